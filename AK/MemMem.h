@@ -8,10 +8,15 @@
 
 #include <AK/Array.h>
 #include <AK/Assertions.h>
+#include <AK/BuiltinWrappers.h>
 #include <AK/Span.h>
 #include <AK/Types.h>
 #include <AK/Vector.h>
 
+#ifndef KERNEL
+#    include <AK/SIMD.h>
+#endif
+
 namespace AK {
 
 namespace Detail {
@@ -40,6 +45,60 @@ constexpr void const* bitap_bitwise(void const* haystack, size_t haystack_length
 
     return nullptr;
 }
+
+#ifndef KERNEL
+// Compares the first and the last byte of the needle against 16 consecutive positions of the haystack at once,
+// and only looks at the rest of the needle where both of them match.
+// NOTE: This is quadratic in the worst case, so it should only be used for short needles.
+inline Optional<size_t> memmem_first_and_last_byte(u8 const* haystack, size_t haystack_length, u8 const* needle, size_t needle_length)
+{
+    VERIFY(needle_length >= 2 && haystack_length >= needle_length);
+
+    using AK::SIMD::u8x16;
+
+    u8x16 first_byte;
+    u8x16 last_byte;
+    for (size_t i = 0; i < 16; ++i) {
+        first_byte[i] = needle[0];
+        last_byte[i] = needle[needle_length - 1];
+    }
+
+    auto matches_at = [&](size_t position) {
+        return __builtin_memcmp(haystack + position + 1, needle + 1, needle_length - 2) == 0;
+    };
+
+    size_t position_count = haystack_length - needle_length + 1;
+    size_t position = 0;
+    for (; position + 16 <= position_count; position += 16) {
+        u8x16 first_bytes;
+        u8x16 last_bytes;
+        __builtin_memcpy(&first_bytes, haystack + position, sizeof(first_bytes));
+        __builtin_memcpy(&last_bytes, haystack + position + needle_length - 1, sizeof(last_bytes));
+
+        auto candidates = (first_bytes == first_byte) & (last_bytes == last_byte);
+        u64 candidate_masks[2];
+        static_assert(sizeof(candidates) == sizeof(candidate_masks));
+        __builtin_memcpy(candidate_masks, &candidates, sizeof(candidate_masks));
+
+        for (size_t half = 0; half < 2; ++half) {
+            for (auto mask = candidate_masks[half]; mask != 0;) {
+                // Every lane of a candidate is 0xff, and the lowest lane is the lowest byte.
+                auto lane = count_trailing_zeroes(mask) / 8;
+                if (matches_at(position + half * 8 + lane))
+                    return position + half * 8 + lane;
+                mask &= ~(0xffull << (lane * 8));
+            }
+        }
+    }
+
+    for (; position < position_count; ++position) {
+        if (haystack[position] == needle[0] && haystack[position + needle_length - 1] == needle[needle_length - 1] && matches_at(position))
+            return position;
+    }
+
+    return {};
+}
+#endif
 }
 
 template<typename HaystackIterT>
@@ -114,6 +173,18 @@ inline Optional<size_t> memmem_optional(void const* haystack, size_t haystack_le
         return {};
     }
 
+#ifndef KERNEL
+    if (needle_length == 1) {
+        auto const* ptr = __builtin_memchr(haystack, *(u8 const*)needle, haystack_length);
+        if (ptr)
+            return static_cast<size_t>((FlatPtr)ptr - (FlatPtr)haystack);
+        return {};
+    }
+
+    if (needle_length < 32 && haystack_length >= 32)
+        return Detail::memmem_first_and_last_byte((u8 const*)haystack, haystack_length, (u8 const*)needle, needle_length);
+#endif
+
     if (needle_length < 32) {
         auto const* ptr = Detail::bitap_bitwise(haystack, haystack_length, needle, needle_length);
         if (ptr)
@@ -76,6 +76,24 @@ TEST_CASE(kmp_two_chunks)
     EXPECT(!result_3.has_value());
 }
 
+TEST_CASE(first_and_last_byte)
+{
+    auto haystack = "the quick brown fox jumps over the lazy dog, then the quick brown dog jumps over the lazy fox"sv;
+
+    auto find = [&](StringView needle) {
+        return AK::memmem_optional(haystack.characters_without_null_termination(), haystack.length(), needle.characters_without_null_termination(), needle.length());
+    };
+
+    EXPECT_EQ(find("the"sv).value_or(999), 0u);
+    EXPECT_EQ(find("fox"sv).value_or(999), 16u);
+    EXPECT_EQ(find("lazy dog"sv).value_or(999), 35u);
+    EXPECT_EQ(find("brown dog"sv).value_or(999), 60u);
+    EXPECT_EQ(find("lazy fox"sv).value_or(999), 85u);
+    EXPECT_EQ(find("x"sv).value_or(999), 18u);
+    EXPECT(!find("lazy cat"sv).has_value());
+    EXPECT(!find("fox!"sv).has_value());
+}
+
 TEST_CASE(timing_safe_compare)
 {
     String data_set = "abcdefghijklmnopqrstuvwxyz123456789";
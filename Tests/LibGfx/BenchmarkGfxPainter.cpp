@@ -6,9 +6,11 @@
 
 #include <LibTest/TestCase.h>
 
+#include <LibGfx/AntiAliasingPainter.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/Font/FontDatabase.h>
 #include <LibGfx/Painter.h>
+#include <LibGfx/Path.h>
 #include <stdio.h>
 
 // Make sure that no matter what order tests are run in, we've got some
@@ -61,3 +63,90 @@ BENCHMARK_CASE(fill_with_gradient)
         painter.fill_rect_with_gradient(bitmap->rect(), Color::Blue, Color::Red);
     }
 }
+
+BENCHMARK_CASE(fill_with_alpha)
+{
+    int const run_count = 100;
+    int const bitmap_size = 2000;
+
+    auto bitmap = Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRx8888, { bitmap_size, bitmap_size }).release_value_but_fixme_should_propagate_errors();
+    Gfx::Painter painter(bitmap);
+
+    for (int run = 0; run < run_count; run++) {
+        painter.fill_rect(bitmap->rect(), Color(Color::Blue).with_alpha(128));
+    }
+}
+
+static NonnullRefPtr<Gfx::Bitmap> create_translucent_bitmap(int bitmap_size)
+{
+    auto bitmap = Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRA8888, { bitmap_size, bitmap_size }).release_value_but_fixme_should_propagate_errors();
+    for (int y = 0; y < bitmap_size; y++) {
+        for (int x = 0; x < bitmap_size; x++)
+            bitmap->set_pixel(x, y, Color(x, y, x + y, (x * y) % 256));
+    }
+    return bitmap;
+}
+
+BENCHMARK_CASE(blit_with_alpha)
+{
+    int const run_count = 50;
+    int const bitmap_size = 2000;
+
+    auto bitmap = Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRx8888, { bitmap_size, bitmap_size }).release_value_but_fixme_should_propagate_errors();
+    auto source = create_translucent_bitmap(bitmap_size);
+    Gfx::Painter painter(bitmap);
+
+    for (int run = 0; run < run_count; run++) {
+        painter.blit({ 0, 0 }, source, source->rect());
+    }
+}
+
+BENCHMARK_CASE(blit_with_opacity)
+{
+    int const run_count = 50;
+    int const bitmap_size = 2000;
+
+    auto bitmap = Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRx8888, { bitmap_size, bitmap_size }).release_value_but_fixme_should_propagate_errors();
+    auto source = create_translucent_bitmap(bitmap_size);
+    Gfx::Painter painter(bitmap);
+
+    for (int run = 0; run < run_count; run++) {
+        painter.blit({ 0, 0 }, source, source->rect(), 0.5f);
+    }
+}
+
+BENCHMARK_CASE(draw_scaled_bitmap_with_alpha)
+{
+    int const run_count = 20;
+    int const bitmap_size = 2000;
+
+    auto bitmap = Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRx8888, { bitmap_size, bitmap_size }).release_value_but_fixme_should_propagate_errors();
+    auto source = create_translucent_bitmap(bitmap_size / 3);
+    Gfx::Painter painter(bitmap);
+
+    for (int run = 0; run < run_count; run++) {
+        painter.draw_scaled_bitmap(bitmap->rect(), source, source->rect(), 1.0f, Gfx::Painter::ScalingMode::NearestNeighbor);
+        painter.draw_scaled_bitmap(bitmap->rect(), source, source->rect(), 1.0f, Gfx::Painter::ScalingMode::BilinearBlend);
+    }
+}
+
+BENCHMARK_CASE(fill_path_anti_aliased)
+{
+    int const run_count = 100;
+    int const bitmap_size = 2000;
+
+    auto bitmap = Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRx8888, { bitmap_size, bitmap_size }).release_value_but_fixme_should_propagate_errors();
+    Gfx::Painter painter(bitmap);
+    Gfx::AntiAliasingPainter aa_painter(painter);
+
+    Gfx::Path path;
+    path.move_to({ 100, 1000 });
+    path.cubic_bezier_curve_to({ 100, 100 }, { 1900, 100 }, { 1900, 1000 });
+    path.quadratic_bezier_curve_to({ 1000, 1300 }, { 1900, 1900 });
+    path.line_to({ 100, 1900 });
+    path.close();
+
+    for (int run = 0; run < run_count; run++) {
+        aa_painter.fill_path(path, Color::Blue, Gfx::Painter::WindingRule::EvenOdd);
+    }
+}
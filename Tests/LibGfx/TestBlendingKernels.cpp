@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/Vector.h>
+#include <LibGfx/BlendingKernels.h>
+#include <LibGfx/Color.h>
+
+// NOTE: The pixels are random, but the same on every run.
+class PixelGenerator {
+public:
+    u32 next_rgb()
+    {
+        m_state ^= m_state << 13;
+        m_state ^= m_state >> 17;
+        m_state ^= m_state << 5;
+        return m_state & 0xffffff;
+    }
+
+private:
+    u32 m_state { 0x12345678 };
+};
+
+// Pixels for every pair of destination and source alpha, with random colors.
+struct PixelPairs {
+    PixelPairs()
+    {
+        PixelGenerator generator;
+        for (u32 destination_alpha = 0; destination_alpha <= 255; ++destination_alpha) {
+            for (u32 source_alpha = 0; source_alpha <= 255; ++source_alpha) {
+                destination.append(destination_alpha << 24 | generator.next_rgb());
+                source.append(source_alpha << 24 | generator.next_rgb());
+            }
+        }
+
+        // The extremes of every channel as well, with some translucent alpha values.
+        for (u32 destination_alpha : { 1u, 128u, 254u }) {
+            for (u32 source_alpha : { 1u, 127u, 254u }) {
+                for (u32 destination_rgb : { 0x000000u, 0xffffffu, 0xff00ffu }) {
+                    for (u32 source_rgb : { 0x000000u, 0xffffffu, 0x00ff00u }) {
+                        destination.append(destination_alpha << 24 | destination_rgb);
+                        source.append(source_alpha << 24 | source_rgb);
+                    }
+                }
+            }
+        }
+    }
+
+    Vector<Gfx::ARGB32> destination;
+    Vector<Gfx::ARGB32> source;
+};
+
+static Gfx::ARGB32 expected_blend(Gfx::ARGB32 destination, Gfx::ARGB32 source)
+{
+    return Gfx::Color::from_argb(destination).blend(Gfx::Color::from_argb(source)).value();
+}
+
+// Calls the kernel on spans of every length up to a few vectors, so that the vector loop and the scalar tail after it
+// both see every kind of pixel.
+template<typename Callback>
+static void for_each_span(size_t count, Callback callback)
+{
+    size_t span_length = 0;
+    for (size_t start = 0; start < count; start += span_length) {
+        span_length = min(start % 29 + 1, count - start);
+        callback(start, span_length);
+    }
+}
+
+static size_t count_mismatches(Vector<Gfx::ARGB32> const& actual, Vector<Gfx::ARGB32> const& expected, StringView kernel_name)
+{
+    size_t mismatches = 0;
+    for (size_t i = 0; i < actual.size(); ++i) {
+        if (actual[i] == expected[i])
+            continue;
+        if (mismatches++ < 10)
+            warnln("{}: Pixel {} is {:08x} instead of {:08x}", kernel_name, i, actual[i], expected[i]);
+    }
+    return mismatches;
+}
+
+TEST_CASE(blend_pixels_matches_color_blend)
+{
+    PixelPairs pixels;
+    Vector<Gfx::ARGB32> expected;
+    for (size_t i = 0; i < pixels.destination.size(); ++i)
+        expected.append(expected_blend(pixels.destination[i], pixels.source[i]));
+
+    for (auto& kernels : Gfx::supported_blending_kernels()) {
+        auto actual = pixels.destination;
+        for_each_span(actual.size(), [&](size_t start, size_t length) {
+            kernels.blend_pixels(actual.data() + start, pixels.source.data() + start, length, Gfx::DestinationAlpha::Keep);
+        });
+        EXPECT_EQ(count_mismatches(actual, expected, kernels.name), 0u);
+    }
+}
+
+TEST_CASE(blend_pixels_into_opaque_destination_matches_color_blend)
+{
+    PixelPairs pixels;
+    Vector<Gfx::ARGB32> expected;
+    for (size_t i = 0; i < pixels.destination.size(); ++i)
+        expected.append(expected_blend(pixels.destination[i] | 0xff000000, pixels.source[i]));
+
+    for (auto& kernels : Gfx::supported_blending_kernels()) {
+        auto actual = pixels.destination;
+        for_each_span(actual.size(), [&](size_t start, size_t length) {
+            kernels.blend_pixels(actual.data() + start, pixels.source.data() + start, length, Gfx::DestinationAlpha::Opaque);
+        });
+        EXPECT_EQ(count_mismatches(actual, expected, kernels.name), 0u);
+    }
+}
+
+TEST_CASE(blend_color_into_pixels_matches_color_blend)
+{
+    PixelPairs pixels;
+
+    // NOTE: The color is the same for a whole call, so each source alpha gets a call on the pixels of every
+    //       destination alpha.
+    for (auto& kernels : Gfx::supported_blending_kernels()) {
+        size_t mismatches = 0;
+        for (size_t source_alpha = 0; source_alpha <= 255; ++source_alpha) {
+            Vector<Gfx::ARGB32> actual;
+            Vector<Gfx::ARGB32> expected;
+            auto color = Gfx::Color::from_argb(pixels.source[source_alpha]);
+            for (size_t destination_alpha = 0; destination_alpha <= 255; ++destination_alpha) {
+                auto destination = pixels.destination[destination_alpha * 256 + source_alpha];
+                actual.append(destination);
+                expected.append(expected_blend(destination, color.value()));
+            }
+            for_each_span(actual.size(), [&](size_t start, size_t length) {
+                kernels.blend_color_into_pixels(actual.data() + start, length, color);
+            });
+            mismatches += count_mismatches(actual, expected, kernels.name);
+        }
+        EXPECT_EQ(mismatches, 0u);
+    }
+}
+
+TEST_CASE(empty_spans_are_left_alone)
+{
+    Gfx::ARGB32 pixel = 0x80402010;
+    for (auto& kernels : Gfx::supported_blending_kernels()) {
+        kernels.blend_pixels(&pixel, nullptr, 0, Gfx::DestinationAlpha::Keep);
+        kernels.blend_color_into_pixels(&pixel, 0, Gfx::Color::Red);
+        EXPECT_EQ(pixel, 0x80402010u);
+    }
+}
@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/Vector.h>
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/Font/GlyphAtlas.h>
+#include <LibGfx/Font/ScaledFont.h>
+#include <LibGfx/Font/TrueType/Font.h>
+#include <LibGfx/Painter.h>
+#include <LibThreading/Thread.h>
+
+static NonnullRefPtr<Gfx::VectorFont> test_font()
+{
+    static auto font = MUST(TTF::Font::try_load_from_file("/res/fonts/SerenitySans-Regular.ttf"));
+    return font;
+}
+
+static constexpr float scale = 1.0f;
+
+// A "glyph" that is filled with a color that is different for every glyph id.
+static Gfx::Color color_for_glyph(u32 glyph_id)
+{
+    return Gfx::Color(glyph_id & 0xff, (glyph_id >> 8) & 0xff, 0x80, 0xff);
+}
+
+static NonnullRefPtr<Gfx::Bitmap> glyph_bitmap(u32 glyph_id, Gfx::IntSize const& size)
+{
+    auto bitmap = MUST(Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRA8888, size));
+    bitmap->fill(color_for_glyph(glyph_id));
+    return bitmap;
+}
+
+static bool glyph_has_color(Gfx::GlyphAtlas::Glyph const& glyph, Gfx::Color color)
+{
+    for (int y = glyph.rect.top(); y <= glyph.rect.bottom(); ++y) {
+        for (int x = glyph.rect.left(); x <= glyph.rect.right(); ++x) {
+            if (glyph.page->get_pixel(x, y) != color)
+                return false;
+        }
+    }
+    return true;
+}
+
+TEST_CASE(glyphs_are_packed_without_overlapping)
+{
+    Gfx::GlyphAtlas atlas;
+    auto& font = *test_font();
+
+    Vector<Gfx::GlyphAtlas::Glyph> glyphs;
+    for (u32 glyph_id = 0; glyph_id < 300; ++glyph_id) {
+        auto glyph = atlas.insert(font, scale, scale, glyph_id, glyph_bitmap(glyph_id, { 1 + glyph_id % 37, 1 + glyph_id % 23 }));
+        EXPECT(glyph.has_value());
+        glyphs.append(glyph.release_value());
+    }
+
+    for (u32 glyph_id = 0; glyph_id < glyphs.size(); ++glyph_id) {
+        auto& glyph = glyphs[glyph_id];
+        EXPECT(Gfx::IntRect(0, 0, Gfx::GlyphAtlas::page_size, Gfx::GlyphAtlas::page_size).contains(glyph.rect));
+        EXPECT(glyph_has_color(glyph, color_for_glyph(glyph_id)));
+
+        auto found_glyph = atlas.find(font, scale, scale, glyph_id);
+        EXPECT(found_glyph.has_value());
+        EXPECT_EQ(found_glyph->page.ptr(), glyph.page.ptr());
+        EXPECT_EQ(found_glyph->rect, glyph.rect);
+
+        for (u32 other_glyph_id = 0; other_glyph_id < glyph_id; ++other_glyph_id) {
+            auto& other_glyph = glyphs[other_glyph_id];
+            if (other_glyph.page.ptr() == glyph.page.ptr())
+                EXPECT(!other_glyph.rect.intersects(glyph.rect));
+        }
+    }
+}
+
+TEST_CASE(glyphs_are_told_apart_by_their_scale)
+{
+    Gfx::GlyphAtlas atlas;
+    auto& font = *test_font();
+
+    EXPECT(atlas.insert(font, 1.0f, 1.0f, 1, glyph_bitmap(1, { 4, 4 })).has_value());
+    EXPECT(atlas.find(font, 1.0f, 1.0f, 1).has_value());
+    EXPECT(!atlas.find(font, 2.0f, 1.0f, 1).has_value());
+    EXPECT(!atlas.find(font, 1.0f, 2.0f, 1).has_value());
+    EXPECT(!atlas.find(font, 1.0f, 1.0f, 2).has_value());
+}
+
+TEST_CASE(glyphs_that_do_not_fit_are_not_inserted)
+{
+    Gfx::GlyphAtlas atlas;
+    auto& font = *test_font();
+
+    EXPECT(!atlas.insert(font, scale, scale, 1, glyph_bitmap(1, { Gfx::GlyphAtlas::page_size + 1, 1 })).has_value());
+    EXPECT(!atlas.insert(font, scale, scale, 2, glyph_bitmap(2, { 1, Gfx::GlyphAtlas::page_size + 1 })).has_value());
+    EXPECT(!atlas.insert(font, scale, scale, 3, MUST(Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRx8888, { 4, 4 }))).has_value());
+    EXPECT(!atlas.find(font, scale, scale, 1).has_value());
+}
+
+TEST_CASE(least_recently_used_page_is_evicted)
+{
+    Gfx::GlyphAtlas atlas;
+    auto& font = *test_font();
+
+    // NOTE: Four of these fill a page.
+    static constexpr int glyph_size = Gfx::GlyphAtlas::page_size / 2;
+    static constexpr u32 glyphs_per_page = 4;
+    static constexpr u32 glyph_count = glyphs_per_page * Gfx::GlyphAtlas::max_page_count;
+
+    Vector<Gfx::GlyphAtlas::Glyph> glyphs;
+    for (u32 glyph_id = 0; glyph_id < glyph_count; ++glyph_id)
+        glyphs.append(atlas.insert(font, scale, scale, glyph_id, glyph_bitmap(glyph_id, { glyph_size, glyph_size })).release_value());
+    for (u32 glyph_id = 0; glyph_id < glyph_count; ++glyph_id)
+        EXPECT(atlas.find(font, scale, scale, glyph_id).has_value());
+
+    // Using a glyph on the first page makes the second page the least recently used one.
+    EXPECT(atlas.find(font, scale, scale, 0).has_value());
+    EXPECT(atlas.insert(font, scale, scale, glyph_count, glyph_bitmap(glyph_count, { glyph_size, glyph_size })).has_value());
+
+    for (u32 glyph_id = 0; glyph_id < glyph_count; ++glyph_id) {
+        bool is_on_second_page = glyph_id >= glyphs_per_page && glyph_id < 2 * glyphs_per_page;
+        EXPECT_EQ(atlas.find(font, scale, scale, glyph_id).has_value(), !is_on_second_page);
+    }
+    EXPECT(atlas.find(font, scale, scale, glyph_count).has_value());
+
+    // Glyphs that were handed out before still show what they did.
+    for (u32 glyph_id = glyphs_per_page; glyph_id < 2 * glyphs_per_page; ++glyph_id)
+        EXPECT(glyph_has_color(glyphs[glyph_id], color_for_glyph(glyph_id)));
+}
+
+TEST_CASE(every_thread_has_its_own_atlas)
+{
+    auto& font = *test_font();
+    EXPECT(Gfx::GlyphAtlas::the().insert(font, 3.0f, 3.0f, 1, glyph_bitmap(1, { 4, 4 })).has_value());
+
+    bool other_thread_found_glyph = true;
+    auto thread = Threading::Thread::construct([&] {
+        other_thread_found_glyph = Gfx::GlyphAtlas::the().find(font, 3.0f, 3.0f, 1).has_value();
+        return 0;
+    });
+    thread->start();
+    EXPECT(!thread->join().is_error());
+
+    EXPECT(!other_thread_found_glyph);
+    EXPECT(Gfx::GlyphAtlas::the().find(font, 3.0f, 3.0f, 1).has_value());
+}
+
+TEST_CASE(drawing_glyphs_from_the_atlas_matches_drawing_them_directly)
+{
+    auto font = adopt_ref(*new Gfx::ScaledFont(test_font(), 14, 14));
+    auto text = "The quick brown fox jumps over the lazy dog, 0123456789!"sv;
+    auto color = Gfx::Color(20, 40, 160, 200);
+
+    // NOTE: The last glyphs are partially clipped by the right edge of the bitmap.
+    Gfx::IntSize size { 300, 24 };
+    Vector<Gfx::DrawGlyph> glyphs;
+    int x = 2;
+    for (auto code_point : text) {
+        glyphs.append({ { x, 3 }, static_cast<u32>(code_point) });
+        x += font->glyph_width(code_point);
+    }
+    VERIFY(x > size.width());
+
+    // Drawing each glyph twice makes sure that the second time is drawn from the atlas as well.
+    auto through_atlas = MUST(Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRx8888, size));
+    for (int i = 0; i < 2; ++i) {
+        through_atlas->fill(Gfx::Color::White);
+        Gfx::Painter painter(*through_atlas);
+        painter.draw_glyph_run(glyphs, *font, color);
+    }
+
+    auto directly = MUST(Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRx8888, size));
+    directly->fill(Gfx::Color::White);
+    Gfx::Painter painter(*directly);
+    for (auto& glyph : glyphs) {
+        auto glyph_id = font->glyph_id_for_code_point(glyph.code_point);
+        auto bitmap = font->rasterize_glyph(glyph_id);
+        if (!bitmap)
+            continue;
+        auto top_left = glyph.position + Gfx::IntPoint(font->glyph_metrics(glyph_id).left_side_bearing, 0);
+        painter.blit_filtered(top_left, *bitmap, bitmap->rect(), [color](Gfx::Color pixel) {
+            return pixel.multiply(color);
+        });
+    }
+
+    size_t differing_pixels = 0;
+    for (int y = 0; y < size.height(); ++y) {
+        for (int x = 0; x < size.width(); ++x) {
+            if (through_atlas->get_pixel(x, y) != directly->get_pixel(x, y))
+                ++differing_pixels;
+        }
+    }
+    EXPECT_EQ(differing_pixels, 0u);
+
+    // The glyphs really came out of the atlas.
+    EXPECT_EQ(font->glyph('T').bitmap()->size(), Gfx::IntSize(Gfx::GlyphAtlas::page_size, Gfx::GlyphAtlas::page_size));
+}
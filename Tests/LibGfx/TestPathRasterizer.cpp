@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/Math.h>
+#include <AK/Vector.h>
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/Font/TrueType/Font.h>
+#include <LibGfx/Path.h>
+#include <LibGfx/PathRasterizer.h>
+
+using WindingRule = Gfx::Painter::WindingRule;
+
+// The coverage of every pixel in a rect, row by row.
+class Coverage {
+public:
+    explicit Coverage(Gfx::IntRect const& rect)
+        : m_rect(rect)
+    {
+        m_values.resize(rect.width() * rect.height());
+    }
+
+    static Coverage rasterize(Gfx::IntRect const& rect, Gfx::Path const& path, WindingRule winding_rule = WindingRule::Nonzero)
+    {
+        Coverage coverage(rect);
+        Gfx::PathRasterizer rasterizer(rect);
+        rasterizer.add_path(path);
+        rasterizer.rasterize(winding_rule, [&](Gfx::IntPoint const& start, Span<float const> values) {
+            EXPECT(rect.contains(start));
+            EXPECT(start.x() + static_cast<int>(values.size()) <= rect.right() + 1);
+            for (size_t i = 0; i < values.size(); ++i)
+                coverage.at(start.x() + i, start.y()) = values[i];
+        });
+        return coverage;
+    }
+
+    // Samples the shape at 64x64 points within each pixel.
+    template<typename Callback>
+    static Coverage supersample(Gfx::IntRect const& rect, Callback contains)
+    {
+        static constexpr int samples = 64;
+        Coverage coverage(rect);
+        for (int y = rect.top(); y <= rect.bottom(); ++y) {
+            for (int x = rect.left(); x <= rect.right(); ++x) {
+                int inside = 0;
+                for (int sy = 0; sy < samples; ++sy) {
+                    for (int sx = 0; sx < samples; ++sx) {
+                        if (contains(x + (sx + 0.5f) / samples, y + (sy + 0.5f) / samples))
+                            ++inside;
+                    }
+                }
+                coverage.at(x, y) = static_cast<float>(inside) / (samples * samples);
+            }
+        }
+        return coverage;
+    }
+
+    float& at(int x, int y) { return m_values[(y - m_rect.top()) * m_rect.width() + x - m_rect.left()]; }
+    float at(int x, int y) const { return const_cast<Coverage&>(*this).at(x, y); }
+
+    float total() const
+    {
+        float total = 0;
+        for (auto value : m_values)
+            total += value;
+        return total;
+    }
+
+    float max_difference(Coverage const& other) const
+    {
+        VERIFY(m_rect == other.m_rect);
+        float max_difference = 0;
+        for (size_t i = 0; i < m_values.size(); ++i)
+            max_difference = max(max_difference, fabsf(m_values[i] - other.m_values[i]));
+        return max_difference;
+    }
+
+private:
+    Gfx::IntRect m_rect;
+    Vector<float> m_values;
+};
+
+// NOTE: Rect::right() and Rect::bottom() are off by one for float rects, so these use the width and height instead.
+static void add_rect(Gfx::Path& path, Gfx::FloatRect const& rect, bool clockwise = true)
+{
+    Gfx::FloatPoint top_right { rect.x() + rect.width(), rect.y() };
+    Gfx::FloatPoint bottom_left { rect.x(), rect.y() + rect.height() };
+    path.move_to(rect.location());
+    path.line_to(clockwise ? top_right : bottom_left);
+    path.line_to({ rect.x() + rect.width(), rect.y() + rect.height() });
+    path.line_to(clockwise ? bottom_left : top_right);
+    path.close();
+}
+
+static Gfx::Path rect_path(Gfx::FloatRect const& rect)
+{
+    Gfx::Path path;
+    add_rect(path, rect);
+    return path;
+}
+
+// How much of the pixel at (x, y) is covered by the rect.
+static float area_of_rect_in_pixel(Gfx::FloatRect const& rect, int x, int y)
+{
+    auto width = min(rect.x() + rect.width(), x + 1.0f) - max(rect.x(), static_cast<float>(x));
+    auto height = min(rect.y() + rect.height(), y + 1.0f) - max(rect.y(), static_cast<float>(y));
+    return max(width, 0.0f) * max(height, 0.0f);
+}
+
+static constexpr float epsilon = 1e-4f;
+
+// Curves are split into lines that stay within this many pixels of them, so pixels along a curve can be off by as much.
+static constexpr float curve_tolerance = 0.1f;
+
+// How far the coverage of a pixel sampled by Coverage::supersample() can be off.
+static constexpr float supersampling_error = 0.03f;
+
+#define EXPECT_NEAR(a, b, error) EXPECT(fabsf((a) - (b)) <= (error))
+
+TEST_CASE(axis_aligned_rects)
+{
+    Gfx::IntRect clip_rect { 0, 0, 16, 16 };
+    for (auto rect : { Gfx::FloatRect { 2, 3, 8, 5 }, Gfx::FloatRect { 0, 0, 16, 16 }, Gfx::FloatRect { -4, 10, 30, 1 } }) {
+        auto coverage = Coverage::rasterize(clip_rect, rect_path(rect));
+        for (int y = clip_rect.top(); y <= clip_rect.bottom(); ++y) {
+            for (int x = clip_rect.left(); x <= clip_rect.right(); ++x)
+                EXPECT_NEAR(coverage.at(x, y), area_of_rect_in_pixel(rect, x, y), epsilon);
+        }
+    }
+}
+
+TEST_CASE(fractional_rects)
+{
+    Gfx::IntRect clip_rect { 0, 0, 16, 16 };
+    for (auto rect : { Gfx::FloatRect { 1.25f, 2.5f, 3.25f, 1.25f }, Gfx::FloatRect { 5.1f, 5.1f, 0.3f, 0.4f }, Gfx::FloatRect { -0.75f, 14.5f, 20.0f, 3.0f } }) {
+        auto coverage = Coverage::rasterize(clip_rect, rect_path(rect));
+        for (int y = clip_rect.top(); y <= clip_rect.bottom(); ++y) {
+            for (int x = clip_rect.left(); x <= clip_rect.right(); ++x)
+                EXPECT_NEAR(coverage.at(x, y), area_of_rect_in_pixel(rect, x, y), epsilon);
+        }
+    }
+}
+
+TEST_CASE(triangles)
+{
+    Gfx::IntRect clip_rect { 0, 0, 24, 24 };
+    struct Triangle {
+        Gfx::FloatPoint a, b, c;
+    };
+    for (auto triangle : { Triangle { { 2, 2 }, { 20, 5 }, { 7, 21.5f } }, Triangle { { 0.5f, 23 }, { 23.5f, 22 }, { 12.25f, 0.75f } }, Triangle { { 3, 3 }, { 3.5f, 20 }, { 4, 3 } } }) {
+        Gfx::Path path;
+        path.move_to(triangle.a);
+        path.line_to(triangle.b);
+        path.line_to(triangle.c);
+        auto coverage = Coverage::rasterize(clip_rect, path);
+
+        auto cross = [](Gfx::FloatPoint const& a, Gfx::FloatPoint const& b, float x, float y) {
+            return (b.x() - a.x()) * (y - a.y()) - (b.y() - a.y()) * (x - a.x());
+        };
+        auto reference = Coverage::supersample(clip_rect, [&](float x, float y) {
+            auto ab = cross(triangle.a, triangle.b, x, y);
+            auto bc = cross(triangle.b, triangle.c, x, y);
+            auto ca = cross(triangle.c, triangle.a, x, y);
+            return (ab >= 0 && bc >= 0 && ca >= 0) || (ab <= 0 && bc <= 0 && ca <= 0);
+        });
+
+        auto area = fabsf(cross(triangle.a, triangle.b, triangle.c.x(), triangle.c.y())) / 2;
+        EXPECT_NEAR(coverage.total(), area, 1e-3f * area);
+        EXPECT(coverage.max_difference(reference) < supersampling_error);
+    }
+}
+
+TEST_CASE(shapes_partially_outside_the_clip_rect)
+{
+    Gfx::Path path;
+    path.move_to({ -10.5f, 3.25f });
+    path.line_to({ 30.25f, -6 });
+    path.line_to({ 18, 40.75f });
+
+    Gfx::IntRect full_rect { -16, -16, 64, 64 };
+    auto full = Coverage::rasterize(full_rect, path);
+    for (auto clip_rect : { Gfx::IntRect { 0, 0, 16, 16 }, Gfx::IntRect { 20, 10, 7, 30 }, Gfx::IntRect { -12, 2, 5, 3 } }) {
+        auto clipped = Coverage::rasterize(clip_rect, path);
+        for (int y = clip_rect.top(); y <= clip_rect.bottom(); ++y) {
+            for (int x = clip_rect.left(); x <= clip_rect.right(); ++x)
+                EXPECT_NEAR(clipped.at(x, y), full.at(x, y), epsilon);
+        }
+    }
+}
+
+TEST_CASE(even_odd_and_nonzero_winding)
+{
+    Gfx::IntRect clip_rect { 0, 0, 16, 16 };
+    Gfx::FloatRect outer { 2, 2, 12, 12 };
+    Gfx::FloatRect inner { 5, 5, 6, 6 };
+
+    // Both rects going the same way: Only the even-odd rule leaves a hole.
+    auto same_direction = rect_path(outer);
+    add_rect(same_direction, inner);
+
+    // The inner rect going the other way: Both rules leave a hole.
+    auto opposite_direction = rect_path(outer);
+    add_rect(opposite_direction, inner, false);
+
+    auto expect_coverage = [&](Coverage const& coverage, bool hole) {
+        for (int y = clip_rect.top(); y <= clip_rect.bottom(); ++y) {
+            for (int x = clip_rect.left(); x <= clip_rect.right(); ++x) {
+                float expected = area_of_rect_in_pixel(outer, x, y);
+                if (hole)
+                    expected -= area_of_rect_in_pixel(inner, x, y);
+                EXPECT_NEAR(coverage.at(x, y), expected, epsilon);
+            }
+        }
+    };
+    expect_coverage(Coverage::rasterize(clip_rect, same_direction, WindingRule::Nonzero), false);
+    expect_coverage(Coverage::rasterize(clip_rect, same_direction, WindingRule::EvenOdd), true);
+    expect_coverage(Coverage::rasterize(clip_rect, opposite_direction, WindingRule::Nonzero), true);
+    expect_coverage(Coverage::rasterize(clip_rect, opposite_direction, WindingRule::EvenOdd), true);
+}
+
+TEST_CASE(circle_made_of_curves)
+{
+    Gfx::IntRect clip_rect { 0, 0, 32, 32 };
+    Gfx::FloatPoint center { 16.25f, 15.5f };
+    float radius = 12.5f;
+
+    // NOTE: This is the usual approximation of a quarter circle with a cubic Bézier curve.
+    float control = radius * 0.5522847f;
+    Gfx::Path path;
+    path.move_to(center + Gfx::FloatPoint { radius, 0 });
+    path.cubic_bezier_curve_to(center + Gfx::FloatPoint { radius, control }, center + Gfx::FloatPoint { control, radius }, center + Gfx::FloatPoint { 0, radius });
+    path.cubic_bezier_curve_to(center + Gfx::FloatPoint { -control, radius }, center + Gfx::FloatPoint { -radius, control }, center + Gfx::FloatPoint { -radius, 0 });
+    path.cubic_bezier_curve_to(center + Gfx::FloatPoint { -radius, -control }, center + Gfx::FloatPoint { -control, -radius }, center + Gfx::FloatPoint { 0, -radius });
+    path.cubic_bezier_curve_to(center + Gfx::FloatPoint { control, -radius }, center + Gfx::FloatPoint { radius, -control }, center + Gfx::FloatPoint { radius, 0 });
+    auto coverage = Coverage::rasterize(clip_rect, path);
+
+    auto reference = Coverage::supersample(clip_rect, [&](float x, float y) {
+        return (x - center.x()) * (x - center.x()) + (y - center.y()) * (y - center.y()) <= radius * radius;
+    });
+
+    // NOTE: The lines are all inside of the circle, so the area can only be too small, by less than the tolerance along
+    //       the whole circumference.
+    auto area = AK::Pi<float> * radius * radius;
+    EXPECT(coverage.total() <= area);
+    EXPECT(coverage.total() > area - 2 * AK::Pi<float> * radius * curve_tolerance);
+    EXPECT(coverage.max_difference(reference) < curve_tolerance + supersampling_error);
+}
+
+TEST_CASE(rasterized_glyph)
+{
+    auto font = MUST(TTF::Font::try_load_from_file("/res/fonts/SerenitySans-Regular.ttf"));
+    auto glyph_id = font->glyph_id_for_code_point('O');
+
+    // NOTE: The glyph transform only scales, so each pixel of the glyph at 8 times the size covers 8x8 pixels of the
+    //       small one. Averaging those gives a good reference for the coverage of the small glyph's pixels.
+    static constexpr int factor = 8;
+    float scale = 0.02f;
+    auto glyph = font->rasterize_glyph(glyph_id, scale, scale);
+    auto large_glyph = font->rasterize_glyph(glyph_id, scale * factor, scale * factor);
+    VERIFY(glyph && large_glyph);
+
+    float total_difference = 0;
+    int max_difference = 0;
+    int covered_pixel_count = 0;
+    for (int y = 0; y < glyph->height(); ++y) {
+        for (int x = 0; x < glyph->width(); ++x) {
+            int large_alpha_sum = 0;
+            for (int large_y = y * factor; large_y < min((y + 1) * factor, large_glyph->height()); ++large_y) {
+                for (int large_x = x * factor; large_x < min((x + 1) * factor, large_glyph->width()); ++large_x)
+                    large_alpha_sum += large_glyph->get_pixel(large_x, large_y).alpha();
+            }
+            int alpha = glyph->get_pixel(x, y).alpha();
+            int difference = abs(alpha - large_alpha_sum / (factor * factor));
+            total_difference += difference;
+            max_difference = max(max_difference, difference);
+            if (alpha > 0)
+                ++covered_pixel_count;
+        }
+    }
+
+    EXPECT(covered_pixel_count > 0);
+    EXPECT(max_difference <= (curve_tolerance + supersampling_error) * 255);
+    EXPECT(total_difference / (glyph->width() * glyph->height()) < 3.0f);
+}
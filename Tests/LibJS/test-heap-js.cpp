@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashMap.h>
+#include <AK/Vector.h>
+#include <LibJS/Heap/BlockAllocator.h>
+#include <LibJS/Heap/DeferGC.h>
+#include <LibJS/Heap/Handle.h>
+#include <LibJS/Heap/HeapBlock.h>
+#include <LibJS/Interpreter.h>
+#include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/Object.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibTest/TestCase.h>
+
+TEST_CASE(purged_blocks_are_usable_again)
+{
+    JS::BlockAllocator allocator;
+
+    Vector<void*> blocks;
+    for (size_t i = 0; i < 100; ++i)
+        blocks.append(allocator.allocate_block("test"));
+    for (auto* block : blocks) {
+        EXPECT_EQ(reinterpret_cast<FlatPtr>(block) % JS::HeapBlock::block_size, 0u);
+        __builtin_memset(block, 0xaa, JS::HeapBlock::block_size);
+        allocator.deallocate_block(block);
+    }
+    EXPECT_EQ(allocator.hot_cached_block_count(), 100u);
+    EXPECT_EQ(allocator.cold_cached_block_count(), 0u);
+
+    allocator.purge_cached_blocks();
+    EXPECT_EQ(allocator.hot_cached_block_count(), 32u);
+    EXPECT_EQ(allocator.cold_cached_block_count(), 68u);
+    EXPECT_EQ(allocator.total_purged_block_count(), 68u);
+
+    // Purging again without anything new in the cache is a no-op.
+    allocator.purge_cached_blocks();
+    EXPECT_EQ(allocator.cold_cached_block_count(), 68u);
+    EXPECT_EQ(allocator.total_purged_block_count(), 68u);
+
+    blocks.clear();
+    for (size_t i = 0; i < 100; ++i) {
+        auto* block = static_cast<u8*>(allocator.allocate_block("test"));
+        __builtin_memset(block, 0x55, JS::HeapBlock::block_size);
+        EXPECT_EQ(block[0], 0x55);
+        EXPECT_EQ(block[JS::HeapBlock::block_size - 1], 0x55);
+        blocks.append(block);
+    }
+    EXPECT_EQ(allocator.hot_cached_block_count(), 0u);
+    EXPECT_EQ(allocator.cold_cached_block_count(), 0u);
+
+    for (auto* block : blocks)
+        allocator.deallocate_block(block);
+}
+
+TEST_CASE(swept_blocks_are_allocated_from_in_address_order)
+{
+    auto vm = JS::VM::create();
+    auto interpreter = JS::Interpreter::create<JS::GlobalObject>(*vm);
+    auto& realm = interpreter->realm();
+    auto& heap = interpreter->heap();
+
+    // Fill some blocks, and keep only every other object alive.
+    static constexpr size_t object_count = 4096;
+    Vector<JS::Handle<JS::Object>> survivors;
+    for (size_t i = 0; i < object_count; ++i) {
+        auto* object = JS::Object::create(realm, nullptr);
+        if (i % 2 == 0)
+            survivors.append(JS::make_handle(object));
+    }
+    heap.collect_garbage();
+
+    // New objects go into the holes left behind, and within every block they come out in ascending address order.
+    // NOTE: Another collection would start over from the lowest free cell, so don't let one happen in between.
+    JS::DeferGC defer_gc(heap);
+    HashMap<JS::HeapBlock*, FlatPtr> last_address_in_block;
+    Vector<JS::Handle<JS::Object>> new_objects;
+    size_t out_of_order_count = 0;
+    for (size_t i = 0; i < object_count / 2; ++i) {
+        auto* object = JS::Object::create(realm, nullptr);
+        new_objects.append(JS::make_handle(object));
+
+        auto* block = JS::HeapBlock::from_cell(object);
+        auto address = reinterpret_cast<FlatPtr>(object);
+        auto last_address = last_address_in_block.get(block);
+        if (last_address.has_value() && *last_address > address)
+            ++out_of_order_count;
+        last_address_in_block.set(block, address);
+    }
+    EXPECT_EQ(out_of_order_count, 0u);
+
+    for (auto& survivor : survivors)
+        EXPECT(!survivor.is_null());
+}
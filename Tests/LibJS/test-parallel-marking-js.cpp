@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Interpreter.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibJS/Script.h>
+#include <LibTest/TestCase.h>
+
+static void run_script_with_marking_threads(StringView source, size_t marking_thread_count)
+{
+    auto vm = JS::VM::create();
+    auto interpreter = JS::Interpreter::create<JS::GlobalObject>(*vm);
+    interpreter->heap().set_marking_thread_count(marking_thread_count);
+    EXPECT_EQ(interpreter->heap().marking_thread_count(), marking_thread_count);
+
+    auto script_or_error = JS::Script::parse(source, interpreter->realm());
+    EXPECT(!script_or_error.is_error());
+    if (script_or_error.is_error())
+        return;
+
+    auto result = interpreter->run(script_or_error.release_value());
+    EXPECT(!result.is_error());
+    if (result.is_error())
+        dbgln("Error: {}", MUST(result.throw_completion().value()->to_string(*vm)));
+}
+
+static constexpr auto object_graph_script = R"(
+    // A long chain (deep graph) and a wide tree (lots of stealable work), plus plenty of garbage.
+    let chain = null;
+    for (let i = 0; i < 100000; ++i)
+        chain = { value: i, next: chain };
+
+    const tree = [];
+    for (let i = 0; i < 1000; ++i) {
+        const children = [];
+        for (let j = 0; j < 100; ++j)
+            children.push({ value: j });
+        tree.push(children);
+        [{}, {}, {}];
+    }
+
+    for (let i = 0; i < 3; ++i)
+        gc();
+
+    let chain_sum = 0;
+    for (let node = chain; node !== null; node = node.next)
+        chain_sum += node.value;
+    if (chain_sum !== 4999950000) throw new Error("chain was damaged by GC");
+
+    let tree_sum = 0;
+    for (const children of tree) {
+        for (const child of children)
+            tree_sum += child.value;
+    }
+    if (tree_sum !== 4950000) throw new Error("tree was damaged by GC");
+)"sv;
+
+TEST_CASE(serial_marking_keeps_reachable_cells_alive)
+{
+    run_script_with_marking_threads(object_graph_script, 1);
+}
+
+TEST_CASE(parallel_marking_keeps_reachable_cells_alive)
+{
+    run_script_with_marking_threads(object_graph_script, 2);
+    run_script_with_marking_threads(object_graph_script, 4);
+}
+
+BENCHMARK_CASE(collect_large_object_graph_serially)
+{
+    run_script_with_marking_threads(object_graph_script, 1);
+}
+
+BENCHMARK_CASE(collect_large_object_graph_on_four_threads)
+{
+    run_script_with_marking_threads(object_graph_script, 4);
+}
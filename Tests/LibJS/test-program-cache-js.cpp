@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Interpreter.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibJS/Script.h>
+#include <LibTest/TestCase.h>
+
+TEST_CASE(identical_scripts_share_their_ast)
+{
+    auto vm = JS::VM::create();
+    auto interpreter = JS::Interpreter::create<JS::GlobalObject>(*vm);
+
+    // NOTE: The source only goes into the cache once it has been parsed twice.
+    (void)JS::Script::parse("function f() { return 1; }"sv, interpreter->realm(), "a.js"sv).release_value();
+    auto first = JS::Script::parse("function f() { return 1; }"sv, interpreter->realm(), "a.js"sv).release_value();
+    auto second = JS::Script::parse("function f() { return 1; }"sv, interpreter->realm(), "a.js"sv).release_value();
+    EXPECT_EQ(&first->parse_node(), &second->parse_node());
+    EXPECT_EQ(vm->program_cache().hit_count(), 1u);
+
+    auto other_filename = JS::Script::parse("function f() { return 1; }"sv, interpreter->realm(), "b.js"sv).release_value();
+    EXPECT_NE(&first->parse_node(), &other_filename->parse_node());
+
+    auto other_source = JS::Script::parse("function f() { return 2; }"sv, interpreter->realm(), "a.js"sv).release_value();
+    EXPECT_NE(&first->parse_node(), &other_source->parse_node());
+}
+
+TEST_CASE(scripts_parsed_once_are_not_copied_into_the_cache)
+{
+    auto vm = JS::VM::create();
+    auto interpreter = JS::Interpreter::create<JS::GlobalObject>(*vm);
+
+    auto first = JS::Script::parse("1 + 2"sv, interpreter->realm()).release_value();
+    EXPECT_EQ(vm->program_cache().entry_count(), 0u);
+    EXPECT_EQ(interpreter->run(*first).value(), JS::Value(3));
+
+    auto second = JS::Script::parse("1 + 2"sv, interpreter->realm()).release_value();
+    EXPECT_EQ(vm->program_cache().entry_count(), 1u);
+    EXPECT_NE(&first->parse_node(), &second->parse_node());
+}
+
+TEST_CASE(scripts_with_tagged_templates_are_not_shared)
+{
+    auto vm = JS::VM::create();
+    auto interpreter = JS::Interpreter::create<JS::GlobalObject>(*vm);
+
+    auto first = JS::Script::parse("String.raw`a`"sv, interpreter->realm()).release_value();
+    auto second = JS::Script::parse("String.raw`a`"sv, interpreter->realm()).release_value();
+    EXPECT_NE(&first->parse_node(), &second->parse_node());
+}
+
+TEST_CASE(scripts_with_syntax_errors_are_not_cached)
+{
+    auto vm = JS::VM::create();
+    auto interpreter = JS::Interpreter::create<JS::GlobalObject>(*vm);
+
+    EXPECT(JS::Script::parse("let let = 1;"sv, interpreter->realm()).is_error());
+    EXPECT(JS::Script::parse("let let = 1;"sv, interpreter->realm()).is_error());
+    EXPECT_EQ(vm->program_cache().hit_count(), 0u);
+}
+
+TEST_CASE(entries_are_evicted_while_their_scripts_are_alive)
+{
+    auto vm = JS::VM::create();
+    auto interpreter = JS::Interpreter::create<JS::GlobalObject>(*vm);
+
+    Vector<JS::Handle<JS::Script>> scripts;
+    for (size_t i = 0; i < JS::ProgramCache::max_entry_count * 2; ++i) {
+        auto source = String::formatted("{};", i);
+        (void)JS::Script::parse(source, interpreter->realm(), "a.js"sv).release_value();
+        scripts.append(JS::make_handle(*JS::Script::parse(source, interpreter->realm(), "a.js"sv).release_value()));
+    }
+    EXPECT_EQ(vm->program_cache().entry_count(), JS::ProgramCache::max_entry_count);
+
+    // NOTE: The first script's entry is gone from the cache, but its AST must still be usable.
+    auto result = interpreter->run(*scripts.first());
+    EXPECT(!result.is_error());
+    EXPECT_EQ(result.value(), JS::Value(0));
+}
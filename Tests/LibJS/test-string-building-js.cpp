@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Interpreter.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibJS/Script.h>
+#include <LibTest/TestCase.h>
+
+static void run_script(StringView source)
+{
+    auto vm = JS::VM::create();
+    auto interpreter = JS::Interpreter::create<JS::GlobalObject>(*vm);
+
+    auto script_or_error = JS::Script::parse(source, interpreter->realm());
+    EXPECT(!script_or_error.is_error());
+    if (script_or_error.is_error())
+        return;
+
+    auto result = interpreter->run(script_or_error.release_value());
+    EXPECT(!result.is_error());
+    if (result.is_error())
+        dbgln("Error: {}", MUST(result.throw_completion().value()->to_string(*vm)));
+}
+
+TEST_CASE(deep_rope_is_resolved_correctly)
+{
+    run_script(R"(
+        let s = "";
+        for (let i = 0; i < 10000; ++i)
+            s += String.fromCharCode(65 + (i % 26));
+        if (s.length !== 10000) throw new Error("bad length");
+        if (s[0] !== "A" || s[25] !== "Z" || s[9999] !== "P") throw new Error("bad contents");
+    )"sv);
+}
+
+TEST_CASE(rebalanced_rope_keeps_its_order)
+{
+    run_script(R"(
+        let s = "";
+        const front = [];
+        const back = [];
+        for (let i = 0; i < 20000; ++i) {
+            const c = String.fromCharCode(65 + (i % 26));
+            if (i % 3 === 0) {
+                s = c + s;
+                front.push(c);
+            } else {
+                s += c;
+                back.push(c);
+            }
+        }
+        if (s !== front.reverse().join("") + back.join("")) throw new Error("bad contents");
+    )"sv);
+}
+
+TEST_CASE(surrogate_pairs_split_across_a_rebalanced_rope)
+{
+    run_script(R"(
+        let s = "";
+        for (let i = 0; i < 5000; ++i) {
+            s += "\ud83d";
+            s += "\ude00";
+        }
+        if (s.length !== 10000) throw new Error("bad length");
+        if (s !== "\u{1f600}".repeat(5000)) throw new Error("bad contents");
+    )"sv);
+}
+
+// NOTE: These are long enough for flattening a rope every max_rope_depth concatenations to show up as quadratic.
+BENCHMARK_CASE(append_characters_with_plus_equals)
+{
+    run_script(R"(
+        let s = "";
+        for (let i = 0; i < 1000000; ++i)
+            s += "x";
+        if (s.length !== 1000000) throw new Error("bad length");
+    )"sv);
+}
+
+BENCHMARK_CASE(prepend_characters_with_plus)
+{
+    run_script(R"(
+        let s = "";
+        for (let i = 0; i < 1000000; ++i)
+            s = "x" + s;
+        if (s.length !== 1000000) throw new Error("bad length");
+    )"sv);
+}
+
+BENCHMARK_CASE(build_string_with_template_literals)
+{
+    run_script(R"(
+        let s = "";
+        for (let i = 0; i < 100000; ++i)
+            s = `${s}<li>${i}</li>`;
+        if (!s.endsWith("<li>99999</li>")) throw new Error("bad contents");
+    )"sv);
+}
+
+BENCHMARK_CASE(build_string_with_concat)
+{
+    run_script(R"(
+        let s = "";
+        for (let i = 0; i < 100000; ++i)
+            s = s.concat("ab", "cd");
+        if (s.length !== 400000) throw new Error("bad length");
+    )"sv);
+}
+
+BENCHMARK_CASE(build_string_with_array_join)
+{
+    run_script(R"(
+        const parts = [];
+        for (let i = 0; i < 200000; ++i)
+            parts.push("x");
+        if (parts.join("").length !== 200000) throw new Error("bad length");
+    )"sv);
+}
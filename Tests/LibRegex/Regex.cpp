@@ -1103,3 +1103,87 @@ TEST_CASE(inversion_state_in_char_class)
         EXPECT_EQ(result.capture_group_matches.first()[1].view.to_string(), "}"sv);
     }
 }
+
+TEST_CASE(matching_without_backtracking)
+{
+    {
+        // Patterns without backreferences or lookaround don't take exponential time to fail.
+        Regex<ECMA262> re("^(a|aa)*b$"sv);
+        EXPECT_EQ(re.match(String::repeated('a', 100)).success, false);
+        EXPECT_EQ(re.match(String::formatted("{}b", String::repeated('a', 100))).success, true);
+    }
+    {
+        Regex<ECMA262> re("(\\w+)@(?<domain>\\w+)\\.com"sv, ECMAScriptFlags::Global);
+
+        auto result = re.match("mail alice@example.com or bob@test.com"sv);
+        EXPECT_EQ(result.success, true);
+        EXPECT_EQ(result.count, 2u);
+        EXPECT_EQ(result.matches.at(0).view, "alice@example.com"sv);
+        EXPECT_EQ(result.matches.at(0).column, 5u);
+        EXPECT_EQ(result.capture_group_matches.at(0).at(0).view, "alice"sv);
+        EXPECT_EQ(result.capture_group_matches.at(0).at(1).view, "example"sv);
+        EXPECT_EQ(result.capture_group_matches.at(0).at(1).capture_group_name, "domain"sv);
+        EXPECT_EQ(result.matches.at(1).view, "bob@test.com"sv);
+        EXPECT_EQ(result.capture_group_matches.at(1).at(0).view, "bob"sv);
+        EXPECT_EQ(result.capture_group_matches.at(1).at(0).column, 26u);
+    }
+    {
+        // The first match found by backtracking is preferred, not the longest one.
+        Regex<ECMA262> re("(a|ab)(c|bcd)"sv, ECMAScriptFlags::Global);
+
+        auto result = re.match("abcd"sv);
+        EXPECT_EQ(result.count, 1u);
+        EXPECT_EQ(result.matches.at(0).view, "abcd"sv);
+        EXPECT_EQ(result.capture_group_matches.at(0).at(0).view, "a"sv);
+        EXPECT_EQ(result.capture_group_matches.at(0).at(1).view, "bcd"sv);
+    }
+    {
+        Regex<ECMA262> re("\\b\\w+$"sv, ECMAScriptFlags::Global | ECMAScriptFlags::Multiline);
+
+        auto result = re.match("one two\nthree four"sv);
+        EXPECT_EQ(result.count, 2u);
+        EXPECT_EQ(result.matches.at(0).view, "two"sv);
+        EXPECT_EQ(result.matches.at(1).view, "four"sv);
+    }
+    {
+        Regex<ECMA262> re("[ab]*\\w"sv);
+        EXPECT_EQ(re.match("aa"sv).success, true);
+    }
+    {
+        // A plain string with the unicode flag is still looked at byte by byte.
+        Regex<PosixExtended> re(".*"sv);
+        EXPECT_EQ(re.match(String("Pröv+2"sv), PosixFlags::Unicode).success, true);
+    }
+}
+
+TEST_CASE(literal_prefilter)
+{
+    {
+        Regex<ECMA262> re("ERROR: (\\w+)"sv, ECMAScriptFlags::Global);
+        EXPECT_EQ(re.parser_result.optimization_data.literal_prefix, "ERROR: "sv);
+
+        auto result = re.match("INFO: ok\nERROR: disk\nERROR full\nERROR: net"sv);
+        EXPECT_EQ(result.count, 2u);
+        EXPECT_EQ(result.matches.at(0).view, "ERROR: disk"sv);
+        EXPECT_EQ(result.matches.at(0).column, 9u);
+        EXPECT_EQ(result.capture_group_matches.at(1).at(0).view, "net"sv);
+    }
+    {
+        Regex<ECMA262> re("^\\d+ (warn|error) in [a-z]+\\.cpp$"sv);
+        EXPECT_EQ(re.parser_result.optimization_data.literal_prefix, ""sv);
+        EXPECT_EQ(re.parser_result.optimization_data.required_substring, " in "sv);
+
+        EXPECT_EQ(re.match("12 error in main.cpp"sv).success, true);
+        EXPECT_EQ(re.match("12 error in main.c"sv).success, false);
+    }
+    {
+        // Literals in an alternative aren't required, but the first repetition of a group is.
+        Regex<PosixExtended> re("[0-9]+(abc|abd)x(yz)+"sv);
+        EXPECT_EQ(re.parser_result.optimization_data.required_substring, "xyz"sv);
+        EXPECT_EQ(re.match("1abdxyzyz"sv, PosixFlags::Global).success, true);
+    }
+    {
+        Regex<ECMA262> re("hello"sv, ECMAScriptFlags::Global | ECMAScriptFlags::Insensitive);
+        EXPECT_EQ(re.match("say HeLLo"sv).success, true);
+    }
+}
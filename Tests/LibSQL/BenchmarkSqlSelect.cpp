@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <unistd.h>
+
+#include <AK/ScopeGuard.h>
+#include <LibSQL/AST/Parser.h>
+#include <LibSQL/Database.h>
+#include <LibSQL/Result.h>
+#include <LibSQL/ResultSet.h>
+#include <LibSQL/Row.h>
+#include <LibSQL/Value.h>
+#include <LibTest/TestCase.h>
+
+namespace {
+
+constexpr char const* db_name = "/tmp/benchmark.db";
+constexpr int row_count = 50'000;
+constexpr int run_count = 20;
+
+SQL::ResultSet execute(NonnullRefPtr<SQL::Database> database, String const& sql)
+{
+    auto parser = SQL::AST::Parser(SQL::AST::Lexer(sql));
+    auto statement = parser.next_statement();
+    VERIFY(!parser.has_errors());
+    auto result = statement->execute(move(database));
+    VERIFY(!result.is_error());
+    return result.release_value();
+}
+
+// Creates a table with an integer, a float and a text column. If `null_every` is set, every so many rows have
+// a NULL integer, which makes the batches they're in fall back to filtering row by row.
+NonnullRefPtr<SQL::Database> create_synthetic_table(Optional<int> null_every = {})
+{
+    auto database = SQL::Database::construct(db_name);
+    MUST(database->open());
+
+    execute(database, "CREATE SCHEMA BenchmarkSchema;");
+    execute(database, "CREATE TABLE BenchmarkSchema.BenchmarkTable ( IntColumn integer, FloatColumn float, TextColumn text );");
+    auto table = MUST(database->get_table("BENCHMARKSCHEMA", "BENCHMARKTABLE"));
+
+    // NOTE: Rows are inserted directly to keep setting up the table quick.
+    for (int ix = 0; ix < row_count; ++ix) {
+        SQL::Row row(table);
+        if (!null_every.has_value() || ix % *null_every != 0)
+            row["INTCOLUMN"] = ix % 1000;
+        row["FLOATCOLUMN"] = ix * 0.5;
+        row["TEXTCOLUMN"] = String::formatted("Text{}", ix % 100);
+        MUST(database->insert(row));
+    }
+    MUST(database->commit());
+    return database;
+}
+
+void run_query(NonnullRefPtr<SQL::Database> database, StringView sql, size_t expected_rows)
+{
+    for (int run = 0; run < run_count; ++run) {
+        auto result = execute(database, sql);
+        EXPECT_EQ(result.size(), expected_rows);
+    }
+}
+
+}
+
+BENCHMARK_CASE(filter_comparison)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = create_synthetic_table();
+    run_query(database, "SELECT IntColumn FROM BenchmarkSchema.BenchmarkTable WHERE IntColumn < 10;"sv, 500);
+}
+
+BENCHMARK_CASE(filter_conjunction)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = create_synthetic_table();
+    run_query(database, "SELECT IntColumn FROM BenchmarkSchema.BenchmarkTable WHERE (IntColumn >= 500) AND (FloatColumn < 5000);"sv, 5000);
+}
+
+BENCHMARK_CASE(filter_arithmetic)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = create_synthetic_table();
+    run_query(database, "SELECT IntColumn FROM BenchmarkSchema.BenchmarkTable WHERE (FloatColumn * 2) > 49500;"sv, 499);
+}
+
+BENCHMARK_CASE(filter_text)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = create_synthetic_table();
+    run_query(database, "SELECT IntColumn FROM BenchmarkSchema.BenchmarkTable WHERE TextColumn = 'Text42';"sv, 500);
+}
+
+BENCHMARK_CASE(filter_comparison_row_by_row)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = create_synthetic_table(1000);
+    // NOTE: NULL compares less than anything, so the rows with a NULL integer pass the filter as well.
+    run_query(database, "SELECT IntColumn FROM BenchmarkSchema.BenchmarkTable WHERE IntColumn < 10;"sv, 500);
+}
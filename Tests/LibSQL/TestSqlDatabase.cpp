@@ -7,6 +7,7 @@
 #include <unistd.h>
 
 #include <AK/ScopeGuard.h>
+#include <LibCore/Stream.h>
 #include <LibSQL/BTree.h>
 #include <LibSQL/Database.h>
 #include <LibSQL/Heap.h>
@@ -21,6 +22,10 @@ void insert_into_table(SQL::Database&, int);
 void verify_table_contents(SQL::Database&, int);
 void insert_and_verify(int);
 void commit(SQL::Database&);
+ByteBuffer block_contents(u32);
+void write_blocks(SQL::Heap&, u32, u32);
+void verify_blocks(SQL::Heap&, u32, u32);
+void copy_file(StringView, StringView);
 
 NonnullRefPtr<SQL::SchemaDef> setup_schema(SQL::Database& db)
 {
@@ -111,6 +116,41 @@ void insert_and_verify(int count)
     }
 }
 
+ByteBuffer block_contents(u32 block)
+{
+    auto buffer = MUST(ByteBuffer::create_uninitialized(SQL::BLOCKSIZE));
+    buffer.bytes().fill(static_cast<u8>(block));
+    buffer.overwrite(0, &block, sizeof(u32));
+    return buffer;
+}
+
+void write_blocks(SQL::Heap& heap, u32 first_block, u32 count)
+{
+    for (auto block = first_block; block < first_block + count; block++) {
+        EXPECT_EQ(heap.new_record_pointer(), block);
+        auto buffer = block_contents(block);
+        heap.add_to_wal(block, buffer);
+    }
+}
+
+void verify_blocks(SQL::Heap& heap, u32 first_block, u32 count)
+{
+    for (auto block = first_block; block < first_block + count; block++) {
+        auto buffer_or_error = heap.read_block(block);
+        EXPECT(!buffer_or_error.is_error());
+        EXPECT_EQ(buffer_or_error.value(), block_contents(block));
+    }
+}
+
+void copy_file(StringView from, StringView to)
+{
+    auto input = MUST(Core::Stream::File::open(from, Core::Stream::OpenMode::Read));
+    auto contents = MUST(input->read_all());
+    auto output = MUST(Core::Stream::File::open(to, Core::Stream::OpenMode::Write));
+    if (!contents.is_empty())
+        EXPECT(output->write_or_error(contents));
+}
+
 TEST_CASE(create_heap)
 {
     ScopeGuard guard([]() { unlink("/tmp/test.db"); });
@@ -140,6 +180,120 @@ TEST_CASE(create_in_non_existing_dir)
     EXPECT(should_be_error.is_error());
 }
 
+TEST_CASE(heap_page_cache)
+{
+    ScopeGuard guard([]() { unlink("/tmp/test.db"); });
+    auto heap = SQL::Heap::construct("/tmp/test.db");
+    EXPECT(!heap->open().is_error());
+    heap->set_page_cache_capacity(4);
+
+    // Pages that weren't committed yet can't be evicted.
+    write_blocks(heap, 1, 16);
+    EXPECT_EQ(heap->cached_pages(), 17u);
+    verify_blocks(heap, 1, 16);
+    EXPECT(!heap->flush().is_error());
+    EXPECT_EQ(heap->cached_pages(), 4u);
+
+    auto pinned_bytes_or_error = heap->pin_block(1);
+    EXPECT(!pinned_bytes_or_error.is_error());
+    verify_blocks(heap, 2, 15);
+    EXPECT_EQ(heap->cached_pages(), 4u);
+    auto expected_contents = block_contents(1);
+    EXPECT_EQ(pinned_bytes_or_error.value(), expected_contents.bytes());
+    heap->unpin_block(1);
+
+    verify_blocks(heap, 1, 16);
+    EXPECT_EQ(heap->cached_pages(), 4u);
+}
+
+TEST_CASE(heap_grow_pinned_block)
+{
+    ScopeGuard guard([]() { unlink("/tmp/test.db"); });
+    auto heap = SQL::Heap::construct("/tmp/test.db");
+    EXPECT(!heap->open().is_error());
+    write_blocks(heap, 1, 1);
+
+    auto pinned_bytes_or_error = heap->pin_block(1);
+    EXPECT(!pinned_bytes_or_error.is_error());
+    auto pinned_bytes = pinned_bytes_or_error.release_value();
+    auto expected_contents = block_contents(1);
+
+    // Blocks are oversized for a while when a tree node is split. Growing a pinned page must not pull its
+    // contents out from under the pin.
+    for (size_t i = 2; i <= 4; ++i) {
+        auto oversized_block = MUST(ByteBuffer::create_uninitialized(SQL::BLOCKSIZE * i));
+        oversized_block.bytes().fill(static_cast<u8>(i));
+        heap->add_to_wal(1, oversized_block);
+        EXPECT_EQ(pinned_bytes, expected_contents.bytes());
+    }
+    heap->unpin_block(1);
+
+    auto buffer_or_error = heap->read_block(1);
+    EXPECT(!buffer_or_error.is_error());
+    EXPECT_EQ(buffer_or_error.value().size(), SQL::BLOCKSIZE * 4);
+    EXPECT_EQ(buffer_or_error.value()[0], 4u);
+}
+
+TEST_CASE(heap_reopen_after_commit)
+{
+    ScopeGuard guard([]() { unlink("/tmp/test.db"); });
+    {
+        auto heap = SQL::Heap::construct("/tmp/test.db");
+        EXPECT(!heap->open().is_error());
+        write_blocks(heap, 1, 8);
+        heap->set_user_value(0, 42);
+        EXPECT(!heap->flush().is_error());
+        write_blocks(heap, 9, 8);
+    }
+    EXPECT(!Core::Stream::File::exists("/tmp/test.db.wal"sv));
+    {
+        auto heap = SQL::Heap::construct("/tmp/test.db");
+        EXPECT(!heap->open().is_error());
+        EXPECT_EQ(heap->size(), 17u);
+        EXPECT_EQ(heap->user_value(0), 42u);
+        verify_blocks(heap, 1, 16);
+    }
+}
+
+TEST_CASE(heap_recover_from_write_ahead_log)
+{
+    ScopeGuard guard([]() {
+        unlink("/tmp/test.db");
+        unlink("/tmp/test2.db");
+        unlink("/tmp/test2.db.wal");
+    });
+    {
+        auto heap = SQL::Heap::construct("/tmp/test.db");
+        EXPECT(!heap->open().is_error());
+        write_blocks(heap, 1, 8);
+        heap->set_user_value(0, 42);
+        EXPECT(!heap->flush().is_error());
+        write_blocks(heap, 9, 8);
+        heap->set_user_value(0, 43);
+
+        // Copy the files of the heap as if the process had crashed right now: the first commit
+        // is only in the write-ahead log, and the changes after it aren't anywhere.
+        copy_file("/tmp/test.db"sv, "/tmp/test2.db"sv);
+        copy_file("/tmp/test.db.wal"sv, "/tmp/test2.db.wal"sv);
+    }
+
+    // A frame that was torn by the crash is ignored.
+    {
+        auto write_ahead_log = MUST(Core::Stream::File::open("/tmp/test2.db.wal"sv, Core::Stream::OpenMode::Write | Core::Stream::OpenMode::Append));
+        auto garbage = MUST(ByteBuffer::create_zeroed(100));
+        EXPECT(write_ahead_log->write_or_error(garbage));
+    }
+
+    {
+        auto heap = SQL::Heap::construct("/tmp/test2.db");
+        EXPECT(!heap->open().is_error());
+        EXPECT_EQ(heap->size(), 9u);
+        EXPECT_EQ(heap->user_value(0), 42u);
+        verify_blocks(heap, 1, 8);
+    }
+    EXPECT(!Core::Stream::File::exists("/tmp/test2.db.wal"sv));
+}
+
 TEST_CASE(create_database)
 {
     ScopeGuard guard([]() { unlink("/tmp/test.db"); });
@@ -9,6 +9,7 @@
 
 #include <AK/QuickSort.h>
 #include <AK/ScopeGuard.h>
+#include <AK/StringBuilder.h>
 #include <LibSQL/AST/Parser.h>
 #include <LibSQL/Database.h>
 #include <LibSQL/Result.h>
@@ -754,4 +755,259 @@ TEST_CASE(binary_operator_failure)
     expect_failure(move(result), '&');
 }
 
+TEST_CASE(select_with_index)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = SQL::Database::construct(db_name);
+    EXPECT(!database->open().is_error());
+    create_table(database);
+
+    for (auto count = 0; count < 10; ++count) {
+        auto result = execute(database, String::formatted("INSERT INTO TestSchema.TestTable VALUES ( 'T{}', {} );", count, count));
+        EXPECT_EQ(result.size(), 1u);
+    }
+
+    auto result = execute(database, "CREATE INDEX TestSchema.IntIndex ON TestTable ( IntColumn );");
+    EXPECT_EQ(result.command(), SQL::SQLCommand::Create);
+    result = execute(database, "CREATE INDEX TestSchema.TextIndex ON TestTable ( TextColumn DESC );");
+    EXPECT_EQ(result.command(), SQL::SQLCommand::Create);
+
+    // Rows inserted after the index was created have to be found through it as well.
+    for (auto count = 10; count < 20; ++count) {
+        result = execute(database, String::formatted("INSERT INTO TestSchema.TestTable VALUES ( 'T{}', {} );", count, count));
+        EXPECT_EQ(result.size(), 1u);
+    }
+
+    auto compare_result = [](SQL::ResultSet const& result, Vector<int> const& expected) {
+        EXPECT_EQ(result.command(), SQL::SQLCommand::Select);
+        EXPECT_EQ(result.size(), expected.size());
+
+        Vector<int> result_values;
+        for (auto& row : result)
+            result_values.append(row.row[0].to_int().value());
+
+        quick_sort(result_values);
+        EXPECT_EQ(result_values, expected);
+    };
+
+    result = execute(database, "SELECT IntColumn FROM TestSchema.TestTable WHERE IntColumn = 4;");
+    compare_result(result, { 4 });
+
+    result = execute(database, "SELECT IntColumn FROM TestSchema.TestTable WHERE 15 = IntColumn;");
+    compare_result(result, { 15 });
+
+    // NOTE: The parser doesn't know about operator precedence, so the terms of a conjunction have to be parenthesized.
+    result = execute(database, "SELECT IntColumn FROM TestSchema.TestTable WHERE (IntColumn > 7) AND (IntColumn <= 12);");
+    compare_result(result, { 8, 9, 10, 11, 12 });
+
+    result = execute(database, "SELECT IntColumn FROM TestSchema.TestTable WHERE (IntColumn < 3) AND (TextColumn != 'T1');");
+    compare_result(result, { 0, 2 });
+
+    result = execute(database, "SELECT IntColumn FROM TestSchema.TestTable WHERE IntColumn = 'Nope';");
+    compare_result(result, {});
+
+    result = execute(database, "SELECT IntColumn FROM TestSchema.TestTable WHERE TextColumn >= 'T17';");
+    compare_result(result, { 2, 3, 4, 5, 6, 7, 8, 9, 17, 18, 19 });
+
+    result = execute(database, "SELECT IntColumn FROM TestSchema.TestTable WHERE (TextColumn > 'T15') AND (TextColumn < 'T3');");
+    compare_result(result, { 2, 16, 17, 18, 19 });
+}
+
+TEST_CASE(unique_index)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = SQL::Database::construct(db_name);
+    EXPECT(!database->open().is_error());
+    create_table(database);
+
+    auto result = execute(database, "INSERT INTO TestSchema.TestTable VALUES ( 'T1', 1 ), ( 'T2', 2 ), ( 'T2', 3 );");
+    EXPECT_EQ(result.size(), 3u);
+
+    auto create_result = try_execute(database, "CREATE UNIQUE INDEX TestSchema.TextIndex ON TestTable ( TextColumn );");
+    EXPECT(create_result.is_error());
+    EXPECT_EQ(create_result.release_error().error(), SQL::SQLErrorCode::InternalError);
+
+    result = execute(database, "CREATE UNIQUE INDEX TestSchema.IntIndex ON TestTable ( IntColumn );");
+    EXPECT_EQ(result.command(), SQL::SQLCommand::Create);
+
+    create_result = try_execute(database, "CREATE INDEX TestSchema.IntIndex ON TestTable ( TextColumn );");
+    EXPECT(create_result.is_error());
+    EXPECT_EQ(create_result.release_error().error(), SQL::SQLErrorCode::IndexExists);
+
+    result = execute(database, "CREATE INDEX IF NOT EXISTS TestSchema.IntIndex ON TestTable ( TextColumn );");
+    EXPECT_EQ(result.command(), SQL::SQLCommand::Create);
+
+    auto insert_result = try_execute(database, "INSERT INTO TestSchema.TestTable VALUES ( 'T4', 2 );");
+    EXPECT(insert_result.is_error());
+    EXPECT_EQ(insert_result.release_error().error(), SQL::SQLErrorCode::InternalError);
+
+    result = execute(database, "INSERT INTO TestSchema.TestTable VALUES ( 'T4', 4 );");
+    EXPECT_EQ(result.size(), 1u);
+
+    result = execute(database, "SELECT TextColumn FROM TestSchema.TestTable WHERE IntColumn = 2;");
+    EXPECT_EQ(result.size(), 1u);
+    EXPECT_EQ(result[0].row[0].to_string(), "T2");
+}
+
+TEST_CASE(explain_query_plan)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = SQL::Database::construct(db_name);
+    EXPECT(!database->open().is_error());
+    create_two_tables(database);
+
+    auto result = execute(database, "CREATE INDEX TestSchema.IntIndex ON TestTable2 ( IntColumn, TextColumn2 );");
+    EXPECT_EQ(result.command(), SQL::SQLCommand::Create);
+
+    auto expect_plan = [&](String const& sql, Vector<String> const& expected) {
+        auto result = execute(database, sql);
+        EXPECT_EQ(result.command(), SQL::SQLCommand::Explain);
+        EXPECT_EQ(result.size(), expected.size());
+        for (size_t i = 0; i < min(result.size(), expected.size()); ++i)
+            EXPECT_EQ(result[i].row[0].to_string(), expected[i]);
+    };
+
+    expect_plan("EXPLAIN QUERY PLAN SELECT * FROM TestSchema.TestTable2;",
+        { "SCAN TABLE TESTSCHEMA.TESTTABLE2" });
+    expect_plan("EXPLAIN QUERY PLAN SELECT * FROM TestSchema.TestTable2 WHERE TextColumn2 = 'Test';",
+        { "SCAN TABLE TESTSCHEMA.TESTTABLE2" });
+    expect_plan("EXPLAIN QUERY PLAN SELECT * FROM TestSchema.TestTable2 WHERE (IntColumn = 42) AND (TextColumn2 > 'Test');",
+        { "SEARCH TABLE TESTSCHEMA.TESTTABLE2 USING INDEX INTINDEX (INTCOLUMN=? AND TEXTCOLUMN2>?)" });
+    expect_plan("EXPLAIN SELECT * FROM TestSchema.TestTable2 WHERE (IntColumn >= 42) AND (IntColumn < 50);",
+        { "SEARCH TABLE TESTSCHEMA.TESTTABLE2 USING INDEX INTINDEX (INTCOLUMN>=? AND INTCOLUMN<?)" });
+
+    // The table with the index is searched for every row of the other one, no matter the order they are listed in.
+    expect_plan("EXPLAIN QUERY PLAN SELECT * FROM TestSchema.TestTable2, TestSchema.TestTable1 WHERE TestTable1.IntColumn = TestTable2.IntColumn;",
+        { "SCAN TABLE TESTSCHEMA.TESTTABLE1", "SEARCH TABLE TESTSCHEMA.TESTTABLE2 USING INDEX INTINDEX (INTCOLUMN=?)" });
+}
+
+TEST_CASE(select_join_with_index)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = SQL::Database::construct(db_name);
+    EXPECT(!database->open().is_error());
+    create_two_tables(database);
+    auto result = execute(database,
+        "INSERT INTO TestSchema.TestTable1 ( TextColumn1, IntColumn ) VALUES "
+        "( 'Test_1', 42 ), "
+        "( 'Test_3', 44 ), "
+        "( 'Test_2', 43 ), "
+        "( 'Test_4', 45 ), "
+        "( 'Test_5', 46 );");
+    EXPECT(result.size() == 5);
+    result = execute(database, "CREATE INDEX TestSchema.IntIndex ON TestTable2 ( IntColumn );");
+    EXPECT_EQ(result.command(), SQL::SQLCommand::Create);
+    result = execute(database,
+        "INSERT INTO TestSchema.TestTable2 ( TextColumn2, IntColumn ) VALUES "
+        "( 'Test_10', 40 ), "
+        "( 'Test_11', 42 ), "
+        "( 'Test_12', 42 ), "
+        "( 'Test_13', 47 ), "
+        "( 'Test_14', 46 );");
+    EXPECT(result.size() == 5);
+    result = execute(database,
+        "SELECT TestTable1.TextColumn1, TestTable2.TextColumn2 FROM TestSchema.TestTable2, TestSchema.TestTable1 "
+        "WHERE (TestTable1.IntColumn = TestTable2.IntColumn) AND (TestTable1.TextColumn1 != 'Test_2') "
+        "ORDER BY TestTable2.TextColumn2;");
+    EXPECT_EQ(result.size(), 3u);
+    EXPECT_EQ(result[0].row[0].to_string(), "Test_1");
+    EXPECT_EQ(result[0].row[1].to_string(), "Test_11");
+    EXPECT_EQ(result[1].row[0].to_string(), "Test_1");
+    EXPECT_EQ(result[1].row[1].to_string(), "Test_12");
+    EXPECT_EQ(result[2].row[0].to_string(), "Test_5");
+    EXPECT_EQ(result[2].row[1].to_string(), "Test_14");
+}
+
+TEST_CASE(index_persists)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    {
+        auto database = SQL::Database::construct(db_name);
+        EXPECT(!database->open().is_error());
+        create_table(database);
+        auto result = execute(database, "CREATE UNIQUE INDEX TestSchema.IntIndex ON TestTable ( IntColumn DESC );");
+        EXPECT_EQ(result.command(), SQL::SQLCommand::Create);
+        for (auto count = 0; count < 100; ++count) {
+            result = execute(database, String::formatted("INSERT INTO TestSchema.TestTable VALUES ( 'T{}', {} );", count, count));
+            EXPECT_EQ(result.size(), 1u);
+        }
+        EXPECT(!database->commit().is_error());
+    }
+    {
+        auto database = SQL::Database::construct(db_name);
+        EXPECT(!database->open().is_error());
+
+        auto table = MUST(database->get_table("TESTSCHEMA", "TESTTABLE"));
+        EXPECT_EQ(table->num_indexes(), 1u);
+        EXPECT_EQ(table->indexes()[0].name(), "INTINDEX");
+        EXPECT(table->indexes()[0].unique());
+        EXPECT_EQ(table->indexes()[0].key_definition()[0].sort_order(), SQL::Order::Descending);
+
+        auto result = execute(database, "EXPLAIN SELECT TextColumn FROM TestSchema.TestTable WHERE IntColumn > 96;");
+        EXPECT_EQ(result.size(), 1u);
+        EXPECT_EQ(result[0].row[0].to_string(), "SEARCH TABLE TESTSCHEMA.TESTTABLE USING INDEX INTINDEX (INTCOLUMN>?)");
+
+        result = execute(database, "SELECT TextColumn FROM TestSchema.TestTable WHERE IntColumn > 96 ORDER BY IntColumn;");
+        EXPECT_EQ(result.size(), 3u);
+        EXPECT_EQ(result[0].row[0].to_string(), "T97");
+        EXPECT_EQ(result[1].row[0].to_string(), "T98");
+        EXPECT_EQ(result[2].row[0].to_string(), "T99");
+
+        auto insert_result = try_execute(database, "INSERT INTO TestSchema.TestTable VALUES ( 'Duplicate', 50 );");
+        EXPECT(insert_result.is_error());
+    }
+}
+
+TEST_CASE(select_with_batch_filters)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = SQL::Database::construct(db_name);
+    EXPECT(!database->open().is_error());
+    create_table(database);
+
+    // Enough rows to fill a few batches, the last one only partially.
+    StringBuilder builder;
+    builder.append("INSERT INTO TestSchema.TestTable VALUES "sv);
+    for (auto count = 0; count < 2500; ++count)
+        builder.appendff("{}( 'T{}', {} )", count == 0 ? "" : ", ", count, count);
+    builder.append(';');
+    auto result = execute(database, builder.build());
+    EXPECT_EQ(result.size(), 2500u);
+
+    auto compare_result = [](SQL::ResultSet const& result, Vector<int> const& expected) {
+        EXPECT_EQ(result.command(), SQL::SQLCommand::Select);
+        EXPECT_EQ(result.size(), expected.size());
+
+        Vector<int> result_values;
+        for (auto& row : result)
+            result_values.append(row.row[0].to_int().value_or(-1));
+
+        quick_sort(result_values);
+        EXPECT_EQ(result_values, expected);
+    };
+
+    result = execute(database, "SELECT IntColumn FROM TestSchema.TestTable WHERE IntColumn >= 2497;");
+    compare_result(result, { 2497, 2498, 2499 });
+
+    result = execute(database, "SELECT IntColumn FROM TestSchema.TestTable WHERE (IntColumn * 2) < 5;");
+    compare_result(result, { 0, 1, 2 });
+
+    result = execute(database, "SELECT IntColumn FROM TestSchema.TestTable WHERE TextColumn = 'T1234';");
+    compare_result(result, { 1234 });
+
+    result = execute(database, "SELECT IntColumn FROM TestSchema.TestTable WHERE (IntColumn < 2) OR (IntColumn > 2497);");
+    compare_result(result, { 0, 1, 2498, 2499 });
+
+    result = execute(database, "SELECT IntColumn FROM TestSchema.TestTable WHERE (IntColumn > 1020) AND (TextColumn LIKE 'T102_');");
+    compare_result(result, { 1021, 1022, 1023, 1024, 1025, 1026, 1027, 1028, 1029 });
+
+    // A NULL in the batch makes it fall back to checking the filters row by row, where NULL compares less than anything.
+    result = execute(database, "INSERT INTO TestSchema.TestTable ( TextColumn ) VALUES ( 'Null' );");
+    EXPECT_EQ(result.size(), 1u);
+    result = execute(database, "SELECT IntColumn FROM TestSchema.TestTable WHERE IntColumn < 2;");
+    compare_result(result, { -1, 0, 1 });
+    result = execute(database, "SELECT IntColumn FROM TestSchema.TestTable WHERE IntColumn >= 2497;");
+    compare_result(result, { 2497, 2498, 2499 });
+}
+
 }
@@ -7,11 +7,22 @@
 #include <LibCore/Stream.h>
 #include <LibTest/JavaScriptTestRunner.h>
 #include <LibWasm/AbstractMachine/BytecodeInterpreter.h>
+#include <LibWasm/AbstractMachine/JITInterpreter.h>
 #include <LibWasm/Types.h>
 #include <string.h>
 
 TEST_ROOT("Userland/Libraries/LibWasm/Tests");
 
+TESTJS_PROGRAM_FLAG(use_jit, "Run functions as compiled machine code wherever possible", "jit", 0);
+
+static bool s_should_deoptimize_after_calls { false };
+
+TESTJS_GLOBAL_FUNCTION(set_deoptimize_after_calls, setDeoptimizeAfterCalls)
+{
+    s_should_deoptimize_after_calls = vm.argument(0).to_boolean();
+    return JS::js_undefined();
+}
+
 TESTJS_GLOBAL_FUNCTION(read_binary_wasm_file, readBinaryWasmFile)
 {
     auto& realm = *vm.current_realm();
@@ -33,6 +44,23 @@ TESTJS_GLOBAL_FUNCTION(read_binary_wasm_file, readBinaryWasmFile)
     return JS::Value(array);
 }
 
+// NOTE: v128 values are passed around as (unsigned) BigInts, with lane 0 in the lowest bits.
+static JS::Value vector_to_bigint(JS::VM& vm, u128 value)
+{
+    auto bigint = Crypto::UnsignedBigInteger { value.high() }.shift_left(64).plus(Crypto::UnsignedBigInteger { value.low() });
+    return JS::js_bigint(vm, Crypto::SignedBigInteger { move(bigint) });
+}
+
+static JS::ThrowCompletionOr<u128> bigint_to_vector(JS::VM& vm, JS::Value value)
+{
+    auto* bigint = TRY(value.to_bigint(vm));
+    auto& words = bigint->big_integer().unsigned_value().words();
+    if (bigint->big_integer().is_negative() || bigint->big_integer().unsigned_value().trimmed_length() > 4)
+        return vm.throw_completion<JS::TypeError>("Expected a v128 value as an unsigned 128-bit BigInt");
+    auto word = [&](size_t index) -> u64 { return index < words.size() ? words[index] : 0; };
+    return u128 { word(0) | (word(1) << 32), word(2) | (word(3) << 32) };
+}
+
 class WebAssemblyModule final : public JS::Object {
     JS_OBJECT(WebAssemblyModule, JS::Object);
 
@@ -71,6 +99,7 @@ public:
 private:
     JS_DECLARE_NATIVE_FUNCTION(get_export);
     JS_DECLARE_NATIVE_FUNCTION(wasm_invoke);
+    JS_DECLARE_NATIVE_FUNCTION(wasm_invoke_lowered);
 
     static HashMap<Wasm::Linker::Name, Wasm::ExternValue> const& spec_test_namespace()
     {
@@ -155,6 +184,7 @@ void WebAssemblyModule::initialize(JS::Realm& realm)
     Base::initialize(realm);
     define_native_function(realm, "getExport", get_export, 1, JS::default_attributes);
     define_native_function(realm, "invoke", wasm_invoke, 1, JS::default_attributes);
+    define_native_function(realm, "invokeLowered", wasm_invoke_lowered, 1, JS::default_attributes);
 }
 
 JS_DEFINE_NATIVE_FUNCTION(WebAssemblyModule::get_export)
@@ -175,19 +205,32 @@ JS_DEFINE_NATIVE_FUNCTION(WebAssemblyModule::get_export)
                     [&](auto const& value) -> JS::Value { return JS::Value(static_cast<double>(value)); },
                     [&](i32 value) { return JS::Value(static_cast<double>(value)); },
                     [&](i64 value) -> JS::Value { return JS::js_bigint(vm, Crypto::SignedBigInteger { value }); },
+                    [&](u128 value) -> JS::Value { return vector_to_bigint(vm, value); },
                     [&](Wasm::Reference const& reference) -> JS::Value {
                         return reference.ref().visit(
                             [&](const Wasm::Reference::Null&) -> JS::Value { return JS::js_null(); },
                             [&](const auto& ref) -> JS::Value { return JS::Value(static_cast<double>(ref.address.value())); });
                     });
             }
-            return vm.throw_completion<JS::TypeError>(String::formatted("'{}' does not refer to a function or a global", name));
+            if (auto v = value.get_pointer<Wasm::MemoryAddress>()) {
+                auto& realm = *vm.current_realm();
+                auto* memory = m_machine.store().get(*v);
+                if (memory->is_guarded())
+                    return JS::ArrayBuffer::create_with_external_storage(realm, memory->data());
+                return JS::ArrayBuffer::create(realm, &memory->buffer());
+            }
+            return vm.throw_completion<JS::TypeError>(String::formatted("'{}' does not refer to a function, a global or a memory", name));
         }
     }
     return vm.throw_completion<JS::TypeError>(String::formatted("'{}' could not be found", name));
 }
 
-JS_DEFINE_NATIVE_FUNCTION(WebAssemblyModule::wasm_invoke)
+enum class ShouldLimitInstructionCount {
+    No,
+    Yes,
+};
+
+static JS::ThrowCompletionOr<JS::Value> invoke(JS::VM& vm, ShouldLimitInstructionCount should_limit_instruction_count)
 {
     auto address = static_cast<unsigned long>(TRY(vm.argument(0).to_double(vm)));
     Wasm::FunctionAddress function_address { address };
@@ -239,10 +282,28 @@ JS_DEFINE_NATIVE_FUNCTION(WebAssemblyModule::wasm_invoke)
         case Wasm::ValueType::Kind::NullExternReference:
             arguments.append(Wasm::Value(Wasm::Reference { Wasm::Reference::Null { Wasm::ValueType(Wasm::ValueType::Kind::ExternReference) } }));
             break;
+        case Wasm::ValueType::Kind::V128:
+            arguments.append(Wasm::Value(TRY(bigint_to_vector(vm, argument))));
+            break;
         }
     }
 
-    auto result = WebAssemblyModule::machine().invoke(function_address, arguments);
+    auto call = [&](Wasm::Interpreter& interpreter) {
+        if (should_limit_instruction_count == ShouldLimitInstructionCount::Yes)
+            return WebAssemblyModule::machine().invoke(interpreter, function_address, arguments);
+        Wasm::Configuration configuration { WebAssemblyModule::machine().store() };
+        return configuration.call(interpreter, function_address, arguments);
+    };
+
+    Wasm::Result result { Wasm::Trap {} };
+    if (use_jit) {
+        Wasm::JITInterpreter interpreter;
+        interpreter.set_should_deoptimize_after_calls(s_should_deoptimize_after_calls);
+        result = call(interpreter);
+    } else {
+        Wasm::BytecodeInterpreter interpreter;
+        result = call(interpreter);
+    }
     if (result.is_trap())
         return vm.throw_completion<JS::TypeError>(String::formatted("Execution trapped: {}", result.trap().reason));
 
@@ -254,6 +315,7 @@ JS_DEFINE_NATIVE_FUNCTION(WebAssemblyModule::wasm_invoke)
         [&](auto const& value) { return_value = JS::Value(static_cast<double>(value)); },
         [&](i32 value) { return_value = JS::Value(static_cast<double>(value)); },
         [&](i64 value) { return_value = JS::Value(JS::js_bigint(vm, Crypto::SignedBigInteger { value })); },
+        [&](u128 value) { return_value = vector_to_bigint(vm, value); },
         [&](Wasm::Reference const& reference) {
             reference.ref().visit(
                 [&](const Wasm::Reference::Null&) { return_value = JS::js_null(); },
@@ -261,3 +323,15 @@ JS_DEFINE_NATIVE_FUNCTION(WebAssemblyModule::wasm_invoke)
         });
     return return_value;
 }
+
+// NOTE: The machine limits how many instructions a call may execute, and only the old interpreter loop can count them.
+JS_DEFINE_NATIVE_FUNCTION(WebAssemblyModule::wasm_invoke)
+{
+    return invoke(vm, ShouldLimitInstructionCount::Yes);
+}
+
+// Runs the function in its lowered form (or as compiled code with --jit), which is what everything outside of tests does.
+JS_DEFINE_NATIVE_FUNCTION(WebAssemblyModule::wasm_invoke_lowered)
+{
+    return invoke(vm, ShouldLimitInstructionCount::No);
+}
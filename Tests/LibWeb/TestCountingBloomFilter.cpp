@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/Vector.h>
+#include <LibWeb/CSS/CountingBloomFilter.h>
+
+// NOTE: This is the filter StyleComputer keeps of the ancestors of an element. A hash that has been added and not
+//       removed again must always be reported, or a selector that matches would be rejected.
+using Filter = Web::CSS::CountingBloomFilter<u8, 12>;
+
+// Both bucket indices of a hash, picked the same way the filter does it.
+static u32 make_hash(u32 first_bucket, u32 second_bucket)
+{
+    return (second_bucket << 16) | first_bucket;
+}
+
+TEST_CASE(added_hashes_are_reported)
+{
+    Filter filter;
+    EXPECT(!filter.may_contain(make_hash(1, 2)));
+
+    Vector<u32> hashes;
+    for (u32 i = 0; i < 1000; ++i)
+        hashes.append(i * 2654435761u);
+    for (auto hash : hashes)
+        filter.add(hash);
+    for (auto hash : hashes)
+        EXPECT(filter.may_contain(hash));
+
+    // Taking them off again in stack order, like the ancestors on the way back up the tree, keeps the rest.
+    while (!hashes.is_empty()) {
+        filter.remove(hashes.take_last());
+        for (auto hash : hashes)
+            EXPECT(filter.may_contain(hash));
+    }
+}
+
+TEST_CASE(removing_a_hash_keeps_hashes_that_share_its_buckets)
+{
+    Filter filter;
+    auto first = make_hash(5, 7);
+    auto shares_first_bucket = make_hash(5, 9);
+    auto shares_both_buckets = make_hash(7, 5);
+
+    filter.add(first);
+    filter.add(shares_first_bucket);
+    filter.add(shares_both_buckets);
+
+    filter.remove(first);
+    EXPECT(filter.may_contain(shares_first_bucket));
+    EXPECT(filter.may_contain(shares_both_buckets));
+
+    filter.remove(shares_first_bucket);
+    EXPECT(filter.may_contain(shares_both_buckets));
+
+    filter.remove(shares_both_buckets);
+    EXPECT(!filter.may_contain(first));
+    EXPECT(!filter.may_contain(shares_first_bucket));
+    EXPECT(!filter.may_contain(shares_both_buckets));
+}
+
+TEST_CASE(saturated_buckets_are_never_emptied)
+{
+    Filter filter;
+    auto often_added = make_hash(3, 4);
+    auto shares_a_bucket = make_hash(3, 11);
+
+    // More ancestors with the same class than a counter can count.
+    for (size_t i = 0; i < 300; ++i)
+        filter.add(often_added);
+    filter.add(shares_a_bucket);
+
+    for (size_t i = 0; i < 300; ++i)
+        filter.remove(often_added);
+    EXPECT(filter.may_contain(shares_a_bucket));
+
+    // The counters never drop back to zero, so the filter keeps erring on the side of a false positive.
+    filter.remove(shares_a_bucket);
+    EXPECT(filter.may_contain(often_added));
+}
+
+TEST_CASE(clear)
+{
+    Filter filter;
+    filter.add(make_hash(1, 2));
+    for (size_t i = 0; i < 300; ++i)
+        filter.add(make_hash(3, 4));
+    filter.clear();
+    EXPECT(!filter.may_contain(make_hash(1, 2)));
+    EXPECT(!filter.may_contain(make_hash(3, 4)));
+}
@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/NonnullOwnPtr.h>
+#include <LibCore/EventLoop.h>
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/Font/FontDatabase.h>
+#include <LibGfx/Painter.h>
+#include <LibGfx/Palette.h>
+#include <LibGfx/SystemTheme.h>
+#include <LibWeb/DOM/Document.h>
+#include <LibWeb/HTML/BrowsingContext.h>
+#include <LibWeb/Layout/InitialContainingBlock.h>
+#include <LibWeb/Page/Page.h>
+#include <LibWeb/Painting/PaintContext.h>
+#include <LibWeb/Platform/EventLoopPluginSerenity.h>
+#include <LibWeb/Platform/FontPluginSerenity.h>
+
+static Gfx::IntRect const viewport_rect { 0, 0, 300, 200 };
+
+// Everything the test page paints is inside this rect.
+static Gfx::IntRect const page_rect { 0, 0, 300, 800 };
+
+static constexpr auto test_page = R"(<!DOCTYPE html>
+<html>
+    <head>
+        <style>
+            body { margin: 0; width: 300px; height: 800px; }
+            div { box-sizing: border-box; }
+            .block { height: 60px; margin: 10px; background: rgb(200, 220, 255); border: 3px solid rgb(0, 0, 128); }
+            .clip { overflow: hidden; height: 50px; background: rgb(255, 240, 200); }
+            .tall { height: 300px; background: rgb(0, 160, 0); }
+            .overflowing-text { height: 10px; white-space: nowrap; }
+            .shadow { box-shadow: 20px 20px 0 rgb(64, 64, 64); outline: 4px solid rgb(255, 0, 255); }
+            .text-shadow { text-shadow: 30px 10px rgb(255, 128, 0); }
+            .positioned { position: absolute; top: 430px; left: 200px; width: 60px; height: 60px; z-index: 2; background: rgb(255, 0, 0); }
+            .below { position: absolute; top: 450px; left: 180px; width: 60px; height: 60px; z-index: 1; background: rgb(0, 0, 255); }
+            .translucent { opacity: 0.5; background: rgb(0, 0, 0); height: 40px; }
+            .transformed { transform: translate(40px, 20px); background: rgb(128, 0, 128); width: 50px; height: 50px; }
+            .float { float: right; width: 80px; height: 80px; background: rgb(0, 128, 128); }
+            .clipped { position: absolute; top: 700px; left: 10px; width: 100px; height: 60px; clip: rect(10px, 50px, 40px, 0px); background: rgb(255, 255, 0); }
+        </style>
+    </head>
+    <body>
+        <div class="block">Some text in a block</div>
+        <div class="clip"><div class="tall">Text in a box taller than the one clipping it</div></div>
+        <div class="block overflowing-text">A line of text that is far too long to fit into the box around it, and overflows it</div>
+        <div class="block shadow">A box with a shadow and an outline</div>
+        <div class="block text-shadow">Text with a shadow</div>
+        <div class="float"></div>
+        <div class="translucent">Translucent</div>
+        <div class="transformed"></div>
+        <span>Some inline text<br>that wraps over<br>several lines</span>
+        <div class="below"></div>
+        <div class="positioned"></div>
+        <div class="clipped"></div>
+    </body>
+</html>
+)"sv;
+
+// The root element's background covers the whole canvas, even though the root element's box is much smaller.
+static constexpr auto root_background_page = R"(<!DOCTYPE html>
+<html>
+    <head>
+        <style>
+            html { height: 50px; margin-left: 100px; background: linear-gradient(to bottom, rgb(255, 0, 0), rgb(0, 0, 255)); }
+            body { margin: 0; }
+        </style>
+    </head>
+    <body></body>
+</html>
+)"sv;
+
+class TestPageClient final : public Web::PageClient {
+public:
+    TestPageClient()
+        : m_page(make<Web::Page>(*this))
+        , m_palette_impl(Gfx::PaletteImpl::create_with_anonymous_buffer(Gfx::load_system_theme("/res/themes/Default.ini")))
+    {
+        m_page->top_level_browsing_context().set_viewport_rect(viewport_rect);
+        load(test_page);
+    }
+
+    void load(StringView html) { m_page->load_html(html, AK::URL("about:blank")); }
+
+    Web::DOM::Document& document() { return *m_page->top_level_browsing_context().active_document(); }
+
+    // NOTE: This paints the same way WebContent paints the page or one of its tiles.
+    NonnullRefPtr<Gfx::Bitmap> paint(Gfx::IntRect const& content_rect)
+    {
+        document().update_layout();
+
+        auto bitmap = MUST(Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRx8888, content_rect.size()));
+        Gfx::Painter painter(*bitmap);
+        painter.fill_rect({ {}, content_rect.size() }, document().background_color(palette()));
+
+        auto viewport_rect = m_page->top_level_browsing_context().viewport_rect();
+        painter.translate(viewport_rect.location() - content_rect.location());
+
+        Web::PaintContext context(painter, palette(), viewport_rect.location());
+        context.set_viewport_rect(viewport_rect);
+        context.set_has_focus(true);
+        document().layout_node()->paint_all_phases(context);
+        return bitmap;
+    }
+
+    void scroll_to(Gfx::IntPoint const& position)
+    {
+        m_page->top_level_browsing_context().set_viewport_rect({ position, viewport_rect.size() });
+    }
+
+    // ^Web::PageClient
+    virtual Gfx::Palette palette() const override { return Gfx::Palette(*m_palette_impl); }
+    virtual Gfx::IntRect screen_rect() const override { return viewport_rect; }
+    virtual Web::CSS::PreferredColorScheme preferred_color_scheme() const override { return Web::CSS::PreferredColorScheme::Auto; }
+    virtual void request_file(NonnullRefPtr<Web::FileRequest>&) override { }
+
+private:
+    NonnullOwnPtr<Web::Page> m_page;
+    NonnullRefPtr<Gfx::PaletteImpl> m_palette_impl;
+};
+
+static TestPageClient& page_client()
+{
+    // NOTE: LibWeb needs an event loop to create its timers on, even though nothing here ever runs it.
+    static Core::EventLoop event_loop;
+    static auto* page_client = [] {
+        Web::Platform::EventLoopPlugin::install(*new Web::Platform::EventLoopPluginSerenity);
+        Web::Platform::FontPlugin::install(*new Web::Platform::FontPluginSerenity);
+        // NOTE: These are what WindowServer hands to WebContent by default.
+        Gfx::FontDatabase::set_default_font_query("Katica 10 400 0");
+        Gfx::FontDatabase::set_window_title_font_query("Katica 10 700 0");
+        Gfx::FontDatabase::set_fixed_width_font_query("Csilla 10 400 0");
+        return new TestPageClient;
+    }();
+    return *page_client;
+}
+
+static size_t count_differing_pixels(Gfx::Bitmap const& expected, Gfx::IntPoint const& expected_offset, Gfx::Bitmap const& actual)
+{
+    size_t differing_pixels = 0;
+    for (int y = 0; y < actual.height(); ++y) {
+        for (int x = 0; x < actual.width(); ++x) {
+            if (expected.get_pixel(expected_offset.x() + x, expected_offset.y() + y) != actual.get_pixel(x, y))
+                ++differing_pixels;
+        }
+    }
+    return differing_pixels;
+}
+
+// NOTE: When the whole page is painted at once, nothing is out of view, so replaying the display list paints every
+//       paintable just like painting the layout tree directly did. Painting only part of the page skips whatever is
+//       out of view, which must not change a single pixel of the part that is painted.
+
+TEST_CASE(painting_tiles_matches_painting_everything)
+{
+    auto& client = page_client();
+    auto reference = client.paint(page_rect);
+
+    // NOTE: The odd tile size makes tile edges cut through boxes, text and shadows at different places.
+    static constexpr Gfx::IntSize tile_size { 37, 29 };
+    for (int y = 0; y < page_rect.height(); y += tile_size.height()) {
+        for (int x = 0; x < page_rect.width(); x += tile_size.width()) {
+            auto tile_rect = Gfx::IntRect { { x, y }, tile_size }.intersected(page_rect);
+            auto tile = client.paint(tile_rect);
+            auto differing_pixels = count_differing_pixels(*reference, tile_rect.location(), *tile);
+            if (differing_pixels != 0)
+                warnln("Tile {} differs in {} pixels", tile_rect, differing_pixels);
+            EXPECT_EQ(differing_pixels, 0u);
+        }
+    }
+}
+
+TEST_CASE(painting_a_scrolled_viewport_matches_painting_everything)
+{
+    auto& client = page_client();
+    auto reference = client.paint(page_rect);
+
+    for (int scroll_offset = 0; scroll_offset + viewport_rect.height() <= page_rect.height(); scroll_offset += 45) {
+        auto scrolled_viewport_rect = viewport_rect.translated(0, scroll_offset);
+        client.scroll_to(scrolled_viewport_rect.location());
+        auto viewport = client.paint(scrolled_viewport_rect);
+        EXPECT_EQ(count_differing_pixels(*reference, scrolled_viewport_rect.location(), *viewport), 0u);
+    }
+    client.scroll_to({});
+}
+
+TEST_CASE(painting_tiles_while_scrolled_matches_painting_everything)
+{
+    auto& client = page_client();
+    auto reference = client.paint(page_rect);
+
+    // NOTE: WebContent keeps tiles painted while the page was scrolled elsewhere, they have to look the same.
+    client.scroll_to({ 0, 300 });
+    for (int y = 0; y < page_rect.height(); y += 256) {
+        auto tile_rect = Gfx::IntRect { 0, y, page_rect.width(), 256 }.intersected(page_rect);
+        EXPECT_EQ(count_differing_pixels(*reference, tile_rect.location(), client.paint(tile_rect)), 0u);
+    }
+    client.scroll_to({});
+}
+
+TEST_CASE(repainting_matches_painting_everything)
+{
+    auto& client = page_client();
+    auto reference = client.paint(page_rect);
+
+    // Replaying the same display list again has to give the same result.
+    EXPECT_EQ(count_differing_pixels(*reference, {}, client.paint(page_rect)), 0u);
+
+    // So does recording a new one once the stacking context tree has been thrown away.
+    client.document().invalidate_stacking_context_tree();
+    EXPECT_EQ(count_differing_pixels(*reference, {}, client.paint(page_rect)), 0u);
+}
+
+TEST_CASE(painting_tiles_outside_of_the_root_element_matches_painting_everything)
+{
+    auto& client = page_client();
+    client.load(root_background_page);
+    auto reference = client.paint(viewport_rect);
+
+    static constexpr Gfx::IntSize tile_size { 37, 29 };
+    for (int y = 0; y < viewport_rect.height(); y += tile_size.height()) {
+        for (int x = 0; x < viewport_rect.width(); x += tile_size.width()) {
+            auto tile_rect = Gfx::IntRect { { x, y }, tile_size }.intersected(viewport_rect);
+            EXPECT_EQ(count_differing_pixels(*reference, tile_rect.location(), client.paint(tile_rect)), 0u);
+        }
+    }
+    client.load(test_page);
+}
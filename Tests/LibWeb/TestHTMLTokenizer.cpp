@@ -197,6 +197,29 @@ TEST_CASE(doctype)
     EXPECT_END_TAG_TOKEN(html);
 }
 
+TEST_CASE(long_runs_of_characters)
+{
+    auto tokens = run_tokenizer("<p title=\"a fairly long attribute &amp; value\">Text that is longer than 16 characters\r\nwith \xc3\xa9 &amp; more</p><!-- a comment that is longer than 16 characters -->"sv);
+    BEGIN_ENUMERATION(tokens);
+    EXPECT_START_TAG_TOKEN(p);
+    EXPECT_TAG_TOKEN_ATTRIBUTE_COUNT(1);
+    EXPECT_TAG_TOKEN_ATTRIBUTE(title, "a fairly long attribute & value");
+    EXPECT_CHARACTER_TOKENS(Text that is longer than 16 characters);
+    EXPECT_CHARACTER_TOKEN('\n');
+    EXPECT_CHARACTER_TOKENS(with);
+    EXPECT_CHARACTER_TOKEN(' ');
+    EXPECT_CHARACTER_TOKEN(0xe9);
+    EXPECT_CHARACTER_TOKEN(' ');
+    EXPECT_CHARACTER_TOKEN('&');
+    EXPECT_CHARACTER_TOKEN(' ');
+    EXPECT_CHARACTER_TOKENS(more);
+    EXPECT_END_TAG_TOKEN(p);
+    EXPECT_EQ(current_token->comment(), " a comment that is longer than 16 characters ");
+    EXPECT_COMMENT_TOKEN();
+    EXPECT_END_OF_FILE_TOKEN();
+    END_ENUMERATION();
+}
+
 // NOTE: This relies on the format of HTMLToken::to_string() staying the same.
 //       If that changes, or something is added to the test HTML, the hash needs to be adjusted.
 TEST_CASE(regression)
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/URL.h>
+#include <AK/Vector.h>
+#include <LibWeb/HTML/Parser/HTMLTokenizer.h>
+#include <LibWeb/HTML/Parser/SpeculativeHTMLParser.h>
+
+using Web::HTML::SpeculativeHTMLParser;
+
+struct Fetch {
+    Web::Resource::Type type;
+    String url;
+};
+
+static AK::URL const document_url { "https://example.com/dir/page.html" };
+
+static Vector<Fetch> run_speculative_parser(SpeculativeHTMLParser& parser, AK::URL const& base_url = document_url)
+{
+    Vector<Fetch> fetches;
+    parser.run(base_url, document_url, [&](Web::Resource::Type type, AK::URL const& url) {
+        fetches.append({ type, url.to_string() });
+    });
+    return fetches;
+}
+
+static Vector<Fetch> speculatively_parse(StringView input, bool scripting_enabled = true)
+{
+    SpeculativeHTMLParser parser(input, scripting_enabled);
+    return run_speculative_parser(parser);
+}
+
+#define EXPECT_FETCH(fetch, expected_type, expected_url)             \
+    do {                                                             \
+        EXPECT_EQ((fetch).type, Web::Resource::Type::expected_type); \
+        EXPECT_EQ((fetch).url, expected_url##sv);                    \
+    } while (0)
+
+TEST_CASE(resources_after_a_blocking_script_are_fetched)
+{
+    // NOTE: This is what the HTML parser does when it has to wait for a script: the speculative parser gets to look
+    //       at everything the tokenizer hasn't reached yet.
+    auto input = "<!DOCTYPE html><html><head><script src=\"blocking.js\"></script>"
+                 "<link rel=\"stylesheet\" href=\"style.css\">"
+                 "<script src=\"/later.js\"></script>"
+                 "</head><body><p>Text <img src=\"image.png\"></p></body></html>"sv;
+
+    Web::HTML::HTMLTokenizer tokenizer(input, "utf-8");
+    for (;;) {
+        auto token = tokenizer.next_token();
+        VERIFY(token.has_value() && !token->is_end_of_file());
+        if (token->is_end_tag() && token->tag_name() == "script"sv)
+            break;
+    }
+
+    SpeculativeHTMLParser parser(tokenizer.unparsed_input(), true);
+    auto fetches = run_speculative_parser(parser);
+    EXPECT_EQ(fetches.size(), 3u);
+    if (fetches.size() != 3)
+        return;
+    EXPECT_FETCH(fetches[0], Generic, "https://example.com/dir/style.css");
+    EXPECT_FETCH(fetches[1], Generic, "https://example.com/later.js");
+    EXPECT_FETCH(fetches[2], Image, "https://example.com/dir/image.png");
+
+    // Running again only looks at input it hasn't seen before, of which there is none.
+    EXPECT(run_speculative_parser(parser).is_empty());
+}
+
+TEST_CASE(resources_that_would_not_be_loaded_are_skipped)
+{
+    auto fetches = speculatively_parse(
+        "<link rel=\"alternate stylesheet\" href=\"alternate.css\">"
+        "<link rel=\"icon\" href=\"icon.png\">"
+        "<script type=\"module\" src=\"module.js\"></script>"
+        "<script>document.write('<img src=\"written.png\">');</script>"
+        "<textarea><img src=\"textarea.png\"></textarea>"
+        "<template><img src=\"template.png\"><template></template><img src=\"nested-template.png\"></template>"
+        "<img src=\"data:image/png;base64,AAAA\">"
+        "<img src=\"file:///res/icons/16x16/app-browser.png\">"
+        "<img src=\"twice.png\"><img src=\"twice.png\">"sv);
+    EXPECT_EQ(fetches.size(), 1u);
+    if (fetches.size() != 1)
+        return;
+    EXPECT_FETCH(fetches[0], Image, "https://example.com/dir/twice.png");
+}
+
+TEST_CASE(noscript_contents_are_fetched_only_without_scripting)
+{
+    auto input = "<script src=\"script.js\"></script><noscript><img src=\"noscript.png\"></noscript>"sv;
+
+    auto fetches = speculatively_parse(input, true);
+    EXPECT_EQ(fetches.size(), 1u);
+    if (fetches.size() == 1)
+        EXPECT_FETCH(fetches[0], Generic, "https://example.com/dir/script.js");
+
+    fetches = speculatively_parse(input, false);
+    EXPECT_EQ(fetches.size(), 1u);
+    if (fetches.size() == 1)
+        EXPECT_FETCH(fetches[0], Image, "https://example.com/dir/noscript.png");
+}
+
+TEST_CASE(first_base_element_is_honored)
+{
+    auto input = "<base href=\"https://cdn.example.com/assets/\"><base href=\"https://other.example.com/\"><img src=\"image.png\">"sv;
+
+    auto fetches = speculatively_parse(input);
+    EXPECT_EQ(fetches.size(), 1u);
+    if (fetches.size() == 1)
+        EXPECT_FETCH(fetches[0], Image, "https://cdn.example.com/assets/image.png");
+
+    // A base element that is already in the document wins over any that come later.
+    SpeculativeHTMLParser parser(input, true);
+    fetches = run_speculative_parser(parser, AK::URL("https://static.example.com/"));
+    EXPECT_EQ(fetches.size(), 1u);
+    if (fetches.size() == 1)
+        EXPECT_FETCH(fetches[0], Image, "https://static.example.com/image.png");
+}
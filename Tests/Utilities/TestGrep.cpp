@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/LexicalPath.h>
+#include <AK/String.h>
+#include <AK/StringBuilder.h>
+#include <LibCore/Command.h>
+#include <LibCore/File.h>
+#include <LibTest/TestCase.h>
+#include <stdlib.h>
+
+// Holds the files a test case searches, and removes them once it's done.
+class TemporaryDirectory {
+public:
+    TemporaryDirectory()
+    {
+        char path[] = "/tmp/grep-test.XXXXXX";
+        VERIFY(mkdtemp(path));
+        m_path = path;
+    }
+
+    ~TemporaryDirectory()
+    {
+        auto result = Core::File::remove(m_path, Core::File::RecursionMode::Allowed, false);
+        EXPECT(!result.is_error());
+    }
+
+    String path_of(StringView name) const { return LexicalPath::join(m_path, name).string(); }
+
+private:
+    String m_path;
+};
+
+static void write_file(String const& path, StringView contents)
+{
+    auto file = MUST(Core::File::open(path, Core::OpenMode::WriteOnly | Core::OpenMode::Truncate));
+    EXPECT(file->write(contents));
+}
+
+static Core::CommandResult run_grep(Vector<String> const& arguments)
+{
+    return MUST(Core::command("grep", arguments, {}));
+}
+
+TEST_CASE(output_of_files_is_written_in_argument_order)
+{
+    TemporaryDirectory directory;
+    Vector<String> arguments { "match" };
+    StringBuilder expected_output;
+    for (size_t i = 0; i < 32; ++i) {
+        auto path = directory.path_of(String::formatted("order-{}.txt", i));
+        StringBuilder contents;
+        for (size_t line = 0; line < i * 100; ++line) {
+            contents.appendff("match {} {}\n", i, line);
+            contents.append("no\n"sv);
+            expected_output.appendff("{}:match {} {}\n", path, i, line);
+        }
+        write_file(path, contents.string_view());
+        arguments.append(path);
+    }
+
+    auto result = run_grep(arguments);
+    EXPECT_EQ(result.exit_code, 0);
+    EXPECT_EQ(result.output, expected_output.string_view());
+}
+
+TEST_CASE(output_larger_than_what_is_buffered_per_file)
+{
+    // NOTE: Each file's output is held back while an earlier file is still being searched, but only up to a limit.
+    TemporaryDirectory directory;
+    StringBuilder expected_output;
+    for (size_t i = 1; i <= 2; ++i) {
+        auto path = directory.path_of(String::formatted("large-{}.txt", i));
+        StringBuilder contents;
+        for (size_t line = 0; line < 200'000; ++line) {
+            contents.appendff("a line that matches, number {}\n", line);
+            expected_output.appendff("{}:a line that matches, number {}\n", path, line);
+        }
+        write_file(path, contents.string_view());
+    }
+    auto last_path = directory.path_of("large-3.txt"sv);
+    write_file(last_path, "nothing here\nmatches\n"sv);
+    expected_output.appendff("{}:matches\n", last_path);
+
+    auto result = run_grep({ "matches", directory.path_of("large-1.txt"sv), directory.path_of("large-2.txt"sv), last_path });
+    EXPECT_EQ(result.exit_code, 0);
+    EXPECT_EQ(result.output, expected_output.string_view());
+}
+
+TEST_CASE(single_file)
+{
+    TemporaryDirectory directory;
+    auto path = directory.path_of("single.txt"sv);
+    write_file(path, "one\ntwo\nthree\n"sv);
+
+    auto result = run_grep({ "-n", "t", path });
+    EXPECT_EQ(result.exit_code, 0);
+    EXPECT_EQ(result.output, "2:two\n3:three\n"sv);
+
+    result = run_grep({ "-c", "o", path });
+    EXPECT_EQ(result.exit_code, 0);
+    EXPECT_EQ(result.output, "2\n"sv);
+
+    result = run_grep({ "four", path });
+    EXPECT_EQ(result.exit_code, 1);
+    EXPECT(result.output.is_empty());
+}
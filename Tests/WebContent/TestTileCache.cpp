@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/Vector.h>
+#include <LibGfx/Bitmap.h>
+#include <WebContent/TileCache.h>
+
+// Stands in for the page: a pattern that is different at every pixel, with some rects painted over it.
+class TestContent {
+public:
+    Gfx::Color color_at(int x, int y) const
+    {
+        for (size_t i = m_changed_rects.size(); i > 0; --i) {
+            if (m_changed_rects[i - 1].contains(x, y))
+                return Gfx::Color(255, static_cast<u8>(i * 16), static_cast<u8>(i * 32));
+        }
+        return Gfx::Color(x & 0xff, y & 0xff, ((x >> 8) & 0xf) << 4 | ((y >> 8) & 0xf));
+    }
+
+    void change(Gfx::IntRect const& rect) { m_changed_rects.append(rect); }
+
+    NonnullRefPtr<Gfx::Bitmap> paint(Gfx::IntRect const& content_rect) const
+    {
+        auto bitmap = MUST(Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRx8888, content_rect.size()));
+        paint_into(content_rect, *bitmap);
+        return bitmap;
+    }
+
+    void paint_into(Gfx::IntRect const& content_rect, Gfx::Bitmap& bitmap) const
+    {
+        for (int y = 0; y < content_rect.height(); ++y) {
+            for (int x = 0; x < content_rect.width(); ++x)
+                bitmap.set_pixel(x, y, color_at(content_rect.x() + x, content_rect.y() + y));
+        }
+    }
+
+private:
+    Vector<Gfx::IntRect> m_changed_rects;
+};
+
+class TestTileCache {
+public:
+    NonnullRefPtr<Gfx::Bitmap> paint(Gfx::IntRect const& content_rect)
+    {
+        auto bitmap = MUST(Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRx8888, content_rect.size()));
+        m_tile_cache.paint(content_rect, *bitmap, [this](auto& tile_rect, auto& tile_bitmap) {
+            ++m_rasterized_tile_count;
+            content.paint_into(tile_rect, tile_bitmap);
+        });
+        return bitmap;
+    }
+
+    // Returns how many tiles had to be rasterized for painting `content_rect`, and checks what was painted.
+    size_t paint_and_count_rasterized_tiles(Gfx::IntRect const& content_rect)
+    {
+        m_rasterized_tile_count = 0;
+        auto bitmap = paint(content_rect);
+        EXPECT_EQ(count_differing_pixels(*content.paint(content_rect), *bitmap), 0u);
+        return m_rasterized_tile_count;
+    }
+
+    WebContent::TileCache& tile_cache() { return m_tile_cache; }
+
+    TestContent content;
+
+private:
+    static size_t count_differing_pixels(Gfx::Bitmap const& expected, Gfx::Bitmap const& actual)
+    {
+        size_t differing_pixels = 0;
+        for (int y = 0; y < expected.height(); ++y) {
+            for (int x = 0; x < expected.width(); ++x) {
+                if (expected.get_pixel(x, y) != actual.get_pixel(x, y))
+                    ++differing_pixels;
+            }
+        }
+        return differing_pixels;
+    }
+
+    WebContent::TileCache m_tile_cache;
+    size_t m_rasterized_tile_count { 0 };
+};
+
+static constexpr auto tile_size = WebContent::TileCache::tile_size;
+
+// 4x3 tiles.
+static Gfx::IntRect const viewport_rect { 0, 0, 800, 600 };
+
+TEST_CASE(painting_tiles_matches_painting_everything)
+{
+    for (auto content_rect : { viewport_rect, Gfx::IntRect { -100, -37, 300, 200 }, Gfx::IntRect { 1000, 3000, 513, 257 }, Gfx::IntRect { 5, 7, 1, 1 } }) {
+        TestTileCache cache;
+        cache.content.change({ 200, 240, 100, 30 });
+        EXPECT_NE(cache.paint_and_count_rasterized_tiles(content_rect), 0u);
+    }
+}
+
+TEST_CASE(tiles_are_only_rasterized_again_once_invalidated)
+{
+    TestTileCache cache;
+    EXPECT_EQ(cache.paint_and_count_rasterized_tiles(viewport_rect), 12u);
+    EXPECT_EQ(cache.paint_and_count_rasterized_tiles(viewport_rect), 0u);
+
+    cache.content.change({ 300, 300, 10, 10 });
+    cache.tile_cache().invalidate({ 300, 300, 10, 10 });
+    EXPECT_EQ(cache.paint_and_count_rasterized_tiles(viewport_rect), 1u);
+
+    // A change across tile edges invalidates every tile it touches.
+    cache.content.change({ tile_size - 5, tile_size - 5, 10, 10 });
+    cache.tile_cache().invalidate({ tile_size - 5, tile_size - 5, 10, 10 });
+    EXPECT_EQ(cache.paint_and_count_rasterized_tiles(viewport_rect), 4u);
+
+    // So does a change that reaches into a tile by a single pixel.
+    cache.content.change({ 0, 0, tile_size + 1, 1 });
+    cache.tile_cache().invalidate({ 0, 0, tile_size + 1, 1 });
+    EXPECT_EQ(cache.paint_and_count_rasterized_tiles(viewport_rect), 2u);
+
+    cache.tile_cache().invalidate_all();
+    EXPECT_EQ(cache.paint_and_count_rasterized_tiles(viewport_rect), 12u);
+}
+
+TEST_CASE(invalidating_tiles_outside_of_the_painted_area)
+{
+    TestTileCache cache;
+    EXPECT_EQ(cache.paint_and_count_rasterized_tiles(viewport_rect), 12u);
+    EXPECT_EQ(cache.paint_and_count_rasterized_tiles(viewport_rect.translated(0, 300)), 4u);
+
+    // The first row of tiles is still cached, and has to be painted again once it has changed.
+    cache.content.change({ 10, 10, 20, 20 });
+    cache.tile_cache().invalidate({ 10, 10, 20, 20 });
+    EXPECT_EQ(cache.paint_and_count_rasterized_tiles(viewport_rect.translated(0, 300)), 0u);
+    EXPECT_EQ(cache.paint_and_count_rasterized_tiles(viewport_rect), 1u);
+}
+
+TEST_CASE(scrolling_reuses_tiles)
+{
+    TestTileCache cache;
+    EXPECT_EQ(cache.paint_and_count_rasterized_tiles(viewport_rect), 12u);
+
+    // Still within the same rows of tiles.
+    EXPECT_EQ(cache.paint_and_count_rasterized_tiles(viewport_rect.translated(0, 100)), 0u);
+
+    // One row further down, and back.
+    EXPECT_EQ(cache.paint_and_count_rasterized_tiles(viewport_rect.translated(0, 300)), 4u);
+    EXPECT_EQ(cache.paint_and_count_rasterized_tiles(viewport_rect), 0u);
+
+    // Sideways, by less than a tile.
+    EXPECT_EQ(cache.paint_and_count_rasterized_tiles(viewport_rect.translated(-17, 0)), 3u);
+}
+
+TEST_CASE(tiles_far_outside_of_the_painted_area_are_evicted)
+{
+    TestTileCache cache;
+    EXPECT_EQ(cache.paint_and_count_rasterized_tiles(viewport_rect), 12u);
+    EXPECT_EQ(cache.paint_and_count_rasterized_tiles(viewport_rect.translated(0, 100 * tile_size)), 12u);
+    EXPECT_EQ(cache.paint_and_count_rasterized_tiles(viewport_rect), 12u);
+}
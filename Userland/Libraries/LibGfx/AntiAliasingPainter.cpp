@@ -9,11 +9,11 @@
 #    pragma GCC optimize("O3")
 #endif
 
-#include "FillPathImplementation.h"
 #include <AK/Function.h>
 #include <AK/NumericLimits.h>
 #include <LibGfx/AntiAliasingPainter.h>
 #include <LibGfx/Path.h>
+#include <LibGfx/PathRasterizer.h>
 
 namespace Gfx {
 
@@ -176,7 +176,22 @@ void AntiAliasingPainter::draw_line(FloatPoint const& actual_from, FloatPoint co
 
 void AntiAliasingPainter::fill_path(Path& path, Color color, Painter::WindingRule rule)
 {
-    Detail::fill_path<Detail::FillPathMode::AllowFloatingPoints>(*this, path, color, rule);
+    if (color.alpha() == 0)
+        return;
+
+    auto& target = *m_underlying_painter.target();
+    auto scale = m_underlying_painter.scale();
+    auto clip_rect = (m_underlying_painter.clip_rect() * scale).intersected(target.physical_rect());
+    if (clip_rect.is_empty())
+        return;
+
+    auto transform = AffineTransform {}
+                         .scale(scale, scale)
+                         .translate(m_underlying_painter.translation().to_type<float>())
+                         .multiply(m_transform);
+    PathRasterizer rasterizer(clip_rect);
+    rasterizer.add_path(path, transform);
+    rasterizer.fill(target, color, rule);
 }
 
 void AntiAliasingPainter::stroke_path(Path const& path, Color color, float thickness)
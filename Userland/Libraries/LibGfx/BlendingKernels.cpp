@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Platform.h>
+#include <AK/SIMD.h>
+#include <AK/Vector.h>
+#include <LibGfx/BlendingKernels.h>
+
+#if ARCH(I386) || ARCH(X86_64)
+#    include <cpuid.h>
+#endif
+
+// NOTE: The AVX2 variants pass 256-bit vectors between inlined functions, which GCC warns about for targets without AVX.
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+namespace Gfx {
+
+using AK::SIMD::f32x4;
+using AK::SIMD::i32x4;
+using AK::SIMD::u32x4;
+
+template<typename VectorType>
+static constexpr size_t lane_count = sizeof(VectorType) / sizeof(u32);
+
+template<typename I32xN>
+ALWAYS_INLINE static bool all_lanes(I32xN const& mask)
+{
+    for (size_t i = 0; i < lane_count<I32xN>; ++i) {
+        if (!mask[i])
+            return false;
+    }
+    return true;
+}
+
+// This is Color::blend() for N pixels at once. The divisions are done in single precision, which gives exactly the
+// same results as the integer divisions there: All numerators and denominators are below 2^24, so they are exact,
+// and a quotient that isn't a whole number is far enough from the next one to never be rounded up to it.
+template<typename U32xN, typename I32xN, typename F32xN>
+ALWAYS_INLINE static U32xN blend(U32xN const& destination, U32xN const& source)
+{
+    auto destination_alpha = (I32xN)(destination >> 24);
+    auto source_alpha = (I32xN)(source >> 24);
+
+    auto d = 255 * (destination_alpha + source_alpha) - destination_alpha * source_alpha;
+    // NOTE: d is only 0 where both pixels are transparent, in which case the source is used below.
+    auto divisor = __builtin_convertvector(d - (d == 0), F32xN);
+
+    auto destination_weight = destination_alpha * (255 - source_alpha);
+    auto source_weight = 255 * source_alpha;
+    auto blend_channel = [&](int shift) {
+        auto destination_channel = (I32xN)((destination >> shift) & 0xff);
+        auto source_channel = (I32xN)((source >> shift) & 0xff);
+        auto numerator = destination_channel * destination_weight + source_channel * source_weight;
+        return (U32xN)__builtin_convertvector(__builtin_convertvector(numerator, F32xN) / divisor, I32xN);
+    };
+
+    auto alpha = (U32xN)__builtin_convertvector(divisor / 255.0f, I32xN);
+    auto blended = (I32xN)((alpha << 24) | (blend_channel(16) << 16) | (blend_channel(8) << 8) | blend_channel(0));
+
+    auto use_source = (destination_alpha == 0) | (source_alpha == 255);
+    auto use_destination = (source_alpha == 0) & ~use_source;
+    auto use_blended = ~(use_source | use_destination);
+    return (U32xN)((use_source & (I32xN)source) | (use_destination & (I32xN)destination) | (use_blended & blended));
+}
+
+template<typename U32xN, typename I32xN, typename F32xN>
+ALWAYS_INLINE static void blend_pixels_impl(ARGB32* destination, ARGB32 const* source, size_t count, DestinationAlpha destination_alpha)
+{
+    constexpr size_t lanes = lane_count<U32xN>;
+    u32 destination_alpha_mask = destination_alpha == DestinationAlpha::Opaque ? 0xff000000 : 0;
+
+    size_t i = 0;
+    for (; i + lanes <= count; i += lanes) {
+        U32xN source_pixels;
+        __builtin_memcpy(&source_pixels, source + i, sizeof(source_pixels));
+
+        // NOTE: Opaque sources are simply copied, which is the common case for most images.
+        auto source_alpha = (I32xN)(source_pixels >> 24);
+        if (all_lanes<I32xN>(source_alpha == 255)) {
+            __builtin_memcpy(destination + i, &source_pixels, sizeof(source_pixels));
+            continue;
+        }
+
+        U32xN destination_pixels;
+        __builtin_memcpy(&destination_pixels, destination + i, sizeof(destination_pixels));
+        destination_pixels |= destination_alpha_mask;
+
+        auto result = blend<U32xN, I32xN, F32xN>(destination_pixels, source_pixels);
+        __builtin_memcpy(destination + i, &result, sizeof(result));
+    }
+
+    for (; i < count; ++i)
+        destination[i] = Color::from_argb(destination[i] | destination_alpha_mask).blend(Color::from_argb(source[i])).value();
+}
+
+template<typename U32xN, typename I32xN, typename F32xN>
+ALWAYS_INLINE static void blend_color_into_pixels_impl(ARGB32* pixels, size_t count, Color color)
+{
+    constexpr size_t lanes = lane_count<U32xN>;
+    U32xN color_pixels;
+    for (size_t i = 0; i < lanes; ++i)
+        color_pixels[i] = color.value();
+
+    size_t i = 0;
+    for (; i + lanes <= count; i += lanes) {
+        U32xN destination_pixels;
+        __builtin_memcpy(&destination_pixels, pixels + i, sizeof(destination_pixels));
+        auto result = blend<U32xN, I32xN, F32xN>(destination_pixels, color_pixels);
+        __builtin_memcpy(pixels + i, &result, sizeof(result));
+    }
+
+    for (; i < count; ++i)
+        pixels[i] = Color::from_argb(pixels[i]).blend(color).value();
+}
+
+static void blend_pixels_x4(ARGB32* destination, ARGB32 const* source, size_t count, DestinationAlpha destination_alpha)
+{
+    blend_pixels_impl<u32x4, i32x4, f32x4>(destination, source, count, destination_alpha);
+}
+
+static void blend_color_into_pixels_x4(ARGB32* pixels, size_t count, Color color)
+{
+    blend_color_into_pixels_impl<u32x4, i32x4, f32x4>(pixels, count, color);
+}
+
+#if ARCH(I386) || ARCH(X86_64)
+using AK::SIMD::f32x8;
+using AK::SIMD::i32x8;
+using AK::SIMD::u32x8;
+
+[[gnu::target("avx2")]] static void blend_pixels_x8(ARGB32* destination, ARGB32 const* source, size_t count, DestinationAlpha destination_alpha)
+{
+    blend_pixels_impl<u32x8, i32x8, f32x8>(destination, source, count, destination_alpha);
+}
+
+[[gnu::target("avx2")]] static void blend_color_into_pixels_x8(ARGB32* pixels, size_t count, Color color)
+{
+    blend_color_into_pixels_impl<u32x8, i32x8, f32x8>(pixels, count, color);
+}
+
+static bool cpu_supports_avx2()
+{
+    u32 eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+        return false;
+
+    // The operating system also has to save the AVX registers on context switches.
+    constexpr u32 cpuid_1_ecx_bit_osxsave = 1 << 27;
+    constexpr u32 cpuid_1_ecx_bit_avx = 1 << 28;
+    if ((ecx & (cpuid_1_ecx_bit_osxsave | cpuid_1_ecx_bit_avx)) != (cpuid_1_ecx_bit_osxsave | cpuid_1_ecx_bit_avx))
+        return false;
+    u32 xcr0_low, xcr0_high;
+    asm volatile("xgetbv"
+                 : "=a"(xcr0_low), "=d"(xcr0_high)
+                 : "c"(0));
+    constexpr u32 xcr0_sse_and_avx_state = 0b110;
+    if ((xcr0_low & xcr0_sse_and_avx_state) != xcr0_sse_and_avx_state)
+        return false;
+
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+        return false;
+    constexpr u32 cpuid_7_ebx_bit_avx2 = 1 << 5;
+    return ebx & cpuid_7_ebx_bit_avx2;
+}
+#endif
+
+Span<BlendingKernels const> supported_blending_kernels()
+{
+    static Vector<BlendingKernels> const s_kernels = [] {
+        Vector<BlendingKernels> kernels;
+#if ARCH(I386) || ARCH(X86_64)
+        if (cpu_supports_avx2())
+            kernels.append({ "x8"sv, blend_color_into_pixels_x8, blend_pixels_x8 });
+#endif
+        kernels.append({ "x4"sv, blend_color_into_pixels_x4, blend_pixels_x4 });
+        return kernels;
+    }();
+    return s_kernels;
+}
+
+static BlendingKernels const& kernels()
+{
+    static BlendingKernels const& s_kernels = supported_blending_kernels()[0];
+    return s_kernels;
+}
+
+void blend_color_into_pixels(ARGB32* pixels, size_t count, Color color)
+{
+    kernels().blend_color_into_pixels(pixels, count, color);
+}
+
+void blend_pixels(ARGB32* destination, ARGB32 const* source, size_t count, DestinationAlpha destination_alpha)
+{
+    kernels().blend_pixels(destination, source, count, destination_alpha);
+}
+
+}
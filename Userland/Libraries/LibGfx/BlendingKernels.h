@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Span.h>
+#include <AK/StringView.h>
+#include <AK/Types.h>
+#include <LibGfx/Color.h>
+
+// These blend whole rows of pixels at once, with the widest vector instructions the CPU supports. They give exactly
+// the same results as calling Color::blend() for every pixel.
+
+namespace Gfx {
+
+enum class DestinationAlpha {
+    // The alpha channel of the destination pixels is used as is.
+    Keep,
+    // The destination pixels are treated as opaque, which is what Color::from_rgb() does.
+    Opaque,
+};
+
+// Blends the color into each of the pixels.
+void blend_color_into_pixels(ARGB32* pixels, size_t count, Color);
+
+// Blends each of the source pixels into the corresponding destination pixel.
+void blend_pixels(ARGB32* destination, ARGB32 const* source, size_t count, DestinationAlpha = DestinationAlpha::Keep);
+
+// The functions above for one vector width.
+struct BlendingKernels {
+    StringView name;
+    void (*blend_color_into_pixels)(ARGB32* pixels, size_t count, Color);
+    void (*blend_pixels)(ARGB32* destination, ARGB32 const* source, size_t count, DestinationAlpha);
+};
+
+// The kernels for each vector width that the CPU supports, widest first. The functions above use the first of them,
+// this is for testing all of them.
+Span<BlendingKernels const> supported_blending_kernels();
+
+}
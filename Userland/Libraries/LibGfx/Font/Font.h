@@ -14,6 +14,7 @@
 #include <AK/Types.h>
 #include <LibCore/MappedFile.h>
 #include <LibGfx/Bitmap.h>
+#include <LibGfx/Rect.h>
 #include <LibGfx/Size.h>
 
 namespace Gfx {
@@ -65,6 +66,17 @@ public:
 
     Glyph(RefPtr<Bitmap> bitmap, int left_bearing, int advance, int ascent)
         : m_bitmap(bitmap)
+        , m_bitmap_rect(bitmap ? bitmap->rect() : IntRect {})
+        , m_left_bearing(left_bearing)
+        , m_advance(advance)
+        , m_ascent(ascent)
+    {
+    }
+
+    // The glyph only covers part of the bitmap, e.g. if it is stored in a glyph atlas.
+    Glyph(NonnullRefPtr<Bitmap> bitmap, IntRect const& bitmap_rect, int left_bearing, int advance, int ascent)
+        : m_bitmap(move(bitmap))
+        , m_bitmap_rect(bitmap_rect)
         , m_left_bearing(left_bearing)
         , m_advance(advance)
         , m_ascent(ascent)
@@ -74,6 +86,7 @@ public:
     bool is_glyph_bitmap() const { return !m_bitmap; }
     GlyphBitmap glyph_bitmap() const { return m_glyph_bitmap; }
     RefPtr<Bitmap> bitmap() const { return m_bitmap; }
+    IntRect const& bitmap_rect() const { return m_bitmap_rect; }
     int left_bearing() const { return m_left_bearing; }
     int advance() const { return m_advance; }
     int ascent() const { return m_ascent; }
@@ -81,6 +94,7 @@ public:
 private:
     GlyphBitmap m_glyph_bitmap;
     RefPtr<Bitmap> m_bitmap;
+    IntRect m_bitmap_rect;
     int m_left_bearing;
     int m_advance;
     int m_ascent;
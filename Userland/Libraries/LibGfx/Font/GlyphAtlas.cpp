@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGfx/Font/GlyphAtlas.h>
+
+namespace Gfx {
+
+GlyphAtlas& GlyphAtlas::the()
+{
+    static thread_local GlyphAtlas s_the;
+    return s_the;
+}
+
+Optional<GlyphAtlas::Glyph> GlyphAtlas::find(VectorFont const& font, float x_scale, float y_scale, u32 glyph_id)
+{
+    auto it = m_entries.find({ &font, x_scale, y_scale, glyph_id });
+    if (it == m_entries.end())
+        return {};
+    auto& entry = it->value;
+    entry.page->last_used = ++m_use_counter;
+    return Glyph { entry.page->bitmap, entry.rect };
+}
+
+Optional<GlyphAtlas::Glyph> GlyphAtlas::insert(VectorFont const& font, float x_scale, float y_scale, u32 glyph_id, Bitmap const& bitmap)
+{
+    if (bitmap.width() > page_size || bitmap.height() > page_size || bitmap.scale() != 1 || bitmap.format() != BitmapFormat::BGRA8888)
+        return {};
+
+    Optional<IntPoint> location;
+    if (m_current_page)
+        location = allocate(*m_current_page, bitmap.size());
+
+    if (!location.has_value()) {
+        auto* page = take_least_recently_used_page();
+        if (!page)
+            return {};
+        m_current_page = page;
+        location = allocate(*page, bitmap.size());
+        VERIFY(location.has_value());
+    }
+
+    IntRect rect { *location, bitmap.size() };
+    for (int y = 0; y < rect.height(); ++y)
+        __builtin_memcpy(m_current_page->bitmap->scanline(rect.y() + y) + rect.x(), bitmap.scanline(y), rect.width() * sizeof(ARGB32));
+
+    GlyphAtlasKey key { &font, x_scale, y_scale, glyph_id };
+    m_current_page->keys.append(key);
+    m_current_page->last_used = ++m_use_counter;
+    m_entries.set(key, Entry { font, m_current_page, rect });
+    return Glyph { m_current_page->bitmap, rect };
+}
+
+// Glyphs are packed in rows (shelves) from left to right. A new shelf is started below the tallest glyph of the
+// current one once it is full.
+Optional<IntPoint> GlyphAtlas::allocate(Page& page, IntSize const& size)
+{
+    if (page.shelf_position.x() + size.width() > page_size) {
+        page.shelf_position = { 0, page.shelf_position.y() + page.shelf_height };
+        page.shelf_height = 0;
+    }
+    if (page.shelf_position.y() + size.height() > page_size)
+        return {};
+
+    auto location = page.shelf_position;
+    page.shelf_position.translate_by(size.width(), 0);
+    page.shelf_height = max(page.shelf_height, size.height());
+    return location;
+}
+
+GlyphAtlas::Page* GlyphAtlas::take_least_recently_used_page()
+{
+    auto bitmap_or_error = Bitmap::try_create(BitmapFormat::BGRA8888, { page_size, page_size });
+    if (bitmap_or_error.is_error()) {
+        dbgln("GlyphAtlas: Failed to create page: {}", bitmap_or_error.error());
+        return nullptr;
+    }
+
+    if (m_pages.size() < max_page_count) {
+        m_pages.append(adopt_own(*new Page { bitmap_or_error.release_value() }));
+        return &m_pages.last();
+    }
+
+    Page* least_recently_used_page = nullptr;
+    for (auto& page : m_pages) {
+        if (!least_recently_used_page || page.last_used < least_recently_used_page->last_used)
+            least_recently_used_page = &page;
+    }
+    VERIFY(least_recently_used_page);
+
+    // NOTE: The old bitmap is replaced instead of cleared, as glyphs that were handed out earlier may still refer to it.
+    auto& page = *least_recently_used_page;
+    for (auto& key : page.keys)
+        m_entries.remove(key);
+    page.keys.clear();
+    page.bitmap = bitmap_or_error.release_value();
+    page.shelf_position = {};
+    page.shelf_height = 0;
+    return &page;
+}
+
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/Noncopyable.h>
+#include <AK/NonnullOwnPtrVector.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/Optional.h>
+#include <AK/Vector.h>
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/Font/VectorFont.h>
+#include <LibGfx/Rect.h>
+
+namespace Gfx {
+
+struct GlyphAtlasKey {
+    VectorFont const* font { nullptr };
+    float x_scale { 0 };
+    float y_scale { 0 };
+    u32 glyph_id { 0 };
+
+    bool operator==(GlyphAtlasKey const&) const = default;
+};
+
+}
+
+namespace AK {
+
+template<>
+struct Traits<Gfx::GlyphAtlasKey> : public GenericTraits<Gfx::GlyphAtlasKey> {
+    static unsigned hash(Gfx::GlyphAtlasKey const& key)
+    {
+        auto scale_hash = pair_int_hash(bit_cast<u32>(key.x_scale), bit_cast<u32>(key.y_scale));
+        return pair_int_hash(pair_int_hash(ptr_hash(key.font), scale_hash), key.glyph_id);
+    }
+};
+
+}
+
+namespace Gfx {
+
+// Rasterized glyphs of vector fonts, packed into a bounded number of shared pages. Fonts of the same typeface and size
+// share their glyphs, and glyphs drawn one after the other are close to each other in memory. When all pages are full,
+// the page that was used the longest time ago is thrown away.
+class GlyphAtlas {
+    AK_MAKE_NONCOPYABLE(GlyphAtlas);
+    AK_MAKE_NONMOVABLE(GlyphAtlas);
+
+public:
+    // Returns the atlas of the current thread.
+    // NOTE: Every thread that draws text gets its own atlas, since the reference counts of the pages aren't atomic.
+    static GlyphAtlas& the();
+
+    GlyphAtlas() = default;
+
+    static constexpr int page_size = 512;
+    static constexpr size_t max_page_count = 8;
+
+    struct Glyph {
+        NonnullRefPtr<Bitmap> page;
+        IntRect rect;
+    };
+
+    Optional<Glyph> find(VectorFont const&, float x_scale, float y_scale, u32 glyph_id);
+
+    // Returns an empty Optional if the bitmap doesn't fit into a page.
+    Optional<Glyph> insert(VectorFont const&, float x_scale, float y_scale, u32 glyph_id, Bitmap const&);
+
+private:
+    struct Page {
+        NonnullRefPtr<Bitmap> bitmap;
+        Vector<GlyphAtlasKey> keys {};
+        IntPoint shelf_position {};
+        int shelf_height { 0 };
+        u64 last_used { 0 };
+    };
+
+    struct Entry {
+        // NOTE: This keeps the font alive, so that its address isn't reused while it is part of a key.
+        NonnullRefPtr<VectorFont const> font;
+        Page* page { nullptr };
+        IntRect rect;
+    };
+
+    Optional<IntPoint> allocate(Page&, IntSize const&);
+    Page* take_least_recently_used_page();
+
+    HashMap<GlyphAtlasKey, Entry> m_entries;
+    NonnullOwnPtrVector<Page> m_pages;
+    Page* m_current_page { nullptr };
+    u64 m_use_counter { 0 };
+};
+
+}
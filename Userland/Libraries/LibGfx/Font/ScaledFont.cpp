@@ -6,6 +6,7 @@
 
 #include <AK/Utf32View.h>
 #include <AK/Utf8View.h>
+#include <LibGfx/Font/GlyphAtlas.h>
 #include <LibGfx/Font/ScaledFont.h>
 
 namespace Gfx {
@@ -52,8 +53,23 @@ RefPtr<Gfx::Bitmap> ScaledFont::rasterize_glyph(u32 glyph_id) const
 Gfx::Glyph ScaledFont::glyph(u32 code_point) const
 {
     auto id = glyph_id_for_code_point(code_point);
-    auto bitmap = rasterize_glyph(id);
     auto metrics = glyph_metrics(id);
+
+    auto& atlas = GlyphAtlas::the();
+    if (auto atlas_glyph = atlas.find(*m_font, m_x_scale, m_y_scale, id); atlas_glyph.has_value())
+        return Gfx::Glyph(atlas_glyph->page, atlas_glyph->rect, metrics.left_side_bearing, metrics.advance_width, metrics.ascender);
+
+    // NOTE: Glyphs that are empty or don't fit into the atlas are cached by the font itself.
+    if (!m_cached_glyph_bitmaps.contains(id)) {
+        auto bitmap = m_font->rasterize_glyph(id, m_x_scale, m_y_scale);
+        if (bitmap) {
+            if (auto atlas_glyph = atlas.insert(*m_font, m_x_scale, m_y_scale, id, *bitmap); atlas_glyph.has_value())
+                return Gfx::Glyph(atlas_glyph->page, atlas_glyph->rect, metrics.left_side_bearing, metrics.advance_width, metrics.ascender);
+        }
+        m_cached_glyph_bitmaps.set(id, move(bitmap));
+    }
+
+    auto bitmap = rasterize_glyph(id);
     return Gfx::Glyph(bitmap, metrics.left_side_bearing, metrics.advance_width, metrics.ascender);
 }
 
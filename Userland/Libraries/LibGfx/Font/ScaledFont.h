@@ -71,6 +71,7 @@ private:
     float m_y_scale { 0.0f };
     float m_point_width { 0.0f };
     float m_point_height { 0.0f };
+    // NOTE: Most glyphs are cached in the GlyphAtlas instead.
     mutable HashMap<u32, RefPtr<Gfx::Bitmap>> m_cached_glyph_bitmaps;
 
     template<typename T>
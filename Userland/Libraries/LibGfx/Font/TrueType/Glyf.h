@@ -11,6 +11,7 @@
 #include <LibGfx/AffineTransform.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/Font/TrueType/Tables.h>
+#include <LibGfx/PathRasterizer.h>
 #include <math.h>
 
 namespace TTF {
@@ -22,10 +23,8 @@ public:
     RefPtr<Gfx::Bitmap> accumulate();
 
 private:
-    void draw_line(Gfx::FloatPoint, Gfx::FloatPoint);
-
     Gfx::IntSize m_size;
-    Vector<float> m_data;
+    Gfx::PathRasterizer m_path_rasterizer;
 };
 
 class Loca {
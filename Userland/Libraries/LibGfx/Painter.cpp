@@ -12,10 +12,12 @@
 
 #include "Painter.h"
 #include "Bitmap.h"
+#include "BlendingKernels.h"
 #include "Font/Emoji.h"
 #include "Font/Font.h"
 #include "Font/FontDatabase.h"
 #include "Gamma.h"
+#include <AK/Array.h>
 #include <AK/Assertions.h>
 #include <AK/Debug.h>
 #include <AK/Function.h>
@@ -122,8 +124,7 @@ void Painter::fill_physical_rect(IntRect const& physical_rect, Color color)
     size_t const dst_skip = m_target->pitch() / sizeof(ARGB32);
 
     for (int i = physical_rect.height() - 1; i >= 0; --i) {
-        for (int j = 0; j < physical_rect.width(); ++j)
-            dst[j] = Color::from_argb(dst[j]).blend(color).value();
+        blend_color_into_pixels(dst, physical_rect.width(), color);
         dst += dst_skip;
     }
 }
@@ -816,27 +817,40 @@ static void swap_red_and_blue_channels(Color& color)
     color = Color::from_argb(bgra);
 }
 
-// FIXME: This function is very unoptimized.
 template<BlitState::AlphaState has_alpha>
 static void do_blit_with_opacity(BlitState& state)
 {
+    auto destination_alpha = (has_alpha & BlitState::DstAlpha) ? DestinationAlpha::Keep : DestinationAlpha::Opaque;
+
+    // NOTE: The source pixels can be blended as they are if they need neither a new alpha value nor swapped channels.
+    //       Otherwise, each row is prepared in a buffer first.
+    bool can_blend_source_row = (has_alpha & BlitState::SrcAlpha) && state.opacity == 1.0f && state.src_format != BitmapFormat::RGBA8888;
+    Vector<ARGB32> source_row;
+    if (!can_blend_source_row)
+        source_row.resize(state.column_count);
+
+    Array<u8, 256> alpha_with_opacity;
+    for (size_t alpha = 0; alpha < alpha_with_opacity.size(); ++alpha) {
+        float pixel_opacity = alpha / 255.0;
+        alpha_with_opacity[alpha] = 255 * (state.opacity * pixel_opacity);
+    }
+    u8 opaque_alpha_with_opacity = state.opacity * 255;
+
     for (int row = 0; row < state.row_count; ++row) {
-        for (int x = 0; x < state.column_count; ++x) {
-            Color dest_color = (has_alpha & BlitState::DstAlpha) ? Color::from_argb(state.dst[x]) : Color::from_rgb(state.dst[x]);
-            if constexpr (has_alpha & BlitState::SrcAlpha) {
-                Color src_color_with_alpha = Color::from_argb(state.src[x]);
-                if (state.src_format == BitmapFormat::RGBA8888)
-                    swap_red_and_blue_channels(src_color_with_alpha);
-                float pixel_opacity = src_color_with_alpha.alpha() / 255.0;
-                src_color_with_alpha.set_alpha(255 * (state.opacity * pixel_opacity));
-                state.dst[x] = dest_color.blend(src_color_with_alpha).value();
-            } else {
-                Color src_color_with_alpha = Color::from_rgb(state.src[x]);
+        if (can_blend_source_row) {
+            blend_pixels(state.dst, state.src, state.column_count, destination_alpha);
+        } else {
+            for (int x = 0; x < state.column_count; ++x) {
+                auto src_color_with_alpha = (has_alpha & BlitState::SrcAlpha) ? Color::from_argb(state.src[x]) : Color::from_rgb(state.src[x]);
                 if (state.src_format == BitmapFormat::RGBA8888)
                     swap_red_and_blue_channels(src_color_with_alpha);
-                src_color_with_alpha.set_alpha(state.opacity * 255);
-                state.dst[x] = dest_color.blend(src_color_with_alpha).value();
+                if constexpr (has_alpha & BlitState::SrcAlpha)
+                    src_color_with_alpha.set_alpha(alpha_with_opacity[src_color_with_alpha.alpha()]);
+                else
+                    src_color_with_alpha.set_alpha(opaque_alpha_with_opacity);
+                source_row[x] = src_color_with_alpha.value();
             }
+            blend_pixels(state.dst, source_row.data(), state.column_count, destination_alpha);
         }
         state.dst += state.dst_pitch;
         state.src += state.src_pitch;
@@ -1164,16 +1178,34 @@ ALWAYS_INLINE static void do_draw_scaled_bitmap(Gfx::Bitmap& target, IntRect con
     i64 clipped_src_bottom_shifted = (clipped_src_rect.y() + clipped_src_rect.height()) * shift;
     i64 clipped_src_right_shifted = (clipped_src_rect.x() + clipped_src_rect.width()) * shift;
 
+    // NOTE: With an alpha channel, the sampled pixels of a row are collected first, and then each uninterrupted span
+    //       of them is blended into the target at once.
+    Vector<ARGB32> blend_span;
+    if constexpr (has_alpha_channel)
+        blend_span.ensure_capacity(clipped_rect.width());
+
     for (int y = clipped_rect.top(); y <= clipped_rect.bottom(); ++y) {
         auto* scanline = (Color*)target.scanline(y);
         auto desired_y = ((y - dst_rect.y()) * vscale + src_top);
         if (desired_y < clipped_src_rect.top() || desired_y > clipped_src_bottom_shifted)
             continue;
 
+        int blend_span_start = clipped_rect.left();
+        auto flush_blend_span = [&] {
+            if (!blend_span.is_empty())
+                blend_pixels((ARGB32*)&scanline[blend_span_start], blend_span.data(), blend_span.size());
+            blend_span.clear_with_capacity();
+        };
+
         for (int x = clipped_rect.left(); x <= clipped_rect.right(); ++x) {
             auto desired_x = ((x - dst_rect.x()) * hscale + src_left);
-            if (desired_x < clipped_src_rect.left() || desired_x > clipped_src_right_shifted)
+            if (desired_x < clipped_src_rect.left() || desired_x > clipped_src_right_shifted) {
+                if constexpr (has_alpha_channel) {
+                    flush_blend_span();
+                    blend_span_start = x + 1;
+                }
                 continue;
+            }
 
             Color src_pixel;
             if constexpr (scaling_mode == Painter::ScalingMode::BilinearBlend) {
@@ -1227,11 +1259,14 @@ ALWAYS_INLINE static void do_draw_scaled_bitmap(Gfx::Bitmap& target, IntRect con
             if (has_opacity)
                 src_pixel.set_alpha(src_pixel.alpha() * opacity);
             if constexpr (has_alpha_channel) {
-                scanline[x] = scanline[x].blend(src_pixel);
+                blend_span.unchecked_append(src_pixel.value());
             } else {
                 scanline[x] = src_pixel;
             }
         }
+
+        if constexpr (has_alpha_channel)
+            flush_blend_span();
     }
 }
 
@@ -1328,12 +1363,61 @@ FLATTEN void Painter::draw_glyph(IntPoint const& point, u32 code_point, Font con
     if (glyph.is_glyph_bitmap()) {
         draw_bitmap(top_left, glyph.glyph_bitmap(), color);
     } else {
-        blit_filtered(top_left, *glyph.bitmap(), glyph.bitmap()->rect(), [color](Color pixel) -> Color {
+        blit_filtered(top_left, *glyph.bitmap(), glyph.bitmap_rect(), [color](Color pixel) -> Color {
             return pixel.multiply(color);
         });
     }
 }
 
+void Painter::draw_glyph_run(Span<DrawGlyph const> glyphs, Font const& font, Color color)
+{
+    if (scale() != 1) {
+        for (auto& glyph : glyphs)
+            draw_glyph(glyph.position, glyph.code_point, font, color);
+        return;
+    }
+
+    // NOTE: This does the same as draw_glyph() for every glyph, but with the blending done in place instead of
+    //       through blit_filtered().
+    for (auto& draw_glyph : glyphs) {
+        auto glyph = font.glyph(draw_glyph.code_point);
+        auto top_left = draw_glyph.position + IntPoint(glyph.left_bearing(), 0);
+
+        if (glyph.is_glyph_bitmap()) {
+            draw_bitmap(top_left, glyph.glyph_bitmap(), color);
+            continue;
+        }
+
+        auto const& source = *glyph.bitmap();
+        VERIFY(source.scale() == 1);
+        auto src_rect = glyph.bitmap_rect().intersected(source.rect());
+        auto dst_rect = IntRect(top_left, src_rect.size()).translated(translation());
+        auto clipped_rect = dst_rect.intersected(clip_rect());
+        if (clipped_rect.is_empty())
+            continue;
+
+        ARGB32* dst = m_target->scanline(clipped_rect.y()) + clipped_rect.x();
+        size_t const dst_skip = m_target->pitch() / sizeof(ARGB32);
+        ARGB32 const* src = source.scanline(src_rect.y() + clipped_rect.y() - dst_rect.y()) + src_rect.x() + clipped_rect.x() - dst_rect.x();
+        size_t const src_skip = source.pitch() / sizeof(ARGB32);
+
+        for (int row = 0; row < clipped_rect.height(); ++row) {
+            for (int x = 0; x < clipped_rect.width(); ++x) {
+                auto pixel = Color::from_argb(src[x]);
+                if (pixel.alpha() == 0)
+                    continue;
+                pixel = pixel.multiply(color);
+                if (pixel.alpha() == 0xff)
+                    dst[x] = pixel.value();
+                else
+                    dst[x] = Color::from_argb(dst[x]).blend(pixel).value();
+            }
+            dst += dst_skip;
+            src += src_skip;
+        }
+    }
+}
+
 void Painter::draw_emoji(IntPoint const& point, Gfx::Bitmap const& emoji, Font const& font)
 {
     IntRect dst_rect {
@@ -1353,14 +1437,14 @@ void Painter::draw_glyph_or_emoji(IntPoint const& point, u32 code_point, Font co
     return draw_glyph_or_emoji(point, it, font, color);
 }
 
+// FIXME: These should live somewhere else.
+static constexpr u32 text_variation_selector = 0xFE0E;
+static constexpr u32 emoji_variation_selector = 0xFE0F;
+static constexpr u32 regional_indicator_symbol_a = 0x1F1E6;
+static constexpr u32 regional_indicator_symbol_z = 0x1F1FF;
+
 void Painter::draw_glyph_or_emoji(IntPoint const& point, Utf8CodePointIterator& it, Font const& font, Color color)
 {
-    // FIXME: These should live somewhere else.
-    constexpr u32 text_variation_selector = 0xFE0E;
-    constexpr u32 emoji_variation_selector = 0xFE0F;
-    constexpr u32 regional_indicator_symbol_a = 0x1F1E6;
-    constexpr u32 regional_indicator_symbol_z = 0x1F1FF;
-
     auto initial_it = it;
     u32 code_point = *it;
     auto next_code_point = it.peek(1);
@@ -2416,6 +2500,9 @@ void Painter::draw_text_run(FloatPoint const& baseline_start, Utf8View const& st
 
     u32 last_code_point = 0;
 
+    // NOTE: Plain text glyphs are collected and drawn together, anything that may be an emoji is drawn right away.
+    Vector<DrawGlyph, 128> glyph_run;
+
     for (auto code_point_iterator = string.begin(); code_point_iterator != string.end(); ++code_point_iterator) {
         auto code_point = *code_point_iterator;
         if (should_paint_as_space(code_point)) {
@@ -2426,10 +2513,25 @@ void Painter::draw_text_run(FloatPoint const& baseline_start, Utf8View const& st
 
         // FIXME: this is probably not the real space taken for complex emojis
         x += font.glyphs_horizontal_kerning(last_code_point, code_point);
-        draw_glyph_or_emoji({ static_cast<int>(x), y }, code_point_iterator, font, color);
+
+        // This is the case in which draw_glyph_or_emoji() draws a text glyph right away.
+        auto next_code_point = code_point_iterator.peek(1);
+        auto code_point_is_regional_indicator = code_point >= regional_indicator_symbol_a && code_point <= regional_indicator_symbol_z;
+        if (!code_point_is_regional_indicator && next_code_point != emoji_variation_selector && font.contains_glyph(code_point)) {
+            glyph_run.append({ { static_cast<int>(x), y }, code_point });
+            if (next_code_point == text_variation_selector)
+                ++code_point_iterator;
+        } else {
+            draw_glyph_run(glyph_run, font, color);
+            glyph_run.clear_with_capacity();
+            draw_glyph_or_emoji({ static_cast<int>(x), y }, code_point_iterator, font, color);
+        }
+
         x += font.glyph_or_emoji_width(code_point) + font.glyph_spacing();
         last_code_point = code_point;
     }
+
+    draw_glyph_run(glyph_run, font, color);
 }
 
 void Painter::draw_scaled_bitmap_with_transform(Gfx::IntRect const& dst_rect, Gfx::Bitmap const& bitmap, Gfx::FloatRect const& src_rect, Gfx::AffineTransform const& transform, float opacity, Gfx::Painter::ScalingMode scaling_mode)
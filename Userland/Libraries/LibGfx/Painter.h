@@ -23,6 +23,11 @@
 
 namespace Gfx {
 
+struct DrawGlyph {
+    IntPoint position;
+    u32 code_point { 0 };
+};
+
 class Painter {
 public:
     explicit Painter(Gfx::Bitmap&);
@@ -91,6 +96,8 @@ public:
     void draw_emoji(IntPoint const&, Gfx::Bitmap const&, Font const&);
     void draw_glyph_or_emoji(IntPoint const&, u32, Font const&, Color);
     void draw_glyph_or_emoji(IntPoint const&, Utf8CodePointIterator&, Font const&, Color);
+    // Draws many glyphs of the same font and color at once, which is cheaper than drawing them one by one.
+    void draw_glyph_run(Span<DrawGlyph const>, Font const&, Color);
     void draw_circle_arc_intersecting(IntRect const&, IntPoint const&, int radius, Color, int thickness);
 
     // Streamlined text drawing routine that does no wrapping/elision/alignment.
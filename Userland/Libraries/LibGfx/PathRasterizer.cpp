@@ -0,0 +1,303 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Math.h>
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/BlendingKernels.h>
+#include <LibGfx/PathRasterizer.h>
+
+namespace Gfx {
+
+PathRasterizer::PathRasterizer(IntRect const& clip_rect)
+    : m_clip_rect(clip_rect)
+{
+}
+
+void PathRasterizer::add_line(FloatPoint const& from, FloatPoint const& to)
+{
+    if (!isfinite(from.x()) || !isfinite(from.y()) || !isfinite(to.x()) || !isfinite(to.y()))
+        return;
+    if (from.y() == to.y())
+        return;
+
+    auto top = from;
+    auto bottom = to;
+    float direction = 1.0f;
+    if (top.y() > bottom.y()) {
+        swap(top, bottom);
+        direction = -1.0f;
+    }
+
+    // NOTE: Edges to the left of the clip rect still matter, as everything right of them is inside the shape.
+    if (bottom.y() <= m_clip_rect.top() || top.y() >= m_clip_rect.bottom() + 1 || min(top.x(), bottom.x()) >= m_clip_rect.right() + 1)
+        return;
+
+    m_edges.append({
+        .x_at_top = top.x(),
+        .dxdy = (bottom.x() - top.x()) / (bottom.y() - top.y()),
+        .top = top.y(),
+        .bottom = bottom.y(),
+        .direction = direction,
+        .first_scanline = static_cast<int>(floorf(max(top.y(), static_cast<float>(m_clip_rect.top())))),
+    });
+}
+
+// Curves are split into enough lines that no point on them is further than this many pixels from the lines. This is
+// much coarser than what Path::split_lines() does, which is fine as the coverage of the pixels is exact.
+static constexpr float curve_tolerance = 0.1f;
+static constexpr float max_line_count_per_curve = 1024;
+
+static int line_count_for_quadratic_bezier_curve(FloatPoint const& p1, FloatPoint const& control, FloatPoint const& p2)
+{
+    auto second_difference = p1 - control * 2 + p2;
+    auto distance = sqrtf(second_difference.x() * second_difference.x() + second_difference.y() * second_difference.y());
+    return max(1, static_cast<int>(min(ceilf(sqrtf(distance / (4 * curve_tolerance))), max_line_count_per_curve)));
+}
+
+static int line_count_for_cubic_bezier_curve(FloatPoint const& p1, FloatPoint const& control_0, FloatPoint const& control_1, FloatPoint const& p2)
+{
+    auto first_difference = p1 - control_0 * 2 + control_1;
+    auto second_difference = control_0 - control_1 * 2 + p2;
+    auto distance = sqrtf(max(first_difference.x() * first_difference.x() + first_difference.y() * first_difference.y(),
+        second_difference.x() * second_difference.x() + second_difference.y() * second_difference.y()));
+    return max(1, static_cast<int>(min(ceilf(sqrtf(3 * distance / (4 * curve_tolerance))), max_line_count_per_curve)));
+}
+
+void PathRasterizer::add_path(Path const& path, AffineTransform const& transform)
+{
+    // NOTE: The curves are split into lines after the transform, so that the tolerance is in pixels. Since this also
+    //       keeps track of where each subpath starts, Path::split_lines() isn't used.
+    FloatPoint untransformed_cursor;
+    auto cursor = transform.map(untransformed_cursor);
+    Optional<FloatPoint> start_of_subpath;
+    auto close_subpath = [&] {
+        if (start_of_subpath.has_value())
+            add_line(cursor, start_of_subpath.release_value());
+    };
+
+    for (auto& segment : path.segments()) {
+        auto point = transform.map(segment.point());
+        if (segment.type() == Segment::Type::MoveTo) {
+            close_subpath();
+            cursor = point;
+            untransformed_cursor = segment.point();
+            continue;
+        }
+        if (!start_of_subpath.has_value())
+            start_of_subpath = cursor;
+
+        switch (segment.type()) {
+        case Segment::Type::LineTo:
+            add_line(cursor, point);
+            break;
+        case Segment::Type::QuadraticBezierCurveTo: {
+            auto control = transform.map(static_cast<QuadraticBezierCurveSegment const&>(segment).through());
+            int line_count = line_count_for_quadratic_bezier_curve(cursor, control, point);
+            auto previous = cursor;
+            for (int i = 1; i <= line_count; ++i) {
+                float t = static_cast<float>(i) / line_count;
+                float s = 1.0f - t;
+                auto next = i == line_count ? point : cursor * (s * s) + control * (2 * s * t) + point * (t * t);
+                add_line(previous, next);
+                previous = next;
+            }
+            break;
+        }
+        case Segment::Type::CubicBezierCurveTo: {
+            auto& curve = static_cast<CubicBezierCurveSegment const&>(segment);
+            auto control_0 = transform.map(curve.through_0());
+            auto control_1 = transform.map(curve.through_1());
+            int line_count = line_count_for_cubic_bezier_curve(cursor, control_0, control_1, point);
+            auto previous = cursor;
+            for (int i = 1; i <= line_count; ++i) {
+                float t = static_cast<float>(i) / line_count;
+                float s = 1.0f - t;
+                auto next = i == line_count ? point : cursor * (s * s * s) + control_0 * (3 * s * s * t) + control_1 * (3 * s * t * t) + point * (t * t * t);
+                add_line(previous, next);
+                previous = next;
+            }
+            break;
+        }
+        case Segment::Type::EllipticalArcTo: {
+            // FIXME: Split the arc after the transform as well.
+            auto& arc = static_cast<EllipticalArcSegment const&>(segment);
+            Painter::for_each_line_segment_on_elliptical_arc(untransformed_cursor, arc.point(), arc.center(), arc.radii(), arc.x_axis_rotation(), arc.theta_1(), arc.theta_delta(), [&](FloatPoint const& p0, FloatPoint const& p1) {
+                add_line(transform.map(p0), transform.map(p1));
+            });
+            break;
+        }
+        case Segment::Type::MoveTo:
+        case Segment::Type::Invalid:
+            VERIFY_NOT_REACHED();
+        }
+        cursor = point;
+        untransformed_cursor = segment.point();
+    }
+    close_subpath();
+}
+
+// Adds the part of a line that lies within the current scanline, with x relative to the clip rect.
+void PathRasterizer::accumulate(float x0, float x1, float height)
+{
+    // The area cut off by a line only adds to the coverage of the pixels to its right. So the parts of a line left of
+    // the clip rect are moved onto its left edge, and the parts right of it are dropped.
+    float width = m_clip_rect.width();
+    auto split_at = [&](float x) {
+        if ((x0 < x && x1 > x) || (x0 > x && x1 < x)) {
+            float t = (x - x0) / (x1 - x0);
+            accumulate(x0, x, height * t);
+            accumulate(x, x1, height * (1.0f - t));
+            return true;
+        }
+        return false;
+    };
+    if (split_at(0.0f) || split_at(width))
+        return;
+    if (x0 >= width && x1 >= width)
+        return;
+
+    accumulate_cells(clamp(x0, 0.0f, width), clamp(x1, 0.0f, width), height);
+}
+
+void PathRasterizer::accumulate_cells(float x0, float x1, float height)
+{
+    if (x0 > x1)
+        swap(x0, x1);
+
+    float x0_floor = floorf(x0);
+    float x1_ceil = ceilf(x1);
+    int x0i = static_cast<int>(x0_floor);
+    int x1i = static_cast<int>(x1_ceil);
+    m_first_dirty_cell = min(m_first_dirty_cell, x0i);
+    m_last_dirty_cell = max(m_last_dirty_cell, max(x0i + 1, x1i));
+
+    if (x1i <= x0i + 1) {
+        // The line stays within one pixel: The part of it right of the line's middle is covered, and the rest of the
+        // height carries over to the next pixel.
+        float middle = 0.5f * (x0 + x1) - x0_floor;
+        m_cells[x0i] += height * (1.0f - middle);
+        m_cells[x0i + 1] += height * middle;
+        return;
+    }
+
+    // The line crosses several pixels: Each of them gets the area of the trapezoid that the line cuts off from it.
+    float inverse_width = 1.0f / (x1 - x0);
+    float x0_fraction = x0 - x0_floor;
+    float first_area = 0.5f * inverse_width * (1.0f - x0_fraction) * (1.0f - x0_fraction);
+    float x1_fraction = x1 - x1_ceil + 1.0f;
+    float last_area = 0.5f * inverse_width * x1_fraction * x1_fraction;
+
+    m_cells[x0i] += height * first_area;
+    if (x1i == x0i + 2) {
+        m_cells[x0i + 1] += height * (1.0f - first_area - last_area);
+    } else {
+        float second_area = inverse_width * (1.5f - x0_fraction);
+        m_cells[x0i + 1] += height * (second_area - first_area);
+        for (int x = x0i + 2; x < x1i - 1; ++x)
+            m_cells[x] += height * inverse_width;
+        float area_before_last = second_area + (x1i - x0i - 3) * inverse_width;
+        m_cells[x1i - 1] += height * (1.0f - area_before_last - last_area);
+    }
+    m_cells[x1i] += height * last_area;
+}
+
+void PathRasterizer::rasterize(Painter::WindingRule winding_rule, CoverageCallback callback)
+{
+    if (m_edges.is_empty() || m_clip_rect.is_empty())
+        return;
+
+    // Build the edge table: The edges are sorted by the scanline they start on, which is a counting sort.
+    Vector<size_t> edge_count_before_scanline;
+    edge_count_before_scanline.resize(m_clip_rect.height() + 1);
+    for (auto const& edge : m_edges)
+        ++edge_count_before_scanline[edge.first_scanline - m_clip_rect.top() + 1];
+    for (int i = 1; i <= m_clip_rect.height(); ++i)
+        edge_count_before_scanline[i] += edge_count_before_scanline[i - 1];
+    Vector<Edge> edge_table;
+    edge_table.resize(m_edges.size());
+    for (auto const& edge : m_edges)
+        edge_table[edge_count_before_scanline[edge.first_scanline - m_clip_rect.top()]++] = edge;
+
+    int width = m_clip_rect.width();
+    // NOTE: Lines ending on the right edge of the clip rect touch the two cells after it.
+    m_cells.resize(width + 2);
+    m_coverage.resize(width);
+
+    auto coverage_for_area = [winding_rule](float area) {
+        area = fabsf(area);
+        if (winding_rule == Painter::WindingRule::EvenOdd) {
+            area = fmodf(area, 2.0f);
+            return area > 1.0f ? 2.0f - area : area;
+        }
+        return min(area, 1.0f);
+    };
+
+    // Anything below this is invisible, and is only left over from rounding errors after the last edge.
+    constexpr float minimum_visible_coverage = 1.0f / 512;
+
+    Vector<Edge const*> active_edges;
+    size_t next_edge = 0;
+    for (int y = edge_table.first().first_scanline; y <= m_clip_rect.bottom(); ++y) {
+        active_edges.remove_all_matching([&](auto const* edge) { return edge->bottom <= y; });
+        for (; next_edge < edge_table.size() && edge_table[next_edge].first_scanline == y; ++next_edge)
+            active_edges.append(&edge_table[next_edge]);
+
+        if (active_edges.is_empty()) {
+            if (next_edge == edge_table.size())
+                break;
+            // Skip ahead to the scanline where the next edge starts.
+            y = edge_table[next_edge].first_scanline - 1;
+            continue;
+        }
+
+        m_first_dirty_cell = width + 2;
+        m_last_dirty_cell = -1;
+        for (auto const* edge : active_edges) {
+            float top = max(static_cast<float>(y), edge->top);
+            float bottom = min(y + 1.0f, edge->bottom);
+            float x_at_top = edge->x_at_top + (top - edge->top) * edge->dxdy - m_clip_rect.left();
+            float x_at_bottom = edge->x_at_top + (bottom - edge->top) * edge->dxdy - m_clip_rect.left();
+            accumulate(x_at_top, x_at_bottom, (bottom - top) * edge->direction);
+        }
+        if (m_last_dirty_cell < 0)
+            continue;
+
+        int first_cell = m_first_dirty_cell;
+        int last_cell = min(m_last_dirty_cell, width - 1);
+        float area = 0;
+        int x = first_cell;
+        for (; x <= last_cell; ++x) {
+            area += m_cells[x];
+            m_coverage[x - first_cell] = coverage_for_area(area);
+        }
+        // Right of the last edge, the coverage stays the same until the end of the scanline.
+        if (float coverage = coverage_for_area(area); coverage >= minimum_visible_coverage) {
+            for (; x < width; ++x)
+                m_coverage[x - first_cell] = coverage;
+        }
+
+        for (int cell = first_cell; cell <= m_last_dirty_cell; ++cell)
+            m_cells[cell] = 0;
+
+        if (x > first_cell)
+            callback({ m_clip_rect.left() + first_cell, y }, m_coverage.span().slice(0, x - first_cell));
+    }
+}
+
+void PathRasterizer::fill(Bitmap& bitmap, Color color, Painter::WindingRule winding_rule)
+{
+    VERIFY(bitmap.physical_rect().contains(m_clip_rect));
+
+    Vector<ARGB32> pixels;
+    rasterize(winding_rule, [&](IntPoint const& start, Span<float const> coverage) {
+        pixels.resize(coverage.size());
+        for (size_t i = 0; i < coverage.size(); ++i)
+            pixels[i] = color.with_alpha(static_cast<u8>(color.alpha() * coverage[i] + 0.5f)).value();
+        blend_pixels(bitmap.scanline(start.y()) + start.x(), pixels.data(), pixels.size());
+    });
+}
+
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Function.h>
+#include <AK/Span.h>
+#include <AK/Vector.h>
+#include <LibGfx/AffineTransform.h>
+#include <LibGfx/Color.h>
+#include <LibGfx/Painter.h>
+#include <LibGfx/Path.h>
+#include <LibGfx/Point.h>
+#include <LibGfx/Rect.h>
+
+namespace Gfx {
+
+// Computes how much of each pixel is covered by a shape, by summing up the exact areas that its edges cut off, the way
+// font rasterizers do it. The edges are sorted by their top, and each scanline only visits the edges crossing it and
+// the pixels between the leftmost and rightmost of them, so large clip rects with small shapes in them are cheap.
+class PathRasterizer {
+public:
+    // Only the coverage of pixels inside the clip rect is computed.
+    explicit PathRasterizer(IntRect const& clip_rect);
+
+    void add_line(FloatPoint const& from, FloatPoint const& to);
+
+    // NOTE: Subpaths are closed implicitly, as filling requires.
+    void add_path(Path const&, AffineTransform const& = {});
+
+    // Calls the callback with the coverage (between 0 and 1) of the pixels in each scanline, starting at the leftmost
+    // pixel that is touched by the shape. Pixels that aren't covered at all may be left out.
+    using CoverageCallback = Function<void(IntPoint const& start, Span<float const> coverage)>;
+    void rasterize(Painter::WindingRule, CoverageCallback);
+
+    // Blends the color into the covered pixels. The bitmap has to contain the clip rect.
+    void fill(Bitmap&, Color, Painter::WindingRule);
+
+private:
+    struct Edge {
+        float x_at_top { 0 };
+        float dxdy { 0 };
+        float top { 0 };
+        float bottom { 0 };
+        // 1 for edges going down, -1 for edges going up.
+        float direction { 0 };
+        // The first scanline inside the clip rect that the edge crosses.
+        int first_scanline { 0 };
+    };
+
+    void accumulate(float x0, float x1, float height);
+    void accumulate_cells(float x0, float x1, float height);
+
+    IntRect m_clip_rect;
+    Vector<Edge> m_edges;
+
+    // The area that the edges cut off from each pixel of the current scanline, relative to the clip rect. Summing
+    // these up from left to right gives the coverage.
+    Vector<float> m_cells;
+    int m_first_dirty_cell { 0 };
+    int m_last_dirty_cell { -1 };
+    Vector<float> m_coverage;
+};
+
+}
@@ -11,7 +11,6 @@
 #include <AK/HashTable.h>
 #include <AK/QuickSort.h>
 #include <AK/ScopeGuard.h>
-#include <AK/StringBuilder.h>
 #include <AK/TemporaryChange.h>
 #include <LibCrypto/BigInt/SignedBigInteger.h>
 #include <LibJS/AST.h>
@@ -3580,7 +3579,8 @@ Completion TemplateLiteral::execute(Interpreter& interpreter) const
     InterpreterNodeScope node_scope { interpreter, *this };
     auto& vm = interpreter.vm();
 
-    StringBuilder string_builder;
+    // NOTE: The parts are concatenated into a rope, so that building a string like `${s}...` in a loop doesn't copy s every time.
+    PrimitiveString* result = &vm.empty_string();
 
     for (auto& expression : m_expressions) {
         // 1. Let head be the TV of TemplateHead as defined in 12.8.6.
@@ -3590,15 +3590,15 @@ Completion TemplateLiteral::execute(Interpreter& interpreter) const
         auto sub = TRY(expression.execute(interpreter)).release_value();
 
         // 4. Let middle be ? ToString(sub).
-        auto string = TRY(sub.to_string(vm));
-        string_builder.append(string);
+        auto* string = TRY(sub.to_primitive_string(vm));
+        result = js_rope_string(vm, *result, *string);
 
         // 5. Let tail be the result of evaluating TemplateSpans.
         // 6. ReturnIfAbrupt(tail).
     }
 
     // 7. Return the string-concatenation of head, middle, and tail.
-    return Value { js_string(interpreter.heap(), string_builder.build()) };
+    return Value { result };
 }
 
 void TaggedTemplateLiteral::dump(int indent) const
@@ -804,9 +804,32 @@ void Yield::replace_references_impl(BasicBlock const& from, BasicBlock const& to
         m_continuation_label = Label { to };
 }
 
+static Optional<u32> array_index_from_value(Value value)
+{
+    if (!value.is_integral_number())
+        return {};
+    auto index = value.as_double();
+    if (index < 0 || index >= NumericLimits<u32>::max())
+        return {};
+    return static_cast<u32>(index);
+}
+
 ThrowCompletionOr<void> GetByValue::execute_impl(Bytecode::Interpreter& interpreter) const
 {
     auto& vm = interpreter.vm();
+
+    // Fast path: Elements of arrays are plain data properties, so we can read them directly.
+    if (auto base = interpreter.reg(m_base); base.is_object()) {
+        if (auto index = array_index_from_value(interpreter.accumulator()); index.has_value()) {
+            if (auto const* storage = array_element_storage(base.as_object())) {
+                if (auto value = storage->get_value_or_empty(*index); !value.is_empty()) {
+                    interpreter.accumulator() = value;
+                    return {};
+                }
+            }
+        }
+    }
+
     auto* object = TRY(interpreter.reg(m_base).to_object(vm));
 
     auto property_key = TRY(interpreter.accumulator().to_property_key(vm));
@@ -818,6 +841,17 @@ ThrowCompletionOr<void> GetByValue::execute_impl(Bytecode::Interpreter& interpre
 ThrowCompletionOr<void> PutByValue::execute_impl(Bytecode::Interpreter& interpreter) const
 {
     auto& vm = interpreter.vm();
+
+    // Fast path: Overwriting an existing array element can't hit a setter or a non-writable property.
+    if (auto base = interpreter.reg(m_base); m_kind == PropertyKind::KeyValue && base.is_object()) {
+        if (auto index = array_index_from_value(interpreter.reg(m_property)); index.has_value()) {
+            if (auto* storage = array_element_storage(base.as_object()); storage && !storage->get_value_or_empty(*index).is_empty()) {
+                storage->put(*index, interpreter.accumulator());
+                return {};
+            }
+        }
+    }
+
     auto* object = TRY(interpreter.reg(m_base).to_object(vm));
 
     auto property_key = TRY(interpreter.reg(m_property).to_property_key(vm));
@@ -176,6 +176,7 @@ class Module;
 class NativeFunction;
 class ObjectEnvironment;
 class PrimitiveString;
+class ProgramCache;
 class PromiseCapability;
 class PromiseReaction;
 class PropertyAttributes;
@@ -5,11 +5,13 @@
  */
 
 #include <AK/Platform.h>
+#include <AK/QuickSort.h>
 #include <AK/Random.h>
 #include <AK/Vector.h>
 #include <LibJS/Heap/BlockAllocator.h>
 #include <LibJS/Heap/HeapBlock.h>
 #include <sys/mman.h>
+#include <unistd.h>
 
 #ifdef HAS_ADDRESS_SANITIZER
 #    include <sanitizer/asan_interface.h>
@@ -17,43 +19,100 @@
 
 namespace JS {
 
-BlockAllocator::~BlockAllocator()
+static void release_block(void* block)
 {
-    for (auto* block : m_blocks) {
-        ASAN_UNPOISON_MEMORY_REGION(block, HeapBlock::block_size);
-#ifdef AK_OS_SERENITY
-        if (munmap(block, HeapBlock::block_size) < 0) {
+    if (munmap(block, HeapBlock::block_size) < 0) {
+        perror("munmap");
+        VERIFY_NOT_REACHED();
+    }
+}
+
+#ifndef AK_OS_SERENITY
+static size_t page_size()
+{
+    static size_t const page_size = sysconf(_SC_PAGESIZE);
+    return page_size;
+}
+
+static void* map_block()
+{
+    auto map = [](size_t size) {
+        auto* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+        if (mapping == MAP_FAILED) {
+            perror("mmap");
+            VERIFY_NOT_REACHED();
+        }
+        return static_cast<u8*>(mapping);
+    };
+    auto unmap = [](u8* address, size_t size) {
+        if (size != 0 && munmap(address, size) < 0) {
             perror("munmap");
             VERIFY_NOT_REACHED();
         }
-#else
-        free(block);
+    };
+
+    if (page_size() >= HeapBlock::block_size)
+        return map(HeapBlock::block_size);
+
+    // NOTE: Blocks have to be aligned to their size, but mmap() only aligns to the page size.
+    //       So we map enough to be sure an aligned block fits, and unmap the rest.
+    auto mapping_size = HeapBlock::block_size * 2 - page_size();
+    auto* mapping = map(mapping_size);
+    auto* block = reinterpret_cast<u8*>(align_up_to(reinterpret_cast<FlatPtr>(mapping), HeapBlock::block_size));
+    unmap(mapping, block - mapping);
+    unmap(block + HeapBlock::block_size, mapping + mapping_size - block - HeapBlock::block_size);
+    return block;
+}
 #endif
+
+BlockAllocator::~BlockAllocator()
+{
+    for (auto* block : m_hot_blocks) {
+        ASAN_UNPOISON_MEMORY_REGION(block, HeapBlock::block_size);
+        release_block(block);
+    }
+    for (auto* block : m_cold_blocks) {
+        ASAN_UNPOISON_MEMORY_REGION(block, HeapBlock::block_size);
+        release_block(block);
     }
 }
 
 void* BlockAllocator::allocate_block([[maybe_unused]] char const* name)
 {
-    if (!m_blocks.is_empty()) {
-        // To reduce predictability, take a random block from the cache.
-        size_t random_index = get_random_uniform(m_blocks.size());
-        auto* block = m_blocks.unstable_take(random_index);
+    // To reduce predictability, take a random block from the cache.
+    // NOTE: Prefer hot blocks, as their pages are still resident.
+    void* block = nullptr;
+    bool block_is_cold = false;
+    if (!m_hot_blocks.is_empty()) {
+        block = m_hot_blocks.unstable_take(get_random_uniform(m_hot_blocks.size()));
+    } else if (!m_cold_blocks.is_empty()) {
+        block = m_cold_blocks.unstable_take(get_random_uniform(m_cold_blocks.size()));
+        block_is_cold = true;
+    }
+
+    if (block) {
         ASAN_UNPOISON_MEMORY_REGION(block, HeapBlock::block_size);
 #ifdef AK_OS_SERENITY
+        if (block_is_cold && madvise(block, HeapBlock::block_size, MADV_SET_NONVOLATILE) < 0) {
+            perror("madvise");
+            VERIFY_NOT_REACHED();
+        }
         if (set_mmap_name(block, HeapBlock::block_size, name) < 0) {
             perror("set_mmap_name");
             VERIFY_NOT_REACHED();
         }
+#else
+        // NOTE: Purged blocks are simply faulted back in (zero-filled) on first access.
+        (void)block_is_cold;
 #endif
         return block;
     }
 
 #ifdef AK_OS_SERENITY
-    auto* block = (HeapBlock*)serenity_mmap(nullptr, HeapBlock::block_size, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_RANDOMIZED | MAP_PRIVATE, 0, 0, HeapBlock::block_size, name);
+    block = serenity_mmap(nullptr, HeapBlock::block_size, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_RANDOMIZED | MAP_PRIVATE | MAP_PURGEABLE, 0, 0, HeapBlock::block_size, name);
     VERIFY(block != MAP_FAILED);
 #else
-    auto* block = (HeapBlock*)aligned_alloc(HeapBlock::block_size, HeapBlock::block_size);
-    VERIFY(block);
+    block = map_block();
 #endif
     return block;
 }
@@ -61,20 +120,61 @@ void* BlockAllocator::allocate_block([[maybe_unused]] char const* name)
 void BlockAllocator::deallocate_block(void* block)
 {
     VERIFY(block);
-    if (m_blocks.size() >= max_cached_blocks) {
+    if (m_hot_blocks.size() + m_cold_blocks.size() >= max_cached_blocks) {
+        release_block(block);
+        return;
+    }
+
+    ASAN_POISON_MEMORY_REGION(block, HeapBlock::block_size);
+    m_hot_blocks.append(block);
+}
+
+void BlockAllocator::purge_cached_blocks()
+{
+    if (m_hot_blocks.size() <= max_hot_cached_blocks)
+        return;
+
+    // Keep the most recently freed blocks hot, and purge the rest.
+    auto purge_count = m_hot_blocks.size() - max_hot_cached_blocks;
+    Vector<void*> blocks_to_purge;
+    blocks_to_purge.ensure_capacity(purge_count);
+    for (size_t i = 0; i < purge_count; ++i)
+        blocks_to_purge.unchecked_append(m_hot_blocks[i]);
+    m_hot_blocks.remove(0, purge_count);
+
 #ifdef AK_OS_SERENITY
-        if (munmap(block, HeapBlock::block_size) < 0) {
-            perror("munmap");
+    // NOTE: Every block is its own purgeable mapping here, so they have to be made volatile one by one.
+    for (auto* block : blocks_to_purge) {
+        if (madvise(block, HeapBlock::block_size, MADV_SET_VOLATILE) < 0) {
+            perror("madvise");
             VERIFY_NOT_REACHED();
         }
+    }
 #else
-        free(block);
-#endif
-        return;
+    // Coalesce blocks that are adjacent in memory, so that each run only costs one madvise() call.
+    quick_sort(blocks_to_purge);
+    for (size_t run_start = 0; run_start < blocks_to_purge.size();) {
+        size_t run_end = run_start + 1;
+        while (run_end < blocks_to_purge.size()
+            && static_cast<u8*>(blocks_to_purge[run_end]) == static_cast<u8*>(blocks_to_purge[run_end - 1]) + HeapBlock::block_size)
+            ++run_end;
+
+        // NOTE: Pages may be larger than blocks, in which case only the pages that lie entirely within the run can be
+        //       purged. The others stay resident until the blocks sharing them are purged along with them.
+        auto run_start_address = reinterpret_cast<FlatPtr>(blocks_to_purge[run_start]);
+        auto run_end_address = run_start_address + (run_end - run_start) * HeapBlock::block_size;
+        auto purge_start = align_up_to(run_start_address, page_size());
+        auto purge_end = run_end_address - run_end_address % page_size();
+        if (purge_start < purge_end && madvise(reinterpret_cast<void*>(purge_start), purge_end - purge_start, MADV_DONTNEED) < 0) {
+            perror("madvise");
+            VERIFY_NOT_REACHED();
+        }
+        run_start = run_end;
     }
+#endif
 
-    ASAN_POISON_MEMORY_REGION(block, HeapBlock::block_size);
-    m_blocks.append(block);
+    m_cold_blocks.extend(move(blocks_to_purge));
+    m_total_purged_block_count += purge_count;
 }
 
 }
@@ -19,10 +19,23 @@ public:
     void* allocate_block(char const* name);
     void deallocate_block(void*);
 
+    // Hands the memory of cached blocks beyond the hot reserve back to the kernel, in as few calls as possible.
+    void purge_cached_blocks();
+
+    size_t hot_cached_block_count() const { return m_hot_blocks.size(); }
+    size_t cold_cached_block_count() const { return m_cold_blocks.size(); }
+    size_t total_purged_block_count() const { return m_total_purged_block_count; }
+
 private:
     static constexpr size_t max_cached_blocks = 512;
 
-    Vector<void*, max_cached_blocks> m_blocks;
+    // Blocks that are cached but still backed by memory, so reusing them doesn't fault in new pages.
+    static constexpr size_t max_hot_cached_blocks = 32;
+
+    Vector<void*, max_hot_cached_blocks> m_hot_blocks;
+    Vector<void*> m_cold_blocks;
+
+    size_t m_total_purged_block_count { 0 };
 };
 
 }
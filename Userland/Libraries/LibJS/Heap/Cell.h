@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
 #include <AK/Badge.h>
 #include <AK/Format.h>
 #include <AK/Forward.h>
@@ -36,6 +37,10 @@ public:
     bool is_marked() const { return m_mark; }
     void set_marked(bool b) { m_mark = b; }
 
+    // Marks the cell and returns whether it was already marked. This is safe to call from
+    // multiple marking threads at once, exactly one of them will see `false` for a given cell.
+    bool test_and_set_marked() { return AK::atomic_exchange(&m_mark, true, AK::memory_order_relaxed); }
+
     enum class State {
         Live,
         Dead,
@@ -97,7 +102,8 @@ protected:
     void set_overrides_must_survive_garbage_collection(bool b) { m_overrides_must_survive_garbage_collection = b; }
 
 private:
-    bool m_mark : 1 { false };
+    // NOTE: m_mark is not a bitfield member so that it can be set atomically during parallel marking.
+    bool m_mark { false };
     bool m_overrides_must_survive_garbage_collection : 1 { false };
     State m_state : 1 { State::Live };
 };
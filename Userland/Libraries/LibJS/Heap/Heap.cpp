@@ -14,6 +14,7 @@
 #include <LibJS/Heap/Handle.h>
 #include <LibJS/Heap/Heap.h>
 #include <LibJS/Heap/HeapBlock.h>
+#include <LibJS/Heap/ParallelMarker.h>
 #include <LibJS/Interpreter.h>
 #include <LibJS/Runtime/Object.h>
 #include <LibJS/Runtime/WeakContainer.h>
@@ -41,6 +42,8 @@ Heap::Heap(VM& vm)
     gc_perf_string_id = perf_register_string(gc_signpost_string.characters_without_null_termination(), gc_signpost_string.length());
 #endif
 
+    m_time_since_last_gc.start();
+
     if constexpr (HeapBlock::min_possible_cell_size <= 16) {
         m_allocators.append(make<CellAllocator>(16));
     }
@@ -53,6 +56,18 @@ Heap::Heap(VM& vm)
     m_allocators.append(make<CellAllocator>(512));
     m_allocators.append(make<CellAllocator>(1024));
     m_allocators.append(make<CellAllocator>(3072));
+
+    static_assert(max_cell_size % size_class_granularity == 0);
+    VERIFY(m_allocators.last()->cell_size() == max_cell_size);
+    for (size_t size_class = 0; size_class < m_allocator_for_size_class.size(); ++size_class) {
+        auto cell_size = size_class * size_class_granularity;
+        for (auto& allocator : m_allocators) {
+            if (allocator->cell_size() >= cell_size) {
+                m_allocator_for_size_class[size_class] = allocator.ptr();
+                break;
+            }
+        }
+    }
 }
 
 Heap::~Heap()
@@ -63,10 +78,10 @@ Heap::~Heap()
 
 ALWAYS_INLINE CellAllocator& Heap::allocator_for_size(size_t cell_size)
 {
-    for (auto& allocator : m_allocators) {
-        if (allocator->cell_size() >= cell_size)
-            return *allocator;
-    }
+    // NOTE: Every allocator's cell size is a multiple of the size class granularity, so rounding up here never picks a bigger allocator than necessary.
+    auto size_class = ceil_div(cell_size, size_class_granularity);
+    if (size_class < m_allocator_for_size_class.size())
+        return *m_allocator_for_size_class[size_class];
     dbgln("Cannot get CellAllocator for cell size {}, largest available is {}!", cell_size, m_allocators.last()->cell_size());
     VERIFY_NOT_REACHED();
 }
@@ -83,6 +98,8 @@ Cell* Heap::allocate_cell(size_t size)
     }
 
     auto& allocator = allocator_for_size(size);
+    ++m_allocated_cells_since_last_gc;
+    m_allocated_cell_bytes_since_last_gc += allocator.cell_size();
     return allocator.allocate_cell(*this);
 }
 
@@ -205,7 +222,10 @@ __attribute__((no_sanitize("address"))) void Heap::gather_conservative_roots(Has
 
 class MarkingVisitor final : public Cell::Visitor {
 public:
-    MarkingVisitor() = default;
+    explicit MarkingVisitor(Vector<Cell*>& work_queue)
+        : m_work_queue(work_queue)
+    {
+    }
 
     virtual void visit_impl(Cell& cell) override
     {
@@ -214,17 +234,37 @@ public:
         dbgln_if(HEAP_DEBUG, "  ! {}", &cell);
 
         cell.set_marked(true);
-        cell.visit_edges(*this);
+        m_work_queue.append(&cell);
+    }
+
+    // NOTE: Cells are traced from an explicit work queue rather than recursively,
+    //       so that long object chains can't overflow the stack.
+    void mark_all_live_cells()
+    {
+        while (!m_work_queue.is_empty())
+            m_work_queue.take_last()->visit_edges(*this);
     }
+
+private:
+    Vector<Cell*>& m_work_queue;
 };
 
 void Heap::mark_live_cells(HashTable<Cell*> const& roots)
 {
     dbgln_if(HEAP_DEBUG, "mark_live_cells:");
 
-    MarkingVisitor visitor;
-    for (auto* root : roots)
-        visitor.visit(root);
+    Vector<Cell*> work_queue;
+    if (m_parallel_marker) {
+        work_queue.ensure_capacity(roots.size());
+        for (auto* root : roots)
+            work_queue.unchecked_append(root);
+        m_parallel_marker->mark(work_queue);
+    } else {
+        MarkingVisitor visitor(work_queue);
+        for (auto* root : roots)
+            visitor.visit(root);
+        visitor.mark_all_live_cells();
+    }
 
     for (auto& inverse_root : m_uprooted_cells)
         inverse_root->set_marked(false);
@@ -232,6 +272,23 @@ void Heap::mark_live_cells(HashTable<Cell*> const& roots)
     m_uprooted_cells.clear();
 }
 
+size_t Heap::marking_thread_count() const
+{
+    return m_parallel_marker ? m_parallel_marker->thread_count() : 1;
+}
+
+void Heap::set_marking_thread_count(size_t thread_count)
+{
+    VERIFY(!m_collecting_garbage);
+    if (thread_count == marking_thread_count())
+        return;
+    if (thread_count <= 1) {
+        m_parallel_marker = nullptr;
+        return;
+    }
+    m_parallel_marker = make<ParallelMarker>(thread_count);
+}
+
 bool Heap::cell_must_survive_garbage_collection(Cell const& cell)
 {
     if (!cell.overrides_must_survive_garbage_collection({}))
@@ -263,11 +320,13 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
 
     for_each_block([&](auto& block) {
         bool block_has_live_cells = false;
+        bool block_has_collected_cells = false;
         bool block_was_full = block.is_full();
         block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
             if (!cell->is_marked() && !cell_must_survive_garbage_collection(*cell)) {
                 dbgln_if(HEAP_DEBUG, "  ~ {}", cell);
                 block.deallocate(cell);
+                block_has_collected_cells = true;
                 ++collected_cells;
                 collected_cell_bytes += block.cell_size();
             } else {
@@ -277,9 +336,13 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
                 live_cell_bytes += block.cell_size();
             }
         });
-        if (!block_has_live_cells)
+        if (!block_has_live_cells) {
             empty_blocks.append(&block);
-        else if (block_was_full != block.is_full())
+            return IterationDecision::Continue;
+        }
+        if (block_has_collected_cells)
+            block.rebuild_freelist_after_sweep();
+        if (block_was_full != block.is_full())
             full_blocks_that_became_usable.append(&block);
         return IterationDecision::Continue;
     });
@@ -297,6 +360,8 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
         allocator_for_size(block->cell_size()).block_did_become_usable({}, *block);
     }
 
+    m_block_allocator.purge_cached_blocks();
+
     if constexpr (HEAP_DEBUG) {
         for_each_block([&](auto& block) {
             dbgln(" > Live HeapBlock @ {}: cell_size={}", &block, block.cell_size());
@@ -320,8 +385,17 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
         dbgln("Collected cells: {} ({} bytes)", collected_cells, collected_cell_bytes);
         dbgln("    Live blocks: {} ({} bytes)", live_block_count, live_block_count * HeapBlock::block_size);
         dbgln("   Freed blocks: {} ({} bytes)", empty_blocks.size(), empty_blocks.size() * HeapBlock::block_size);
+        dbgln("     Hot blocks: {} ({} bytes, cached and resident)", m_block_allocator.hot_cached_block_count(), m_block_allocator.hot_cached_block_count() * HeapBlock::block_size);
+        dbgln("    Cold blocks: {} ({} bytes, cached and purged, {} purged in total)", m_block_allocator.cold_cached_block_count(), m_block_allocator.cold_cached_block_count() * HeapBlock::block_size, m_block_allocator.total_purged_block_count());
+        dbgln("  Estimated RSS: {} bytes", (live_block_count + m_block_allocator.hot_cached_block_count()) * HeapBlock::block_size);
+        auto mutator_time_ms = max<i64>(m_time_since_last_gc.elapsed() - time_spent, 1);
+        dbgln("      Allocated: {} cells ({} bytes) since last GC, {} cells/ms", m_allocated_cells_since_last_gc, m_allocated_cell_bytes_since_last_gc, m_allocated_cells_since_last_gc / mutator_time_ms);
         dbgln("=============================================");
     }
+
+    m_allocated_cells_since_last_gc = 0;
+    m_allocated_cell_bytes_since_last_gc = 0;
+    m_time_since_last_gc.start();
 }
 
 void Heap::did_create_handle(Badge<HandleImpl>, HandleImpl& impl)
@@ -6,13 +6,16 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/Badge.h>
 #include <AK/HashTable.h>
 #include <AK/IntrusiveList.h>
 #include <AK/Noncopyable.h>
 #include <AK/NonnullOwnPtr.h>
+#include <AK/OwnPtr.h>
 #include <AK/Types.h>
 #include <AK/Vector.h>
+#include <LibCore/ElapsedTimer.h>
 #include <LibCore/Forward.h>
 #include <LibJS/Forward.h>
 #include <LibJS/Heap/BlockAllocator.h>
@@ -24,6 +27,8 @@
 
 namespace JS {
 
+class ParallelMarker;
+
 class Heap {
     AK_MAKE_NONCOPYABLE(Heap);
     AK_MAKE_NONMOVABLE(Heap);
@@ -62,6 +67,11 @@ public:
     bool should_collect_on_every_allocation() const { return m_should_collect_on_every_allocation; }
     void set_should_collect_on_every_allocation(bool b) { m_should_collect_on_every_allocation = b; }
 
+    // Marking is serial by default. A count above 1 traces the heap on that many threads (including the collecting one),
+    // which requires every visit_edges() implementation in the program to be safe to run concurrently.
+    size_t marking_thread_count() const;
+    void set_marking_thread_count(size_t);
+
     void did_create_handle(Badge<HandleImpl>, HandleImpl&);
     void did_destroy_handle(Badge<HandleImpl>, HandleImpl&);
 
@@ -109,6 +119,14 @@ private:
 
     Vector<NonnullOwnPtr<CellAllocator>> m_allocators;
 
+    static constexpr size_t size_class_granularity = 16;
+    static constexpr size_t max_cell_size = 3072;
+    AK::Array<CellAllocator*, max_cell_size / size_class_granularity + 1> m_allocator_for_size_class {};
+
+    size_t m_allocated_cells_since_last_gc { 0 };
+    size_t m_allocated_cell_bytes_since_last_gc { 0 };
+    Core::ElapsedTimer m_time_since_last_gc;
+
     HandleImpl::List m_handles;
     MarkedVectorBase::List m_marked_vectors;
     WeakContainer::List m_weak_containers;
@@ -117,6 +135,8 @@ private:
 
     BlockAllocator m_block_allocator;
 
+    OwnPtr<ParallelMarker> m_parallel_marker;
+
     size_t m_gc_deferrals { 0 };
     bool m_should_gc_when_deferral_ends { false };
 
@@ -63,4 +63,23 @@ void HeapBlock::deallocate(Cell* cell)
 #endif
 }
 
+void HeapBlock::rebuild_freelist_after_sweep()
+{
+    auto end = has_lazy_freelist() ? m_next_lazy_freelist_index : cell_count();
+    while (end > 0 && cell(end - 1)->state() == Cell::State::Dead)
+        --end;
+    m_next_lazy_freelist_index = end;
+
+    // NOTE: We walk backwards so that allocation from the freelist proceeds in increasing address order.
+    m_freelist = nullptr;
+    for (size_t i = end; i > 0; --i) {
+        auto* dead_cell = cell(i - 1);
+        if (dead_cell->state() != Cell::State::Dead)
+            continue;
+        auto* freelist_entry = static_cast<FreelistEntry*>(dead_cell);
+        freelist_entry->next = m_freelist;
+        m_freelist = freelist_entry;
+    }
+}
+
 }
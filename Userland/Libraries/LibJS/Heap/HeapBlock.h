@@ -49,6 +49,10 @@ public:
 
     void deallocate(Cell*);
 
+    // Called after sweeping a block that still has live cells. Dead cells at the end of the block are handed back
+    // to the bump allocator, and the remaining dead cells are threaded onto the freelist in address order.
+    void rebuild_freelist_after_sweep();
+
     template<typename Callback>
     void for_each_cell(Callback callback)
     {
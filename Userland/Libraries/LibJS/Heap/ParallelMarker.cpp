@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <LibJS/Heap/Cell.h>
+#include <LibJS/Heap/ParallelMarker.h>
+#include <sched.h>
+
+namespace JS {
+
+// Once a participant's private stack grows beyond this many cells, half of it is published for others to steal.
+static constexpr size_t publish_threshold = 64;
+
+class ParallelMarker::Worker final : public Cell::Visitor {
+public:
+    Worker() = default;
+
+    void mark_root(Cell& cell)
+    {
+        if (cell.test_and_set_marked())
+            return;
+        m_shared_work.append(&cell);
+        m_shared_work_size.store(m_shared_work.size(), AK::memory_order_relaxed);
+    }
+
+    void drain_local_stack()
+    {
+        while (!m_local_stack.is_empty()) {
+            auto* cell = m_local_stack.take_last();
+            cell->visit_edges(*this);
+
+            if (m_local_stack.size() > publish_threshold && !has_shared_work())
+                publish_half_of_local_stack();
+        }
+    }
+
+    bool has_shared_work() const { return m_shared_work_size.load(AK::memory_order_relaxed) != 0; }
+
+    // Moves every published cell back onto the private stack.
+    bool take_own_shared_work()
+    {
+        if (!has_shared_work())
+            return false;
+        Threading::MutexLocker locker(m_shared_work_mutex);
+        if (m_shared_work.is_empty())
+            return false;
+        m_local_stack.extend(move(m_shared_work));
+        m_shared_work.clear();
+        m_shared_work_size.store(0, AK::memory_order_relaxed);
+        return true;
+    }
+
+    // Moves half (at least one) of `victim`'s published cells onto this worker's private stack.
+    bool steal_from(Worker& victim)
+    {
+        if (!victim.has_shared_work())
+            return false;
+        Threading::MutexLocker locker(victim.m_shared_work_mutex);
+        auto available = victim.m_shared_work.size();
+        if (available == 0)
+            return false;
+        auto count = max<size_t>(available / 2, 1);
+        for (size_t i = 0; i < count; ++i)
+            m_local_stack.append(victim.m_shared_work.take_last());
+        victim.m_shared_work_size.store(victim.m_shared_work.size(), AK::memory_order_relaxed);
+        return true;
+    }
+
+private:
+    virtual void visit_impl(Cell& cell) override
+    {
+        if (cell.test_and_set_marked())
+            return;
+        dbgln_if(HEAP_DEBUG, "  ! {}", &cell);
+        m_local_stack.append(&cell);
+    }
+
+    void publish_half_of_local_stack()
+    {
+        Threading::MutexLocker locker(m_shared_work_mutex);
+        auto count = m_local_stack.size() / 2;
+        for (size_t i = 0; i < count; ++i)
+            m_shared_work.append(m_local_stack.take_last());
+        m_shared_work_size.store(m_shared_work.size(), AK::memory_order_relaxed);
+    }
+
+    Vector<Cell*> m_local_stack;
+
+    Threading::Mutex m_shared_work_mutex;
+    Vector<Cell*> m_shared_work;
+    Atomic<size_t> m_shared_work_size { 0 };
+};
+
+ParallelMarker::ParallelMarker(size_t thread_count)
+{
+    VERIFY(thread_count > 0);
+    for (size_t i = 0; i < thread_count; ++i)
+        m_workers.append(make<Worker>());
+
+    // NOTE: Worker 0 belongs to whichever thread calls mark(), the rest get a helper thread each.
+    for (size_t i = 1; i < thread_count; ++i) {
+        auto thread = Threading::Thread::construct([this, i]() -> intptr_t {
+            helper_thread_main(i);
+            return 0;
+        },
+            "GC Marker"sv);
+        thread->start();
+        m_helper_threads.append(move(thread));
+    }
+}
+
+ParallelMarker::~ParallelMarker()
+{
+    {
+        Threading::MutexLocker locker(m_mutex);
+        m_shutting_down = true;
+        m_round_started.broadcast();
+    }
+    for (auto& thread : m_helper_threads)
+        (void)thread.join();
+}
+
+void ParallelMarker::mark(Vector<Cell*> const& roots)
+{
+    for (size_t i = 0; i < roots.size(); ++i) {
+        if (roots[i])
+            m_workers[i % m_workers.size()]->mark_root(*roots[i]);
+    }
+
+    m_idle_worker_count.store(0);
+
+    {
+        Threading::MutexLocker locker(m_mutex);
+        ++m_round;
+        m_helpers_still_marking = m_helper_threads.size();
+        m_round_started.broadcast();
+    }
+
+    run_worker(*m_workers[0]);
+
+    Threading::MutexLocker locker(m_mutex);
+    m_round_finished.wait_while([this] { return m_helpers_still_marking > 0; });
+}
+
+void ParallelMarker::helper_thread_main(size_t worker_index)
+{
+    u64 last_round = 0;
+    for (;;) {
+        {
+            Threading::MutexLocker locker(m_mutex);
+            m_round_started.wait_while([&] { return !m_shutting_down && m_round == last_round; });
+            if (m_shutting_down)
+                return;
+            last_round = m_round;
+        }
+
+        run_worker(*m_workers[worker_index]);
+
+        Threading::MutexLocker locker(m_mutex);
+        if (--m_helpers_still_marking == 0)
+            m_round_finished.signal();
+    }
+}
+
+void ParallelMarker::run_worker(Worker& worker)
+{
+    for (;;) {
+        worker.drain_local_stack();
+
+        if (worker.take_own_shared_work() || try_steal_work(worker))
+            continue;
+
+        // NOTE: A participant only publishes work while it is busy, and only goes idle once its own deque is empty.
+        //       So once every participant is idle at the same time, there is no marking work left anywhere.
+        ++m_idle_worker_count;
+        for (;;) {
+            if (m_idle_worker_count.load() == m_workers.size())
+                return;
+            if (any_shared_work_available()) {
+                // Leave the idle set *before* stealing, so that the stolen cells are never unaccounted for.
+                --m_idle_worker_count;
+                if (try_steal_work(worker))
+                    break;
+                ++m_idle_worker_count;
+            }
+            sched_yield();
+        }
+    }
+}
+
+bool ParallelMarker::try_steal_work(Worker& thief)
+{
+    for (auto& victim : m_workers) {
+        if (victim.ptr() == &thief)
+            continue;
+        if (thief.steal_from(*victim))
+            return true;
+    }
+    return false;
+}
+
+bool ParallelMarker::any_shared_work_available() const
+{
+    for (auto& worker : m_workers) {
+        if (worker->has_shared_work())
+            return true;
+    }
+    return false;
+}
+
+}
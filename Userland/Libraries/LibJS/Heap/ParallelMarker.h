@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/Noncopyable.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/NonnullRefPtrVector.h>
+#include <AK/Vector.h>
+#include <LibJS/Forward.h>
+#include <LibThreading/ConditionVariable.h>
+#include <LibThreading/Mutex.h>
+#include <LibThreading/Thread.h>
+
+namespace JS {
+
+// Marks the transitive closure of a set of roots using a pool of worker threads.
+// Each participant (the calling thread plus the helper threads) traces from a private stack,
+// and publishes surplus work to a shared deque that idle participants steal from.
+class ParallelMarker {
+    AK_MAKE_NONCOPYABLE(ParallelMarker);
+    AK_MAKE_NONMOVABLE(ParallelMarker);
+
+public:
+    // `thread_count` includes the calling thread, so a count of N spawns N - 1 helper threads.
+    explicit ParallelMarker(size_t thread_count);
+    ~ParallelMarker();
+
+    size_t thread_count() const { return m_workers.size(); }
+
+    void mark(Vector<Cell*> const& roots);
+
+private:
+    class Worker;
+
+    void helper_thread_main(size_t worker_index);
+    void run_worker(Worker&);
+    bool try_steal_work(Worker& thief);
+    bool any_shared_work_available() const;
+
+    Vector<NonnullOwnPtr<Worker>> m_workers;
+    NonnullRefPtrVector<Threading::Thread> m_helper_threads;
+
+    // Protects the fields below, which are used to hand marking rounds to the helper threads.
+    Threading::Mutex m_mutex;
+    Threading::ConditionVariable m_round_started { m_mutex };
+    Threading::ConditionVariable m_round_finished { m_mutex };
+    u64 m_round { 0 };
+    size_t m_helpers_still_marking { 0 };
+    bool m_shutting_down { false };
+
+    Atomic<size_t> m_idle_worker_count { 0 };
+};
+
+}
@@ -1869,6 +1869,9 @@ NonnullRefPtr<TemplateLiteral> Parser::parse_template_literal(bool is_tagged)
     auto rule_start = push_start();
     consume(TokenType::TemplateLiteralStart);
 
+    if (is_tagged)
+        m_state.has_tagged_template_literals = true;
+
     NonnullRefPtrVector<Expression> expressions;
     NonnullRefPtrVector<Expression> raw_strings;
 
@@ -202,6 +202,7 @@ public:
     };
 
     bool has_errors() const { return m_state.errors.size(); }
+    bool has_tagged_template_literals() const { return m_state.has_tagged_template_literals; }
     Vector<Error> const& errors() const { return m_state.errors; }
     void print_errors(bool print_hint = true) const
     {
@@ -326,6 +327,7 @@ private:
         bool in_class_field_initializer { false };
         bool in_class_static_init_block { false };
         bool function_might_need_arguments_object { false };
+        bool has_tagged_template_literals { false };
 
         ParserState(Lexer, Program::Type);
     };
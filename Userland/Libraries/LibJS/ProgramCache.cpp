@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/StringHash.h>
+#include <LibJS/ProgramCache.h>
+
+namespace JS {
+
+RefPtr<ProgramCache::Entry> ProgramCache::find(StringView source_text, StringView filename, size_t line_number_offset)
+{
+    auto hash = string_hash(source_text.characters_without_null_termination(), source_text.length());
+    for (auto& entry : m_entries) {
+        if (!entry.program || entry.source_hash != hash || entry.line_number_offset != line_number_offset)
+            continue;
+        if (entry.filename != filename || entry.source_text != source_text)
+            continue;
+        entry.last_use = ++m_use_counter;
+        ++m_hit_count;
+        return entry;
+    }
+    ++m_miss_count;
+    return nullptr;
+}
+
+NonnullRefPtr<ProgramCache::Entry> ProgramCache::create_entry(StringView source_text, StringView filename, size_t line_number_offset)
+{
+    auto entry = adopt_ref(*new Entry);
+    entry->filename = filename;
+    entry->line_number_offset = line_number_offset;
+    entry->source_hash = string_hash(source_text.characters_without_null_termination(), source_text.length());
+
+    if (!m_hashes_of_sources_parsed_once.contains_slow(entry->source_hash)) {
+        if (m_hashes_of_sources_parsed_once.size() == max_remembered_hash_count)
+            m_hashes_of_sources_parsed_once.take_first();
+        m_hashes_of_sources_parsed_once.append(entry->source_hash);
+        return entry;
+    }
+
+    entry->source_text = source_text;
+    entry->last_use = ++m_use_counter;
+
+    m_total_source_size += source_text.length();
+    m_entries.append(entry);
+
+    evict_if_needed();
+    return entry;
+}
+
+void ProgramCache::discard(Entry& entry)
+{
+    m_entries.remove_first_matching([&](auto& it) {
+        if (it.ptr() != &entry)
+            return false;
+        m_total_source_size -= it->source_text.length();
+        return true;
+    });
+}
+
+void ProgramCache::evict_if_needed()
+{
+    while (m_entries.size() > max_entry_count || m_total_source_size > max_total_source_size) {
+        Entry* victim = nullptr;
+        for (auto& entry : m_entries) {
+            if (!victim || entry.last_use < victim->last_use)
+                victim = &entry;
+        }
+        discard(*victim);
+    }
+}
+
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/NonnullRefPtrVector.h>
+#include <AK/RefCounted.h>
+#include <AK/String.h>
+#include <AK/Vector.h>
+#include <LibJS/AST.h>
+
+namespace JS {
+
+// Keeps the ASTs of recently parsed scripts around in memory, keyed by their source text, so that evaluating
+// the same script again in the same VM (e.g. when reloading a page) doesn't have to lex and parse it from scratch.
+// Nothing is kept across VMs or processes.
+class ProgramCache {
+    AK_MAKE_NONCOPYABLE(ProgramCache);
+    AK_MAKE_NONMOVABLE(ProgramCache);
+
+public:
+    static constexpr size_t max_entry_count = 64;
+    static constexpr size_t max_total_source_size = 16 * MiB;
+    static constexpr size_t max_remembered_hash_count = 256;
+
+    ProgramCache() = default;
+
+    // NOTE: The AST refers to the filename owned by its entry, so a Script keeps the entry it was parsed
+    //       into alive. This lets the cache drop entries regardless of whether they're still in use.
+    class Entry : public RefCounted<Entry> {
+    public:
+        String source_text;
+        String filename;
+        size_t line_number_offset { 0 };
+        unsigned source_hash { 0 };
+        RefPtr<Program> program;
+        u64 last_use { 0 };
+    };
+
+    RefPtr<Entry> find(StringView source_text, StringView filename, size_t line_number_offset);
+
+    // Returns an entry to parse into. Call discard() if parsing fails.
+    // NOTE: A source is only copied into the cache once it gets parsed a second time, so that scripts which are
+    //       only ever parsed once don't pay for it. Until then, the entry isn't part of the cache.
+    NonnullRefPtr<Entry> create_entry(StringView source_text, StringView filename, size_t line_number_offset);
+    void discard(Entry&);
+
+    void clear()
+    {
+        m_entries.clear();
+        m_hashes_of_sources_parsed_once.clear();
+        m_total_source_size = 0;
+    }
+
+    size_t entry_count() const { return m_entries.size(); }
+    size_t hit_count() const { return m_hit_count; }
+    size_t miss_count() const { return m_miss_count; }
+
+private:
+    void evict_if_needed();
+
+    NonnullRefPtrVector<Entry> m_entries;
+    Vector<unsigned> m_hashes_of_sources_parsed_once;
+    size_t m_total_source_size { 0 };
+    u64 m_use_counter { 0 };
+
+    size_t m_hit_count { 0 };
+    size_t m_miss_count { 0 };
+};
+
+}
@@ -156,6 +156,43 @@ ThrowCompletionOr<bool> Array::set_length(PropertyDescriptor const& property_des
     return true;
 }
 
+static Optional<i32> as_i32_if_integral(Value value)
+{
+    if (!value.is_integral_number())
+        return {};
+    auto number = value.as_double();
+    if (number < NumericLimits<i32>::min() || number > NumericLimits<i32>::max())
+        return {};
+    // NOTE: This maps -0 to 0, which is fine since ToString(-0) is "0".
+    return static_cast<i32>(number);
+}
+
+static StringView integer_to_decimal_string(i32 value, AK::Array<char, 12>& buffer)
+{
+    auto magnitude = value < 0 ? -static_cast<i64>(value) : static_cast<i64>(value);
+    size_t start = buffer.size();
+    do {
+        buffer[--start] = '0' + (magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+    if (value < 0)
+        buffer[--start] = '-';
+    return { buffer.data() + start, buffer.size() - start };
+}
+
+// Equivalent to the steps of CompareArrayElements comparing ToString(x) and ToString(y).
+static double compare_integers_as_strings(i32 x, i32 y)
+{
+    AK::Array<char, 12> x_buffer;
+    AK::Array<char, 12> y_buffer;
+    auto result = integer_to_decimal_string(x, x_buffer).compare(integer_to_decimal_string(y, y_buffer));
+    if (result < 0)
+        return -1;
+    if (result > 0)
+        return 1;
+    return 0;
+}
+
 // 1.1.1.2 CompareArrayElements ( x, y, comparefn ), https://tc39.es/proposal-change-array-by-copy/#sec-comparearrayelements
 ThrowCompletionOr<double> compare_array_elements(VM& vm, Value x, Value y, FunctionObject* comparefn)
 {
@@ -185,6 +222,11 @@ ThrowCompletionOr<double> compare_array_elements(VM& vm, Value x, Value y, Funct
         return value_number.as_double();
     }
 
+    // NOTE: Sorting integers without a comparator is common enough that it's worth comparing
+    //       their string representations without allocating them.
+    if (auto x_integer = as_i32_if_integral(x), y_integer = as_i32_if_integral(y); x_integer.has_value() && y_integer.has_value())
+        return compare_integers_as_strings(*x_integer, *y_integer);
+
     // 5. Let xString be ? ToString(x).
     auto* x_string = js_string(vm, TRY(x.to_string(vm)));
 
@@ -215,35 +257,43 @@ ThrowCompletionOr<MarkedVector<Value>> sort_indexed_properties(VM& vm, Object co
     // 1. Let items be a new empty List.
     auto items = MarkedVector<Value> { vm.heap() };
 
-    // 2. Let k be 0.
-    // 3. Repeat, while k < len,
-    for (size_t k = 0; k < length; ++k) {
-        // a. Let Pk be ! ToString(𝔽(k)).
-        auto property_key = PropertyKey { k };
-
-        bool k_read;
-
-        // b. If skipHoles is true, then
-        if (skip_holes) {
-            // i. Let kRead be ? HasProperty(obj, Pk).
-            k_read = TRY(object.has_property(property_key));
+    // NOTE: Reading the elements of an array without holes can't run any user code, so we can copy them out directly.
+    auto const* storage = array_element_storage(object);
+    if (storage && storage->is_packed() && length <= storage->array_like_size()) {
+        items.ensure_capacity(length);
+        for (size_t k = 0; k < length; ++k)
+            items.unchecked_append(storage->elements()[k]);
+    } else {
+        // 2. Let k be 0.
+        // 3. Repeat, while k < len,
+        for (size_t k = 0; k < length; ++k) {
+            // a. Let Pk be ! ToString(𝔽(k)).
+            auto property_key = PropertyKey { k };
+
+            bool k_read;
+
+            // b. If skipHoles is true, then
+            if (skip_holes) {
+                // i. Let kRead be ? HasProperty(obj, Pk).
+                k_read = TRY(object.has_property(property_key));
+            }
+            // c. Else,
+            else {
+                // i. Let kRead be true.
+                k_read = true;
+            }
+
+            // d. If kRead is true, then
+            if (k_read) {
+                // i. Let kValue be ? Get(obj, Pk).
+                auto k_value = TRY(object.get(property_key));
+
+                // ii. Append kValue to items.
+                items.append(k_value);
+            }
+
+            // e. Set k to k + 1.
         }
-        // c. Else,
-        else {
-            // i. Let kRead be true.
-            k_read = true;
-        }
-
-        // d. If kRead is true, then
-        if (k_read) {
-            // i. Let kValue be ? Get(obj, Pk).
-            auto k_value = TRY(object.get(property_key));
-
-            // ii. Append kValue to items.
-            items.append(k_value);
-        }
-
-        // e. Set k to k + 1.
     }
 
     // 4. Sort items using an implementation-defined sequence of calls to SortCompare. If any such call returns an abrupt completion, stop before performing any further calls to SortCompare or steps in this algorithm and return that Completion Record.
@@ -48,11 +48,40 @@ protected:
     explicit Array(Object& prototype);
 
 private:
+    virtual bool is_array() const final { return true; }
+
     ThrowCompletionOr<bool> set_length(PropertyDescriptor const&);
 
     bool m_length_writable { true };
 };
 
+template<>
+inline bool Object::fast_is<Array>() const { return is_array(); }
+
+// Returns the element storage of an Array if its elements can be read directly, i.e. without
+// going through [[HasProperty]] and [[Get]]. Holes still need the slow path, since they defer
+// to the prototype chain.
+inline SimpleIndexedPropertyStorage* array_element_storage(Object& object)
+{
+    if (!is<Array>(object))
+        return nullptr;
+    return object.indexed_properties().simple_storage();
+}
+
+inline SimpleIndexedPropertyStorage const* array_element_storage(Object const& object)
+{
+    return array_element_storage(const_cast<Object&>(object));
+}
+
+// Returns the element at the given index if it can be read without going through [[Get]], or an empty value.
+inline Value array_element_or_empty(Object const& object, size_t index)
+{
+    auto const* storage = array_element_storage(object);
+    if (!storage || index > NumericLimits<u32>::max())
+        return {};
+    return storage->get_value_or_empty(index);
+}
+
 ThrowCompletionOr<double> compare_array_elements(VM&, Value x, Value y, FunctionObject* comparefn);
 ThrowCompletionOr<MarkedVector<Value>> sort_indexed_properties(VM&, Object const&, size_t length, Function<ThrowCompletionOr<double>(Value, Value)> const& sort_compare, bool skip_holes);
 
@@ -30,6 +30,11 @@ ArrayBuffer* ArrayBuffer::create(Realm& realm, ByteBuffer* buffer)
     return realm.heap().allocate<ArrayBuffer>(realm, buffer, *realm.intrinsics().array_buffer_prototype());
 }
 
+ArrayBuffer* ArrayBuffer::create_with_external_storage(Realm& realm, Bytes external_storage)
+{
+    return realm.heap().allocate<ArrayBuffer>(realm, external_storage, *realm.intrinsics().array_buffer_prototype());
+}
+
 ArrayBuffer::ArrayBuffer(ByteBuffer buffer, Object& prototype)
     : Object(prototype)
     , m_buffer(move(buffer))
@@ -44,6 +49,13 @@ ArrayBuffer::ArrayBuffer(ByteBuffer* buffer, Object& prototype)
 {
 }
 
+ArrayBuffer::ArrayBuffer(Bytes external_storage, Object& prototype)
+    : Object(prototype)
+    , m_buffer(external_storage)
+    , m_detach_key(js_undefined())
+{
+}
+
 void ArrayBuffer::visit_edges(Cell::Visitor& visitor)
 {
     Base::visit_edges(visitor);
@@ -104,10 +116,10 @@ ThrowCompletionOr<ArrayBuffer*> clone_array_buffer(VM& vm, ArrayBuffer& source_b
     auto* target_buffer = TRY(allocate_array_buffer(vm, *realm.intrinsics().array_buffer_constructor(), source_length));
 
     // 3. Let srcBlock be srcBuffer.[[ArrayBufferData]].
-    auto& source_block = source_buffer.buffer();
+    auto source_block = source_buffer.buffer();
 
     // 4. Let targetBlock be targetBuffer.[[ArrayBufferData]].
-    auto& target_block = target_buffer->buffer();
+    auto target_block = target_buffer->buffer();
 
     // 5. Perform CopyDataBlockBytes(targetBlock, 0, srcBlock, srcByteOffset, srcLength).
     // FIXME: This is only correct for ArrayBuffers, once SharedArrayBuffer is implemented, the AO has to be implemented
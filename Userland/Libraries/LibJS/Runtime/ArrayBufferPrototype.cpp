@@ -116,7 +116,7 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayBufferPrototype::slice)
     // 25. Let toBuf be new.[[ArrayBufferData]].
     // 26. Perform CopyDataBlockBytes(toBuf, 0, fromBuf, first, newLen).
     // FIXME: Implement this to specification
-    array_buffer_object->buffer().span().slice(first, new_length).copy_to(new_array_buffer_object->buffer().span());
+    array_buffer_object->buffer().slice(first, new_length).copy_to(new_array_buffer_object->buffer());
 
     // 27. Return new.
     return new_array_buffer_object;
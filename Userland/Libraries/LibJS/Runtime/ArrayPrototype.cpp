@@ -382,6 +382,13 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::fill)
     else
         to = min(relative_end, length);
 
+    // NOTE: If the array has no holes, every Set() below just overwrites an existing data property.
+    if (auto* storage = array_element_storage(*this_object); storage && storage->is_packed() && to <= storage->array_like_size()) {
+        for (u64 i = from; i < to; i++)
+            storage->put(i, vm.argument(0));
+        return this_object;
+    }
+
     for (u64 i = from; i < to; i++)
         TRY(this_object->set(i, vm.argument(0), Object::ShouldThrowExceptions::Yes));
 
@@ -902,6 +909,20 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::includes)
             from_index = from_argument;
     }
     auto value_to_find = vm.argument(0);
+
+    // NOTE: Reading the elements of an array without holes has no side effects, and neither does
+    //       SameValueZero, so we can scan the elements directly.
+    if (auto const* storage = array_element_storage(*this_object); storage && storage->is_packed() && length <= storage->array_like_size()) {
+        if (storage->has_only_numbers() && !value_to_find.is_number())
+            return Value(false);
+        auto const& elements = storage->elements();
+        for (u64 i = from_index; i < length; ++i) {
+            if (same_value_zero(elements[i], value_to_find))
+                return Value(true);
+        }
+        return Value(false);
+    }
+
     for (u64 i = from_index; i < length; ++i) {
         auto element = TRY(this_object->get(i));
         if (same_value_zero(element, value_to_find))
@@ -955,6 +976,19 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::index_of)
         k = max(length + n, 0);
     }
 
+    // NOTE: Reading the elements of an array without holes has no side effects, and neither does
+    //       IsStrictlyEqual, so we can scan the elements directly.
+    if (auto const* storage = array_element_storage(*object); storage && storage->is_packed() && length <= storage->array_like_size()) {
+        if (storage->has_only_numbers() && !search_element.is_number())
+            return Value(-1);
+        auto const& elements = storage->elements();
+        for (; k < length; ++k) {
+            if (is_strictly_equal(search_element, elements[k]))
+                return Value(k);
+        }
+        return Value(-1);
+    }
+
     // 10. Repeat, while k < len,
     for (; k < length; ++k) {
         auto property_key = PropertyKey { k };
@@ -1063,9 +1097,25 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::last_index_of)
     // 7. Else,
     else {
         //  a. Let k be len + n.
+        // NOTE: n can be far more negative than any index, so don't convert len + n to an integer unless it is one.
+        //       If it is negative, the loop below has nothing to search.
+        if ((double)length + n < 0)
+            return Value(-1);
         k = (double)length + n;
     }
 
+    // NOTE: See the fast path in Array.prototype.indexOf.
+    if (auto const* storage = array_element_storage(*object); storage && storage->is_packed() && length <= storage->array_like_size()) {
+        if (storage->has_only_numbers() && !search_element.is_number())
+            return Value(-1);
+        auto const& elements = storage->elements();
+        for (; k >= 0; --k) {
+            if (is_strictly_equal(search_element, elements[k]))
+                return Value((size_t)k);
+        }
+        return Value(-1);
+    }
+
     // 8. Repeat, while k ≥ 0,
     for (; k >= 0; --k) {
         auto property_key = PropertyKey { k };
@@ -1118,13 +1168,18 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::map)
         // a. Let Pk be ! ToString(𝔽(k)).
         auto property_key = PropertyKey { k };
 
+        // NOTE: Array elements are plain data properties, so if there is one we can skip straight to its value.
+        //       The callback may modify the array, so this has to be checked again on every iteration.
+        auto k_value = array_element_or_empty(*object, k);
+
         // b. Let kPresent be ? HasProperty(O, Pk).
-        auto k_present = TRY(object->has_property(property_key));
+        auto k_present = !k_value.is_empty() || TRY(object->has_property(property_key));
 
         // c. If kPresent is true, then
         if (k_present) {
             // i. Let kValue be ? Get(O, Pk).
-            auto k_value = TRY(object->get(property_key));
+            if (k_value.is_empty())
+                k_value = TRY(object->get(property_key));
 
             // ii. Let mappedValue be ? Call(callbackfn, thisArg, « kValue, 𝔽(k), O »).
             auto mapped_value = TRY(call(vm, callback_function.as_function(), this_arg, k_value, Value(k), object));
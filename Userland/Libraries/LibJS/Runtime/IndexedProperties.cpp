@@ -17,6 +17,33 @@ SimpleIndexedPropertyStorage::SimpleIndexedPropertyStorage(Vector<Value>&& initi
     : m_array_size(initial_values.size())
     , m_packed_elements(move(initial_values))
 {
+    for (auto& value : m_packed_elements)
+        update_element_kind(value);
+}
+
+void SimpleIndexedPropertyStorage::update_element_kind(Value value)
+{
+    if (value.is_empty()) {
+        m_element_kind = ElementKind::Holey;
+        return;
+    }
+
+    switch (m_element_kind) {
+    case ElementKind::PackedInt32:
+        if (value.is_stored_as_int32())
+            return;
+        m_element_kind = value.is_number() ? ElementKind::PackedDouble : ElementKind::Packed;
+        return;
+    case ElementKind::PackedDouble:
+        if (value.is_number())
+            return;
+        m_element_kind = ElementKind::Packed;
+        return;
+    case ElementKind::Packed:
+    case ElementKind::Holey:
+        return;
+    }
+    VERIFY_NOT_REACHED();
 }
 
 bool SimpleIndexedPropertyStorage::has_index(u32 index) const
@@ -49,15 +76,20 @@ void SimpleIndexedPropertyStorage::put(u32 index, Value value, PropertyAttribute
     VERIFY(attributes == default_attributes);
 
     if (index >= m_array_size) {
+        // Writing past the end leaves holes behind.
+        if (index > m_array_size)
+            m_element_kind = ElementKind::Holey;
         m_array_size = index + 1;
         grow_storage_if_needed();
     }
+    update_element_kind(value);
     m_packed_elements[index] = value;
 }
 
 void SimpleIndexedPropertyStorage::remove(u32 index)
 {
     VERIFY(index < m_array_size);
+    m_element_kind = ElementKind::Holey;
     m_packed_elements[index] = {};
 }
 
@@ -77,6 +109,8 @@ ValueAndAttributes SimpleIndexedPropertyStorage::take_last()
 
 bool SimpleIndexedPropertyStorage::set_array_like_size(size_t new_size)
 {
+    if (new_size > m_array_size)
+        m_element_kind = ElementKind::Holey;
     m_array_size = new_size;
     m_packed_elements.resize_and_keep_capacity(new_size);
     return true;
@@ -40,6 +40,15 @@ public:
     virtual bool is_simple_storage() const { return false; }
 };
 
+// The kind of elements held by a SimpleIndexedPropertyStorage. Packed kinds have no holes below
+// array_like_size(), and a storage only ever moves down this list as elements get written.
+enum class ElementKind : u8 {
+    PackedInt32,
+    PackedDouble,
+    Packed,
+    Holey,
+};
+
 class SimpleIndexedPropertyStorage final : public IndexedPropertyStorage {
 public:
     SimpleIndexedPropertyStorage() = default;
@@ -60,13 +69,22 @@ public:
     virtual bool is_simple_storage() const override { return true; }
     Vector<Value> const& elements() const { return m_packed_elements; }
 
+    ElementKind element_kind() const { return m_element_kind; }
+    bool is_packed() const { return m_element_kind != ElementKind::Holey; }
+    bool has_only_numbers() const { return m_element_kind == ElementKind::PackedInt32 || m_element_kind == ElementKind::PackedDouble; }
+
+    // Returns an empty value for holes and out-of-bounds indices.
+    Value get_value_or_empty(u32 index) const { return index < m_array_size ? m_packed_elements[index] : Value {}; }
+
 private:
     friend GenericIndexedPropertyStorage;
 
     void grow_storage_if_needed();
+    void update_element_kind(Value);
 
     size_t m_array_size { 0 };
     Vector<Value> m_packed_elements;
+    ElementKind m_element_kind { ElementKind::PackedInt32 };
 };
 
 class GenericIndexedPropertyStorage final : public IndexedPropertyStorage {
@@ -140,6 +158,9 @@ public:
 
     Vector<u32> indices() const;
 
+    SimpleIndexedPropertyStorage* simple_storage() { return m_storage && m_storage->is_simple_storage() ? static_cast<SimpleIndexedPropertyStorage*>(m_storage.ptr()) : nullptr; }
+    SimpleIndexedPropertyStorage const* simple_storage() const { return const_cast<IndexedProperties&>(*this).simple_storage(); }
+
     template<typename Callback>
     void for_each_value(Callback callback)
     {
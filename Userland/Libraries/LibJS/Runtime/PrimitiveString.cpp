@@ -4,8 +4,11 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Array.h>
 #include <AK/CharacterTypes.h>
+#include <AK/Checked.h>
 #include <AK/Utf16View.h>
+#include <LibJS/Heap/DeferGC.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/GlobalObject.h>
 #include <LibJS/Runtime/PrimitiveString.h>
@@ -15,8 +18,19 @@
 
 namespace JS {
 
+// NOTE: A leaf is counted every time it occurs in a rope, so concatenating a string with itself over and over doubles
+//       the count every time. It saturates instead of overflowing.
+static size_t rope_leaf_count_of_concatenation(size_t lhs_leaf_count, size_t rhs_leaf_count)
+{
+    Checked<size_t> leaf_count = lhs_leaf_count;
+    leaf_count.saturating_add(rhs_leaf_count);
+    return leaf_count.value();
+}
+
 PrimitiveString::PrimitiveString(PrimitiveString& lhs, PrimitiveString& rhs)
     : m_is_rope(true)
+    , m_rope_depth(max(lhs.m_rope_depth, rhs.m_rope_depth) + 1)
+    , m_rope_leaf_count(rope_leaf_count_of_concatenation(lhs.m_rope_leaf_count, rhs.m_rope_leaf_count))
     , m_lhs(&lhs)
     , m_rhs(&rhs)
 {
@@ -162,6 +176,91 @@ PrimitiveString* js_string(VM& vm, String string)
     return js_string(vm.heap(), move(string));
 }
 
+// Rebalances ropes the way Boehm, Atkinson and Plass's "Ropes: an Alternative to Strings" describes it:
+// the leaves (and already balanced subtrees) are fed left to right into a forest of balanced ropes, where
+// slot i holds a rope of between fib(i + 2) and fib(i + 3) leaves. Concatenating the forest gives a rope
+// whose depth is logarithmic in its leaf count. Since balanced subtrees are taken over as they are, this
+// only costs as much as the part of the rope that has become unbalanced.
+class RopeRebalancer {
+public:
+    explicit RopeRebalancer(VM& vm)
+        : m_vm(vm)
+    {
+    }
+
+    void add(PrimitiveString& rope)
+    {
+        Vector<PrimitiveString*> stack;
+        stack.append(&rope);
+        while (!stack.is_empty()) {
+            auto* current = stack.take_last();
+            if (current->m_is_rope && !is_balanced(*current)) {
+                stack.append(current->m_rhs);
+                stack.append(current->m_lhs);
+                continue;
+            }
+            add_to_forest(*current);
+        }
+    }
+
+    PrimitiveString& result()
+    {
+        PrimitiveString* result = nullptr;
+        for (auto* rope : m_forest)
+            result = concatenate(rope, result);
+        VERIFY(result);
+        return *result;
+    }
+
+private:
+    static constexpr size_t forest_size = 48;
+
+    // The fewest leaves a balanced rope of depth i has, which is fib(i + 2).
+    static constexpr AK::Array<u64, forest_size + 1> minimum_leaf_count = [] {
+        AK::Array<u64, forest_size + 1> counts {};
+        counts[0] = 1;
+        counts[1] = 2;
+        for (size_t i = 2; i < counts.size(); ++i)
+            counts[i] = counts[i - 1] + counts[i - 2];
+        return counts;
+    }();
+
+    static bool is_balanced(PrimitiveString const& rope)
+    {
+        return rope.m_rope_depth < forest_size && rope.m_rope_leaf_count >= minimum_leaf_count[rope.m_rope_depth];
+    }
+
+    PrimitiveString* concatenate(PrimitiveString* lhs, PrimitiveString* rhs)
+    {
+        if (!lhs)
+            return rhs;
+        if (!rhs)
+            return lhs;
+        return m_vm.heap().allocate_without_realm<PrimitiveString>(*lhs, *rhs);
+    }
+
+    void add_to_forest(PrimitiveString& piece)
+    {
+        // Everything in the slots below the one this piece belongs in is shorter, and came before it.
+        PrimitiveString* preceding = nullptr;
+        size_t i = 0;
+        for (; i < forest_size - 1 && piece.m_rope_leaf_count >= minimum_leaf_count[i + 1]; ++i)
+            preceding = concatenate(exchange(m_forest[i], nullptr), preceding);
+
+        auto* rope = concatenate(preceding, &piece);
+        for (;; ++i) {
+            rope = concatenate(exchange(m_forest[i], nullptr), rope);
+            if (i == forest_size - 1 || rope->m_rope_leaf_count < minimum_leaf_count[i + 1]) {
+                m_forest[i] = rope;
+                return;
+            }
+        }
+    }
+
+    VM& m_vm;
+    AK::Array<PrimitiveString*, forest_size> m_forest {};
+};
+
 PrimitiveString* js_rope_string(VM& vm, PrimitiveString& lhs, PrimitiveString& rhs)
 {
     // We're here to concatenate two strings into a new rope string.
@@ -179,7 +278,18 @@ PrimitiveString* js_rope_string(VM& vm, PrimitiveString& lhs, PrimitiveString& r
     if (rhs_empty)
         return &lhs;
 
-    return vm.heap().allocate_without_realm<PrimitiveString>(lhs, rhs);
+    auto* rope = vm.heap().allocate_without_realm<PrimitiveString>(lhs, rhs);
+
+    // NOTE: The GC marks ropes recursively, so an unbounded chain of `s += x` would eventually
+    //       exhaust the stack. Rebalancing puts a cap on the depth of any rope, without copying
+    //       any characters.
+    if (rope->m_rope_depth < PrimitiveString::max_rope_depth)
+        return rope;
+
+    DeferGC defer_gc(vm.heap());
+    RopeRebalancer rebalancer(vm);
+    rebalancer.add(*rope);
+    return &rebalancer.result();
 }
 
 void PrimitiveString::resolve_rope_if_needed() const
@@ -201,6 +311,8 @@ void PrimitiveString::resolve_rope_if_needed() const
         m_utf16_string = Utf16String(move(combined));
         m_has_utf16_string = true;
         m_is_rope = false;
+        m_rope_depth = 0;
+        m_rope_leaf_count = 1;
         m_lhs = nullptr;
         m_rhs = nullptr;
         return;
@@ -289,6 +401,8 @@ void PrimitiveString::resolve_rope_if_needed() const
     m_utf8_string = builder.to_string();
     m_has_utf8_string = true;
     m_is_rope = false;
+    m_rope_depth = 0;
+    m_rope_leaf_count = 1;
     m_lhs = nullptr;
     m_rhs = nullptr;
 }
@@ -35,7 +35,17 @@ public:
 
     Optional<Value> get(VM&, PropertyKey const&) const;
 
+    bool is_rope() const { return m_is_rope; }
+    u32 rope_depth() const { return m_rope_depth; }
+
+    // A concatenation that makes a rope this deep rebalances it, see js_rope_string().
+    static constexpr u32 max_rope_depth = 1024;
+    static_assert(max_rope_depth <= NumericLimits<u16>::max());
+
 private:
+    friend class RopeRebalancer;
+    friend PrimitiveString* js_rope_string(VM&, PrimitiveString&, PrimitiveString&);
+
     explicit PrimitiveString(PrimitiveString&, PrimitiveString&);
     explicit PrimitiveString(String);
     explicit PrimitiveString(Utf16String);
@@ -48,6 +58,10 @@ private:
     mutable bool m_has_utf8_string { false };
     mutable bool m_has_utf16_string { false };
 
+    // NOTE: Ropes never get deeper than max_rope_depth, so this fits in front of the leaf count.
+    mutable u16 m_rope_depth { 0 };
+    mutable size_t m_rope_leaf_count { 1 };
+
     mutable PrimitiveString* m_lhs { nullptr };
     mutable PrimitiveString* m_rhs { nullptr };
 
@@ -12,6 +12,7 @@
 #include <AK/StringBuilder.h>
 #include <LibCore/File.h>
 #include <LibJS/Interpreter.h>
+#include <LibJS/ProgramCache.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/BoundFunction.h>
@@ -31,13 +32,16 @@
 
 namespace JS {
 
+VM::~VM() = default;
+
 NonnullRefPtr<VM> VM::create(OwnPtr<CustomData> custom_data)
 {
     return adopt_ref(*new VM(move(custom_data)));
 }
 
 VM::VM(OwnPtr<CustomData> custom_data)
-    : m_heap(*this)
+    : m_program_cache(make<ProgramCache>())
+    , m_heap(*this)
     , m_custom_data(move(custom_data))
 {
     m_empty_string = m_heap.allocate_without_realm<PrimitiveString>(String::empty());
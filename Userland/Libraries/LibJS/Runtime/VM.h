@@ -39,7 +39,7 @@ public:
     };
 
     static NonnullRefPtr<VM> create(OwnPtr<CustomData> = {});
-    ~VM() = default;
+    ~VM();
 
     Heap& heap() { return m_heap; }
     Heap const& heap() const { return m_heap; }
@@ -76,6 +76,7 @@ public:
     Symbol* get_global_symbol(String const& description);
 
     HashMap<String, PrimitiveString*>& string_cache() { return m_string_cache; }
+    ProgramCache& program_cache() { return *m_program_cache; }
     PrimitiveString& empty_string() { return *m_empty_string; }
     PrimitiveString& single_ascii_character_string(u8 character)
     {
@@ -254,6 +255,7 @@ private:
     void finish_dynamic_import(ScriptOrModule referencing_script_or_module, ModuleRequest module_request, PromiseCapability const& promise_capability, Promise* inner_promise);
 
     HashMap<String, PrimitiveString*> m_string_cache;
+    NonnullOwnPtr<ProgramCache> m_program_cache;
 
     Heap m_heap;
     Vector<Interpreter*> m_interpreters;
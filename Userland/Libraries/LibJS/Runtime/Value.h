@@ -136,6 +136,8 @@ public:
     bool is_undefined() const { return m_value.tag == UNDEFINED_TAG; }
     bool is_null() const { return m_value.tag == NULL_TAG; }
     bool is_number() const { return is_double() || is_int32(); }
+    // Whether this number is stored as an i32 rather than as a double.
+    bool is_stored_as_int32() const { return is_int32(); }
     bool is_string() const { return m_value.tag == STRING_TAG; }
     bool is_object() const { return m_value.tag == OBJECT_TAG; }
     bool is_boolean() const { return m_value.tag == BOOLEAN_TAG; }
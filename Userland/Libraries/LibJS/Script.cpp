@@ -7,6 +7,7 @@
 #include <LibJS/AST.h>
 #include <LibJS/Lexer.h>
 #include <LibJS/Parser.h>
+#include <LibJS/ProgramCache.h>
 #include <LibJS/Runtime/VM.h>
 #include <LibJS/Script.h>
 
@@ -15,21 +16,38 @@ namespace JS {
 // 16.1.5 ParseScript ( sourceText, realm, hostDefined ), https://tc39.es/ecma262/#sec-parse-script
 Result<NonnullGCPtr<Script>, Vector<Parser::Error>> Script::parse(StringView source_text, Realm& realm, StringView filename, HostDefined* host_defined, size_t line_number_offset)
 {
+    auto& program_cache = realm.vm().program_cache();
+    if (auto cache_entry = program_cache.find(source_text, filename, line_number_offset))
+        return NonnullGCPtr(*realm.heap().allocate_without_realm<Script>(realm, filename, cache_entry.release_nonnull(), host_defined));
+
+    // NOTE: The AST refers to the filename, so we parse out of the cache entry's copy of it.
+    auto cache_entry = program_cache.create_entry(source_text, filename, line_number_offset);
+
     // 1. Let script be ParseText(sourceText, Script).
-    auto parser = Parser(Lexer(source_text, filename, line_number_offset));
+    auto parser = Parser(Lexer(source_text, cache_entry->filename, line_number_offset));
     auto script = parser.parse_program();
 
     // 2. If script is a List of errors, return body.
-    if (parser.has_errors())
+    if (parser.has_errors()) {
+        program_cache.discard(*cache_entry);
         return parser.errors();
+    }
+
+    cache_entry->program = move(script);
+
+    // NOTE: Template objects are cached on their parse node, but each evaluation of a script
+    //       is supposed to get fresh ones, so we can't hand out the same AST twice.
+    if (parser.has_tagged_template_literals())
+        program_cache.discard(*cache_entry);
 
     // 3. Return Script Record { [[Realm]]: realm, [[ECMAScriptCode]]: script, [[HostDefined]]: hostDefined }.
-    return NonnullGCPtr(*realm.heap().allocate_without_realm<Script>(realm, filename, move(script), host_defined));
+    return NonnullGCPtr(*realm.heap().allocate_without_realm<Script>(realm, filename, move(cache_entry), host_defined));
 }
 
-Script::Script(Realm& realm, StringView filename, NonnullRefPtr<Program> parse_node, HostDefined* host_defined)
+Script::Script(Realm& realm, StringView filename, NonnullRefPtr<ProgramCache::Entry> program_cache_entry, HostDefined* host_defined)
     : m_realm(realm)
-    , m_parse_node(move(parse_node))
+    , m_program_cache_entry(move(program_cache_entry))
+    , m_parse_node(*m_program_cache_entry->program)
     , m_filename(filename)
     , m_host_defined(host_defined)
 {
@@ -11,6 +11,7 @@
 #include <LibJS/Heap/GCPtr.h>
 #include <LibJS/Heap/Handle.h>
 #include <LibJS/Parser.h>
+#include <LibJS/ProgramCache.h>
 #include <LibJS/Runtime/Realm.h>
 
 namespace JS {
@@ -36,11 +37,14 @@ public:
     StringView filename() const { return m_filename; }
 
 private:
-    Script(Realm&, StringView filename, NonnullRefPtr<Program>, HostDefined* = nullptr);
+    Script(Realm&, StringView filename, NonnullRefPtr<ProgramCache::Entry>, HostDefined* = nullptr);
 
     virtual void visit_edges(Cell::Visitor&) override;
 
-    GCPtr<Realm> m_realm;                // [[Realm]]
+    GCPtr<Realm> m_realm; // [[Realm]]
+
+    // NOTE: This owns the source text and filename that the AST refers to.
+    NonnullRefPtr<ProgramCache::Entry> m_program_cache_entry;
     NonnullRefPtr<Program> m_parse_node; // [[ECMAScriptCode]]
 
     // Needed for potential lookups of modules.
@@ -0,0 +1,87 @@
+describe("arrays moving between element kinds", () => {
+    test("int32 elements becoming doubles and then generic values", () => {
+        const a = [1, 2, 3];
+        expect(a.indexOf("1")).toBe(-1);
+        expect(a.includes(2)).toBeTrue();
+
+        a[1] = 2.5;
+        expect(a.indexOf(2.5)).toBe(1);
+        expect(a.indexOf(2)).toBe(-1);
+
+        a[2] = "3";
+        expect(a.indexOf("3")).toBe(2);
+        expect(a.lastIndexOf(1)).toBe(0);
+    });
+
+    test("lastIndexOf with a fromIndex before the start of the array", () => {
+        const a = [1, 2, 3];
+        expect(a.lastIndexOf(1, -3)).toBe(0);
+        expect(a.lastIndexOf(1, -4)).toBe(-1);
+        expect(a.lastIndexOf(1, -1e300)).toBe(-1);
+        expect(a.lastIndexOf(3, 1e300)).toBe(2);
+    });
+
+    test("NaN and signed zeros in numeric arrays", () => {
+        const a = [0, 1, NaN];
+        expect(a.indexOf(NaN)).toBe(-1);
+        expect(a.includes(NaN)).toBeTrue();
+        expect(a.indexOf(-0)).toBe(0);
+        expect(a.includes(-0)).toBeTrue();
+    });
+
+    test("holes defer to the prototype chain", () => {
+        const a = [1, 2, 3];
+        delete a[1];
+        Array.prototype[1] = 2;
+        try {
+            expect(a.indexOf(2)).toBe(1);
+            expect(a.includes(2)).toBeTrue();
+            expect(a[1]).toBe(2);
+        } finally {
+            delete Array.prototype[1];
+        }
+        expect(a.indexOf(2)).toBe(-1);
+    });
+
+    test("growing an array through its length leaves holes", () => {
+        const a = [1, 2];
+        a.length = 4;
+        const calls = [];
+        Object.defineProperty(Array.prototype, 3, {
+            set(value) {
+                calls.push(value);
+            },
+            configurable: true,
+        });
+        try {
+            a.fill(7);
+        } finally {
+            delete Array.prototype[3];
+        }
+        expect(calls).toEqual([7]);
+        expect(a[0]).toBe(7);
+        expect(a[2]).toBe(7);
+        expect(Object.hasOwn(a, 3)).toBeFalse();
+    });
+
+    test("map sees changes made by the callback", () => {
+        const a = [1, 2, 3, 4];
+        const result = a.map((value, index) => {
+            if (index === 0) {
+                a[2] = "x";
+                a.length = 3;
+            }
+            return value;
+        });
+        expect(result).toHaveLength(4);
+        expect(result[0]).toBe(1);
+        expect(result[1]).toBe(2);
+        expect(result[2]).toBe("x");
+        expect(Object.hasOwn(result, 3)).toBeFalse();
+    });
+
+    test("default sort of integers compares them as strings", () => {
+        expect([10, 9, 1, -1, -10, 0, -0, 100].sort()).toEqual([-1, -10, 0, -0, 1, 10, 100, 9]);
+        expect([2147483647, -2147483648, 3].sort()).toEqual([-2147483648, 2147483647, 3]);
+    });
+});
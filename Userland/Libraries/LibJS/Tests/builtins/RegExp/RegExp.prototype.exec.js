@@ -71,6 +71,23 @@ test("basic index with global and initial offset", () => {
     expect(res[0]).toBe("foo");
 });
 
+test("global unicode match with initial offset past a surrogate pair", () => {
+    let re = /[a-z]/gu;
+    let string = "\u{1F600}a\u{1F600}b";
+
+    let res = re.exec(string);
+    expect(res.index).toBe(2);
+    expect(res[0]).toBe("a");
+    expect(re.lastIndex).toBe(3);
+
+    res = re.exec(string);
+    expect(res.index).toBe(5);
+    expect(res[0]).toBe("b");
+    expect(re.lastIndex).toBe(6);
+
+    expect(string.replaceAll(/\ud83d\ude00/gu, "")).toBe("ab");
+});
+
 test("not matching", () => {
     let re = /foo/;
     let res = re.exec("bar");
@@ -154,8 +154,8 @@ static bool restore_string_position(MatchInput const& input, MatchState& state)
     return true;
 }
 
-OwnPtr<OpCode> ByteCode::s_opcodes[(size_t)OpCodeId::Last + 1];
-bool ByteCode::s_opcodes_initialized { false };
+thread_local OwnPtr<OpCode> ByteCode::s_opcodes[(size_t)OpCodeId::Last + 1];
+thread_local bool ByteCode::s_opcodes_initialized { false };
 
 void ByteCode::ensure_opcodes_initialized()
 {
@@ -180,6 +180,7 @@ ALWAYS_INLINE OpCode& ByteCode::get_opcode_by_id(OpCodeId id) const
 {
     VERIFY(id >= OpCodeId::First && id <= OpCodeId::Last);
 
+    ensure_opcodes_initialized();
     auto& opcode = s_opcodes[(u32)id];
     opcode->set_bytecode(*const_cast<ByteCode*>(this));
     return *opcode;
@@ -284,15 +285,17 @@ ALWAYS_INLINE ExecutionResult OpCode_CheckBegin::execute(MatchInput const& input
 
         return false;
     }();
-    if (is_at_line_boundary && (input.regex_options & AllFlags::MatchNotBeginOfLine))
-        return ExecutionResult::Failed_ExecuteLowPrioForks;
+    return is_satisfied(is_at_line_boundary, input.regex_options) ? ExecutionResult::Continue : ExecutionResult::Failed_ExecuteLowPrioForks;
+}
 
-    if ((is_at_line_boundary && !(input.regex_options & AllFlags::MatchNotBeginOfLine))
-        || (!is_at_line_boundary && (input.regex_options & AllFlags::MatchNotBeginOfLine))
-        || (is_at_line_boundary && (input.regex_options & AllFlags::Global)))
-        return ExecutionResult::Continue;
+bool OpCode_CheckBegin::is_satisfied(bool is_at_line_boundary, AllOptions const& options)
+{
+    if (is_at_line_boundary && (options & AllFlags::MatchNotBeginOfLine))
+        return false;
 
-    return ExecutionResult::Failed_ExecuteLowPrioForks;
+    return (is_at_line_boundary && !(options & AllFlags::MatchNotBeginOfLine))
+        || (!is_at_line_boundary && (options & AllFlags::MatchNotBeginOfLine))
+        || (is_at_line_boundary && (options & AllFlags::Global));
 }
 
 ALWAYS_INLINE ExecutionResult OpCode_CheckBoundary::execute(MatchInput const& input, MatchState& state) const
@@ -337,14 +340,16 @@ ALWAYS_INLINE ExecutionResult OpCode_CheckEnd::execute(MatchInput const& input,
 
         return false;
     }();
-    if (is_at_line_boundary && (input.regex_options & AllFlags::MatchNotEndOfLine))
-        return ExecutionResult::Failed_ExecuteLowPrioForks;
+    return is_satisfied(is_at_line_boundary, input.regex_options) ? ExecutionResult::Continue : ExecutionResult::Failed_ExecuteLowPrioForks;
+}
 
-    if ((is_at_line_boundary && !(input.regex_options & AllFlags::MatchNotEndOfLine))
-        || (!is_at_line_boundary && (input.regex_options & AllFlags::MatchNotEndOfLine || input.regex_options & AllFlags::MatchNotBeginOfLine)))
-        return ExecutionResult::Continue;
+bool OpCode_CheckEnd::is_satisfied(bool is_at_line_boundary, AllOptions const& options)
+{
+    if (is_at_line_boundary && (options & AllFlags::MatchNotEndOfLine))
+        return false;
 
-    return ExecutionResult::Failed_ExecuteLowPrioForks;
+    return (is_at_line_boundary && !(options & AllFlags::MatchNotEndOfLine))
+        || (!is_at_line_boundary && (options & AllFlags::MatchNotEndOfLine || options & AllFlags::MatchNotBeginOfLine));
 }
 
 ALWAYS_INLINE ExecutionResult OpCode_ClearCaptureGroup::execute(MatchInput const& input, MatchState& state) const
@@ -515,10 +515,11 @@ private:
             empend((ByteCodeValueType)view[i]);
     }
 
-    void ensure_opcodes_initialized();
+    static void ensure_opcodes_initialized();
     ALWAYS_INLINE OpCode& get_opcode_by_id(OpCodeId id) const;
-    static OwnPtr<OpCode> s_opcodes[(size_t)OpCodeId::Last + 1];
-    static bool s_opcodes_initialized;
+    // NOTE: The opcodes point at the bytecode and state they're executed with, so every thread needs its own.
+    static thread_local OwnPtr<OpCode> s_opcodes[(size_t)OpCodeId::Last + 1];
+    static thread_local bool s_opcodes_initialized;
 };
 
 #define ENUMERATE_EXECUTION_RESULTS                          \
@@ -677,6 +678,8 @@ public:
     ALWAYS_INLINE OpCodeId opcode_id() const override { return OpCodeId::CheckBegin; }
     ALWAYS_INLINE size_t size() const override { return 1; }
     String arguments_string() const override { return String::empty(); }
+
+    static bool is_satisfied(bool is_at_line_boundary, AllOptions const&);
 };
 
 class OpCode_CheckEnd final : public OpCode {
@@ -685,6 +688,8 @@ public:
     ALWAYS_INLINE OpCodeId opcode_id() const override { return OpCodeId::CheckEnd; }
     ALWAYS_INLINE size_t size() const override { return 1; }
     String arguments_string() const override { return String::empty(); }
+
+    static bool is_satisfied(bool is_at_line_boundary, AllOptions const&);
 };
 
 class OpCode_CheckBoundary final : public OpCode {
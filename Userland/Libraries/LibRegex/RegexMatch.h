@@ -74,7 +74,21 @@ public:
         return m_view.get<Utf8View>();
     }
 
+    // The underlying bytes, if positions in this view are byte offsets into them.
+    Optional<StringView> byte_view() const
+    {
+        if (unicode())
+            return {};
+        return m_view.visit(
+            [](StringView view) -> Optional<StringView> { return view; },
+            [](Utf8View const& view) -> Optional<StringView> { return view.as_string(); },
+            [](auto const&) -> Optional<StringView> { return {}; });
+    }
+
     bool unicode() const { return m_unicode; }
+
+    // Whether a code point may span several code units, i.e. whether positions in code points and code units can differ in unicode mode.
+    bool has_multi_unit_code_points() const { return m_view.has<Utf8View>() || m_view.has<Utf16View>(); }
     void set_unicode(bool unicode) { m_unicode = unicode; }
 
     bool is_empty() const
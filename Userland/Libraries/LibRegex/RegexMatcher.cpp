@@ -226,11 +226,44 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
             }
         }
 
+        auto& match_length_minimum = m_pattern->parser_result.match_length_minimum;
+        // NOTE: The last position the loop below would try to match at, for the NFA to stop searching there.
+        Optional<size_t> last_start_position;
+        if (view_length >= match_length_minimum && !(view_length == 0 && input.regex_options.has_flag_set(AllFlags::Multiline)))
+            last_start_position = min(view_length - match_length_minimum, view_length - (input.regex_options.has_flag_set(AllFlags::Multiline) ? 1 : 0));
+
+        // NOTE: Literals that every match starts with or contains are searched for directly, which is much faster
+        //       than attempting a match at every position. This only works if positions are byte offsets.
+        auto const& optimization_data = m_pattern->parser_result.optimization_data;
+        Optional<StringView> bytes;
+        if (!input.regex_options.has_flag_set(AllFlags::Insensitive) && !(optimization_data.literal_prefix.is_empty() && optimization_data.required_substring.is_empty()))
+            bytes = view.byte_view();
+        Optional<size_t> required_substring_position;
+
         for (; view_index <= view_length; ++view_index) {
+            if (bytes.has_value()) {
+                auto remaining_bytes = bytes->substring_view(view_index);
+                if (!optimization_data.literal_prefix.is_empty()) {
+                    if (continue_search) {
+                        auto offset = AK::memmem_optional(remaining_bytes.characters_without_null_termination(), remaining_bytes.length(), optimization_data.literal_prefix.characters(), optimization_data.literal_prefix.length());
+                        if (!offset.has_value())
+                            break;
+                        view_index += *offset;
+                    } else if (!remaining_bytes.starts_with(optimization_data.literal_prefix)) {
+                        break;
+                    }
+                }
+                if (!optimization_data.required_substring.is_empty() && (!required_substring_position.has_value() || *required_substring_position < view_index)) {
+                    auto offset = AK::memmem_optional(bytes->characters_without_null_termination() + view_index, bytes->length() - view_index, optimization_data.required_substring.characters(), optimization_data.required_substring.length());
+                    if (!offset.has_value())
+                        break;
+                    required_substring_position = view_index + *offset;
+                }
+            }
+
             if (view_index == view_length && input.regex_options.has_flag_set(AllFlags::Multiline))
                 break;
 
-            auto& match_length_minimum = m_pattern->parser_result.match_length_minimum;
             // FIXME: More performant would be to know the remaining minimum string
             //        length needed to match from the current position onwards within
             //        the vm. Add new OpCode for MinMatchLengthFromSp with the value of
@@ -248,7 +281,16 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
             state.instruction_position = 0;
             state.repetition_marks.clear();
 
-            auto success = execute(input, state, operations);
+            bool success;
+            if (m_nfa) {
+                if (!last_start_position.has_value() || view_index > *last_start_position)
+                    break;
+                success = m_nfa->search(m_pattern->parser_result.bytecode, input, state, view_index, *last_start_position, !continue_search, operations);
+                if (!success)
+                    break;
+            } else {
+                success = execute(input, state, operations);
+            }
             if (success) {
                 succeeded = true;
 
@@ -0,0 +1,840 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <AK/CharacterTypes.h>
+#include <AK/Debug.h>
+#include <AK/HashMap.h>
+#include <AK/HashTable.h>
+#include <AK/NonnullOwnPtrVector.h>
+#include <AK/Utf32View.h>
+#include <LibRegex/RegexNFA.h>
+
+namespace regex {
+
+// NOTE: Closures remember which checkpoints they passed alongside the node index, packed into a single u64.
+static constexpr size_t c_node_index_bits = 14;
+static constexpr size_t c_max_node_count = 1 << c_node_index_bits;
+static constexpr size_t c_max_checkpoint_count = 64 - c_node_index_bits;
+
+// Once the DFA states built so far take up this much memory, they are all thrown away and built again as needed.
+static constexpr size_t c_max_dfa_cache_size = 2 * MiB;
+
+struct NFA::Cache {
+    struct DFAState;
+
+    // A DFA state as seen from one particular Context, with its closure computed.
+    struct DFAClosedState {
+        Context context { Context::None };
+        bool is_match { false };
+        bool has_matched { false };
+        Vector<u32> consuming_nodes;
+        Array<DFAState*, 128> ascii_transitions {};
+        HashMap<u32, DFAState*> transitions;
+    };
+
+    // The set of threads that are alive between two characters, in priority order.
+    struct DFAState {
+        Vector<u32> nodes;
+        bool has_matched { false };
+        unsigned hash { 0 };
+        NonnullOwnPtrVector<DFAClosedState> closed_states;
+    };
+
+    struct DFAStateTraits : public GenericTraits<DFAState*> {
+        static unsigned hash(DFAState* state) { return state->hash; }
+        static bool equals(DFAState* a, DFAState* b) { return a->has_matched == b->has_matched && a->nodes == b->nodes; }
+    };
+
+    struct ClosureStep {
+        u32 node { 0 };
+        u64 checkpoints { 0 };
+        RefPtr<Captures> captures;
+    };
+
+    DFAState* intern_dfa_state(Vector<u32>&& nodes, bool has_matched)
+    {
+        unsigned hash = has_matched ? 1 : 0;
+        for (auto node : nodes)
+            hash = pair_int_hash(hash, node);
+
+        auto it = dfa_state_set.find(hash, [&](DFAState* state) { return state->has_matched == has_matched && state->nodes == nodes; });
+        if (it != dfa_state_set.end())
+            return *it;
+
+        if (dfa_memory_usage > c_max_dfa_cache_size) {
+            dbgln_if(REGEX_DEBUG, "NFA: Flushing {} DFA states", dfa_states.size());
+            dfa_state_set.clear();
+            dfa_states.clear();
+            dfa_memory_usage = 0;
+            ++dfa_generation;
+        }
+
+        auto state = make<DFAState>();
+        state->nodes = move(nodes);
+        state->has_matched = has_matched;
+        state->hash = hash;
+        dfa_memory_usage += sizeof(DFAState) + state->nodes.size() * sizeof(u32);
+
+        auto* state_ptr = state.ptr();
+        dfa_states.append(move(state));
+        dfa_state_set.set(state_ptr);
+        return state_ptr;
+    }
+
+    AllOptions options;
+    Context assertion_context_mask { Context::None };
+
+    NonnullOwnPtrVector<DFAState> dfa_states;
+    HashTable<DFAState*, DFAStateTraits> dfa_state_set;
+    size_t dfa_memory_usage { 0 };
+    size_t dfa_generation { 0 };
+
+    // Which ASCII characters each Compare node accepts, computed on first use.
+    Vector<Optional<Array<u64, 2>>> ascii_matches;
+
+    // Scratch space for computing closures and transitions.
+    Vector<ClosureStep> closure_stack;
+    Vector<u32> visited;
+    u32 visit_generation { 0 };
+    HashTable<u64> visited_with_checkpoints;
+};
+
+class NFA::Compiler {
+public:
+    explicit Compiler(ByteCode const& bytecode)
+        : m_bytecode(bytecode)
+    {
+    }
+
+    OwnPtr<NFA> compile()
+    {
+        auto nfa = adopt_own(*new NFA);
+        m_nfa = nfa.ptr();
+
+        Vector<Fixup> unresolved;
+        if (!emit(0, m_bytecode.size(), unresolved) || !unresolved.is_empty())
+            return {};
+        append_node({ .type = Node::Type::Match });
+        if (m_nfa->m_nodes.size() > c_max_node_count)
+            return {};
+
+        for (auto& node : m_nfa->m_nodes) {
+            if (node.type == Node::Type::CheckBegin)
+                m_nfa->m_assertion_context_mask |= Context::AtStart | Context::AfterNewline;
+            else if (node.type == Node::Type::CheckEnd)
+                m_nfa->m_assertion_context_mask |= Context::AtEnd | Context::BeforeNewline;
+            else if (node.type == Node::Type::CheckBoundary)
+                m_nfa->m_assertion_context_mask |= Context::AfterWordCharacter | Context::BeforeWordCharacter;
+        }
+        return nfa;
+    }
+
+private:
+    // A jump whose target instruction hasn't been turned into a node yet.
+    struct Fixup {
+        u32 node { 0 };
+        bool is_alternative { false };
+        size_t target { 0 };
+    };
+
+    u32 append_node(Node node)
+    {
+        m_nfa->m_nodes.append(node);
+        return m_nfa->m_nodes.size() - 1;
+    }
+
+    Optional<size_t> checkpoint_index(size_t checkpoint_position)
+    {
+        if (auto index = m_checkpoint_indices.get(checkpoint_position); index.has_value())
+            return *index;
+        if (m_checkpoint_indices.size() == c_max_checkpoint_count)
+            return {};
+        auto index = m_checkpoint_indices.size();
+        m_checkpoint_indices.set(checkpoint_position, index);
+        return index;
+    }
+
+    void note_capture_group(size_t id, Optional<StringView> name = {})
+    {
+        auto& names = m_nfa->m_capture_group_names;
+        if (id >= names.size())
+            names.resize(id + 1);
+        if (name.has_value())
+            names[id] = name;
+    }
+
+    bool emit_compare(OpCode_Compare const& compare, size_t position)
+    {
+        auto arguments_position = position + 3;
+
+        // NOTE: Only the POSIX basic parser emits (whole) strings, we turn them into one node per character.
+        if (compare.arguments_count() == 1 && static_cast<CharacterCompareType>(m_bytecode.at(arguments_position)) == CharacterCompareType::String) {
+            auto length = m_bytecode.at(arguments_position + 1);
+            for (size_t i = 0; i < length; ++i) {
+                auto ch = m_bytecode.at(arguments_position + 2 + i);
+                if (ch >= 128)
+                    return false;
+                append_node({ .type = Node::Type::CompareChar, .argument = ch });
+            }
+            return true;
+        }
+
+        for (auto& compare_pair : compare.flat_compares()) {
+            if (compare_pair.type == CharacterCompareType::String || compare_pair.type == CharacterCompareType::Reference)
+                return false;
+        }
+        append_node({ .type = Node::Type::Compare, .argument = position });
+        return true;
+    }
+
+    // Turns the instructions in [from, to) into nodes; jumps to `to` continue with whatever gets emitted next,
+    // jumps outside of the range are left in `unresolved` for the caller.
+    bool emit(size_t from, size_t to, Vector<Fixup>& unresolved)
+    {
+        HashMap<size_t, u32> node_for_position;
+        Vector<Fixup> fixups;
+
+        MatchState state;
+        state.instruction_position = from;
+        while (state.instruction_position < to) {
+            if (m_nfa->m_nodes.size() >= c_max_node_count)
+                return false;
+
+            auto position = state.instruction_position;
+            node_for_position.set(position, m_nfa->m_nodes.size());
+
+            auto& opcode = m_bytecode.get_opcode(state);
+            auto next_position = position + opcode.size();
+
+            switch (opcode.opcode_id()) {
+            case OpCodeId::Compare:
+                if (!emit_compare(static_cast<OpCode_Compare const&>(opcode), position))
+                    return false;
+                break;
+            case OpCodeId::Jump: {
+                auto node = append_node({ .type = Node::Type::Jump });
+                fixups.append({ node, false, next_position + static_cast<OpCode_Jump const&>(opcode).offset() });
+                break;
+            }
+            case OpCodeId::ForkJump:
+            case OpCodeId::ForkReplaceJump: {
+                auto node = append_node({ .type = Node::Type::Fork });
+                fixups.append({ node, false, next_position + static_cast<OpCode_ForkJump const&>(opcode).offset() });
+                fixups.append({ node, true, next_position });
+                break;
+            }
+            case OpCodeId::ForkStay:
+            case OpCodeId::ForkReplaceStay: {
+                auto node = append_node({ .type = Node::Type::Fork });
+                fixups.append({ node, false, next_position });
+                fixups.append({ node, true, next_position + static_cast<OpCode_ForkStay const&>(opcode).offset() });
+                break;
+            }
+            case OpCodeId::CheckBegin:
+                append_node({ .type = Node::Type::CheckBegin });
+                break;
+            case OpCodeId::CheckEnd:
+                append_node({ .type = Node::Type::CheckEnd });
+                break;
+            case OpCodeId::CheckBoundary:
+                append_node({ .type = Node::Type::CheckBoundary, .form = static_cast<u8>(static_cast<OpCode_CheckBoundary const&>(opcode).type()) });
+                break;
+            case OpCodeId::Checkpoint: {
+                auto index = checkpoint_index(position);
+                if (!index.has_value())
+                    return false;
+                append_node({ .type = Node::Type::Checkpoint, .argument = *index });
+                break;
+            }
+            case OpCodeId::JumpNonEmpty: {
+                auto& jump = static_cast<OpCode_JumpNonEmpty const&>(opcode);
+                auto form = jump.form();
+                if (form != OpCodeId::Jump && form != OpCodeId::ForkJump && form != OpCodeId::ForkStay && form != OpCodeId::ForkReplaceJump && form != OpCodeId::ForkReplaceStay)
+                    return false;
+                auto index = checkpoint_index(next_position + jump.checkpoint());
+                if (!index.has_value())
+                    return false;
+                auto node = append_node({ .type = Node::Type::JumpNonEmpty, .form = static_cast<u8>(form), .argument = *index });
+                fixups.append({ node, true, next_position + jump.offset() });
+                break;
+            }
+            case OpCodeId::SaveLeftCaptureGroup: {
+                auto id = static_cast<OpCode_SaveLeftCaptureGroup const&>(opcode).id();
+                note_capture_group(id);
+                append_node({ .type = Node::Type::SaveLeftCaptureGroup, .argument = id });
+                break;
+            }
+            case OpCodeId::SaveRightCaptureGroup: {
+                auto id = static_cast<OpCode_SaveRightCaptureGroup const&>(opcode).id();
+                note_capture_group(id);
+                append_node({ .type = Node::Type::SaveRightCaptureGroup, .argument = id });
+                break;
+            }
+            case OpCodeId::SaveRightNamedCaptureGroup: {
+                auto& save = static_cast<OpCode_SaveRightNamedCaptureGroup const&>(opcode);
+                note_capture_group(save.id(), save.name());
+                append_node({ .type = Node::Type::SaveRightCaptureGroup, .argument = save.id() });
+                break;
+            }
+            case OpCodeId::ClearCaptureGroup: {
+                auto id = static_cast<OpCode_ClearCaptureGroup const&>(opcode).id();
+                note_capture_group(id);
+                append_node({ .type = Node::Type::ClearCaptureGroup, .argument = id });
+                break;
+            }
+            case OpCodeId::Repeat: {
+                // NOTE: The body has already been emitted once, the remaining repetitions become copies of it.
+                auto& repeat = static_cast<OpCode_Repeat const&>(opcode);
+                auto body_start = position - repeat.offset();
+                auto count = repeat.count();
+                if (repeat.offset() > position - from || count == 0 || count > c_max_node_count)
+                    return false;
+                for (u64 i = 1; i < count; ++i) {
+                    Vector<Fixup> escaping_fixups;
+                    if (!emit(body_start, position, escaping_fixups))
+                        return false;
+                    fixups.extend(move(escaping_fixups));
+                }
+                break;
+            }
+            case OpCodeId::ResetRepeat:
+                // NOTE: Repetition counters don't exist once repetitions are unrolled.
+                break;
+            case OpCodeId::Exit:
+                append_node({ .type = Node::Type::Match });
+                break;
+            case OpCodeId::Save:
+            case OpCodeId::Restore:
+            case OpCodeId::GoBack:
+            case OpCodeId::FailForks:
+                // NOTE: Lookarounds need backtracking.
+                return false;
+            }
+
+            state.instruction_position = next_position;
+        }
+
+        if (state.instruction_position != to)
+            return false;
+
+        for (auto& fixup : fixups) {
+            u32 target_node;
+            if (fixup.target == to) {
+                target_node = m_nfa->m_nodes.size();
+            } else if (fixup.target >= from && fixup.target < to) {
+                auto node = node_for_position.get(fixup.target);
+                if (!node.has_value())
+                    return false;
+                target_node = *node;
+            } else {
+                unresolved.append(fixup);
+                continue;
+            }
+
+            auto& node = m_nfa->m_nodes[fixup.node];
+            if (fixup.is_alternative)
+                node.alternative = target_node;
+            else
+                node.target = target_node;
+        }
+        return true;
+    }
+
+    ByteCode const& m_bytecode;
+    NFA* m_nfa { nullptr };
+    HashMap<size_t, size_t> m_checkpoint_indices;
+};
+
+static bool is_word_character(u32 code_point)
+{
+    return is_ascii_alphanumeric(code_point) || code_point == '_';
+}
+
+static bool considers_newlines(AllOptions const& options)
+{
+    return options.has_flag_set(AllFlags::Multiline) && options.has_flag_set(AllFlags::Internal_ConsiderNewline);
+}
+
+u32 NFA::code_point_at(MatchInput const& input, Scan const& scan)
+{
+    // NOTE: Without the unicode flag, a surrogate pair in a UTF-16 view is two separate characters (as in OpCode_Compare::compare_char()).
+    //       Views of other kinds are indexed by position like there, even though advance() counts their code units differently.
+    if (input.view.unicode() && input.view.has_multi_unit_code_points())
+        return input.view[scan.position_in_code_units];
+    return input.view.substring_view(scan.position, 1)[0];
+}
+
+void NFA::advance(MatchInput const& input, Scan& scan, u32 code_point)
+{
+    ++scan.position;
+    if (input.view.unicode())
+        scan.position_in_code_units += input.view.length_of_code_point(code_point);
+    else
+        ++scan.position_in_code_units;
+}
+
+NFA::NFA() = default;
+NFA::~NFA() = default;
+
+OwnPtr<NFA> NFA::try_create(ByteCode const& bytecode)
+{
+    auto nfa = Compiler(bytecode).compile();
+    if (nfa)
+        dbgln_if(REGEX_DEBUG, "NFA: Compiled {} nodes", nfa->m_nodes.size());
+    else
+        dbgln_if(REGEX_DEBUG, "NFA: Pattern needs backtracking");
+    return nfa;
+}
+
+NonnullRefPtr<NFA::Captures> NFA::Captures::clone() const
+{
+    auto captures = adopt_ref(*new Captures);
+    captures->start = start;
+    captures->groups = groups;
+    return captures;
+}
+
+NFA::Cache& NFA::cache_for(MatchInput const& input) const
+{
+    // NOTE: What a Compare node accepts and what the assertions check depends on the options, so a change in options starts over.
+    if (m_cache && m_cache->options.value() == input.regex_options.value())
+        return *m_cache;
+
+    m_cache = make<Cache>();
+    m_cache->options = input.regex_options;
+    m_cache->assertion_context_mask = m_assertion_context_mask;
+    if (!considers_newlines(input.regex_options))
+        m_cache->assertion_context_mask &= ~(Context::AfterNewline | Context::BeforeNewline);
+    m_cache->ascii_matches.resize(m_nodes.size());
+    m_cache->visited.resize(m_nodes.size());
+    return *m_cache;
+}
+
+bool NFA::node_matches(ByteCode const& bytecode, MatchInput const& input, u32 node_index, u32 code_point) const
+{
+    auto& node = m_nodes[node_index];
+    if (node.type == Node::Type::CompareChar) {
+        if (input.regex_options & AllFlags::Insensitive)
+            return to_ascii_lowercase(code_point) == to_ascii_lowercase(node.argument);
+        return code_point == node.argument;
+    }
+
+    VERIFY(node.type == Node::Type::Compare);
+
+    // NOTE: Rather than duplicating every kind of comparison, run the Compare instruction itself against just this code point.
+    auto run_compare = [&](u32 code_point) {
+        MatchInput probe_input;
+        probe_input.view = Utf32View { &code_point, 1 };
+        probe_input.view.set_unicode(input.view.unicode());
+        probe_input.regex_options = input.regex_options;
+
+        MatchState probe_state;
+        probe_state.instruction_position = node.argument;
+        auto& opcode = bytecode.get_opcode(probe_state);
+        return opcode.execute(probe_input, probe_state) == ExecutionResult::Continue && probe_state.string_position == 1;
+    };
+
+    if (code_point >= 128)
+        return run_compare(code_point);
+
+    auto& ascii_matches = m_cache->ascii_matches[node_index];
+    if (!ascii_matches.has_value()) {
+        Array<u64, 2> matches {};
+        for (u32 ch = 0; ch < 128; ++ch) {
+            if (run_compare(ch))
+                matches[ch / 64] |= 1ull << (ch % 64);
+        }
+        ascii_matches = matches;
+    }
+    return ((*ascii_matches)[code_point / 64] >> (code_point % 64)) & 1;
+}
+
+NFA::Context NFA::assertion_context(MatchInput const& input, Scan const& scan, size_t view_length) const
+{
+    auto mask = m_cache->assertion_context_mask;
+    if (mask == Context::None)
+        return Context::None;
+
+    auto context = Context::None;
+    if (scan.position == 0) {
+        context |= Context::AtStart;
+    } else {
+        auto previous_code_point = input.view[scan.position_in_code_units - 1];
+        if (previous_code_point == '\n')
+            context |= Context::AfterNewline;
+        if (is_word_character(previous_code_point))
+            context |= Context::AfterWordCharacter;
+    }
+
+    if (scan.position >= view_length) {
+        context |= Context::AtEnd;
+    } else {
+        auto next_code_point = input.view[scan.position_in_code_units];
+        if (next_code_point == '\n')
+            context |= Context::BeforeNewline;
+        if (is_word_character(next_code_point))
+            context |= Context::BeforeWordCharacter;
+    }
+
+    return context & mask;
+}
+
+bool NFA::passes_assertion(MatchInput const& input, Node const& node, Context context) const
+{
+    switch (node.type) {
+    case Node::Type::CheckBegin: {
+        auto is_at_line_boundary = has_flag(context, Context::AtStart) || has_flag(context, Context::AfterNewline);
+        return OpCode_CheckBegin::is_satisfied(is_at_line_boundary, input.regex_options);
+    }
+    case Node::Type::CheckEnd: {
+        auto is_at_line_boundary = has_flag(context, Context::AtEnd) || has_flag(context, Context::BeforeNewline);
+        return OpCode_CheckEnd::is_satisfied(is_at_line_boundary, input.regex_options);
+    }
+    case Node::Type::CheckBoundary: {
+        auto is_word_boundary = has_flag(context, Context::AfterWordCharacter) != has_flag(context, Context::BeforeWordCharacter);
+        return static_cast<BoundaryCheckType>(node.form) == BoundaryCheckType::Word ? is_word_boundary : !is_word_boundary;
+    }
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
+
+RefPtr<NFA::Captures> NFA::apply_capture_operation(Node const& node, NonnullRefPtr<Captures> captures, Scan const& scan) const
+{
+    auto id = node.argument;
+    if (node.type == Node::Type::SaveRightCaptureGroup) {
+        auto group = id < captures->groups.size() ? captures->groups[id] : CaptureGroup {};
+        if (scan.position < group.left_column)
+            return nullptr;
+        // NOTE: Like OpCode_SaveRightCaptureGroup, this keeps a later capture from moving the group backwards.
+        if (group.left_column < group.column)
+            return captures;
+    }
+
+    auto new_captures = captures->clone();
+    if (id >= new_captures->groups.size())
+        new_captures->groups.resize(id + 1);
+    auto& group = new_captures->groups[id];
+
+    switch (node.type) {
+    case Node::Type::SaveLeftCaptureGroup:
+        group.left_column = scan.position;
+        break;
+    case Node::Type::SaveRightCaptureGroup:
+        group.column = group.left_column;
+        group.length = scan.position - group.left_column;
+        group.is_set = true;
+        break;
+    case Node::Type::ClearCaptureGroup:
+        group = {};
+        break;
+    default:
+        VERIFY_NOT_REACHED();
+    }
+    return new_captures;
+}
+
+// Follows everything that doesn't consume input from the given threads (and then from the start of the pattern, if
+// `start_thread` is given), calling `callback` for the consuming nodes reached in order of priority.
+// Returns whether the end of the pattern was reached, after which lower priority threads don't matter anymore.
+template<typename Callback>
+bool NFA::for_each_consuming_node_in_closure(MatchInput const& input, Vector<Thread> const& threads, Thread const* start_thread, Scan const& scan, Context context, Callback callback, RefPtr<Captures>* matched_captures) const
+{
+    auto& cache = *m_cache;
+    if (++cache.visit_generation == 0) {
+        for (auto& visit_generation : cache.visited)
+            visit_generation = 0;
+        cache.visit_generation = 1;
+    }
+    if (!cache.visited_with_checkpoints.is_empty())
+        cache.visited_with_checkpoints.clear_with_capacity();
+
+    // NOTE: A loop may be entered again through a different set of checkpoints, but there's never a reason to consume
+    //       the next character at the same node twice.
+    auto mark_visited = [&](u32 node_index, u64 checkpoints) {
+        auto type = m_nodes[node_index].type;
+        if (checkpoints == 0 || type == Node::Type::Compare || type == Node::Type::CompareChar || type == Node::Type::Match) {
+            if (cache.visited[node_index] == cache.visit_generation)
+                return false;
+            cache.visited[node_index] = cache.visit_generation;
+            return true;
+        }
+        return cache.visited_with_checkpoints.set((checkpoints << c_node_index_bits) | node_index) == AK::HashSetResult::InsertedNewEntry;
+    };
+
+    auto& stack = cache.closure_stack;
+    auto explore = [&](Thread const& thread) {
+        stack.clear_with_capacity();
+        stack.append({ thread.node, 0, thread.captures });
+
+        while (!stack.is_empty()) {
+            auto step = stack.take_last();
+            if (!mark_visited(step.node, step.checkpoints))
+                continue;
+
+            auto& node = m_nodes[step.node];
+            auto next = step.node + 1;
+            switch (node.type) {
+            case Node::Type::Compare:
+            case Node::Type::CompareChar:
+                callback(Thread { step.node, move(step.captures) });
+                break;
+            case Node::Type::Match:
+                if (matched_captures)
+                    *matched_captures = move(step.captures);
+                return true;
+            case Node::Type::Jump:
+                stack.append({ node.target, step.checkpoints, move(step.captures) });
+                break;
+            case Node::Type::Fork:
+                stack.append({ node.alternative, step.checkpoints, step.captures });
+                stack.append({ node.target, step.checkpoints, move(step.captures) });
+                break;
+            case Node::Type::CheckBegin:
+            case Node::Type::CheckEnd:
+            case Node::Type::CheckBoundary:
+                if (passes_assertion(input, node, context))
+                    stack.append({ next, step.checkpoints, move(step.captures) });
+                break;
+            case Node::Type::Checkpoint:
+                stack.append({ next, step.checkpoints | (1ull << node.argument), move(step.captures) });
+                break;
+            case Node::Type::JumpNonEmpty: {
+                // NOTE: If the checkpoint was passed during this closure, the loop body didn't consume anything.
+                if (step.checkpoints & (1ull << node.argument)) {
+                    stack.append({ next, step.checkpoints, move(step.captures) });
+                    break;
+                }
+                switch (static_cast<OpCodeId>(node.form)) {
+                case OpCodeId::Jump:
+                    stack.append({ node.alternative, step.checkpoints, move(step.captures) });
+                    break;
+                case OpCodeId::ForkJump:
+                case OpCodeId::ForkReplaceJump:
+                    stack.append({ next, step.checkpoints, step.captures });
+                    stack.append({ node.alternative, step.checkpoints, move(step.captures) });
+                    break;
+                default:
+                    stack.append({ node.alternative, step.checkpoints, step.captures });
+                    stack.append({ next, step.checkpoints, move(step.captures) });
+                    break;
+                }
+                break;
+            }
+            case Node::Type::SaveLeftCaptureGroup:
+            case Node::Type::SaveRightCaptureGroup:
+            case Node::Type::ClearCaptureGroup:
+                if (!step.captures) {
+                    stack.append({ next, step.checkpoints, nullptr });
+                } else if (auto captures = apply_capture_operation(node, step.captures.release_nonnull(), scan)) {
+                    stack.append({ next, step.checkpoints, move(captures) });
+                }
+                break;
+            }
+        }
+        return false;
+    };
+
+    for (auto& thread : threads) {
+        if (explore(thread))
+            return true;
+    }
+    return start_thread && explore(*start_thread);
+}
+
+Optional<NFA::Scan> NFA::find_match_end(ByteCode const& bytecode, MatchInput const& input, Scan scan, size_t view_length, size_t last_start_position, bool anchored, size_t& operations) const
+{
+    using DFAState = Cache::DFAState;
+    using DFAClosedState = Cache::DFAClosedState;
+
+    auto& cache = *m_cache;
+    auto first_position = scan.position;
+
+    auto closed_state_for = [&](DFAState& state, Context context) -> DFAClosedState& {
+        for (auto& closed_state : state.closed_states) {
+            if (closed_state.context == context)
+                return closed_state;
+        }
+
+        auto closed_state = make<DFAClosedState>();
+        closed_state->context = context;
+
+        Vector<Thread> threads;
+        threads.ensure_capacity(state.nodes.size());
+        for (auto node : state.nodes)
+            threads.unchecked_append({ node, nullptr });
+        Thread start_thread { 0, nullptr };
+        auto can_start = has_flag(context, Context::CanStartMatch) && !state.has_matched;
+
+        closed_state->is_match = for_each_consuming_node_in_closure(
+            input, threads, can_start ? &start_thread : nullptr, scan, context, [&](Thread&& thread) { closed_state->consuming_nodes.append(thread.node); }, nullptr);
+        closed_state->has_matched = state.has_matched || closed_state->is_match;
+
+        cache.dfa_memory_usage += sizeof(DFAClosedState) + closed_state->consuming_nodes.size() * sizeof(u32);
+        state.closed_states.append(move(closed_state));
+        return state.closed_states.last();
+    };
+
+    Optional<Scan> match_end;
+    auto* state = cache.intern_dfa_state({}, false);
+    for (;;) {
+        auto context = assertion_context(input, scan, view_length);
+        if (anchored ? scan.position == first_position : scan.position <= last_start_position)
+            context |= Context::CanStartMatch;
+
+        auto& closed_state = closed_state_for(*state, context);
+        if (closed_state.is_match)
+            match_end = scan;
+
+        // NOTE: Once nothing is alive, only a match starting further ahead could still be found (and preferred).
+        if (closed_state.consuming_nodes.is_empty() && (closed_state.has_matched || anchored || scan.position >= last_start_position))
+            break;
+        if (scan.position >= view_length)
+            break;
+
+        auto code_point = code_point_at(input, scan);
+        auto* next_state = code_point < 128 ? closed_state.ascii_transitions[code_point] : closed_state.transitions.get(code_point).value_or(nullptr);
+        if (!next_state) {
+            Vector<u32> next_nodes;
+            for (auto node : closed_state.consuming_nodes) {
+                if (node_matches(bytecode, input, node, code_point))
+                    next_nodes.append(node + 1);
+            }
+
+            auto generation = cache.dfa_generation;
+            next_state = cache.intern_dfa_state(move(next_nodes), closed_state.has_matched);
+            // NOTE: If interning flushed the cache, closed_state is gone along with everything else.
+            if (generation == cache.dfa_generation) {
+                if (code_point < 128) {
+                    closed_state.ascii_transitions[code_point] = next_state;
+                } else {
+                    closed_state.transitions.set(code_point, next_state);
+                    cache.dfa_memory_usage += sizeof(u32) + sizeof(DFAState*);
+                }
+            }
+        }
+
+        advance(input, scan, code_point);
+        state = next_state;
+        ++operations;
+    }
+
+    return match_end;
+}
+
+RefPtr<NFA::Captures> NFA::find_match_with_captures(ByteCode const& bytecode, MatchInput const& input, Scan& scan, size_t view_length, size_t last_start_position, bool anchored, size_t& operations) const
+{
+    auto first_position = scan.position;
+
+    Vector<Thread> threads;
+    Vector<Thread> consuming_threads;
+    RefPtr<Captures> match;
+    Scan match_end;
+
+    for (;;) {
+        auto context = assertion_context(input, scan, view_length);
+        auto can_start = !match && (anchored ? scan.position == first_position : scan.position <= last_start_position);
+
+        Thread start_thread;
+        if (can_start) {
+            start_thread.captures = adopt_ref(*new Captures);
+            start_thread.captures->start = scan;
+        }
+
+        consuming_threads.clear_with_capacity();
+        RefPtr<Captures> matched_captures;
+        auto did_match = for_each_consuming_node_in_closure(
+            input, threads, can_start ? &start_thread : nullptr, scan, context, [&](Thread&& thread) { consuming_threads.append(move(thread)); }, &matched_captures);
+        if (did_match) {
+            match = move(matched_captures);
+            match_end = scan;
+        }
+
+        if (consuming_threads.is_empty() && (match || anchored || scan.position >= last_start_position))
+            break;
+        if (scan.position >= view_length)
+            break;
+
+        auto code_point = code_point_at(input, scan);
+        threads.clear_with_capacity();
+        for (auto& thread : consuming_threads) {
+            if (node_matches(bytecode, input, thread.node, code_point))
+                threads.append({ thread.node + 1, move(thread.captures) });
+        }
+
+        advance(input, scan, code_point);
+        ++operations;
+    }
+
+    scan = match_end;
+    return match;
+}
+
+bool NFA::search(ByteCode const& bytecode, MatchInput const& input, MatchState& state, size_t& start_position, size_t last_start_position, bool anchored, size_t& operations) const
+{
+    cache_for(input);
+    auto view_length = input.view.length();
+
+    // NOTE: With the unicode flag, a search that starts further into a UTF-8 or UTF-16 view (like RegExp.prototype.exec()
+    //       from a lastIndex past a surrogate pair) starts at a different position in code units than in code points.
+    auto start_position_in_code_units = start_position;
+    if (input.view.unicode() && input.view.has_multi_unit_code_points())
+        start_position_in_code_units = input.view.code_unit_offset_of(start_position);
+    Scan start { start_position, start_position_in_code_units };
+
+    auto match_end = find_match_end(bytecode, input, start, view_length, last_start_position, anchored, operations);
+    if (!match_end.has_value())
+        return false;
+
+    if (state.capture_group_matches.size() <= input.match_index)
+        state.capture_group_matches.resize(input.match_index + 1);
+    auto& capture_group_matches = state.capture_group_matches[input.match_index];
+    for (auto& match : capture_group_matches)
+        match.reset();
+
+    // NOTE: The DFA knows where the match ends, but only the NFA can tell where it started and what the groups captured.
+    if (anchored && (m_capture_group_names.is_empty() || input.regex_options.has_flag_set(AllFlags::SkipSubExprResults))) {
+        state.string_position = match_end->position;
+        state.string_position_in_code_units = match_end->position_in_code_units;
+        return true;
+    }
+
+    auto end = start;
+    auto captures = find_match_with_captures(bytecode, input, end, view_length, last_start_position, anchored, operations);
+    VERIFY(captures);
+    VERIFY(end.position == match_end->position);
+
+    start_position = captures->start.position;
+    state.string_position = end.position;
+    state.string_position_in_code_units = end.position_in_code_units;
+
+    if (capture_group_matches.size() < m_capture_group_names.size())
+        capture_group_matches.resize(m_capture_group_names.size());
+    for (size_t id = 0; id < captures->groups.size(); ++id) {
+        auto& group = captures->groups[id];
+        if (!group.is_set)
+            continue;
+
+        auto view = input.view.substring_view(group.column, group.length);
+        auto& match = capture_group_matches[id];
+        if (auto& name = m_capture_group_names[id]; name.has_value()) {
+            if (input.regex_options & AllFlags::StringCopyMatches)
+                match = { view.to_string(), *name, input.line, group.column, input.global_offset + group.column };
+            else
+                match = { view, *name, input.line, group.column, input.global_offset + group.column };
+        } else {
+            if (input.regex_options & AllFlags::StringCopyMatches)
+                match = { view.to_string(), input.line, group.column, input.global_offset + group.column };
+            else
+                match = { view, input.line, group.column, input.global_offset + group.column };
+        }
+    }
+
+    return true;
+}
+
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include "RegexByteCode.h"
+#include "RegexMatch.h"
+#include "RegexOptions.h"
+
+#include <AK/EnumBits.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/OwnPtr.h>
+#include <AK/RefCounted.h>
+#include <AK/RefPtr.h>
+#include <AK/Vector.h>
+
+namespace regex {
+
+// A Thompson NFA compiled from the bytecode of a pattern that doesn't need backtracking,
+// i.e. one without backreferences or lookaround.
+// Matching it takes time linear in the length of the input, and finds the same match (and captures)
+// that the backtracking VM in Matcher::execute() would find first.
+//
+// Matches are located by a lazily built DFA whose states are cached across calls, and only
+// if there is one are captures recovered by simulating the NFA directly ("Pike VM").
+class NFA {
+public:
+    static OwnPtr<NFA> try_create(ByteCode const&);
+    ~NFA();
+
+    // Finds the leftmost match that starts at or after `start_position` (exactly at `start_position` if `anchored`), but
+    // not after `last_start_position`. On success, `start_position` is moved to the start of the match and `state`
+    // holds its end and capture groups, just like after a successful Matcher::execute().
+    bool search(ByteCode const&, MatchInput const&, MatchState&, size_t& start_position, size_t last_start_position, bool anchored, size_t& operations) const;
+
+private:
+    struct Node {
+        enum class Type : u8 {
+            Compare,
+            CompareChar,
+            Jump,
+            Fork,
+            CheckBegin,
+            CheckEnd,
+            CheckBoundary,
+            Checkpoint,
+            JumpNonEmpty,
+            SaveLeftCaptureGroup,
+            SaveRightCaptureGroup,
+            ClearCaptureGroup,
+            Match,
+        };
+
+        Type type;
+        // CheckBoundary: the BoundaryCheckType, JumpNonEmpty: the OpCodeId of the jump to perform.
+        u8 form { 0 };
+        // Jump: the target, Fork: the higher priority target. Everything else continues with the next node.
+        u32 target { 0 };
+        // Fork: the lower priority target, JumpNonEmpty: the target if the loop made progress.
+        u32 alternative { 0 };
+        // Compare: the instruction position, CompareChar: the code point,
+        // Checkpoint and JumpNonEmpty: the checkpoint index, capture group operations: the group id.
+        u64 argument { 0 };
+    };
+
+    class Compiler;
+
+    // Everything about the surroundings of a position that assertions look at, so that it can be part of a cache key.
+    enum class Context : u8 {
+        None = 0,
+        AtStart = 1 << 0,
+        AtEnd = 1 << 1,
+        AfterNewline = 1 << 2,
+        BeforeNewline = 1 << 3,
+        AfterWordCharacter = 1 << 4,
+        BeforeWordCharacter = 1 << 5,
+        CanStartMatch = 1 << 6,
+    };
+    AK_ENUM_BITWISE_FRIEND_OPERATORS(Context);
+
+    struct Scan {
+        size_t position { 0 };
+        size_t position_in_code_units { 0 };
+    };
+
+    struct CaptureGroup {
+        size_t left_column { 0 };
+        size_t column { 0 };
+        size_t length { 0 };
+        bool is_set { false };
+    };
+
+    struct Captures : public RefCounted<Captures> {
+        NonnullRefPtr<Captures> clone() const;
+
+        Scan start;
+        Vector<CaptureGroup> groups;
+    };
+
+    struct Thread {
+        u32 node { 0 };
+        RefPtr<Captures> captures;
+    };
+
+    struct Cache;
+
+    NFA();
+
+    Cache& cache_for(MatchInput const&) const;
+
+    static u32 code_point_at(MatchInput const&, Scan const&);
+    static void advance(MatchInput const&, Scan&, u32 code_point);
+
+    bool node_matches(ByteCode const&, MatchInput const&, u32 node_index, u32 code_point) const;
+    Context assertion_context(MatchInput const&, Scan const&, size_t view_length) const;
+    bool passes_assertion(MatchInput const&, Node const&, Context) const;
+    RefPtr<Captures> apply_capture_operation(Node const&, NonnullRefPtr<Captures>, Scan const&) const;
+
+    template<typename Callback>
+    bool for_each_consuming_node_in_closure(MatchInput const&, Vector<Thread> const&, Thread const* start_thread, Scan const&, Context, Callback, RefPtr<Captures>* matched_captures) const;
+
+    Optional<Scan> find_match_end(ByteCode const&, MatchInput const&, Scan, size_t view_length, size_t last_start_position, bool anchored, size_t& operations) const;
+    RefPtr<Captures> find_match_with_captures(ByteCode const&, MatchInput const&, Scan&, size_t view_length, size_t last_start_position, bool anchored, size_t& operations) const;
+
+    Vector<Node> m_nodes;
+    Vector<Optional<StringView>> m_capture_group_names;
+    Context m_assertion_context_mask { Context::None };
+
+    // NOTE: Like Regex::start_offset, this is updated by const member functions; an NFA can't be used by two threads at once.
+    mutable OwnPtr<Cache> m_cache;
+};
+
+}
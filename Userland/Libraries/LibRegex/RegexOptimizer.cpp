@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/HashMap.h>
 #include <AK/QuickSort.h>
 #include <AK/RedBlackTree.h>
 #include <AK/Stack.h>
@@ -28,6 +29,9 @@ void Regex<Parser>::run_optimization_passes()
     attempt_rewrite_loops_as_atomic_groups(split_basic_blocks(parser_result.bytecode));
 
     parser_result.bytecode.flatten();
+
+    // Find literals that every match has to start with or contain, e.g. "ERROR" in ^.*ERROR: \w+$
+    fill_optimization_data();
 }
 
 template<typename Parser>
@@ -970,6 +974,269 @@ void Optimizer::append_character_class(ByteCode& target, Vector<CompareTypeAndVa
     target.extend(move(arguments));
 }
 
+static Optional<String> literal_compared_by(ByteCode const& bytecode, size_t position, OpCode_Compare const& compare)
+{
+    if (compare.arguments_count() != 1)
+        return {};
+
+    auto arguments_position = position + 3;
+    auto type = static_cast<CharacterCompareType>(bytecode.at(arguments_position));
+    if (type != CharacterCompareType::Char && type != CharacterCompareType::String)
+        return {};
+
+    // NOTE: Only ASCII is the same in every kind of view, and only ASCII can be found by a byte-wise search.
+    StringBuilder builder;
+    auto append_if_ascii = [&](ByteCodeValueType code_point) {
+        if (code_point >= 128)
+            return false;
+        builder.append(static_cast<char>(code_point));
+        return true;
+    };
+
+    if (type == CharacterCompareType::Char) {
+        if (!append_if_ascii(bytecode.at(arguments_position + 1)))
+            return {};
+    } else {
+        auto length = bytecode.at(arguments_position + 1);
+        for (size_t i = 0; i < length; ++i) {
+            if (!append_if_ascii(bytecode.at(arguments_position + 2 + i)))
+                return {};
+        }
+    }
+
+    return builder.to_string();
+}
+
+template<typename Parser>
+void Regex<Parser>::fill_optimization_data()
+{
+    auto& data = parser_result.optimization_data;
+    data = {};
+
+    // NOTE: Patterns larger than this aren't worth the effort.
+    static constexpr size_t max_instruction_count = 4096;
+
+    enum class Kind {
+        // Consumes exactly `literal`, then continues with the next instruction.
+        Literal,
+        // Consumes nothing, then continues with the next instruction (if it continues at all).
+        Transparent,
+        Other,
+    };
+
+    struct Instruction {
+        Kind kind { Kind::Other };
+        String literal;
+        Vector<size_t, 2> successors;
+    };
+
+    auto& bytecode = parser_result.bytecode;
+    auto bytecode_size = bytecode.size();
+
+    Vector<Instruction> instructions;
+    HashMap<size_t, size_t> index_for_position;
+
+    MatchState state;
+    state.instruction_position = 0;
+    while (state.instruction_position < bytecode_size) {
+        if (instructions.size() >= max_instruction_count)
+            return;
+
+        auto position = state.instruction_position;
+        auto& opcode = bytecode.get_opcode(state);
+        auto next_position = position + opcode.size();
+
+        Instruction instruction;
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Compare:
+            if (auto literal = literal_compared_by(bytecode, position, static_cast<OpCode_Compare const&>(opcode)); literal.has_value()) {
+                instruction.kind = Kind::Literal;
+                instruction.literal = literal.release_value();
+            }
+            instruction.successors.append(next_position);
+            break;
+        case OpCodeId::Jump:
+            instruction.successors.append(next_position + static_cast<OpCode_Jump const&>(opcode).offset());
+            break;
+        case OpCodeId::ForkJump:
+        case OpCodeId::ForkReplaceJump:
+            instruction.successors.append(next_position);
+            instruction.successors.append(next_position + static_cast<OpCode_ForkJump const&>(opcode).offset());
+            break;
+        case OpCodeId::ForkStay:
+        case OpCodeId::ForkReplaceStay:
+            instruction.successors.append(next_position);
+            instruction.successors.append(next_position + static_cast<OpCode_ForkStay const&>(opcode).offset());
+            break;
+        case OpCodeId::JumpNonEmpty:
+            instruction.successors.append(next_position);
+            instruction.successors.append(next_position + static_cast<OpCode_JumpNonEmpty const&>(opcode).offset());
+            break;
+        case OpCodeId::Repeat:
+            instruction.successors.append(next_position);
+            instruction.successors.append(position - static_cast<OpCode_Repeat const&>(opcode).offset());
+            break;
+        case OpCodeId::Exit:
+            instruction.successors.append(bytecode_size);
+            break;
+        case OpCodeId::Save:
+        case OpCodeId::Restore:
+        case OpCodeId::GoBack:
+        case OpCodeId::FailForks:
+            // NOTE: Lookarounds look at input outside of the match.
+            return;
+        case OpCodeId::SaveLeftCaptureGroup:
+        case OpCodeId::SaveRightCaptureGroup:
+        case OpCodeId::SaveRightNamedCaptureGroup:
+        case OpCodeId::ClearCaptureGroup:
+        case OpCodeId::CheckBegin:
+        case OpCodeId::CheckEnd:
+        case OpCodeId::CheckBoundary:
+        case OpCodeId::Checkpoint:
+        case OpCodeId::ResetRepeat:
+            instruction.kind = Kind::Transparent;
+            instruction.successors.append(next_position);
+            break;
+        }
+
+        index_for_position.set(position, instructions.size());
+        instructions.append(move(instruction));
+        state.instruction_position = next_position;
+    }
+
+    // Turn positions into indices, the end of the bytecode (i.e. a match) becomes one past the last instruction.
+    auto end = instructions.size();
+    for (auto& instruction : instructions) {
+        for (auto& successor : instruction.successors) {
+            if (successor == bytecode_size) {
+                successor = end;
+                continue;
+            }
+            auto index = index_for_position.get(successor);
+            if (!index.has_value())
+                return;
+            successor = *index;
+        }
+    }
+
+    // Every match starts with the instructions at the beginning of the bytecode.
+    StringBuilder prefix_builder;
+    for (size_t i = 0; i < end && instructions[i].kind != Kind::Other; ++i)
+        prefix_builder.append(instructions[i].literal);
+    data.literal_prefix = prefix_builder.to_string();
+
+    // Every match passes through the instructions that dominate the end of the bytecode,
+    // which are found with "A Simple, Fast Dominance Algorithm" by Cooper, Harvey and Kennedy.
+    auto successors_of = [&](size_t index) -> Span<size_t const> {
+        if (index == end)
+            return {};
+        return instructions[index].successors.span();
+    };
+
+    Vector<size_t> postorder;
+    Vector<Optional<size_t>> postorder_number;
+    postorder_number.resize(end + 1);
+    {
+        Vector<bool> visited;
+        visited.resize(end + 1);
+        struct Visit {
+            size_t index { 0 };
+            size_t next_successor { 0 };
+        };
+        Vector<Visit> stack;
+        stack.append({ 0, 0 });
+        visited[0] = true;
+        while (!stack.is_empty()) {
+            auto& visit = stack.last();
+            auto index = visit.index;
+            auto successors = successors_of(index);
+            if (visit.next_successor < successors.size()) {
+                auto successor = successors[visit.next_successor++];
+                if (!visited[successor]) {
+                    visited[successor] = true;
+                    stack.append({ successor, 0 });
+                }
+                continue;
+            }
+            postorder_number[index] = postorder.size();
+            postorder.append(index);
+            stack.take_last();
+        }
+    }
+
+    if (!postorder_number[end].has_value())
+        return;
+
+    Vector<Vector<size_t>> predecessors;
+    predecessors.resize(end + 1);
+    for (auto index : postorder) {
+        for (auto successor : successors_of(index))
+            predecessors[successor].append(index);
+    }
+
+    Vector<Optional<size_t>> immediate_dominator;
+    immediate_dominator.resize(end + 1);
+    immediate_dominator[0] = 0;
+
+    auto intersect = [&](size_t first, size_t second) {
+        while (first != second) {
+            while (*postorder_number[first] < *postorder_number[second])
+                first = *immediate_dominator[first];
+            while (*postorder_number[second] < *postorder_number[first])
+                second = *immediate_dominator[second];
+        }
+        return first;
+    };
+
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (size_t i = postorder.size() - 1; i-- > 0;) {
+            auto index = postorder[i];
+            Optional<size_t> new_dominator;
+            for (auto predecessor : predecessors[index]) {
+                if (!immediate_dominator[predecessor].has_value())
+                    continue;
+                new_dominator = new_dominator.has_value() ? intersect(predecessor, *new_dominator) : predecessor;
+            }
+            if (new_dominator != immediate_dominator[index]) {
+                immediate_dominator[index] = new_dominator;
+                changed = true;
+            }
+        }
+    }
+
+    Vector<size_t> dominators;
+    for (auto index = end; index != 0;) {
+        index = *immediate_dominator[index];
+        dominators.append(index);
+    }
+    dominators.reverse();
+
+    // Literals on consecutive dominators are adjacent in every match if nothing can come between them.
+    StringBuilder run_builder;
+    auto flush_run = [&] {
+        if (run_builder.length() > data.required_substring.length())
+            data.required_substring = run_builder.to_string();
+        run_builder.clear();
+    };
+    for (size_t i = 0; i < dominators.size(); ++i) {
+        auto& instruction = instructions[dominators[i]];
+        if (instruction.kind == Kind::Other) {
+            flush_run();
+            continue;
+        }
+        run_builder.append(instruction.literal);
+        if (i + 1 == dominators.size() || dominators[i + 1] != dominators[i] + 1)
+            flush_run();
+    }
+    flush_run();
+
+    if (data.literal_prefix.contains(data.required_substring))
+        data.required_substring = {};
+
+    dbgln_if(REGEX_DEBUG, "[optimizer] literal prefix: '{}', required substring: '{}'", data.literal_prefix, data.required_substring);
+}
+
 template void Regex<PosixBasicParser>::run_optimization_passes();
 template void Regex<PosixExtendedParser>::run_optimization_passes();
 template void Regex<ECMA262Parser>::run_optimization_passes();
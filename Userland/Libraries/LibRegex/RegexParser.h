@@ -55,6 +55,14 @@ public:
         Token error_token;
         Vector<FlyString> capture_groups;
         AllOptions options;
+
+        // Filled in by Regex::run_optimization_passes(), lets the matcher skip input that can't contain a match.
+        struct OptimizationData {
+            // Every match starts with this.
+            String literal_prefix;
+            // Every match contains this.
+            String required_substring;
+        } optimization_data;
     };
 
     explicit Parser(Lexer& lexer)
@@ -86,6 +86,22 @@ private:
     NonnullRefPtr<TypeName> m_type_name;
 };
 
+class IndexedColumn : public ASTNode {
+public:
+    IndexedColumn(String column_name, Order order)
+        : m_column_name(move(column_name))
+        , m_order(order)
+    {
+    }
+
+    String const& column_name() const { return m_column_name; }
+    Order order() const { return m_order; }
+
+private:
+    String m_column_name;
+    Order m_order;
+};
+
 class CommonTableExpression : public ASTNode {
 public:
     CommonTableExpression(String table_name, Vector<String> column_names, NonnullRefPtr<Select> select_statement)
@@ -801,6 +817,36 @@ private:
     bool m_is_error_if_table_exists;
 };
 
+class CreateIndex : public Statement {
+public:
+    CreateIndex(String schema_name, String index_name, String table_name, NonnullRefPtrVector<IndexedColumn> columns, bool is_unique, bool is_error_if_index_exists)
+        : m_schema_name(move(schema_name))
+        , m_index_name(move(index_name))
+        , m_table_name(move(table_name))
+        , m_columns(move(columns))
+        , m_is_unique(is_unique)
+        , m_is_error_if_index_exists(is_error_if_index_exists)
+    {
+    }
+
+    String const& schema_name() const { return m_schema_name; }
+    String const& index_name() const { return m_index_name; }
+    String const& table_name() const { return m_table_name; }
+    NonnullRefPtrVector<IndexedColumn> const& columns() const { return m_columns; }
+    bool is_unique() const { return m_is_unique; }
+    bool is_error_if_index_exists() const { return m_is_error_if_index_exists; }
+
+    ResultOr<ResultSet> execute(ExecutionContext&) const override;
+
+private:
+    String m_schema_name;
+    String m_index_name;
+    String m_table_name;
+    NonnullRefPtrVector<IndexedColumn> m_columns;
+    bool m_is_unique;
+    bool m_is_error_if_index_exists;
+};
+
 class AlterTable : public Statement {
 public:
     String const& schema_name() const { return m_schema_name; }
@@ -1073,4 +1119,18 @@ private:
     NonnullRefPtr<QualifiedTableName> m_qualified_table_name;
 };
 
+class Explain : public Statement {
+public:
+    explicit Explain(NonnullRefPtr<Select> select_statement)
+        : m_select_statement(move(select_statement))
+    {
+    }
+
+    NonnullRefPtr<Select> const& select_statement() const { return m_select_statement; }
+    ResultOr<ResultSet> execute(ExecutionContext&) const override;
+
+private:
+    NonnullRefPtr<Select> m_select_statement;
+};
+
 }
@@ -0,0 +1,497 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/NumericLimits.h>
+#include <AK/TypeCasts.h>
+#include <LibSQL/AST/BatchExpression.h>
+#include <LibSQL/Row.h>
+#include <LibSQL/TupleDescriptor.h>
+#include <LibSQL/Value.h>
+#include <math.h>
+
+namespace SQL::AST {
+
+void ColumnVector::reset(SQLType new_type, size_t size)
+{
+    type = new_type;
+    is_constant = false;
+    switch (type) {
+    case SQLType::Integer:
+        integers.resize_and_keep_capacity(size);
+        break;
+    case SQLType::Float:
+        floats.resize_and_keep_capacity(size);
+        break;
+    case SQLType::Boolean:
+        booleans.resize_and_keep_capacity(size);
+        break;
+    case SQLType::Text:
+        texts.resize_and_keep_capacity(size);
+        break;
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
+
+// Calls the callback for every row with the values of both operands in that row. Having a loop for every
+// combination of constant and non-constant operands keeps the loops simple enough for the compiler to vectorize.
+template<typename L, typename R, typename Callback>
+static void for_each_row(Span<L const> lhs, bool lhs_is_constant, Span<R const> rhs, bool rhs_is_constant, size_t size, Callback callback)
+{
+    if (lhs_is_constant && rhs_is_constant) {
+        callback(0, lhs[0], rhs[0]);
+    } else if (lhs_is_constant) {
+        for (size_t ix = 0; ix < size; ++ix)
+            callback(ix, lhs[0], rhs[ix]);
+    } else if (rhs_is_constant) {
+        for (size_t ix = 0; ix < size; ++ix)
+            callback(ix, lhs[ix], rhs[0]);
+    } else {
+        for (size_t ix = 0; ix < size; ++ix)
+            callback(ix, lhs[ix], rhs[ix]);
+    }
+}
+
+template<typename Callback>
+static bool visit_numeric(ColumnVector const& column, Callback callback)
+{
+    if (column.type == SQLType::Integer) {
+        callback(column.integers.span());
+        return true;
+    }
+    if (column.type == SQLType::Float) {
+        callback(column.floats.span());
+        return true;
+    }
+    return false;
+}
+
+// NOTE: These mirror what Value::compare() does for the types of its operands, including its quirks:
+//       integers are compared to floats rounded to the nearest integer, and floats to anything with
+//       a tolerance.
+static int compare_values(int lhs, int rhs)
+{
+    if (lhs == rhs)
+        return 0;
+    return lhs < rhs ? -1 : 1;
+}
+
+static int compare_values(int lhs, double rhs)
+{
+    if (rhs > static_cast<double>(NumericLimits<int>::max()) || rhs < static_cast<double>(NumericLimits<int>::min()))
+        return 1;
+    return compare_values(lhs, static_cast<int>(round(rhs)));
+}
+
+static int compare_values(double lhs, double rhs)
+{
+    auto diff = lhs - rhs;
+    if (fabs(diff) < NumericLimits<double>::epsilon())
+        return 0;
+    return diff < 0 ? -1 : 1;
+}
+
+static int compare_values(double lhs, int rhs)
+{
+    return compare_values(lhs, static_cast<double>(rhs));
+}
+
+static int compare_values(String const& lhs, String const& rhs)
+{
+    return lhs.view().compare(rhs);
+}
+
+static int compare_values(bool lhs, bool rhs)
+{
+    return lhs ^ rhs;
+}
+
+template<typename L, typename R>
+static void compare_columns(BinaryOperator op, Span<L const> lhs, bool lhs_is_constant, Span<R const> rhs, bool rhs_is_constant, size_t size, Vector<bool>& result)
+{
+    auto apply = [&](auto predicate) {
+        for_each_row(lhs, lhs_is_constant, rhs, rhs_is_constant, size, [&](size_t ix, auto const& lhs_value, auto const& rhs_value) {
+            result[ix] = predicate(compare_values(lhs_value, rhs_value));
+        });
+    };
+
+    switch (op) {
+    case BinaryOperator::LessThan:
+        apply([](int comparison) { return comparison < 0; });
+        break;
+    case BinaryOperator::LessThanEquals:
+        apply([](int comparison) { return comparison <= 0; });
+        break;
+    case BinaryOperator::GreaterThan:
+        apply([](int comparison) { return comparison > 0; });
+        break;
+    case BinaryOperator::GreaterThanEquals:
+        apply([](int comparison) { return comparison >= 0; });
+        break;
+    case BinaryOperator::Equals:
+        apply([](int comparison) { return comparison == 0; });
+        break;
+    case BinaryOperator::NotEquals:
+        apply([](int comparison) { return comparison != 0; });
+        break;
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
+
+// NOTE: Like Value::add() and friends, this always calculates with (and results in) floats.
+template<typename L, typename R>
+static void calculate_columns(BinaryOperator op, Span<L const> lhs, bool lhs_is_constant, Span<R const> rhs, bool rhs_is_constant, size_t size, Vector<double>& result)
+{
+    auto apply = [&](auto operation) {
+        for_each_row(lhs, lhs_is_constant, rhs, rhs_is_constant, size, [&](size_t ix, L lhs_value, R rhs_value) {
+            result[ix] = operation(static_cast<double>(lhs_value), static_cast<double>(rhs_value));
+        });
+    };
+
+    switch (op) {
+    case BinaryOperator::Plus:
+        apply([](double lhs_value, double rhs_value) { return lhs_value + rhs_value; });
+        break;
+    case BinaryOperator::Minus:
+        apply([](double lhs_value, double rhs_value) { return lhs_value - rhs_value; });
+        break;
+    case BinaryOperator::Multiplication:
+        apply([](double lhs_value, double rhs_value) { return lhs_value * rhs_value; });
+        break;
+    case BinaryOperator::Division:
+        apply([](double lhs_value, double rhs_value) { return lhs_value / rhs_value; });
+        break;
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
+
+static bool is_comparison(BinaryOperator op)
+{
+    switch (op) {
+    case BinaryOperator::LessThan:
+    case BinaryOperator::LessThanEquals:
+    case BinaryOperator::GreaterThan:
+    case BinaryOperator::GreaterThanEquals:
+    case BinaryOperator::Equals:
+    case BinaryOperator::NotEquals:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static bool is_arithmetic(BinaryOperator op)
+{
+    return op == BinaryOperator::Plus || op == BinaryOperator::Minus || op == BinaryOperator::Multiplication || op == BinaryOperator::Division;
+}
+
+// NOTE: An expression in parentheses evaluates to a tuple with a single element. That converts to a boolean and
+//       compares to other values like the element does, but can't be calculated with or compared against.
+static Expression const& unwrap_parentheses(Expression const& expression)
+{
+    if (is<ChainedExpression>(expression)) {
+        auto const& chained_expression = static_cast<ChainedExpression const&>(expression);
+        if (chained_expression.expressions().size() == 1)
+            return unwrap_parentheses(chained_expression.expressions()[0]);
+    }
+    return expression;
+}
+
+OwnPtr<BatchExpression> BatchExpression::compile(Expression const& expression, TupleDescriptor const& descriptor, Vector<size_t>& referenced_columns)
+{
+    return compile_operand(unwrap_parentheses(expression), descriptor, referenced_columns);
+}
+
+OwnPtr<BatchExpression> BatchExpression::compile_operand(Expression const& expression, TupleDescriptor const& descriptor, Vector<size_t>& referenced_columns)
+{
+    if (is<NumericLiteral>(expression)) {
+        auto result = adopt_own(*new BatchExpression(Type::Constant));
+        result->m_result.reset(SQLType::Float, 1);
+        result->m_result.is_constant = true;
+        result->m_result.floats[0] = static_cast<NumericLiteral const&>(expression).value();
+        return result;
+    }
+
+    if (is<StringLiteral>(expression)) {
+        auto result = adopt_own(*new BatchExpression(Type::Constant));
+        result->m_result.reset(SQLType::Text, 1);
+        result->m_result.is_constant = true;
+        result->m_result.texts[0] = static_cast<StringLiteral const&>(expression).value();
+        return result;
+    }
+
+    if (is<ColumnNameExpression>(expression)) {
+        // NOTE: This resolves the column just like ColumnNameExpression::evaluate() does. Columns that are ambiguous
+        //       or don't exist are left for it to fail on.
+        auto const& column_name_expression = static_cast<ColumnNameExpression const&>(expression);
+        Optional<size_t> column_index;
+        for (size_t ix = 0; ix < descriptor.size(); ++ix) {
+            if (!column_name_expression.table_name().is_empty() && descriptor[ix].table != column_name_expression.table_name())
+                continue;
+            if (descriptor[ix].name != column_name_expression.column_name())
+                continue;
+            if (column_index.has_value())
+                return {};
+            column_index = ix;
+        }
+        if (!column_index.has_value())
+            return {};
+
+        if (!referenced_columns.contains_slow(*column_index))
+            referenced_columns.append(*column_index);
+        auto result = adopt_own(*new BatchExpression(Type::Column));
+        result->m_column_index = *column_index;
+        return result;
+    }
+
+    if (is<UnaryOperatorExpression>(expression)) {
+        auto const& unary_expression = static_cast<UnaryOperatorExpression const&>(expression);
+        if (unary_expression.type() != UnaryOperator::Minus && unary_expression.type() != UnaryOperator::Not)
+            return {};
+
+        auto operand = compile_operand(*unary_expression.expression(), descriptor, referenced_columns);
+        if (!operand)
+            return {};
+        auto result = adopt_own(*new BatchExpression(unary_expression.type() == UnaryOperator::Minus ? Type::Negation : Type::Not));
+        result->m_lhs = move(operand);
+        return result;
+    }
+
+    if (is<BinaryOperatorExpression>(expression)) {
+        auto const& binary_expression = static_cast<BinaryOperatorExpression const&>(expression);
+        auto op = binary_expression.type();
+
+        Type type;
+        if (is_comparison(op))
+            type = Type::Comparison;
+        else if (is_arithmetic(op))
+            type = Type::Arithmetic;
+        else if (op == BinaryOperator::And || op == BinaryOperator::Or)
+            type = Type::Logical;
+        else
+            return {};
+
+        // Both sides of a boolean operator are converted to booleans, and the left hand side of a comparison compares
+        // like the element of a parenthesized expression, so parentheses don't matter there.
+        auto const& lhs = type == Type::Arithmetic ? *binary_expression.lhs() : unwrap_parentheses(*binary_expression.lhs());
+        auto const& rhs = type == Type::Logical ? unwrap_parentheses(*binary_expression.rhs()) : *binary_expression.rhs();
+
+        auto lhs_operand = compile_operand(lhs, descriptor, referenced_columns);
+        if (!lhs_operand)
+            return {};
+        auto rhs_operand = compile_operand(rhs, descriptor, referenced_columns);
+        if (!rhs_operand)
+            return {};
+
+        auto result = adopt_own(*new BatchExpression(type));
+        result->m_operator = op;
+        result->m_lhs = move(lhs_operand);
+        result->m_rhs = move(rhs_operand);
+        return result;
+    }
+
+    return {};
+}
+
+ColumnVector const* BatchExpression::evaluate(Vector<ColumnVector> const& columns, size_t size)
+{
+    switch (m_type) {
+    case Type::Constant:
+        return &m_result;
+    case Type::Column:
+        return &columns[m_column_index];
+    default:
+        break;
+    }
+
+    auto const* lhs = m_lhs->evaluate(columns, size);
+    if (!lhs)
+        return nullptr;
+
+    if (m_type == Type::Negation || m_type == Type::Not) {
+        auto result_size = lhs->is_constant ? 1 : size;
+        if (m_type == Type::Not) {
+            if (lhs->type != SQLType::Boolean)
+                return nullptr;
+            m_result.reset(SQLType::Boolean, result_size);
+            for (size_t ix = 0; ix < result_size; ++ix)
+                m_result.booleans[ix] = !lhs->booleans[ix];
+        } else if (lhs->type == SQLType::Integer) {
+            m_result.reset(SQLType::Integer, result_size);
+            for (size_t ix = 0; ix < result_size; ++ix)
+                m_result.integers[ix] = -lhs->integers[ix];
+        } else if (lhs->type == SQLType::Float) {
+            m_result.reset(SQLType::Float, result_size);
+            for (size_t ix = 0; ix < result_size; ++ix)
+                m_result.floats[ix] = -lhs->floats[ix];
+        } else {
+            return nullptr;
+        }
+        m_result.is_constant = lhs->is_constant;
+        return &m_result;
+    }
+
+    auto const* rhs = m_rhs->evaluate(columns, size);
+    if (!rhs)
+        return nullptr;
+
+    auto is_constant = lhs->is_constant && rhs->is_constant;
+    auto result_size = is_constant ? 1 : size;
+
+    switch (m_type) {
+    case Type::Comparison: {
+        m_result.reset(SQLType::Boolean, result_size);
+        bool handled = false;
+        if (lhs->type == SQLType::Text && rhs->type == SQLType::Text) {
+            compare_columns(m_operator, lhs->texts.span(), lhs->is_constant, rhs->texts.span(), rhs->is_constant, size, m_result.booleans);
+            handled = true;
+        } else if (lhs->type == SQLType::Boolean && rhs->type == SQLType::Boolean) {
+            compare_columns(m_operator, lhs->booleans.span(), lhs->is_constant, rhs->booleans.span(), rhs->is_constant, size, m_result.booleans);
+            handled = true;
+        } else {
+            visit_numeric(*lhs, [&](auto lhs_values) {
+                visit_numeric(*rhs, [&](auto rhs_values) {
+                    compare_columns(m_operator, lhs_values, lhs->is_constant, rhs_values, rhs->is_constant, size, m_result.booleans);
+                    handled = true;
+                });
+            });
+        }
+        if (!handled)
+            return nullptr;
+        break;
+    }
+    case Type::Arithmetic: {
+        m_result.reset(SQLType::Float, result_size);
+        bool handled = false;
+        visit_numeric(*lhs, [&](auto lhs_values) {
+            visit_numeric(*rhs, [&](auto rhs_values) {
+                calculate_columns(m_operator, lhs_values, lhs->is_constant, rhs_values, rhs->is_constant, size, m_result.floats);
+                handled = true;
+            });
+        });
+        if (!handled)
+            return nullptr;
+        break;
+    }
+    case Type::Logical: {
+        if (lhs->type != SQLType::Boolean || rhs->type != SQLType::Boolean)
+            return nullptr;
+        m_result.reset(SQLType::Boolean, result_size);
+        if (m_operator == BinaryOperator::And) {
+            for_each_row(lhs->booleans.span(), lhs->is_constant, rhs->booleans.span(), rhs->is_constant, size, [&](size_t ix, bool lhs_value, bool rhs_value) {
+                m_result.booleans[ix] = lhs_value && rhs_value;
+            });
+        } else {
+            for_each_row(lhs->booleans.span(), lhs->is_constant, rhs->booleans.span(), rhs->is_constant, size, [&](size_t ix, bool lhs_value, bool rhs_value) {
+                m_result.booleans[ix] = lhs_value || rhs_value;
+            });
+        }
+        break;
+    }
+    default:
+        VERIFY_NOT_REACHED();
+    }
+
+    m_result.is_constant = is_constant;
+    return &m_result;
+}
+
+OwnPtr<BatchFilter> BatchFilter::create(NonnullRefPtrVector<Expression> const& filters, TupleDescriptor const& descriptor, size_t& vectorized_filter_count)
+{
+    auto batch_filter = adopt_own(*new BatchFilter);
+
+    // NOTE: Filters are checked in order, and a row that fails one isn't checked against the next ones. Compiled
+    //       filters can't fail, but the others can, so only leading filters are compiled to keep errors the same.
+    for (auto const& filter : filters) {
+        auto expression = BatchExpression::compile(filter, descriptor, batch_filter->m_referenced_columns);
+        if (!expression)
+            break;
+        batch_filter->m_filters.append(expression.release_nonnull());
+    }
+
+    vectorized_filter_count = batch_filter->m_filters.size();
+    if (batch_filter->m_filters.is_empty())
+        return {};
+
+    batch_filter->m_columns.resize(descriptor.size());
+    return batch_filter;
+}
+
+bool BatchFilter::load_column(Span<Row const> rows, size_t column_index)
+{
+    auto const& first_value = rows[0][column_index];
+    if (first_value.is_null())
+        return false;
+
+    auto type = first_value.type();
+    auto& column = m_columns[column_index];
+    switch (type) {
+    case SQLType::Integer:
+    case SQLType::Float:
+    case SQLType::Boolean:
+    case SQLType::Text:
+        column.reset(type, rows.size());
+        break;
+    default:
+        return false;
+    }
+
+    for (size_t ix = 0; ix < rows.size(); ++ix) {
+        auto const& value = rows[ix][column_index];
+        if (value.is_null() || value.type() != type)
+            return false;
+
+        switch (type) {
+        case SQLType::Integer:
+            column.integers[ix] = value.to_int().value();
+            break;
+        case SQLType::Float:
+            column.floats[ix] = value.to_double().value();
+            break;
+        case SQLType::Boolean:
+            column.booleans[ix] = value.to_bool().value();
+            break;
+        case SQLType::Text:
+            column.texts[ix] = value.to_string();
+            break;
+        default:
+            VERIFY_NOT_REACHED();
+        }
+    }
+    return true;
+}
+
+bool BatchFilter::select(Span<Row const> rows, Vector<u16>& selection)
+{
+    VERIFY(!rows.is_empty() && rows.size() <= batch_size);
+    selection.clear_with_capacity();
+
+    for (auto column_index : m_referenced_columns) {
+        if (!load_column(rows, column_index))
+            return false;
+    }
+
+    Vector<ColumnVector const*, 8> results;
+    for (auto& filter : m_filters) {
+        auto const* result = filter.evaluate(m_columns, rows.size());
+        if (!result || result->type != SQLType::Boolean)
+            return false;
+        results.append(result);
+    }
+
+    for (size_t ix = 0; ix < rows.size(); ++ix) {
+        bool passes = true;
+        for (auto const* result : results)
+            passes &= result->booleans[result->is_constant ? 0 : ix];
+        if (passes)
+            selection.append(static_cast<u16>(ix));
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/NonnullOwnPtrVector.h>
+#include <AK/NonnullRefPtrVector.h>
+#include <AK/OwnPtr.h>
+#include <AK/Span.h>
+#include <AK/String.h>
+#include <AK/Vector.h>
+#include <LibSQL/AST/AST.h>
+#include <LibSQL/Forward.h>
+#include <LibSQL/Type.h>
+
+namespace SQL::AST {
+
+/**
+ * A ColumnVector holds the values of one column for every row of a batch,
+ * unboxed into a plain array of the type all of them share. Constants are
+ * stored once and apply to every row.
+ */
+struct ColumnVector {
+    SQLType type { SQLType::Null };
+    bool is_constant { false };
+
+    Vector<int> integers;
+    Vector<double> floats;
+    Vector<bool> booleans;
+    Vector<String> texts;
+
+    void reset(SQLType, size_t size);
+};
+
+/**
+ * A BatchExpression is an Expression compiled to be evaluated on a batch of
+ * rows at once, one column at a time, instead of on every row on its own.
+ *
+ * Only expressions that can't fail are compiled: column names, numeric and
+ * string literals, comparisons, arithmetic, and boolean operators. The types
+ * of their operands are only known once the values of a batch are seen, so a
+ * batch whose values aren't all of the same type in a column (including NULL),
+ * or whose types the kernels don't handle, can't be evaluated here. Callers
+ * then evaluate the original Expression on each of its rows instead, which
+ * gives the same results.
+ */
+class BatchExpression {
+public:
+    static OwnPtr<BatchExpression> compile(Expression const&, TupleDescriptor const&, Vector<size_t>& referenced_columns);
+
+    // Returns nullptr if the batch has values this expression can't be evaluated on.
+    ColumnVector const* evaluate(Vector<ColumnVector> const& columns, size_t size);
+
+private:
+    enum class Type {
+        Constant,
+        Column,
+        Comparison,
+        Arithmetic,
+        Logical,
+        Negation,
+        Not,
+    };
+
+    explicit BatchExpression(Type type)
+        : m_type(type)
+    {
+    }
+
+    static OwnPtr<BatchExpression> compile_operand(Expression const&, TupleDescriptor const&, Vector<size_t>& referenced_columns);
+
+    Type m_type;
+    BinaryOperator m_operator { BinaryOperator::Equals };
+    size_t m_column_index { 0 };
+    OwnPtr<BatchExpression> m_lhs;
+    OwnPtr<BatchExpression> m_rhs;
+
+    // Constants keep their value here, everything else the result of the last batch.
+    ColumnVector m_result;
+};
+
+/**
+ * A BatchFilter checks the leading filters of a list that can be compiled to
+ * BatchExpressions on the rows of a table, up to batch_size rows at a time.
+ */
+class BatchFilter {
+public:
+    static constexpr size_t batch_size = 1024;
+
+    // Returns nullptr if the first filter can't be compiled. Otherwise, `vectorized_filter_count` is set to the
+    // number of leading filters that were, and the remaining ones must still be checked row by row.
+    static OwnPtr<BatchFilter> create(NonnullRefPtrVector<Expression> const& filters, TupleDescriptor const&, size_t& vectorized_filter_count);
+
+    // Puts the indices of the rows that pass every compiled filter into `selection`. Returns false if the filters
+    // can't be evaluated on the values of these rows, and must be checked row by row instead.
+    bool select(Span<Row const> rows, Vector<u16>& selection);
+
+private:
+    BatchFilter() = default;
+
+    bool load_column(Span<Row const> rows, size_t column_index);
+
+    NonnullOwnPtrVector<BatchExpression> m_filters;
+    Vector<size_t> m_referenced_columns;
+    Vector<ColumnVector> m_columns;
+};
+
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ScopeGuard.h>
+#include <LibSQL/AST/AST.h>
+#include <LibSQL/Database.h>
+#include <LibSQL/Meta.h>
+
+namespace SQL::AST {
+
+ResultOr<ResultSet> CreateIndex::execute(ExecutionContext& context) const
+{
+    auto schema_name = m_schema_name.is_empty() ? String { "default"sv } : m_schema_name;
+
+    auto schema_def = TRY(context.database->get_schema(schema_name));
+    if (!schema_def)
+        return Result { SQLCommand::Create, SQLErrorCode::SchemaDoesNotExist, schema_name };
+
+    auto table_def = TRY(context.database->get_table(schema_name, m_table_name));
+    if (!table_def)
+        return Result { SQLCommand::Create, SQLErrorCode::TableDoesNotExist, m_table_name };
+
+    for (auto& index : table_def->indexes()) {
+        if (index.name() != m_index_name)
+            continue;
+        if (m_is_error_if_index_exists)
+            return Result { SQLCommand::Create, SQLErrorCode::IndexExists, m_index_name };
+        return ResultSet { SQLCommand::Create };
+    }
+
+    auto index_def = IndexDef::construct(table_def, m_index_name, m_is_unique);
+    ArmedScopeGuard remove_index_def = [&] {
+        index_def->remove_from_parent();
+    };
+
+    for (auto& column : m_columns) {
+        Optional<SQLType> type;
+        for (auto& column_def : table_def->columns()) {
+            if (column_def.name() == column.column_name())
+                type = column_def.type();
+        }
+        if (!type.has_value())
+            return Result { SQLCommand::Create, SQLErrorCode::ColumnDoesNotExist, column.column_name() };
+
+        index_def->append_column(column.column_name(), *type, column.order());
+    }
+
+    TRY(context.database->add_index(*index_def));
+    remove_index_def.disarm();
+    return ResultSet { SQLCommand::Create };
+}
+
+}
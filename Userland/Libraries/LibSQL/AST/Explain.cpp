@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibSQL/AST/AST.h>
+#include <LibSQL/AST/QueryPlan.h>
+#include <LibSQL/ResultSet.h>
+
+namespace SQL::AST {
+
+ResultOr<ResultSet> Explain::execute(ExecutionContext& context) const
+{
+    auto plan = TRY(QueryPlan::create(context, *m_select_statement));
+
+    auto descriptor = adopt_ref(*new TupleDescriptor);
+    descriptor->append({ "", "", "detail", SQLType::Text });
+
+    ResultSet result { SQLCommand::Explain };
+    auto lines = plan.describe();
+    TRY(result.try_ensure_capacity(lines.size()));
+
+    for (auto& line : lines) {
+        Tuple tuple(descriptor);
+        tuple[0] = line;
+
+        result.insert_row(tuple, Tuple {});
+    }
+
+    return result;
+}
+
+}
@@ -41,6 +41,8 @@ NonnullRefPtr<Statement> Parser::parse_statement()
         consume();
         if (match(TokenType::Schema))
             return parse_create_schema_statement();
+        else if (match(TokenType::Unique) || match(TokenType::Index))
+            return parse_create_index_statement();
         else
             return parse_create_table_statement();
     case TokenType::Alter:
@@ -57,8 +59,10 @@ NonnullRefPtr<Statement> Parser::parse_statement()
         return parse_delete_statement({});
     case TokenType::Select:
         return parse_select_statement({});
+    case TokenType::Explain:
+        return parse_explain_statement();
     default:
-        expected("CREATE, ALTER, DROP, DESCRIBE, INSERT, UPDATE, DELETE, or SELECT"sv);
+        expected("CREATE, ALTER, DROP, DESCRIBE, INSERT, UPDATE, DELETE, SELECT, or EXPLAIN"sv);
         return create_ast_node<ErrorStatement>();
     }
 }
@@ -129,6 +133,35 @@ NonnullRefPtr<CreateTable> Parser::parse_create_table_statement()
     return create_ast_node<CreateTable>(move(schema_name), move(table_name), move(column_definitions), is_temporary, is_error_if_table_exists);
 }
 
+NonnullRefPtr<CreateIndex> Parser::parse_create_index_statement()
+{
+    // https://sqlite.org/lang_createindex.html
+
+    bool is_unique = consume_if(TokenType::Unique);
+    consume(TokenType::Index);
+
+    bool is_error_if_index_exists = true;
+    if (consume_if(TokenType::If)) {
+        consume(TokenType::Not);
+        consume(TokenType::Exists);
+        is_error_if_index_exists = false;
+    }
+
+    String schema_name;
+    String index_name;
+    parse_schema_and_table_name(schema_name, index_name);
+
+    consume(TokenType::On);
+    String table_name = consume(TokenType::Identifier).value();
+
+    NonnullRefPtrVector<IndexedColumn> indexed_columns;
+    parse_comma_separated_list(true, [&]() { indexed_columns.append(parse_indexed_column()); });
+
+    // FIXME: Parse "WHERE expr" for partial indexes.
+
+    return create_ast_node<CreateIndex>(move(schema_name), move(index_name), move(table_name), move(indexed_columns), is_unique, is_error_if_index_exists);
+}
+
 NonnullRefPtr<AlterTable> Parser::parse_alter_table_statement()
 {
     // https://sqlite.org/lang_altertable.html
@@ -194,6 +227,19 @@ NonnullRefPtr<DescribeTable> Parser::parse_describe_table_statement()
     return create_ast_node<DescribeTable>(move(table_name));
 }
 
+NonnullRefPtr<Explain> Parser::parse_explain_statement()
+{
+    // https://sqlite.org/lang_explain.html
+    consume(TokenType::Explain);
+
+    // NOTE: We only know how to explain the plan of a query, so QUERY PLAN is optional.
+    if (consume_if(TokenType::Query))
+        consume(TokenType::Plan);
+
+    auto select_statement = parse_select_statement({});
+    return create_ast_node<Explain>(move(select_statement));
+}
+
 NonnullRefPtr<Insert> Parser::parse_insert_statement(RefPtr<CommonTableExpressionList> common_table_expression_list)
 {
     // https://sqlite.org/lang_insert.html
@@ -1053,6 +1099,19 @@ NonnullRefPtr<OrderingTerm> Parser::parse_ordering_term()
     return create_ast_node<OrderingTerm>(move(expression), move(collation_name), order, nulls);
 }
 
+NonnullRefPtr<IndexedColumn> Parser::parse_indexed_column()
+{
+    // https://sqlite.org/syntax/indexed-column.html
+    String column_name = consume(TokenType::Identifier).value();
+
+    // FIXME: Parse "COLLATE collation-name".
+
+    Order order = consume_if(TokenType::Desc) ? Order::Descending : Order::Ascending;
+    consume_if(TokenType::Asc); // ASC is the default, so ignore it if specified.
+
+    return create_ast_node<IndexedColumn>(move(column_name), order);
+}
+
 void Parser::parse_schema_and_table_name(String& schema_name, String& table_name)
 {
     String schema_or_table_name = consume(TokenType::Identifier).value();
@@ -0,0 +1,721 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/StringBuilder.h>
+#include <AK/TemporaryChange.h>
+#include <AK/TypeCasts.h>
+#include <LibSQL/AST/BatchExpression.h>
+#include <LibSQL/AST/QueryPlan.h>
+#include <LibSQL/Database.h>
+#include <LibSQL/Key.h>
+#include <LibSQL/Meta.h>
+#include <LibSQL/Row.h>
+#include <LibSQL/Tuple.h>
+
+namespace SQL::AST {
+
+// NOTE: These stand in for the statistics we don't have, and are roughly what SQLite assumes without ANALYZE.
+static constexpr double s_estimated_table_rows = 1'000'000;
+static constexpr double s_estimated_rows_per_key = 10;
+static constexpr double s_equality_selectivity = 0.1;
+static constexpr double s_range_selectivity = 0.25;
+static constexpr double s_other_selectivity = 0.5;
+static constexpr double s_index_lookup_cost = 2;
+
+using TableMask = u64;
+
+namespace {
+
+// A comparison between a column and an expression that doesn't refer to the table of that column,
+// turned around if needed so that the column is on the left hand side.
+struct ColumnComparison {
+    size_t table_index { 0 };
+    String column_name;
+    BinaryOperator comparison { BinaryOperator::Equals };
+    NonnullRefPtr<Expression> value;
+    TableMask value_tables { 0 };
+};
+
+struct Term {
+    NonnullRefPtr<Expression> expression;
+    TableMask tables { 0 };
+    Vector<ColumnComparison> comparisons {};
+};
+
+struct AccessPath {
+    RefPtr<IndexDef> index;
+    NonnullRefPtrVector<Expression> equalities {};
+    Optional<QueryPlan::Bound> lower_bound {};
+    Optional<QueryPlan::Bound> upper_bound {};
+    Vector<size_t> used_terms {};
+    bool is_correlated { false };
+    double fetched_rows { s_estimated_table_rows };
+};
+
+struct JoinOrder {
+    Vector<size_t> table_indices {};
+    Vector<AccessPath> paths {};
+    double cost { 0 };
+};
+
+}
+
+static TableMask table_bit(size_t table_index)
+{
+    return static_cast<TableMask>(1) << table_index;
+}
+
+static bool is_comparison(BinaryOperator type)
+{
+    switch (type) {
+    case BinaryOperator::LessThan:
+    case BinaryOperator::LessThanEquals:
+    case BinaryOperator::GreaterThan:
+    case BinaryOperator::GreaterThanEquals:
+    case BinaryOperator::Equals:
+    case BinaryOperator::NotEquals:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static BinaryOperator flip_comparison(BinaryOperator type)
+{
+    switch (type) {
+    case BinaryOperator::LessThan:
+        return BinaryOperator::GreaterThan;
+    case BinaryOperator::LessThanEquals:
+        return BinaryOperator::GreaterThanEquals;
+    case BinaryOperator::GreaterThan:
+        return BinaryOperator::LessThan;
+    case BinaryOperator::GreaterThanEquals:
+        return BinaryOperator::LessThanEquals;
+    default:
+        return type;
+    }
+}
+
+// NOTE: An expression in parentheses is a chained expression with a single element, which converts to a
+//       boolean and compares just like that element does.
+static NonnullRefPtr<Expression> unwrap_parentheses(NonnullRefPtr<Expression> const& expression)
+{
+    if (is<ChainedExpression>(*expression)) {
+        auto const& chained_expression = static_cast<ChainedExpression const&>(*expression);
+        if (chained_expression.expressions().size() == 1)
+            return unwrap_parentheses(chained_expression.expressions().ptr_at(0));
+    }
+    return expression;
+}
+
+// Returns whether the expression always evaluates to a boolean (or fails).
+static bool is_predicate(NonnullRefPtr<Expression> const& expression)
+{
+    auto unwrapped_expression = unwrap_parentheses(expression);
+    if (is<MatchExpression>(*unwrapped_expression))
+        return true;
+    if (!is<BinaryOperatorExpression>(*unwrapped_expression))
+        return false;
+
+    auto type = static_cast<BinaryOperatorExpression const&>(*unwrapped_expression).type();
+    return is_comparison(type) || type == BinaryOperator::And || type == BinaryOperator::Or;
+}
+
+// NOTE: Both sides of an AND are always evaluated, so a row passes the conjunction of two predicates
+//       exactly if it passes both of them on their own.
+static void split_conjunction(NonnullRefPtr<Expression> const& expression, NonnullRefPtrVector<Expression>& terms)
+{
+    auto unwrapped_expression = unwrap_parentheses(expression);
+    if (is<BinaryOperatorExpression>(*unwrapped_expression)) {
+        auto const& binary_expression = static_cast<BinaryOperatorExpression const&>(*unwrapped_expression);
+        if (binary_expression.type() == BinaryOperator::And && is_predicate(binary_expression.lhs()) && is_predicate(binary_expression.rhs())) {
+            split_conjunction(binary_expression.lhs(), terms);
+            split_conjunction(binary_expression.rhs(), terms);
+            return;
+        }
+    }
+    terms.append(move(unwrapped_expression));
+}
+
+static Optional<size_t> resolve_column(NonnullRefPtrVector<TableDef> const& tables, ColumnNameExpression const& column_name_expression)
+{
+    Optional<size_t> table_index;
+    for (size_t ix = 0; ix < tables.size(); ++ix) {
+        auto const& table = tables[ix];
+        if (!column_name_expression.table_name().is_empty() && table.name() != column_name_expression.table_name())
+            continue;
+        for (auto const& column : table.columns()) {
+            if (column.name() != column_name_expression.column_name())
+                continue;
+            if (table_index.has_value())
+                return {};
+            table_index = ix;
+        }
+    }
+    return table_index;
+}
+
+// Returns the tables whose columns the expression refers to, or nothing if it refers to columns that don't
+// exist or are ambiguous, or if we don't know how to evaluate it. Terms like that are left to fail at runtime.
+static Optional<TableMask> tables_referenced_by(NonnullRefPtrVector<TableDef> const& tables, Expression const& expression)
+{
+    if (is<NumericLiteral>(expression) || is<StringLiteral>(expression) || is<NullLiteral>(expression))
+        return 0;
+
+    if (is<ColumnNameExpression>(expression)) {
+        auto table_index = resolve_column(tables, static_cast<ColumnNameExpression const&>(expression));
+        if (!table_index.has_value())
+            return {};
+        return table_bit(*table_index);
+    }
+
+    if (is<NestedExpression>(expression))
+        return tables_referenced_by(tables, *static_cast<NestedExpression const&>(expression).expression());
+
+    if (is<BinaryOperatorExpression>(expression) || is<MatchExpression>(expression)) {
+        auto const& nested_expression = static_cast<NestedDoubleExpression const&>(expression);
+        auto lhs_tables = tables_referenced_by(tables, *nested_expression.lhs());
+        auto rhs_tables = tables_referenced_by(tables, *nested_expression.rhs());
+        if (!lhs_tables.has_value() || !rhs_tables.has_value())
+            return {};
+
+        auto referenced_tables = *lhs_tables | *rhs_tables;
+        if (is<MatchExpression>(expression)) {
+            if (auto const& escape = static_cast<MatchExpression const&>(expression).escape()) {
+                auto escape_tables = tables_referenced_by(tables, *escape);
+                if (!escape_tables.has_value())
+                    return {};
+                referenced_tables |= *escape_tables;
+            }
+        }
+        return referenced_tables;
+    }
+
+    if (is<ChainedExpression>(expression)) {
+        TableMask referenced_tables = 0;
+        for (auto const& element : static_cast<ChainedExpression const&>(expression).expressions()) {
+            auto element_tables = tables_referenced_by(tables, element);
+            if (!element_tables.has_value())
+                return {};
+            referenced_tables |= *element_tables;
+        }
+        return referenced_tables;
+    }
+
+    return {};
+}
+
+static void find_column_comparisons(NonnullRefPtrVector<TableDef> const& tables, Term& term)
+{
+    if (!is<BinaryOperatorExpression>(*term.expression))
+        return;
+    auto const& binary_expression = static_cast<BinaryOperatorExpression const&>(*term.expression);
+    if (!is_comparison(binary_expression.type()))
+        return;
+
+    auto add_comparison = [&](NonnullRefPtr<Expression> const& column, NonnullRefPtr<Expression> const& value, BinaryOperator comparison) {
+        if (!is<ColumnNameExpression>(*column))
+            return;
+        auto const& column_name_expression = static_cast<ColumnNameExpression const&>(*column);
+        auto table_index = resolve_column(tables, column_name_expression);
+        auto value_tables = tables_referenced_by(tables, *value);
+        if (!table_index.has_value() || !value_tables.has_value() || (*value_tables & table_bit(*table_index)))
+            return;
+        term.comparisons.append({ *table_index, column_name_expression.column_name(), comparison, value, *value_tables });
+    };
+
+    add_comparison(binary_expression.lhs(), binary_expression.rhs(), binary_expression.type());
+    add_comparison(binary_expression.rhs(), binary_expression.lhs(), flip_comparison(binary_expression.type()));
+}
+
+static double selectivity(Term const& term)
+{
+    if (term.comparisons.is_empty())
+        return s_other_selectivity;
+
+    switch (term.comparisons.first().comparison) {
+    case BinaryOperator::Equals:
+        return s_equality_selectivity;
+    case BinaryOperator::LessThan:
+    case BinaryOperator::LessThanEquals:
+    case BinaryOperator::GreaterThan:
+    case BinaryOperator::GreaterThanEquals:
+        return s_range_selectivity;
+    default:
+        return s_other_selectivity;
+    }
+}
+
+// Finds the terms that let us search the table through the index, given the tables that are joined before it:
+// equalities for as many leading parts of the key as possible, and then bounds for the part after those.
+static Optional<AccessPath> index_access_path(NonnullRefPtr<IndexDef> const& index, size_t table_index, TableMask joined_tables, Vector<Term> const& terms)
+{
+    AccessPath path { .index = index };
+    auto const& key_parts = index->key_definition();
+
+    auto for_each_usable_comparison = [&](String const& column_name, auto callback) {
+        for (size_t term_index = 0; term_index < terms.size(); ++term_index) {
+            for (auto const& comparison : terms[term_index].comparisons) {
+                if (comparison.table_index != table_index || comparison.column_name != column_name)
+                    continue;
+                if (comparison.value_tables & ~joined_tables)
+                    continue;
+                if (callback(term_index, comparison) == IterationDecision::Break)
+                    return;
+            }
+        }
+    };
+
+    auto use_comparison = [&](size_t term_index, ColumnComparison const& comparison) {
+        path.used_terms.append(term_index);
+        if (comparison.value_tables)
+            path.is_correlated = true;
+    };
+
+    size_t part_index = 0;
+    for (; part_index < key_parts.size(); ++part_index) {
+        bool found_equality = false;
+        for_each_usable_comparison(key_parts[part_index].name(), [&](size_t term_index, ColumnComparison const& comparison) {
+            if (comparison.comparison != BinaryOperator::Equals)
+                return IterationDecision::Continue;
+            path.equalities.append(comparison.value);
+            use_comparison(term_index, comparison);
+            found_equality = true;
+            return IterationDecision::Break;
+        });
+        if (!found_equality)
+            break;
+    }
+
+    if (part_index < key_parts.size()) {
+        for_each_usable_comparison(key_parts[part_index].name(), [&](size_t term_index, ColumnComparison const& comparison) {
+            switch (comparison.comparison) {
+            case BinaryOperator::GreaterThan:
+            case BinaryOperator::GreaterThanEquals:
+                if (path.lower_bound.has_value())
+                    break;
+                path.lower_bound = QueryPlan::Bound { comparison.value, comparison.comparison == BinaryOperator::GreaterThanEquals };
+                use_comparison(term_index, comparison);
+                break;
+            case BinaryOperator::LessThan:
+            case BinaryOperator::LessThanEquals:
+                if (path.upper_bound.has_value())
+                    break;
+                path.upper_bound = QueryPlan::Bound { comparison.value, comparison.comparison == BinaryOperator::LessThanEquals };
+                use_comparison(term_index, comparison);
+                break;
+            default:
+                break;
+            }
+            return IterationDecision::Continue;
+        });
+    }
+
+    if (path.equalities.is_empty() && !path.lower_bound.has_value() && !path.upper_bound.has_value())
+        return {};
+
+    if (index->unique() && path.equalities.size() == key_parts.size()) {
+        path.fetched_rows = 1;
+    } else if (!path.equalities.is_empty()) {
+        path.fetched_rows = s_estimated_rows_per_key;
+        for (size_t ix = 1; ix < path.equalities.size(); ++ix)
+            path.fetched_rows /= 2;
+    }
+    if (path.lower_bound.has_value())
+        path.fetched_rows *= s_range_selectivity;
+    if (path.upper_bound.has_value())
+        path.fetched_rows *= s_range_selectivity;
+    path.fetched_rows = max(path.fetched_rows, 1.0);
+    return path;
+}
+
+// Joins the tables one after the other, starting with the given one and then always picking the table that
+// is cheapest to join next.
+static JoinOrder greedy_join_order(NonnullRefPtrVector<TableDef> const& tables, Vector<Term> const& terms, size_t first_table_index)
+{
+    JoinOrder join_order;
+    TableMask joined_tables = 0;
+    double joined_rows = 1;
+    while (join_order.table_indices.size() < tables.size()) {
+        Optional<size_t> best_table_index;
+        AccessPath best_path;
+        double best_cost = 0;
+        double best_joined_rows = 0;
+
+        for (size_t table_index = 0; table_index < tables.size(); ++table_index) {
+            if (joined_tables & table_bit(table_index))
+                continue;
+            if (joined_tables == 0 && table_index != first_table_index)
+                continue;
+
+            Vector<AccessPath> paths;
+            paths.append({});
+            auto const& indexes = tables[table_index].indexes();
+            for (size_t ix = 0; ix < indexes.size(); ++ix) {
+                if (auto path = index_access_path(indexes.ptr_at(ix), table_index, joined_tables, terms); path.has_value())
+                    paths.append(path.release_value());
+            }
+
+            auto tables_after_join = joined_tables | table_bit(table_index);
+            for (auto const& path : paths) {
+                double table_rows = path.fetched_rows;
+                double rows_after_join = joined_rows * path.fetched_rows;
+                for (size_t term_index = 0; term_index < terms.size(); ++term_index) {
+                    auto const& term = terms[term_index];
+                    if (!(term.tables & table_bit(table_index)) || (term.tables & ~tables_after_join))
+                        continue;
+                    if (path.used_terms.contains_slow(term_index))
+                        continue;
+                    if (term.tables == table_bit(table_index))
+                        table_rows *= selectivity(term);
+                    rows_after_join *= selectivity(term);
+                }
+
+                double fetch_cost = path.index ? path.fetched_rows * s_index_lookup_cost : s_estimated_table_rows;
+                if (path.is_correlated)
+                    fetch_cost *= joined_rows;
+                double cost = fetch_cost + joined_rows * table_rows;
+                if (!best_table_index.has_value() || cost < best_cost) {
+                    best_table_index = table_index;
+                    best_path = path;
+                    best_cost = cost;
+                    best_joined_rows = rows_after_join;
+                }
+            }
+        }
+
+        join_order.table_indices.append(*best_table_index);
+        join_order.paths.append(move(best_path));
+        join_order.cost += best_cost;
+        joined_tables |= table_bit(*best_table_index);
+        joined_rows = max(best_joined_rows, 1.0);
+    }
+    return join_order;
+}
+
+ResultOr<QueryPlan> QueryPlan::create(ExecutionContext& context, Select const& select)
+{
+    NonnullRefPtrVector<TableDef> tables;
+    for (auto const& table_descriptor : select.table_or_subquery_list()) {
+        if (!table_descriptor.is_table())
+            return Result { SQLCommand::Select, SQLErrorCode::NotYetImplemented, "Sub-selects are not yet implemented"sv };
+
+        auto table_def = TRY(context.database->get_table(table_descriptor.schema_name(), table_descriptor.table_name()));
+        if (!table_def)
+            return Result { SQLCommand::Select, SQLErrorCode::TableDoesNotExist, table_descriptor.table_name() };
+        if (table_def->num_columns() == 0)
+            continue;
+        tables.append(table_def.release_nonnull());
+    }
+
+    QueryPlan plan;
+    Vector<Term> terms;
+    bool can_split_where_clause = tables.size() <= sizeof(TableMask) * 8;
+    if (auto const& where_clause = select.where_clause(); where_clause && can_split_where_clause) {
+        NonnullRefPtrVector<Expression> expressions;
+        split_conjunction(*where_clause, expressions);
+        for (auto const& expression : expressions) {
+            auto referenced_tables = tables_referenced_by(tables, expression);
+            if (!referenced_tables.has_value()) {
+                can_split_where_clause = false;
+                break;
+            }
+            Term term { .expression = expression, .tables = *referenced_tables };
+            find_column_comparisons(tables, term);
+            terms.append(move(term));
+        }
+    }
+
+    if (!can_split_where_clause) {
+        for (size_t ix = 0; ix < tables.size(); ++ix)
+            plan.m_steps.append({ .table = tables.ptr_at(ix) });
+        if (auto const& where_clause = select.where_clause())
+            plan.m_residual_filters.append(*where_clause);
+        return plan;
+    }
+
+    // Greedily pick the table that is cheapest to join next, until all of them are joined. Tables that are cheap
+    // to search once other ones are joined tend to look like any other table before that, so every table is
+    // tried as the first one and the join order that is cheapest overall wins.
+    Optional<JoinOrder> best_join_order;
+    for (size_t first_table_index = 0; first_table_index < tables.size(); ++first_table_index) {
+        auto join_order = greedy_join_order(tables, terms, first_table_index);
+        if (!best_join_order.has_value() || join_order.cost < best_join_order->cost)
+            best_join_order = move(join_order);
+    }
+
+    Vector<size_t> join_order;
+    if (best_join_order.has_value()) {
+        join_order = move(best_join_order->table_indices);
+        for (size_t ix = 0; ix < join_order.size(); ++ix) {
+            auto const& path = best_join_order->paths[ix];
+            plan.m_steps.append({
+                .table = tables.ptr_at(join_order[ix]),
+                .index = path.index,
+                .equalities = path.equalities,
+                .lower_bound = path.lower_bound,
+                .upper_bound = path.upper_bound,
+                .is_correlated = path.is_correlated,
+            });
+        }
+    }
+
+    // Check every term as soon as all the tables it refers to are joined. The terms used to search an index are
+    // checked as well, since the index search may return rows that the comparison doesn't let through.
+    for (auto const& term : terms) {
+        if (plan.m_steps.is_empty()) {
+            plan.m_residual_filters.append(term.expression);
+            continue;
+        }
+
+        TableMask tables_up_to_step = 0;
+        for (size_t step_index = 0; step_index < plan.m_steps.size(); ++step_index) {
+            auto step_table = table_bit(join_order[step_index]);
+            tables_up_to_step |= step_table;
+            if (term.tables & ~tables_up_to_step)
+                continue;
+
+            auto& step = plan.m_steps[step_index];
+            if (term.tables & ~step_table)
+                step.join_filters.append(term.expression);
+            else
+                step.table_filters.append(term.expression);
+            break;
+        }
+    }
+
+    return plan;
+}
+
+Vector<String> QueryPlan::describe() const
+{
+    Vector<String> lines;
+    for (auto const& step : m_steps) {
+        StringBuilder builder;
+        builder.appendff("{} TABLE {}.{}", step.index ? "SEARCH"sv : "SCAN"sv, step.table->parent()->name(), step.table->name());
+
+        if (step.index) {
+            auto const& key_parts = step.index->key_definition();
+            Vector<String> constraints;
+            for (size_t ix = 0; ix < step.equalities.size(); ++ix)
+                constraints.append(String::formatted("{}=?", key_parts[ix].name()));
+            if (step.lower_bound.has_value())
+                constraints.append(String::formatted("{}>{}?", key_parts[step.equalities.size()].name(), step.lower_bound->inclusive ? "="sv : ""sv));
+            if (step.upper_bound.has_value())
+                constraints.append(String::formatted("{}<{}?", key_parts[step.equalities.size()].name(), step.upper_bound->inclusive ? "="sv : ""sv));
+
+            builder.appendff(" USING INDEX {} (", step.index->name());
+            builder.join(" AND "sv, constraints);
+            builder.append(')');
+        }
+
+        lines.append(builder.to_string());
+    }
+    return lines;
+}
+
+static ResultOr<bool> passes_filters(ExecutionContext& context, NonnullRefPtrVector<Expression> const& filters, Tuple& row)
+{
+    context.current_row = &row;
+    for (auto const& filter : filters) {
+        auto result = TRY(filter.evaluate(context)).to_bool();
+        if (!result.has_value() || !result.value())
+            return false;
+    }
+    return true;
+}
+
+// NOTE: Keys are only ordered consistently between values of compatible types, so we don't search an index
+//       for anything else. NULL never compares equal to anything, but orders before everything.
+static bool can_search_index_for(Value const& value, KeyPartDef const& key_part)
+{
+    if (value.is_null())
+        return false;
+
+    switch (key_part.type()) {
+    case SQLType::Text:
+        return value.type() == SQLType::Text;
+    case SQLType::Integer:
+    case SQLType::Float:
+        return value.type() == SQLType::Integer || value.type() == SQLType::Float;
+    default:
+        return false;
+    }
+}
+
+ResultOr<Vector<Tuple>> QueryPlan::fetch_rows(ExecutionContext& context, Step const& step, Tuple& outer_row) const
+{
+    Vector<Row> rows;
+    bool searched_index = false;
+
+    if (step.index) {
+        TemporaryChange current_row_change { context.current_row, &outer_row };
+        auto const& key_parts = step.index->key_definition();
+        bool can_search_index = true;
+
+        Vector<Value> equalities;
+        for (size_t ix = 0; ix < step.equalities.size(); ++ix) {
+            equalities.append(TRY(step.equalities[ix].evaluate(context)));
+            can_search_index &= can_search_index_for(equalities.last(), key_parts[ix]);
+        }
+
+        auto evaluate_bound = [&](Optional<Bound> const& bound) -> ResultOr<Optional<Value>> {
+            if (!bound.has_value())
+                return Optional<Value> {};
+            auto value = TRY(bound->expression->evaluate(context));
+            can_search_index &= can_search_index_for(value, key_parts[equalities.size()]);
+            return Optional<Value> { move(value) };
+        };
+        auto lower_bound = TRY(evaluate_bound(step.lower_bound));
+        auto upper_bound = TRY(evaluate_bound(step.upper_bound));
+
+        if (can_search_index) {
+            // Tells whether a key of the index is before, in, or after the range of keys we're looking for.
+            auto compare = [&](Key const& key) {
+                auto in_key_order = [&](size_t part_index, int result) {
+                    return key_parts[part_index].sort_order() == Order::Descending ? -result : result;
+                };
+
+                for (size_t ix = 0; ix < equalities.size(); ++ix) {
+                    if (auto result = key[ix].compare(equalities[ix]); result != 0)
+                        return in_key_order(ix, result);
+                }
+
+                if (!lower_bound.has_value() && !upper_bound.has_value())
+                    return 0;
+
+                auto const& value = key[equalities.size()];
+                if (lower_bound.has_value()) {
+                    auto result = value.compare(*lower_bound);
+                    if (result < 0 || (result == 0 && !step.lower_bound->inclusive))
+                        return in_key_order(equalities.size(), -1);
+                }
+                if (upper_bound.has_value()) {
+                    auto result = value.compare(*upper_bound);
+                    if (result > 0 || (result == 0 && !step.upper_bound->inclusive))
+                        return in_key_order(equalities.size(), 1);
+                }
+                return 0;
+            };
+
+            rows = TRY(context.database->select_range(*step.index, move(compare)));
+            searched_index = true;
+        }
+    }
+
+    if (!searched_index)
+        rows = TRY(context.database->select_all(*step.table));
+
+    // NOTE: Rows read from the heap don't know the table their columns belong to, but column names in
+    //       expressions may be qualified with it.
+    auto descriptor = step.table->to_tuple_descriptor();
+    Vector<Tuple> result;
+    auto to_tuple = [&](Row const& row) {
+        Tuple tuple(descriptor);
+        for (size_t ix = 0; ix < row.size(); ++ix)
+            tuple[ix] = row[ix];
+        return tuple;
+    };
+
+    // Filters are checked on a batch of rows at a time where possible, falling back to checking them row by row
+    // for batches with values they can't be evaluated on.
+    size_t vectorized_filter_count = 0;
+    auto batch_filter = BatchFilter::create(step.table_filters, descriptor, vectorized_filter_count);
+    if (!batch_filter) {
+        for (auto const& row : rows) {
+            auto tuple = to_tuple(row);
+            if (TRY(passes_filters(context, step.table_filters, tuple)))
+                result.append(move(tuple));
+        }
+        return result;
+    }
+
+    NonnullRefPtrVector<Expression> remaining_filters;
+    for (size_t ix = vectorized_filter_count; ix < step.table_filters.size(); ++ix)
+        remaining_filters.append(step.table_filters[ix]);
+
+    Vector<u16> selection;
+    for (size_t batch_start = 0; batch_start < rows.size(); batch_start += BatchFilter::batch_size) {
+        auto batch = rows.span().slice(batch_start, min(BatchFilter::batch_size, rows.size() - batch_start));
+        if (!batch_filter->select(batch, selection)) {
+            for (auto const& row : batch) {
+                auto tuple = to_tuple(row);
+                if (TRY(passes_filters(context, step.table_filters, tuple)))
+                    result.append(move(tuple));
+            }
+            continue;
+        }
+
+        for (auto row_index : selection) {
+            auto tuple = to_tuple(batch[row_index]);
+            if (TRY(passes_filters(context, remaining_filters, tuple)))
+                result.append(move(tuple));
+        }
+    }
+    return result;
+}
+
+ResultOr<void> QueryPlan::join_rows(ExecutionContext& context, size_t step_index, Tuple& outer_row, Vector<NonnullRefPtr<TupleDescriptor>> const& descriptors, Vector<Optional<Vector<Tuple>>>& cached_rows, Function<ResultOr<void>(Tuple&)> const& callback) const
+{
+    if (step_index == m_steps.size()) {
+        if (!TRY(passes_filters(context, m_residual_filters, outer_row)))
+            return {};
+        context.current_row = &outer_row;
+        return callback(outer_row);
+    }
+
+    auto const& step = m_steps[step_index];
+    Vector<Tuple> correlated_rows;
+    Vector<Tuple> const* rows = nullptr;
+    if (step.is_correlated) {
+        correlated_rows = TRY(fetch_rows(context, step, outer_row));
+        rows = &correlated_rows;
+    } else {
+        if (!cached_rows[step_index].has_value())
+            cached_rows[step_index] = TRY(fetch_rows(context, step, outer_row));
+        rows = &cached_rows[step_index].value();
+    }
+
+    for (auto const& row : *rows) {
+        Tuple joined_row(descriptors[step_index + 1]);
+        for (size_t ix = 0; ix < outer_row.size(); ++ix)
+            joined_row[ix] = outer_row[ix];
+        for (size_t ix = 0; ix < row.size(); ++ix)
+            joined_row[outer_row.size() + ix] = row[ix];
+
+        if (!TRY(passes_filters(context, step.join_filters, joined_row)))
+            continue;
+        TRY(join_rows(context, step_index + 1, joined_row, descriptors, cached_rows, callback));
+    }
+    return {};
+}
+
+ResultOr<void> QueryPlan::for_each_row(ExecutionContext& context, Function<ResultOr<void>(Tuple&)> const& callback) const
+{
+    TemporaryChange current_row_change { context.current_row, static_cast<Tuple*>(nullptr) };
+
+    // The combined rows after each step consist of a single "unity" column, followed by the columns of
+    // the tables joined so far.
+    Vector<NonnullRefPtr<TupleDescriptor>> descriptors;
+    auto unity_descriptor = adopt_ref(*new TupleDescriptor);
+    unity_descriptor->empend("__unity__"sv);
+    descriptors.append(unity_descriptor);
+    for (auto const& step : m_steps) {
+        auto descriptor = adopt_ref(*new TupleDescriptor);
+        descriptor->extend(descriptors.last());
+        descriptor->extend(step.table->to_tuple_descriptor());
+        descriptors.append(move(descriptor));
+    }
+
+    Tuple unity_row(unity_descriptor);
+    unity_row[0] = Value { true };
+
+    Vector<Optional<Vector<Tuple>>> cached_rows;
+    cached_rows.resize(m_steps.size());
+    return join_rows(context, 0, unity_row, descriptors, cached_rows, callback);
+}
+
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Function.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/NonnullRefPtrVector.h>
+#include <AK/Optional.h>
+#include <AK/RefPtr.h>
+#include <AK/String.h>
+#include <AK/Vector.h>
+#include <LibSQL/AST/AST.h>
+#include <LibSQL/Forward.h>
+#include <LibSQL/Meta.h>
+#include <LibSQL/Result.h>
+
+namespace SQL::AST {
+
+/**
+ * A QueryPlan describes how the rows a SELECT statement looks at are produced:
+ * the order in which the tables of its FROM clause are joined, whether each of
+ * them is scanned or searched through one of its indexes, and at which point
+ * of the join each term of the WHERE clause is checked.
+ *
+ * There are no statistics about the contents of tables, so the plan is chosen
+ * using fixed estimates of how many rows a table has and how many of them
+ * each kind of term lets through.
+ */
+class QueryPlan {
+public:
+    struct Bound {
+        NonnullRefPtr<Expression> expression;
+        bool inclusive { false };
+    };
+
+    struct Step {
+        NonnullRefPtr<TableDef> table;
+
+        // If set, the table is searched through this index for the keys whose leading
+        // parts are equal to the equalities, and whose next part is within the bounds.
+        RefPtr<IndexDef> index {};
+        NonnullRefPtrVector<Expression> equalities {};
+        Optional<Bound> lower_bound {};
+        Optional<Bound> upper_bound {};
+
+        // Terms of the WHERE clause that only refer to this table are checked before its rows
+        // are joined with the ones of the previous steps, the other ones right after that.
+        NonnullRefPtrVector<Expression> table_filters {};
+        NonnullRefPtrVector<Expression> join_filters {};
+
+        // Whether the index search depends on the columns of previous steps, so that it has
+        // to be done again for every row they produce.
+        bool is_correlated { false };
+    };
+
+    static ResultOr<QueryPlan> create(ExecutionContext&, Select const&);
+
+    Vector<Step> const& steps() const { return m_steps; }
+    Vector<String> describe() const;
+
+    // Calls the callback for every combination of rows of the tables that passes the WHERE clause.
+    // The combined row is the current row of the context while the callback runs.
+    ResultOr<void> for_each_row(ExecutionContext&, Function<ResultOr<void>(Tuple&)> const&) const;
+
+private:
+    QueryPlan() = default;
+
+    ResultOr<Vector<Tuple>> fetch_rows(ExecutionContext&, Step const&, Tuple& outer_row) const;
+    ResultOr<void> join_rows(ExecutionContext&, size_t step_index, Tuple& outer_row, Vector<NonnullRefPtr<TupleDescriptor>> const&, Vector<Optional<Vector<Tuple>>>& cached_rows, Function<ResultOr<void>(Tuple&)> const&) const;
+
+    Vector<Step> m_steps;
+
+    // Used when the WHERE clause can't be split up, checked on the rows of the complete join.
+    NonnullRefPtrVector<Expression> m_residual_filters;
+};
+
+}
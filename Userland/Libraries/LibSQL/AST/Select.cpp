@@ -6,6 +6,7 @@
 
 #include <AK/NumericLimits.h>
 #include <LibSQL/AST/AST.h>
+#include <LibSQL/AST/QueryPlan.h>
 #include <LibSQL/Database.h>
 #include <LibSQL/Meta.h>
 #include <LibSQL/Row.h>
@@ -48,37 +49,11 @@ ResultOr<ResultSet> Select::execute(ExecutionContext& context) const
         }
     }
 
-    ResultSet result { SQLCommand::Select };
-
-    auto descriptor = adopt_ref(*new TupleDescriptor);
-    Tuple tuple(descriptor);
-    Vector<Tuple> rows;
-    descriptor->empend("__unity__"sv);
-    tuple.append(Value { true });
-    rows.append(tuple);
-
-    for (auto& table_descriptor : table_or_subquery_list()) {
-        if (!table_descriptor.is_table())
-            return Result { SQLCommand::Select, SQLErrorCode::NotYetImplemented, "Sub-selects are not yet implemented"sv };
-
-        auto table_def = TRY(context.database->get_table(table_descriptor.schema_name(), table_descriptor.table_name()));
-        if (table_def->num_columns() == 0)
-            continue;
-
-        auto old_descriptor_size = descriptor->size();
-        descriptor->extend(table_def->to_tuple_descriptor());
+    auto plan = TRY(QueryPlan::create(context, *this));
 
-        while (!rows.is_empty() && (rows.first().size() == old_descriptor_size)) {
-            auto cartesian_row = rows.take_first();
-            auto table_rows = TRY(context.database->select_all(*table_def));
+    ResultSet result { SQLCommand::Select };
 
-            for (auto& table_row : table_rows) {
-                auto new_row = cartesian_row;
-                new_row.extend(table_row);
-                rows.append(new_row);
-            }
-        }
-    }
+    Tuple tuple(adopt_ref(*new TupleDescriptor));
 
     bool has_ordering { false };
     auto sort_descriptor = adopt_ref(*new TupleDescriptor);
@@ -88,15 +63,7 @@ ResultOr<ResultSet> Select::execute(ExecutionContext& context) const
     }
     Tuple sort_key(sort_descriptor);
 
-    for (auto& row : rows) {
-        context.current_row = &row;
-
-        if (where_clause()) {
-            auto where_result = TRY(where_clause()->evaluate(context)).to_bool();
-            if (!where_result.has_value() || !where_result.value())
-                continue;
-        }
-
+    TRY(plan.for_each_row(context, [&](Tuple&) -> ResultOr<void> {
         tuple.clear();
 
         for (auto& col : columns) {
@@ -113,7 +80,8 @@ ResultOr<ResultSet> Select::execute(ExecutionContext& context) const
         }
 
         result.insert_row(tuple, sort_key);
-    }
+        return {};
+    }));
 
     if (m_limit_clause != nullptr) {
         size_t limit_value = NumericLimits<size_t>::max();
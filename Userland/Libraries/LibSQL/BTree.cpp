@@ -46,6 +46,8 @@ void BTree::initialize_root()
     } else {
         set_pointer(new_record_pointer());
         m_root = make<TreeNode>(*this, nullptr, pointer());
+        // NOTE: The heap can't be flushed with holes in it, so the root has to be written even if it stays empty.
+        serializer().serialize_and_write(*m_root.ptr(), m_root->pointer());
         if (on_new_root)
             on_new_root();
     }
@@ -103,6 +105,28 @@ BTreeIterator BTree::find(Key const& key)
     return end();
 }
 
+// Returns an iterator pointing to the first key in sort order for which `compare` doesn't return a negative number.
+// `compare` must be monotonic in the sort order of the tree, i.e. negative for the keys before a range of interest,
+// zero for the keys in that range, and positive for the keys after it.
+BTreeIterator BTree::lower_bound(Function<int(Key const&)> const& compare)
+{
+    if (!m_root)
+        initialize_root();
+    VERIFY(m_root);
+    auto ret = end();
+    for (auto node = m_root.ptr(); node && node->size();) {
+        auto ix = 0u;
+        while (ix < node->size() && compare((*node)[ix]) < 0)
+            ix++;
+        if (ix < node->size())
+            ret = BTreeIterator(node, (int)ix);
+        if (node->is_leaf())
+            break;
+        node = node->down_node(ix);
+    }
+    return ret;
+}
+
 void BTree::list_tree()
 {
     if (!m_root)
@@ -104,6 +104,7 @@ public:
     bool update_key_pointer(Key const&);
     Optional<u32> get(Key&);
     BTreeIterator find(Key const& key);
+    BTreeIterator lower_bound(Function<int(Key const&)> const& compare);
     BTreeIterator begin();
     static BTreeIterator end();
     void list_tree();
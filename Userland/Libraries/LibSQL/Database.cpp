@@ -6,6 +6,7 @@
  */
 
 #include <AK/Format.h>
+#include <AK/QuickSort.h>
 #include <AK/RefPtr.h>
 #include <AK/String.h>
 
@@ -18,6 +19,15 @@
 
 namespace SQL {
 
+static bool has_null_value(Key const& key)
+{
+    for (auto ix = 0u; ix < key.size(); ix++) {
+        if (key[ix].is_null())
+            return true;
+    }
+    return false;
+}
+
 Database::Database(String name)
     : m_heap(Heap::construct(move(name)))
     , m_serializer(m_heap)
@@ -42,6 +52,16 @@ ErrorOr<void> Database::open()
         m_heap->set_table_columns_root(m_table_columns->root());
     };
 
+    m_indexes = BTree::construct(m_serializer, IndexDef::index_def()->to_tuple_descriptor(), m_heap->indexes_root());
+    m_indexes->on_new_root = [&]() {
+        m_heap->set_indexes_root(m_indexes->root());
+    };
+
+    m_index_columns = BTree::construct(m_serializer, KeyPartDef::index_def()->to_tuple_descriptor(), m_heap->index_columns_root());
+    m_index_columns->on_new_root = [&]() {
+        m_heap->set_index_columns_root(m_index_columns->root());
+    };
+
     m_open = true;
     auto default_schema = TRY(get_schema("default"));
     if (!default_schema) {
@@ -171,9 +191,87 @@ ErrorOr<RefPtr<TableDef>> Database::get_table(String const& schema, String const
          column_iterator++) {
         ret->append_column(*column_iterator);
     }
+    auto index_key = IndexDef::make_key(ret);
+    for (auto index_iterator = m_indexes->find(index_key);
+         !index_iterator.is_end() && ((*index_iterator)["table_hash"].to_u32().value() == hash);
+         index_iterator++) {
+        auto index = IndexDef::construct(ret, (*index_iterator)["index_name"].to_string(), (*index_iterator)["unique"].to_int().value() != 0, (*index_iterator).pointer());
+        auto index_hash = index->hash();
+        for (auto key_part_iterator = m_index_columns->find(KeyPartDef::make_key(index));
+             !key_part_iterator.is_end() && ((*key_part_iterator)["index_hash"].to_u32().value() == index_hash);
+             key_part_iterator++) {
+            index->append_column(*key_part_iterator);
+        }
+        ret->append_index(index);
+    }
     return RefPtr<TableDef>(ret);
 }
 
+NonnullRefPtr<BTree> Database::index_tree(IndexDef const& index)
+{
+    auto hash = index.hash();
+    if (auto tree = m_index_cache.get(hash); tree.has_value())
+        return *tree.value();
+
+    auto tree = BTree::construct(m_serializer, index.to_tuple_descriptor(), index.unique(), index.pointer());
+    tree->on_new_root = [this, tree = tree.ptr(), key = index.key()]() mutable {
+        key.set_pointer(tree->root());
+        VERIFY(m_indexes->update_key_pointer(key));
+    };
+    m_index_cache.set(hash, tree);
+    return tree;
+}
+
+Key Database::make_index_key(IndexDef const& index, Row const& row)
+{
+    Key key(index.to_tuple_descriptor());
+    for (auto& part : index.key_definition())
+        key[part.name()] = row[part.name()];
+    key.set_pointer(row.pointer());
+    return key;
+}
+
+ErrorOr<void> Database::add_index(IndexDef& index)
+{
+    VERIFY(is_open());
+    auto& table = verify_cast<TableDef>(*index.parent());
+    VERIFY(m_table_cache.get(table.key().hash()).has_value());
+
+    Vector<Key> keys;
+    for (auto& row : TRY(select_all(table)))
+        keys.append(make_index_key(index, row));
+
+    if (index.unique()) {
+        // NOTE: Like in most databases, NULLs never collide with each other in a UNIQUE index.
+        Vector<Key> keys_without_nulls;
+        for (auto& key : keys) {
+            if (!has_null_value(key))
+                keys_without_nulls.append(key);
+        }
+        quick_sort(keys_without_nulls, [](auto const& a, auto const& b) { return a < b; });
+        for (auto ix = 1u; ix < keys_without_nulls.size(); ix++) {
+            if (keys_without_nulls[ix - 1] == keys_without_nulls[ix]) {
+                warnln("Rows of table '{}'.'{}' have duplicate values for UNIQUE index '{}'"sv, table.parent()->name(), table.name(), index.name());
+                return Error::from_string_literal("Unique constraint violated");
+            }
+        }
+    }
+
+    if (!m_indexes->insert(index.key())) {
+        warnln("Duplicate index name '{}' on table '{}'.'{}'"sv, index.name(), table.parent()->name(), table.name());
+        return Error::from_string_literal("Duplicate index name");
+    }
+    for (auto& key_part : index.key_definition()) {
+        VERIFY(m_index_columns->insert(key_part.key()));
+    }
+
+    auto tree = index_tree(index);
+    for (auto& key : keys)
+        VERIFY(tree->insert(key));
+    table.append_index(index);
+    return {};
+}
+
 ErrorOr<Vector<Row>> Database::select_all(TableDef const& table)
 {
     VERIFY(m_table_cache.get(table.key().hash()).has_value());
@@ -184,6 +282,21 @@ ErrorOr<Vector<Row>> Database::select_all(TableDef const& table)
     return ret;
 }
 
+// Returns the rows of the table the index is defined on whose keys are in the range described by `compare`.
+// See BTree::lower_bound() for what `compare` has to return.
+ErrorOr<Vector<Row>> Database::select_range(IndexDef const& index, Function<int(Key const&)> const& compare)
+{
+    auto& table = verify_cast<TableDef>(*index.parent());
+    VERIFY(m_table_cache.get(table.key().hash()).has_value());
+    Vector<Row> ret;
+    auto tree = index_tree(index);
+    for (auto iterator = tree->lower_bound(compare); !iterator.is_end() && compare(*iterator) == 0; iterator++) {
+        auto pointer = (*iterator).pointer();
+        ret.append(m_serializer.deserialize_block<Row>(pointer, table, pointer));
+    }
+    return ret;
+}
+
 ErrorOr<Vector<Row>> Database::match(TableDef const& table, Key const& key)
 {
     VERIFY(m_table_cache.get(table.key().hash()).has_value());
@@ -204,12 +317,14 @@ ErrorOr<void> Database::insert(Row& row)
 {
     VERIFY(m_table_cache.get(row.table()->key().hash()).has_value());
     // TODO Check constraints
+    TRY(check_unique_indexes(row));
 
     row.set_pointer(m_heap->new_record_pointer());
     row.next_pointer(row.table()->pointer());
     TRY(update(row));
 
-    // TODO update indexes defined on table.
+    for (auto& index : row.table()->indexes())
+        VERIFY(index_tree(index)->insert(make_index_key(index, row)));
 
     auto table_key = row.table()->key();
     table_key.set_pointer(row.pointer());
@@ -218,6 +333,23 @@ ErrorOr<void> Database::insert(Row& row)
     return {};
 }
 
+ErrorOr<void> Database::check_unique_indexes(Row const& row)
+{
+    for (auto& index : row.table()->indexes()) {
+        if (!index.unique())
+            continue;
+        auto key = make_index_key(index, row);
+        if (has_null_value(key))
+            continue;
+        auto iterator = index_tree(index)->lower_bound([&](Key const& entry) { return entry.compare(key); });
+        if (!iterator.is_end() && *iterator == key) {
+            warnln("Row violates UNIQUE index '{}' on table '{}'.'{}'"sv, index.name(), row.table()->parent()->name(), row.table()->name());
+            return Error::from_string_literal("Unique constraint violated");
+        }
+    }
+    return {};
+}
+
 ErrorOr<void> Database::update(Row& tuple)
 {
     VERIFY(m_table_cache.get(tuple.table()->key().hash()).has_value());
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <AK/Function.h>
 #include <AK/RefPtr.h>
 #include <AK/String.h>
 #include <LibCore/Object.h>
@@ -40,7 +41,10 @@ public:
     static Key get_table_key(String const&, String const&);
     ErrorOr<RefPtr<TableDef>> get_table(String const&, String const&);
 
+    ErrorOr<void> add_index(IndexDef&);
+
     ErrorOr<Vector<Row>> select_all(TableDef const&);
+    ErrorOr<Vector<Row>> select_range(IndexDef const&, Function<int(Key const&)> const&);
     ErrorOr<Vector<Row>> match(TableDef const&, Key const&);
     ErrorOr<void> insert(Row&);
     ErrorOr<void> update(Row&);
@@ -48,15 +52,22 @@ public:
 private:
     explicit Database(String);
 
+    NonnullRefPtr<BTree> index_tree(IndexDef const&);
+    static Key make_index_key(IndexDef const&, Row const&);
+    ErrorOr<void> check_unique_indexes(Row const&);
+
     bool m_open { false };
     NonnullRefPtr<Heap> m_heap;
     Serializer m_serializer;
     RefPtr<BTree> m_schemas;
     RefPtr<BTree> m_tables;
     RefPtr<BTree> m_table_columns;
+    RefPtr<BTree> m_indexes;
+    RefPtr<BTree> m_index_columns;
 
     HashMap<u32, RefPtr<SchemaDef>> m_schema_cache;
     HashMap<u32, RefPtr<TableDef>> m_table_cache;
+    HashMap<u32, RefPtr<BTree>> m_index_cache;
 };
 
 }
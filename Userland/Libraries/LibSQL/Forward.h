@@ -50,6 +50,7 @@ class ColumnDefinition;
 class ColumnNameExpression;
 class CommonTableExpression;
 class CommonTableExpressionList;
+class CreateIndex;
 class CreateTable;
 class Delete;
 class DropColumn;
@@ -57,9 +58,11 @@ class DropTable;
 class ErrorExpression;
 class ErrorStatement;
 class ExistsExpression;
+class Explain;
 class Expression;
 class GroupByClause;
 class InChainedExpression;
+class IndexedColumn;
 class InSelectionExpression;
 class Insert;
 class InTableExpression;
@@ -77,6 +80,7 @@ class NumericLiteral;
 class OrderingTerm;
 class Parser;
 class QualifiedTableName;
+class QueryPlan;
 class RenameColumn;
 class RenameTable;
 class ResultColumn;
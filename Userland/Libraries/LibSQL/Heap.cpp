@@ -6,10 +6,14 @@
 
 #include <AK/Format.h>
 #include <AK/QuickSort.h>
+#include <AK/Random.h>
 #include <AK/String.h>
+#include <AK/StringHash.h>
 #include <LibCore/IODevice.h>
+#include <LibCore/System.h>
 #include <LibSQL/Heap.h>
 #include <LibSQL/Serializer.h>
+#include <fcntl.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 
@@ -20,12 +24,44 @@ Heap::Heap(String file_name)
     set_name(move(file_name));
 }
 
+// The write-ahead log starts with FILE_ID, followed by a random salt that seeds the checksums of its frames.
+// Every frame holds the number of the block it contains, the number of frames of the commit it belongs to
+// if it is the last frame of that commit (0 otherwise), and a checksum over itself and all frames before it.
+constexpr static auto WAL_FILE_ID = "SerenityWAL "sv;
+constexpr static auto WAL_SALT_OFFSET = WAL_FILE_ID.length();
+constexpr static u32 WAL_HEADER_SIZE = WAL_SALT_OFFSET + sizeof(u32);
+constexpr static u32 FRAME_BLOCK_OFFSET = 0;
+constexpr static u32 FRAME_COMMIT_SIZE_OFFSET = FRAME_BLOCK_OFFSET + sizeof(u32);
+constexpr static u32 FRAME_CHECKSUM_OFFSET = FRAME_COMMIT_SIZE_OFFSET + sizeof(u32);
+constexpr static u32 FRAME_HEADER_SIZE = FRAME_CHECKSUM_OFFSET + sizeof(u32);
+constexpr static u32 FRAME_SIZE = FRAME_HEADER_SIZE + BLOCKSIZE;
+
+static u32 frame_checksum(u32 block, u32 commit_size, ReadonlyBytes data, u32 previous_checksum)
+{
+    auto checksum = string_hash(reinterpret_cast<char const*>(&block), sizeof(u32), previous_checksum);
+    checksum = string_hash(reinterpret_cast<char const*>(&commit_size), sizeof(u32), checksum);
+    return string_hash(reinterpret_cast<char const*>(data.data()), data.size(), checksum);
+}
+
 Heap::~Heap()
 {
-    if (m_file && !m_write_ahead_log.is_empty()) {
-        if (auto maybe_error = flush(); maybe_error.is_error())
-            warnln("~Heap({}): {}", name(), maybe_error.error());
+    if (m_file) {
+        if (m_dirty_pages > 0) {
+            if (auto maybe_error = flush(); maybe_error.is_error())
+                warnln("~Heap({}): {}", name(), maybe_error.error());
+        }
+        // NOTE: A heap file that was closed properly doesn't need its write-ahead log.
+        if (m_write_ahead_log && m_dirty_pages == 0) {
+            if (auto maybe_error = checkpoint(); maybe_error.is_error()) {
+                warnln("~Heap({}): {}", name(), maybe_error.error());
+            } else {
+                m_write_ahead_log = nullptr;
+                if (auto maybe_error = Core::System::unlink(write_ahead_log_name()); maybe_error.is_error())
+                    warnln("~Heap({}): {}", name(), maybe_error.error());
+            }
+        }
     }
+    m_evictable_pages.clear();
 }
 
 ErrorOr<void> Heap::open()
@@ -46,10 +82,18 @@ ErrorOr<void> Heap::open()
     if (file_size > 0)
         m_next_block = m_end_of_file = file_size / BLOCKSIZE;
 
-    auto file = TRY(Core::Stream::File::open(name(), Core::Stream::OpenMode::ReadWrite));
+    m_fd = TRY(Core::System::open(name(), O_RDWR | O_CREAT | O_CLOEXEC, 0644));
+    auto file = TRY(Core::Stream::File::adopt_fd(m_fd, Core::Stream::OpenMode::ReadWrite));
     m_file = TRY(Core::Stream::BufferedFile::create(move(file)));
 
-    if (file_size > 0) {
+    auto recovered_blocks = recover_write_ahead_log();
+    if (recovered_blocks.is_error()) {
+        m_file = nullptr;
+        return recovered_blocks.release_error();
+    }
+    m_next_block = max(m_next_block, m_end_of_file);
+
+    if (file_size > 0 || recovered_blocks.value() > 0) {
         if (auto error_maybe = read_zero_block(); error_maybe.is_error()) {
             m_file = nullptr;
             return error_maybe.error();
@@ -69,24 +113,147 @@ ErrorOr<ByteBuffer> Heap::read_block(u32 block)
         return Error::from_string_literal("Heap()::read_block(): Heap file not opened");
     }
 
-    if (auto buffer = m_write_ahead_log.get(block); buffer.has_value())
-        return TRY(ByteBuffer::copy(*buffer));
+    auto* page = TRY(page_for(block));
+    return TRY(ByteBuffer::copy(page->buffer));
+}
+
+ErrorOr<ReadonlyBytes> Heap::pin_block(u32 block)
+{
+    if (!m_file) {
+        warnln("Heap({})::pin_block({}): Heap file not opened"sv, name(), block);
+        return Error::from_string_literal("Heap()::pin_block(): Heap file not opened");
+    }
+
+    auto* page = TRY(page_for(block));
+    if (page->lru_list_node.is_in_list())
+        m_evictable_pages.remove(*page);
+    page->pin_count++;
+    return page->buffer.bytes();
+}
+
+void Heap::unpin_block(u32 block)
+{
+    auto page = m_pages.get(block);
+    VERIFY(page.has_value());
+    auto& pinned_page = *page.value();
+    VERIFY(pinned_page.pin_count > 0);
+    if (--pinned_page.pin_count == 0)
+        pinned_page.buffers_kept_for_pins.clear();
+    if (pinned_page.pin_count == 0 && !pinned_page.is_dirty) {
+        m_evictable_pages.append(pinned_page);
+        evict_pages();
+    }
+}
+
+bool Heap::has_block(u32 block) const
+{
+    if (block < size() || m_write_ahead_log_frames.contains(block))
+        return true;
+    auto page = m_pages.get(block);
+    return page.has_value() && page.value()->is_dirty;
+}
+
+void Heap::set_page_cache_capacity(size_t capacity)
+{
+    m_page_cache_capacity = max(capacity, 1u);
+    evict_pages();
+}
+
+void Heap::add_to_wal(u32 block, ByteBuffer& buffer)
+{
+    dbgln_if(SQL_DEBUG, "Adding to WAL: block #{}, size {}", block, buffer.size());
+    dbgln_if(SQL_DEBUG, "{:hex-dump}", buffer.bytes().trim(8));
+    Page* page = nullptr;
+    if (auto existing_page = m_pages.get(block); existing_page.has_value()) {
+        page = existing_page.value();
+        touch_page(*page);
+    } else {
+        auto new_page = make<Page>();
+        new_page->block = block;
+        // FIXME: Handle an OOM failure here.
+        new_page->buffer = ByteBuffer::create_zeroed(BLOCKSIZE).release_value_but_fixme_should_propagate_errors();
+        page = new_page.ptr();
+        m_pages.set(block, move(new_page));
+    }
+
+    // NOTE: The buffer of a page is overwritten in place, since it may be pinned. A block may be oversized
+    //       for a while, e.g. while a tree node is being split, but it can't be committed like that.
+    // FIXME: Handle an OOM failure here.
+    auto page_size = max(buffer.size(), static_cast<size_t>(BLOCKSIZE));
+    if (page->pin_count > 0 && page_size > page->buffer.size()) {
+        // NOTE: Growing the buffer could move it out from under whoever pinned the page. So the page gets a new
+        //       buffer instead, and the old one is kept around until the page is unpinned.
+        auto new_buffer = ByteBuffer::create_uninitialized(page_size).release_value_but_fixme_should_propagate_errors();
+        page->buffers_kept_for_pins.append(move(page->buffer));
+        page->buffer = move(new_buffer);
+    } else {
+        page->buffer.try_resize(page_size).release_value_but_fixme_should_propagate_errors();
+    }
+    page->buffer.overwrite(0, buffer.data(), buffer.size());
+    memset(page->buffer.offset_pointer(buffer.size()), 0, page_size - buffer.size());
+    if (!page->is_dirty) {
+        page->is_dirty = true;
+        m_dirty_pages++;
+        if (page->lru_list_node.is_in_list())
+            m_evictable_pages.remove(*page);
+    }
+    evict_pages();
+}
+
+ErrorOr<Heap::Page*> Heap::page_for(u32 block)
+{
+    if (auto page = m_pages.get(block); page.has_value()) {
+        touch_page(*page.value());
+        return page.value();
+    }
 
     if (block >= m_next_block) {
         warnln("Heap({})::read_block({}): block # out of range (>= {})"sv, name(), block, m_next_block);
         return Error::from_string_literal("Heap()::read_block(): block # out of range");
     }
 
+    // NOTE: Blocks that were handed out by new_record_pointer() but never written read as zeroes.
+    auto buffer = TRY(ByteBuffer::create_zeroed(BLOCKSIZE));
+    if (auto offset = m_write_ahead_log_frames.get(block); offset.has_value())
+        TRY(read_write_ahead_log_frame(offset.value(), buffer));
+    else if (block < m_end_of_file)
+        TRY(read_block_from_file(block, buffer));
+
+    auto page = make<Page>();
+    page->block = block;
+    page->buffer = move(buffer);
+    auto* page_pointer = page.ptr();
+    m_pages.set(block, move(page));
+    m_evictable_pages.append(*page_pointer);
+    evict_pages();
+    return page_pointer;
+}
+
+void Heap::touch_page(Page& page)
+{
+    if (!page.lru_list_node.is_in_list())
+        return;
+    m_evictable_pages.remove(page);
+    m_evictable_pages.append(page);
+}
+
+void Heap::evict_pages()
+{
+    while (m_pages.size() > m_page_cache_capacity && !m_evictable_pages.is_empty()) {
+        auto* page = m_evictable_pages.take_first();
+        dbgln_if(SQL_DEBUG, "Evict heap block {}", page->block);
+        m_pages.remove(page->block);
+    }
+}
+
+ErrorOr<void> Heap::read_block_from_file(u32 block, ByteBuffer& buffer)
+{
     dbgln_if(SQL_DEBUG, "Read heap block {}", block);
     TRY(seek_block(block));
 
-    auto buffer = TRY(ByteBuffer::create_uninitialized(BLOCKSIZE));
     auto bytes = TRY(m_file->read(buffer));
-
     dbgln_if(SQL_DEBUG, "{:hex-dump}", bytes.trim(8));
-    TRY(buffer.try_resize(bytes.size()));
-
-    return buffer;
+    return {};
 }
 
 ErrorOr<void> Heap::write_block(u32 block, ByteBuffer& buffer)
@@ -159,19 +326,186 @@ u32 Heap::new_record_pointer()
 ErrorOr<void> Heap::flush()
 {
     VERIFY(m_file);
-    Vector<u32> blocks;
-    for (auto& wal_entry : m_write_ahead_log) {
-        blocks.append(wal_entry.key);
+    if (m_dirty_pages == 0)
+        return {};
+
+    Vector<Page*> pages;
+    for (auto& it : m_pages) {
+        auto& page = *it.value;
+        if (!page.is_dirty)
+            continue;
+        if (page.buffer.size() > BLOCKSIZE) {
+            warnln("Heap({})::flush(): Oversized block {} ({} > {})"sv, name(), page.block, page.buffer.size(), BLOCKSIZE);
+            return Error::from_string_literal("Heap()::flush(): Oversized block");
+        }
+        pages.append(&page);
+    }
+    VERIFY(pages.size() == m_dirty_pages);
+    quick_sort(pages, [](auto* a, auto* b) { return a->block < b->block; });
+
+    if (!m_write_ahead_log)
+        TRY(create_write_ahead_log());
+
+    // NOTE: All pages of a commit are appended to the log with a single write, and the log is synced
+    //       once, so that committing many changes at once costs about as much as committing one.
+    auto frames = TRY(ByteBuffer::create_uninitialized(pages.size() * FRAME_SIZE));
+    auto checksum = m_write_ahead_log_checksum;
+    for (auto ix = 0u; ix < pages.size(); ix++) {
+        auto const& page = *pages[ix];
+        u32 commit_size = (ix == pages.size() - 1) ? pages.size() : 0;
+        checksum = frame_checksum(page.block, commit_size, page.buffer, checksum);
+
+        auto offset = ix * FRAME_SIZE;
+        frames.overwrite(offset + FRAME_BLOCK_OFFSET, &page.block, sizeof(u32));
+        frames.overwrite(offset + FRAME_COMMIT_SIZE_OFFSET, &commit_size, sizeof(u32));
+        frames.overwrite(offset + FRAME_CHECKSUM_OFFSET, &checksum, sizeof(u32));
+        frames.overwrite(offset + FRAME_HEADER_SIZE, page.buffer.data(), BLOCKSIZE);
+    }
+
+    TRY(m_write_ahead_log->seek(m_write_ahead_log_size, Core::Stream::SeekMode::SetPosition));
+    if (!m_write_ahead_log->write_or_error(frames)) {
+        warnln("Heap({})::flush(): Could not write to the write-ahead log"sv, name());
+        return Error::from_string_literal("Heap()::flush(): Could not write to the write-ahead log");
+    }
+    TRY(Core::System::fsync(m_write_ahead_log_fd));
+
+    for (auto ix = 0u; ix < pages.size(); ix++) {
+        auto& page = *pages[ix];
+        dbgln_if(SQL_DEBUG, "Committed block {} to {}", page.block, write_ahead_log_name());
+        m_write_ahead_log_frames.set(page.block, m_write_ahead_log_size + ix * FRAME_SIZE);
+        page.is_dirty = false;
+        if (page.pin_count == 0)
+            m_evictable_pages.append(page);
     }
+    m_dirty_pages = 0;
+    m_write_ahead_log_size += frames.size();
+    m_write_ahead_log_checksum = checksum;
+    evict_pages();
+
+    if ((m_write_ahead_log_size - WAL_HEADER_SIZE) / FRAME_SIZE >= WRITE_AHEAD_LOG_CHECKPOINT_FRAMES)
+        TRY(checkpoint());
+    return {};
+}
+
+ErrorOr<void> Heap::create_write_ahead_log()
+{
+    if (!m_write_ahead_log) {
+        m_write_ahead_log_fd = TRY(Core::System::open(write_ahead_log_name(), O_RDWR | O_CREAT | O_CLOEXEC, 0644));
+        m_write_ahead_log = TRY(Core::Stream::File::adopt_fd(m_write_ahead_log_fd, Core::Stream::OpenMode::ReadWrite));
+    }
+
+    auto salt = get_random<u32>();
+    auto header = TRY(ByteBuffer::create_zeroed(WAL_HEADER_SIZE));
+    header.overwrite(0, WAL_FILE_ID.characters_without_null_termination(), WAL_FILE_ID.length());
+    header.overwrite(WAL_SALT_OFFSET, &salt, sizeof(u32));
+
+    TRY(m_write_ahead_log->truncate(0));
+    TRY(m_write_ahead_log->seek(0, Core::Stream::SeekMode::SetPosition));
+    if (!m_write_ahead_log->write_or_error(header)) {
+        warnln("Heap({}): Could not write to the write-ahead log"sv, name());
+        return Error::from_string_literal("Heap(): Could not write to the write-ahead log");
+    }
+    TRY(Core::System::fsync(m_write_ahead_log_fd));
+
+    m_write_ahead_log_frames.clear();
+    m_write_ahead_log_size = WAL_HEADER_SIZE;
+    m_write_ahead_log_checksum = salt;
+    dbgln_if(SQL_DEBUG, "Write-ahead log {} created", write_ahead_log_name());
+    return {};
+}
+
+// Returns the number of blocks copied from a write-ahead log that a crash left behind into the heap file.
+ErrorOr<size_t> Heap::recover_write_ahead_log()
+{
+    if (!Core::Stream::File::exists(write_ahead_log_name()))
+        return 0;
+
+    m_write_ahead_log_fd = TRY(Core::System::open(write_ahead_log_name(), O_RDWR | O_CLOEXEC));
+    m_write_ahead_log = TRY(Core::Stream::File::adopt_fd(m_write_ahead_log_fd, Core::Stream::OpenMode::ReadWrite));
+    auto contents = TRY(m_write_ahead_log->read_all());
+
+    m_write_ahead_log_size = WAL_HEADER_SIZE;
+    if (contents.size() >= WAL_HEADER_SIZE && contents.bytes().trim(WAL_FILE_ID.length()) == WAL_FILE_ID.bytes()) {
+        memcpy(&m_write_ahead_log_checksum, contents.offset_pointer(WAL_SALT_OFFSET), sizeof(u32));
+
+        // Frames are only applied once the last frame of their commit is found, and the first frame
+        // that doesn't match its checksum ends the log, since a crash may have torn it.
+        Vector<u32> uncommitted_offsets;
+        for (u32 offset = WAL_HEADER_SIZE; offset + FRAME_SIZE <= contents.size(); offset += FRAME_SIZE) {
+            u32 block;
+            u32 commit_size;
+            u32 checksum;
+            memcpy(&block, contents.offset_pointer(offset + FRAME_BLOCK_OFFSET), sizeof(u32));
+            memcpy(&commit_size, contents.offset_pointer(offset + FRAME_COMMIT_SIZE_OFFSET), sizeof(u32));
+            memcpy(&checksum, contents.offset_pointer(offset + FRAME_CHECKSUM_OFFSET), sizeof(u32));
+            auto data = contents.bytes().slice(offset + FRAME_HEADER_SIZE, BLOCKSIZE);
+            if (checksum != frame_checksum(block, commit_size, data, m_write_ahead_log_checksum))
+                break;
+            m_write_ahead_log_checksum = checksum;
+
+            uncommitted_offsets.append(offset);
+            if (commit_size == 0)
+                continue;
+            if (commit_size != uncommitted_offsets.size())
+                break;
+            for (auto frame_offset : uncommitted_offsets) {
+                memcpy(&block, contents.offset_pointer(frame_offset + FRAME_BLOCK_OFFSET), sizeof(u32));
+                m_write_ahead_log_frames.set(block, frame_offset);
+                m_next_block = max(m_next_block, block + 1);
+            }
+            uncommitted_offsets.clear();
+            m_write_ahead_log_size = offset + FRAME_SIZE;
+        }
+    }
+
+    auto recovered_blocks = m_write_ahead_log_frames.size();
+    if (recovered_blocks > 0)
+        dbgln_if(SQL_DEBUG, "Heap({}): Recovering {} blocks from write-ahead log", name(), recovered_blocks);
+    TRY(checkpoint());
+    return recovered_blocks;
+}
+
+ErrorOr<void> Heap::read_write_ahead_log_frame(u32 offset, ByteBuffer& buffer)
+{
+    VERIFY(m_write_ahead_log);
+    TRY(m_write_ahead_log->seek(offset + FRAME_HEADER_SIZE, Core::Stream::SeekMode::SetPosition));
+    if (!m_write_ahead_log->read_or_error(buffer.bytes().trim(BLOCKSIZE))) {
+        warnln("Heap({}): Could not read from the write-ahead log at offset {}"sv, name(), offset);
+        return Error::from_string_literal("Heap(): Could not read from the write-ahead log");
+    }
+    return {};
+}
+
+// Copies the committed blocks in the write-ahead log into the heap file, and empties the log.
+ErrorOr<void> Heap::checkpoint()
+{
+    VERIFY(m_write_ahead_log);
+
+    Vector<u32> blocks;
+    for (auto& frame : m_write_ahead_log_frames)
+        blocks.append(frame.key);
     quick_sort(blocks);
-    for (auto& block : blocks) {
-        auto buffer_it = m_write_ahead_log.find(block);
-        VERIFY(buffer_it != m_write_ahead_log.end());
-        dbgln_if(SQL_DEBUG, "Flushing block {} to {}", block, name());
-        TRY(write_block(block, buffer_it->value));
-    }
-    m_write_ahead_log.clear();
-    dbgln_if(SQL_DEBUG, "WAL flushed. Heap size = {}", size());
+
+    auto buffer = TRY(ByteBuffer::create_zeroed(BLOCKSIZE));
+    for (auto block : blocks) {
+        // NOTE: Blocks that were handed out but never written leave holes, which the heap file can't have.
+        while (m_end_of_file < block) {
+            auto zeroes = TRY(ByteBuffer::create_zeroed(BLOCKSIZE));
+            TRY(write_block(m_end_of_file, zeroes));
+        }
+
+        if (auto page = m_pages.get(block); page.has_value() && !page.value()->is_dirty)
+            buffer.overwrite(0, page.value()->buffer.data(), BLOCKSIZE);
+        else
+            TRY(read_write_ahead_log_frame(m_write_ahead_log_frames.get(block).value(), buffer));
+        dbgln_if(SQL_DEBUG, "Checkpointing block {} to {}", block, name());
+        TRY(write_block(block, buffer));
+    }
+    if (!blocks.is_empty())
+        TRY(Core::System::fsync(m_fd));
+
+    TRY(create_write_ahead_log());
+    dbgln_if(SQL_DEBUG, "Write-ahead log checkpointed. Heap size = {}", size());
     return {};
 }
 
@@ -182,6 +516,9 @@ constexpr static auto TABLES_ROOT_OFFSET = SCHEMAS_ROOT_OFFSET + sizeof(u32);
 constexpr static auto TABLE_COLUMNS_ROOT_OFFSET = TABLES_ROOT_OFFSET + sizeof(u32);
 constexpr static auto FREE_LIST_OFFSET = TABLE_COLUMNS_ROOT_OFFSET + sizeof(u32);
 constexpr static auto USER_VALUES_OFFSET = FREE_LIST_OFFSET + sizeof(u32);
+// NOTE: These come after the user values so that heap files written before indexes existed can still be read.
+constexpr static auto INDEXES_ROOT_OFFSET = USER_VALUES_OFFSET + 16 * sizeof(u32);
+constexpr static auto INDEX_COLUMNS_ROOT_OFFSET = INDEXES_ROOT_OFFSET + sizeof(u32);
 
 ErrorOr<void> Heap::read_zero_block()
 {
@@ -216,6 +553,12 @@ ErrorOr<void> Heap::read_zero_block()
             dbgln_if(SQL_DEBUG, "User value {}: {}", ix, m_user_values[ix]);
         }
     }
+
+    memcpy(&m_indexes_root, buffer.offset_pointer(INDEXES_ROOT_OFFSET), sizeof(u32));
+    dbgln_if(SQL_DEBUG, "Indexes root node: {}", m_indexes_root);
+
+    memcpy(&m_index_columns_root, buffer.offset_pointer(INDEX_COLUMNS_ROOT_OFFSET), sizeof(u32));
+    dbgln_if(SQL_DEBUG, "Index columns root node: {}", m_index_columns_root);
     return {};
 }
 
@@ -226,6 +569,8 @@ void Heap::update_zero_block()
     dbgln_if(SQL_DEBUG, "Schemas root node: {}", m_schemas_root);
     dbgln_if(SQL_DEBUG, "Tables root node: {}", m_tables_root);
     dbgln_if(SQL_DEBUG, "Table Columns root node: {}", m_table_columns_root);
+    dbgln_if(SQL_DEBUG, "Indexes root node: {}", m_indexes_root);
+    dbgln_if(SQL_DEBUG, "Index Columns root node: {}", m_index_columns_root);
     dbgln_if(SQL_DEBUG, "Free list: {}", m_free_list);
     for (auto ix = 0u; ix < m_user_values.size(); ix++) {
         if (m_user_values[ix]) {
@@ -242,6 +587,8 @@ void Heap::update_zero_block()
     buffer.overwrite(TABLE_COLUMNS_ROOT_OFFSET, &m_table_columns_root, sizeof(u32));
     buffer.overwrite(FREE_LIST_OFFSET, &m_free_list, sizeof(u32));
     buffer.overwrite(USER_VALUES_OFFSET, m_user_values.data(), m_user_values.size() * sizeof(u32));
+    buffer.overwrite(INDEXES_ROOT_OFFSET, &m_indexes_root, sizeof(u32));
+    buffer.overwrite(INDEX_COLUMNS_ROOT_OFFSET, &m_index_columns_root, sizeof(u32));
 
     add_to_wal(0, buffer);
 }
@@ -252,6 +599,8 @@ void Heap::initialize_zero_block()
     m_schemas_root = 0;
     m_tables_root = 0;
     m_table_columns_root = 0;
+    m_indexes_root = 0;
+    m_index_columns_root = 0;
     m_next_block = 1;
     m_free_list = 0;
     for (auto& user : m_user_values) {
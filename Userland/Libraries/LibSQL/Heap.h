@@ -9,6 +9,8 @@
 #include <AK/Array.h>
 #include <AK/Debug.h>
 #include <AK/HashMap.h>
+#include <AK/IntrusiveList.h>
+#include <AK/NonnullOwnPtr.h>
 #include <AK/String.h>
 #include <AK/Vector.h>
 #include <LibCore/Object.h>
@@ -17,6 +19,8 @@
 namespace SQL {
 
 constexpr static u32 BLOCKSIZE = 1024;
+constexpr static size_t DEFAULT_PAGE_CACHE_CAPACITY = 1024;
+constexpr static size_t WRITE_AHEAD_LOG_CHECKPOINT_FRAMES = 1024;
 
 /**
  * A Heap is a logical container for database (SQL) data. Conceptually a
@@ -28,6 +32,15 @@ constexpr static u32 BLOCKSIZE = 1024;
  * assumed that a single SQL database is backed by a single Heap.
  *
  * Currently only B-Trees and tuple stores are implemented.
+ *
+ * Blocks that are read or written are kept in a page cache. Once it holds
+ * more than page_cache_capacity() clean pages, the least recently used ones
+ * that aren't pinned are evicted. Written pages stay in the cache until
+ * flush() commits them by appending all of them to a write-ahead log file
+ * next to the heap file in a single write. When the log grows large, its
+ * blocks are copied into the heap file in block order (a checkpoint), and
+ * it starts over. Committed blocks in a log that was left behind by a crash
+ * are copied into the heap file when it is opened again.
  */
 class Heap : public Core::Object {
     C_OBJECT(Heap);
@@ -38,8 +51,18 @@ public:
     ErrorOr<void> open();
     u32 size() const { return m_end_of_file; }
     ErrorOr<ByteBuffer> read_block(u32);
+
+    // Returns the contents of the block without copying them. They stay valid, and the block stays
+    // in the page cache, until unpin_block() is called for it as many times as it was pinned.
+    ErrorOr<ReadonlyBytes> pin_block(u32);
+    void unpin_block(u32);
+
+    size_t page_cache_capacity() const { return m_page_cache_capacity; }
+    void set_page_cache_capacity(size_t);
+    size_t cached_pages() const { return m_pages.size(); }
+
     [[nodiscard]] u32 new_record_pointer();
-    [[nodiscard]] bool has_block(u32 block) const { return block < size(); }
+    [[nodiscard]] bool has_block(u32 block) const;
     [[nodiscard]] bool valid() const { return static_cast<bool>(m_file); }
 
     u32 schemas_root() const { return m_schemas_root; }
@@ -65,6 +88,22 @@ public:
         m_table_columns_root = root;
         update_zero_block();
     }
+
+    u32 indexes_root() const { return m_indexes_root; }
+
+    void set_indexes_root(u32 root)
+    {
+        m_indexes_root = root;
+        update_zero_block();
+    }
+
+    u32 index_columns_root() const { return m_index_columns_root; }
+
+    void set_index_columns_root(u32 root)
+    {
+        m_index_columns_root = root;
+        update_zero_block();
+    }
     u32 version() const { return m_version; }
 
     u32 user_value(size_t index) const
@@ -80,24 +119,41 @@ public:
         update_zero_block();
     }
 
-    void add_to_wal(u32 block, ByteBuffer& buffer)
-    {
-        dbgln_if(SQL_DEBUG, "Adding to WAL: block #{}, size {}", block, buffer.size());
-        dbgln_if(SQL_DEBUG, "{:hex-dump}", buffer.bytes().trim(8));
-        m_write_ahead_log.set(block, buffer);
-    }
+    void add_to_wal(u32 block, ByteBuffer& buffer);
 
     ErrorOr<void> flush();
 
 private:
+    struct Page {
+        u32 block { 0 };
+        ByteBuffer buffer;
+        u32 pin_count { 0 };
+        // Buffers that were replaced while the page was pinned, which the pins may still be reading from.
+        Vector<ByteBuffer> buffers_kept_for_pins;
+        bool is_dirty { false };
+        IntrusiveListNode<Page> lru_list_node;
+    };
+
     explicit Heap(String);
 
+    ErrorOr<Page*> page_for(u32 block);
+    void touch_page(Page&);
+    void evict_pages();
+
+    ErrorOr<void> read_block_from_file(u32, ByteBuffer&);
     ErrorOr<void> write_block(u32, ByteBuffer&);
     ErrorOr<void> seek_block(u32);
     ErrorOr<void> read_zero_block();
     void initialize_zero_block();
     void update_zero_block();
 
+    String write_ahead_log_name() const { return String::formatted("{}.wal", name()); }
+    ErrorOr<void> create_write_ahead_log();
+    ErrorOr<size_t> recover_write_ahead_log();
+    ErrorOr<void> read_write_ahead_log_frame(u32 offset, ByteBuffer&);
+    ErrorOr<void> checkpoint();
+
+    int m_fd { -1 };
     OwnPtr<Core::Stream::BufferedFile> m_file;
     u32 m_free_list { 0 };
     u32 m_next_block { 1 };
@@ -105,9 +161,23 @@ private:
     u32 m_schemas_root { 0 };
     u32 m_tables_root { 0 };
     u32 m_table_columns_root { 0 };
+    u32 m_indexes_root { 0 };
+    u32 m_index_columns_root { 0 };
     u32 m_version { 0x00000001 };
     Array<u32, 16> m_user_values { 0 };
-    HashMap<u32, ByteBuffer> m_write_ahead_log;
+
+    HashMap<u32, NonnullOwnPtr<Page>> m_pages;
+    // Clean pages that aren't pinned, least recently used first.
+    IntrusiveList<&Page::lru_list_node> m_evictable_pages;
+    size_t m_page_cache_capacity { DEFAULT_PAGE_CACHE_CAPACITY };
+    size_t m_dirty_pages { 0 };
+
+    int m_write_ahead_log_fd { -1 };
+    OwnPtr<Core::Stream::File> m_write_ahead_log;
+    // The offset of the latest committed frame of every block in the write-ahead log.
+    HashMap<u32, u32> m_write_ahead_log_frames;
+    u32 m_write_ahead_log_size { 0 };
+    u32 m_write_ahead_log_checksum { 0 };
 };
 
 }
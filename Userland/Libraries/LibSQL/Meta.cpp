@@ -96,6 +96,37 @@ KeyPartDef::KeyPartDef(IndexDef* index, String name, SQLType sql_type, Order sor
 {
 }
 
+Key KeyPartDef::key() const
+{
+    auto key = Key(index_def());
+    key["index_hash"] = parent_relation()->hash();
+    key["column_number"] = (int)column_number();
+    key["column_name"] = name();
+    key["column_type"] = (int)type();
+    key["sort_order"] = (int)sort_order();
+    return key;
+}
+
+Key KeyPartDef::make_key(IndexDef const& index_def)
+{
+    Key key(KeyPartDef::index_def());
+    key["index_hash"] = index_def.key().hash();
+    return key;
+}
+
+NonnullRefPtr<IndexDef> KeyPartDef::index_def()
+{
+    NonnullRefPtr<IndexDef> s_index_def = IndexDef::construct("$key_part", true, 0);
+    if (!s_index_def->size()) {
+        s_index_def->append_column("index_hash", SQLType::Integer, Order::Ascending);
+        s_index_def->append_column("column_number", SQLType::Integer, Order::Ascending);
+        s_index_def->append_column("column_name", SQLType::Text, Order::Ascending);
+        s_index_def->append_column("column_type", SQLType::Integer, Order::Ascending);
+        s_index_def->append_column("sort_order", SQLType::Integer, Order::Ascending);
+    }
+    return s_index_def;
+}
+
 IndexDef::IndexDef(TableDef* table, String name, bool unique, u32 pointer)
     : Relation(move(name), pointer, table)
     , m_key_definition()
@@ -114,6 +145,16 @@ void IndexDef::append_column(String name, SQLType sql_type, Order sort_order)
     m_key_definition.append(part);
 }
 
+void IndexDef::append_column(Key const& key_part)
+{
+    auto column_type = key_part["column_type"].to_int();
+    VERIFY(column_type.has_value());
+    auto sort_order = key_part["sort_order"].to_int();
+    VERIFY(sort_order.has_value());
+
+    append_column(key_part["column_name"].to_string(), static_cast<SQLType>(*column_type), static_cast<Order>(*sort_order));
+}
+
 NonnullRefPtr<TupleDescriptor> IndexDef::to_tuple_descriptor() const
 {
     NonnullRefPtr<TupleDescriptor> ret = adopt_ref(*new TupleDescriptor);
@@ -129,6 +170,7 @@ Key IndexDef::key() const
     key["table_hash"] = parent_relation()->key().hash();
     key["index_name"] = name();
     key["unique"] = unique() ? 1 : 0;
+    key.set_pointer(pointer());
     return key;
 }
 
@@ -189,6 +231,12 @@ void TableDef::append_column(Key const& column)
     append_column(column["column_name"].to_string(), static_cast<SQLType>(*column_type));
 }
 
+void TableDef::append_index(NonnullRefPtr<IndexDef> index)
+{
+    VERIFY(index->parent() == this);
+    m_indexes.append(move(index));
+}
+
 Key TableDef::make_key(SchemaDef const& schema_def)
 {
     return TableDef::make_key(schema_def.key());
@@ -96,8 +96,12 @@ class KeyPartDef : public ColumnDef {
     C_OBJECT(KeyPartDef);
 
 public:
+    Key key() const override;
     Order sort_order() const { return m_sort_order; }
 
+    static NonnullRefPtr<IndexDef> index_def();
+    static Key make_key(IndexDef const&);
+
 private:
     KeyPartDef(IndexDef*, String, SQLType, Order = Order::Ascending);
 
@@ -114,6 +118,7 @@ public:
     bool unique() const { return m_unique; }
     [[nodiscard]] size_t size() const { return m_key_definition.size(); }
     void append_column(String, SQLType, Order = Order::Ascending);
+    void append_column(Key const&);
     Key key() const override;
     [[nodiscard]] NonnullRefPtr<TupleDescriptor> to_tuple_descriptor() const;
     static NonnullRefPtr<IndexDef> index_def();
@@ -136,6 +141,7 @@ public:
     Key key() const override;
     void append_column(String, SQLType);
     void append_column(Key const&);
+    void append_index(NonnullRefPtr<IndexDef>);
     size_t num_columns() { return m_columns.size(); }
     size_t num_indexes() { return m_indexes.size(); }
     NonnullRefPtrVector<ColumnDef> const& columns() const { return m_columns; }
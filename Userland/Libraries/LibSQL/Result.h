@@ -9,6 +9,7 @@
 
 #include <AK/Error.h>
 #include <AK/Noncopyable.h>
+#include <AK/String.h>
 #include <LibSQL/Type.h>
 
 namespace SQL {
@@ -18,6 +19,7 @@ namespace SQL {
     S(Create)                     \
     S(Delete)                     \
     S(Describe)                   \
+    S(Explain)                    \
     S(Insert)                     \
     S(Select)                     \
     S(Update)
@@ -55,6 +57,7 @@ constexpr char const* command_tag(SQLCommand command)
     S(ColumnDoesNotExist, "Column '{}' does not exist")                                  \
     S(AmbiguousColumnName, "Column name '{}' is ambiguous")                              \
     S(TableExists, "Table '{}' already exist")                                           \
+    S(IndexExists, "Index '{}' already exist")                                           \
     S(InvalidType, "Invalid type '{}'")                                                  \
     S(InvalidDatabaseName, "Invalid database name '{}'")                                 \
     S(InvalidValueType, "Invalid type for attribute '{}'")                               \
@@ -91,9 +94,10 @@ public:
     {
     }
 
+    // NOTE: Errors coming from the storage layer (e.g. a violated UNIQUE index) don't carry an SQLErrorCode.
     ALWAYS_INLINE Result(Error error)
-        : m_error(static_cast<SQLErrorCode>(error.code()))
-        , m_error_message(error.string_literal())
+        : m_error(SQLErrorCode::InternalError)
+        , m_error_message(String::formatted("{}", error))
     {
     }
 
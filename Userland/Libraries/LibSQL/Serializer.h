@@ -9,6 +9,7 @@
 #include <AK/ByteBuffer.h>
 #include <AK/Debug.h>
 #include <AK/Format.h>
+#include <AK/Optional.h>
 #include <AK/ScopeGuard.h>
 #include <AK/String.h>
 #include <LibSQL/Forward.h>
@@ -26,18 +27,42 @@ public:
     {
     }
 
+    Serializer(Serializer const& other)
+        : m_buffer(other.m_buffer)
+        , m_current_offset(other.m_current_offset)
+        , m_heap(other.m_heap)
+    {
+        if (other.m_pinned_block.has_value()) {
+            m_pinned_bytes = MUST(m_heap->pin_block(*other.m_pinned_block));
+            m_pinned_block = other.m_pinned_block;
+        }
+    }
+
+    Serializer& operator=(Serializer const&) = delete;
+
+    ~Serializer()
+    {
+        unpin_block();
+    }
+
+    // Reads are served straight from the heap's page cache. The block stays pinned there until
+    // the next block is read, or the serializer is reset.
     void get_block(u32 pointer)
     {
         VERIFY(m_heap.ptr() != nullptr);
-        auto buffer_or_error = m_heap->read_block(pointer);
-        if (buffer_or_error.is_error())
+        unpin_block();
+        auto bytes_or_error = m_heap->pin_block(pointer);
+        if (bytes_or_error.is_error())
             VERIFY_NOT_REACHED();
-        m_buffer = buffer_or_error.value();
+        m_pinned_block = pointer;
+        m_pinned_bytes = bytes_or_error.value();
+        m_buffer.clear();
         m_current_offset = 0;
     }
 
     void reset()
     {
+        unpin_block();
         m_buffer.clear();
         m_current_offset = 0;
     }
@@ -127,7 +152,7 @@ public:
     bool has_block(u32 pointer) const
     {
         VERIFY(m_heap.ptr() != nullptr);
-        return pointer < m_heap->size();
+        return m_heap->has_block(pointer);
     }
 
     Heap& heap()
@@ -145,9 +170,17 @@ private:
         m_current_offset += sz;
     }
 
+    void unpin_block()
+    {
+        if (!m_pinned_block.has_value())
+            return;
+        m_heap->unpin_block(m_pinned_block.release_value());
+        m_pinned_bytes = {};
+    }
+
     u8 const* read(size_t sz)
     {
-        auto buffer_ptr = m_buffer.offset_pointer(m_current_offset);
+        auto buffer_ptr = (m_pinned_block.has_value() ? m_pinned_bytes.data() : m_buffer.data()) + m_current_offset;
         if constexpr (SQL_DEBUG)
             dump(buffer_ptr, sz, "<= (in)");
         m_current_offset += sz;
@@ -171,6 +204,8 @@ private:
     ByteBuffer m_buffer {};
     size_t m_current_offset { 0 };
     RefPtr<Heap> m_heap { nullptr };
+    Optional<u32> m_pinned_block {};
+    ReadonlyBytes m_pinned_bytes {};
 };
 
 }
@@ -121,6 +121,8 @@ void TreeNode::deserialize(Serializer& serializer)
         dbgln_if(SQL_DEBUG, "Right {}", right);
         VERIFY((right == 0) == m_is_leaf);
         m_down.empend(this, right);
+    } else if (m_down.is_empty()) {
+        m_down.append(DownPointer(this, nullptr));
     }
 }
 
@@ -162,9 +164,7 @@ bool TreeNode::insert(Key const& key)
 bool TreeNode::update_key_pointer(Key const& key)
 {
     dbgln_if(SQL_DEBUG, "[#{}] UPDATE({}, {})", pointer(), key.to_string(), key.pointer());
-    if (!is_leaf())
-        return node_for(key)->update_key_pointer(key);
-
+    // NOTE: Splitting a node moves its median key up, so the key we're looking for may live in a non-leaf node.
     for (auto ix = 0u; ix < size(); ix++) {
         if (key == m_entries[ix]) {
             dbgln_if(SQL_DEBUG, "[#{}] {} == {}",
@@ -177,6 +177,8 @@ bool TreeNode::update_key_pointer(Key const& key)
             return true;
         }
     }
+    if (!is_leaf())
+        return node_for(key)->update_key_pointer(key);
     return false;
 }
 
@@ -337,7 +339,7 @@ void TreeNode::split()
     dump_if(SQL_DEBUG, "Split Left To WAL");
     tree().serializer().serialize_and_write(*this, pointer());
     new_node->dump_if(SQL_DEBUG, "Split Right to WAL");
-    tree().serializer().serialize_and_write(*new_node, pointer());
+    tree().serializer().serialize_and_write(*new_node, new_node->pointer());
 
     m_up->just_insert(median, new_node);
 }
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
 #include <AK/DistinctNumeric.h>
 #include <AK/Function.h>
 #include <AK/Result.h>
@@ -33,6 +34,7 @@ public:
     String thread_name() const { return m_thread_name; }
     pthread_t tid() const { return m_tid; }
     bool is_started() const { return m_started; }
+    bool has_exited() const { return m_has_exited; }
 
 private:
     explicit Thread(Function<intptr_t()> action, StringView thread_name = {});
@@ -41,6 +43,7 @@ private:
     String m_thread_name;
     bool m_detached { false };
     bool m_started { false };
+    Atomic<bool> m_has_exited { false };
 };
 
 template<typename T>
@@ -7,12 +7,35 @@
 #include <LibWasm/AbstractMachine/AbstractMachine.h>
 #include <LibWasm/AbstractMachine/BytecodeInterpreter.h>
 #include <LibWasm/AbstractMachine/Configuration.h>
+#include <LibWasm/AbstractMachine/GuardedMemory.h>
 #include <LibWasm/AbstractMachine/Interpreter.h>
+#include <LibWasm/AbstractMachine/LoweredFunction.h>
 #include <LibWasm/AbstractMachine/Validator.h>
+#include <LibWasm/JIT/Compiler.h>
 #include <LibWasm/Types.h>
 
 namespace Wasm {
 
+WasmFunction::WasmFunction(FunctionType const& type, ModuleInstance const& module, Module::Function const& code)
+    : m_type(type)
+    , m_module(module)
+    , m_code(code)
+{
+}
+
+WasmFunction::WasmFunction(WasmFunction&&) = default;
+WasmFunction::~WasmFunction() = default;
+
+void WasmFunction::set_lowered_function(NonnullOwnPtr<LoweredFunction> lowered_function)
+{
+    m_lowered_function = move(lowered_function);
+}
+
+void WasmFunction::set_native_code(NonnullOwnPtr<JIT::NativeCode> native_code)
+{
+    m_native_code = move(native_code);
+}
+
 Optional<FunctionAddress> Store::allocate(ModuleInstance& module, Module::Function const& function)
 {
     FunctionAddress address { m_functions.size() };
@@ -40,6 +63,66 @@ Optional<TableAddress> Store::allocate(TableType const& type)
     return address;
 }
 
+ErrorOr<MemoryInstance> MemoryInstance::create(MemoryType const& type)
+{
+    MemoryInstance instance { type };
+
+    if constexpr (GuardedMemory::is_supported) {
+        // NOTE: If the address space can't spare a reservation, this memory simply gets bounds checked.
+        if (auto reservation = GuardedMemory::reserve(); !reservation.is_error())
+            instance.m_reservation = reservation.release_value();
+    }
+
+    if (!instance.grow(type.limits().min() * Constants::page_size))
+        return Error::from_string_literal("Failed to grow to requested size");
+
+    return { move(instance) };
+}
+
+MemoryInstance::MemoryInstance(MemoryInstance&& other)
+    : m_type(other.m_type)
+    , m_size(exchange(other.m_size, 0))
+    , m_reservation(exchange(other.m_reservation, nullptr))
+    , m_buffer(move(other.m_buffer))
+{
+}
+
+MemoryInstance::~MemoryInstance()
+{
+    if (m_reservation)
+        GuardedMemory::release(m_reservation);
+}
+
+bool MemoryInstance::grow(size_t size_to_grow)
+{
+    if (size_to_grow == 0)
+        return true;
+    u64 new_size = m_size + size_to_grow;
+    // Can't grow past 2^16 pages.
+    if (new_size >= Constants::page_size * 65536)
+        return false;
+    if (auto max = m_type.limits().max(); max.has_value()) {
+        if (max.value() * Constants::page_size < new_size)
+            return false;
+    }
+
+    if (m_reservation) {
+        // NOTE: This never moves the memory, and the newly committed pages come zeroed.
+        if (GuardedMemory::commit(m_reservation, m_size, new_size).is_error())
+            return false;
+        m_size = new_size;
+        return true;
+    }
+
+    auto previous_size = m_size;
+    if (m_buffer.try_resize(new_size).is_error())
+        return false;
+    m_size = new_size;
+    // The spec requires that we zero out everything on grow
+    __builtin_memset(m_buffer.offset_pointer(previous_size), 0, size_to_grow);
+    return true;
+}
+
 Optional<MemoryAddress> Store::allocate(MemoryType const& type)
 {
     MemoryAddress address { m_memories.size() };
@@ -323,6 +406,7 @@ InstantiationResult AbstractMachine::instantiate(Module const& module, Vector<Ex
                     size_t offset = 0;
                     result.values().first().value().visit(
                         [&](auto const& value) { offset = value; },
+                        [&](u128 const&) { instantiation_result = InstantiationError { "Data segment offset returned a vector"sv }; },
                         [&](Reference const&) { instantiation_result = InstantiationError { "Data segment offset returned a reference"sv }; });
                     if (instantiation_result.has_value() && instantiation_result->is_error())
                         return;
@@ -9,6 +9,7 @@
 #include <AK/Function.h>
 #include <AK/HashMap.h>
 #include <AK/HashTable.h>
+#include <AK/Noncopyable.h>
 #include <AK/OwnPtr.h>
 #include <AK/Result.h>
 #include <LibWasm/Types.h>
@@ -17,6 +18,11 @@ namespace Wasm {
 
 class Configuration;
 struct Interpreter;
+class LoweredFunction;
+
+namespace JIT {
+struct NativeCode;
+}
 
 struct InstantiationError {
     String error { "Unknown error" };
@@ -70,7 +76,7 @@ public:
     {
     }
 
-    using AnyValueType = Variant<i32, i64, float, double, Reference>;
+    using AnyValueType = Variant<i32, i64, float, double, u128, Reference>;
     explicit Value(AnyValueType value)
         : m_value(move(value))
     {
@@ -99,6 +105,9 @@ public:
         case ValueType::Kind::F64:
             m_value = bit_cast<double>(raw_value);
             break;
+        case ValueType::Kind::V128:
+            m_value = u128 { bit_cast<u64>(raw_value) };
+            break;
         case ValueType::Kind::NullFunctionReference:
             VERIFY(raw_value == 0);
             m_value = Reference { Reference::Null { ValueType(ValueType::Kind::FunctionReference) } };
@@ -152,6 +161,7 @@ public:
             [](i64) { return ValueType::Kind::I64; },
             [](float) { return ValueType::Kind::F32; },
             [](double) { return ValueType::Kind::F64; },
+            [](u128) { return ValueType::Kind::V128; },
             [&](Reference const& type) {
                 return type.ref().visit(
                     [](Reference::Func const&) { return ValueType::Kind::FunctionReference; },
@@ -260,21 +270,32 @@ private:
 
 class WasmFunction {
 public:
-    explicit WasmFunction(FunctionType const& type, ModuleInstance const& module, Module::Function const& code)
-        : m_type(type)
-        , m_module(module)
-        , m_code(code)
-    {
-    }
+    explicit WasmFunction(FunctionType const& type, ModuleInstance const& module, Module::Function const& code);
+    WasmFunction(WasmFunction&&);
+    ~WasmFunction();
 
     auto& type() const { return m_type; }
     auto& module() const { return m_module; }
     auto& code() const { return m_code; }
 
+    // Lowered on first call, since this needs the addresses that only become known at instantiation time.
+    LoweredFunction const* lowered_function() const { return m_lowered_function; }
+    void set_lowered_function(NonnullOwnPtr<LoweredFunction>);
+    // Set instead if lowering failed, such functions are always interpreted from their instructions.
+    bool cannot_be_lowered() const { return m_cannot_be_lowered; }
+    void set_cannot_be_lowered() { m_cannot_be_lowered = true; }
+
+    // Compiled from the lowered function on first call, if the JIT is in use.
+    JIT::NativeCode* native_code() { return m_native_code; }
+    void set_native_code(NonnullOwnPtr<JIT::NativeCode>);
+
 private:
     FunctionType m_type;
     ModuleInstance const& m_module;
     Module::Function const& m_code;
+    OwnPtr<LoweredFunction> m_lowered_function;
+    OwnPtr<JIT::NativeCode> m_native_code;
+    bool m_cannot_be_lowered { false };
 };
 
 class HostFunction {
@@ -330,43 +351,33 @@ private:
 };
 
 class MemoryInstance {
-public:
-    static ErrorOr<MemoryInstance> create(MemoryType const& type)
-    {
-        MemoryInstance instance { type };
+    AK_MAKE_NONCOPYABLE(MemoryInstance);
 
-        if (!instance.grow(type.limits().min() * Constants::page_size))
-            return Error::from_string_literal("Failed to grow to requested size");
+public:
+    static ErrorOr<MemoryInstance> create(MemoryType const& type);
 
-        return { move(instance) };
-    }
+    MemoryInstance(MemoryInstance&&);
+    ~MemoryInstance();
 
     auto& type() const { return m_type; }
     auto size() const { return m_size; }
-    auto& data() const { return m_data; }
-    auto& data() { return m_data; }
+    Bytes data() { return m_reservation ? Bytes { m_reservation, m_size } : m_buffer.bytes(); }
+    ReadonlyBytes data() const { return m_reservation ? ReadonlyBytes { m_reservation, m_size } : m_buffer.bytes(); }
+
+    // Whether this memory lives in a guard-page backed reservation (see GuardedMemory.h),
+    // in which case accesses don't need to be bounds checked.
+    bool is_guarded() const { return m_reservation != nullptr; }
 
-    bool grow(size_t size_to_grow)
+    // A guarded memory never moves, so embedders can hand out views of data() directly. Other memories live in a ByteBuffer
+    // that may be reallocated when growing, so they have to be referred to through it.
+    ByteBuffer& buffer()
     {
-        if (size_to_grow == 0)
-            return true;
-        u64 new_size = m_data.size() + size_to_grow;
-        // Can't grow past 2^16 pages.
-        if (new_size >= Constants::page_size * 65536)
-            return false;
-        if (auto max = m_type.limits().max(); max.has_value()) {
-            if (max.value() * Constants::page_size < new_size)
-                return false;
-        }
-        auto previous_size = m_size;
-        if (m_data.try_resize(new_size).is_error())
-            return false;
-        m_size = new_size;
-        // The spec requires that we zero out everything on grow
-        __builtin_memset(m_data.offset_pointer(previous_size), 0, size_to_grow);
-        return true;
+        VERIFY(!is_guarded());
+        return m_buffer;
     }
 
+    bool grow(size_t size_to_grow);
+
 private:
     explicit MemoryInstance(MemoryType const& type)
         : m_type(type)
@@ -375,7 +386,8 @@ private:
 
     MemoryType const& m_type;
     size_t m_size { 0 };
-    ByteBuffer m_data;
+    u8* m_reservation { nullptr };
+    ByteBuffer m_buffer;
 };
 
 class GlobalInstance {
@@ -5,13 +5,20 @@
  */
 
 #include <AK/Debug.h>
+#include <AK/Endian.h>
+#include <AK/SIMD.h>
+#include <AK/TemporaryChange.h>
 #include <LibWasm/AbstractMachine/AbstractMachine.h>
 #include <LibWasm/AbstractMachine/BytecodeInterpreter.h>
 #include <LibWasm/AbstractMachine/Configuration.h>
+#include <LibWasm/AbstractMachine/GuardedMemory.h>
+#include <LibWasm/AbstractMachine/LoweredFunction.h>
 #include <LibWasm/AbstractMachine/Operators.h>
 #include <LibWasm/Opcode.h>
 #include <LibWasm/Printer/Printer.h>
 
+using namespace AK::SIMD;
+
 namespace Wasm {
 
 #define TRAP_IF_NOT(x)                                                                         \
@@ -103,7 +110,7 @@ void BytecodeInterpreter::load_and_push(Configuration& configuration, Instructio
         return;
     }
     dbgln_if(WASM_TRACE_DEBUG, "load({} : {}) -> stack", instance_address, sizeof(ReadType));
-    auto slice = memory->data().bytes().slice(instance_address, sizeof(ReadType));
+    auto slice = memory->data().slice(instance_address, sizeof(ReadType));
     configuration.stack().peek() = Value(static_cast<PushType>(read_value<ReadType>(slice)));
 }
 
@@ -142,17 +149,17 @@ void BytecodeInterpreter::call_address(Configuration& configuration, FunctionAdd
         configuration.stack().entries().unchecked_append(move(entry));
 }
 
-template<typename PopType, typename PushType, typename Operator>
-void BytecodeInterpreter::binary_numeric_operation(Configuration& configuration)
+template<typename PopTypeLHS, typename PushType, typename Operator, typename PopTypeRHS, typename... Args>
+void BytecodeInterpreter::binary_numeric_operation(Configuration& configuration, Args&&... args)
 {
     auto rhs_entry = configuration.stack().pop();
     auto& lhs_entry = configuration.stack().peek();
     auto rhs_ptr = rhs_entry.get_pointer<Value>();
     auto lhs_ptr = lhs_entry.get_pointer<Value>();
-    auto rhs = rhs_ptr->to<PopType>();
-    auto lhs = lhs_ptr->to<PopType>();
+    auto rhs = rhs_ptr->to<PopTypeRHS>();
+    auto lhs = lhs_ptr->to<PopTypeLHS>();
     PushType result;
-    auto call_result = Operator {}(lhs.value(), rhs.value());
+    auto call_result = Operator { forward<Args>(args)... }(lhs.value(), rhs.value());
     if constexpr (IsSpecializationOf<decltype(call_result), AK::Result>) {
         if (call_result.is_error()) {
             trap_if_not(false, call_result.error());
@@ -166,13 +173,13 @@ void BytecodeInterpreter::binary_numeric_operation(Configuration& configuration)
     lhs_entry = Value(result);
 }
 
-template<typename PopType, typename PushType, typename Operator>
-void BytecodeInterpreter::unary_operation(Configuration& configuration)
+template<typename PopType, typename PushType, typename Operator, typename... Args>
+void BytecodeInterpreter::unary_operation(Configuration& configuration, Args&&... args)
 {
     auto& entry = configuration.stack().peek();
     auto entry_ptr = entry.get_pointer<Value>();
     auto value = entry_ptr->to<PopType>();
-    auto call_result = Operator {}(*value);
+    auto call_result = Operator { forward<Args>(args)... }(*value);
     PushType result;
     if constexpr (IsSpecializationOf<decltype(call_result), AK::Result>) {
         if (call_result.is_error()) {
@@ -229,14 +236,13 @@ void BytecodeInterpreter::pop_and_store(Configuration& configuration, Instructio
     dbgln_if(WASM_TRACE_DEBUG, "stack({}) -> temporary({}b)", value, sizeof(StoreT));
     auto base_entry = configuration.stack().pop();
     auto base = base_entry.get<Value>().to<i32>();
-    store_to_memory(configuration, instruction, { &value, sizeof(StoreT) }, *base);
+    store_to_memory(configuration, instruction.arguments().get<Instruction::MemoryArgument>(), { &value, sizeof(StoreT) }, *base);
 }
 
-void BytecodeInterpreter::store_to_memory(Configuration& configuration, Instruction const& instruction, ReadonlyBytes data, i32 base)
+void BytecodeInterpreter::store_to_memory(Configuration& configuration, Instruction::MemoryArgument const& arg, ReadonlyBytes data, i32 base)
 {
     auto& address = configuration.frame().module().memories().first();
     auto memory = configuration.store().get(address);
-    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
     u64 instance_address = static_cast<u64>(bit_cast<u32>(base)) + arg.offset;
     Checked addition { instance_address };
     addition += data.size();
@@ -246,7 +252,61 @@ void BytecodeInterpreter::store_to_memory(Configuration& configuration, Instruct
         return;
     }
     dbgln_if(WASM_TRACE_DEBUG, "temporary({}b) -> store({})", data.size(), instance_address);
-    data.copy_to(memory->data().bytes().slice(instance_address, data.size()));
+    data.copy_to(memory->data().slice(instance_address, data.size()));
+}
+
+Optional<Bytes> BytecodeInterpreter::memory_range(Configuration& configuration, Instruction::MemoryArgument const& arg, i32 base, size_t size)
+{
+    auto& address = configuration.frame().module().memories().first();
+    auto memory = configuration.store().get(address);
+    u64 instance_address = static_cast<u64>(bit_cast<u32>(base)) + arg.offset;
+    Checked addition { instance_address };
+    addition += size;
+    if (addition.has_overflow() || addition.value() > memory->size()) {
+        m_trap = Trap { "Memory access out of bounds" };
+        dbgln("LibWasm: Memory access out of bounds (expected {} to be less than or equal to {})", instance_address + size, memory->size());
+        return {};
+    }
+    return memory->data().slice(instance_address, size);
+}
+
+template<typename ReadType, typename Operator>
+void BytecodeInterpreter::load_and_push_vector(Configuration& configuration, Instruction const& instruction)
+{
+    auto& entry = configuration.stack().peek();
+    auto base = entry.get<Value>().to<i32>();
+    auto range = memory_range(configuration, instruction.arguments().get<Instruction::MemoryArgument>(), *base, sizeof(ReadType));
+    if (!range.has_value())
+        return;
+    ReadType value;
+    range->copy_to({ &value, sizeof(ReadType) });
+    dbgln_if(WASM_TRACE_DEBUG, "load({}b) -> stack", sizeof(ReadType));
+    entry = Value(Operator {}(value));
+}
+
+template<typename VectorType>
+void BytecodeInterpreter::load_vector_lane(Configuration& configuration, Instruction const& instruction)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryAndLaneArgument>();
+    auto vector = *configuration.stack().pop().get<Value>().to<u128>();
+    auto& entry = configuration.stack().peek();
+    auto base = entry.get<Value>().to<i32>();
+    auto range = memory_range(configuration, arg.memory, *base, sizeof(Operators::LaneType<VectorType>));
+    if (!range.has_value())
+        return;
+    Operators::LaneType<VectorType> value;
+    range->copy_to({ &value, sizeof(value) });
+    entry = Value(Operators::VectorReplaceLane<VectorType> { arg.lane }(vector, value));
+}
+
+template<typename VectorType>
+void BytecodeInterpreter::store_vector_lane(Configuration& configuration, Instruction const& instruction)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryAndLaneArgument>();
+    auto vector = *configuration.stack().pop().get<Value>().to<u128>();
+    auto base = *configuration.stack().pop().get<Value>().to<i32>();
+    auto value = Operators::VectorExtractLane<VectorType, Operators::LaneType<VectorType>> { arg.lane }(vector);
+    store_to_memory(configuration, arg.memory, { &value, sizeof(value) }, base);
 }
 
 template<typename T>
@@ -938,17 +998,496 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
         TRAP_IF_NOT(source_offset + count > 0);
         TRAP_IF_NOT(static_cast<size_t>(source_offset + count) <= data.size());
 
-        Instruction synthetic_store_instruction {
-            Instructions::i32_store8,
-            Instruction::MemoryArgument { 0, 0 }
-        };
-
         for (size_t i = 0; i < (size_t)count; ++i) {
             auto value = data.data()[source_offset + i];
-            store_to_memory(configuration, synthetic_store_instruction, { &value, sizeof(value) }, destination_offset + i);
+            store_to_memory(configuration, Instruction::MemoryArgument { 0, 0 }, { &value, sizeof(value) }, destination_offset + i);
         }
         return;
     }
+    case Instructions::v128_load.value():
+        return load_and_push_vector<u128, Operators::Extend<u128>>(configuration, instruction);
+    case Instructions::v128_load8x8_s.value():
+        return load_and_push_vector<u64, Operators::VectorExtend<i8x8, i16x8, Operators::VectorHalf::Low>>(configuration, instruction);
+    case Instructions::v128_load8x8_u.value():
+        return load_and_push_vector<u64, Operators::VectorExtend<u8x8, u16x8, Operators::VectorHalf::Low>>(configuration, instruction);
+    case Instructions::v128_load16x4_s.value():
+        return load_and_push_vector<u64, Operators::VectorExtend<i16x4, i32x4, Operators::VectorHalf::Low>>(configuration, instruction);
+    case Instructions::v128_load16x4_u.value():
+        return load_and_push_vector<u64, Operators::VectorExtend<u16x4, u32x4, Operators::VectorHalf::Low>>(configuration, instruction);
+    case Instructions::v128_load32x2_s.value():
+        return load_and_push_vector<u64, Operators::VectorExtend<i32x2, i64x2, Operators::VectorHalf::Low>>(configuration, instruction);
+    case Instructions::v128_load32x2_u.value():
+        return load_and_push_vector<u64, Operators::VectorExtend<u32x2, u64x2, Operators::VectorHalf::Low>>(configuration, instruction);
+    case Instructions::v128_load8_splat.value():
+        return load_and_push_vector<u8, Operators::VectorSplat<u8x16>>(configuration, instruction);
+    case Instructions::v128_load16_splat.value():
+        return load_and_push_vector<u16, Operators::VectorSplat<u16x8>>(configuration, instruction);
+    case Instructions::v128_load32_splat.value():
+        return load_and_push_vector<u32, Operators::VectorSplat<u32x4>>(configuration, instruction);
+    case Instructions::v128_load64_splat.value():
+        return load_and_push_vector<u64, Operators::VectorSplat<u64x2>>(configuration, instruction);
+    case Instructions::v128_store.value(): {
+        auto vector = *configuration.stack().pop().get<Value>().to<u128>();
+        auto base = *configuration.stack().pop().get<Value>().to<i32>();
+        store_to_memory(configuration, instruction.arguments().get<Instruction::MemoryArgument>(), vector.bytes(), base);
+        return;
+    }
+    case Instructions::v128_const.value(): {
+        configuration.stack().push(Value(instruction.arguments().get<u128>()));
+        return;
+    }
+    case Instructions::i8x16_shuffle.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorShuffle, u128>(configuration, instruction.arguments().get<Instruction::ShuffleArgument>().lanes);
+    case Instructions::i8x16_swizzle.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorSwizzle>(configuration);
+    case Instructions::i8x16_splat.value():
+        return unary_operation<i32, u128, Operators::VectorSplat<u8x16>>(configuration);
+    case Instructions::i16x8_splat.value():
+        return unary_operation<i32, u128, Operators::VectorSplat<u16x8>>(configuration);
+    case Instructions::i32x4_splat.value():
+        return unary_operation<i32, u128, Operators::VectorSplat<u32x4>>(configuration);
+    case Instructions::i64x2_splat.value():
+        return unary_operation<i64, u128, Operators::VectorSplat<u64x2>>(configuration);
+    case Instructions::f32x4_splat.value():
+        return unary_operation<float, u128, Operators::VectorSplat<f32x4>>(configuration);
+    case Instructions::f64x2_splat.value():
+        return unary_operation<double, u128, Operators::VectorSplat<f64x2>>(configuration);
+    case Instructions::i8x16_extract_lane_s.value():
+        return unary_operation<u128, i32, Operators::VectorExtractLane<i8x16, i32>>(configuration, instruction.arguments().get<Instruction::LaneIndex>().lane);
+    case Instructions::i8x16_extract_lane_u.value():
+        return unary_operation<u128, i32, Operators::VectorExtractLane<u8x16, i32>>(configuration, instruction.arguments().get<Instruction::LaneIndex>().lane);
+    case Instructions::i8x16_replace_lane.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorReplaceLane<u8x16>, i32>(configuration, instruction.arguments().get<Instruction::LaneIndex>().lane);
+    case Instructions::i16x8_extract_lane_s.value():
+        return unary_operation<u128, i32, Operators::VectorExtractLane<i16x8, i32>>(configuration, instruction.arguments().get<Instruction::LaneIndex>().lane);
+    case Instructions::i16x8_extract_lane_u.value():
+        return unary_operation<u128, i32, Operators::VectorExtractLane<u16x8, i32>>(configuration, instruction.arguments().get<Instruction::LaneIndex>().lane);
+    case Instructions::i16x8_replace_lane.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorReplaceLane<u16x8>, i32>(configuration, instruction.arguments().get<Instruction::LaneIndex>().lane);
+    case Instructions::i32x4_extract_lane.value():
+        return unary_operation<u128, i32, Operators::VectorExtractLane<i32x4, i32>>(configuration, instruction.arguments().get<Instruction::LaneIndex>().lane);
+    case Instructions::i32x4_replace_lane.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorReplaceLane<i32x4>, i32>(configuration, instruction.arguments().get<Instruction::LaneIndex>().lane);
+    case Instructions::i64x2_extract_lane.value():
+        return unary_operation<u128, i64, Operators::VectorExtractLane<i64x2, i64>>(configuration, instruction.arguments().get<Instruction::LaneIndex>().lane);
+    case Instructions::i64x2_replace_lane.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorReplaceLane<i64x2>, i64>(configuration, instruction.arguments().get<Instruction::LaneIndex>().lane);
+    case Instructions::f32x4_extract_lane.value():
+        return unary_operation<u128, float, Operators::VectorExtractLane<f32x4, float>>(configuration, instruction.arguments().get<Instruction::LaneIndex>().lane);
+    case Instructions::f32x4_replace_lane.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorReplaceLane<f32x4>, float>(configuration, instruction.arguments().get<Instruction::LaneIndex>().lane);
+    case Instructions::f64x2_extract_lane.value():
+        return unary_operation<u128, double, Operators::VectorExtractLane<f64x2, double>>(configuration, instruction.arguments().get<Instruction::LaneIndex>().lane);
+    case Instructions::f64x2_replace_lane.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorReplaceLane<f64x2>, double>(configuration, instruction.arguments().get<Instruction::LaneIndex>().lane);
+    case Instructions::i8x16_eq.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<i8x16, Operators::Equals>>(configuration);
+    case Instructions::i8x16_ne.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<i8x16, Operators::NotEquals>>(configuration);
+    case Instructions::i8x16_lt_s.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<i8x16, Operators::LessThan>>(configuration);
+    case Instructions::i8x16_lt_u.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<u8x16, Operators::LessThan>>(configuration);
+    case Instructions::i8x16_gt_s.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<i8x16, Operators::GreaterThan>>(configuration);
+    case Instructions::i8x16_gt_u.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<u8x16, Operators::GreaterThan>>(configuration);
+    case Instructions::i8x16_le_s.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<i8x16, Operators::LessThanOrEquals>>(configuration);
+    case Instructions::i8x16_le_u.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<u8x16, Operators::LessThanOrEquals>>(configuration);
+    case Instructions::i8x16_ge_s.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<i8x16, Operators::GreaterThanOrEquals>>(configuration);
+    case Instructions::i8x16_ge_u.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<u8x16, Operators::GreaterThanOrEquals>>(configuration);
+    case Instructions::i16x8_eq.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<i16x8, Operators::Equals>>(configuration);
+    case Instructions::i16x8_ne.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<i16x8, Operators::NotEquals>>(configuration);
+    case Instructions::i16x8_lt_s.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<i16x8, Operators::LessThan>>(configuration);
+    case Instructions::i16x8_lt_u.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<u16x8, Operators::LessThan>>(configuration);
+    case Instructions::i16x8_gt_s.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<i16x8, Operators::GreaterThan>>(configuration);
+    case Instructions::i16x8_gt_u.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<u16x8, Operators::GreaterThan>>(configuration);
+    case Instructions::i16x8_le_s.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<i16x8, Operators::LessThanOrEquals>>(configuration);
+    case Instructions::i16x8_le_u.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<u16x8, Operators::LessThanOrEquals>>(configuration);
+    case Instructions::i16x8_ge_s.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<i16x8, Operators::GreaterThanOrEquals>>(configuration);
+    case Instructions::i16x8_ge_u.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<u16x8, Operators::GreaterThanOrEquals>>(configuration);
+    case Instructions::i32x4_eq.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<i32x4, Operators::Equals>>(configuration);
+    case Instructions::i32x4_ne.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<i32x4, Operators::NotEquals>>(configuration);
+    case Instructions::i32x4_lt_s.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<i32x4, Operators::LessThan>>(configuration);
+    case Instructions::i32x4_lt_u.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<u32x4, Operators::LessThan>>(configuration);
+    case Instructions::i32x4_gt_s.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<i32x4, Operators::GreaterThan>>(configuration);
+    case Instructions::i32x4_gt_u.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<u32x4, Operators::GreaterThan>>(configuration);
+    case Instructions::i32x4_le_s.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<i32x4, Operators::LessThanOrEquals>>(configuration);
+    case Instructions::i32x4_le_u.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<u32x4, Operators::LessThanOrEquals>>(configuration);
+    case Instructions::i32x4_ge_s.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<i32x4, Operators::GreaterThanOrEquals>>(configuration);
+    case Instructions::i32x4_ge_u.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<u32x4, Operators::GreaterThanOrEquals>>(configuration);
+    case Instructions::f32x4_eq.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<f32x4, Operators::Equals>>(configuration);
+    case Instructions::f32x4_ne.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<f32x4, Operators::NotEquals>>(configuration);
+    case Instructions::f32x4_lt.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<f32x4, Operators::LessThan>>(configuration);
+    case Instructions::f32x4_gt.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<f32x4, Operators::GreaterThan>>(configuration);
+    case Instructions::f32x4_le.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<f32x4, Operators::LessThanOrEquals>>(configuration);
+    case Instructions::f32x4_ge.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<f32x4, Operators::GreaterThanOrEquals>>(configuration);
+    case Instructions::f64x2_eq.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<f64x2, Operators::Equals>>(configuration);
+    case Instructions::f64x2_ne.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<f64x2, Operators::NotEquals>>(configuration);
+    case Instructions::f64x2_lt.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<f64x2, Operators::LessThan>>(configuration);
+    case Instructions::f64x2_gt.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<f64x2, Operators::GreaterThan>>(configuration);
+    case Instructions::f64x2_le.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<f64x2, Operators::LessThanOrEquals>>(configuration);
+    case Instructions::f64x2_ge.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<f64x2, Operators::GreaterThanOrEquals>>(configuration);
+    case Instructions::v128_not.value():
+        return unary_operation<u128, u128, Operators::Vectorized<u64x2, Operators::BitNot>>(configuration);
+    case Instructions::v128_and.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<u64x2, Operators::BitAnd>>(configuration);
+    case Instructions::v128_andnot.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<u64x2, Operators::BitAndNot>>(configuration);
+    case Instructions::v128_or.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<u64x2, Operators::BitOr>>(configuration);
+    case Instructions::v128_xor.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<u64x2, Operators::BitXor>>(configuration);
+    case Instructions::v128_bitselect.value(): {
+        auto mask = bit_cast<u64x2>(*configuration.stack().pop().get<Value>().to<u128>());
+        auto false_vector = bit_cast<u64x2>(*configuration.stack().pop().get<Value>().to<u128>());
+        auto& entry = configuration.stack().peek();
+        auto true_vector = bit_cast<u64x2>(*entry.get<Value>().to<u128>());
+        entry = Value(bit_cast<u128>((true_vector & mask) | (false_vector & ~mask)));
+        return;
+    }
+    case Instructions::v128_any_true.value():
+        return unary_operation<u128, i32, Operators::VectorAnyTrue>(configuration);
+    case Instructions::v128_load8_lane.value():
+        return load_vector_lane<u8x16>(configuration, instruction);
+    case Instructions::v128_load16_lane.value():
+        return load_vector_lane<u16x8>(configuration, instruction);
+    case Instructions::v128_load32_lane.value():
+        return load_vector_lane<u32x4>(configuration, instruction);
+    case Instructions::v128_load64_lane.value():
+        return load_vector_lane<u64x2>(configuration, instruction);
+    case Instructions::v128_store8_lane.value():
+        return store_vector_lane<u8x16>(configuration, instruction);
+    case Instructions::v128_store16_lane.value():
+        return store_vector_lane<u16x8>(configuration, instruction);
+    case Instructions::v128_store32_lane.value():
+        return store_vector_lane<u32x4>(configuration, instruction);
+    case Instructions::v128_store64_lane.value():
+        return store_vector_lane<u64x2>(configuration, instruction);
+    case Instructions::v128_load32_zero.value():
+        return load_and_push_vector<u32, Operators::Extend<u128>>(configuration, instruction);
+    case Instructions::v128_load64_zero.value():
+        return load_and_push_vector<u64, Operators::Extend<u128>>(configuration, instruction);
+    case Instructions::f32x4_demote_f64x2_zero.value():
+        return unary_operation<u128, u128, Operators::LaneWiseConvert<f64x2, f32x4, Operators::Demote>>(configuration);
+    case Instructions::f64x2_promote_low_f32x4.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<f32x2, f64x2, Operators::VectorHalf::Low>>(configuration);
+    case Instructions::i8x16_abs.value():
+        return unary_operation<u128, u128, Operators::VectorAbsolute<i8x16>>(configuration);
+    case Instructions::i8x16_neg.value():
+        return unary_operation<u128, u128, Operators::Vectorized<u8x16, Operators::Negate>>(configuration);
+    case Instructions::i8x16_popcnt.value():
+        return unary_operation<u128, u128, Operators::VectorPopCount>(configuration);
+    case Instructions::i8x16_all_true.value():
+        return unary_operation<u128, i32, Operators::VectorAllTrue<u8x16>>(configuration);
+    case Instructions::i8x16_bitmask.value():
+        return unary_operation<u128, i32, Operators::VectorBitmask<i8x16>>(configuration);
+    case Instructions::i8x16_narrow_i16x8_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorNarrow<i16x8, i8x16>>(configuration);
+    case Instructions::i8x16_narrow_i16x8_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorNarrow<i16x8, u8x16>>(configuration);
+    case Instructions::f32x4_ceil.value():
+        return unary_operation<u128, u128, Operators::LaneWise<f32x4, Operators::Ceil>>(configuration);
+    case Instructions::f32x4_floor.value():
+        return unary_operation<u128, u128, Operators::LaneWise<f32x4, Operators::Floor>>(configuration);
+    case Instructions::f32x4_trunc.value():
+        return unary_operation<u128, u128, Operators::LaneWise<f32x4, Operators::Truncate>>(configuration);
+    case Instructions::f32x4_nearest.value():
+        return unary_operation<u128, u128, Operators::LaneWise<f32x4, Operators::NearbyIntegral>>(configuration);
+    case Instructions::i8x16_shl.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorShiftLeft<u8x16>, i32>(configuration);
+    case Instructions::i8x16_shr_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorShiftRight<i8x16>, i32>(configuration);
+    case Instructions::i8x16_shr_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorShiftRight<u8x16>, i32>(configuration);
+    case Instructions::i8x16_add.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<u8x16, Operators::Add>>(configuration);
+    case Instructions::i8x16_add_sat_s.value():
+        return binary_numeric_operation<u128, u128, Operators::LaneWise<i8x16, Operators::SaturatingAdd>>(configuration);
+    case Instructions::i8x16_add_sat_u.value():
+        return binary_numeric_operation<u128, u128, Operators::LaneWise<u8x16, Operators::SaturatingAdd>>(configuration);
+    case Instructions::i8x16_sub.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<u8x16, Operators::Subtract>>(configuration);
+    case Instructions::i8x16_sub_sat_s.value():
+        return binary_numeric_operation<u128, u128, Operators::LaneWise<i8x16, Operators::SaturatingSubtract>>(configuration);
+    case Instructions::i8x16_sub_sat_u.value():
+        return binary_numeric_operation<u128, u128, Operators::LaneWise<u8x16, Operators::SaturatingSubtract>>(configuration);
+    case Instructions::f64x2_ceil.value():
+        return unary_operation<u128, u128, Operators::LaneWise<f64x2, Operators::Ceil>>(configuration);
+    case Instructions::f64x2_floor.value():
+        return unary_operation<u128, u128, Operators::LaneWise<f64x2, Operators::Floor>>(configuration);
+    case Instructions::i8x16_min_s.value():
+        return binary_numeric_operation<u128, u128, Operators::LaneWise<i8x16, Operators::Minimum>>(configuration);
+    case Instructions::i8x16_min_u.value():
+        return binary_numeric_operation<u128, u128, Operators::LaneWise<u8x16, Operators::Minimum>>(configuration);
+    case Instructions::i8x16_max_s.value():
+        return binary_numeric_operation<u128, u128, Operators::LaneWise<i8x16, Operators::Maximum>>(configuration);
+    case Instructions::i8x16_max_u.value():
+        return binary_numeric_operation<u128, u128, Operators::LaneWise<u8x16, Operators::Maximum>>(configuration);
+    case Instructions::f64x2_trunc.value():
+        return unary_operation<u128, u128, Operators::LaneWise<f64x2, Operators::Truncate>>(configuration);
+    case Instructions::i8x16_avgr_u.value():
+        return binary_numeric_operation<u128, u128, Operators::LaneWise<u8x16, Operators::RoundingAverage>>(configuration);
+    case Instructions::i16x8_extadd_pairwise_i8x16_s.value():
+        return unary_operation<u128, u128, Operators::VectorExtendedAddPairwise<i8x16, i16x8>>(configuration);
+    case Instructions::i16x8_extadd_pairwise_i8x16_u.value():
+        return unary_operation<u128, u128, Operators::VectorExtendedAddPairwise<u8x16, u16x8>>(configuration);
+    case Instructions::i32x4_extadd_pairwise_i16x8_s.value():
+        return unary_operation<u128, u128, Operators::VectorExtendedAddPairwise<i16x8, i32x4>>(configuration);
+    case Instructions::i32x4_extadd_pairwise_i16x8_u.value():
+        return unary_operation<u128, u128, Operators::VectorExtendedAddPairwise<u16x8, u32x4>>(configuration);
+    case Instructions::i16x8_abs.value():
+        return unary_operation<u128, u128, Operators::VectorAbsolute<i16x8>>(configuration);
+    case Instructions::i16x8_neg.value():
+        return unary_operation<u128, u128, Operators::Vectorized<u16x8, Operators::Negate>>(configuration);
+    case Instructions::i16x8_q15mulr_sat_s.value():
+        return binary_numeric_operation<u128, u128, Operators::LaneWise<i16x8, Operators::Q15MultiplyRoundSaturate>>(configuration);
+    case Instructions::i16x8_all_true.value():
+        return unary_operation<u128, i32, Operators::VectorAllTrue<u16x8>>(configuration);
+    case Instructions::i16x8_bitmask.value():
+        return unary_operation<u128, i32, Operators::VectorBitmask<i16x8>>(configuration);
+    case Instructions::i16x8_narrow_i32x4_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorNarrow<i32x4, i16x8>>(configuration);
+    case Instructions::i16x8_narrow_i32x4_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorNarrow<i32x4, u16x8>>(configuration);
+    case Instructions::i16x8_extend_low_i8x16_s.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<i8x8, i16x8, Operators::VectorHalf::Low>>(configuration);
+    case Instructions::i16x8_extend_high_i8x16_s.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<i8x8, i16x8, Operators::VectorHalf::High>>(configuration);
+    case Instructions::i16x8_extend_low_i8x16_u.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<u8x8, u16x8, Operators::VectorHalf::Low>>(configuration);
+    case Instructions::i16x8_extend_high_i8x16_u.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<u8x8, u16x8, Operators::VectorHalf::High>>(configuration);
+    case Instructions::i16x8_shl.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorShiftLeft<u16x8>, i32>(configuration);
+    case Instructions::i16x8_shr_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorShiftRight<i16x8>, i32>(configuration);
+    case Instructions::i16x8_shr_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorShiftRight<u16x8>, i32>(configuration);
+    case Instructions::i16x8_add.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<u16x8, Operators::Add>>(configuration);
+    case Instructions::i16x8_add_sat_s.value():
+        return binary_numeric_operation<u128, u128, Operators::LaneWise<i16x8, Operators::SaturatingAdd>>(configuration);
+    case Instructions::i16x8_add_sat_u.value():
+        return binary_numeric_operation<u128, u128, Operators::LaneWise<u16x8, Operators::SaturatingAdd>>(configuration);
+    case Instructions::i16x8_sub.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<u16x8, Operators::Subtract>>(configuration);
+    case Instructions::i16x8_sub_sat_s.value():
+        return binary_numeric_operation<u128, u128, Operators::LaneWise<i16x8, Operators::SaturatingSubtract>>(configuration);
+    case Instructions::i16x8_sub_sat_u.value():
+        return binary_numeric_operation<u128, u128, Operators::LaneWise<u16x8, Operators::SaturatingSubtract>>(configuration);
+    case Instructions::f64x2_nearest.value():
+        return unary_operation<u128, u128, Operators::LaneWise<f64x2, Operators::NearbyIntegral>>(configuration);
+    case Instructions::i16x8_mul.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<u16x8, Operators::Multiply>>(configuration);
+    case Instructions::i16x8_min_s.value():
+        return binary_numeric_operation<u128, u128, Operators::LaneWise<i16x8, Operators::Minimum>>(configuration);
+    case Instructions::i16x8_min_u.value():
+        return binary_numeric_operation<u128, u128, Operators::LaneWise<u16x8, Operators::Minimum>>(configuration);
+    case Instructions::i16x8_max_s.value():
+        return binary_numeric_operation<u128, u128, Operators::LaneWise<i16x8, Operators::Maximum>>(configuration);
+    case Instructions::i16x8_max_u.value():
+        return binary_numeric_operation<u128, u128, Operators::LaneWise<u16x8, Operators::Maximum>>(configuration);
+    case Instructions::i16x8_avgr_u.value():
+        return binary_numeric_operation<u128, u128, Operators::LaneWise<u16x8, Operators::RoundingAverage>>(configuration);
+    case Instructions::i16x8_extmul_low_i8x16_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendedMultiply<i8x8, i16x8, Operators::VectorHalf::Low>>(configuration);
+    case Instructions::i16x8_extmul_high_i8x16_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendedMultiply<i8x8, i16x8, Operators::VectorHalf::High>>(configuration);
+    case Instructions::i16x8_extmul_low_i8x16_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendedMultiply<u8x8, u16x8, Operators::VectorHalf::Low>>(configuration);
+    case Instructions::i16x8_extmul_high_i8x16_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendedMultiply<u8x8, u16x8, Operators::VectorHalf::High>>(configuration);
+    case Instructions::i32x4_abs.value():
+        return unary_operation<u128, u128, Operators::VectorAbsolute<i32x4>>(configuration);
+    case Instructions::i32x4_neg.value():
+        return unary_operation<u128, u128, Operators::Vectorized<u32x4, Operators::Negate>>(configuration);
+    case Instructions::i32x4_all_true.value():
+        return unary_operation<u128, i32, Operators::VectorAllTrue<u32x4>>(configuration);
+    case Instructions::i32x4_bitmask.value():
+        return unary_operation<u128, i32, Operators::VectorBitmask<i32x4>>(configuration);
+    case Instructions::i32x4_extend_low_i16x8_s.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<i16x4, i32x4, Operators::VectorHalf::Low>>(configuration);
+    case Instructions::i32x4_extend_high_i16x8_s.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<i16x4, i32x4, Operators::VectorHalf::High>>(configuration);
+    case Instructions::i32x4_extend_low_i16x8_u.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<u16x4, u32x4, Operators::VectorHalf::Low>>(configuration);
+    case Instructions::i32x4_extend_high_i16x8_u.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<u16x4, u32x4, Operators::VectorHalf::High>>(configuration);
+    case Instructions::i32x4_shl.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorShiftLeft<u32x4>, i32>(configuration);
+    case Instructions::i32x4_shr_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorShiftRight<i32x4>, i32>(configuration);
+    case Instructions::i32x4_shr_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorShiftRight<u32x4>, i32>(configuration);
+    case Instructions::i32x4_add.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<u32x4, Operators::Add>>(configuration);
+    case Instructions::i32x4_sub.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<u32x4, Operators::Subtract>>(configuration);
+    case Instructions::i32x4_mul.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<u32x4, Operators::Multiply>>(configuration);
+    case Instructions::i32x4_min_s.value():
+        return binary_numeric_operation<u128, u128, Operators::LaneWise<i32x4, Operators::Minimum>>(configuration);
+    case Instructions::i32x4_min_u.value():
+        return binary_numeric_operation<u128, u128, Operators::LaneWise<u32x4, Operators::Minimum>>(configuration);
+    case Instructions::i32x4_max_s.value():
+        return binary_numeric_operation<u128, u128, Operators::LaneWise<i32x4, Operators::Maximum>>(configuration);
+    case Instructions::i32x4_max_u.value():
+        return binary_numeric_operation<u128, u128, Operators::LaneWise<u32x4, Operators::Maximum>>(configuration);
+    case Instructions::i32x4_dot_i16x8_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorDot>(configuration);
+    case Instructions::i32x4_extmul_low_i16x8_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendedMultiply<i16x4, i32x4, Operators::VectorHalf::Low>>(configuration);
+    case Instructions::i32x4_extmul_high_i16x8_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendedMultiply<i16x4, i32x4, Operators::VectorHalf::High>>(configuration);
+    case Instructions::i32x4_extmul_low_i16x8_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendedMultiply<u16x4, u32x4, Operators::VectorHalf::Low>>(configuration);
+    case Instructions::i32x4_extmul_high_i16x8_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendedMultiply<u16x4, u32x4, Operators::VectorHalf::High>>(configuration);
+    case Instructions::i64x2_abs.value():
+        return unary_operation<u128, u128, Operators::VectorAbsolute<i64x2>>(configuration);
+    case Instructions::i64x2_neg.value():
+        return unary_operation<u128, u128, Operators::Vectorized<u64x2, Operators::Negate>>(configuration);
+    case Instructions::i64x2_all_true.value():
+        return unary_operation<u128, i32, Operators::VectorAllTrue<u64x2>>(configuration);
+    case Instructions::i64x2_bitmask.value():
+        return unary_operation<u128, i32, Operators::VectorBitmask<i64x2>>(configuration);
+    case Instructions::i64x2_extend_low_i32x4_s.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<i32x2, i64x2, Operators::VectorHalf::Low>>(configuration);
+    case Instructions::i64x2_extend_high_i32x4_s.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<i32x2, i64x2, Operators::VectorHalf::High>>(configuration);
+    case Instructions::i64x2_extend_low_i32x4_u.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<u32x2, u64x2, Operators::VectorHalf::Low>>(configuration);
+    case Instructions::i64x2_extend_high_i32x4_u.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<u32x2, u64x2, Operators::VectorHalf::High>>(configuration);
+    case Instructions::i64x2_shl.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorShiftLeft<u64x2>, i32>(configuration);
+    case Instructions::i64x2_shr_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorShiftRight<i64x2>, i32>(configuration);
+    case Instructions::i64x2_shr_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorShiftRight<u64x2>, i32>(configuration);
+    case Instructions::i64x2_add.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<u64x2, Operators::Add>>(configuration);
+    case Instructions::i64x2_sub.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<u64x2, Operators::Subtract>>(configuration);
+    case Instructions::i64x2_mul.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<u64x2, Operators::Multiply>>(configuration);
+    case Instructions::i64x2_eq.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<i64x2, Operators::Equals>>(configuration);
+    case Instructions::i64x2_ne.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<i64x2, Operators::NotEquals>>(configuration);
+    case Instructions::i64x2_lt_s.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<i64x2, Operators::LessThan>>(configuration);
+    case Instructions::i64x2_gt_s.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<i64x2, Operators::GreaterThan>>(configuration);
+    case Instructions::i64x2_le_s.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<i64x2, Operators::LessThanOrEquals>>(configuration);
+    case Instructions::i64x2_ge_s.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<i64x2, Operators::GreaterThanOrEquals>>(configuration);
+    case Instructions::i64x2_extmul_low_i32x4_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendedMultiply<i32x2, i64x2, Operators::VectorHalf::Low>>(configuration);
+    case Instructions::i64x2_extmul_high_i32x4_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendedMultiply<i32x2, i64x2, Operators::VectorHalf::High>>(configuration);
+    case Instructions::i64x2_extmul_low_i32x4_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendedMultiply<u32x2, u64x2, Operators::VectorHalf::Low>>(configuration);
+    case Instructions::i64x2_extmul_high_i32x4_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendedMultiply<u32x2, u64x2, Operators::VectorHalf::High>>(configuration);
+    case Instructions::f32x4_abs.value():
+        return unary_operation<u128, u128, Operators::VectorAbsolute<f32x4>>(configuration);
+    case Instructions::f32x4_neg.value():
+        return unary_operation<u128, u128, Operators::Vectorized<f32x4, Operators::Negate>>(configuration);
+    case Instructions::f32x4_sqrt.value():
+        return unary_operation<u128, u128, Operators::LaneWise<f32x4, Operators::SquareRoot>>(configuration);
+    case Instructions::f32x4_add.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<f32x4, Operators::Add>>(configuration);
+    case Instructions::f32x4_sub.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<f32x4, Operators::Subtract>>(configuration);
+    case Instructions::f32x4_mul.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<f32x4, Operators::Multiply>>(configuration);
+    case Instructions::f32x4_div.value():
+        return binary_numeric_operation<u128, u128, Operators::LaneWise<f32x4, Operators::Divide>>(configuration);
+    case Instructions::f32x4_min.value():
+        return binary_numeric_operation<u128, u128, Operators::LaneWise<f32x4, Operators::Minimum>>(configuration);
+    case Instructions::f32x4_max.value():
+        return binary_numeric_operation<u128, u128, Operators::LaneWise<f32x4, Operators::Maximum>>(configuration);
+    case Instructions::f32x4_pmin.value():
+        return binary_numeric_operation<u128, u128, Operators::LaneWise<f32x4, Operators::PseudoMinimum>>(configuration);
+    case Instructions::f32x4_pmax.value():
+        return binary_numeric_operation<u128, u128, Operators::LaneWise<f32x4, Operators::PseudoMaximum>>(configuration);
+    case Instructions::f64x2_abs.value():
+        return unary_operation<u128, u128, Operators::VectorAbsolute<f64x2>>(configuration);
+    case Instructions::f64x2_neg.value():
+        return unary_operation<u128, u128, Operators::Vectorized<f64x2, Operators::Negate>>(configuration);
+    case Instructions::f64x2_sqrt.value():
+        return unary_operation<u128, u128, Operators::LaneWise<f64x2, Operators::SquareRoot>>(configuration);
+    case Instructions::f64x2_add.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<f64x2, Operators::Add>>(configuration);
+    case Instructions::f64x2_sub.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<f64x2, Operators::Subtract>>(configuration);
+    case Instructions::f64x2_mul.value():
+        return binary_numeric_operation<u128, u128, Operators::Vectorized<f64x2, Operators::Multiply>>(configuration);
+    case Instructions::f64x2_div.value():
+        return binary_numeric_operation<u128, u128, Operators::LaneWise<f64x2, Operators::Divide>>(configuration);
+    case Instructions::f64x2_min.value():
+        return binary_numeric_operation<u128, u128, Operators::LaneWise<f64x2, Operators::Minimum>>(configuration);
+    case Instructions::f64x2_max.value():
+        return binary_numeric_operation<u128, u128, Operators::LaneWise<f64x2, Operators::Maximum>>(configuration);
+    case Instructions::f64x2_pmin.value():
+        return binary_numeric_operation<u128, u128, Operators::LaneWise<f64x2, Operators::PseudoMinimum>>(configuration);
+    case Instructions::f64x2_pmax.value():
+        return binary_numeric_operation<u128, u128, Operators::LaneWise<f64x2, Operators::PseudoMaximum>>(configuration);
+    case Instructions::i32x4_trunc_sat_f32x4_s.value():
+        return unary_operation<u128, u128, Operators::LaneWiseConvert<f32x4, i32x4, Operators::SaturatingTruncate<i32>>>(configuration);
+    case Instructions::i32x4_trunc_sat_f32x4_u.value():
+        return unary_operation<u128, u128, Operators::LaneWiseConvert<f32x4, u32x4, Operators::SaturatingTruncate<u32>>>(configuration);
+    case Instructions::f32x4_convert_i32x4_s.value():
+        return unary_operation<u128, u128, Operators::VectorConvert<i32x4, f32x4>>(configuration);
+    case Instructions::f32x4_convert_i32x4_u.value():
+        return unary_operation<u128, u128, Operators::VectorConvert<u32x4, f32x4>>(configuration);
+    case Instructions::i32x4_trunc_sat_f64x2_s_zero.value():
+        return unary_operation<u128, u128, Operators::LaneWiseConvert<f64x2, i32x4, Operators::SaturatingTruncate<i32>>>(configuration);
+    case Instructions::i32x4_trunc_sat_f64x2_u_zero.value():
+        return unary_operation<u128, u128, Operators::LaneWiseConvert<f64x2, u32x4, Operators::SaturatingTruncate<u32>>>(configuration);
+    case Instructions::f64x2_convert_low_i32x4_s.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<i32x2, f64x2, Operators::VectorHalf::Low>>(configuration);
+    case Instructions::f64x2_convert_low_i32x4_u.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<u32x2, f64x2, Operators::VectorHalf::Low>>(configuration);
     case Instructions::data_drop.value():
     case Instructions::memory_copy.value():
     case Instructions::memory_fill.value():
@@ -966,6 +1505,404 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
     }
 }
 
+Optional<Result> BytecodeInterpreter::try_call_directly(Configuration& configuration, FunctionAddress address, Vector<Value>& arguments)
+{
+    // NOTE: Only interpret() knows how to count instructions.
+    if (configuration.should_limit_instruction_count())
+        return {};
+
+    auto* function = configuration.store().get(address);
+    if (!function || !function->has<WasmFunction>())
+        return {};
+    if (!ensure_lowered(configuration.store(), function->get<WasmFunction>()))
+        return {};
+    auto& type = function->get<WasmFunction>().type();
+
+    m_trap.clear();
+    auto frame_base = m_value_stack_base;
+    if (!ensure_value_stack_size(frame_base + max(arguments.size(), type.results().size())))
+        return Result { *m_trap };
+    for (size_t i = 0; i < arguments.size(); ++i)
+        m_value_stack[frame_base + i] = LoweredFunction::slot_from_value(arguments[i]);
+
+    auto* previous_reservation = GuardedMemory::active_reservation();
+    GuardedMemory::TrapScope trap_scope;
+    GuardedMemory::enter(trap_scope);
+    if (sigsetjmp(trap_scope.jump_buffer, 0) != 0) {
+        // NOTE: We only get here through an out-of-bounds access to a guarded memory.
+        GuardedMemory::leave(trap_scope);
+        GuardedMemory::set_active_reservation(previous_reservation);
+        m_trap = Trap { "Memory access out of bounds" };
+        return Result { *m_trap };
+    }
+    auto succeeded = call_lowered(configuration, address, frame_base);
+    GuardedMemory::leave(trap_scope);
+    GuardedMemory::set_active_reservation(previous_reservation);
+    if (!succeeded)
+        return Result { *m_trap };
+
+    // NOTE: Like Configuration::execute(), this returns the results in the order they are popped off the stack.
+    Vector<Value> results;
+    results.ensure_capacity(type.results().size());
+    for (size_t i = type.results().size(); i > 0; --i)
+        results.unchecked_append(LoweredFunction::value_from_slot(type.results()[i - 1], m_value_stack[frame_base + i - 1]));
+    return Result { move(results) };
+}
+
+bool BytecodeInterpreter::ensure_value_stack_size(size_t size)
+{
+    if (size <= m_value_stack.size())
+        return true;
+    if (size > Constants::max_allowed_value_stack_slots || m_value_stack.try_resize(min(max(size, m_value_stack.size() * 2), Constants::max_allowed_value_stack_slots)).is_error()) {
+        m_trap = Trap { "Value stack exhausted" };
+        return false;
+    }
+    return true;
+}
+
+bool BytecodeInterpreter::ensure_lowered(Store& store, WasmFunction& function)
+{
+    if (function.lowered_function())
+        return true;
+    if (function.cannot_be_lowered())
+        return false;
+
+    auto lowered_function = LoweredFunction::create(store, function);
+    if (!lowered_function) {
+        dbgln_if(WASM_TRACE_DEBUG, "Failed to lower a function, interpreting it instead");
+        function.set_cannot_be_lowered();
+        return false;
+    }
+    function.set_lowered_function(lowered_function.release_nonnull());
+    return true;
+}
+
+bool BytecodeInterpreter::call_lowered(Configuration& configuration, FunctionAddress address, size_t frame_base)
+{
+    auto* function = configuration.store().get(address);
+    auto* wasm_function = function->get_pointer<WasmFunction>();
+    if (wasm_function && ensure_lowered(configuration.store(), *wasm_function))
+        return execute_lowered(configuration, *wasm_function, frame_base);
+
+    // NOTE: Host functions, and wasm functions that couldn't be lowered, take and return their values on the Configuration's stack.
+    FunctionType const* type { nullptr };
+    function->visit([&](auto const& callee) { type = &callee.type(); });
+    Vector<Value> arguments;
+    arguments.ensure_capacity(type->parameters().size());
+    for (size_t i = 0; i < type->parameters().size(); ++i)
+        arguments.unchecked_append(LoweredFunction::value_from_slot(type->parameters()[i], m_value_stack[frame_base + i]));
+
+    Result result { Trap { ""sv } };
+    {
+        // NOTE: The callee may call back into this interpreter, which must leave the frames below alone.
+        TemporaryChange base_change { m_value_stack_base, m_value_stack.size() };
+        // NOTE: Faults in the callee are none of our business, it does its own bounds checks.
+        GuardedMemory::set_active_reservation(nullptr);
+        if (wasm_function) {
+            CallFrameHandle handle { *this, configuration };
+            result = configuration.call(*this, address, move(arguments));
+        } else {
+            result = function->get<HostFunction>().function()(configuration, arguments);
+        }
+    }
+
+    if (result.is_trap()) {
+        m_trap = move(result.trap());
+        return false;
+    }
+
+    auto& values = result.values();
+    if (!ensure_value_stack_size(frame_base + values.size()))
+        return false;
+    for (size_t i = 0; i < values.size(); ++i)
+        m_value_stack[frame_base + i] = LoweredFunction::slot_from_value(values[values.size() - i - 1]);
+    return true;
+}
+
+bool BytecodeInterpreter::call_indirect_lowered(Configuration& configuration, ModuleInstance const& module, LoweredInstruction const& instruction, u32 index, size_t frame_base)
+{
+    auto& store = configuration.store();
+    auto* table = store.get(TableAddress { instruction.immediate });
+    if (index >= table->elements().size()) {
+        m_trap = Trap { "Indirect call index out of bounds" };
+        return false;
+    }
+    auto& element = table->elements()[index];
+    if (!element.has_value() || !element->ref().has<Reference::Func>()) {
+        m_trap = Trap { "Indirect call to a null or non-function reference" };
+        return false;
+    }
+
+    auto address = element->ref().get<Reference::Func>().address;
+    FunctionType const* type { nullptr };
+    store.get(address)->visit([&](auto const& callee) { type = &callee.type(); });
+    auto& expected_type = module.types()[instruction.c];
+    if (type->parameters() != expected_type.parameters() || type->results() != expected_type.results()) {
+        m_trap = Trap { "Indirect call type mismatch" };
+        return false;
+    }
+
+    return call_lowered(configuration, address, frame_base + instruction.b);
+}
+
+bool BytecodeInterpreter::execute_lowered(Configuration& configuration, WasmFunction& function, size_t frame_base)
+{
+    if (m_stack_info.size_free() < Constants::minimum_stack_space_to_keep_free) [[unlikely]] {
+        m_trap = Trap { "Call stack exhausted" };
+        return false;
+    }
+
+    VERIFY(function.lowered_function());
+    auto& lowered = *function.lowered_function();
+    if (!ensure_value_stack_size(frame_base + lowered.frame_size()))
+        return false;
+
+    auto* slots = m_value_stack.data() + frame_base;
+    for (size_t i = lowered.parameter_count(); i < lowered.local_count(); ++i)
+        slots[i] = 0;
+
+    return run_lowered(configuration, function, frame_base, 0);
+}
+
+bool BytecodeInterpreter::run_lowered(Configuration& configuration, WasmFunction& function, size_t frame_base, size_t start_ip)
+{
+    auto& lowered = *function.lowered_function();
+    auto& store = configuration.store();
+    auto& module = function.module();
+    auto* slots = m_value_stack.data() + frame_base;
+
+#define __ENUMERATE_LOWERED_NUMERIC_OPCODE(name, ...) &&handle_##name,
+#define __ENUMERATE_LOWERED_GUARDED_MEMORY_OPCODE(name, ...) &&handle_##name##_unchecked,
+#define __ENUMERATE_LOWERED_CONTROL_OPCODE(name) &&handle_##name,
+    static void* const checked_dispatch_table[] = {
+        ENUMERATE_LOWERED_BINARY_OPERATIONS(__ENUMERATE_LOWERED_NUMERIC_OPCODE)
+            ENUMERATE_LOWERED_UNARY_OPERATIONS(__ENUMERATE_LOWERED_NUMERIC_OPCODE)
+                ENUMERATE_LOWERED_LOAD_OPERATIONS(__ENUMERATE_LOWERED_NUMERIC_OPCODE)
+                    ENUMERATE_LOWERED_STORE_OPERATIONS(__ENUMERATE_LOWERED_NUMERIC_OPCODE)
+                        ENUMERATE_LOWERED_CONTROL_OPERATIONS(__ENUMERATE_LOWERED_CONTROL_OPCODE)
+    };
+    // NOTE: Accesses to a guarded memory can't go past its reservation, and anything past its size faults
+    //       into the TrapScope set up by try_call_directly(), so these skip the bounds checks.
+    static void* const guarded_dispatch_table[] = {
+        ENUMERATE_LOWERED_BINARY_OPERATIONS(__ENUMERATE_LOWERED_NUMERIC_OPCODE)
+            ENUMERATE_LOWERED_UNARY_OPERATIONS(__ENUMERATE_LOWERED_NUMERIC_OPCODE)
+                ENUMERATE_LOWERED_LOAD_OPERATIONS(__ENUMERATE_LOWERED_GUARDED_MEMORY_OPCODE)
+                    ENUMERATE_LOWERED_STORE_OPERATIONS(__ENUMERATE_LOWERED_GUARDED_MEMORY_OPCODE)
+                        ENUMERATE_LOWERED_CONTROL_OPERATIONS(__ENUMERATE_LOWERED_CONTROL_OPCODE)
+    };
+#undef __ENUMERATE_LOWERED_NUMERIC_OPCODE
+#undef __ENUMERATE_LOWERED_GUARDED_MEMORY_OPCODE
+#undef __ENUMERATE_LOWERED_CONTROL_OPCODE
+    static_assert(array_size(checked_dispatch_table) == to_underlying(LoweredOpCode::__Count));
+    static_assert(array_size(guarded_dispatch_table) == to_underlying(LoweredOpCode::__Count));
+
+    // NOTE: Calls and memory.grow may move (or unguard) the memory, so these are reloaded after each of them.
+    MemoryInstance* memory = nullptr;
+    u8* memory_data = nullptr;
+    u64 memory_size = 0;
+    void* const* dispatch_table = checked_dispatch_table;
+    auto reload_memory = [&] {
+        if (module.memories().is_empty()) {
+            GuardedMemory::set_active_reservation(nullptr);
+            return;
+        }
+        memory = store.get(module.memories().first());
+        memory_data = memory->data().data();
+        memory_size = memory->size();
+        dispatch_table = memory->is_guarded() ? guarded_dispatch_table : checked_dispatch_table;
+        GuardedMemory::set_active_reservation(memory->is_guarded() ? memory_data : nullptr);
+    };
+    reload_memory();
+
+    auto const* instructions = lowered.instructions().data();
+    auto const* branch_targets = lowered.branch_targets().data();
+    auto const* ip = instructions + start_ip;
+
+#define DISPATCH() goto* dispatch_table[to_underlying(ip->opcode)]
+#define DISPATCH_NEXT() \
+    do {                \
+        ++ip;           \
+        DISPATCH();     \
+    } while (false)
+#define TRAP(reason)              \
+    do {                          \
+        m_trap = Trap { reason }; \
+        return false;             \
+    } while (false)
+
+    DISPATCH();
+
+#define __HANDLE_BINARY_OPERATION(name, PopType, PushType, Operator)                                                   \
+    handle_##name:                                                                                                     \
+    {                                                                                                                  \
+        StringView error;                                                                                              \
+        auto call_result = Operators::Operator {}(from_slot<PopType>(slots[ip->b]), from_slot<PopType>(slots[ip->c])); \
+        if (!store_operation_result<PushType>(slots[ip->a], move(call_result), error)) [[unlikely]]                    \
+            TRAP(error);                                                                                               \
+        DISPATCH_NEXT();                                                                                               \
+    }
+    ENUMERATE_LOWERED_BINARY_OPERATIONS(__HANDLE_BINARY_OPERATION)
+#undef __HANDLE_BINARY_OPERATION
+
+#define __HANDLE_UNARY_OPERATION(name, PopType, PushType, Operator)                                 \
+    handle_##name:                                                                                  \
+    {                                                                                               \
+        StringView error;                                                                           \
+        auto call_result = Operators::Operator {}(from_slot<PopType>(slots[ip->b]));                \
+        if (!store_operation_result<PushType>(slots[ip->a], move(call_result), error)) [[unlikely]] \
+            TRAP(error);                                                                            \
+        DISPATCH_NEXT();                                                                            \
+    }
+    ENUMERATE_LOWERED_UNARY_OPERATIONS(__HANDLE_UNARY_OPERATION)
+#undef __HANDLE_UNARY_OPERATION
+
+#define __HANDLE_LOAD_OPERATION(name, ReadType, PushType)                                                   \
+    handle_##name:                                                                                          \
+    {                                                                                                       \
+        auto address = static_cast<u64>(from_slot<u32>(slots[ip->b])) + ip->immediate;                      \
+        if (address + sizeof(ReadType) > memory_size) [[unlikely]]                                          \
+            TRAP("Memory access out of bounds"sv);                                                          \
+        slots[ip->a] = to_slot(static_cast<PushType>(read_little_endian<ReadType>(memory_data + address))); \
+        DISPATCH_NEXT();                                                                                    \
+    }
+    ENUMERATE_LOWERED_LOAD_OPERATIONS(__HANDLE_LOAD_OPERATION)
+#undef __HANDLE_LOAD_OPERATION
+
+#define __HANDLE_GUARDED_LOAD_OPERATION(name, ReadType, PushType)                                           \
+    handle_##name##_unchecked:                                                                              \
+    {                                                                                                       \
+        auto address = static_cast<u64>(from_slot<u32>(slots[ip->b])) + ip->immediate;                      \
+        slots[ip->a] = to_slot(static_cast<PushType>(read_little_endian<ReadType>(memory_data + address))); \
+        DISPATCH_NEXT();                                                                                    \
+    }
+    ENUMERATE_LOWERED_LOAD_OPERATIONS(__HANDLE_GUARDED_LOAD_OPERATION)
+#undef __HANDLE_GUARDED_LOAD_OPERATION
+
+#define __HANDLE_STORE_OPERATION(name, PopType, StoreType)                                                    \
+    handle_##name:                                                                                            \
+    {                                                                                                         \
+        auto address = static_cast<u64>(from_slot<u32>(slots[ip->b])) + ip->immediate;                        \
+        if (address + sizeof(StoreType) > memory_size) [[unlikely]]                                           \
+            TRAP("Memory access out of bounds"sv);                                                            \
+        write_little_endian(memory_data + address, static_cast<StoreType>(from_slot<PopType>(slots[ip->a]))); \
+        DISPATCH_NEXT();                                                                                      \
+    }
+    ENUMERATE_LOWERED_STORE_OPERATIONS(__HANDLE_STORE_OPERATION)
+#undef __HANDLE_STORE_OPERATION
+
+#define __HANDLE_GUARDED_STORE_OPERATION(name, PopType, StoreType)                                            \
+    handle_##name##_unchecked:                                                                                \
+    {                                                                                                         \
+        auto address = static_cast<u64>(from_slot<u32>(slots[ip->b])) + ip->immediate;                        \
+        write_little_endian(memory_data + address, static_cast<StoreType>(from_slot<PopType>(slots[ip->a]))); \
+        DISPATCH_NEXT();                                                                                      \
+    }
+    ENUMERATE_LOWERED_STORE_OPERATIONS(__HANDLE_GUARDED_STORE_OPERATION)
+#undef __HANDLE_GUARDED_STORE_OPERATION
+
+handle_copy:
+    slots[ip->a] = slots[ip->b];
+    DISPATCH_NEXT();
+
+handle_constant:
+    slots[ip->a] = ip->immediate;
+    DISPATCH_NEXT();
+
+handle_jump : {
+    auto& target = branch_targets[ip->immediate];
+    move_branch_values(slots, target.result_slot, ip->b, ip->c);
+    ip = instructions + target.ip;
+    DISPATCH();
+}
+
+handle_jump_if:
+    if (from_slot<u32>(slots[ip->a]) != 0)
+        goto handle_jump;
+    DISPATCH_NEXT();
+
+handle_jump_unless:
+    if (from_slot<u32>(slots[ip->a]) == 0) {
+        ip = instructions + branch_targets[ip->immediate].ip;
+        DISPATCH();
+    }
+    DISPATCH_NEXT();
+
+handle_jump_table : {
+    auto index = min(from_slot<u32>(slots[ip->a]), ip->d);
+    auto& target = branch_targets[ip->immediate + index];
+    move_branch_values(slots, target.result_slot, ip->b, ip->c);
+    ip = instructions + target.ip;
+    DISPATCH();
+}
+
+handle_return_:
+    move_branch_values(slots, 0, ip->b, ip->c);
+    return true;
+
+handle_call:
+    if (!call_lowered(configuration, FunctionAddress { ip->immediate }, frame_base + ip->b))
+        return false;
+    slots = m_value_stack.data() + frame_base;
+    reload_memory();
+    DISPATCH_NEXT();
+
+handle_call_indirect:
+    if (!call_indirect_lowered(configuration, module, *ip, from_slot<u32>(slots[ip->a]), frame_base))
+        return false;
+    slots = m_value_stack.data() + frame_base;
+    reload_memory();
+    DISPATCH_NEXT();
+
+handle_trap:
+    TRAP(lowered.trap_messages()[ip->immediate]);
+
+handle_select:
+    slots[ip->a] = from_slot<u32>(slots[ip->d]) != 0 ? slots[ip->b] : slots[ip->c];
+    DISPATCH_NEXT();
+
+handle_global_get:
+    slots[ip->a] = LoweredFunction::slot_from_value(store.get(GlobalAddress { ip->immediate })->value());
+    DISPATCH_NEXT();
+
+handle_global_set:
+    store.get(GlobalAddress { ip->immediate })->set_value(LoweredFunction::value_from_slot(ValueType(static_cast<ValueType::Kind>(ip->c)), slots[ip->b]));
+    DISPATCH_NEXT();
+
+handle_memory_size:
+    slots[ip->a] = to_slot(static_cast<i32>(memory_size / Constants::page_size));
+    DISPATCH_NEXT();
+
+handle_memory_grow : {
+    auto old_pages = static_cast<i32>(memory_size / Constants::page_size);
+    auto pages_to_grow = from_slot<u32>(slots[ip->b]);
+    // NOTE: Anything past 2^16 pages would fail anyway, this just keeps the size computation from overflowing.
+    auto did_grow = pages_to_grow <= 65536 && memory->grow(pages_to_grow * Constants::page_size);
+    slots[ip->a] = to_slot(did_grow ? old_pages : -1);
+    reload_memory();
+    DISPATCH_NEXT();
+}
+
+handle_memory_init : {
+    auto& data = *store.get(DataAddress { ip->immediate });
+    auto destination = static_cast<u64>(from_slot<u32>(slots[ip->b]));
+    auto source = static_cast<u64>(from_slot<u32>(slots[ip->c]));
+    auto count = static_cast<u64>(from_slot<u32>(slots[ip->d]));
+    if (source + count > data.size() || destination + count > memory_size)
+        TRAP("Memory access out of bounds"sv);
+    if (count != 0)
+        __builtin_memcpy(memory_data + destination, data.data().data() + source, count);
+    DISPATCH_NEXT();
+}
+
+handle_ref_is_null:
+    slots[ip->a] = slots[ip->b] == 0 ? 1 : 0;
+    DISPATCH_NEXT();
+
+#undef DISPATCH
+#undef DISPATCH_NEXT
+#undef TRAP
+}
+
 void DebuggerBytecodeInterpreter::interpret(Configuration& configuration, InstructionPointer& ip, Instruction const& instruction)
 {
     if (pre_interpret_hook) {
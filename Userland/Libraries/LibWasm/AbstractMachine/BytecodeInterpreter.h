@@ -9,11 +9,13 @@
 #include <AK/StackInfo.h>
 #include <LibWasm/AbstractMachine/Configuration.h>
 #include <LibWasm/AbstractMachine/Interpreter.h>
+#include <LibWasm/AbstractMachine/LoweredFunction.h>
 
 namespace Wasm {
 
 struct BytecodeInterpreter : public Interpreter {
     virtual void interpret(Configuration&) override;
+    virtual Optional<Result> try_call_directly(Configuration&, FunctionAddress, Vector<Value>& arguments) override;
     virtual ~BytecodeInterpreter() override = default;
     virtual bool did_trap() const override { return m_trap.has_value(); }
     virtual String trap_reason() const override { return m_trap.value().reason; }
@@ -39,14 +41,25 @@ protected:
     void load_and_push(Configuration&, Instruction const&);
     template<typename PopT, typename StoreT>
     void pop_and_store(Configuration&, Instruction const&);
-    void store_to_memory(Configuration&, Instruction const&, ReadonlyBytes data, i32 base);
+    void store_to_memory(Configuration&, Instruction::MemoryArgument const&, ReadonlyBytes data, i32 base);
     void call_address(Configuration&, FunctionAddress);
 
-    template<typename PopType, typename PushType, typename Operator>
-    void binary_numeric_operation(Configuration&);
+    // Returns the memory a load of `size` bytes refers to, or traps if it's out of bounds.
+    Optional<Bytes> memory_range(Configuration&, Instruction::MemoryArgument const&, i32 base, size_t size);
+    // Reads a ReadT and turns it into a v128 with Operator.
+    template<typename ReadT, typename Operator>
+    void load_and_push_vector(Configuration&, Instruction const&);
+    template<typename VectorType>
+    void load_vector_lane(Configuration&, Instruction const&);
+    template<typename VectorType>
+    void store_vector_lane(Configuration&, Instruction const&);
 
-    template<typename PopType, typename PushType, typename Operator>
-    void unary_operation(Configuration&);
+    // Any extra arguments are passed on to the operator's constructor.
+    template<typename PopTypeLHS, typename PushType, typename Operator, typename PopTypeRHS = PopTypeLHS, typename... Args>
+    void binary_numeric_operation(Configuration&, Args&&...);
+
+    template<typename PopType, typename PushType, typename Operator, typename... Args>
+    void unary_operation(Configuration&, Args&&...);
 
     template<typename V, typename T>
     MakeUnsigned<T> checked_unsigned_truncate(V);
@@ -65,8 +78,20 @@ protected:
         return m_trap.has_value();
     }
 
+    // Lowered functions run in frames on a value stack of their own, see LoweredFunction.
+    bool call_lowered(Configuration&, FunctionAddress, size_t frame_base);
+    bool call_indirect_lowered(Configuration&, ModuleInstance const&, LoweredInstruction const&, u32 index, size_t frame_base);
+    // Lowers the function on first use, returns false if it can't be lowered and has to be interpreted from its instructions.
+    bool ensure_lowered(Store&, WasmFunction&);
+    bool execute_lowered(Configuration&, WasmFunction&, size_t frame_base);
+    // Runs the (already lowered) function in the frame at `frame_base`, starting at instruction `start_ip`.
+    virtual bool run_lowered(Configuration&, WasmFunction&, size_t frame_base, size_t start_ip);
+    bool ensure_value_stack_size(size_t);
+
     Optional<Trap> m_trap;
     StackInfo m_stack_info;
+    Vector<u64> m_value_stack;
+    size_t m_value_stack_base { 0 };
 };
 
 struct DebuggerBytecodeInterpreter : public BytecodeInterpreter {
@@ -75,6 +100,9 @@ struct DebuggerBytecodeInterpreter : public BytecodeInterpreter {
     Function<bool(Configuration&, InstructionPointer&, Instruction const&)> pre_interpret_hook;
     Function<bool(Configuration&, InstructionPointer&, Instruction const&, Interpreter const&)> post_interpret_hook;
 
+    // NOTE: The hooks need to see every instruction, so always go through the Configuration.
+    virtual Optional<Result> try_call_directly(Configuration&, FunctionAddress, Vector<Value>&) override { return {}; }
+
 private:
     virtual void interpret(Configuration&, InstructionPointer&, Instruction const&) override;
 };
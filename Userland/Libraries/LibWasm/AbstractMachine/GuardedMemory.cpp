@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/System.h>
+#include <LibWasm/AbstractMachine/GuardedMemory.h>
+#include <errno.h>
+#include <signal.h>
+#include <sys/mman.h>
+
+namespace Wasm::GuardedMemory {
+
+thread_local u8* s_active_reservation { nullptr };
+static thread_local TrapScope* s_current_trap_scope { nullptr };
+
+static struct sigaction s_previous_segv_action;
+static struct sigaction s_previous_bus_action;
+
+static void handle_fault(int signal, siginfo_t* info, void* context)
+{
+    auto* scope = s_current_trap_scope;
+    auto* reservation = s_active_reservation;
+    if (scope && reservation) {
+        auto* address = static_cast<u8*>(info->si_addr);
+        // NOTE: Not every system reports the faulting address (Serenity doesn't), in which case we have to assume that
+        //       a fault while accessing guarded memory was caused by that access.
+        if (!address || (address >= reservation && address < reservation + Constants::guarded_memory_reservation_size))
+            siglongjmp(scope->jump_buffer, 1);
+    }
+
+    // Not ours, hand it to whoever was there before us.
+    auto& previous = signal == SIGBUS ? s_previous_bus_action : s_previous_segv_action;
+    if ((previous.sa_flags & SA_SIGINFO) && previous.sa_sigaction) {
+        previous.sa_sigaction(signal, info, context);
+        return;
+    }
+    if (previous.sa_handler == SIG_DFL || previous.sa_handler == SIG_IGN) {
+        // NOTE: Returning re-executes the faulting instruction, which now gets the default treatment.
+        struct sigaction default_action { };
+        default_action.sa_handler = SIG_DFL;
+        sigemptyset(&default_action.sa_mask);
+        ::sigaction(signal, &default_action, nullptr);
+        return;
+    }
+    previous.sa_handler(signal);
+}
+
+static void install_fault_handler()
+{
+    static bool const s_installed = [] {
+        struct sigaction action { };
+        action.sa_sigaction = handle_fault;
+        // NOTE: SA_NODEFER keeps the signal unblocked after we siglongjmp() out of the handler,
+        //       which saves TrapScope from saving and restoring the signal mask on every entry.
+        action.sa_flags = SA_SIGINFO | SA_NODEFER;
+        sigemptyset(&action.sa_mask);
+        MUST(Core::System::sigaction(SIGSEGV, &action, &s_previous_segv_action));
+        MUST(Core::System::sigaction(SIGBUS, &action, &s_previous_bus_action));
+        return true;
+    }();
+    (void)s_installed;
+}
+
+ErrorOr<u8*> reserve()
+{
+    if constexpr (!is_supported)
+        return Error::from_errno(ENOTSUP);
+    install_fault_handler();
+    auto* reservation = TRY(Core::System::mmap(nullptr, Constants::guarded_memory_reservation_size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0, 0, "Wasm memory"sv));
+    return static_cast<u8*>(reservation);
+}
+
+void release(u8* reservation)
+{
+    MUST(Core::System::munmap(reservation, Constants::guarded_memory_reservation_size));
+}
+
+ErrorOr<void> commit(u8* reservation, size_t old_size, size_t new_size)
+{
+    VERIFY(new_size >= old_size && new_size <= Constants::guarded_memory_reservation_size);
+    if (new_size == old_size)
+        return {};
+    // NOTE: Freshly committed anonymous pages are zero-filled, which is exactly what the spec wants from memory.grow.
+    if (::mprotect(reservation + old_size, new_size - old_size, PROT_READ | PROT_WRITE) < 0)
+        return Error::from_syscall("mprotect"sv, -errno);
+    return {};
+}
+
+void enter(TrapScope& scope)
+{
+    scope.previous = s_current_trap_scope;
+    s_current_trap_scope = &scope;
+}
+
+void leave(TrapScope& scope)
+{
+    s_current_trap_scope = scope.previous;
+}
+
+}
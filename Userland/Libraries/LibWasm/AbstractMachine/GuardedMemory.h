@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Error.h>
+#include <AK/Types.h>
+#include <LibWasm/Constants.h>
+#include <setjmp.h>
+
+// On 64-bit hosts, a linear memory reserves its whole addressable range (plus a guard region) up front, and only
+// makes the first `size` bytes of it accessible. Such a memory grows in place, and since no u32 address plus u32
+// offset can reach past the reservation, code accessing it can skip bounds checks altogether: an out-of-bounds
+// access faults on an inaccessible page, and the fault is turned into a trap by the innermost active TrapScope.
+namespace Wasm::GuardedMemory {
+
+static constexpr bool is_supported = sizeof(FlatPtr) == 8;
+
+ErrorOr<u8*> reserve();
+void release(u8* reservation);
+ErrorOr<void> commit(u8* reservation, size_t old_size, size_t new_size);
+
+struct TrapScope {
+    sigjmp_buf jump_buffer;
+    TrapScope* previous { nullptr };
+};
+
+// Code that may access a guarded memory without bounds checks must run inside a TrapScope:
+//
+//     TrapScope scope;
+//     enter(scope);
+//     if (sigsetjmp(scope.jump_buffer, 0) != 0) {
+//         leave(scope);
+//         ... the access was out of bounds ...
+//     }
+//     ... accesses ...
+//     leave(scope);
+//
+// NOTE: A trap unwinds straight to the sigsetjmp() without running any destructors on the way,
+//       so the frames in between must not own anything.
+void enter(TrapScope&);
+void leave(TrapScope&);
+
+extern thread_local u8* s_active_reservation;
+
+// The reservation the current thread is accessing without bounds checks, if any. Faults are only turned into traps
+// while one is set, so it must be cleared while running anything else (e.g. host functions).
+inline u8* active_reservation() { return s_active_reservation; }
+inline void set_active_reservation(u8* reservation) { s_active_reservation = reservation; }
+
+}
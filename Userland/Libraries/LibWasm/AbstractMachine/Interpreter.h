@@ -13,6 +13,8 @@ namespace Wasm {
 struct Interpreter {
     virtual ~Interpreter() = default;
     virtual void interpret(Configuration&) = 0;
+    // Interpreters may run a function without going through the Configuration's stack; returning nothing falls back to interpret().
+    virtual Optional<Result> try_call_directly(Configuration&, FunctionAddress, Vector<Value>&) { return {}; }
     virtual bool did_trap() const = 0;
     virtual String trap_reason() const = 0;
     virtual void clear_trap() = 0;
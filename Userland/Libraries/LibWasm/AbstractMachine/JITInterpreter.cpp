@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <LibWasm/AbstractMachine/AbstractMachine.h>
+#include <LibWasm/AbstractMachine/GuardedMemory.h>
+#include <LibWasm/AbstractMachine/JITInterpreter.h>
+#include <LibWasm/AbstractMachine/LoweredFunction.h>
+#include <LibWasm/AbstractMachine/Operators.h>
+#include <LibWasm/JIT/Compiler.h>
+
+namespace Wasm {
+
+using JIT::NativeFrame;
+using JIT::NativeStatus;
+
+struct JITInterpreter::Runtime {
+    static NativeStatus trap(NativeFrame& frame, StringView reason)
+    {
+        frame.interpreter->m_trap = Trap { reason };
+        return NativeStatus::Trapped;
+    }
+
+    // Picks up everything a call (or memory.grow) may have moved.
+    static MemoryInstance* reload(NativeFrame& frame)
+    {
+        frame.slots = frame.interpreter->m_value_stack.data() + frame.frame_base;
+
+        auto& module = frame.function->module();
+        if (module.memories().is_empty()) {
+            GuardedMemory::set_active_reservation(nullptr);
+            return nullptr;
+        }
+        auto* memory = frame.configuration->store().get(module.memories().first());
+        frame.memory_data = memory->data().data();
+        frame.memory_size = memory->size();
+        GuardedMemory::set_active_reservation(memory->is_guarded() ? frame.memory_data : nullptr);
+        return memory;
+    }
+
+    static NativeStatus finish_call(NativeFrame& frame, LoweredInstruction const& instruction, bool succeeded)
+    {
+        if (!succeeded)
+            return NativeStatus::Trapped;
+        auto* memory = reload(frame);
+        // NOTE: A memory keeps its guard pages for good, so this shouldn't happen. If it ever does,
+        //       the rest of this function can't skip bounds checks anymore.
+        auto memory_lost_its_guard_pages = frame.assumes_guarded_memory && memory && !memory->is_guarded();
+        if (memory_lost_its_guard_pages || frame.interpreter->m_should_deoptimize_after_calls) [[unlikely]] {
+            frame.resume_ip = &instruction - frame.instructions + 1;
+            return NativeStatus::Deoptimized;
+        }
+        return NativeStatus::Ok;
+    }
+
+    static NativeStatus call(NativeFrame& frame, LoweredInstruction const& instruction)
+    {
+        auto succeeded = frame.interpreter->call_lowered(*frame.configuration, FunctionAddress { instruction.immediate }, frame.frame_base + instruction.b);
+        return finish_call(frame, instruction, succeeded);
+    }
+
+    static NativeStatus call_indirect(NativeFrame& frame, LoweredInstruction const& instruction)
+    {
+        auto succeeded = frame.interpreter->call_indirect_lowered(*frame.configuration, frame.function->module(), instruction, from_slot<u32>(frame.slots[instruction.a]), frame.frame_base);
+        return finish_call(frame, instruction, succeeded);
+    }
+
+    static NativeStatus trap_instruction(NativeFrame& frame, LoweredInstruction const& instruction)
+    {
+        return trap(frame, frame.function->lowered_function()->trap_messages()[instruction.immediate]);
+    }
+
+    static NativeStatus out_of_bounds(NativeFrame& frame, LoweredInstruction const&)
+    {
+        return trap(frame, "Memory access out of bounds"sv);
+    }
+
+    static NativeStatus global_get(NativeFrame& frame, LoweredInstruction const& instruction)
+    {
+        frame.slots[instruction.a] = LoweredFunction::slot_from_value(frame.configuration->store().get(GlobalAddress { instruction.immediate })->value());
+        return NativeStatus::Ok;
+    }
+
+    static NativeStatus global_set(NativeFrame& frame, LoweredInstruction const& instruction)
+    {
+        auto type = ValueType(static_cast<ValueType::Kind>(instruction.c));
+        frame.configuration->store().get(GlobalAddress { instruction.immediate })->set_value(LoweredFunction::value_from_slot(type, frame.slots[instruction.b]));
+        return NativeStatus::Ok;
+    }
+
+    static NativeStatus memory_grow(NativeFrame& frame, LoweredInstruction const& instruction)
+    {
+        auto* memory = frame.configuration->store().get(frame.function->module().memories().first());
+        auto old_pages = static_cast<i32>(memory->size() / Constants::page_size);
+        auto pages_to_grow = from_slot<u32>(frame.slots[instruction.b]);
+        // NOTE: Anything past 2^16 pages would fail anyway, this just keeps the size computation from overflowing.
+        auto did_grow = pages_to_grow <= 65536 && memory->grow(pages_to_grow * Constants::page_size);
+        frame.slots[instruction.a] = to_slot(did_grow ? old_pages : -1);
+        reload(frame);
+        return NativeStatus::Ok;
+    }
+
+    static NativeStatus memory_init(NativeFrame& frame, LoweredInstruction const& instruction)
+    {
+        auto& data = *frame.configuration->store().get(DataAddress { instruction.immediate });
+        auto destination = static_cast<u64>(from_slot<u32>(frame.slots[instruction.b]));
+        auto source = static_cast<u64>(from_slot<u32>(frame.slots[instruction.c]));
+        auto count = static_cast<u64>(from_slot<u32>(frame.slots[instruction.d]));
+        if (source + count > data.size() || destination + count > frame.memory_size)
+            return trap(frame, "Memory access out of bounds"sv);
+        if (count != 0)
+            __builtin_memcpy(frame.memory_data + destination, data.data().data() + source, count);
+        return NativeStatus::Ok;
+    }
+
+    template<typename PopType, typename PushType, typename Operator>
+    static NativeStatus binary_operation(NativeFrame& frame, LoweredInstruction const& instruction)
+    {
+        StringView error;
+        auto call_result = Operator {}(from_slot<PopType>(frame.slots[instruction.b]), from_slot<PopType>(frame.slots[instruction.c]));
+        if (!store_operation_result<PushType>(frame.slots[instruction.a], move(call_result), error))
+            return trap(frame, error);
+        return NativeStatus::Ok;
+    }
+
+    template<typename PopType, typename PushType, typename Operator>
+    static NativeStatus unary_operation(NativeFrame& frame, LoweredInstruction const& instruction)
+    {
+        StringView error;
+        auto call_result = Operator {}(from_slot<PopType>(frame.slots[instruction.b]));
+        if (!store_operation_result<PushType>(frame.slots[instruction.a], move(call_result), error))
+            return trap(frame, error);
+        return NativeStatus::Ok;
+    }
+
+    static JIT::RuntimeHelpers const& helpers()
+    {
+        static JIT::RuntimeHelpers const s_helpers = [] {
+            JIT::RuntimeHelpers helpers;
+#define __ENUMERATE_BINARY_HELPER(name, PopType, PushType, Operator) \
+    helpers.generic[to_underlying(LoweredOpCode::name)] = binary_operation<PopType, PushType, Operators::Operator>;
+#define __ENUMERATE_UNARY_HELPER(name, PopType, PushType, Operator) \
+    helpers.generic[to_underlying(LoweredOpCode::name)] = unary_operation<PopType, PushType, Operators::Operator>;
+            ENUMERATE_LOWERED_BINARY_OPERATIONS(__ENUMERATE_BINARY_HELPER)
+            ENUMERATE_LOWERED_UNARY_OPERATIONS(__ENUMERATE_UNARY_HELPER)
+#undef __ENUMERATE_BINARY_HELPER
+#undef __ENUMERATE_UNARY_HELPER
+            helpers.generic[to_underlying(LoweredOpCode::call)] = call;
+            helpers.generic[to_underlying(LoweredOpCode::call_indirect)] = call_indirect;
+            helpers.generic[to_underlying(LoweredOpCode::trap)] = trap_instruction;
+            helpers.generic[to_underlying(LoweredOpCode::global_get)] = global_get;
+            helpers.generic[to_underlying(LoweredOpCode::global_set)] = global_set;
+            helpers.generic[to_underlying(LoweredOpCode::memory_grow)] = memory_grow;
+            helpers.generic[to_underlying(LoweredOpCode::memory_init)] = memory_init;
+            helpers.out_of_bounds = out_of_bounds;
+            return helpers;
+        }();
+        return s_helpers;
+    }
+};
+
+JIT::NativeFunction const* JITInterpreter::native_function_for(WasmFunction& function, bool memory_is_guarded)
+{
+    if constexpr (!JIT::is_supported)
+        return nullptr;
+
+    if (!function.native_code())
+        function.set_native_code(make<JIT::NativeCode>());
+    auto& native_code = *function.native_code();
+    if (native_code.failed_to_compile)
+        return nullptr;
+
+    // NOTE: Code with bounds checks works for any memory, so it is reused even if the memory turns out to be guarded.
+    if (memory_is_guarded && native_code.for_guarded_memory)
+        return native_code.for_guarded_memory.ptr();
+    if (native_code.with_bounds_checks)
+        return native_code.with_bounds_checks.ptr();
+
+    auto& variant = memory_is_guarded ? native_code.for_guarded_memory : native_code.with_bounds_checks;
+    variant = JIT::compile(*function.lowered_function(), memory_is_guarded, Runtime::helpers());
+    if (!variant) {
+        dbgln_if(WASM_TRACE_DEBUG, "Failed to compile a function, interpreting it instead");
+        native_code.failed_to_compile = true;
+    }
+    return variant.ptr();
+}
+
+bool JITInterpreter::run_lowered(Configuration& configuration, WasmFunction& function, size_t frame_base, size_t start_ip)
+{
+    // NOTE: Compiled code can only be entered at the top, picking up anywhere else is left to the interpreter.
+    if (start_ip != 0)
+        return BytecodeInterpreter::run_lowered(configuration, function, frame_base, start_ip);
+
+    auto& module = function.module();
+    auto memory_is_guarded = !module.memories().is_empty() && configuration.store().get(module.memories().first())->is_guarded();
+    auto* native_function = native_function_for(function, memory_is_guarded);
+    if (!native_function)
+        return BytecodeInterpreter::run_lowered(configuration, function, frame_base, start_ip);
+
+    NativeFrame frame;
+    frame.instructions = function.lowered_function()->instructions().data();
+    frame.interpreter = this;
+    frame.configuration = &configuration;
+    frame.function = &function;
+    frame.frame_base = frame_base;
+    frame.assumes_guarded_memory = native_function->assumes_guarded_memory();
+    Runtime::reload(frame);
+
+    switch (native_function->entry()(&frame)) {
+    case NativeStatus::Ok:
+        return true;
+    case NativeStatus::Trapped:
+        return false;
+    case NativeStatus::Deoptimized:
+        return BytecodeInterpreter::run_lowered(configuration, function, frame_base, frame.resume_ip);
+    }
+    VERIFY_NOT_REACHED();
+}
+
+}
@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <LibWasm/AbstractMachine/BytecodeInterpreter.h>
+
+namespace Wasm {
+
+namespace JIT {
+class NativeFunction;
+}
+
+// Runs functions as machine code compiled from their lowered form (see JIT::compile()), wherever possible.
+// Anything that can't be compiled, or has to leave compiled code halfway through, runs in the BytecodeInterpreter instead.
+struct JITInterpreter : public BytecodeInterpreter {
+    virtual ~JITInterpreter() override = default;
+
+    // Makes compiled code hand over to the interpreter after every call it makes, which it otherwise only does
+    // in cases that are hard to set up. This is only meant for tests.
+    void set_should_deoptimize_after_calls(bool value) { m_should_deoptimize_after_calls = value; }
+
+protected:
+    virtual bool run_lowered(Configuration&, WasmFunction&, size_t frame_base, size_t start_ip) override;
+
+private:
+    // Called from compiled code, see JIT::RuntimeHelpers.
+    struct Runtime;
+
+    JIT::NativeFunction const* native_function_for(WasmFunction&, bool memory_is_guarded);
+
+    bool m_should_deoptimize_after_calls { false };
+};
+
+}
@@ -0,0 +1,673 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/AnyOf.h>
+#include <LibWasm/AbstractMachine/LoweredFunction.h>
+#include <LibWasm/Opcode.h>
+#include <LibWasm/Printer/Printer.h>
+
+namespace Wasm {
+
+// Turns a validated function body into a LoweredFunction.
+// The operand stack is tracked at compile time, and every stack entry is assigned the slot `local_count + height`
+// (its "canonical" slot). As an exception, `local.get` only records a reference to the local's own slot, which is
+// then read directly by the instruction consuming the value; such entries are copied to their canonical slot
+// ("materialized") whenever the local may change underneath them, or when control flow needs them in place.
+class FunctionLowerer {
+public:
+    FunctionLowerer(Store& store, WasmFunction const& function)
+        : m_store(store)
+        , m_module(function.module())
+        , m_lowered(adopt_own(*new LoweredFunction))
+    {
+        auto& type = function.type();
+        m_lowered->m_parameter_count = type.parameters().size();
+        m_lowered->m_local_count = type.parameters().size() + function.code().locals().size();
+        m_local_count = m_lowered->m_local_count;
+
+        // The function body is a block whose label is the function's return.
+        m_control_stack.append(ControlFrame {
+            .kind = ControlFrame::Kind::Block,
+            .height = 0,
+            .parameter_count = 0,
+            .result_count = static_cast<u32>(type.results().size()),
+            .target = allocate_branch_target(canonical_slot(0)),
+        });
+    }
+
+    NonnullOwnPtr<LoweredFunction> lower(Expression const& body)
+    {
+        for (auto& instruction : body.instructions()) {
+            if (m_unreachable)
+                skip(instruction);
+            else
+                lower(instruction);
+        }
+
+        auto frame = m_control_stack.take_last();
+        VERIFY(m_control_stack.is_empty());
+        end_frame(frame);
+        emit(LoweredOpCode::return_, 0, canonical_slot(0), frame.result_count);
+
+        m_lowered->m_frame_size = m_local_count + m_max_height;
+        return move(m_lowered);
+    }
+
+private:
+    struct ControlFrame {
+        enum class Kind {
+            Block,
+            Loop,
+            If,
+        };
+
+        Kind kind { Kind::Block };
+        u32 height { 0 };
+        u32 parameter_count { 0 };
+        u32 result_count { 0 };
+        u32 target { 0 };
+        Optional<u32> else_target {};
+        Vector<u32> table_targets {};
+
+        u32 branch_arity() const { return kind == Kind::Loop ? parameter_count : result_count; }
+    };
+
+    u32 canonical_slot(size_t height) const { return static_cast<u32>(m_local_count + height); }
+    bool is_local_slot(u32 slot) const { return slot < m_local_count; }
+
+    u32 allocate_branch_target(u32 result_slot, u32 ip = 0)
+    {
+        m_lowered->m_branch_targets.append({ ip, result_slot });
+        return static_cast<u32>(m_lowered->m_branch_targets.size() - 1);
+    }
+
+    void bind_branch_target(u32 target)
+    {
+        m_lowered->m_branch_targets[target].ip = current_ip();
+        m_last_bound_ip = current_ip();
+    }
+
+    u32 current_ip() const { return static_cast<u32>(m_lowered->m_instructions.size()); }
+
+    void emit(LoweredOpCode opcode, u32 a = 0, u32 b = 0, u32 c = 0, u32 d = 0, u64 immediate = 0)
+    {
+        m_lowered->m_instructions.append({ opcode, a, b, c, d, immediate });
+    }
+
+    void emit_trap(String message)
+    {
+        m_lowered->m_trap_messages.append(move(message));
+        emit(LoweredOpCode::trap, 0, 0, 0, 0, m_lowered->m_trap_messages.size() - 1);
+    }
+
+    u32 push()
+    {
+        auto slot = canonical_slot(m_stack.size());
+        m_stack.append(slot);
+        m_max_height = max(m_max_height, m_stack.size());
+        return slot;
+    }
+
+    u32 pop() { return m_stack.take_last(); }
+
+    void materialize(size_t height)
+    {
+        auto slot = canonical_slot(height);
+        if (m_stack[height] == slot)
+            return;
+        emit(LoweredOpCode::copy, slot, m_stack[height]);
+        m_stack[height] = slot;
+    }
+
+    void materialize_top(size_t count)
+    {
+        for (size_t i = m_stack.size() - count; i < m_stack.size(); ++i)
+            materialize(i);
+    }
+
+    void materialize_all() { materialize_top(m_stack.size()); }
+
+    void materialize_references_to_local(u32 local)
+    {
+        for (size_t i = 0; i < m_stack.size(); ++i) {
+            if (m_stack[i] == local)
+                materialize(i);
+        }
+    }
+
+    // If the value on top of the stack was just computed into its canonical slot by the previous instruction,
+    // and nothing can jump in between the two, that instruction can write straight into `local` instead.
+    bool try_redirect_previous_result(u32 value_slot, u32 local)
+    {
+        if (is_local_slot(value_slot) || current_ip() == m_last_bound_ip)
+            return false;
+
+        auto& previous = m_lowered->m_instructions.last();
+        if (previous.a != value_slot || !writes_only_to_first_operand(previous.opcode))
+            return false;
+
+        previous.a = local;
+        return true;
+    }
+
+    static bool writes_only_to_first_operand(LoweredOpCode opcode)
+    {
+        switch (opcode) {
+#define __ENUMERATE_LOWERED_NUMERIC_OPCODE(name, ...) case LoweredOpCode::name:
+            ENUMERATE_LOWERED_BINARY_OPERATIONS(__ENUMERATE_LOWERED_NUMERIC_OPCODE)
+            ENUMERATE_LOWERED_UNARY_OPERATIONS(__ENUMERATE_LOWERED_NUMERIC_OPCODE)
+            ENUMERATE_LOWERED_LOAD_OPERATIONS(__ENUMERATE_LOWERED_NUMERIC_OPCODE)
+#undef __ENUMERATE_LOWERED_NUMERIC_OPCODE
+        case LoweredOpCode::copy:
+        case LoweredOpCode::constant:
+        case LoweredOpCode::select:
+        case LoweredOpCode::global_get:
+        case LoweredOpCode::memory_size:
+        case LoweredOpCode::memory_grow:
+        case LoweredOpCode::ref_is_null:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    FunctionType const& function_type(FunctionAddress address)
+    {
+        FunctionType const* type { nullptr };
+        m_store.get(address)->visit([&](auto const& function) { type = &function.type(); });
+        return *type;
+    }
+
+    void enter_frame(ControlFrame::Kind kind, BlockType const& block_type)
+    {
+        u32 parameter_count = 0;
+        u32 result_count = 0;
+        switch (block_type.kind()) {
+        case BlockType::Empty:
+            break;
+        case BlockType::Type:
+            result_count = 1;
+            break;
+        case BlockType::Index: {
+            auto& type = m_module.types()[block_type.type_index().value()];
+            parameter_count = type.parameters().size();
+            result_count = type.results().size();
+            break;
+        }
+        }
+
+        Optional<u32> condition_slot;
+        if (kind == ControlFrame::Kind::If)
+            condition_slot = pop();
+
+        // NOTE: Stores inside the block may not run on every path, so no entry can stay a pending local reference.
+        materialize_all();
+
+        auto height = static_cast<u32>(m_stack.size() - parameter_count);
+        ControlFrame frame {
+            .kind = kind,
+            .height = height,
+            .parameter_count = parameter_count,
+            .result_count = result_count,
+            .target = allocate_branch_target(canonical_slot(height)),
+        };
+
+        if (kind == ControlFrame::Kind::Loop) {
+            bind_branch_target(frame.target);
+        } else if (kind == ControlFrame::Kind::If) {
+            frame.else_target = allocate_branch_target(canonical_slot(height));
+            emit(LoweredOpCode::jump_unless, *condition_slot, 0, 0, 0, *frame.else_target);
+        }
+
+        m_control_stack.append(move(frame));
+    }
+
+    void reset_stack(size_t height)
+    {
+        m_stack.resize(height);
+        for (size_t i = 0; i < height; ++i)
+            VERIFY(m_stack[i] == canonical_slot(i));
+    }
+
+    void fill_stack(size_t height)
+    {
+        while (m_stack.size() < height)
+            push();
+    }
+
+    void end_frame(ControlFrame& frame)
+    {
+        if (!m_unreachable)
+            materialize_top(frame.result_count);
+
+        if (frame.kind != ControlFrame::Kind::Loop) {
+            if (frame.else_target.has_value())
+                bind_branch_target(*frame.else_target);
+            bind_branch_target(frame.target);
+            for (auto target : frame.table_targets)
+                bind_branch_target(target);
+        }
+
+        reset_stack(frame.height);
+        fill_stack(frame.height + frame.result_count);
+        m_unreachable = false;
+    }
+
+    void lower_else()
+    {
+        auto& frame = m_control_stack.last();
+        VERIFY(frame.kind == ControlFrame::Kind::If);
+        if (!m_unreachable) {
+            materialize_top(frame.result_count);
+            emit(LoweredOpCode::jump, 0, 0, 0, 0, frame.target);
+        }
+
+        bind_branch_target(*frame.else_target);
+        frame.else_target.clear();
+
+        reset_stack(frame.height);
+        fill_stack(frame.height + frame.parameter_count);
+        m_unreachable = false;
+    }
+
+    void lower_end()
+    {
+        auto frame = m_control_stack.take_last();
+        end_frame(frame);
+    }
+
+    ControlFrame& frame_for_label(LabelIndex label)
+    {
+        return m_control_stack[m_control_stack.size() - 1 - label.value()];
+    }
+
+    void lower_branch(LabelIndex label, Optional<u32> condition_slot = {})
+    {
+        auto& frame = frame_for_label(label);
+        auto arity = frame.branch_arity();
+        materialize_top(arity);
+        auto source = canonical_slot(m_stack.size() - arity);
+        if (condition_slot.has_value())
+            emit(LoweredOpCode::jump_if, *condition_slot, source, arity, 0, frame.target);
+        else
+            emit(LoweredOpCode::jump, 0, source, arity, 0, frame.target);
+    }
+
+    void lower_branch_table(Instruction::TableBranchArgs const& arguments)
+    {
+        auto index_slot = pop();
+        auto arity = frame_for_label(arguments.default_).branch_arity();
+        materialize_top(arity);
+
+        auto first_target = static_cast<u32>(m_lowered->m_branch_targets.size());
+        auto add_target = [&](LabelIndex label) {
+            auto& frame = frame_for_label(label);
+            auto& target = m_lowered->m_branch_targets[frame.target];
+            auto new_target = allocate_branch_target(target.result_slot, target.ip);
+            if (frame.kind != ControlFrame::Kind::Loop)
+                frame.table_targets.append(new_target);
+        };
+        for (auto label : arguments.labels)
+            add_target(label);
+        add_target(arguments.default_);
+
+        emit(LoweredOpCode::jump_table, index_slot, canonical_slot(m_stack.size() - arity), arity, arguments.labels.size(), first_target);
+    }
+
+    void lower_return()
+    {
+        auto result_count = m_control_stack.first().result_count;
+        materialize_top(result_count);
+        emit(LoweredOpCode::return_, 0, canonical_slot(m_stack.size() - result_count), result_count);
+    }
+
+    void lower_call(FunctionType const& type, LoweredOpCode opcode, u32 index_slot = 0, u32 type_index = 0, u64 immediate = 0)
+    {
+        auto parameter_count = type.parameters().size();
+        materialize_top(parameter_count);
+        auto base = m_stack.size() - parameter_count;
+        emit(opcode, index_slot, canonical_slot(base), type_index, 0, immediate);
+        m_stack.resize(base);
+        fill_stack(base + type.results().size());
+    }
+
+    void lower_local_set(u32 local, bool keep_value)
+    {
+        auto value_slot = pop();
+        if (value_slot == local) {
+            // local.set of the local's own value, or local.tee of a pending local.get: nothing to do.
+            if (keep_value)
+                m_stack.append(value_slot);
+            return;
+        }
+
+        materialize_references_to_local(local);
+        if (!try_redirect_previous_result(value_slot, local))
+            emit(LoweredOpCode::copy, local, value_slot);
+        else if (keep_value)
+            value_slot = local;
+
+        if (keep_value)
+            m_stack.append(value_slot);
+    }
+
+    void lower_numeric(LoweredOpCode opcode, size_t operand_count)
+    {
+        u32 operands[2] {};
+        for (size_t i = operand_count; i > 0; --i)
+            operands[i - 1] = pop();
+        auto result = push();
+        emit(opcode, result, operands[0], operands[1]);
+    }
+
+    void skip(Instruction const& instruction)
+    {
+        switch (instruction.opcode().value()) {
+        case Instructions::block.value():
+        case Instructions::loop.value():
+        case Instructions::if_.value():
+            ++m_unreachable_depth;
+            return;
+        case Instructions::structured_else.value():
+            if (m_unreachable_depth == 0)
+                lower_else();
+            return;
+        case Instructions::structured_end.value():
+            if (m_unreachable_depth == 0)
+                lower_end();
+            else
+                --m_unreachable_depth;
+            return;
+        default:
+            return;
+        }
+    }
+
+    void mark_rest_of_block_unreachable()
+    {
+        m_unreachable = true;
+        m_unreachable_depth = 0;
+    }
+
+    void lower(Instruction const& instruction)
+    {
+        auto opcode = instruction.opcode();
+        switch (opcode.value()) {
+#define __ENUMERATE_LOWERED_BINARY_OPCODE(name, ...) \
+    case Instructions::name.value():                 \
+        return lower_numeric(LoweredOpCode::name, 2);
+#define __ENUMERATE_LOWERED_UNARY_OPCODE(name, ...) \
+    case Instructions::name.value():                \
+        return lower_numeric(LoweredOpCode::name, 1);
+            ENUMERATE_LOWERED_BINARY_OPERATIONS(__ENUMERATE_LOWERED_BINARY_OPCODE)
+            ENUMERATE_LOWERED_UNARY_OPERATIONS(__ENUMERATE_LOWERED_UNARY_OPCODE)
+#undef __ENUMERATE_LOWERED_BINARY_OPCODE
+#undef __ENUMERATE_LOWERED_UNARY_OPCODE
+
+#define __ENUMERATE_LOWERED_LOAD_OPCODE(name, ...) case Instructions::name.value():
+            ENUMERATE_LOWERED_LOAD_OPERATIONS(__ENUMERATE_LOWERED_LOAD_OPCODE)
+#undef __ENUMERATE_LOWERED_LOAD_OPCODE
+            {
+                auto address_slot = pop();
+                auto result = push();
+                emit(lowered_memory_opcode(opcode), result, address_slot, 0, 0, instruction.arguments().get<Instruction::MemoryArgument>().offset);
+                return;
+            }
+
+#define __ENUMERATE_LOWERED_STORE_OPCODE(name, ...) case Instructions::name.value():
+            ENUMERATE_LOWERED_STORE_OPERATIONS(__ENUMERATE_LOWERED_STORE_OPCODE)
+#undef __ENUMERATE_LOWERED_STORE_OPCODE
+            {
+                auto value_slot = pop();
+                auto address_slot = pop();
+                emit(lowered_memory_opcode(opcode), value_slot, address_slot, 0, 0, instruction.arguments().get<Instruction::MemoryArgument>().offset);
+                return;
+            }
+
+        case Instructions::unreachable.value():
+            emit_trap("Unreachable");
+            return mark_rest_of_block_unreachable();
+        case Instructions::nop.value():
+            return;
+        case Instructions::block.value():
+            return enter_frame(ControlFrame::Kind::Block, instruction.arguments().get<Instruction::StructuredInstructionArgs>().block_type);
+        case Instructions::loop.value():
+            return enter_frame(ControlFrame::Kind::Loop, instruction.arguments().get<Instruction::StructuredInstructionArgs>().block_type);
+        case Instructions::if_.value():
+            return enter_frame(ControlFrame::Kind::If, instruction.arguments().get<Instruction::StructuredInstructionArgs>().block_type);
+        case Instructions::structured_else.value():
+            return lower_else();
+        case Instructions::structured_end.value():
+            return lower_end();
+        case Instructions::br.value():
+            lower_branch(instruction.arguments().get<LabelIndex>());
+            return mark_rest_of_block_unreachable();
+        case Instructions::br_if.value(): {
+            auto condition_slot = pop();
+            return lower_branch(instruction.arguments().get<LabelIndex>(), condition_slot);
+        }
+        case Instructions::br_table.value():
+            lower_branch_table(instruction.arguments().get<Instruction::TableBranchArgs>());
+            return mark_rest_of_block_unreachable();
+        case Instructions::return_.value():
+            lower_return();
+            return mark_rest_of_block_unreachable();
+        case Instructions::call.value(): {
+            auto address = m_module.functions()[instruction.arguments().get<FunctionIndex>().value()];
+            return lower_call(function_type(address), LoweredOpCode::call, 0, 0, address.value());
+        }
+        case Instructions::call_indirect.value(): {
+            auto& arguments = instruction.arguments().get<Instruction::IndirectCallArgs>();
+            auto index_slot = pop();
+            auto table_address = m_module.tables()[arguments.table.value()];
+            return lower_call(m_module.types()[arguments.type.value()], LoweredOpCode::call_indirect, index_slot, arguments.type.value(), table_address.value());
+        }
+        case Instructions::local_get.value():
+            m_stack.append(instruction.arguments().get<LocalIndex>().value());
+            m_max_height = max(m_max_height, m_stack.size());
+            return;
+        case Instructions::local_set.value():
+            return lower_local_set(instruction.arguments().get<LocalIndex>().value(), false);
+        case Instructions::local_tee.value():
+            return lower_local_set(instruction.arguments().get<LocalIndex>().value(), true);
+        case Instructions::global_get.value(): {
+            auto address = m_module.globals()[instruction.arguments().get<GlobalIndex>().value()];
+            emit(LoweredOpCode::global_get, push(), 0, 0, 0, address.value());
+            return;
+        }
+        case Instructions::global_set.value(): {
+            auto address = m_module.globals()[instruction.arguments().get<GlobalIndex>().value()];
+            auto type = m_store.get(address)->value().type();
+            emit(LoweredOpCode::global_set, 0, pop(), type.kind(), 0, address.value());
+            return;
+        }
+        case Instructions::i32_const.value():
+            emit(LoweredOpCode::constant, push(), 0, 0, 0, to_slot(instruction.arguments().get<i32>()));
+            return;
+        case Instructions::i64_const.value():
+            emit(LoweredOpCode::constant, push(), 0, 0, 0, to_slot(instruction.arguments().get<i64>()));
+            return;
+        case Instructions::f32_const.value():
+            emit(LoweredOpCode::constant, push(), 0, 0, 0, to_slot(instruction.arguments().get<float>()));
+            return;
+        case Instructions::f64_const.value():
+            emit(LoweredOpCode::constant, push(), 0, 0, 0, to_slot(instruction.arguments().get<double>()));
+            return;
+        case Instructions::ref_null.value():
+            emit(LoweredOpCode::constant, push());
+            return;
+        case Instructions::ref_func.value(): {
+            auto address = m_module.functions()[instruction.arguments().get<FunctionIndex>().value()];
+            emit(LoweredOpCode::constant, push(), 0, 0, 0, address.value() + 1);
+            return;
+        }
+        case Instructions::ref_is_null.value():
+            return lower_numeric(LoweredOpCode::ref_is_null, 1);
+        case Instructions::drop.value():
+            pop();
+            return;
+        case Instructions::select.value():
+        case Instructions::select_typed.value(): {
+            auto condition_slot = pop();
+            auto rhs_slot = pop();
+            auto lhs_slot = pop();
+            emit(LoweredOpCode::select, push(), lhs_slot, rhs_slot, condition_slot);
+            return;
+        }
+        case Instructions::memory_size.value():
+            emit(LoweredOpCode::memory_size, push());
+            return;
+        case Instructions::memory_grow.value():
+            return lower_numeric(LoweredOpCode::memory_grow, 1);
+        case Instructions::memory_init.value(): {
+            auto count_slot = pop();
+            auto source_slot = pop();
+            auto destination_slot = pop();
+            auto data_address = m_module.datas()[instruction.arguments().get<DataIndex>().value()];
+            emit(LoweredOpCode::memory_init, 0, destination_slot, source_slot, count_slot, data_address.value());
+            return;
+        }
+        default:
+            // NOTE: The interpreter traps on these too, and their stack effect is irrelevant after a trap.
+            emit_trap(String::formatted("Unimplemented instruction {}", instruction_name(opcode)));
+            return mark_rest_of_block_unreachable();
+        }
+    }
+
+    static LoweredOpCode lowered_memory_opcode(OpCode opcode)
+    {
+        switch (opcode.value()) {
+#define __ENUMERATE_LOWERED_MEMORY_OPCODE(name, ...) \
+    case Instructions::name.value():                 \
+        return LoweredOpCode::name;
+            ENUMERATE_LOWERED_LOAD_OPERATIONS(__ENUMERATE_LOWERED_MEMORY_OPCODE)
+            ENUMERATE_LOWERED_STORE_OPERATIONS(__ENUMERATE_LOWERED_MEMORY_OPCODE)
+#undef __ENUMERATE_LOWERED_MEMORY_OPCODE
+        default:
+            VERIFY_NOT_REACHED();
+        }
+    }
+
+    Store& m_store;
+    ModuleInstance const& m_module;
+    NonnullOwnPtr<LoweredFunction> m_lowered;
+    size_t m_local_count { 0 };
+
+    Vector<u32, 32> m_stack;
+    size_t m_max_height { 0 };
+    Vector<ControlFrame, 16> m_control_stack;
+    bool m_unreachable { false };
+    size_t m_unreachable_depth { 0 };
+    u32 m_last_bound_ip { 0 };
+};
+
+static bool has_vector(FunctionType const& type)
+{
+    auto is_vector = [](ValueType const& value_type) { return value_type.is_vector(); };
+    return any_of(type.parameters(), is_vector) || any_of(type.results(), is_vector);
+}
+
+// Checks for anything that could put a v128 into a slot.
+static bool uses_vectors(Store& store, WasmFunction const& function)
+{
+    if (has_vector(function.type()))
+        return true;
+    if (any_of(function.code().locals(), [](ValueType const& type) { return type.is_vector(); }))
+        return true;
+
+    auto& module = function.module();
+    for (auto& instruction : function.code().body().instructions()) {
+        auto opcode = instruction.opcode().value();
+        if (opcode >= 0xfd00 && opcode <= 0xfdff)
+            return true;
+
+        switch (opcode) {
+        case Instructions::block.value():
+        case Instructions::loop.value():
+        case Instructions::if_.value(): {
+            auto& block_type = instruction.arguments().get<Instruction::StructuredInstructionArgs>().block_type;
+            if (block_type.kind() == BlockType::Type && block_type.value_type().is_vector())
+                return true;
+            if (block_type.kind() == BlockType::Index && has_vector(module.types()[block_type.type_index().value()]))
+                return true;
+            break;
+        }
+        case Instructions::select_typed.value():
+            if (any_of(instruction.arguments().get<Vector<ValueType>>(), [](ValueType const& type) { return type.is_vector(); }))
+                return true;
+            break;
+        case Instructions::call.value(): {
+            auto* callee = store.get(module.functions()[instruction.arguments().get<FunctionIndex>().value()]);
+            FunctionType const* type { nullptr };
+            callee->visit([&](auto const& function) { type = &function.type(); });
+            if (has_vector(*type))
+                return true;
+            break;
+        }
+        case Instructions::call_indirect.value():
+            if (has_vector(module.types()[instruction.arguments().get<Instruction::IndirectCallArgs>().type.value()]))
+                return true;
+            break;
+        case Instructions::global_get.value():
+        case Instructions::global_set.value():
+            if (store.get(module.globals()[instruction.arguments().get<GlobalIndex>().value()])->type().type().is_vector())
+                return true;
+            break;
+        default:
+            break;
+        }
+    }
+    return false;
+}
+
+OwnPtr<LoweredFunction> LoweredFunction::create(Store& store, WasmFunction const& function)
+{
+    if (uses_vectors(store, function))
+        return {};
+    return FunctionLowerer { store, function }.lower(function.code().body());
+}
+
+u64 LoweredFunction::slot_from_value(Value const& value)
+{
+    return value.value().visit(
+        [](Reference const& reference) {
+            return reference.ref().visit(
+                [](Reference::Null const&) -> u64 { return 0; },
+                [](auto const& reference) -> u64 { return reference.address.value() + 1; });
+        },
+        [](u128) -> u64 { VERIFY_NOT_REACHED(); },
+        [](auto number) { return to_slot(number); });
+}
+
+Value LoweredFunction::value_from_slot(ValueType type, u64 slot)
+{
+    switch (type.kind()) {
+    case ValueType::I32:
+        return Value(from_slot<i32>(slot));
+    case ValueType::I64:
+        return Value(from_slot<i64>(slot));
+    case ValueType::F32:
+        return Value(from_slot<float>(slot));
+    case ValueType::F64:
+        return Value(from_slot<double>(slot));
+    case ValueType::V128:
+        // NOTE: Functions that deal with vectors are never lowered, see uses_vectors().
+        VERIFY_NOT_REACHED();
+    case ValueType::FunctionReference:
+    case ValueType::NullFunctionReference:
+        if (slot == 0)
+            return Value(Reference { Reference::Null { ValueType(ValueType::FunctionReference) } });
+        return Value(Reference { Reference::Func { { slot - 1 } } });
+    case ValueType::ExternReference:
+    case ValueType::NullExternReference:
+        if (slot == 0)
+            return Value(Reference { Reference::Null { ValueType(ValueType::ExternReference) } });
+        return Value(Reference { Reference::Extern { { slot - 1 } } });
+    }
+    VERIFY_NOT_REACHED();
+}
+
+}
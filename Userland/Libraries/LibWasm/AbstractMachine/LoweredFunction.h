@@ -0,0 +1,368 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/BitCast.h>
+#include <AK/Endian.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Result.h>
+#include <AK/String.h>
+#include <AK/Types.h>
+#include <AK/Vector.h>
+#include <LibWasm/AbstractMachine/AbstractMachine.h>
+
+namespace Wasm {
+
+// Numeric instructions that take two operands: M(name, operand type, result type, operator)
+#define ENUMERATE_LOWERED_BINARY_OPERATIONS(M)  \
+    M(i32_eq, i32, i32, Equals)                 \
+    M(i32_ne, i32, i32, NotEquals)              \
+    M(i32_lts, i32, i32, LessThan)              \
+    M(i32_ltu, u32, i32, LessThan)              \
+    M(i32_gts, i32, i32, GreaterThan)           \
+    M(i32_gtu, u32, i32, GreaterThan)           \
+    M(i32_les, i32, i32, LessThanOrEquals)      \
+    M(i32_leu, u32, i32, LessThanOrEquals)      \
+    M(i32_ges, i32, i32, GreaterThanOrEquals)   \
+    M(i32_geu, u32, i32, GreaterThanOrEquals)   \
+    M(i64_eq, i64, i32, Equals)                 \
+    M(i64_ne, i64, i32, NotEquals)              \
+    M(i64_lts, i64, i32, LessThan)              \
+    M(i64_ltu, u64, i32, LessThan)              \
+    M(i64_gts, i64, i32, GreaterThan)           \
+    M(i64_gtu, u64, i32, GreaterThan)           \
+    M(i64_les, i64, i32, LessThanOrEquals)      \
+    M(i64_leu, u64, i32, LessThanOrEquals)      \
+    M(i64_ges, i64, i32, GreaterThanOrEquals)   \
+    M(i64_geu, u64, i32, GreaterThanOrEquals)   \
+    M(f32_eq, float, i32, Equals)               \
+    M(f32_ne, float, i32, NotEquals)            \
+    M(f32_lt, float, i32, LessThan)             \
+    M(f32_gt, float, i32, GreaterThan)          \
+    M(f32_le, float, i32, LessThanOrEquals)     \
+    M(f32_ge, float, i32, GreaterThanOrEquals)  \
+    M(f64_eq, double, i32, Equals)              \
+    M(f64_ne, double, i32, NotEquals)           \
+    M(f64_lt, double, i32, LessThan)            \
+    M(f64_gt, double, i32, GreaterThan)         \
+    M(f64_le, double, i32, LessThanOrEquals)    \
+    M(f64_ge, double, i32, GreaterThanOrEquals) \
+    M(i32_add, u32, i32, Add)                   \
+    M(i32_sub, u32, i32, Subtract)              \
+    M(i32_mul, u32, i32, Multiply)              \
+    M(i32_divs, i32, i32, Divide)               \
+    M(i32_divu, u32, i32, Divide)               \
+    M(i32_rems, i32, i32, Modulo)               \
+    M(i32_remu, u32, i32, Modulo)               \
+    M(i32_and, i32, i32, BitAnd)                \
+    M(i32_or, i32, i32, BitOr)                  \
+    M(i32_xor, i32, i32, BitXor)                \
+    M(i32_shl, u32, i32, BitShiftLeft)          \
+    M(i32_shrs, i32, i32, BitShiftRight)        \
+    M(i32_shru, u32, i32, BitShiftRight)        \
+    M(i32_rotl, u32, i32, BitRotateLeft)        \
+    M(i32_rotr, u32, i32, BitRotateRight)       \
+    M(i64_add, u64, i64, Add)                   \
+    M(i64_sub, u64, i64, Subtract)              \
+    M(i64_mul, u64, i64, Multiply)              \
+    M(i64_divs, i64, i64, Divide)               \
+    M(i64_divu, u64, i64, Divide)               \
+    M(i64_rems, i64, i64, Modulo)               \
+    M(i64_remu, u64, i64, Modulo)               \
+    M(i64_and, i64, i64, BitAnd)                \
+    M(i64_or, i64, i64, BitOr)                  \
+    M(i64_xor, i64, i64, BitXor)                \
+    M(i64_shl, u64, i64, BitShiftLeft)          \
+    M(i64_shrs, i64, i64, BitShiftRight)        \
+    M(i64_shru, u64, i64, BitShiftRight)        \
+    M(i64_rotl, u64, i64, BitRotateLeft)        \
+    M(i64_rotr, u64, i64, BitRotateRight)       \
+    M(f32_add, float, float, Add)               \
+    M(f32_sub, float, float, Subtract)          \
+    M(f32_mul, float, float, Multiply)          \
+    M(f32_div, float, float, Divide)            \
+    M(f32_min, float, float, Minimum)           \
+    M(f32_max, float, float, Maximum)           \
+    M(f32_copysign, float, float, CopySign)     \
+    M(f64_add, double, double, Add)             \
+    M(f64_sub, double, double, Subtract)        \
+    M(f64_mul, double, double, Multiply)        \
+    M(f64_div, double, double, Divide)          \
+    M(f64_min, double, double, Minimum)         \
+    M(f64_max, double, double, Maximum)         \
+    M(f64_copysign, double, double, CopySign)
+
+// Numeric instructions that take one operand: M(name, operand type, result type, operator)
+#define ENUMERATE_LOWERED_UNARY_OPERATIONS(M)                    \
+    M(i32_eqz, i32, i32, EqualsZero)                             \
+    M(i64_eqz, i64, i32, EqualsZero)                             \
+    M(i32_clz, i32, i32, CountLeadingZeros)                      \
+    M(i32_ctz, i32, i32, CountTrailingZeros)                     \
+    M(i32_popcnt, i32, i32, PopCount)                            \
+    M(i64_clz, i64, i64, CountLeadingZeros)                      \
+    M(i64_ctz, i64, i64, CountTrailingZeros)                     \
+    M(i64_popcnt, i64, i64, PopCount)                            \
+    M(f32_abs, float, float, Absolute)                           \
+    M(f32_neg, float, float, Negate)                             \
+    M(f32_ceil, float, float, Ceil)                              \
+    M(f32_floor, float, float, Floor)                            \
+    M(f32_trunc, float, float, Truncate)                         \
+    M(f32_nearest, float, float, NearbyIntegral)                 \
+    M(f32_sqrt, float, float, SquareRoot)                        \
+    M(f64_abs, double, double, Absolute)                         \
+    M(f64_neg, double, double, Negate)                           \
+    M(f64_ceil, double, double, Ceil)                            \
+    M(f64_floor, double, double, Floor)                          \
+    M(f64_trunc, double, double, Truncate)                       \
+    M(f64_nearest, double, double, NearbyIntegral)               \
+    M(f64_sqrt, double, double, SquareRoot)                      \
+    M(i32_wrap_i64, i64, i32, Wrap<i32>)                         \
+    M(i32_trunc_sf32, float, i32, CheckedTruncate<i32>)          \
+    M(i32_trunc_uf32, float, i32, CheckedTruncate<u32>)          \
+    M(i32_trunc_sf64, double, i32, CheckedTruncate<i32>)         \
+    M(i32_trunc_uf64, double, i32, CheckedTruncate<u32>)         \
+    M(i64_trunc_sf32, float, i64, CheckedTruncate<i64>)          \
+    M(i64_trunc_uf32, float, i64, CheckedTruncate<u64>)          \
+    M(i64_trunc_sf64, double, i64, CheckedTruncate<i64>)         \
+    M(i64_trunc_uf64, double, i64, CheckedTruncate<u64>)         \
+    M(i64_extend_si32, i32, i64, Extend<i64>)                    \
+    M(i64_extend_ui32, u32, i64, Extend<i64>)                    \
+    M(f32_convert_si32, i32, float, Convert<float>)              \
+    M(f32_convert_ui32, u32, float, Convert<float>)              \
+    M(f32_convert_si64, i64, float, Convert<float>)              \
+    M(f32_convert_ui64, u64, float, Convert<float>)              \
+    M(f32_demote_f64, double, float, Demote)                     \
+    M(f64_convert_si32, i32, double, Convert<double>)            \
+    M(f64_convert_ui32, u32, double, Convert<double>)            \
+    M(f64_convert_si64, i64, double, Convert<double>)            \
+    M(f64_convert_ui64, u64, double, Convert<double>)            \
+    M(f64_promote_f32, float, double, Promote)                   \
+    M(i32_reinterpret_f32, float, i32, Reinterpret<i32>)         \
+    M(i64_reinterpret_f64, double, i64, Reinterpret<i64>)        \
+    M(f32_reinterpret_i32, i32, float, Reinterpret<float>)       \
+    M(f64_reinterpret_i64, i64, double, Reinterpret<double>)     \
+    M(i32_extend8_s, i32, i32, SignExtend<i8>)                   \
+    M(i32_extend16_s, i32, i32, SignExtend<i16>)                 \
+    M(i64_extend8_s, i64, i64, SignExtend<i8>)                   \
+    M(i64_extend16_s, i64, i64, SignExtend<i16>)                 \
+    M(i64_extend32_s, i64, i64, SignExtend<i32>)                 \
+    M(i32_trunc_sat_f32_s, float, i32, SaturatingTruncate<i32>)  \
+    M(i32_trunc_sat_f32_u, float, i32, SaturatingTruncate<u32>)  \
+    M(i32_trunc_sat_f64_s, double, i32, SaturatingTruncate<i32>) \
+    M(i32_trunc_sat_f64_u, double, i32, SaturatingTruncate<u32>) \
+    M(i64_trunc_sat_f32_s, float, i64, SaturatingTruncate<i64>)  \
+    M(i64_trunc_sat_f32_u, float, i64, SaturatingTruncate<u64>)  \
+    M(i64_trunc_sat_f64_s, double, i64, SaturatingTruncate<i64>) \
+    M(i64_trunc_sat_f64_u, double, i64, SaturatingTruncate<u64>)
+
+// Memory loads: M(name, type in memory, result type)
+#define ENUMERATE_LOWERED_LOAD_OPERATIONS(M) \
+    M(i32_load, i32, i32)                    \
+    M(i64_load, i64, i64)                    \
+    M(f32_load, float, float)                \
+    M(f64_load, double, double)              \
+    M(i32_load8_s, i8, i32)                  \
+    M(i32_load8_u, u8, i32)                  \
+    M(i32_load16_s, i16, i32)                \
+    M(i32_load16_u, u16, i32)                \
+    M(i64_load8_s, i8, i64)                  \
+    M(i64_load8_u, u8, i64)                  \
+    M(i64_load16_s, i16, i64)                \
+    M(i64_load16_u, u16, i64)                \
+    M(i64_load32_s, i32, i64)                \
+    M(i64_load32_u, u32, i64)
+
+// Memory stores: M(name, operand type, type in memory)
+#define ENUMERATE_LOWERED_STORE_OPERATIONS(M) \
+    M(i32_store, i32, i32)                    \
+    M(i64_store, i64, i64)                    \
+    M(f32_store, float, float)                \
+    M(f64_store, double, double)              \
+    M(i32_store8, i32, i8)                    \
+    M(i32_store16, i32, i16)                  \
+    M(i64_store8, i64, i8)                    \
+    M(i64_store16, i64, i16)                  \
+    M(i64_store32, i64, i32)
+
+// Everything else. The operand layout of each of these is documented on LoweredInstruction.
+#define ENUMERATE_LOWERED_CONTROL_OPERATIONS(M) \
+    M(copy)                                     \
+    M(constant)                                 \
+    M(jump)                                     \
+    M(jump_if)                                  \
+    M(jump_unless)                              \
+    M(jump_table)                               \
+    M(return_)                                  \
+    M(call)                                     \
+    M(call_indirect)                            \
+    M(trap)                                     \
+    M(select)                                   \
+    M(global_get)                               \
+    M(global_set)                               \
+    M(memory_size)                              \
+    M(memory_grow)                              \
+    M(memory_init)                              \
+    M(ref_is_null)
+
+enum class LoweredOpCode : u32 {
+#define __ENUMERATE_LOWERED_NUMERIC_OPCODE(name, ...) name,
+#define __ENUMERATE_LOWERED_CONTROL_OPCODE(name) name,
+    ENUMERATE_LOWERED_BINARY_OPERATIONS(__ENUMERATE_LOWERED_NUMERIC_OPCODE)
+        ENUMERATE_LOWERED_UNARY_OPERATIONS(__ENUMERATE_LOWERED_NUMERIC_OPCODE)
+            ENUMERATE_LOWERED_LOAD_OPERATIONS(__ENUMERATE_LOWERED_NUMERIC_OPCODE)
+                ENUMERATE_LOWERED_STORE_OPERATIONS(__ENUMERATE_LOWERED_NUMERIC_OPCODE)
+                    ENUMERATE_LOWERED_CONTROL_OPERATIONS(__ENUMERATE_LOWERED_CONTROL_OPCODE)
+#undef __ENUMERATE_LOWERED_NUMERIC_OPCODE
+#undef __ENUMERATE_LOWERED_CONTROL_OPCODE
+                        __Count,
+};
+
+// Every value lives in a 64-bit slot; 32-bit values only use the low half.
+template<typename T>
+ALWAYS_INLINE T from_slot(u64 slot)
+{
+    if constexpr (IsSame<T, float>)
+        return bit_cast<float>(static_cast<u32>(slot));
+    else if constexpr (IsSame<T, double>)
+        return bit_cast<double>(slot);
+    else
+        return static_cast<T>(slot);
+}
+
+template<typename T>
+ALWAYS_INLINE u64 to_slot(T value)
+{
+    if constexpr (IsSame<T, float>)
+        return bit_cast<u32>(value);
+    else if constexpr (IsSame<T, double>)
+        return bit_cast<u64>(value);
+    else if constexpr (sizeof(T) == sizeof(u64))
+        return static_cast<u64>(value);
+    else
+        return static_cast<u32>(value);
+}
+
+// Linear memory is always little-endian.
+template<typename T>
+ALWAYS_INLINE T read_little_endian(u8 const* data)
+{
+    if constexpr (IsFloatingPoint<T>) {
+        return bit_cast<T>(read_little_endian<Conditional<IsSame<T, float>, u32, u64>>(data));
+    } else {
+        T value;
+        __builtin_memcpy(&value, data, sizeof(T));
+        return AK::convert_between_host_and_little_endian(value);
+    }
+}
+
+template<typename T>
+ALWAYS_INLINE void write_little_endian(u8* data, T value)
+{
+    if constexpr (IsFloatingPoint<T>) {
+        write_little_endian(data, bit_cast<Conditional<IsSame<T, float>, u32, u64>>(value));
+    } else {
+        value = AK::convert_between_host_and_little_endian(value);
+        __builtin_memcpy(data, &value, sizeof(T));
+    }
+}
+
+template<typename PushType, typename T>
+ALWAYS_INLINE bool store_operation_result(u64& slot, T call_result, StringView& error)
+{
+    if constexpr (IsSpecializationOf<T, AK::Result>) {
+        if (call_result.is_error()) {
+            error = call_result.error();
+            return false;
+        }
+        slot = to_slot(static_cast<PushType>(call_result.release_value()));
+    } else {
+        slot = to_slot(static_cast<PushType>(call_result));
+    }
+    return true;
+}
+
+ALWAYS_INLINE void move_branch_values(u64* slots, u32 destination, u32 source, u32 count)
+{
+    if (destination == source)
+        return;
+    // NOTE: Branches only ever move values down the stack, so a forward copy is safe.
+    for (u32 i = 0; i < count; ++i)
+        slots[destination + i] = slots[source + i];
+}
+
+// A lowered instruction names its operands by slot index in the current frame, which holds the function's locals
+// followed by its operand stack. Since stack heights are static in WebAssembly, every operand has a fixed slot.
+//
+//   binary ops:    slots[a] = slots[b] <op> slots[c]
+//   unary ops:     slots[a] = <op>(slots[b])
+//   loads:         slots[a] = memory[slots[b] + immediate]
+//   stores:        memory[slots[b] + immediate] = slots[a]
+//   copy:          slots[a] = slots[b]
+//   constant:      slots[a] = immediate
+//   jump(_if):     if slots[a] (jump_if only): move c values from slots[b] to slots[target.result_slot], goto target.ip,
+//                  where target = branch_targets[immediate]
+//   jump_unless:   if !slots[a]: goto branch_targets[immediate].ip
+//   jump_table:    like jump, with target = branch_targets[immediate + min(slots[a], count)], count in d
+//   return_:       move c values from slots[b] to slots[0] and leave the function
+//   call:          call function address `immediate`, with arguments (and results) starting at slots[b]
+//   call_indirect: call the function at index slots[a] of table address `immediate`, expecting type index c, with arguments at slots[b]
+//   trap:          trap with trap_messages[immediate]
+//   select:        slots[a] = slots[d] ? slots[b] : slots[c]
+//   global_get:    slots[a] = global at address `immediate`
+//   global_set:    global at address `immediate` = slots[b], whose value type is c
+//   memory_size:   slots[a] = current page count
+//   memory_grow:   slots[a] = grow memory by slots[b] pages
+//   memory_init:   copy slots[d] bytes from data address `immediate` offset slots[c] to memory offset slots[b]
+//   ref_is_null:   slots[a] = slots[b] == null
+struct LoweredInstruction {
+    LoweredOpCode opcode;
+    u32 a { 0 };
+    u32 b { 0 };
+    u32 c { 0 };
+    u32 d { 0 };
+    u64 immediate { 0 };
+};
+
+struct LoweredBranchTarget {
+    u32 ip { 0 };
+    u32 result_slot { 0 };
+};
+
+// A WebAssembly function body, lowered once into a flat, pre-decoded, register-style instruction stream:
+// structured control flow is resolved to jumps, and stack positions are resolved to frame slots.
+class LoweredFunction {
+public:
+    // Functions that deal with v128 values can't be lowered, since those don't fit into a slot. They return nothing.
+    static OwnPtr<LoweredFunction> create(Store&, WasmFunction const&);
+
+    auto& instructions() const { return m_instructions; }
+    auto& branch_targets() const { return m_branch_targets; }
+    auto& trap_messages() const { return m_trap_messages; }
+
+    // The number of slots taken up by parameters and locals, followed by the slots of the deepest operand stack.
+    size_t local_count() const { return m_local_count; }
+    size_t parameter_count() const { return m_parameter_count; }
+    size_t frame_size() const { return m_frame_size; }
+
+    // References are stored as 0 for null, and as their address plus one otherwise; their type is implied by the code.
+    static u64 slot_from_value(Value const&);
+    static Value value_from_slot(ValueType, u64);
+
+private:
+    friend class FunctionLowerer;
+
+    LoweredFunction() = default;
+
+    Vector<LoweredInstruction> m_instructions;
+    Vector<LoweredBranchTarget> m_branch_targets;
+    Vector<String> m_trap_messages;
+    size_t m_local_count { 0 };
+    size_t m_parameter_count { 0 };
+    size_t m_frame_size { 0 };
+};
+
+}
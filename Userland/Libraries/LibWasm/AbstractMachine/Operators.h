@@ -6,11 +6,14 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/BitCast.h>
 #include <AK/BuiltinWrappers.h>
 #include <AK/Result.h>
+#include <AK/SIMD.h>
 #include <AK/StringView.h>
 #include <AK/Types.h>
+#include <AK/UFixedBigInt.h>
 #include <limits.h>
 #include <math.h>
 
@@ -254,7 +257,7 @@ struct Floor {
 };
 struct Truncate {
     template<typename Lhs>
-    Result<Lhs, StringView> operator()(Lhs lhs) const
+    auto operator()(Lhs lhs) const
     {
         if constexpr (IsSame<Lhs, float>)
             return truncf(lhs);
@@ -442,4 +445,389 @@ struct SaturatingTruncate {
     static StringView name() { return "truncate.saturating"sv; }
 };
 
+// Vector
+// NOTE: v128 values are passed around as u128, and reinterpreted as one of the AK::SIMD vector types by each operator.
+//       Whole-vector operators compile down to the host's SIMD instructions, the rest apply a scalar operator to each lane.
+//       All of this assumes a little-endian host, where lane 0 occupies the lowest bits of the u128.
+
+template<typename VectorType>
+using LaneType = RemoveCVReference<decltype(declval<VectorType>()[0])>;
+
+template<typename VectorType>
+static constexpr size_t lane_count = sizeof(VectorType) / sizeof(LaneType<VectorType>);
+
+enum class VectorHalf {
+    Low,
+    High,
+};
+
+template<typename VectorType, typename Operator>
+struct Vectorized {
+    u128 operator()(u128 lhs, u128 rhs) const
+    {
+        return bit_cast<u128>(Operator {}(bit_cast<VectorType>(lhs), bit_cast<VectorType>(rhs)));
+    }
+
+    u128 operator()(u128 lhs) const
+    {
+        return bit_cast<u128>(Operator {}(bit_cast<VectorType>(lhs)));
+    }
+
+    static StringView name() { return Operator::name(); }
+};
+
+template<typename VectorType, typename Operator>
+struct LaneWise {
+    u128 operator()(u128 lhs, u128 rhs) const
+    {
+        auto lhs_vector = bit_cast<VectorType>(lhs);
+        auto rhs_vector = bit_cast<VectorType>(rhs);
+        VectorType result;
+        for (size_t i = 0; i < lane_count<VectorType>; ++i)
+            result[i] = Operator {}(lhs_vector[i], rhs_vector[i]);
+        return bit_cast<u128>(result);
+    }
+
+    u128 operator()(u128 lhs) const
+    {
+        auto vector = bit_cast<VectorType>(lhs);
+        VectorType result;
+        for (size_t i = 0; i < lane_count<VectorType>; ++i)
+            result[i] = Operator {}(vector[i]);
+        return bit_cast<u128>(result);
+    }
+
+    static StringView name() { return Operator::name(); }
+};
+
+// Converts each lane of the source, any lanes of the result that are left over are zeroed.
+template<typename SourceVectorType, typename ResultVectorType, typename Operator>
+struct LaneWiseConvert {
+    u128 operator()(u128 lhs) const
+    {
+        auto vector = bit_cast<SourceVectorType>(lhs);
+        ResultVectorType result {};
+        for (size_t i = 0; i < min(lane_count<SourceVectorType>, lane_count<ResultVectorType>); ++i)
+            result[i] = Operator {}(vector[i]);
+        return bit_cast<u128>(result);
+    }
+
+    static StringView name() { return Operator::name(); }
+};
+
+template<typename SourceVectorType, typename ResultVectorType>
+struct VectorConvert {
+    u128 operator()(u128 lhs) const
+    {
+        return bit_cast<u128>(__builtin_convertvector(bit_cast<SourceVectorType>(lhs), ResultVectorType));
+    }
+
+    static StringView name() { return "convert"sv; }
+};
+
+// Converts the lanes in one half of the vector into a vector with lanes twice as wide.
+template<typename HalfVectorType, typename ResultVectorType, VectorHalf half>
+struct VectorExtend {
+    u128 operator()(u128 lhs) const
+    {
+        auto half_vector = bit_cast<HalfVectorType>(half == VectorHalf::Low ? lhs.low() : lhs.high());
+        return bit_cast<u128>(__builtin_convertvector(half_vector, ResultVectorType));
+    }
+
+    static StringView name() { return "extend"sv; }
+};
+
+template<typename HalfVectorType, typename ResultVectorType, VectorHalf half>
+struct VectorExtendedMultiply {
+    u128 operator()(u128 lhs, u128 rhs) const
+    {
+        VectorExtend<HalfVectorType, ResultVectorType, half> extend;
+        return bit_cast<u128>(bit_cast<ResultVectorType>(extend(lhs)) * bit_cast<ResultVectorType>(extend(rhs)));
+    }
+
+    static StringView name() { return "extmul"sv; }
+};
+
+template<typename SourceVectorType, typename ResultVectorType>
+struct VectorExtendedAddPairwise {
+    u128 operator()(u128 lhs) const
+    {
+        auto vector = bit_cast<SourceVectorType>(lhs);
+        ResultVectorType result;
+        for (size_t i = 0; i < lane_count<ResultVectorType>; ++i)
+            result[i] = static_cast<LaneType<ResultVectorType>>(vector[2 * i]) + static_cast<LaneType<ResultVectorType>>(vector[2 * i + 1]);
+        return bit_cast<u128>(result);
+    }
+
+    static StringView name() { return "extadd_pairwise"sv; }
+};
+
+struct VectorDot {
+    u128 operator()(u128 lhs, u128 rhs) const
+    {
+        auto lhs_vector = bit_cast<AK::SIMD::i16x8>(lhs);
+        auto rhs_vector = bit_cast<AK::SIMD::i16x8>(rhs);
+        AK::SIMD::u32x4 result;
+        // NOTE: The sum of both products overflows for -32768 * -32768 + -32768 * -32768, which is expected to wrap around.
+        for (size_t i = 0; i < 4; ++i)
+            result[i] = static_cast<u32>(lhs_vector[2 * i] * rhs_vector[2 * i]) + static_cast<u32>(lhs_vector[2 * i + 1] * rhs_vector[2 * i + 1]);
+        return bit_cast<u128>(result);
+    }
+
+    static StringView name() { return "dot"sv; }
+};
+
+// Saturates both vectors into lanes half as wide, the lanes of `lhs` end up in the lower half of the result.
+template<typename SourceVectorType, typename ResultVectorType>
+struct VectorNarrow {
+    u128 operator()(u128 lhs, u128 rhs) const
+    {
+        using ResultLaneType = LaneType<ResultVectorType>;
+        constexpr auto narrow = [](auto value) {
+            return static_cast<ResultLaneType>(clamp<decltype(value)>(value, NumericLimits<ResultLaneType>::min(), NumericLimits<ResultLaneType>::max()));
+        };
+        auto lhs_vector = bit_cast<SourceVectorType>(lhs);
+        auto rhs_vector = bit_cast<SourceVectorType>(rhs);
+        ResultVectorType result;
+        for (size_t i = 0; i < lane_count<SourceVectorType>; ++i) {
+            result[i] = narrow(lhs_vector[i]);
+            result[i + lane_count<SourceVectorType>] = narrow(rhs_vector[i]);
+        }
+        return bit_cast<u128>(result);
+    }
+
+    static StringView name() { return "narrow"sv; }
+};
+
+template<typename VectorType>
+struct VectorShiftLeft {
+    u128 operator()(u128 lhs, i32 rhs) const
+    {
+        return bit_cast<u128>(bit_cast<VectorType>(lhs) << (static_cast<u32>(rhs) % (sizeof(LaneType<VectorType>) * 8)));
+    }
+
+    static StringView name() { return "<<"sv; }
+};
+
+template<typename VectorType>
+struct VectorShiftRight {
+    u128 operator()(u128 lhs, i32 rhs) const
+    {
+        return bit_cast<u128>(bit_cast<VectorType>(lhs) >> (static_cast<u32>(rhs) % (sizeof(LaneType<VectorType>) * 8)));
+    }
+
+    static StringView name() { return ">>"sv; }
+};
+
+struct BitAndNot {
+    template<typename Lhs, typename Rhs>
+    auto operator()(Lhs lhs, Rhs rhs) const { return lhs & ~rhs; }
+
+    static StringView name() { return "andnot"sv; }
+};
+
+struct BitNot {
+    template<typename Lhs>
+    auto operator()(Lhs lhs) const { return ~lhs; }
+
+    static StringView name() { return "not"sv; }
+};
+
+template<typename VectorType>
+struct VectorAbsolute {
+    u128 operator()(u128 lhs) const
+    {
+        if constexpr (IsFloatingPoint<LaneType<VectorType>>) {
+            // NOTE: This has to clear the sign bit of NaNs too, so it can't be done with a comparison.
+            return bit_cast<u128>(bit_cast<AK::SIMD::u64x2>(lhs) & (sizeof(LaneType<VectorType>) == 4 ? 0x7fffffff7fffffffull : 0x7fffffffffffffffull));
+        } else {
+            auto vector = bit_cast<VectorType>(lhs);
+            VectorType result;
+            for (size_t i = 0; i < lane_count<VectorType>; ++i) {
+                auto lane = vector[i];
+                auto magnitude = static_cast<MakeUnsigned<LaneType<VectorType>>>(lane);
+                result[i] = static_cast<LaneType<VectorType>>(lane < 0 ? -magnitude : magnitude);
+            }
+            return bit_cast<u128>(result);
+        }
+    }
+
+    static StringView name() { return "abs"sv; }
+};
+
+struct VectorPopCount {
+    u128 operator()(u128 lhs) const
+    {
+        auto vector = bit_cast<AK::SIMD::u8x16>(lhs);
+        AK::SIMD::u8x16 result;
+        for (size_t i = 0; i < 16; ++i)
+            result[i] = popcount(static_cast<u32>(vector[i]));
+        return bit_cast<u128>(result);
+    }
+
+    static StringView name() { return "popcnt"sv; }
+};
+
+struct VectorAnyTrue {
+    i32 operator()(u128 lhs) const { return (lhs.low() | lhs.high()) != 0; }
+
+    static StringView name() { return "any_true"sv; }
+};
+
+template<typename VectorType>
+struct VectorAllTrue {
+    i32 operator()(u128 lhs) const
+    {
+        auto vector = bit_cast<VectorType>(lhs);
+        for (size_t i = 0; i < lane_count<VectorType>; ++i) {
+            if (vector[i] == 0)
+                return 0;
+        }
+        return 1;
+    }
+
+    static StringView name() { return "all_true"sv; }
+};
+
+template<typename VectorType>
+struct VectorBitmask {
+    i32 operator()(u128 lhs) const
+    {
+        auto vector = bit_cast<VectorType>(lhs);
+        u32 result = 0;
+        for (size_t i = 0; i < lane_count<VectorType>; ++i)
+            result |= static_cast<u32>(vector[i] < 0) << i;
+        return static_cast<i32>(result);
+    }
+
+    static StringView name() { return "bitmask"sv; }
+};
+
+template<typename VectorType>
+struct VectorSplat {
+    template<typename Lhs>
+    u128 operator()(Lhs lhs) const
+    {
+        VectorType result;
+        for (size_t i = 0; i < lane_count<VectorType>; ++i)
+            result[i] = static_cast<LaneType<VectorType>>(lhs);
+        return bit_cast<u128>(result);
+    }
+
+    static StringView name() { return "splat"sv; }
+};
+
+template<typename VectorType, typename ResultT>
+struct VectorExtractLane {
+    ResultT operator()(u128 lhs) const { return static_cast<ResultT>(bit_cast<VectorType>(lhs)[lane]); }
+
+    static StringView name() { return "extract_lane"sv; }
+
+    u8 lane { 0 };
+};
+
+template<typename VectorType>
+struct VectorReplaceLane {
+    template<typename Rhs>
+    u128 operator()(u128 lhs, Rhs rhs) const
+    {
+        auto vector = bit_cast<VectorType>(lhs);
+        vector[lane] = static_cast<LaneType<VectorType>>(rhs);
+        return bit_cast<u128>(vector);
+    }
+
+    static StringView name() { return "replace_lane"sv; }
+
+    u8 lane { 0 };
+};
+
+struct VectorShuffle {
+    u128 operator()(u128 lhs, u128 rhs) const
+    {
+        auto lhs_vector = bit_cast<AK::SIMD::u8x16>(lhs);
+        auto rhs_vector = bit_cast<AK::SIMD::u8x16>(rhs);
+        AK::SIMD::u8x16 result;
+        for (size_t i = 0; i < 16; ++i)
+            result[i] = lanes[i] < 16 ? lhs_vector[lanes[i]] : rhs_vector[lanes[i] - 16];
+        return bit_cast<u128>(result);
+    }
+
+    static StringView name() { return "shuffle"sv; }
+
+    Array<u8, 16> const& lanes;
+};
+
+struct VectorSwizzle {
+    u128 operator()(u128 lhs, u128 rhs) const
+    {
+        auto vector = bit_cast<AK::SIMD::u8x16>(lhs);
+        auto indices = bit_cast<AK::SIMD::u8x16>(rhs);
+        AK::SIMD::u8x16 result;
+        for (size_t i = 0; i < 16; ++i)
+            result[i] = indices[i] < 16 ? vector[indices[i]] : 0;
+        return bit_cast<u128>(result);
+    }
+
+    static StringView name() { return "swizzle"sv; }
+};
+
+// Scalar operators used on each lane of a vector.
+
+struct SaturatingAdd {
+    template<typename Lhs, typename Rhs>
+    Lhs operator()(Lhs lhs, Rhs rhs) const
+    {
+        static_assert(sizeof(Lhs) < sizeof(i32));
+        return static_cast<Lhs>(clamp<i32>(static_cast<i32>(lhs) + static_cast<i32>(rhs), NumericLimits<Lhs>::min(), NumericLimits<Lhs>::max()));
+    }
+
+    static StringView name() { return "add_sat"sv; }
+};
+
+struct SaturatingSubtract {
+    template<typename Lhs, typename Rhs>
+    Lhs operator()(Lhs lhs, Rhs rhs) const
+    {
+        static_assert(sizeof(Lhs) < sizeof(i32));
+        return static_cast<Lhs>(clamp<i32>(static_cast<i32>(lhs) - static_cast<i32>(rhs), NumericLimits<Lhs>::min(), NumericLimits<Lhs>::max()));
+    }
+
+    static StringView name() { return "sub_sat"sv; }
+};
+
+struct RoundingAverage {
+    template<typename Lhs, typename Rhs>
+    Lhs operator()(Lhs lhs, Rhs rhs) const
+    {
+        static_assert(IsUnsigned<Lhs> && sizeof(Lhs) < sizeof(u32));
+        return static_cast<Lhs>((static_cast<u32>(lhs) + static_cast<u32>(rhs) + 1) / 2);
+    }
+
+    static StringView name() { return "avgr"sv; }
+};
+
+struct Q15MultiplyRoundSaturate {
+    i16 operator()(i16 lhs, i16 rhs) const
+    {
+        auto product = (static_cast<i32>(lhs) * static_cast<i32>(rhs) + 0x4000) >> 15;
+        return static_cast<i16>(clamp<i32>(product, NumericLimits<i16>::min(), NumericLimits<i16>::max()));
+    }
+
+    static StringView name() { return "q15mulr_sat"sv; }
+};
+
+struct PseudoMinimum {
+    template<typename Lhs, typename Rhs>
+    auto operator()(Lhs lhs, Rhs rhs) const { return rhs < lhs ? rhs : lhs; }
+
+    static StringView name() { return "pmin"sv; }
+};
+
+struct PseudoMaximum {
+    template<typename Lhs, typename Rhs>
+    auto operator()(Lhs lhs, Rhs rhs) const { return lhs < rhs ? rhs : lhs; }
+
+    static StringView name() { return "pmax"sv; }
+};
+
 }
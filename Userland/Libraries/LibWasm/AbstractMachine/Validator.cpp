@@ -2166,6 +2166,392 @@ VALIDATE_INSTRUCTION(call_indirect)
     return {};
 }
 
+// https://webassembly.github.io/simd/core/valid/instructions.html#vector-instructions
+#define VALIDATE_VECTOR_UNARY_INSTRUCTION(name)   \
+    VALIDATE_INSTRUCTION(name)                    \
+    {                                             \
+        TRY((stack.take<ValueType::V128>()));     \
+        stack.append(ValueType(ValueType::V128)); \
+        return {};                                \
+    }
+
+#define VALIDATE_VECTOR_BINARY_INSTRUCTION(name)               \
+    VALIDATE_INSTRUCTION(name)                                 \
+    {                                                          \
+        TRY((stack.take<ValueType::V128, ValueType::V128>())); \
+        stack.append(ValueType(ValueType::V128));              \
+        return {};                                             \
+    }
+
+#define VALIDATE_VECTOR_TEST_INSTRUCTION(name)   \
+    VALIDATE_INSTRUCTION(name)                   \
+    {                                            \
+        TRY((stack.take<ValueType::V128>()));    \
+        stack.append(ValueType(ValueType::I32)); \
+        return {};                               \
+    }
+
+#define VALIDATE_VECTOR_SHIFT_INSTRUCTION(name)               \
+    VALIDATE_INSTRUCTION(name)                                \
+    {                                                         \
+        TRY((stack.take<ValueType::I32, ValueType::V128>())); \
+        stack.append(ValueType(ValueType::V128));             \
+        return {};                                            \
+    }
+
+#define VALIDATE_VECTOR_SPLAT_INSTRUCTION(name, kind) \
+    VALIDATE_INSTRUCTION(name)                        \
+    {                                                 \
+        TRY((stack.take<ValueType::kind>()));         \
+        stack.append(ValueType(ValueType::V128));     \
+        return {};                                    \
+    }
+
+#define VALIDATE_VECTOR_EXTRACT_LANE_INSTRUCTION(name, kind, lane_count)        \
+    VALIDATE_INSTRUCTION(name)                                                  \
+    {                                                                           \
+        auto lane = instruction.arguments().get<Instruction::LaneIndex>().lane; \
+        if (lane >= lane_count)                                                 \
+            return Errors::out_of_bounds("lane index"sv, lane, 0, lane_count);  \
+        TRY((stack.take<ValueType::V128>()));                                   \
+        stack.append(ValueType(ValueType::kind));                               \
+        return {};                                                              \
+    }
+
+#define VALIDATE_VECTOR_REPLACE_LANE_INSTRUCTION(name, kind, lane_count)        \
+    VALIDATE_INSTRUCTION(name)                                                  \
+    {                                                                           \
+        auto lane = instruction.arguments().get<Instruction::LaneIndex>().lane; \
+        if (lane >= lane_count)                                                 \
+            return Errors::out_of_bounds("lane index"sv, lane, 0, lane_count);  \
+        TRY((stack.take<ValueType::kind, ValueType::V128>()));                  \
+        stack.append(ValueType(ValueType::V128));                               \
+        return {};                                                              \
+    }
+
+#define VALIDATE_VECTOR_LOAD_INSTRUCTION(name, size)                                           \
+    VALIDATE_INSTRUCTION(name)                                                                 \
+    {                                                                                          \
+        TRY(validate(MemoryIndex { 0 }));                                                      \
+        auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();                \
+        if ((1ull << arg.align) > size)                                                        \
+            return Errors::out_of_bounds("memory op alignment"sv, 1ull << arg.align, 0, size); \
+        TRY((stack.take<ValueType::I32>()));                                                   \
+        stack.append(ValueType(ValueType::V128));                                              \
+        return {};                                                                             \
+    }
+
+#define VALIDATE_VECTOR_LOAD_LANE_INSTRUCTION(name, size)                                             \
+    VALIDATE_INSTRUCTION(name)                                                                        \
+    {                                                                                                 \
+        TRY(validate(MemoryIndex { 0 }));                                                             \
+        auto& arg = instruction.arguments().get<Instruction::MemoryAndLaneArgument>();                \
+        if ((1ull << arg.memory.align) > size)                                                        \
+            return Errors::out_of_bounds("memory op alignment"sv, 1ull << arg.memory.align, 0, size); \
+        if (arg.lane >= 16 / size)                                                                    \
+            return Errors::out_of_bounds("lane index"sv, arg.lane, 0, 16 / size);                     \
+        TRY((stack.take<ValueType::V128, ValueType::I32>()));                                         \
+        stack.append(ValueType(ValueType::V128));                                                     \
+        return {};                                                                                    \
+    }
+
+#define VALIDATE_VECTOR_STORE_LANE_INSTRUCTION(name, size)                                            \
+    VALIDATE_INSTRUCTION(name)                                                                        \
+    {                                                                                                 \
+        TRY(validate(MemoryIndex { 0 }));                                                             \
+        auto& arg = instruction.arguments().get<Instruction::MemoryAndLaneArgument>();                \
+        if ((1ull << arg.memory.align) > size)                                                        \
+            return Errors::out_of_bounds("memory op alignment"sv, 1ull << arg.memory.align, 0, size); \
+        if (arg.lane >= 16 / size)                                                                    \
+            return Errors::out_of_bounds("lane index"sv, arg.lane, 0, 16 / size);                     \
+        TRY((stack.take<ValueType::V128, ValueType::I32>()));                                         \
+        return {};                                                                                    \
+    }
+
+VALIDATE_VECTOR_LOAD_INSTRUCTION(v128_load, 16)
+VALIDATE_VECTOR_LOAD_INSTRUCTION(v128_load8x8_s, 8)
+VALIDATE_VECTOR_LOAD_INSTRUCTION(v128_load8x8_u, 8)
+VALIDATE_VECTOR_LOAD_INSTRUCTION(v128_load16x4_s, 8)
+VALIDATE_VECTOR_LOAD_INSTRUCTION(v128_load16x4_u, 8)
+VALIDATE_VECTOR_LOAD_INSTRUCTION(v128_load32x2_s, 8)
+VALIDATE_VECTOR_LOAD_INSTRUCTION(v128_load32x2_u, 8)
+VALIDATE_VECTOR_LOAD_INSTRUCTION(v128_load8_splat, 1)
+VALIDATE_VECTOR_LOAD_INSTRUCTION(v128_load16_splat, 2)
+VALIDATE_VECTOR_LOAD_INSTRUCTION(v128_load32_splat, 4)
+VALIDATE_VECTOR_LOAD_INSTRUCTION(v128_load64_splat, 8)
+
+VALIDATE_INSTRUCTION(v128_store)
+{
+    TRY(validate(MemoryIndex { 0 }));
+
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+    if ((1ull << arg.align) > 16)
+        return Errors::out_of_bounds("memory op alignment"sv, 1ull << arg.align, 0, 16);
+
+    TRY((stack.take<ValueType::V128, ValueType::I32>()));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(v128_const)
+{
+    is_constant = true;
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_INSTRUCTION(i8x16_shuffle)
+{
+    for (auto lane : instruction.arguments().get<Instruction::ShuffleArgument>().lanes) {
+        if (lane >= 32)
+            return Errors::out_of_bounds("shuffle lane"sv, lane, 0, 32);
+    }
+
+    TRY((stack.take<ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i8x16_swizzle)
+VALIDATE_VECTOR_SPLAT_INSTRUCTION(i8x16_splat, I32)
+VALIDATE_VECTOR_SPLAT_INSTRUCTION(i16x8_splat, I32)
+VALIDATE_VECTOR_SPLAT_INSTRUCTION(i32x4_splat, I32)
+VALIDATE_VECTOR_SPLAT_INSTRUCTION(i64x2_splat, I64)
+VALIDATE_VECTOR_SPLAT_INSTRUCTION(f32x4_splat, F32)
+VALIDATE_VECTOR_SPLAT_INSTRUCTION(f64x2_splat, F64)
+VALIDATE_VECTOR_EXTRACT_LANE_INSTRUCTION(i8x16_extract_lane_s, I32, 16)
+VALIDATE_VECTOR_EXTRACT_LANE_INSTRUCTION(i8x16_extract_lane_u, I32, 16)
+VALIDATE_VECTOR_REPLACE_LANE_INSTRUCTION(i8x16_replace_lane, I32, 16)
+VALIDATE_VECTOR_EXTRACT_LANE_INSTRUCTION(i16x8_extract_lane_s, I32, 8)
+VALIDATE_VECTOR_EXTRACT_LANE_INSTRUCTION(i16x8_extract_lane_u, I32, 8)
+VALIDATE_VECTOR_REPLACE_LANE_INSTRUCTION(i16x8_replace_lane, I32, 8)
+VALIDATE_VECTOR_EXTRACT_LANE_INSTRUCTION(i32x4_extract_lane, I32, 4)
+VALIDATE_VECTOR_REPLACE_LANE_INSTRUCTION(i32x4_replace_lane, I32, 4)
+VALIDATE_VECTOR_EXTRACT_LANE_INSTRUCTION(i64x2_extract_lane, I64, 2)
+VALIDATE_VECTOR_REPLACE_LANE_INSTRUCTION(i64x2_replace_lane, I64, 2)
+VALIDATE_VECTOR_EXTRACT_LANE_INSTRUCTION(f32x4_extract_lane, F32, 4)
+VALIDATE_VECTOR_REPLACE_LANE_INSTRUCTION(f32x4_replace_lane, F32, 4)
+VALIDATE_VECTOR_EXTRACT_LANE_INSTRUCTION(f64x2_extract_lane, F64, 2)
+VALIDATE_VECTOR_REPLACE_LANE_INSTRUCTION(f64x2_replace_lane, F64, 2)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i8x16_eq)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i8x16_ne)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i8x16_lt_s)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i8x16_lt_u)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i8x16_gt_s)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i8x16_gt_u)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i8x16_le_s)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i8x16_le_u)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i8x16_ge_s)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i8x16_ge_u)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i16x8_eq)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i16x8_ne)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i16x8_lt_s)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i16x8_lt_u)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i16x8_gt_s)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i16x8_gt_u)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i16x8_le_s)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i16x8_le_u)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i16x8_ge_s)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i16x8_ge_u)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i32x4_eq)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i32x4_ne)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i32x4_lt_s)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i32x4_lt_u)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i32x4_gt_s)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i32x4_gt_u)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i32x4_le_s)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i32x4_le_u)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i32x4_ge_s)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i32x4_ge_u)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(f32x4_eq)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(f32x4_ne)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(f32x4_lt)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(f32x4_gt)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(f32x4_le)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(f32x4_ge)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(f64x2_eq)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(f64x2_ne)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(f64x2_lt)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(f64x2_gt)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(f64x2_le)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(f64x2_ge)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(v128_not)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(v128_and)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(v128_andnot)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(v128_or)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(v128_xor)
+
+VALIDATE_INSTRUCTION(v128_bitselect)
+{
+    TRY((stack.take<ValueType::V128, ValueType::V128, ValueType::V128>()));
+    stack.append(ValueType(ValueType::V128));
+    return {};
+}
+
+VALIDATE_VECTOR_TEST_INSTRUCTION(v128_any_true)
+VALIDATE_VECTOR_LOAD_LANE_INSTRUCTION(v128_load8_lane, 1)
+VALIDATE_VECTOR_LOAD_LANE_INSTRUCTION(v128_load16_lane, 2)
+VALIDATE_VECTOR_LOAD_LANE_INSTRUCTION(v128_load32_lane, 4)
+VALIDATE_VECTOR_LOAD_LANE_INSTRUCTION(v128_load64_lane, 8)
+VALIDATE_VECTOR_STORE_LANE_INSTRUCTION(v128_store8_lane, 1)
+VALIDATE_VECTOR_STORE_LANE_INSTRUCTION(v128_store16_lane, 2)
+VALIDATE_VECTOR_STORE_LANE_INSTRUCTION(v128_store32_lane, 4)
+VALIDATE_VECTOR_STORE_LANE_INSTRUCTION(v128_store64_lane, 8)
+VALIDATE_VECTOR_LOAD_INSTRUCTION(v128_load32_zero, 4)
+VALIDATE_VECTOR_LOAD_INSTRUCTION(v128_load64_zero, 8)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(f32x4_demote_f64x2_zero)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(f64x2_promote_low_f32x4)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(i8x16_abs)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(i8x16_neg)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(i8x16_popcnt)
+VALIDATE_VECTOR_TEST_INSTRUCTION(i8x16_all_true)
+VALIDATE_VECTOR_TEST_INSTRUCTION(i8x16_bitmask)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i8x16_narrow_i16x8_s)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i8x16_narrow_i16x8_u)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(f32x4_ceil)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(f32x4_floor)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(f32x4_trunc)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(f32x4_nearest)
+VALIDATE_VECTOR_SHIFT_INSTRUCTION(i8x16_shl)
+VALIDATE_VECTOR_SHIFT_INSTRUCTION(i8x16_shr_s)
+VALIDATE_VECTOR_SHIFT_INSTRUCTION(i8x16_shr_u)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i8x16_add)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i8x16_add_sat_s)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i8x16_add_sat_u)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i8x16_sub)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i8x16_sub_sat_s)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i8x16_sub_sat_u)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(f64x2_ceil)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(f64x2_floor)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i8x16_min_s)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i8x16_min_u)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i8x16_max_s)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i8x16_max_u)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(f64x2_trunc)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i8x16_avgr_u)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(i16x8_extadd_pairwise_i8x16_s)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(i16x8_extadd_pairwise_i8x16_u)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(i32x4_extadd_pairwise_i16x8_s)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(i32x4_extadd_pairwise_i16x8_u)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(i16x8_abs)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(i16x8_neg)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i16x8_q15mulr_sat_s)
+VALIDATE_VECTOR_TEST_INSTRUCTION(i16x8_all_true)
+VALIDATE_VECTOR_TEST_INSTRUCTION(i16x8_bitmask)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i16x8_narrow_i32x4_s)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i16x8_narrow_i32x4_u)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(i16x8_extend_low_i8x16_s)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(i16x8_extend_high_i8x16_s)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(i16x8_extend_low_i8x16_u)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(i16x8_extend_high_i8x16_u)
+VALIDATE_VECTOR_SHIFT_INSTRUCTION(i16x8_shl)
+VALIDATE_VECTOR_SHIFT_INSTRUCTION(i16x8_shr_s)
+VALIDATE_VECTOR_SHIFT_INSTRUCTION(i16x8_shr_u)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i16x8_add)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i16x8_add_sat_s)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i16x8_add_sat_u)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i16x8_sub)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i16x8_sub_sat_s)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i16x8_sub_sat_u)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(f64x2_nearest)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i16x8_mul)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i16x8_min_s)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i16x8_min_u)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i16x8_max_s)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i16x8_max_u)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i16x8_avgr_u)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i16x8_extmul_low_i8x16_s)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i16x8_extmul_high_i8x16_s)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i16x8_extmul_low_i8x16_u)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i16x8_extmul_high_i8x16_u)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(i32x4_abs)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(i32x4_neg)
+VALIDATE_VECTOR_TEST_INSTRUCTION(i32x4_all_true)
+VALIDATE_VECTOR_TEST_INSTRUCTION(i32x4_bitmask)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(i32x4_extend_low_i16x8_s)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(i32x4_extend_high_i16x8_s)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(i32x4_extend_low_i16x8_u)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(i32x4_extend_high_i16x8_u)
+VALIDATE_VECTOR_SHIFT_INSTRUCTION(i32x4_shl)
+VALIDATE_VECTOR_SHIFT_INSTRUCTION(i32x4_shr_s)
+VALIDATE_VECTOR_SHIFT_INSTRUCTION(i32x4_shr_u)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i32x4_add)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i32x4_sub)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i32x4_mul)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i32x4_min_s)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i32x4_min_u)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i32x4_max_s)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i32x4_max_u)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i32x4_dot_i16x8_s)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i32x4_extmul_low_i16x8_s)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i32x4_extmul_high_i16x8_s)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i32x4_extmul_low_i16x8_u)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i32x4_extmul_high_i16x8_u)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(i64x2_abs)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(i64x2_neg)
+VALIDATE_VECTOR_TEST_INSTRUCTION(i64x2_all_true)
+VALIDATE_VECTOR_TEST_INSTRUCTION(i64x2_bitmask)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(i64x2_extend_low_i32x4_s)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(i64x2_extend_high_i32x4_s)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(i64x2_extend_low_i32x4_u)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(i64x2_extend_high_i32x4_u)
+VALIDATE_VECTOR_SHIFT_INSTRUCTION(i64x2_shl)
+VALIDATE_VECTOR_SHIFT_INSTRUCTION(i64x2_shr_s)
+VALIDATE_VECTOR_SHIFT_INSTRUCTION(i64x2_shr_u)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i64x2_add)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i64x2_sub)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i64x2_mul)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i64x2_eq)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i64x2_ne)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i64x2_lt_s)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i64x2_gt_s)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i64x2_le_s)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i64x2_ge_s)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i64x2_extmul_low_i32x4_s)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i64x2_extmul_high_i32x4_s)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i64x2_extmul_low_i32x4_u)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(i64x2_extmul_high_i32x4_u)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(f32x4_abs)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(f32x4_neg)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(f32x4_sqrt)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(f32x4_add)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(f32x4_sub)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(f32x4_mul)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(f32x4_div)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(f32x4_min)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(f32x4_max)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(f32x4_pmin)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(f32x4_pmax)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(f64x2_abs)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(f64x2_neg)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(f64x2_sqrt)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(f64x2_add)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(f64x2_sub)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(f64x2_mul)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(f64x2_div)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(f64x2_min)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(f64x2_max)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(f64x2_pmin)
+VALIDATE_VECTOR_BINARY_INSTRUCTION(f64x2_pmax)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(i32x4_trunc_sat_f32x4_s)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(i32x4_trunc_sat_f32x4_u)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(f32x4_convert_i32x4_s)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(f32x4_convert_i32x4_u)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(i32x4_trunc_sat_f64x2_s_zero)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(i32x4_trunc_sat_f64x2_u_zero)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(f64x2_convert_low_i32x4_s)
+VALIDATE_VECTOR_UNARY_INSTRUCTION(f64x2_convert_low_i32x4_u)
+
+#undef VALIDATE_VECTOR_UNARY_INSTRUCTION
+#undef VALIDATE_VECTOR_BINARY_INSTRUCTION
+#undef VALIDATE_VECTOR_TEST_INSTRUCTION
+#undef VALIDATE_VECTOR_SHIFT_INSTRUCTION
+#undef VALIDATE_VECTOR_SPLAT_INSTRUCTION
+#undef VALIDATE_VECTOR_EXTRACT_LANE_INSTRUCTION
+#undef VALIDATE_VECTOR_REPLACE_LANE_INSTRUCTION
+#undef VALIDATE_VECTOR_LOAD_INSTRUCTION
+#undef VALIDATE_VECTOR_LOAD_LANE_INSTRUCTION
+#undef VALIDATE_VECTOR_STORE_LANE_INSTRUCTION
+
 ErrorOr<void, ValidationError> Validator::validate(Instruction const& instruction, Stack& stack, bool& is_constant)
 {
     switch (instruction.opcode().value()) {
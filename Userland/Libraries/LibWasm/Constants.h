@@ -15,6 +15,7 @@ static constexpr auto i32_tag = 0x7f;
 static constexpr auto i64_tag = 0x7e;
 static constexpr auto f32_tag = 0x7d;
 static constexpr auto f64_tag = 0x7c;
+static constexpr auto v128_tag = 0x7b;
 static constexpr auto function_reference_tag = 0x70;
 static constexpr auto extern_reference_tag = 0x6f;
 
@@ -42,5 +43,8 @@ static constexpr auto minimum_stack_space_to_keep_free = 256 * KiB; // Note: Val
 static constexpr auto max_allowed_executed_instructions_per_call = 256 * 1024 * 1024;
 static constexpr auto max_allowed_vector_size = 500 * MiB;
 static constexpr auto max_allowed_function_locals_per_type = 42069; // Note: VERY arbitrary.
+static constexpr auto max_allowed_value_stack_slots = 16 * MiB;     // Note: Only used by lowered functions, each slot is 8 bytes.
+// Note: Covers every u32 address plus u32 offset plus access size, so guarded memories never need a bounds check.
+static constexpr u64 guarded_memory_reservation_size = 8 * GiB + page_size;
 
 }
@@ -0,0 +1,325 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/NumericLimits.h>
+#include <AK/Optional.h>
+#include <AK/StdLibExtras.h>
+#include <AK/Types.h>
+#include <AK/Vector.h>
+#include <initializer_list>
+
+namespace Wasm::JIT {
+
+// A tiny x86_64 encoder, covering just the instructions the compiler needs.
+// Memory operands are always encoded with a 32-bit displacement, which keeps the encoding uniform at the cost of a few bytes.
+class Assembler {
+public:
+    enum class Reg : u8 {
+        RAX = 0,
+        RCX,
+        RDX,
+        RBX,
+        RSP,
+        RBP,
+        RSI,
+        RDI,
+        R8,
+        R9,
+        R10,
+        R11,
+        R12,
+        R13,
+        R14,
+        R15,
+    };
+
+    enum class XmmReg : u8 {
+        XMM0 = 0,
+        XMM1,
+    };
+
+    enum class Width : u8 {
+        Dword,
+        Qword,
+    };
+
+    // The low nibble of the Jcc/SETcc/CMOVcc opcodes.
+    enum class Condition : u8 {
+        Below = 0x2,
+        AboveOrEqual = 0x3,
+        Equal = 0x4,
+        NotEqual = 0x5,
+        BelowOrEqual = 0x6,
+        Above = 0x7,
+        Parity = 0xa,
+        NotParity = 0xb,
+        Less = 0xc,
+        GreaterOrEqual = 0xd,
+        LessOrEqual = 0xe,
+        Greater = 0xf,
+    };
+
+    enum class AluOp : u8 {
+        Add = 0x03,
+        Or = 0x0b,
+        And = 0x23,
+        Sub = 0x2b,
+        Xor = 0x33,
+        Cmp = 0x3b,
+    };
+
+    enum class ShiftOp : u8 {
+        RotateLeft = 0,
+        RotateRight = 1,
+        ShiftLeft = 4,
+        ShiftRightLogical = 5,
+        ShiftRightArithmetic = 7,
+    };
+
+    enum class SseOp : u8 {
+        Add = 0x58,
+        Multiply = 0x59,
+        Subtract = 0x5c,
+        Divide = 0x5e,
+    };
+
+    // [base + index * 2^scale + displacement]
+    struct Memory {
+        Reg base;
+        Optional<Reg> index {};
+        u8 scale { 0 };
+        i32 displacement { 0 };
+    };
+
+    static Memory at(Reg base, i32 displacement = 0) { return { base, {}, 0, displacement }; }
+    static Memory at(Reg base, Reg index, u8 scale, i32 displacement = 0) { return { base, index, scale, displacement }; }
+
+    struct Label {
+        Optional<size_t> offset;
+        Vector<size_t> unresolved_references;
+    };
+
+    Vector<u8> const& output() const { return m_output; }
+    size_t current_offset() const { return m_output.size(); }
+
+    void bind(Label& label)
+    {
+        VERIFY(!label.offset.has_value());
+        label.offset = current_offset();
+        for (auto reference : label.unresolved_references)
+            patch_u32(reference, static_cast<u32>(current_offset() - (reference + 4)));
+        label.unresolved_references.clear();
+    }
+
+    void patch_u32(size_t offset, u32 value)
+    {
+        for (size_t i = 0; i < 4; ++i)
+            m_output[offset + i] = static_cast<u8>(value >> (i * 8));
+    }
+
+    void emit_u32(u32 value)
+    {
+        for (size_t i = 0; i < 4; ++i)
+            m_output.append(static_cast<u8>(value >> (i * 8)));
+    }
+
+    // mov reg, [memory]
+    void load(Width width, Reg destination, Memory const& source) { emit_memory_instruction({}, width == Width::Qword, { 0x8b }, to_underlying(destination), source); }
+    // mov [memory], reg
+    void store(Width width, Memory const& destination, Reg source) { emit_memory_instruction({}, width == Width::Qword, { 0x89 }, to_underlying(source), destination); }
+    void store8(Memory const& destination, Reg source) { emit_memory_instruction({}, false, { 0x88 }, to_underlying(source), destination, to_underlying(source) >= 4); }
+    void store16(Memory const& destination, Reg source) { emit_memory_instruction(0x66, false, { 0x89 }, to_underlying(source), destination); }
+
+    // movzx/movsx reg, byte/word [memory], and movsxd reg, dword [memory]
+    void load_zero_extended8(Width width, Reg destination, Memory const& source) { emit_memory_instruction({}, width == Width::Qword, { 0x0f, 0xb6 }, to_underlying(destination), source); }
+    void load_zero_extended16(Width width, Reg destination, Memory const& source) { emit_memory_instruction({}, width == Width::Qword, { 0x0f, 0xb7 }, to_underlying(destination), source); }
+    void load_sign_extended8(Width width, Reg destination, Memory const& source) { emit_memory_instruction({}, width == Width::Qword, { 0x0f, 0xbe }, to_underlying(destination), source); }
+    void load_sign_extended16(Width width, Reg destination, Memory const& source) { emit_memory_instruction({}, width == Width::Qword, { 0x0f, 0xbf }, to_underlying(destination), source); }
+    void load_sign_extended32(Reg destination, Memory const& source) { emit_memory_instruction({}, true, { 0x63 }, to_underlying(destination), source); }
+
+    void lea(Reg destination, Memory const& source) { emit_memory_instruction({}, true, { 0x8d }, to_underlying(destination), source); }
+
+    // lea reg, [rip + label]
+    void lea(Reg destination, Label& label)
+    {
+        emit_rex(true, to_underlying(destination), 0, 0);
+        m_output.append(0x8d);
+        m_output.append(static_cast<u8>(((to_underlying(destination) & 7) << 3) | 0b101));
+        emit_label_reference(label);
+    }
+
+    void mov(Width width, Reg destination, Reg source) { emit_register_instruction({}, width == Width::Qword, { 0x89 }, to_underlying(source), to_underlying(destination)); }
+
+    void mov(Reg destination, u64 immediate)
+    {
+        if (immediate <= NumericLimits<u32>::max()) {
+            // NOTE: Writing the low half zero-extends into the full register.
+            emit_rex(false, 0, 0, to_underlying(destination));
+            m_output.append(static_cast<u8>(0xb8 | (to_underlying(destination) & 7)));
+            emit_u32(static_cast<u32>(immediate));
+            return;
+        }
+        emit_rex(true, 0, 0, to_underlying(destination));
+        m_output.append(static_cast<u8>(0xb8 | (to_underlying(destination) & 7)));
+        emit_u32(static_cast<u32>(immediate));
+        emit_u32(static_cast<u32>(immediate >> 32));
+    }
+
+    // op reg, [memory]
+    void alu(AluOp op, Width width, Reg destination, Memory const& source) { emit_memory_instruction({}, width == Width::Qword, { to_underlying(op) }, to_underlying(destination), source); }
+    // op destination, source
+    void alu(AluOp op, Width width, Reg destination, Reg source) { emit_register_instruction({}, width == Width::Qword, { to_underlying(op) }, to_underlying(destination), to_underlying(source)); }
+    // imul reg, [memory]
+    void imul(Width width, Reg destination, Memory const& source) { emit_memory_instruction({}, width == Width::Qword, { 0x0f, 0xaf }, to_underlying(destination), source); }
+    // op reg, cl
+    void shift(ShiftOp op, Width width, Reg destination) { emit_register_instruction({}, width == Width::Qword, { 0xd3 }, to_underlying(op), to_underlying(destination)); }
+
+    // op reg, imm8
+    void shift(ShiftOp op, Width width, Reg destination, u8 count)
+    {
+        emit_register_instruction({}, width == Width::Qword, { 0xc1 }, to_underlying(op), to_underlying(destination));
+        m_output.append(count);
+    }
+
+    // cmp reg, imm8
+    void compare_with_immediate(Width width, Reg reg, i8 immediate)
+    {
+        emit_register_instruction({}, width == Width::Qword, { 0x83 }, 7, to_underlying(reg));
+        m_output.append(static_cast<u8>(immediate));
+    }
+
+    // cmp [memory], imm8
+    void compare_with_immediate(Width width, Memory const& memory, i8 immediate)
+    {
+        emit_memory_instruction({}, width == Width::Qword, { 0x83 }, 7, memory);
+        m_output.append(static_cast<u8>(immediate));
+    }
+
+    void add(Reg destination, i32 immediate)
+    {
+        emit_register_instruction({}, true, { 0x81 }, 0, to_underlying(destination));
+        emit_u32(static_cast<u32>(immediate));
+    }
+
+    void sub(Reg destination, i32 immediate)
+    {
+        emit_register_instruction({}, true, { 0x81 }, 5, to_underlying(destination));
+        emit_u32(static_cast<u32>(immediate));
+    }
+
+    // setcc reg8
+    void set(Condition condition, Reg destination) { emit_register_instruction({}, false, { 0x0f, static_cast<u8>(0x90 | to_underlying(condition)) }, 0, to_underlying(destination), to_underlying(destination) >= 4); }
+    // movzx reg32, reg8
+    void zero_extend8(Reg destination, Reg source) { emit_register_instruction({}, false, { 0x0f, 0xb6 }, to_underlying(destination), to_underlying(source), to_underlying(source) >= 4); }
+    // cmovcc reg, [memory]
+    void cmov(Condition condition, Width width, Reg destination, Memory const& source) { emit_memory_instruction({}, width == Width::Qword, { 0x0f, static_cast<u8>(0x40 | to_underlying(condition)) }, to_underlying(destination), source); }
+    // cmovcc destination, source
+    void cmov(Condition condition, Width width, Reg destination, Reg source) { emit_register_instruction({}, width == Width::Qword, { 0x0f, static_cast<u8>(0x40 | to_underlying(condition)) }, to_underlying(destination), to_underlying(source)); }
+
+    void jump(Label& label)
+    {
+        m_output.append(0xe9);
+        emit_label_reference(label);
+    }
+
+    void jump_if(Condition condition, Label& label)
+    {
+        m_output.append(0x0f);
+        m_output.append(static_cast<u8>(0x80 | to_underlying(condition)));
+        emit_label_reference(label);
+    }
+
+    void jump(Reg target) { emit_register_instruction({}, false, { 0xff }, 4, to_underlying(target)); }
+    void call(Reg target) { emit_register_instruction({}, false, { 0xff }, 2, to_underlying(target)); }
+
+    void push(Reg reg)
+    {
+        emit_rex(false, 0, 0, to_underlying(reg));
+        m_output.append(static_cast<u8>(0x50 | (to_underlying(reg) & 7)));
+    }
+
+    void pop(Reg reg)
+    {
+        emit_rex(false, 0, 0, to_underlying(reg));
+        m_output.append(static_cast<u8>(0x58 | (to_underlying(reg) & 7)));
+    }
+
+    void ret() { m_output.append(0xc3); }
+
+    // movss/movsd xmm, [memory]
+    void load(Width width, XmmReg destination, Memory const& source) { emit_memory_instruction(sse_prefix(width), false, { 0x0f, 0x10 }, to_underlying(destination), source); }
+    // movss/movsd [memory], xmm
+    void store(Width width, Memory const& destination, XmmReg source) { emit_memory_instruction(sse_prefix(width), false, { 0x0f, 0x11 }, to_underlying(source), destination); }
+    // addss/addsd etc. xmm, [memory]
+    void sse(SseOp op, Width width, XmmReg destination, Memory const& source) { emit_memory_instruction(sse_prefix(width), false, { 0x0f, to_underlying(op) }, to_underlying(destination), source); }
+    // ucomiss/ucomisd xmm, [memory]
+    void unordered_compare(Width width, XmmReg lhs, Memory const& rhs)
+    {
+        emit_memory_instruction(width == Width::Qword ? Optional<u8> { 0x66 } : Optional<u8> {}, false, { 0x0f, 0x2e }, to_underlying(lhs), rhs);
+    }
+    // movd reg32, xmm
+    void move_to_general_purpose(Reg destination, XmmReg source) { emit_register_instruction(0x66, false, { 0x0f, 0x7e }, to_underlying(source), to_underlying(destination)); }
+
+private:
+    static u8 sse_prefix(Width width) { return width == Width::Qword ? 0xf2 : 0xf3; }
+
+    void emit_rex(bool w, u8 reg, u8 index, u8 base, bool force = false)
+    {
+        u8 rex = 0x40 | (w ? 0x08 : 0) | ((reg & 8) ? 0x04 : 0) | ((index & 8) ? 0x02 : 0) | ((base & 8) ? 0x01 : 0);
+        if (rex != 0x40 || force)
+            m_output.append(rex);
+    }
+
+    void emit_label_reference(Label& label)
+    {
+        auto reference = current_offset();
+        if (label.offset.has_value()) {
+            emit_u32(static_cast<u32>(label.offset.value() - (reference + 4)));
+            return;
+        }
+        label.unresolved_references.append(reference);
+        emit_u32(0);
+    }
+
+    void emit_register_instruction(Optional<u8> prefix, bool w, std::initializer_list<u8> opcode, u8 reg, u8 rm, bool force_rex = false)
+    {
+        if (prefix.has_value())
+            m_output.append(*prefix);
+        emit_rex(w, reg, 0, rm, force_rex);
+        for (auto byte : opcode)
+            m_output.append(byte);
+        m_output.append(static_cast<u8>(0xc0 | ((reg & 7) << 3) | (rm & 7)));
+    }
+
+    void emit_memory_instruction(Optional<u8> prefix, bool w, std::initializer_list<u8> opcode, u8 reg, Memory const& memory, bool force_rex = false)
+    {
+        auto base = to_underlying(memory.base);
+        u8 index = memory.index.has_value() ? to_underlying(*memory.index) : 0;
+        VERIFY(!memory.index.has_value() || *memory.index != Reg::RSP);
+
+        if (prefix.has_value())
+            m_output.append(*prefix);
+        emit_rex(w, reg, index, base, force_rex);
+        for (auto byte : opcode)
+            m_output.append(byte);
+
+        // NOTE: mod=10 means a 32-bit displacement. rm=100 means a SIB byte follows, which RSP and R12 always need as a base.
+        if (memory.index.has_value() || (base & 7) == 4) {
+            m_output.append(static_cast<u8>(0x80 | ((reg & 7) << 3) | 0b100));
+            u8 index_bits = memory.index.has_value() ? (index & 7) : 0b100;
+            m_output.append(static_cast<u8>((memory.scale << 6) | (index_bits << 3) | (base & 7)));
+        } else {
+            m_output.append(static_cast<u8>(0x80 | ((reg & 7) << 3) | (base & 7)));
+        }
+        emit_u32(static_cast<u32>(memory.displacement));
+    }
+
+    Vector<u8> m_output;
+};
+
+}
@@ -0,0 +1,705 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <AK/ScopeGuard.h>
+#include <LibCore/System.h>
+#include <LibWasm/JIT/Assembler.h>
+#include <LibWasm/JIT/Compiler.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+
+namespace Wasm::JIT {
+
+NativeFunction::~NativeFunction()
+{
+    MUST(Core::System::munmap(m_code, m_size));
+}
+
+#if ARCH(X86_64)
+
+using Reg = Assembler::Reg;
+using XmmReg = Assembler::XmmReg;
+using Width = Assembler::Width;
+using Condition = Assembler::Condition;
+using AluOp = Assembler::AluOp;
+using ShiftOp = Assembler::ShiftOp;
+using SseOp = Assembler::SseOp;
+
+// These are all callee-saved, so they survive calls into the runtime.
+static constexpr auto slots_register = Reg::RBX;
+static constexpr auto memory_data_register = Reg::R12;
+static constexpr auto memory_size_register = Reg::R13;
+static constexpr auto frame_register = Reg::R14;
+static constexpr auto instructions_register = Reg::R15;
+
+static Assembler::Memory slot(u32 index)
+{
+    return Assembler::at(slots_register, static_cast<i32>(index * sizeof(u64)));
+}
+
+static Assembler::Memory frame_field(size_t offset)
+{
+    return Assembler::at(frame_register, static_cast<i32>(offset));
+}
+
+class FunctionCompiler {
+public:
+    FunctionCompiler(LoweredFunction const& function, bool assume_guarded_memory, RuntimeHelpers const& helpers)
+        : m_function(function)
+        , m_assume_guarded_memory(assume_guarded_memory)
+        , m_helpers(helpers)
+    {
+    }
+
+    bool compile()
+    {
+        // NOTE: Slots are addressed with 32-bit displacements.
+        if (m_function.frame_size() * sizeof(u64) > static_cast<size_t>(NumericLimits<i32>::max()))
+            return false;
+
+        auto& instructions = m_function.instructions();
+        m_instruction_labels.resize(instructions.size());
+
+        emit_prologue();
+        for (size_t i = 0; i < instructions.size(); ++i) {
+            m_assembler.bind(m_instruction_labels[i]);
+            if (!compile_instruction(i, instructions[i]))
+                return false;
+        }
+
+        m_assembler.bind(m_out_of_bounds);
+        m_assembler.mov(Width::Qword, Reg::RDI, frame_register);
+        m_assembler.mov(Width::Qword, Reg::RSI, instructions_register);
+        emit_call(m_helpers.out_of_bounds);
+
+        m_assembler.bind(m_epilogue);
+        emit_epilogue();
+        return true;
+    }
+
+    Vector<u8> const& code() const { return m_assembler.output(); }
+
+private:
+    void emit_prologue()
+    {
+        m_assembler.push(Reg::RBP);
+        m_assembler.mov(Width::Qword, Reg::RBP, Reg::RSP);
+        m_assembler.push(Reg::RBX);
+        m_assembler.push(Reg::R12);
+        m_assembler.push(Reg::R13);
+        m_assembler.push(Reg::R14);
+        m_assembler.push(Reg::R15);
+        // NOTE: Keeps the stack 16-byte aligned for the calls we make.
+        m_assembler.sub(Reg::RSP, 8);
+
+        m_assembler.mov(Width::Qword, frame_register, Reg::RDI);
+        m_assembler.load(Width::Qword, instructions_register, frame_field(offsetof(NativeFrame, instructions)));
+        reload_frame_registers();
+    }
+
+    void emit_epilogue()
+    {
+        m_assembler.add(Reg::RSP, 8);
+        m_assembler.pop(Reg::R15);
+        m_assembler.pop(Reg::R14);
+        m_assembler.pop(Reg::R13);
+        m_assembler.pop(Reg::R12);
+        m_assembler.pop(Reg::RBX);
+        m_assembler.pop(Reg::RBP);
+        m_assembler.ret();
+    }
+
+    void reload_frame_registers()
+    {
+        m_assembler.load(Width::Qword, slots_register, frame_field(offsetof(NativeFrame, slots)));
+        m_assembler.load(Width::Qword, memory_data_register, frame_field(offsetof(NativeFrame, memory_data)));
+        m_assembler.load(Width::Qword, memory_size_register, frame_field(offsetof(NativeFrame, memory_size)));
+    }
+
+    void emit_call(RuntimeHelper helper)
+    {
+        m_assembler.mov(Reg::RAX, bit_cast<FlatPtr>(helper));
+        m_assembler.call(Reg::RAX);
+    }
+
+    // Hands the instruction to the runtime, and leaves the function unless it says to carry on.
+    void emit_helper_call(RuntimeHelper helper, size_t index, bool may_change_frame)
+    {
+        m_assembler.mov(Width::Qword, Reg::RDI, frame_register);
+        m_assembler.lea(Reg::RSI, Assembler::at(instructions_register, static_cast<i32>(index * sizeof(LoweredInstruction))));
+        emit_call(helper);
+        m_assembler.compare_with_immediate(Width::Dword, Reg::RAX, static_cast<i8>(NativeStatus::Ok));
+        m_assembler.jump_if(Condition::NotEqual, m_epilogue);
+        if (may_change_frame)
+            reload_frame_registers();
+    }
+
+    void emit_branch_moves(u32 destination, u32 source, u32 count)
+    {
+        if (destination == source)
+            return;
+        // NOTE: Branches only ever move values down the stack, so a forward copy is safe.
+        for (u32 i = 0; i < count; ++i) {
+            m_assembler.load(Width::Qword, Reg::RAX, slot(source + i));
+            m_assembler.store(Width::Qword, slot(destination + i), Reg::RAX);
+        }
+    }
+
+    void emit_jump_to(LoweredBranchTarget const& target, u32 source, u32 count)
+    {
+        emit_branch_moves(target.result_slot, source, count);
+        m_assembler.jump(m_instruction_labels[target.ip]);
+    }
+
+    void emit_store_result(u32 destination, Reg source)
+    {
+        m_assembler.store(Width::Qword, slot(destination), source);
+    }
+
+    void emit_integer_arithmetic(AluOp op, Width width, LoweredInstruction const& instruction)
+    {
+        m_assembler.load(width, Reg::RAX, slot(instruction.b));
+        m_assembler.alu(op, width, Reg::RAX, slot(instruction.c));
+        emit_store_result(instruction.a, Reg::RAX);
+    }
+
+    void emit_integer_multiply(Width width, LoweredInstruction const& instruction)
+    {
+        m_assembler.load(width, Reg::RAX, slot(instruction.b));
+        m_assembler.imul(width, Reg::RAX, slot(instruction.c));
+        emit_store_result(instruction.a, Reg::RAX);
+    }
+
+    void emit_integer_shift(ShiftOp op, Width width, LoweredInstruction const& instruction)
+    {
+        // NOTE: x86 masks the shift count to the operand width, just like WebAssembly does.
+        m_assembler.load(width, Reg::RAX, slot(instruction.b));
+        m_assembler.load(Width::Dword, Reg::RCX, slot(instruction.c));
+        m_assembler.shift(op, width, Reg::RAX);
+        emit_store_result(instruction.a, Reg::RAX);
+    }
+
+    void emit_set_result(Condition condition, u32 destination)
+    {
+        m_assembler.set(condition, Reg::RAX);
+        m_assembler.zero_extend8(Reg::RAX, Reg::RAX);
+        emit_store_result(destination, Reg::RAX);
+    }
+
+    void emit_integer_comparison(Condition condition, Width width, LoweredInstruction const& instruction)
+    {
+        m_assembler.load(width, Reg::RAX, slot(instruction.b));
+        m_assembler.alu(AluOp::Cmp, width, Reg::RAX, slot(instruction.c));
+        emit_set_result(condition, instruction.a);
+    }
+
+    void emit_float_arithmetic(SseOp op, Width width, LoweredInstruction const& instruction)
+    {
+        m_assembler.load(width, XmmReg::XMM0, slot(instruction.b));
+        m_assembler.sse(op, width, XmmReg::XMM0, slot(instruction.c));
+        if (width == Width::Dword) {
+            // NOTE: Goes through a general purpose register so that the upper half of the slot is cleared.
+            m_assembler.move_to_general_purpose(Reg::RAX, XmmReg::XMM0);
+            emit_store_result(instruction.a, Reg::RAX);
+        } else {
+            m_assembler.store(width, slot(instruction.a), XmmReg::XMM0);
+        }
+    }
+
+    enum class FloatComparison {
+        Equal,
+        NotEqual,
+        Less,
+        Greater,
+        LessOrEqual,
+        GreaterOrEqual,
+    };
+
+    void emit_float_comparison(FloatComparison comparison, Width width, LoweredInstruction const& instruction)
+    {
+        // NOTE: An unordered comparison sets ZF, PF and CF, so "above (or equal)" is false for NaNs, and (in)equality has to look at PF.
+        //       Less-than comparisons are done as greater-than comparisons with swapped operands for the same reason.
+        auto swap_operands = comparison == FloatComparison::Less || comparison == FloatComparison::LessOrEqual;
+        m_assembler.load(width, XmmReg::XMM0, slot(swap_operands ? instruction.c : instruction.b));
+        m_assembler.unordered_compare(width, XmmReg::XMM0, slot(swap_operands ? instruction.b : instruction.c));
+        switch (comparison) {
+        case FloatComparison::Equal:
+        case FloatComparison::NotEqual: {
+            auto is_equal = comparison == FloatComparison::Equal;
+            m_assembler.set(is_equal ? Condition::Equal : Condition::NotEqual, Reg::RAX);
+            m_assembler.set(is_equal ? Condition::NotParity : Condition::Parity, Reg::RCX);
+            m_assembler.zero_extend8(Reg::RAX, Reg::RAX);
+            m_assembler.zero_extend8(Reg::RCX, Reg::RCX);
+            m_assembler.alu(is_equal ? AluOp::And : AluOp::Or, Width::Dword, Reg::RAX, Reg::RCX);
+            emit_store_result(instruction.a, Reg::RAX);
+            return;
+        }
+        case FloatComparison::Less:
+        case FloatComparison::Greater:
+            emit_set_result(Condition::Above, instruction.a);
+            return;
+        case FloatComparison::LessOrEqual:
+        case FloatComparison::GreaterOrEqual:
+            emit_set_result(Condition::AboveOrEqual, instruction.a);
+            return;
+        }
+        VERIFY_NOT_REACHED();
+    }
+
+    // Leaves the effective address of an access to slots[b] + immediate in RAX, and returns the memory operand for it.
+    Assembler::Memory emit_effective_address(LoweredInstruction const& instruction, size_t access_size)
+    {
+        m_assembler.load(Width::Dword, Reg::RAX, slot(instruction.b));
+        if (!m_assume_guarded_memory) {
+            m_assembler.mov(Reg::RDX, instruction.immediate + access_size);
+            m_assembler.alu(AluOp::Add, Width::Qword, Reg::RDX, Reg::RAX);
+            m_assembler.alu(AluOp::Cmp, Width::Qword, Reg::RDX, memory_size_register);
+            m_assembler.jump_if(Condition::Above, m_out_of_bounds);
+        }
+        if (instruction.immediate <= static_cast<u64>(NumericLimits<i32>::max()))
+            return Assembler::at(memory_data_register, Reg::RAX, 0, static_cast<i32>(instruction.immediate));
+        m_assembler.mov(Reg::RDX, instruction.immediate);
+        m_assembler.alu(AluOp::Add, Width::Qword, Reg::RAX, Reg::RDX);
+        return Assembler::at(memory_data_register, Reg::RAX, 0);
+    }
+
+    enum class Extension {
+        Zero,
+        Sign,
+    };
+
+    void emit_load(LoweredInstruction const& instruction, size_t access_size, Extension extension, Width result_width)
+    {
+        auto address = emit_effective_address(instruction, access_size);
+        switch (access_size) {
+        case 1:
+            if (extension == Extension::Sign)
+                m_assembler.load_sign_extended8(result_width, Reg::RCX, address);
+            else
+                m_assembler.load_zero_extended8(Width::Dword, Reg::RCX, address);
+            break;
+        case 2:
+            if (extension == Extension::Sign)
+                m_assembler.load_sign_extended16(result_width, Reg::RCX, address);
+            else
+                m_assembler.load_zero_extended16(Width::Dword, Reg::RCX, address);
+            break;
+        case 4:
+            if (extension == Extension::Sign && result_width == Width::Qword)
+                m_assembler.load_sign_extended32(Reg::RCX, address);
+            else
+                m_assembler.load(Width::Dword, Reg::RCX, address);
+            break;
+        case 8:
+            m_assembler.load(Width::Qword, Reg::RCX, address);
+            break;
+        default:
+            VERIFY_NOT_REACHED();
+        }
+        emit_store_result(instruction.a, Reg::RCX);
+    }
+
+    void emit_store(LoweredInstruction const& instruction, size_t access_size)
+    {
+        m_assembler.load(Width::Qword, Reg::RCX, slot(instruction.a));
+        auto address = emit_effective_address(instruction, access_size);
+        switch (access_size) {
+        case 1:
+            m_assembler.store8(address, Reg::RCX);
+            break;
+        case 2:
+            m_assembler.store16(address, Reg::RCX);
+            break;
+        case 4:
+            m_assembler.store(Width::Dword, address, Reg::RCX);
+            break;
+        case 8:
+            m_assembler.store(Width::Qword, address, Reg::RCX);
+            break;
+        default:
+            VERIFY_NOT_REACHED();
+        }
+    }
+
+    void emit_copy(LoweredInstruction const& instruction)
+    {
+        m_assembler.load(Width::Qword, Reg::RAX, slot(instruction.b));
+        emit_store_result(instruction.a, Reg::RAX);
+    }
+
+    void emit_jump_table(LoweredInstruction const& instruction)
+    {
+        // NOTE: The table holds the offset of one stub per target relative to the table itself; each stub moves the branch values and jumps.
+        Assembler::Label table;
+        m_assembler.load(Width::Dword, Reg::RAX, slot(instruction.a));
+        m_assembler.mov(Reg::RCX, instruction.d);
+        m_assembler.alu(AluOp::Cmp, Width::Dword, Reg::RAX, Reg::RCX);
+        m_assembler.cmov(Condition::Above, Width::Dword, Reg::RAX, Reg::RCX);
+        m_assembler.lea(Reg::RCX, table);
+        m_assembler.load_sign_extended32(Reg::RDX, Assembler::at(Reg::RCX, Reg::RAX, 2));
+        m_assembler.alu(AluOp::Add, Width::Qword, Reg::RDX, Reg::RCX);
+        m_assembler.jump(Reg::RDX);
+
+        m_assembler.bind(table);
+        auto table_offset = m_assembler.current_offset();
+        for (u32 i = 0; i <= instruction.d; ++i)
+            m_assembler.emit_u32(0);
+        auto& branch_targets = m_function.branch_targets();
+        for (u32 i = 0; i <= instruction.d; ++i) {
+            m_assembler.patch_u32(table_offset + i * sizeof(u32), static_cast<u32>(m_assembler.current_offset() - table_offset));
+            emit_jump_to(branch_targets[instruction.immediate + i], instruction.b, instruction.c);
+        }
+    }
+
+    bool compile_instruction(size_t index, LoweredInstruction const& instruction)
+    {
+        auto& branch_targets = m_function.branch_targets();
+
+        switch (instruction.opcode) {
+        case LoweredOpCode::i32_add:
+            emit_integer_arithmetic(AluOp::Add, Width::Dword, instruction);
+            return true;
+        case LoweredOpCode::i32_sub:
+            emit_integer_arithmetic(AluOp::Sub, Width::Dword, instruction);
+            return true;
+        case LoweredOpCode::i32_and:
+            emit_integer_arithmetic(AluOp::And, Width::Dword, instruction);
+            return true;
+        case LoweredOpCode::i32_or:
+            emit_integer_arithmetic(AluOp::Or, Width::Dword, instruction);
+            return true;
+        case LoweredOpCode::i32_xor:
+            emit_integer_arithmetic(AluOp::Xor, Width::Dword, instruction);
+            return true;
+        case LoweredOpCode::i32_mul:
+            emit_integer_multiply(Width::Dword, instruction);
+            return true;
+        case LoweredOpCode::i64_add:
+            emit_integer_arithmetic(AluOp::Add, Width::Qword, instruction);
+            return true;
+        case LoweredOpCode::i64_sub:
+            emit_integer_arithmetic(AluOp::Sub, Width::Qword, instruction);
+            return true;
+        case LoweredOpCode::i64_and:
+            emit_integer_arithmetic(AluOp::And, Width::Qword, instruction);
+            return true;
+        case LoweredOpCode::i64_or:
+            emit_integer_arithmetic(AluOp::Or, Width::Qword, instruction);
+            return true;
+        case LoweredOpCode::i64_xor:
+            emit_integer_arithmetic(AluOp::Xor, Width::Qword, instruction);
+            return true;
+        case LoweredOpCode::i64_mul:
+            emit_integer_multiply(Width::Qword, instruction);
+            return true;
+
+        case LoweredOpCode::i32_shl:
+            emit_integer_shift(ShiftOp::ShiftLeft, Width::Dword, instruction);
+            return true;
+        case LoweredOpCode::i32_shrs:
+            emit_integer_shift(ShiftOp::ShiftRightArithmetic, Width::Dword, instruction);
+            return true;
+        case LoweredOpCode::i32_shru:
+            emit_integer_shift(ShiftOp::ShiftRightLogical, Width::Dword, instruction);
+            return true;
+        case LoweredOpCode::i32_rotl:
+            emit_integer_shift(ShiftOp::RotateLeft, Width::Dword, instruction);
+            return true;
+        case LoweredOpCode::i32_rotr:
+            emit_integer_shift(ShiftOp::RotateRight, Width::Dword, instruction);
+            return true;
+        case LoweredOpCode::i64_shl:
+            emit_integer_shift(ShiftOp::ShiftLeft, Width::Qword, instruction);
+            return true;
+        case LoweredOpCode::i64_shrs:
+            emit_integer_shift(ShiftOp::ShiftRightArithmetic, Width::Qword, instruction);
+            return true;
+        case LoweredOpCode::i64_shru:
+            emit_integer_shift(ShiftOp::ShiftRightLogical, Width::Qword, instruction);
+            return true;
+        case LoweredOpCode::i64_rotl:
+            emit_integer_shift(ShiftOp::RotateLeft, Width::Qword, instruction);
+            return true;
+        case LoweredOpCode::i64_rotr:
+            emit_integer_shift(ShiftOp::RotateRight, Width::Qword, instruction);
+            return true;
+
+#define __COMPILE_INTEGER_COMPARISONS(prefix, width)                                \
+    case LoweredOpCode::prefix##_eq:                                                \
+        emit_integer_comparison(Condition::Equal, width, instruction);              \
+        return true;                                                                \
+    case LoweredOpCode::prefix##_ne:                                                \
+        emit_integer_comparison(Condition::NotEqual, width, instruction);           \
+        return true;                                                                \
+    case LoweredOpCode::prefix##_lts:                                               \
+        emit_integer_comparison(Condition::Less, width, instruction);               \
+        return true;                                                                \
+    case LoweredOpCode::prefix##_ltu:                                               \
+        emit_integer_comparison(Condition::Below, width, instruction);              \
+        return true;                                                                \
+    case LoweredOpCode::prefix##_gts:                                               \
+        emit_integer_comparison(Condition::Greater, width, instruction);            \
+        return true;                                                                \
+    case LoweredOpCode::prefix##_gtu:                                               \
+        emit_integer_comparison(Condition::Above, width, instruction);              \
+        return true;                                                                \
+    case LoweredOpCode::prefix##_les:                                               \
+        emit_integer_comparison(Condition::LessOrEqual, width, instruction);        \
+        return true;                                                                \
+    case LoweredOpCode::prefix##_leu:                                               \
+        emit_integer_comparison(Condition::BelowOrEqual, width, instruction);       \
+        return true;                                                                \
+    case LoweredOpCode::prefix##_ges:                                               \
+        emit_integer_comparison(Condition::GreaterOrEqual, width, instruction);     \
+        return true;                                                                \
+    case LoweredOpCode::prefix##_geu:                                               \
+        emit_integer_comparison(Condition::AboveOrEqual, width, instruction);       \
+        return true;                                                                \
+    case LoweredOpCode::prefix##_eqz:                                               \
+        m_assembler.compare_with_immediate(width, slot(instruction.b), 0);          \
+        emit_set_result(Condition::Equal, instruction.a);                           \
+        return true;
+            __COMPILE_INTEGER_COMPARISONS(i32, Width::Dword)
+            __COMPILE_INTEGER_COMPARISONS(i64, Width::Qword)
+#undef __COMPILE_INTEGER_COMPARISONS
+
+#define __COMPILE_FLOAT_OPERATIONS(prefix, width)                                     \
+    case LoweredOpCode::prefix##_eq:                                                  \
+        emit_float_comparison(FloatComparison::Equal, width, instruction);            \
+        return true;                                                                  \
+    case LoweredOpCode::prefix##_ne:                                                  \
+        emit_float_comparison(FloatComparison::NotEqual, width, instruction);         \
+        return true;                                                                  \
+    case LoweredOpCode::prefix##_lt:                                                  \
+        emit_float_comparison(FloatComparison::Less, width, instruction);             \
+        return true;                                                                  \
+    case LoweredOpCode::prefix##_gt:                                                  \
+        emit_float_comparison(FloatComparison::Greater, width, instruction);          \
+        return true;                                                                  \
+    case LoweredOpCode::prefix##_le:                                                  \
+        emit_float_comparison(FloatComparison::LessOrEqual, width, instruction);      \
+        return true;                                                                  \
+    case LoweredOpCode::prefix##_ge:                                                  \
+        emit_float_comparison(FloatComparison::GreaterOrEqual, width, instruction);   \
+        return true;                                                                  \
+    case LoweredOpCode::prefix##_add:                                                 \
+        emit_float_arithmetic(SseOp::Add, width, instruction);                        \
+        return true;                                                                  \
+    case LoweredOpCode::prefix##_sub:                                                 \
+        emit_float_arithmetic(SseOp::Subtract, width, instruction);                   \
+        return true;                                                                  \
+    case LoweredOpCode::prefix##_mul:                                                 \
+        emit_float_arithmetic(SseOp::Multiply, width, instruction);                   \
+        return true;                                                                  \
+    case LoweredOpCode::prefix##_div:                                                 \
+        emit_float_arithmetic(SseOp::Divide, width, instruction);                     \
+        return true;
+            __COMPILE_FLOAT_OPERATIONS(f32, Width::Dword)
+            __COMPILE_FLOAT_OPERATIONS(f64, Width::Qword)
+#undef __COMPILE_FLOAT_OPERATIONS
+
+        case LoweredOpCode::i32_wrap_i64:
+        case LoweredOpCode::i64_extend_ui32:
+            m_assembler.load(Width::Dword, Reg::RAX, slot(instruction.b));
+            emit_store_result(instruction.a, Reg::RAX);
+            return true;
+        case LoweredOpCode::i64_extend_si32:
+        case LoweredOpCode::i64_extend32_s:
+            m_assembler.load_sign_extended32(Reg::RAX, slot(instruction.b));
+            emit_store_result(instruction.a, Reg::RAX);
+            return true;
+        case LoweredOpCode::i32_extend8_s:
+        case LoweredOpCode::i64_extend8_s:
+            m_assembler.load_sign_extended8(instruction.opcode == LoweredOpCode::i32_extend8_s ? Width::Dword : Width::Qword, Reg::RAX, slot(instruction.b));
+            emit_store_result(instruction.a, Reg::RAX);
+            return true;
+        case LoweredOpCode::i32_extend16_s:
+        case LoweredOpCode::i64_extend16_s:
+            m_assembler.load_sign_extended16(instruction.opcode == LoweredOpCode::i32_extend16_s ? Width::Dword : Width::Qword, Reg::RAX, slot(instruction.b));
+            emit_store_result(instruction.a, Reg::RAX);
+            return true;
+        // NOTE: Values of these types share their slot representation, so reinterpreting one is a plain copy.
+        case LoweredOpCode::i32_reinterpret_f32:
+        case LoweredOpCode::i64_reinterpret_f64:
+        case LoweredOpCode::f32_reinterpret_i32:
+        case LoweredOpCode::f64_reinterpret_i64:
+        case LoweredOpCode::copy:
+            emit_copy(instruction);
+            return true;
+
+        case LoweredOpCode::i32_load:
+        case LoweredOpCode::f32_load:
+            emit_load(instruction, 4, Extension::Zero, Width::Dword);
+            return true;
+        case LoweredOpCode::i64_load:
+        case LoweredOpCode::f64_load:
+            emit_load(instruction, 8, Extension::Zero, Width::Qword);
+            return true;
+        case LoweredOpCode::i32_load8_s:
+            emit_load(instruction, 1, Extension::Sign, Width::Dword);
+            return true;
+        case LoweredOpCode::i32_load8_u:
+        case LoweredOpCode::i64_load8_u:
+            emit_load(instruction, 1, Extension::Zero, Width::Dword);
+            return true;
+        case LoweredOpCode::i32_load16_s:
+            emit_load(instruction, 2, Extension::Sign, Width::Dword);
+            return true;
+        case LoweredOpCode::i32_load16_u:
+        case LoweredOpCode::i64_load16_u:
+            emit_load(instruction, 2, Extension::Zero, Width::Dword);
+            return true;
+        case LoweredOpCode::i64_load8_s:
+            emit_load(instruction, 1, Extension::Sign, Width::Qword);
+            return true;
+        case LoweredOpCode::i64_load16_s:
+            emit_load(instruction, 2, Extension::Sign, Width::Qword);
+            return true;
+        case LoweredOpCode::i64_load32_s:
+            emit_load(instruction, 4, Extension::Sign, Width::Qword);
+            return true;
+        case LoweredOpCode::i64_load32_u:
+            emit_load(instruction, 4, Extension::Zero, Width::Dword);
+            return true;
+
+        case LoweredOpCode::i32_store8:
+        case LoweredOpCode::i64_store8:
+            emit_store(instruction, 1);
+            return true;
+        case LoweredOpCode::i32_store16:
+        case LoweredOpCode::i64_store16:
+            emit_store(instruction, 2);
+            return true;
+        case LoweredOpCode::i32_store:
+        case LoweredOpCode::f32_store:
+        case LoweredOpCode::i64_store32:
+            emit_store(instruction, 4);
+            return true;
+        case LoweredOpCode::i64_store:
+        case LoweredOpCode::f64_store:
+            emit_store(instruction, 8);
+            return true;
+
+        case LoweredOpCode::constant:
+            m_assembler.mov(Reg::RAX, instruction.immediate);
+            emit_store_result(instruction.a, Reg::RAX);
+            return true;
+        case LoweredOpCode::jump:
+            emit_jump_to(branch_targets[instruction.immediate], instruction.b, instruction.c);
+            return true;
+        case LoweredOpCode::jump_if: {
+            auto& target = branch_targets[instruction.immediate];
+            m_assembler.compare_with_immediate(Width::Dword, slot(instruction.a), 0);
+            if (target.result_slot == instruction.b || instruction.c == 0) {
+                m_assembler.jump_if(Condition::NotEqual, m_instruction_labels[target.ip]);
+                return true;
+            }
+            Assembler::Label not_taken;
+            m_assembler.jump_if(Condition::Equal, not_taken);
+            emit_jump_to(target, instruction.b, instruction.c);
+            m_assembler.bind(not_taken);
+            return true;
+        }
+        case LoweredOpCode::jump_unless:
+            m_assembler.compare_with_immediate(Width::Dword, slot(instruction.a), 0);
+            m_assembler.jump_if(Condition::Equal, m_instruction_labels[branch_targets[instruction.immediate].ip]);
+            return true;
+        case LoweredOpCode::jump_table:
+            emit_jump_table(instruction);
+            return true;
+        case LoweredOpCode::return_:
+            emit_branch_moves(0, instruction.b, instruction.c);
+            m_assembler.mov(Reg::RAX, to_underlying(NativeStatus::Ok));
+            m_assembler.jump(m_epilogue);
+            return true;
+        case LoweredOpCode::select:
+            m_assembler.load(Width::Qword, Reg::RAX, slot(instruction.b));
+            m_assembler.compare_with_immediate(Width::Dword, slot(instruction.d), 0);
+            m_assembler.cmov(Condition::Equal, Width::Qword, Reg::RAX, slot(instruction.c));
+            emit_store_result(instruction.a, Reg::RAX);
+            return true;
+        case LoweredOpCode::ref_is_null:
+            m_assembler.compare_with_immediate(Width::Qword, slot(instruction.b), 0);
+            emit_set_result(Condition::Equal, instruction.a);
+            return true;
+        case LoweredOpCode::memory_size:
+            static_assert(Constants::page_size == 1 << 16);
+            m_assembler.mov(Width::Qword, Reg::RAX, memory_size_register);
+            m_assembler.shift(ShiftOp::ShiftRightLogical, Width::Qword, Reg::RAX, 16);
+            emit_store_result(instruction.a, Reg::RAX);
+            return true;
+
+        case LoweredOpCode::call:
+        case LoweredOpCode::call_indirect:
+        case LoweredOpCode::memory_grow:
+            // NOTE: These may move the value stack and the memory.
+            if (!m_helpers.generic[to_underlying(instruction.opcode)])
+                return false;
+            emit_helper_call(m_helpers.generic[to_underlying(instruction.opcode)], index, true);
+            return true;
+
+        default:
+            if (!m_helpers.generic[to_underlying(instruction.opcode)])
+                return false;
+            emit_helper_call(m_helpers.generic[to_underlying(instruction.opcode)], index, false);
+            return true;
+        }
+    }
+
+    LoweredFunction const& m_function;
+    bool m_assume_guarded_memory { false };
+    RuntimeHelpers const& m_helpers;
+
+    Assembler m_assembler;
+    Vector<Assembler::Label> m_instruction_labels;
+    Assembler::Label m_out_of_bounds;
+    Assembler::Label m_epilogue;
+};
+
+// NOTE: The code is written through one mapping and executed through another, so no page is ever writable and executable,
+//       and none ever turns from one into the other either.
+static ErrorOr<void*> map_executable_code(ReadonlyBytes code, size_t mapped_size)
+{
+    auto fd = TRY(Core::System::anon_create(mapped_size, O_CLOEXEC));
+    ScopeGuard close_fd = [&] { (void)Core::System::close(fd); };
+
+    auto* writable = TRY(Core::System::mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0));
+    __builtin_memcpy(writable, code.data(), code.size());
+    TRY(Core::System::munmap(writable, mapped_size));
+
+    return Core::System::mmap(nullptr, mapped_size, PROT_READ | PROT_EXEC, MAP_SHARED, fd, 0);
+}
+
+OwnPtr<NativeFunction> compile(LoweredFunction const& function, bool assume_guarded_memory, RuntimeHelpers const& helpers)
+{
+    FunctionCompiler compiler { function, assume_guarded_memory, helpers };
+    if (!compiler.compile())
+        return {};
+
+    auto& code = compiler.code();
+    auto mapped_size = round_up_to_power_of_two(code.size(), PAGE_SIZE);
+    auto mapping = map_executable_code(code.span(), mapped_size);
+    if (mapping.is_error()) {
+        dbgln_if(WASM_TRACE_DEBUG, "Failed to map compiled code: {}", mapping.error());
+        return {};
+    }
+    auto native_function = adopt_own_if_nonnull(new (nothrow) NativeFunction(mapping.value(), mapped_size, assume_guarded_memory));
+    if (!native_function)
+        (void)Core::System::munmap(mapping.value(), mapped_size);
+    return native_function;
+}
+
+#else
+
+OwnPtr<NativeFunction> compile(LoweredFunction const&, bool, RuntimeHelpers const&)
+{
+    return {};
+}
+
+#endif
+
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/OwnPtr.h>
+#include <AK/Types.h>
+#include <LibWasm/AbstractMachine/LoweredFunction.h>
+
+namespace Wasm {
+
+struct JITInterpreter;
+
+}
+
+namespace Wasm::JIT {
+
+enum class NativeStatus : u32 {
+    // The function trapped; the reason has already been recorded by the runtime.
+    Trapped = 0,
+    Ok = 1,
+    // The rest of the function has to run in the interpreter, starting at NativeFrame::resume_ip.
+    Deoptimized = 2,
+};
+
+// The state shared between a compiled function and the runtime it calls into, one per activation.
+// Compiled code keeps `slots`, `memory_data`, `memory_size` and `instructions` in registers,
+// and reloads them after calling anything that may change them.
+struct NativeFrame {
+    u64* slots { nullptr };
+    u8* memory_data { nullptr };
+    u64 memory_size { 0 };
+    LoweredInstruction const* instructions { nullptr };
+    JITInterpreter* interpreter { nullptr };
+    Configuration* configuration { nullptr };
+    WasmFunction* function { nullptr };
+    size_t frame_base { 0 };
+    size_t resume_ip { 0 };
+    bool assumes_guarded_memory { false };
+};
+
+// Everything that isn't compiled inline is handed to one of these, with the frame and the instruction being executed.
+using RuntimeHelper = NativeStatus (*)(NativeFrame&, LoweredInstruction const&);
+
+struct RuntimeHelpers {
+    // Used for every instruction the compiler has no inline code for.
+    Array<RuntimeHelper, to_underlying(LoweredOpCode::__Count)> generic {};
+    // Records an out-of-bounds memory access trap.
+    RuntimeHelper out_of_bounds { nullptr };
+};
+
+// Machine code for a single lowered function. It is called as `NativeStatus entry(NativeFrame*)`.
+class NativeFunction {
+    AK_MAKE_NONCOPYABLE(NativeFunction);
+    AK_MAKE_NONMOVABLE(NativeFunction);
+
+public:
+    using Entry = NativeStatus (*)(NativeFrame*);
+
+    ~NativeFunction();
+
+    Entry entry() const { return reinterpret_cast<Entry>(m_code); }
+
+    // Code compiled for a guarded memory leaves out all bounds checks, so it can't run on an unguarded one.
+    bool assumes_guarded_memory() const { return m_assumes_guarded_memory; }
+
+private:
+    friend OwnPtr<NativeFunction> compile(LoweredFunction const&, bool, RuntimeHelpers const&);
+
+    NativeFunction(void* code, size_t size, bool assumes_guarded_memory)
+        : m_code(code)
+        , m_size(size)
+        , m_assumes_guarded_memory(assumes_guarded_memory)
+    {
+    }
+
+    void* m_code { nullptr };
+    size_t m_size { 0 };
+    bool m_assumes_guarded_memory { false };
+};
+
+// The compiled forms of a single function. These are only freed along with the function,
+// since activations of one may still be on the stack by the time the other is needed.
+struct NativeCode {
+    OwnPtr<NativeFunction> for_guarded_memory;
+    OwnPtr<NativeFunction> with_bounds_checks;
+    bool failed_to_compile { false };
+};
+
+#if ARCH(X86_64)
+static constexpr bool is_supported = true;
+#else
+static constexpr bool is_supported = false;
+#endif
+
+// Compiles a lowered function into x86_64 machine code, in a single pass over its instructions.
+// Returns nothing if the function (or the host) can't be compiled for; callers are expected to interpret it instead.
+OwnPtr<NativeFunction> compile(LoweredFunction const&, bool assume_guarded_memory, RuntimeHelpers const&);
+
+}
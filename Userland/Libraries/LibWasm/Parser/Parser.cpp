@@ -131,6 +131,8 @@ ParseResult<ValueType> ValueType::parse(InputStream& stream)
         return ValueType(F32);
     case Constants::f64_tag:
         return ValueType(F64);
+    case Constants::v128_tag:
+        return ValueType(V128);
     case Constants::function_reference_tag:
         return ValueType(FunctionReference);
     case Constants::extern_reference_tag:
@@ -275,6 +277,28 @@ ParseResult<BlockType> BlockType::parse(InputStream& stream)
     return BlockType { TypeIndex(index_value) };
 }
 
+static bool is_known_opcode(OpCode opcode)
+{
+    switch (opcode.value()) {
+#define M(name, value) case value:
+        ENUMERATE_WASM_OPCODES(M)
+#undef M
+        return true;
+    default:
+        return false;
+    }
+}
+
+static ParseResult<Instruction::MemoryArgument> parse_memory_argument(InputStream& stream)
+{
+    size_t align, offset;
+    if (!LEB128::read_unsigned(stream, align))
+        return with_eof_check(stream, ParseError::InvalidInput);
+    if (!LEB128::read_unsigned(stream, offset))
+        return with_eof_check(stream, ParseError::InvalidInput);
+    return Instruction::MemoryArgument { static_cast<u32>(align), static_cast<u32>(offset) };
+}
+
 ParseResult<Vector<Instruction>> Instruction::parse(InputStream& stream, InstructionPointer& ip)
 {
     ScopeLogger<WASM_BINPARSER_DEBUG> logger("Instruction"sv);
@@ -726,6 +750,99 @@ ParseResult<Vector<Instruction>> Instruction::parse(InputStream& stream, Instruc
             return ParseError::UnknownInstruction;
         }
     }
+    case 0xfd: {
+        // These are the vector instructions, see https://webassembly.github.io/simd/core/binary/instructions.html#vector-instructions
+        u32 selector;
+        if (!LEB128::read_unsigned(stream, selector))
+            return with_eof_check(stream, ParseError::InvalidInput);
+        if (selector > 0xff)
+            return ParseError::UnknownInstruction;
+        OpCode vector_opcode { 0xfd00 | selector };
+
+        switch (vector_opcode.value()) {
+        case Instructions::v128_load.value():
+        case Instructions::v128_load8x8_s.value():
+        case Instructions::v128_load8x8_u.value():
+        case Instructions::v128_load16x4_s.value():
+        case Instructions::v128_load16x4_u.value():
+        case Instructions::v128_load32x2_s.value():
+        case Instructions::v128_load32x2_u.value():
+        case Instructions::v128_load8_splat.value():
+        case Instructions::v128_load16_splat.value():
+        case Instructions::v128_load32_splat.value():
+        case Instructions::v128_load64_splat.value():
+        case Instructions::v128_load32_zero.value():
+        case Instructions::v128_load64_zero.value():
+        case Instructions::v128_store.value(): {
+            // op (align offset)
+            auto memory_argument = parse_memory_argument(stream);
+            if (memory_argument.is_error())
+                return memory_argument.error();
+            return Vector { Instruction { vector_opcode, memory_argument.release_value() } };
+        }
+        case Instructions::v128_load8_lane.value():
+        case Instructions::v128_load16_lane.value():
+        case Instructions::v128_load32_lane.value():
+        case Instructions::v128_load64_lane.value():
+        case Instructions::v128_store8_lane.value():
+        case Instructions::v128_store16_lane.value():
+        case Instructions::v128_store32_lane.value():
+        case Instructions::v128_store64_lane.value(): {
+            // op (align offset) lane
+            auto memory_argument = parse_memory_argument(stream);
+            if (memory_argument.is_error())
+                return memory_argument.error();
+            u8 lane;
+            stream >> lane;
+            if (stream.has_any_error())
+                return with_eof_check(stream, ParseError::InvalidInput);
+            return Vector { Instruction { vector_opcode, MemoryAndLaneArgument { memory_argument.release_value(), lane } } };
+        }
+        case Instructions::v128_const.value(): {
+            // op literal
+            // NOTE: v128 values are kept in host byte order, with lane 0 in the lowest bits.
+            LittleEndian<u64> low;
+            LittleEndian<u64> high;
+            stream >> low >> high;
+            if (stream.has_any_error())
+                return with_eof_check(stream, ParseError::InvalidInput);
+            return Vector { Instruction { vector_opcode, u128 { static_cast<u64>(low), static_cast<u64>(high) } } };
+        }
+        case Instructions::i8x16_shuffle.value(): {
+            // op lane{16}
+            ShuffleArgument argument;
+            if (!stream.read_or_error(argument.lanes.span()))
+                return with_eof_check(stream, ParseError::InvalidInput);
+            return Vector { Instruction { vector_opcode, argument } };
+        }
+        case Instructions::i8x16_extract_lane_s.value():
+        case Instructions::i8x16_extract_lane_u.value():
+        case Instructions::i8x16_replace_lane.value():
+        case Instructions::i16x8_extract_lane_s.value():
+        case Instructions::i16x8_extract_lane_u.value():
+        case Instructions::i16x8_replace_lane.value():
+        case Instructions::i32x4_extract_lane.value():
+        case Instructions::i32x4_replace_lane.value():
+        case Instructions::i64x2_extract_lane.value():
+        case Instructions::i64x2_replace_lane.value():
+        case Instructions::f32x4_extract_lane.value():
+        case Instructions::f32x4_replace_lane.value():
+        case Instructions::f64x2_extract_lane.value():
+        case Instructions::f64x2_replace_lane.value(): {
+            // op lane
+            u8 lane;
+            stream >> lane;
+            if (stream.has_any_error())
+                return with_eof_check(stream, ParseError::InvalidInput);
+            return Vector { Instruction { vector_opcode, LaneIndex { lane } } };
+        }
+        default:
+            // NOTE: The rest of the vector instructions have no immediates, but a few selectors are left unassigned.
+            if (!is_known_opcode(vector_opcode))
+                return ParseError::UnknownInstruction;
+            return Vector { Instruction { vector_opcode } };
+        }
+    }
     }
 
     return ParseError::UnknownInstruction;
@@ -0,0 +1,297 @@
+// (module
+//   (memory (export "memory") 1)
+//   (table 2 funcref)
+//   (global $counter (mut i32) (i32.const 7))
+//   (elem (i32.const 0) $fib $square)
+//   (func $fib (export "fib") (param i32) (result i32)
+//     (if (result i32) (i32.lt_s (local.get 0) (i32.const 2))
+//       (then (local.get 0))
+//       (else (i32.add (call $fib (i32.sub (local.get 0) (i32.const 1))) (call $fib (i32.sub (local.get 0) (i32.const 2)))))))
+//   (func $square (param i32) (result i32) (i32.mul (local.get 0) (local.get 0)))
+//   (func (export "callIndirect") (param i32 i32) (result i32)
+//     (call_indirect (param i32) (result i32) (local.get 1) (local.get 0)))
+//   (func (export "loopSum") (param i32) (result i64) (local i32 i64)
+//     (block (loop
+//       (br_if 1 (i32.ge_s (local.get 1) (local.get 0)))
+//       (local.set 2 (i64.add (local.get 2) (i64.xor (i64.mul (i64.extend_i32_s (local.get 1)) (i64.extend_i32_s (local.get 1))) (i64.extend_i32_s (local.get 1)))))
+//       (local.set 1 (i32.add (local.get 1) (i32.const 1)))
+//       (br 0)))
+//     (local.get 2))
+//   (func (export "countPrimes") (param i32) (result i32) (local i32 i32 i32)
+//     (local.set 1 (i32.const 2))
+//     (block (loop
+//       (br_if 1 (i32.ge_s (local.get 1) (local.get 0)))
+//       (if (i32.eqz (i32.load8_u (local.get 1)))
+//         (then
+//           (local.set 3 (i32.add (local.get 3) (i32.const 1)))
+//           (local.set 2 (i32.mul (local.get 1) (local.get 1)))
+//           (block (loop
+//             (br_if 1 (i32.ge_s (local.get 2) (local.get 0)))
+//             (i32.store8 (local.get 2) (i32.const 1))
+//             (local.set 2 (i32.add (local.get 2) (local.get 1)))
+//             (br 0)))))
+//       (local.set 1 (i32.add (local.get 1) (i32.const 1)))
+//       (br 0)))
+//     (local.get 3))
+//   (func (export "branchTable") (param i32) (result i32) (local i32)
+//     (block (block (block (block
+//       (br_table 0 1 2 3 (i32.and (local.get 0) (i32.const 3))))
+//       (local.set 1 (i32.const 10)) (br 2))
+//       (local.set 1 (i32.const 20)) (br 1))
+//       (drop (local.tee 1 (i32.const 30))) (br 0))
+//     (global.set $counter (i32.add (local.get 1) (global.get $counter)))
+//     (select (local.get 1) (global.get $counter) (i32.and (local.get 0) (i32.const 1))))
+//   (func (export "branchWithValue") (param i32) (result i32)
+//     (i32.add
+//       (block (result i32)
+//         (drop (br_if 0 (i32.const 5) (local.get 0)))
+//         (block (result i32) (br_if 1 (i32.const 9) (i32.const 1))))
+//       (i32.const 100)))
+//   (func (export "floatLoopSum") (param i32) (result f64) (local i32 f64)
+//     (block (loop
+//       (br_if 1 (i32.ge_s (local.get 1) (local.get 0)))
+//       (local.set 2 (f64.add (local.get 2) (f64.mul (f64.sqrt (f64.convert_i32_s (local.get 1))) (f64.const 1.5))))
+//       (local.set 1 (i32.add (local.get 1) (i32.const 1)))
+//       (br 0)))
+//     (local.get 2))
+//   (func (export "returnFromLoop") (param i32) (result i32) (local i32)
+//     (loop
+//       (if (i32.eq (local.tee 1 (i32.add (local.get 1) (i32.const 1))) (local.get 0))
+//         (then (return (i32.mul (local.get 1) (i32.const 1000)))))
+//       (br 0))
+//     (i32.const -1))
+//   (func (export "overwriteLocalOnStack") (param i32) (result i32)
+//     local.get 0
+//     (local.set 0 (i32.add (local.get 0) (i32.const 1)))
+//     local.get 0
+//     i32.sub)
+//   (func (export "setLocalAfterBlock") (param i32) (result i32) (local i32)
+//     (local.set 1
+//       (block (result i32)
+//         (drop (br_if 0 (i32.const 1) (local.get 0)))
+//         (i32.const 2)))
+//     (i32.add (local.get 1) (i32.mul (local.tee 0 (i32.add (local.get 0) (i32.const 3))) (local.get 0))))
+//   (func (export "mixI64") (param i64 i64) (result i64)
+//     (i64.add
+//       (i64.xor (i64.mul (local.get 0) (local.get 1)) (i64.rem_s (local.get 0) (i64.const 7)))
+//       (i64.clz (local.get 1))))
+//   (func (export "mixMemoryWidths") (param i32) (result i64)
+//     (i64.store (i32.const 100) (i64.mul (i64.extend_i32_u (local.get 0)) (i64.const 0x0102030405060708)))
+//     (i64.add
+//       (i64.add (i64.load8_s offset=3 (i32.const 100)) (i64.load16_u offset=2 (i32.const 100)))
+//       (i64.load32_u offset=4 (i32.const 100))))
+//   (func (export "ifWithParameters") (param i32) (result i32)
+//     i32.const 3
+//     i32.const 4
+//     (if (param i32 i32) (result i32) (local.get 0)
+//       (then i32.add)
+//       (else i32.sub)))
+//   (func (export "branchTableIntoLoop") (param i32) (result i32) (local i32)
+//     local.get 0
+//     (loop (param i32) (result i32)
+//       local.tee 1
+//       i32.const 1
+//       i32.sub
+//       local.tee 1
+//       local.get 1
+//       (br_table 1 0)))
+//   (func $pair (param i32) (result i32 i64)
+//     (i32.add (local.get 0) (i32.const 1))
+//     (i64.mul (i64.extend_i32_s (local.get 0)) (i64.const 10)))
+//   (func (export "multipleResults") (param i32) (result i64)
+//     (call $pair (local.get 0))
+//     (block (param i32 i64) (result i64)
+//       (br_if 0 (local.get 0))
+//       drop
+//       i64.extend_i32_s))
+//   (func $divide (export "divide") (param i32 i32) (result i32) (i32.div_s (local.get 0) (local.get 1)))
+//   (func (export "load") (param i32) (result i32) (i32.load offset=4 (local.get 0)))
+//   (func (export "growMemory") (param i32) (result i32) (i32.add (memory.grow (local.get 0)) (memory.size)))
+//   (func (export "unreachable") unreachable)
+//   (func (export "callThenDivide") (param i32 i32) (result i32) (i32.div_s (call $square (local.get 0)) (local.get 1)))
+//   (func (export "callThenLoad") (param i32) (result i32) (i32.load (call $square (local.get 0))))
+//   (func (export "divideInCallee") (param i32 i32) (result i32)
+//     (i32.add (call $divide (local.get 0) (local.get 1)) (i32.const 1))))
+// prettier-ignore
+const binary = new Uint8Array([
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x2b, 0x08, 0x60, 0x01, 0x7f, 0x01, 0x7f,
+    0x60, 0x02, 0x7f, 0x7f, 0x01, 0x7f, 0x60, 0x01, 0x7f, 0x01, 0x7e, 0x60, 0x01, 0x7f, 0x01, 0x7c,
+    0x60, 0x02, 0x7e, 0x7e, 0x01, 0x7e, 0x60, 0x01, 0x7f, 0x02, 0x7f, 0x7e, 0x60, 0x02, 0x7f, 0x7e,
+    0x01, 0x7e, 0x60, 0x00, 0x00, 0x03, 0x19, 0x18, 0x00, 0x00, 0x01, 0x02, 0x00, 0x00, 0x00, 0x03,
+    0x00, 0x00, 0x00, 0x04, 0x02, 0x00, 0x00, 0x05, 0x02, 0x01, 0x00, 0x00, 0x07, 0x01, 0x00, 0x01,
+    0x04, 0x04, 0x01, 0x70, 0x00, 0x02, 0x05, 0x03, 0x01, 0x00, 0x01, 0x06, 0x06, 0x01, 0x7f, 0x01,
+    0x41, 0x07, 0x0b, 0x07, 0xd6, 0x02, 0x17, 0x06, 0x6d, 0x65, 0x6d, 0x6f, 0x72, 0x79, 0x02, 0x00,
+    0x03, 0x66, 0x69, 0x62, 0x00, 0x00, 0x0c, 0x63, 0x61, 0x6c, 0x6c, 0x49, 0x6e, 0x64, 0x69, 0x72,
+    0x65, 0x63, 0x74, 0x00, 0x02, 0x07, 0x6c, 0x6f, 0x6f, 0x70, 0x53, 0x75, 0x6d, 0x00, 0x03, 0x0b,
+    0x63, 0x6f, 0x75, 0x6e, 0x74, 0x50, 0x72, 0x69, 0x6d, 0x65, 0x73, 0x00, 0x04, 0x0b, 0x62, 0x72,
+    0x61, 0x6e, 0x63, 0x68, 0x54, 0x61, 0x62, 0x6c, 0x65, 0x00, 0x05, 0x0f, 0x62, 0x72, 0x61, 0x6e,
+    0x63, 0x68, 0x57, 0x69, 0x74, 0x68, 0x56, 0x61, 0x6c, 0x75, 0x65, 0x00, 0x06, 0x0c, 0x66, 0x6c,
+    0x6f, 0x61, 0x74, 0x4c, 0x6f, 0x6f, 0x70, 0x53, 0x75, 0x6d, 0x00, 0x07, 0x0e, 0x72, 0x65, 0x74,
+    0x75, 0x72, 0x6e, 0x46, 0x72, 0x6f, 0x6d, 0x4c, 0x6f, 0x6f, 0x70, 0x00, 0x08, 0x15, 0x6f, 0x76,
+    0x65, 0x72, 0x77, 0x72, 0x69, 0x74, 0x65, 0x4c, 0x6f, 0x63, 0x61, 0x6c, 0x4f, 0x6e, 0x53, 0x74,
+    0x61, 0x63, 0x6b, 0x00, 0x09, 0x12, 0x73, 0x65, 0x74, 0x4c, 0x6f, 0x63, 0x61, 0x6c, 0x41, 0x66,
+    0x74, 0x65, 0x72, 0x42, 0x6c, 0x6f, 0x63, 0x6b, 0x00, 0x0a, 0x06, 0x6d, 0x69, 0x78, 0x49, 0x36,
+    0x34, 0x00, 0x0b, 0x0f, 0x6d, 0x69, 0x78, 0x4d, 0x65, 0x6d, 0x6f, 0x72, 0x79, 0x57, 0x69, 0x64,
+    0x74, 0x68, 0x73, 0x00, 0x0c, 0x10, 0x69, 0x66, 0x57, 0x69, 0x74, 0x68, 0x50, 0x61, 0x72, 0x61,
+    0x6d, 0x65, 0x74, 0x65, 0x72, 0x73, 0x00, 0x0d, 0x13, 0x62, 0x72, 0x61, 0x6e, 0x63, 0x68, 0x54,
+    0x61, 0x62, 0x6c, 0x65, 0x49, 0x6e, 0x74, 0x6f, 0x4c, 0x6f, 0x6f, 0x70, 0x00, 0x0e, 0x0f, 0x6d,
+    0x75, 0x6c, 0x74, 0x69, 0x70, 0x6c, 0x65, 0x52, 0x65, 0x73, 0x75, 0x6c, 0x74, 0x73, 0x00, 0x10,
+    0x06, 0x64, 0x69, 0x76, 0x69, 0x64, 0x65, 0x00, 0x11, 0x04, 0x6c, 0x6f, 0x61, 0x64, 0x00, 0x12,
+    0x0a, 0x67, 0x72, 0x6f, 0x77, 0x4d, 0x65, 0x6d, 0x6f, 0x72, 0x79, 0x00, 0x13, 0x0b, 0x75, 0x6e,
+    0x72, 0x65, 0x61, 0x63, 0x68, 0x61, 0x62, 0x6c, 0x65, 0x00, 0x14, 0x0e, 0x63, 0x61, 0x6c, 0x6c,
+    0x54, 0x68, 0x65, 0x6e, 0x44, 0x69, 0x76, 0x69, 0x64, 0x65, 0x00, 0x15, 0x0c, 0x63, 0x61, 0x6c,
+    0x6c, 0x54, 0x68, 0x65, 0x6e, 0x4c, 0x6f, 0x61, 0x64, 0x00, 0x16, 0x0e, 0x64, 0x69, 0x76, 0x69,
+    0x64, 0x65, 0x49, 0x6e, 0x43, 0x61, 0x6c, 0x6c, 0x65, 0x65, 0x00, 0x17, 0x09, 0x08, 0x01, 0x00,
+    0x41, 0x00, 0x0b, 0x02, 0x00, 0x01, 0x0a, 0xd2, 0x04, 0x18, 0x1c, 0x00, 0x20, 0x00, 0x41, 0x02,
+    0x48, 0x04, 0x7f, 0x20, 0x00, 0x05, 0x20, 0x00, 0x41, 0x01, 0x6b, 0x10, 0x00, 0x20, 0x00, 0x41,
+    0x02, 0x6b, 0x10, 0x00, 0x6a, 0x0b, 0x0b, 0x07, 0x00, 0x20, 0x00, 0x20, 0x00, 0x6c, 0x0b, 0x09,
+    0x00, 0x20, 0x01, 0x20, 0x00, 0x11, 0x00, 0x00, 0x0b, 0x2e, 0x02, 0x01, 0x7f, 0x01, 0x7e, 0x02,
+    0x40, 0x03, 0x40, 0x20, 0x01, 0x20, 0x00, 0x4e, 0x0d, 0x01, 0x20, 0x02, 0x20, 0x01, 0xac, 0x20,
+    0x01, 0xac, 0x7e, 0x20, 0x01, 0xac, 0x85, 0x7c, 0x21, 0x02, 0x20, 0x01, 0x41, 0x01, 0x6a, 0x21,
+    0x01, 0x0c, 0x00, 0x0b, 0x0b, 0x20, 0x02, 0x0b, 0x58, 0x03, 0x01, 0x7f, 0x01, 0x7f, 0x01, 0x7f,
+    0x41, 0x02, 0x21, 0x01, 0x02, 0x40, 0x03, 0x40, 0x20, 0x01, 0x20, 0x00, 0x4e, 0x0d, 0x01, 0x20,
+    0x01, 0x2d, 0x00, 0x00, 0x45, 0x04, 0x40, 0x20, 0x03, 0x41, 0x01, 0x6a, 0x21, 0x03, 0x20, 0x01,
+    0x20, 0x01, 0x6c, 0x21, 0x02, 0x02, 0x40, 0x03, 0x40, 0x20, 0x02, 0x20, 0x00, 0x4e, 0x0d, 0x01,
+    0x20, 0x02, 0x41, 0x01, 0x3a, 0x00, 0x00, 0x20, 0x02, 0x20, 0x01, 0x6a, 0x21, 0x02, 0x0c, 0x00,
+    0x0b, 0x0b, 0x0b, 0x20, 0x01, 0x41, 0x01, 0x6a, 0x21, 0x01, 0x0c, 0x00, 0x0b, 0x0b, 0x20, 0x03,
+    0x0b, 0x3f, 0x01, 0x01, 0x7f, 0x02, 0x40, 0x02, 0x40, 0x02, 0x40, 0x02, 0x40, 0x20, 0x00, 0x41,
+    0x03, 0x71, 0x0e, 0x03, 0x00, 0x01, 0x02, 0x03, 0x0b, 0x41, 0x0a, 0x21, 0x01, 0x0c, 0x02, 0x0b,
+    0x41, 0x14, 0x21, 0x01, 0x0c, 0x01, 0x0b, 0x41, 0x1e, 0x22, 0x01, 0x1a, 0x0c, 0x00, 0x0b, 0x20,
+    0x01, 0x23, 0x00, 0x6a, 0x24, 0x00, 0x20, 0x01, 0x23, 0x00, 0x20, 0x00, 0x41, 0x01, 0x71, 0x1b,
+    0x0b, 0x19, 0x00, 0x02, 0x7f, 0x41, 0x05, 0x20, 0x00, 0x0d, 0x00, 0x1a, 0x02, 0x7f, 0x41, 0x09,
+    0x41, 0x01, 0x0d, 0x01, 0x0b, 0x0b, 0x41, 0xe4, 0x00, 0x6a, 0x0b, 0x31, 0x02, 0x01, 0x7f, 0x01,
+    0x7c, 0x02, 0x40, 0x03, 0x40, 0x20, 0x01, 0x20, 0x00, 0x4e, 0x0d, 0x01, 0x20, 0x02, 0x20, 0x01,
+    0xb7, 0x9f, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf8, 0x3f, 0xa2, 0xa0, 0x21, 0x02, 0x20,
+    0x01, 0x41, 0x01, 0x6a, 0x21, 0x01, 0x0c, 0x00, 0x0b, 0x0b, 0x20, 0x02, 0x0b, 0x1f, 0x01, 0x01,
+    0x7f, 0x03, 0x40, 0x20, 0x01, 0x41, 0x01, 0x6a, 0x22, 0x01, 0x20, 0x00, 0x46, 0x04, 0x40, 0x20,
+    0x01, 0x41, 0xe8, 0x07, 0x6c, 0x0f, 0x0b, 0x0c, 0x00, 0x0b, 0x41, 0x7f, 0x0b, 0x0e, 0x00, 0x20,
+    0x00, 0x20, 0x00, 0x41, 0x01, 0x6a, 0x21, 0x00, 0x20, 0x00, 0x6b, 0x0b, 0x1f, 0x01, 0x01, 0x7f,
+    0x02, 0x7f, 0x41, 0x01, 0x20, 0x00, 0x0d, 0x00, 0x1a, 0x41, 0x02, 0x0b, 0x21, 0x01, 0x20, 0x01,
+    0x20, 0x00, 0x41, 0x03, 0x6a, 0x22, 0x00, 0x20, 0x00, 0x6c, 0x6a, 0x0b, 0x11, 0x00, 0x20, 0x00,
+    0x20, 0x01, 0x7e, 0x20, 0x00, 0x42, 0x07, 0x81, 0x85, 0x20, 0x01, 0x79, 0x7c, 0x0b, 0x2a, 0x00,
+    0x41, 0xe4, 0x00, 0x20, 0x00, 0xad, 0x42, 0x88, 0x8e, 0x98, 0xa8, 0xc0, 0xe0, 0x80, 0x81, 0x01,
+    0x7e, 0x37, 0x03, 0x00, 0x41, 0xe4, 0x00, 0x30, 0x00, 0x03, 0x41, 0xe4, 0x00, 0x33, 0x01, 0x02,
+    0x7c, 0x41, 0xe4, 0x00, 0x35, 0x02, 0x04, 0x7c, 0x0b, 0x0e, 0x00, 0x41, 0x03, 0x41, 0x04, 0x20,
+    0x00, 0x04, 0x01, 0x6a, 0x05, 0x6b, 0x0b, 0x0b, 0x16, 0x01, 0x01, 0x7f, 0x20, 0x00, 0x03, 0x00,
+    0x22, 0x01, 0x41, 0x01, 0x6b, 0x22, 0x01, 0x20, 0x01, 0x0e, 0x01, 0x01, 0x00, 0x0b, 0x0b, 0x0d,
+    0x00, 0x20, 0x00, 0x41, 0x01, 0x6a, 0x20, 0x00, 0xac, 0x42, 0x0a, 0x7e, 0x0b, 0x0f, 0x00, 0x20,
+    0x00, 0x10, 0x0f, 0x02, 0x06, 0x20, 0x00, 0x0d, 0x00, 0x1a, 0xac, 0x0b, 0x0b, 0x07, 0x00, 0x20,
+    0x00, 0x20, 0x01, 0x6d, 0x0b, 0x07, 0x00, 0x20, 0x00, 0x28, 0x02, 0x04, 0x0b, 0x09, 0x00, 0x20,
+    0x00, 0x40, 0x00, 0x3f, 0x00, 0x6a, 0x0b, 0x03, 0x00, 0x00, 0x0b, 0x09, 0x00, 0x20, 0x00, 0x10,
+    0x01, 0x20, 0x01, 0x6d, 0x0b, 0x09, 0x00, 0x20, 0x00, 0x10, 0x01, 0x28, 0x02, 0x00, 0x0b, 0x0b,
+    0x00, 0x20, 0x00, 0x20, 0x01, 0x10, 0x11, 0x41, 0x01, 0x6a, 0x0b,
+]);
+
+// NOTE: invoke() runs functions in the interpreter loop that counts instructions, while invokeLowered() runs them
+//       in their lowered form, like everything outside of tests does. Each gets its own instance of the module,
+//       and both make the same calls, so their memories and globals stay the same too.
+const interpreted = parseWebAssemblyModule(binary);
+const lowered = parseWebAssemblyModule(binary);
+
+const outcomeOf = call => {
+    try {
+        return { value: call() };
+    } catch (e) {
+        // NOTE: The interpreter describes some traps by the check that failed,
+        //       so only compare that it trapped.
+        expect(e).toBeInstanceOf(TypeError);
+        return { trapped: true };
+    }
+};
+
+const expectSameOutcome = (name, ...args) => {
+    const expected = outcomeOf(() => interpreted.invoke(interpreted.getExport(name), ...args));
+    const actual = outcomeOf(() => lowered.invokeLowered(lowered.getExport(name), ...args));
+    expect(actual).toEqual(expected);
+    return actual;
+};
+
+test("control flow", () => {
+    expect(expectSameOutcome("fib", 20).value).toBe(6765);
+    expectSameOutcome("fib", 0);
+    expectSameOutcome("fib", 1);
+    for (let i = 0; i < 8; ++i) expectSameOutcome("branchTable", i);
+    expectSameOutcome("branchWithValue", 0);
+    expectSameOutcome("branchWithValue", 1);
+    expect(expectSameOutcome("returnFromLoop", 5).value).toBe(5000);
+    expectSameOutcome("ifWithParameters", 0);
+    expectSameOutcome("ifWithParameters", 1);
+    expectSameOutcome("branchTableIntoLoop", 10);
+    expectSameOutcome("multipleResults", 0);
+    expect(expectSameOutcome("multipleResults", 5).value).toBe(50n);
+    expect(expectSameOutcome("callIndirect", 0, 15).value).toBe(610);
+    expectSameOutcome("callIndirect", 1, 12345);
+});
+
+test("locals", () => {
+    expect(expectSameOutcome("overwriteLocalOnStack", 41).value).toBe(-1);
+    expectSameOutcome("setLocalAfterBlock", 0);
+    expectSameOutcome("setLocalAfterBlock", 1);
+});
+
+test("arithmetic", () => {
+    expectSameOutcome("loopSum", 0);
+    expectSameOutcome("loopSum", 1000);
+    expectSameOutcome("floatLoopSum", 1000);
+    expectSameOutcome("mixI64", 123456789n, -987654321n);
+    expectSameOutcome("mixI64", -1n, 64n);
+    expectSameOutcome("divide", 7, 2);
+    expectSameOutcome("divide", 0xfffffff9, 2);
+});
+
+test("memory", () => {
+    expect(expectSameOutcome("countPrimes", 10000).value).toBe(1229);
+    expectSameOutcome("mixMemoryWidths", 3);
+    expectSameOutcome("mixMemoryWidths", 0xffffffff);
+    expectSameOutcome("load", 0);
+    expectSameOutcome("load", 100);
+    expectSameOutcome("growMemory", 1);
+    expectSameOutcome("growMemory", 65536);
+});
+
+test("traps", () => {
+    for (const [name, ...args] of [
+        ["divide", 1, 0],
+        ["divide", 0x80000000, 0xffffffff],
+        ["load", 65532],
+        ["load", 0xfffffffc],
+        ["callIndirect", 2, 1],
+        ["callIndirect", 0xffffffff, 1],
+        ["unreachable"],
+        ["callThenDivide", 7, 0],
+        ["callThenLoad", 1000],
+        ["divideInCallee", 9, 0],
+    ]) {
+        expect(expectSameOutcome(name, ...args).trapped).toBeTrue();
+    }
+});
+
+// NOTE: With --jit, this makes compiled code hand over to the interpreter right after every call,
+//       which has to pick up where it left off.
+test("leaving compiled code after calls", () => {
+    setDeoptimizeAfterCalls(true);
+    try {
+        expect(expectSameOutcome("fib", 20).value).toBe(6765);
+        expect(expectSameOutcome("callIndirect", 0, 15).value).toBe(610);
+        expect(expectSameOutcome("multipleResults", 5).value).toBe(50n);
+        expect(expectSameOutcome("callThenDivide", 7, 2).value).toBe(24);
+        expectSameOutcome("callThenLoad", 10);
+        expect(expectSameOutcome("divideInCallee", 9, 3).value).toBe(4);
+        expect(expectSameOutcome("callThenDivide", 7, 0).trapped).toBeTrue();
+        expect(expectSameOutcome("callThenLoad", 1000).trapped).toBeTrue();
+        expect(expectSameOutcome("divideInCallee", 9, 0).trapped).toBeTrue();
+    } finally {
+        setDeoptimizeAfterCalls(false);
+    }
+});
+
+test("memories end up the same", () => {
+    const expected = new Uint8Array(interpreted.getExport("memory"));
+    const actual = new Uint8Array(lowered.getExport("memory"));
+    expect(actual.length).toBe(expected.length);
+    let differingBytes = 0;
+    for (let i = 0; i < expected.length; ++i) {
+        if (actual[i] !== expected[i]) ++differingBytes;
+    }
+    expect(differingBytes).toBe(0);
+});
@@ -0,0 +1,100 @@
+// (module
+//   (memory (export "memory") 1)
+//   (func (export "load") (param i32) (result i32) (i32.load (local.get 0)))
+//   (func (export "store") (param i32 i32) (i32.store (local.get 0) (local.get 1)))
+//   (func (export "grow") (param i32) (result i32) (memory.grow (local.get 0))))
+// prettier-ignore
+const binary = new Uint8Array([
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x0b, 0x02, 0x60, 0x01, 0x7f, 0x01, 0x7f,
+    0x60, 0x02, 0x7f, 0x7f, 0x00, 0x03, 0x04, 0x03, 0x00, 0x01, 0x00, 0x05, 0x03, 0x01, 0x00, 0x01,
+    0x07, 0x20, 0x04, 0x06, 0x6d, 0x65, 0x6d, 0x6f, 0x72, 0x79, 0x02, 0x00, 0x04, 0x6c, 0x6f, 0x61,
+    0x64, 0x00, 0x00, 0x05, 0x73, 0x74, 0x6f, 0x72, 0x65, 0x00, 0x01, 0x04, 0x67, 0x72, 0x6f, 0x77,
+    0x00, 0x02, 0x0a, 0x1a, 0x03, 0x07, 0x00, 0x20, 0x00, 0x28, 0x02, 0x00, 0x0b, 0x09, 0x00, 0x20,
+    0x00, 0x20, 0x01, 0x36, 0x02, 0x00, 0x0b, 0x06, 0x00, 0x20, 0x00, 0x40, 0x00, 0x0b,
+]);
+
+const pageSize = 65536;
+
+test("the exported buffer is a view of the memory", () => {
+    const module = parseWebAssemblyModule(binary);
+    const load = module.getExport("load");
+    const store = module.getExport("store");
+    const buffer = module.getExport("memory");
+    expect(buffer.byteLength).toBe(pageSize);
+
+    module.invoke(store, 8, 42);
+    expect(new Uint32Array(buffer)[2]).toBe(42);
+
+    new Uint32Array(buffer)[3] = 1234;
+    expect(module.invoke(load, 12)).toBe(1234);
+});
+
+// NOTE: invoke() checks every access against the size of the memory, while invokeLowered() (and compiled code
+//       with --jit) relies on the guard pages, and turns the fault an out-of-bounds access causes into a trap.
+for (const invoke of ["invoke", "invokeLowered"]) {
+    const expectOutOfBounds = (module, address) => {
+        expect(() => module[invoke](module.getExport("load"), address)).toThrowWithMessage(
+            TypeError,
+            "Execution trapped: Memory access out of bounds"
+        );
+        expect(() => module[invoke](module.getExport("store"), address, 1)).toThrowWithMessage(
+            TypeError,
+            "Execution trapped: Memory access out of bounds"
+        );
+    };
+
+    describe(invoke, () => {
+        test("out-of-bounds accesses trap after the buffer has been exposed", () => {
+            const module = parseWebAssemblyModule(binary);
+            const load = module.getExport("load");
+            const store = module.getExport("store");
+            module.getExport("memory");
+
+            expect(module[invoke](load, pageSize - 4)).toBe(0);
+            for (const address of [pageSize - 3, pageSize, 2 * pageSize, 0xfffffffc])
+                expectOutOfBounds(module, address);
+
+            // The memory is still usable after a trap.
+            module[invoke](store, 0, 7);
+            expect(module[invoke](load, 0)).toBe(7);
+        });
+
+        test("growing makes the new pages accessible", () => {
+            const module = parseWebAssemblyModule(binary);
+            const load = module.getExport("load");
+            const store = module.getExport("store");
+            const grow = module.getExport("grow");
+            const bufferBeforeGrowing = module.getExport("memory");
+            module[invoke](store, 0, 7);
+
+            expect(module[invoke](grow, 2)).toBe(1);
+            expect(module[invoke](load, 3 * pageSize - 4)).toBe(0);
+            module[invoke](store, pageSize, 42);
+            expect(module[invoke](load, pageSize)).toBe(42);
+            expect(module[invoke](load, 0)).toBe(7);
+
+            const buffer = module.getExport("memory");
+            expect(buffer.byteLength).toBe(3 * pageSize);
+            expect(new Uint32Array(buffer)[pageSize / 4]).toBe(42);
+
+            // Growing doesn't move the memory, so a buffer exposed before still views it.
+            new Uint32Array(bufferBeforeGrowing)[1] = 1234;
+            expect(module[invoke](load, 4)).toBe(1234);
+        });
+
+        test("out-of-bounds accesses trap after growing", () => {
+            const module = parseWebAssemblyModule(binary);
+            const grow = module.getExport("grow");
+            module.getExport("memory");
+
+            expect(module[invoke](grow, 1)).toBe(1);
+            for (const address of [2 * pageSize - 3, 2 * pageSize, 3 * pageSize, 0xfffffffc])
+                expectOutOfBounds(module, address);
+
+            // A failed grow leaves the memory as it was.
+            expect(module[invoke](grow, 65536)).toBe(-1);
+            expect(module[invoke](module.getExport("load"), 2 * pageSize - 4)).toBe(0);
+            expectOutOfBounds(module, 2 * pageSize);
+        });
+    });
+}
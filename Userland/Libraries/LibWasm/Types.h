@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/Badge.h>
 #include <AK/Debug.h>
 #include <AK/DistinctNumeric.h>
@@ -13,6 +14,7 @@
 #include <AK/NonnullOwnPtrVector.h>
 #include <AK/Result.h>
 #include <AK/String.h>
+#include <AK/UFixedBigInt.h>
 #include <AK/Variant.h>
 #include <LibWasm/Constants.h>
 #include <LibWasm/Forward.h>
@@ -171,6 +173,7 @@ public:
         I64,
         F32,
         F64,
+        V128,
         FunctionReference,
         ExternReference,
         NullFunctionReference,
@@ -186,6 +189,7 @@ public:
 
     auto is_reference() const { return m_kind == ExternReference || m_kind == FunctionReference || m_kind == NullExternReference || m_kind == NullFunctionReference; }
     auto is_numeric() const { return !is_reference(); }
+    auto is_vector() const { return m_kind == V128; }
     auto kind() const { return m_kind; }
 
     static ParseResult<ValueType> parse(InputStream& stream);
@@ -201,6 +205,8 @@ public:
             return "f32";
         case F64:
             return "f64";
+        case V128:
+            return "v128";
         case FunctionReference:
             return "funcref";
         case ExternReference:
@@ -422,6 +428,20 @@ public:
         u32 offset;
     };
 
+    // https://webassembly.github.io/simd/core/binary/instructions.html#vector-instructions
+    struct MemoryAndLaneArgument {
+        MemoryArgument memory;
+        u8 lane;
+    };
+
+    struct LaneIndex {
+        u8 lane;
+    };
+
+    struct ShuffleArgument {
+        Array<u8, 16> lanes;
+    };
+
     template<typename T>
     explicit Instruction(OpCode opcode, T argument)
         : m_opcode(opcode)
@@ -445,8 +465,11 @@ private:
         GlobalIndex,
         IndirectCallArgs,
         LabelIndex,
+        LaneIndex,
         LocalIndex,
         MemoryArgument,
+        MemoryAndLaneArgument,
+        ShuffleArgument,
         StructuredInstructionArgs,
         TableBranchArgs,
         TableElementArgs,
@@ -458,6 +481,7 @@ private:
         float,
         i32,
         i64,
+        u128,
         u8 // Empty state
     > m_arguments;
     // clang-format on
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/NumericLimits.h>
+#include <AK/Types.h>
+
+namespace Web::CSS {
+
+// A Bloom filter of hashes that keeps a count in every bucket instead of a single bit, so that hashes can be removed
+// again. Each hash sets two buckets, picked by its low and high bits. Buckets that overflow stay saturated forever,
+// which can only ever make the filter report more false positives.
+template<typename CounterType, size_t key_bits>
+class CountingBloomFilter {
+public:
+    static constexpr size_t bucket_count = 1 << key_bits;
+
+    void add(u32 hash)
+    {
+        increment(m_buckets[first_bucket_index(hash)]);
+        increment(m_buckets[second_bucket_index(hash)]);
+    }
+
+    void remove(u32 hash)
+    {
+        decrement(m_buckets[first_bucket_index(hash)]);
+        decrement(m_buckets[second_bucket_index(hash)]);
+    }
+
+    // Returns false only if the hash definitely hasn't been added.
+    bool may_contain(u32 hash) const
+    {
+        return m_buckets[first_bucket_index(hash)] && m_buckets[second_bucket_index(hash)];
+    }
+
+    void clear() { m_buckets.fill(0); }
+
+private:
+    static constexpr u32 key_mask = bucket_count - 1;
+
+    static size_t first_bucket_index(u32 hash) { return hash & key_mask; }
+    static size_t second_bucket_index(u32 hash) { return (hash >> 16) & key_mask; }
+
+    static void increment(CounterType& counter)
+    {
+        if (counter != NumericLimits<CounterType>::max())
+            ++counter;
+    }
+
+    static void decrement(CounterType& counter)
+    {
+        if (counter != NumericLimits<CounterType>::max())
+            --counter;
+    }
+
+    Array<CounterType, bucket_count> m_buckets {};
+};
+
+}
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibWeb/CSS/InvalidationSet.h>
+#include <LibWeb/DOM/Element.h>
+#include <LibWeb/HTML/AttributeNames.h>
+
+namespace Web::CSS {
+
+bool InvalidationSet::matches_descendant_features(DOM::Element const& element) const
+{
+    if (m_invalidates_all_descendants)
+        return true;
+
+    if (!m_descendant_ids.is_empty()) {
+        auto id = element.attribute(HTML::AttributeNames::id);
+        if (!id.is_null() && m_descendant_ids.contains(id.to_lowercase()))
+            return true;
+    }
+    if (!m_descendant_classes.is_empty()) {
+        for (auto const& class_name : element.class_names()) {
+            if (m_descendant_classes.contains(class_name.to_lowercase()))
+                return true;
+        }
+    }
+    if (!m_descendant_tag_names.is_empty() && m_descendant_tag_names.contains(element.local_name().to_lowercase()))
+        return true;
+    return false;
+}
+
+void InvalidationSet::add_descendant_features(Selector::CompoundSelector const& subject)
+{
+    m_invalidates_descendants = true;
+    if (m_invalidates_all_descendants)
+        return;
+
+    // NOTE: An element has to have every feature of the subject to match it, so checking for one of them is enough.
+    //       Ids are the rarest, so they are picked first.
+    Optional<FlyString> id;
+    Optional<FlyString> class_name;
+    Optional<FlyString> tag_name;
+    for (auto const& simple_selector : subject.simple_selectors) {
+        if (simple_selector.type == Selector::SimpleSelector::Type::Id && !id.has_value())
+            id = simple_selector.lowercase_name();
+        else if (simple_selector.type == Selector::SimpleSelector::Type::Class && !class_name.has_value())
+            class_name = simple_selector.lowercase_name();
+        else if (simple_selector.type == Selector::SimpleSelector::Type::TagName && !tag_name.has_value())
+            tag_name = simple_selector.lowercase_name();
+    }
+
+    if (id.has_value())
+        m_descendant_ids.set(id.release_value());
+    else if (class_name.has_value())
+        m_descendant_classes.set(class_name.release_value());
+    else if (tag_name.has_value())
+        m_descendant_tag_names.set(tag_name.release_value());
+    else
+        m_invalidates_all_descendants = true;
+}
+
+// The attribute that a pseudo-class depends on, if it is only ever affected by one.
+static Optional<FlyString> attribute_for_pseudo_class(Selector::SimpleSelector::PseudoClass::Type type)
+{
+    switch (type) {
+    case Selector::SimpleSelector::PseudoClass::Type::Link:
+    case Selector::SimpleSelector::PseudoClass::Type::Visited:
+        return HTML::AttributeNames::href;
+    case Selector::SimpleSelector::PseudoClass::Type::Checked:
+        return HTML::AttributeNames::checked;
+    case Selector::SimpleSelector::PseudoClass::Type::Disabled:
+    case Selector::SimpleSelector::PseudoClass::Type::Enabled:
+        return HTML::AttributeNames::disabled;
+    case Selector::SimpleSelector::PseudoClass::Type::Lang:
+        return HTML::AttributeNames::lang;
+    default:
+        return {};
+    }
+}
+
+void InvalidationSets::add_selector(Selector const& selector)
+{
+    add_selector(selector, selector.compound_selectors().last(), {});
+}
+
+// `relation_to_subject` is set for the argument selectors of pseudo-classes, and is how the element they are matched
+// against relates to the subject of the outermost selector.
+void InvalidationSets::add_selector(Selector const& selector, Selector::CompoundSelector const& subject, Optional<Relation> relation_to_subject)
+{
+    auto const& compound_selectors = selector.compound_selectors();
+    for (size_t i = 0; i < compound_selectors.size(); ++i) {
+        // A change on an element matching this compound can affect the element matching the next one, and everything
+        // that is reached from there. Once the next one is a descendant, everything after it is as well, and once it
+        // is a following sibling, everything after it is inside one of the following siblings.
+        Relation relation = Relation::Self;
+        if (i + 1 < compound_selectors.size()) {
+            auto combinator = compound_selectors[i + 1].combinator;
+            if (combinator == Selector::Combinator::Descendant || combinator == Selector::Combinator::ImmediateChild)
+                relation = Relation::Descendant;
+            else
+                relation = Relation::Sibling;
+        }
+        if (relation == Relation::Self && relation_to_subject.has_value())
+            relation = *relation_to_subject;
+
+        for (auto const& simple_selector : compound_selectors[i].simple_selectors) {
+            switch (simple_selector.type) {
+            case Selector::SimpleSelector::Type::Class:
+                add_feature(m_class_sets.ensure(simple_selector.lowercase_name()), relation, subject);
+                break;
+            case Selector::SimpleSelector::Type::Id:
+                add_feature(m_id_sets.ensure(simple_selector.lowercase_name()), relation, subject);
+                break;
+            case Selector::SimpleSelector::Type::Attribute:
+                add_feature(m_attribute_sets.ensure(simple_selector.attribute().name.to_lowercase()), relation, subject);
+                break;
+            case Selector::SimpleSelector::Type::PseudoClass: {
+                auto const& pseudo_class = simple_selector.pseudo_class();
+                for (auto const& argument_selector : pseudo_class.argument_selector_list)
+                    add_selector(argument_selector, subject, relation);
+                if (auto attribute_name = attribute_for_pseudo_class(pseudo_class.type); attribute_name.has_value())
+                    add_feature(m_attribute_sets.ensure(*attribute_name), relation, subject);
+                break;
+            }
+            default:
+                break;
+            }
+        }
+    }
+}
+
+void InvalidationSets::add_feature(InvalidationSet& set, Relation relation, Selector::CompoundSelector const& subject)
+{
+    switch (relation) {
+    case Relation::Self:
+        set.set_invalidates_self();
+        break;
+    case Relation::Descendant:
+        set.add_descendant_features(subject);
+        break;
+    case Relation::Sibling:
+        set.set_invalidates_siblings();
+        break;
+    }
+}
+
+InvalidationSet const* InvalidationSets::for_class(FlyString const& class_name) const
+{
+    auto it = m_class_sets.find(class_name.to_lowercase());
+    if (it == m_class_sets.end())
+        return nullptr;
+    return &it->value;
+}
+
+InvalidationSet const* InvalidationSets::for_id(FlyString const& id) const
+{
+    auto it = m_id_sets.find(id.to_lowercase());
+    if (it == m_id_sets.end())
+        return nullptr;
+    return &it->value;
+}
+
+InvalidationSet const* InvalidationSets::for_attribute(FlyString const& attribute_name) const
+{
+    auto it = m_attribute_sets.find(attribute_name.to_lowercase());
+    if (it == m_attribute_sets.end())
+        return nullptr;
+    return &it->value;
+}
+
+}
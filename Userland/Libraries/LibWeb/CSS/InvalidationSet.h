@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/FlyString.h>
+#include <AK/HashMap.h>
+#include <AK/HashTable.h>
+#include <LibWeb/CSS/Selector.h>
+#include <LibWeb/Forward.h>
+
+namespace Web::CSS {
+
+// Describes which elements may match different rules once a class, id or attribute changes on an element.
+// All class names, ids and tag names in here are lowercase, so that they also cover quirks mode matching.
+class InvalidationSet {
+public:
+    // The element itself, and so everything inheriting from it.
+    bool invalidates_self() const { return m_invalidates_self; }
+
+    // Some descendants of the element. If there are any descendant features, only the descendants with one of those
+    // (and everything inheriting from them) can be affected, otherwise every descendant can.
+    bool invalidates_descendants() const { return m_invalidates_descendants; }
+    bool invalidates_all_descendants() const { return m_invalidates_all_descendants; }
+    bool matches_descendant_features(DOM::Element const&) const;
+
+    // The siblings following the element, and everything inside them.
+    bool invalidates_siblings() const { return m_invalidates_siblings; }
+
+    void set_invalidates_self() { m_invalidates_self = true; }
+    void set_invalidates_siblings() { m_invalidates_siblings = true; }
+    void add_descendant_features(Selector::CompoundSelector const& subject);
+
+private:
+    bool m_invalidates_self { false };
+    bool m_invalidates_descendants { false };
+    bool m_invalidates_all_descendants { false };
+    bool m_invalidates_siblings { false };
+
+    HashTable<FlyString> m_descendant_classes;
+    HashTable<FlyString> m_descendant_ids;
+    HashTable<FlyString> m_descendant_tag_names;
+};
+
+// The invalidation sets for every class, id and attribute that appears in a set of style rules.
+class InvalidationSets {
+public:
+    void add_selector(Selector const&);
+
+    InvalidationSet const* for_class(FlyString const& class_name) const;
+    InvalidationSet const* for_id(FlyString const& id) const;
+    InvalidationSet const* for_attribute(FlyString const& attribute_name) const;
+
+private:
+    enum class Relation {
+        Self,
+        Descendant,
+        Sibling,
+    };
+
+    void add_selector(Selector const&, Selector::CompoundSelector const& subject, Optional<Relation> relation_to_subject);
+    void add_feature(InvalidationSet&, Relation, Selector::CompoundSelector const& subject);
+
+    HashMap<FlyString, InvalidationSet> m_class_sets;
+    HashMap<FlyString, InvalidationSet> m_id_sets;
+    HashMap<FlyString, InvalidationSet> m_attribute_sets;
+};
+
+}
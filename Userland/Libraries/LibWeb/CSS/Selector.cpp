@@ -6,6 +6,7 @@
  */
 
 #include "Selector.h"
+#include <AK/StringHash.h>
 #include <LibWeb/CSS/Serialize.h>
 
 namespace Web::CSS {
@@ -23,6 +24,62 @@ Selector::Selector(Vector<CompoundSelector>&& compound_selectors)
             }
         }
     }
+
+    collect_ancestor_hashes();
+}
+
+// NOTE: The seeds keep ids, classes and tag names with the same name apart.
+u32 Selector::id_hash(StringView name)
+{
+    return string_hash(name.characters_without_null_termination(), name.length(), 1);
+}
+
+u32 Selector::class_hash(StringView name)
+{
+    return string_hash(name.characters_without_null_termination(), name.length(), 2);
+}
+
+// NOTE: Tag names are compared case-insensitively outside of HTML documents, so they're hashed that way too.
+u32 Selector::tag_name_hash(StringView name)
+{
+    return AK::case_insensitive_string_hash(name.characters_without_null_termination(), name.length(), 3);
+}
+
+void Selector::collect_ancestor_hashes()
+{
+    if (m_compound_selectors.is_empty())
+        return;
+
+    size_t next_hash_index = 0;
+    auto append_hash = [&](u32 hash) {
+        if (hash == 0 || next_hash_index == max_ancestor_hashes)
+            return;
+        m_ancestor_hashes[next_hash_index++] = hash;
+    };
+
+    // A compound selector has to match an ancestor of the subject if it's followed by a descendant or child combinator.
+    // Sibling combinators keep the parent the same, so in "a > b + c", "a" still has to match the parent of "c".
+    for (size_t i = m_compound_selectors.size() - 1; i > 0; --i) {
+        auto combinator = m_compound_selectors[i].combinator;
+        if (combinator != Combinator::Descendant && combinator != Combinator::ImmediateChild)
+            continue;
+
+        for (auto const& simple_selector : m_compound_selectors[i - 1].simple_selectors) {
+            switch (simple_selector.type) {
+            case SimpleSelector::Type::Id:
+                append_hash(id_hash(simple_selector.name()));
+                break;
+            case SimpleSelector::Type::Class:
+                append_hash(class_hash(simple_selector.name()));
+                break;
+            case SimpleSelector::Type::TagName:
+                append_hash(tag_name_hash(simple_selector.name()));
+                break;
+            default:
+                break;
+            }
+        }
+    }
 }
 
 // https://www.w3.org/TR/selectors-4/#specificity-rules
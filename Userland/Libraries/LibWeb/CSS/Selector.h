@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/FlyString.h>
 #include <AK/NonnullRefPtrVector.h>
 #include <AK/RefCounted.h>
@@ -199,12 +200,25 @@ public:
     u32 specificity() const;
     String serialize() const;
 
+    // Hashes of the ids, classes and tag names that ancestors of a matching element are required to have,
+    // closest ancestors first. Unused entries are 0. StyleComputer keeps a filter of the ones the ancestors
+    // of an element do have, so that it can reject selectors without walking up the tree.
+    static constexpr size_t max_ancestor_hashes = 8;
+    Array<u32, max_ancestor_hashes> const& ancestor_hashes() const { return m_ancestor_hashes; }
+
+    static u32 id_hash(StringView);
+    static u32 class_hash(StringView);
+    static u32 tag_name_hash(StringView);
+
 private:
     explicit Selector(Vector<CompoundSelector>&&);
 
+    void collect_ancestor_hashes();
+
     Vector<CompoundSelector> m_compound_selectors;
     mutable Optional<u32> m_specificity;
     Optional<Selector::PseudoElement> m_pseudo_element;
+    Array<u32, max_ancestor_hashes> m_ancestor_hashes {};
 };
 
 constexpr StringView pseudo_element_name(Selector::PseudoElement pseudo_element)
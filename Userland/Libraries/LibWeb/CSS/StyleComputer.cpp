@@ -148,6 +148,13 @@ void StyleComputer::for_each_stylesheet(CascadeOrigin cascade_origin, Callback c
 
 Vector<MatchingRule> StyleComputer::collect_matching_rules(DOM::Element const& element, CascadeOrigin cascade_origin, Optional<CSS::Selector::PseudoElement> pseudo_element) const
 {
+    bool const use_ancestor_filter = can_use_ancestor_filter_for(element);
+    auto selector_matches = [&](Selector const& selector) {
+        if (use_ancestor_filter && is_rejected_by_ancestor_filter(selector))
+            return false;
+        return SelectorEngine::matches(selector, element, pseudo_element);
+    };
+
     if (cascade_origin == CascadeOrigin::Author) {
         Vector<MatchingRule> rules_to_run;
         if (pseudo_element.has_value()) {
@@ -171,7 +178,7 @@ Vector<MatchingRule> StyleComputer::collect_matching_rules(DOM::Element const& e
         matching_rules.ensure_capacity(rules_to_run.size());
         for (auto const& rule_to_run : rules_to_run) {
             auto const& selector = rule_to_run.rule->selectors()[rule_to_run.selector_index];
-            if (SelectorEngine::matches(selector, element, pseudo_element))
+            if (selector_matches(selector))
                 matching_rules.append(rule_to_run);
         }
         return matching_rules;
@@ -184,7 +191,7 @@ Vector<MatchingRule> StyleComputer::collect_matching_rules(DOM::Element const& e
         sheet.for_each_effective_style_rule([&](auto const& rule) {
             size_t selector_index = 0;
             for (auto& selector : rule.selectors()) {
-                if (SelectorEngine::matches(selector, element, pseudo_element)) {
+                if (selector_matches(selector)) {
                     matching_rules.append({ &rule, style_sheet_index, rule_index, selector_index, selector.specificity() });
                     break;
                 }
@@ -1384,6 +1391,15 @@ void StyleComputer::build_rule_cache()
         ++style_sheet_index;
     });
 
+    for (auto cascade_origin : { CascadeOrigin::UserAgent, CascadeOrigin::Author }) {
+        for_each_stylesheet(cascade_origin, [&](auto& sheet) {
+            sheet.for_each_effective_style_rule([&](auto const& rule) {
+                for (CSS::Selector const& selector : rule.selectors())
+                    m_rule_cache->invalidation_sets.add_selector(selector);
+            });
+        });
+    }
+
     if constexpr (LIBWEB_CSS_DEBUG) {
         dbgln("Built rule cache!");
         dbgln("           ID: {}", num_id_rules);
@@ -1400,6 +1416,76 @@ void StyleComputer::invalidate_rule_cache()
     m_rule_cache = nullptr;
 }
 
+InvalidationSets const& StyleComputer::invalidation_sets() const
+{
+    build_rule_cache_if_needed();
+    return m_rule_cache->invalidation_sets;
+}
+
+void StyleComputer::push_ancestor(DOM::Element const& element)
+{
+    auto add_hash = [&](u32 hash) {
+        m_ancestor_filter.add(hash);
+        m_ancestor_filter_hashes.append(hash);
+    };
+
+    auto hash_count_before = m_ancestor_filter_hashes.size();
+    add_hash(Selector::tag_name_hash(element.local_name()));
+    if (auto id = element.attribute(HTML::AttributeNames::id); !id.is_null())
+        add_hash(Selector::id_hash(id));
+    for (auto const& class_name : element.class_names())
+        add_hash(Selector::class_hash(class_name));
+
+    // NOTE: The hashes are remembered, so that changes to the element's attributes can't unbalance the filter.
+    m_ancestor_filter_entries.append({ &element, m_ancestor_filter_hashes.size() - hash_count_before });
+}
+
+void StyleComputer::pop_ancestor(DOM::Element const& element)
+{
+    auto entry = m_ancestor_filter_entries.take_last();
+    VERIFY(entry.element == &element);
+    for (size_t i = 0; i < entry.hash_count; ++i)
+        m_ancestor_filter.remove(m_ancestor_filter_hashes.take_last());
+}
+
+// The filter only describes the ancestors of an element if it was built on the way down to its parent.
+// Elements whose style is computed outside of a style update, or right below a shadow root, can't use it.
+bool StyleComputer::can_use_ancestor_filter_for(DOM::Element const& element) const
+{
+    return !m_ancestor_filter_entries.is_empty() && m_ancestor_filter_entries.last().element == element.parent();
+}
+
+bool StyleComputer::is_rejected_by_ancestor_filter(Selector const& selector) const
+{
+    bool is_rejected = false;
+    for (auto hash : selector.ancestor_hashes()) {
+        if (hash == 0)
+            break;
+        if (!m_ancestor_filter.may_contain(hash)) {
+            is_rejected = true;
+            break;
+        }
+    }
+
+    if constexpr (LIBWEB_CSS_DEBUG) {
+        ++m_ancestor_filter_statistics.selectors_checked;
+        if (is_rejected)
+            ++m_ancestor_filter_statistics.selectors_rejected;
+    }
+    return is_rejected;
+}
+
+void StyleComputer::dump_ancestor_filter_statistics()
+{
+    auto const& statistics = m_ancestor_filter_statistics;
+    if (statistics.selectors_checked != 0) {
+        dbgln("Ancestor filter:");
+        dbgln("      Checked: {}", statistics.selectors_checked);
+        dbgln("     Rejected: {} ({}%)", statistics.selectors_rejected, statistics.selectors_rejected * 100 / statistics.selectors_checked);
+    }
+    m_ancestor_filter_statistics = {};
+}
+
 Gfx::IntRect StyleComputer::viewport_rect() const
 {
     if (auto const* browsing_context = document().browsing_context())
@@ -13,6 +13,8 @@
 #include <AK/OwnPtr.h>
 #include <LibWeb/CSS/CSSFontFaceRule.h>
 #include <LibWeb/CSS/CSSStyleDeclaration.h>
+#include <LibWeb/CSS/CountingBloomFilter.h>
+#include <LibWeb/CSS/InvalidationSet.h>
 #include <LibWeb/CSS/Parser/ComponentValue.h>
 #include <LibWeb/CSS/Parser/TokenStream.h>
 #include <LibWeb/CSS/Selector.h>
@@ -71,6 +73,18 @@ public:
 
     void invalidate_rule_cache();
 
+    // The invalidation sets for the selectors of every style rule that applies to the document, which tell which
+    // elements need their style updated when a class, id or attribute of an element changes.
+    InvalidationSets const& invalidation_sets() const;
+
+    // While styles are updated, the elements whose children are visited are pushed here on the way down the tree.
+    // This keeps a filter of the ids, classes and tag names of the ancestors of the elements whose style is computed,
+    // which rejects most selectors that need ancestors that aren't there without walking up the tree.
+    void push_ancestor(DOM::Element const&);
+    void pop_ancestor(DOM::Element const&);
+
+    void dump_ancestor_filter_statistics();
+
     Gfx::Font const& initial_font() const;
 
     void did_load_font(FlyString const& family_name);
@@ -106,6 +120,9 @@ private:
     void build_rule_cache();
     void build_rule_cache_if_needed() const;
 
+    bool can_use_ancestor_filter_for(DOM::Element const&) const;
+    bool is_rejected_by_ancestor_filter(Selector const&) const;
+
     DOM::Document& m_document;
 
     struct RuleCache {
@@ -114,9 +131,24 @@ private:
         HashMap<FlyString, Vector<MatchingRule>> rules_by_tag_name;
         HashMap<Selector::PseudoElement, Vector<MatchingRule>> rules_by_pseudo_element;
         Vector<MatchingRule> other_rules;
+        InvalidationSets invalidation_sets;
     };
     OwnPtr<RuleCache> m_rule_cache;
 
+    struct AncestorFilterEntry {
+        DOM::Element const* element { nullptr };
+        size_t hash_count { 0 };
+    };
+    CountingBloomFilter<u8, 12> m_ancestor_filter;
+    Vector<AncestorFilterEntry> m_ancestor_filter_entries;
+    Vector<u32> m_ancestor_filter_hashes;
+
+    struct AncestorFilterStatistics {
+        size_t selectors_checked { 0 };
+        size_t selectors_rejected { 0 };
+    };
+    mutable AncestorFilterStatistics m_ancestor_filter_statistics;
+
     class FontLoader;
     HashMap<String, NonnullOwnPtr<FontLoader>> m_loaded_fonts;
 };
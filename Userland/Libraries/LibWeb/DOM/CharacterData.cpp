@@ -10,6 +10,7 @@
 #include <LibWeb/DOM/MutationType.h>
 #include <LibWeb/DOM/Range.h>
 #include <LibWeb/DOM/StaticNodeList.h>
+#include <LibWeb/Layout/Node.h>
 
 namespace Web::DOM {
 
@@ -104,7 +105,10 @@ WebIDL::ExceptionOr<void> CharacterData::replace_data(size_t offset, size_t coun
         parent()->children_changed();
 
     set_needs_style_update(true);
-    document().set_needs_layout();
+    if (auto* layout_node = this->layout_node())
+        layout_node->set_needs_layout();
+    else
+        document().invalidate_layout();
     return {};
 }
 
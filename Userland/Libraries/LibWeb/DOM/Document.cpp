@@ -7,7 +7,10 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AnyOf.h>
 #include <AK/CharacterTypes.h>
+#include <AK/Debug.h>
+#include <AK/ScopeGuard.h>
 #include <AK/StringBuilder.h>
 #include <AK/Utf8View.h>
 #include <LibJS/Interpreter.h>
@@ -305,7 +308,7 @@ Document::Document(JS::Realm& realm, const AK::URL& url)
     });
 
     m_layout_update_timer = Platform::Timer::create_single_shot(0, [this] {
-        force_layout();
+        update_layout();
     });
 }
 
@@ -778,6 +781,16 @@ AK::URL Document::parse_url(String const& url) const
 }
 
 void Document::set_needs_layout()
+{
+    // NOTE: Without knowing which layout nodes changed, everything has to be laid out again.
+    m_needs_full_layout = true;
+    if (m_needs_layout)
+        return;
+    m_needs_layout = true;
+    schedule_layout_update();
+}
+
+void Document::set_layout_nodes_need_layout(Badge<Layout::Node>)
 {
     if (m_needs_layout)
         return;
@@ -824,26 +837,33 @@ void Document::update_layout()
         m_layout_root = verify_cast<Layout::InitialContainingBlock>(*tree_builder.build(*this));
     }
 
-    Layout::LayoutState layout_state;
-    layout_state.used_values_per_layout_node.resize(layout_node_count());
+    // NOTE: If nothing has been marked as needing layout, we don't know what changed and have to lay out everything.
+    Vector<Layout::Node&> nodes_that_needed_layout;
+    m_layout_root->clear_needs_layout(nodes_that_needed_layout);
+    bool needs_full_layout = m_needs_full_layout || !m_layout_root->paint_box() || nodes_that_needed_layout.is_empty();
 
-    {
-        Layout::BlockFormattingContext root_formatting_context(layout_state, *m_layout_root, nullptr);
+    if (needs_full_layout || !relayout_from_layout_boundaries(nodes_that_needed_layout)) {
+        Layout::LayoutState layout_state;
+        layout_state.used_values_per_layout_node.resize(layout_node_count());
 
-        auto& icb = static_cast<Layout::InitialContainingBlock&>(*m_layout_root);
-        auto& icb_state = layout_state.get_mutable(icb);
-        icb_state.set_content_width(viewport_rect.width());
-        icb_state.set_content_height(viewport_rect.height());
+        {
+            Layout::BlockFormattingContext root_formatting_context(layout_state, *m_layout_root, nullptr);
 
-        root_formatting_context.run(
-            *m_layout_root,
-            Layout::LayoutMode::Normal,
-            Layout::AvailableSpace(
-                Layout::AvailableSize::make_definite(viewport_rect.width()),
-                Layout::AvailableSize::make_definite(viewport_rect.height())));
-    }
+            auto& icb = static_cast<Layout::InitialContainingBlock&>(*m_layout_root);
+            auto& icb_state = layout_state.get_mutable(icb);
+            icb_state.set_content_width(viewport_rect.width());
+            icb_state.set_content_height(viewport_rect.height());
 
-    layout_state.commit();
+            root_formatting_context.run(
+                *m_layout_root,
+                Layout::LayoutMode::Normal,
+                Layout::AvailableSpace(
+                    Layout::AvailableSize::make_definite(viewport_rect.width()),
+                    Layout::AvailableSize::make_definite(viewport_rect.height())));
+        }
+
+        layout_state.commit();
+    }
 
     browsing_context()->set_needs_display();
 
@@ -853,9 +873,64 @@ void Document::update_layout()
     }
 
     m_needs_layout = false;
+    m_needs_full_layout = false;
     m_layout_update_timer->stop();
 }
 
+// Lays out the contents of the nearest layout boundary of every node that needed layout again, and nothing else.
+// Returns false if one of them doesn't have a layout boundary, in which case the whole document has to be laid out.
+bool Document::relayout_from_layout_boundaries(Vector<Layout::Node&> const& nodes_that_needed_layout)
+{
+    Vector<Layout::Box const*> layout_boundaries;
+    for (auto& node : nodes_that_needed_layout) {
+        Layout::Box const* layout_boundary = nullptr;
+        for (Layout::Node const* ancestor = &node; ancestor; ancestor = ancestor->parent()) {
+            if (is<Layout::Box>(*ancestor) && static_cast<Layout::Box const&>(*ancestor).is_layout_boundary()) {
+                layout_boundary = static_cast<Layout::Box const*>(ancestor);
+                break;
+            }
+        }
+        if (!layout_boundary)
+            return false;
+
+        // NOTE: Layout boundaries inside other ones are laid out along with them.
+        if (any_of(layout_boundaries, [&](auto* other) { return other->is_inclusive_ancestor_of(*layout_boundary); }))
+            continue;
+        layout_boundaries.remove_all_matching([&](auto* other) { return layout_boundary->is_ancestor_of(*other); });
+        layout_boundaries.append(layout_boundary);
+    }
+
+    Vector<NonnullOwnPtr<Layout::LayoutState>> layout_states;
+    for (auto* layout_boundary : layout_boundaries) {
+        auto layout_state = make<Layout::LayoutState>();
+        layout_state->used_values_per_layout_node.resize(layout_node_count());
+        if (!layout_state->restore_from_last_layout(*layout_boundary))
+            return false;
+        layout_states.append(move(layout_state));
+    }
+
+    for (size_t i = 0; i < layout_boundaries.size(); ++i) {
+        auto& layout_boundary = verify_cast<Layout::BlockContainer>(*layout_boundaries[i]);
+        auto& layout_state = *layout_states[i];
+        auto const& layout_boundary_state = layout_state.get(layout_boundary);
+
+        Layout::BlockFormattingContext formatting_context(layout_state, layout_boundary, nullptr);
+        formatting_context.run(
+            layout_boundary,
+            Layout::LayoutMode::Normal,
+            Layout::AvailableSpace(
+                Layout::AvailableSize::make_definite(layout_boundary_state.content_width()),
+                Layout::AvailableSize::make_definite(layout_boundary_state.content_height())));
+        formatting_context.parent_context_did_dimension_child_root_box();
+
+        layout_state.commit(&layout_boundary);
+    }
+
+    // NOTE: The stacking contexts refer to the paintables that were just replaced.
+    invalidate_stacking_context_tree();
+    return true;
+}
+
 [[nodiscard]] static bool update_style_recursively(DOM::Node& node)
 {
     bool const needs_full_style_update = node.document().needs_full_style_update();
@@ -867,6 +942,14 @@ void Document::update_layout()
     node.set_needs_style_update(false);
 
     if (needs_full_style_update || node.child_needs_style_update()) {
+        auto& style_computer = node.document().style_computer();
+        if (node.is_element())
+            style_computer.push_ancestor(static_cast<DOM::Element const&>(node));
+        ScopeGuard pop_ancestor = [&] {
+            if (node.is_element())
+                style_computer.pop_ancestor(static_cast<DOM::Element const&>(node));
+        };
+
         if (node.is_element()) {
             if (auto* shadow_root = static_cast<DOM::Element&>(node).shadow_root()) {
                 if (needs_full_style_update || shadow_root->needs_style_update() || shadow_root->child_needs_style_update())
@@ -898,6 +981,8 @@ void Document::update_style()
     evaluate_media_rules();
     if (update_style_recursively(*this))
         invalidate_layout();
+    if constexpr (LIBWEB_CSS_DEBUG)
+        style_computer().dump_ancestor_filter_statistics();
     m_needs_full_style_update = false;
     m_style_update_timer->stop();
 }
@@ -192,6 +192,10 @@ public:
 
     void set_needs_layout();
 
+    // Schedules a layout that only lays out what's inside the layout boundaries around the layout nodes that were
+    // marked as needing it.
+    void set_layout_nodes_need_layout(Badge<Layout::Node>);
+
     void invalidate_layout();
     void invalidate_stacking_context_tree();
 
@@ -452,6 +456,7 @@ private:
     virtual EventTarget& global_event_handlers_to_event_target(FlyString const&) final { return *this; }
 
     void tear_down_layout_tree();
+    bool relayout_from_layout_boundaries(Vector<Layout::Node&> const& nodes_that_needed_layout);
 
     void evaluate_media_rules();
 
@@ -552,6 +557,7 @@ private:
     Vector<WeakPtr<CSS::MediaQueryList>> m_media_query_lists;
 
     bool m_needs_layout { false };
+    bool m_needs_full_layout { false };
 
     bool m_needs_full_style_update { false };
 
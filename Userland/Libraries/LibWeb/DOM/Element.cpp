@@ -107,6 +107,7 @@ WebIDL::ExceptionOr<void> Element::set_attribute(FlyString const& name, String c
 
     // 3. Let attribute be the first attribute in this’s attribute list whose qualified name is qualifiedName, and null otherwise.
     auto* attribute = m_attributes->get_attribute(name);
+    auto old_value = attribute ? attribute->value() : String {};
 
     // 4. If attribute is null, create an attribute whose local name is qualifiedName, value is value, and node document is this’s node document, then append this attribute to this, and then return.
     if (!attribute) {
@@ -123,7 +124,7 @@ WebIDL::ExceptionOr<void> Element::set_attribute(FlyString const& name, String c
 
     parse_attribute(attribute->local_name(), value);
 
-    invalidate_style_after_attribute_change(name);
+    invalidate_style_after_attribute_change(attribute->local_name(), old_value);
 
     return {};
 }
@@ -186,11 +187,19 @@ WebIDL::ExceptionOr<void> Element::set_attribute_ns(FlyString const& namespace_,
 // https://dom.spec.whatwg.org/#dom-element-removeattribute
 void Element::remove_attribute(FlyString const& name)
 {
+    auto* attribute = m_attributes->get_attribute(name);
+    if (!attribute)
+        return;
+
+    // NOTE: The name we were given may differ in case from the attribute's local name.
+    auto local_name = attribute->local_name();
+    auto old_value = attribute->value();
+
     m_attributes->remove_attribute(name);
 
-    did_remove_attribute(name);
+    did_remove_attribute(local_name);
 
-    invalidate_style_after_attribute_change(name);
+    invalidate_style_after_attribute_change(local_name, old_value);
 }
 
 // https://dom.spec.whatwg.org/#dom-element-hasattribute
@@ -223,7 +232,7 @@ WebIDL::ExceptionOr<bool> Element::toggle_attribute(FlyString const& name, Optio
 
             parse_attribute(new_attribute->local_name(), "");
 
-            invalidate_style_after_attribute_change(name);
+            invalidate_style_after_attribute_change(new_attribute->local_name(), {});
 
             return true;
         }
@@ -234,11 +243,14 @@ WebIDL::ExceptionOr<bool> Element::toggle_attribute(FlyString const& name, Optio
 
     // 5. Otherwise, if force is not given or is false, remove an attribute given qualifiedName and this, and then return false.
     if (!force.has_value() || !force.value()) {
+        auto local_name = attribute->local_name();
+        auto old_value = attribute->value();
+
         m_attributes->remove_attribute(name);
 
-        did_remove_attribute(name);
+        did_remove_attribute(local_name);
 
-        invalidate_style_after_attribute_change(name);
+        invalidate_style_after_attribute_change(local_name, old_value);
     }
 
     // 6. Return true.
@@ -345,7 +357,11 @@ void Element::parse_attribute(FlyString const& name, String const& value)
 
 void Element::did_remove_attribute(FlyString const& name)
 {
-    if (name == HTML::AttributeNames::style) {
+    if (name == HTML::AttributeNames::class_) {
+        m_classes.clear();
+        if (m_class_list)
+            m_class_list->associated_attribute_changed({});
+    } else if (name == HTML::AttributeNames::style) {
         if (m_inline_style) {
             m_inline_style = nullptr;
             set_needs_style_update(true);
@@ -970,13 +986,76 @@ void Element::scroll_into_view(Optional<Variant<bool, ScrollIntoViewOptions>> ar
     // FIXME: 8. Optionally perform some other action that brings the element to the user’s attention.
 }
 
-void Element::invalidate_style_after_attribute_change(FlyString const& attribute_name)
+static void invalidate_descendants_matching(Node& node, CSS::InvalidationSet const& invalidation_set)
+{
+    node.for_each_child_of_type<Element>([&](Element& child) {
+        // NOTE: Elements are matched against selectors inside their shadow trees as well, so those can't be skipped.
+        if (child.shadow_root() || invalidation_set.matches_descendant_features(child))
+            child.invalidate_style();
+        else
+            invalidate_descendants_matching(child, invalidation_set);
+    });
+}
+
+void Element::invalidate_style_with(CSS::InvalidationSet const& invalidation_set)
 {
-    // FIXME: Only invalidate if the attribute can actually affect style.
-    (void)attribute_name;
+    if (invalidation_set.invalidates_self() || invalidation_set.invalidates_all_descendants())
+        invalidate_style();
+    else if (invalidation_set.invalidates_descendants())
+        invalidate_descendants_matching(*this, invalidation_set);
+
+    if (invalidation_set.invalidates_siblings()) {
+        for (auto* sibling = next_element_sibling(); sibling; sibling = sibling->next_element_sibling())
+            sibling->invalidate_style();
+    }
+}
 
+void Element::invalidate_style_after_attribute_change(FlyString const& attribute_name, String const& old_value)
+{
     // FIXME: This will need to become smarter when we implement the :has() selector.
+
+    // NOTE: While elements are created, nothing has been styled yet and there is nothing to compare with.
+    if (!is_connected()) {
+        invalidate_style();
+        return;
+    }
+
+    auto const& invalidation_sets = document().style_computer().invalidation_sets();
+    auto invalidate_with = [&](CSS::InvalidationSet const* invalidation_set) {
+        if (invalidation_set)
+            invalidate_style_with(*invalidation_set);
+    };
+
+    // NOTE: Classes and ids are only matched by the selectors that name them, so only the elements those can
+    //       match need their style updated, which may be none at all.
+    if (attribute_name == HTML::AttributeNames::class_) {
+        auto old_classes = old_value.split_view(Infra::is_ascii_whitespace);
+        for (auto const& old_class : old_classes) {
+            if (!m_classes.contains_slow(old_class))
+                invalidate_with(invalidation_sets.for_class(old_class));
+        }
+        for (auto const& new_class : m_classes) {
+            if (!old_classes.contains_slow(new_class.view()))
+                invalidate_with(invalidation_sets.for_class(new_class));
+        }
+        invalidate_with(invalidation_sets.for_attribute(attribute_name));
+        return;
+    }
+
+    if (attribute_name == HTML::AttributeNames::id) {
+        auto new_value = get_attribute(attribute_name);
+        if (!old_value.is_empty())
+            invalidate_with(invalidation_sets.for_id(old_value));
+        if (!new_value.is_empty())
+            invalidate_with(invalidation_sets.for_id(new_value));
+        invalidate_with(invalidation_sets.for_attribute(attribute_name));
+        return;
+    }
+
+    // NOTE: Any other attribute can affect the element's own style through presentational hints or pseudo-classes,
+    //       but only affects its siblings if a selector says so.
     invalidate_style();
+    invalidate_with(invalidation_sets.for_attribute(attribute_name));
 }
 
 }
@@ -72,6 +72,7 @@ class IdentifierStyleValue;
 class ImageStyleValue;
 class InheritStyleValue;
 class InitialStyleValue;
+class InvalidationSet;
 class Length;
 class LengthBox;
 class LengthPercentage;
@@ -361,6 +362,7 @@ namespace Web::Painting {
 enum class PaintPhase;
 class ButtonPaintable;
 class CheckBoxPaintable;
+class DisplayList;
 class LabelablePaintable;
 class Paintable;
 class PaintableBox;
@@ -313,7 +313,8 @@ void HTMLObjectElement::update_layout_and_child_objects(Representation represent
 
     m_representation = representation;
     set_needs_style_update(true);
-    document().set_needs_layout();
+    // NOTE: Each representation is laid out by a different kind of layout node.
+    document().invalidate_layout();
 }
 
 }
@@ -2281,6 +2281,7 @@ void HTMLParser::handle_text(HTMLToken& token)
                 // that is blocking scripts and the script's "ready to be parser-executed"
                 // flag is set.
                 if (m_document->has_a_style_sheet_that_is_blocking_scripts() || !script->is_ready_to_be_parser_executed()) {
+                    start_the_speculative_html_parser();
                     main_thread_event_loop().spin_until([&] {
                         return !m_document->has_a_style_sheet_that_is_blocking_scripts() && script->is_ready_to_be_parser_executed();
                     });
@@ -3272,6 +3273,15 @@ void HTMLParser::process_using_the_rules_for_foreign_content(HTMLToken& token)
     VERIFY_NOT_REACHED();
 }
 
+// https://html.spec.whatwg.org/multipage/parsing.html#start-the-speculative-html-parser
+void HTMLParser::start_the_speculative_html_parser()
+{
+    // NOTE: We don't have to wait for more input to arrive, so this looks at all of the remaining input at once.
+    if (!m_speculative_html_parser)
+        m_speculative_html_parser = make<SpeculativeHTMLParser>(m_tokenizer.unparsed_input(), m_scripting_enabled);
+    m_speculative_html_parser->run(document());
+}
+
 // https://html.spec.whatwg.org/multipage/parsing.html#reset-the-insertion-mode-appropriately
 void HTMLParser::reset_the_insertion_mode_appropriately()
 {
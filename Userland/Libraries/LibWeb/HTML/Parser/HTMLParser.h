@@ -10,6 +10,7 @@
 #include <LibWeb/DOM/Node.h>
 #include <LibWeb/HTML/Parser/HTMLTokenizer.h>
 #include <LibWeb/HTML/Parser/ListOfActiveFormattingElements.h>
+#include <LibWeb/HTML/Parser/SpeculativeHTMLParser.h>
 #include <LibWeb/HTML/Parser/StackOfOpenElements.h>
 
 namespace Web::HTML {
@@ -146,6 +147,8 @@ private:
     void decrement_script_nesting_level();
     void reset_the_insertion_mode_appropriately();
 
+    void start_the_speculative_html_parser();
+
     void adjust_mathml_attributes(HTMLToken&);
     void adjust_svg_tag_names(HTMLToken&);
     void adjust_svg_attributes(HTMLToken&);
@@ -171,6 +174,9 @@ private:
 
     HTMLTokenizer m_tokenizer;
 
+    // NOTE: This is kept around between scripts, as it has already looked at everything up to where it stopped.
+    OwnPtr<SpeculativeHTMLParser> m_speculative_html_parser;
+
     bool m_foster_parenting { false };
     bool m_frameset_ok { true };
     bool m_parsing_fragment { false };
@@ -5,8 +5,10 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/BuiltinWrappers.h>
 #include <AK/CharacterTypes.h>
 #include <AK/Debug.h>
+#include <AK/SIMD.h>
 #include <AK/SourceLocation.h>
 #include <LibTextCodec/Decoder.h>
 #include <LibWeb/HTML/Parser/Entities.h>
@@ -155,6 +157,23 @@ namespace Web::HTML {
 #define EMIT_CURRENT_CHARACTER \
     EMIT_CHARACTER(current_input_character.value());
 
+// NOTE: The characters that follow the current one are emitted along with it, up to the next one that this state
+//       doesn't simply emit. This saves going through the state machine for every one of them.
+#define EMIT_CURRENT_CHARACTER_AND_ORDINARY_ASCII_RUN(special_character, other_special_character) \
+    do {                                                                                         \
+        create_new_token(HTMLToken::Type::Character);                                            \
+        m_current_token.set_code_point(current_input_character.value());                         \
+        m_queued_tokens.enqueue(move(m_current_token));                                          \
+        enqueue_ordinary_ascii_run_as_characters(special_character, other_special_character);    \
+        return m_queued_tokens.dequeue();                                                        \
+    } while (0)
+
+#define APPEND_CURRENT_CHARACTER_AND_ORDINARY_ASCII_RUN(special_character, other_special_character)       \
+    do {                                                                                                  \
+        m_current_builder.append_code_point(current_input_character.value());                             \
+        m_current_builder.append(consume_ordinary_ascii_run(special_character, other_special_character)); \
+    } while (0)
+
 #define SWITCH_TO_AND_EMIT_CHARACTER(code_point, new_state) \
     do {                                                    \
         will_switch_to(State::new_state);                   \
@@ -188,20 +207,19 @@ Optional<u32> HTMLTokenizer::next_code_point()
     if (m_utf8_iterator == m_utf8_view.end())
         return {};
 
-    u32 code_point;
+    u32 code_point = *m_utf8_iterator;
     // https://html.spec.whatwg.org/multipage/parsing.html#preprocessing-the-input-stream:tokenization
     // https://infra.spec.whatwg.org/#normalize-newlines
-    if (peek_code_point(0).value_or(0) == '\r' && peek_code_point(1).value_or(0) == '\n') {
+    if (code_point == '\r' && peek_code_point(1).value_or(0) == '\n') {
         // replace every U+000D CR U+000A LF code point pair with a single U+000A LF code point,
         skip(2);
         code_point = '\n';
-    } else if (peek_code_point(0).value_or(0) == '\r') {
+    } else if (code_point == '\r') {
         // replace every remaining U+000D CR code point with a U+000A LF code point.
         skip(1);
         code_point = '\n';
     } else {
         skip(1);
-        code_point = *m_prev_utf8_iterator;
     }
 
     dbgln_if(TOKENIZER_TRACE_DEBUG, "(Tokenizer) Next code_point: {}", code_point);
@@ -227,6 +245,81 @@ void HTMLTokenizer::skip(size_t count)
     }
 }
 
+// Returns the length of the run of ASCII characters at the start of the input that are neither NUL nor CR (which is
+// subject to newline normalization), nor one of the two given characters.
+static size_t length_of_ordinary_ascii_run(ReadonlyBytes input, u8 special_character, u8 other_special_character)
+{
+    using AK::SIMD::u8x16;
+
+    u8x16 special_characters;
+    u8x16 other_special_characters;
+    for (size_t i = 0; i < 16; ++i) {
+        special_characters[i] = special_character;
+        other_special_characters[i] = other_special_character;
+    }
+
+    size_t length = 0;
+    for (; length + 16 <= input.size(); length += 16) {
+        u8x16 characters;
+        __builtin_memcpy(&characters, input.data() + length, sizeof(characters));
+
+        auto is_special = (characters >= 0x80) | (characters == 0) | (characters == '\r') | (characters == special_characters) | (characters == other_special_characters);
+        u64 special_masks[2];
+        static_assert(sizeof(is_special) == sizeof(special_masks));
+        __builtin_memcpy(special_masks, &is_special, sizeof(special_masks));
+
+        // Every lane of a special character is 0xff, and the lowest lane is the lowest byte.
+        if (special_masks[0] != 0)
+            return length + count_trailing_zeroes(special_masks[0]) / 8;
+        if (special_masks[1] != 0)
+            return length + 8 + count_trailing_zeroes(special_masks[1]) / 8;
+    }
+
+    for (; length < input.size(); ++length) {
+        auto character = input[length];
+        if (!is_ascii(character) || character == 0 || character == '\r' || character == special_character || character == other_special_character)
+            break;
+    }
+    return length;
+}
+
+StringView HTMLTokenizer::consume_ordinary_ascii_run(u8 special_character, u8 other_special_character)
+{
+    auto offset = m_utf8_view.byte_offset_of(m_utf8_iterator);
+    auto input = m_utf8_view.as_string().bytes().slice(offset);
+
+    // NOTE: The parser stops at the insertion point, so the run mustn't go past it.
+    if (m_insertion_point.defined && m_insertion_point.position >= offset)
+        input = input.trim(m_insertion_point.position - offset);
+
+    auto length = length_of_ordinary_ascii_run(input, special_character, other_special_character);
+    for (size_t i = 0; i < length; ++i) {
+        if (!m_source_positions.is_empty()) {
+            auto position = m_source_positions.last();
+            if (input[i] == '\n') {
+                position.column = 0;
+                position.line++;
+            } else {
+                position.column++;
+            }
+            m_source_positions.append(position);
+        }
+        m_prev_utf8_iterator = m_utf8_iterator;
+        ++m_utf8_iterator;
+    }
+    return StringView { input.trim(length) };
+}
+
+void HTMLTokenizer::enqueue_ordinary_ascii_run_as_characters(u8 special_character, u8 other_special_character)
+{
+    auto run = consume_ordinary_ascii_run(special_character, other_special_character);
+    for (size_t i = 0; i < run.length(); ++i) {
+        auto token = HTMLToken::make_character(run[i]);
+        token.set_start_position({}, nth_last_position(run.length() - 1 - i));
+        m_queued_tokens.enqueue(move(token));
+    }
+}
+
 Optional<u32> HTMLTokenizer::peek_code_point(size_t offset) const
 {
     auto it = m_utf8_iterator;
@@ -286,7 +379,7 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    EMIT_CURRENT_CHARACTER;
+                    EMIT_CURRENT_CHARACTER_AND_ORDINARY_ASCII_RUN('&', '<');
                 }
             }
             END_STATE
@@ -1257,7 +1350,7 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    m_current_builder.append_code_point(current_input_character.value());
+                    APPEND_CURRENT_CHARACTER_AND_ORDINARY_ASCII_RUN('"', '&');
                     continue;
                 }
             }
@@ -1289,7 +1382,7 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    m_current_builder.append_code_point(current_input_character.value());
+                    APPEND_CURRENT_CHARACTER_AND_ORDINARY_ASCII_RUN('\'', '&');
                     continue;
                 }
             }
@@ -1459,7 +1552,7 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    m_current_builder.append_code_point(current_input_character.value());
+                    APPEND_CURRENT_CHARACTER_AND_ORDINARY_ASCII_RUN('<', '-');
                     continue;
                 }
             }
@@ -1896,7 +1989,7 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    EMIT_CURRENT_CHARACTER;
+                    EMIT_CURRENT_CHARACTER_AND_ORDINARY_ASCII_RUN('&', '<');
                 }
             }
             END_STATE
@@ -2015,7 +2108,7 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    EMIT_CURRENT_CHARACTER;
+                    EMIT_CURRENT_CHARACTER_AND_ORDINARY_ASCII_RUN('<', '<');
                 }
             }
             END_STATE
@@ -2134,7 +2227,7 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    EMIT_CURRENT_CHARACTER;
+                    EMIT_CURRENT_CHARACTER_AND_ORDINARY_ASCII_RUN('<', '<');
                 }
             }
             END_STATE
@@ -2153,7 +2246,7 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    EMIT_CURRENT_CHARACTER;
+                    EMIT_CURRENT_CHARACTER_AND_ORDINARY_ASCII_RUN(0, 0);
                 }
             }
             END_STATE
@@ -125,6 +125,9 @@ public:
 
     String source() const { return m_decoded_input; }
 
+    // The input that hasn't been consumed yet.
+    StringView unparsed_input() const { return m_utf8_view.as_string().substring_view(m_utf8_view.iterator_offset(m_utf8_iterator)); }
+
     void insert_input_at_insertion_point(String const& input);
     void insert_eof();
     bool is_eof_inserted();
@@ -149,6 +152,8 @@ public:
 private:
     void skip(size_t count);
     Optional<u32> next_code_point();
+    StringView consume_ordinary_ascii_run(u8 special_character, u8 other_special_character);
+    void enqueue_ordinary_ascii_run_as_characters(u8 special_character, u8 other_special_character);
     Optional<u32> peek_code_point(size_t offset) const;
     bool consume_next_if_match(StringView, CaseSensitivity = CaseSensitivity::CaseSensitive);
     void create_new_token(HTMLToken::Type);
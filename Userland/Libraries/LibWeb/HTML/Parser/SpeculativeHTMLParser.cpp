@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <LibWeb/DOM/Document.h>
+#include <LibWeb/HTML/AttributeNames.h>
+#include <LibWeb/HTML/Parser/SpeculativeHTMLParser.h>
+#include <LibWeb/HTML/TagNames.h>
+#include <LibWeb/Infra/CharacterTypes.h>
+#include <LibWeb/Loader/LoadRequest.h>
+#include <LibWeb/Loader/ResourceLoader.h>
+#include <LibWeb/MimeSniff/MimeType.h>
+
+namespace Web::HTML {
+
+SpeculativeHTMLParser::SpeculativeHTMLParser(StringView input, bool scripting_enabled)
+    : m_tokenizer(input, "utf-8")
+    , m_scripting_enabled(scripting_enabled)
+{
+}
+
+void SpeculativeHTMLParser::run(DOM::Document& document)
+{
+    run(document.base_url(), document.fallback_base_url(), [&](Resource::Type type, AK::URL const& url) {
+        dbgln_if(HTML_PARSER_DEBUG, "SpeculativeHTMLParser: Fetching {}", url);
+
+        // NOTE: This has to be the same request that the element itself will make once it is inserted, so that it
+        //       finds the response in the resource cache.
+        auto request = LoadRequest::create_for_url_on_page(url, document.page());
+        (void)ResourceLoader::the().load_resource(type, request);
+    });
+}
+
+void SpeculativeHTMLParser::run(AK::URL const& document_base_url, AK::URL const& document_fallback_base_url, FetchCallback const& fetch)
+{
+    DocumentURLs document_urls { document_base_url, document_fallback_base_url };
+    for (;;) {
+        auto token = m_tokenizer.next_token();
+        if (!token.has_value() || token->is_end_of_file())
+            break;
+        if (token->is_start_tag())
+            process_start_tag(document_urls, *token, fetch);
+        else if (token->is_end_tag())
+            process_end_tag(*token);
+    }
+}
+
+// Mirrors how HTMLScriptElement::prepare_script() decides that a script is a classic script, as only those are
+// loaded through the resource cache.
+static bool is_classic_script(HTMLToken& token)
+{
+    auto type = token.attribute(AttributeNames::type);
+    auto language = token.attribute(AttributeNames::language);
+    if (type.is_empty() && (!type.is_null() || language.is_empty()))
+        return true;
+    if (!type.is_null())
+        return MimeSniff::is_javascript_mime_type_essence_match(type.trim(Infra::ASCII_WHITESPACE));
+    return MimeSniff::is_javascript_mime_type_essence_match(String::formatted("text/{}", language));
+}
+
+static bool is_stylesheet_link(HTMLToken& token)
+{
+    bool is_stylesheet = false;
+    auto lowercased_rel = token.attribute(AttributeNames::rel).to_lowercase_string();
+    for (auto part : lowercased_rel.split_view(Infra::is_ascii_whitespace)) {
+        if (part == "alternate"sv)
+            return false;
+        if (part == "stylesheet"sv)
+            is_stylesheet = true;
+    }
+    return is_stylesheet;
+}
+
+void SpeculativeHTMLParser::process_start_tag(DocumentURLs const& document_urls, HTMLToken& token, FetchCallback const& fetch)
+{
+    auto const& tag_name = token.tag_name();
+
+    // NOTE: The tree builder switches the tokenizer state for elements with raw text contents, and since there is
+    //       none here, this does the same. Foreign content is not taken into account.
+    if (tag_name == TagNames::script)
+        m_tokenizer.switch_to(HTMLTokenizer::State::ScriptData);
+    else if (tag_name.is_one_of(TagNames::style, TagNames::xmp, TagNames::iframe, TagNames::noembed, TagNames::noframes))
+        m_tokenizer.switch_to(HTMLTokenizer::State::RAWTEXT);
+    else if (tag_name == TagNames::noscript && m_scripting_enabled)
+        m_tokenizer.switch_to(HTMLTokenizer::State::RAWTEXT);
+    else if (tag_name.is_one_of(TagNames::textarea, TagNames::title))
+        m_tokenizer.switch_to(HTMLTokenizer::State::RCDATA);
+    else if (tag_name == TagNames::plaintext)
+        m_tokenizer.switch_to(HTMLTokenizer::State::PLAINTEXT);
+
+    if (tag_name == TagNames::template_) {
+        ++m_template_nesting_level;
+        return;
+    }
+    if (m_template_nesting_level > 0)
+        return;
+
+    if (tag_name == TagNames::base) {
+        // NOTE: Only the first base element with an href attribute is used, which may already be in the document.
+        auto href = token.attribute(AttributeNames::href);
+        if (!m_base_url.has_value() && !href.is_null() && document_urls.base_url == document_urls.fallback_base_url)
+            m_base_url = document_urls.fallback_base_url.complete_url(href);
+        return;
+    }
+
+    if (tag_name == TagNames::script) {
+        auto src = token.attribute(AttributeNames::src);
+        if (m_scripting_enabled && !src.is_empty() && is_classic_script(token))
+            speculatively_fetch(document_urls, Resource::Type::Generic, src, fetch);
+        return;
+    }
+
+    if (tag_name == TagNames::link) {
+        auto href = token.attribute(AttributeNames::href);
+        if (!href.is_empty() && is_stylesheet_link(token))
+            speculatively_fetch(document_urls, Resource::Type::Generic, href, fetch);
+        return;
+    }
+
+    if (tag_name == TagNames::img) {
+        auto src = token.attribute(AttributeNames::src);
+        if (!src.is_empty())
+            speculatively_fetch(document_urls, Resource::Type::Image, src, fetch);
+        return;
+    }
+}
+
+void SpeculativeHTMLParser::process_end_tag(HTMLToken const& token)
+{
+    if (token.tag_name() == TagNames::template_ && m_template_nesting_level > 0)
+        --m_template_nesting_level;
+}
+
+void SpeculativeHTMLParser::speculatively_fetch(DocumentURLs const& document_urls, Resource::Type type, StringView url_string, FetchCallback const& fetch)
+{
+    auto url = m_base_url.has_value() ? m_base_url->complete_url(url_string) : document_urls.base_url.complete_url(url_string);
+    if (!url.is_valid())
+        return;
+    if (url.scheme() == "data"sv || url.scheme() == "file"sv)
+        return;
+    if (m_fetched_urls.set(url.to_string()) != AK::HashSetResult::InsertedNewEntry)
+        return;
+
+    fetch(type, url);
+}
+
+}
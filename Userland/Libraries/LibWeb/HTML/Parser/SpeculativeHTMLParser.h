@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Function.h>
+#include <AK/HashTable.h>
+#include <AK/Optional.h>
+#include <AK/String.h>
+#include <AK/URL.h>
+#include <LibWeb/Forward.h>
+#include <LibWeb/HTML/Parser/HTMLTokenizer.h>
+#include <LibWeb/Loader/Resource.h>
+
+namespace Web::HTML {
+
+// https://html.spec.whatwg.org/multipage/parsing.html#speculative-html-parsing
+// Tokenizes the input that the HTML parser hasn't reached yet while it is blocked on a script, and starts loading the
+// stylesheets, scripts and images it finds. By the time the parser gets to them, they are in the resource cache.
+// Nothing it finds is ever inserted into the document.
+class SpeculativeHTMLParser {
+public:
+    SpeculativeHTMLParser(StringView input, bool scripting_enabled);
+
+    // Tokenizes the rest of the input, starting where the previous run left off.
+    void run(DOM::Document&);
+
+    // Like the above, but hands every resource to `fetch` instead of loading it. Relative URLs are resolved against
+    // the document's base URL, unless the document has no <base> element yet and a <base href> comes along.
+    using FetchCallback = Function<void(Resource::Type, AK::URL const&)>;
+    void run(AK::URL const& document_base_url, AK::URL const& document_fallback_base_url, FetchCallback const& fetch);
+
+private:
+    struct DocumentURLs {
+        AK::URL const& base_url;
+        AK::URL const& fallback_base_url;
+    };
+
+    void process_start_tag(DocumentURLs const&, HTMLToken&, FetchCallback const&);
+    void process_end_tag(HTMLToken const&);
+    void speculatively_fetch(DocumentURLs const&, Resource::Type, StringView url, FetchCallback const&);
+
+    HTMLTokenizer m_tokenizer;
+    bool m_scripting_enabled { true };
+
+    // NOTE: Elements inside of templates are inert, so nothing inside of them is loaded.
+    size_t m_template_nesting_level { 0 };
+
+    Optional<AK::URL> m_base_url;
+    HashTable<String> m_fetched_urls;
+};
+
+}
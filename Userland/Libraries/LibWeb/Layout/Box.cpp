@@ -11,6 +11,7 @@
 #include <LibWeb/Layout/BlockContainer.h>
 #include <LibWeb/Layout/Box.h>
 #include <LibWeb/Layout/FormattingContext.h>
+#include <LibWeb/Layout/InitialContainingBlock.h>
 #include <LibWeb/Painting/PaintableBox.h>
 
 namespace Web::Layout {
@@ -32,7 +33,7 @@ Box::~Box()
 void Box::set_needs_display()
 {
     if (paint_box())
-        browsing_context().set_needs_display(enclosing_int_rect(paint_box()->absolute_rect()));
+        browsing_context().set_needs_display(enclosing_int_rect(paint_box()->absolute_paint_rect()));
 }
 
 bool Box::is_body() const
@@ -50,4 +51,51 @@ Painting::PaintableBox const* Box::paint_box() const
     return static_cast<Painting::PaintableBox const*>(Node::paintable());
 }
 
+bool Box::is_layout_boundary() const
+{
+    // NOTE: Only boxes that have been laid out before have a size and position to keep.
+    if (!paint_box() || is<InitialContainingBlock>(*this))
+        return false;
+
+    // The contents have to be laid out by a block formatting context of the box's own.
+    if (!is<BlockContainer>(*this) || is_replaced_box() || is_svg_box())
+        return false;
+    if (!display().is_block_outside() || !(display().is_flow_inside() || display().is_flow_root_inside()))
+        return false;
+    if (!FormattingContext::creates_block_formatting_context(*this))
+        return false;
+
+    // The size has to be fixed, so that it doesn't depend on the contents.
+    auto is_fixed_size = [](CSS::Size const& size) {
+        return size.is_length() && !size.length().is_calculated();
+    };
+    if (!is_fixed_size(computed_values().width()) || !is_fixed_size(computed_values().height()))
+        return false;
+
+    // NOTE: Overflowing contents only stay out of the scrollable overflow of the viewport if they are hidden.
+    if (computed_values().overflow_x() != CSS::Overflow::Hidden || computed_values().overflow_y() != CSS::Overflow::Hidden)
+        return false;
+
+    // The box can't be a flex or grid item, which can be sized by their contents regardless, and nothing around
+    // it can look at its contents for a baseline.
+    if (!is<BlockContainer>(parent()) || !(parent()->display().is_flow_inside() || parent()->display().is_flow_root_inside()))
+        return false;
+    for (auto const* ancestor = parent(); ancestor; ancestor = ancestor->parent()) {
+        auto ancestor_display = ancestor->display();
+        if (ancestor_display.is_inline_outside() || ancestor_display.is_table_inside() || ancestor_display.is_internal())
+            return false;
+    }
+
+    // Positioned boxes inside it have to be positioned relative to a box inside it as well.
+    bool contains_all_positioned_descendants = true;
+    for_each_in_subtree_of_type<Box>([&](Box const& box) {
+        if (box.is_absolutely_positioned() && !is_inclusive_ancestor_of(*box.containing_block())) {
+            contains_all_positioned_descendants = false;
+            return IterationDecision::Break;
+        }
+        return IterationDecision::Continue;
+    });
+    return contains_all_positioned_descendants;
+}
+
 }
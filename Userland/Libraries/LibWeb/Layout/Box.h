@@ -41,6 +41,10 @@ public:
 
     virtual RefPtr<Painting::Paintable> create_paintable() const override;
 
+    // A layout boundary is a box whose size and position don't depend on anything inside it, and which contains
+    // everything laid out inside it. Its contents can be laid out again without laying out anything around it.
+    bool is_layout_boundary() const;
+
 protected:
     Box(DOM::Document&, DOM::Node*, NonnullRefPtr<CSS::StyleProperties>);
     Box(DOM::Document&, DOM::Node*, CSS::ComputedValues);
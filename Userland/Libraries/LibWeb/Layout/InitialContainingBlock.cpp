@@ -54,6 +54,18 @@ void InitialContainingBlock::paint_all_phases(PaintContext& context)
     paint_box()->stacking_context()->paint(context);
 }
 
+// NOTE: Things without a box of their own, like the selection or focus, invalidate the initial containing block,
+//       so this covers everything that overflows it as well.
+void InitialContainingBlock::set_needs_display()
+{
+    if (!paint_box())
+        return;
+    auto rect = paint_box()->absolute_paint_rect();
+    if (paint_box()->has_overflow())
+        rect = rect.united(paint_box()->scrollable_overflow_rect().value());
+    browsing_context().set_needs_display(enclosing_int_rect(rect));
+}
+
 void InitialContainingBlock::recompute_selection_states()
 {
     SelectionState state = SelectionState::None;
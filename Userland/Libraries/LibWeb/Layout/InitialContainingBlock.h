@@ -30,6 +30,8 @@ public:
     void build_stacking_context_tree_if_needed();
     void recompute_selection_states();
 
+    virtual void set_needs_display() override;
+
 private:
     void build_stacking_context_tree();
     virtual bool is_initial_containing_block_box() const override { return true; }
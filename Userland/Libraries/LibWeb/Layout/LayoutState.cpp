@@ -51,7 +51,7 @@ LayoutState::UsedValues const& LayoutState::get(NodeWithStyleAndBoxModelMetrics
     return *used_values_per_layout_node[serial_id];
 }
 
-void LayoutState::commit()
+void LayoutState::commit(Box const* subtree_root)
 {
     // Only the top-level LayoutState should ever be committed.
     VERIFY(!m_parent);
@@ -63,6 +63,8 @@ void LayoutState::commit()
             continue;
         auto& used_values = *used_values_ptr;
         auto& node = const_cast<NodeWithStyleAndBoxModelMetrics&>(used_values.node());
+        if (subtree_root && !subtree_root->is_inclusive_ancestor_of(node))
+            continue;
 
         // Transfer box model metrics.
         node.box_model().inset = { used_values.inset_top, used_values.inset_right, used_values.inset_bottom, used_values.inset_left };
@@ -97,6 +99,46 @@ void LayoutState::commit()
         text_node->set_paintable(text_node->create_paintable());
 }
 
+bool LayoutState::restore_from_last_layout(Box const& box)
+{
+    Vector<Box const&> boxes;
+    for (Box const* current = &box; current; current = current->containing_block()) {
+        if (!current->paint_box())
+            return false;
+        boxes.append(*current);
+    }
+
+    // NOTE: Containing blocks are restored first, as the used values of a box are resolved against them.
+    for (size_t i = boxes.size(); i > 0; --i) {
+        auto const& current = boxes[i - 1];
+        auto const& paint_box = *current.paint_box();
+        auto const& box_model = current.box_model();
+        auto& used_values = get_mutable(current);
+
+        used_values.margin_top = box_model.margin.top;
+        used_values.margin_right = box_model.margin.right;
+        used_values.margin_bottom = box_model.margin.bottom;
+        used_values.margin_left = box_model.margin.left;
+        used_values.border_top = box_model.border.top;
+        used_values.border_right = box_model.border.right;
+        used_values.border_bottom = box_model.border.bottom;
+        used_values.border_left = box_model.border.left;
+        used_values.padding_top = box_model.padding.top;
+        used_values.padding_right = box_model.padding.right;
+        used_values.padding_bottom = box_model.padding.bottom;
+        used_values.padding_left = box_model.padding.left;
+        used_values.inset_top = box_model.inset.top;
+        used_values.inset_right = box_model.inset.right;
+        used_values.inset_bottom = box_model.inset.bottom;
+        used_values.inset_left = box_model.inset.left;
+
+        used_values.offset = paint_box.offset();
+        used_values.set_content_width(paint_box.content_width());
+        used_values.set_content_height(paint_box.content_height());
+    }
+    return true;
+}
+
 Gfx::FloatRect margin_box_rect(Box const& box, LayoutState const& state)
 {
     auto const& box_state = state.get(box);
@@ -145,7 +145,14 @@ struct LayoutState {
     float resolved_definite_width(Box const&) const;
     float resolved_definite_height(Box const&) const;
 
-    void commit();
+    // If given a subtree root, only the used values of it and the nodes inside it are committed, as the rest were
+    // only restored from the last layout.
+    void commit(Box const* subtree_root = nullptr);
+
+    // Fills in the used values of a box and its containing blocks with the results of the last committed layout,
+    // so that the contents of the box can be laid out again without laying out anything around it.
+    // Returns false if some of them haven't been laid out before.
+    bool restore_from_last_layout(Box const&);
 
     // NOTE: get_mutable() will CoW the UsedValues if it's inherited from an ancestor state;
     UsedValues& get_mutable(NodeWithStyleAndBoxModelMetrics const&);
@@ -157,6 +164,8 @@ struct LayoutState {
 
     // We cache intrinsic sizes once determined, as they will not change over the course of a full layout.
     // This avoids computing them several times while performing flex layout.
+    // NOTE: They are deliberately not kept across layouts, since anything from a style change to a resized viewport
+    //       can change them without the layout tree being marked as needing layout.
     struct IntrinsicSizes {
         Optional<float> min_content_width;
         Optional<float> max_content_width;
@@ -164,6 +164,31 @@ void Node::set_needs_display()
     });
 }
 
+void Node::set_needs_layout()
+{
+    m_needs_layout = true;
+
+    for (auto* ancestor = parent(); ancestor; ancestor = ancestor->parent())
+        ancestor->m_child_needs_layout = true;
+
+    document().set_layout_nodes_need_layout({});
+}
+
+void Node::clear_needs_layout(Vector<Node&>& nodes_that_needed_layout)
+{
+    if (m_needs_layout)
+        nodes_that_needed_layout.append(*this);
+    m_needs_layout = false;
+
+    if (!m_child_needs_layout)
+        return;
+    m_child_needs_layout = false;
+    for_each_child([&](Node& child) {
+        if (child.m_needs_layout || child.m_child_needs_layout)
+            child.clear_needs_layout(nodes_that_needed_layout);
+    });
+}
+
 Gfx::FloatPoint Node::box_type_agnostic_position() const
 {
     if (is<Box>(*this))
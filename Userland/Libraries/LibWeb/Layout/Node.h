@@ -125,6 +125,15 @@ public:
 
     virtual void set_needs_display();
 
+    // Marks this node as needing layout, and its ancestors as having a descendant that does, so that the next layout
+    // can start from the nearest layout boundary instead of the root.
+    void set_needs_layout();
+    bool needs_layout() const { return m_needs_layout; }
+    bool child_needs_layout() const { return m_child_needs_layout; }
+
+    // Clears the layout flags of this node and of every descendant that needs layout, and collects the nodes that did.
+    void clear_needs_layout(Vector<Node&>& nodes_that_needed_layout);
+
     bool children_are_inline() const { return m_children_are_inline; }
     void set_children_are_inline(bool value) { m_children_are_inline = value; }
 
@@ -164,6 +173,9 @@ private:
 
     bool m_is_flex_item { false };
     bool m_generated { false };
+
+    bool m_needs_layout { false };
+    bool m_child_needs_layout { false };
 };
 
 class NodeWithStyle : public Node {
@@ -33,10 +33,8 @@ void EditEventHandler::handle_delete_character_after(const DOM::Position& cursor
     builder.append(text.substring_view(cursor_position.offset() + code_point_length));
     node.set_data(builder.to_string());
 
-    // FIXME: When nodes are removed from the DOM, the associated layout nodes become stale and still
-    //        remain in the layout tree. This has to be fixed, this just causes everything to be recomputed
-    //        which really hurts performance.
-    m_browsing_context.active_document()->force_layout();
+    // NOTE: Only the data of a text node changed, which has marked its layout node as needing layout.
+    m_browsing_context.active_document()->update_layout();
 
     m_browsing_context.did_edit({});
 }
@@ -116,10 +114,8 @@ void EditEventHandler::handle_insert(DOM::Position position, u32 code_point)
         node.invalidate_style();
     }
 
-    // FIXME: When nodes are removed from the DOM, the associated layout nodes become stale and still
-    //        remain in the layout tree. This has to be fixed, this just causes everything to be recomputed
-    //        which really hurts performance.
-    m_browsing_context.active_document()->force_layout();
+    // NOTE: Only the data of a text node changed, which has marked its layout node as needing layout.
+    m_browsing_context.active_document()->update_layout();
 
     m_browsing_context.did_edit({});
 }
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGfx/Painter.h>
+#include <LibWeb/Layout/Box.h>
+#include <LibWeb/Layout/TextNode.h>
+#include <LibWeb/Painting/DisplayList.h>
+#include <LibWeb/Painting/PaintContext.h>
+#include <LibWeb/Painting/PaintableBox.h>
+#include <LibWeb/Painting/SVGPaintable.h>
+#include <LibWeb/Painting/StackingContext.h>
+
+namespace Web::Painting {
+
+static bool is_culled_phase(PaintPhase phase)
+{
+    return AK::first_is_one_of(phase, PaintPhase::Background, PaintPhase::Border, PaintPhase::Foreground);
+}
+
+Optional<Gfx::IntRect> DisplayList::bounding_rect_for_paint(Paintable const& paintable, PaintPhase phase)
+{
+    if (!is_culled_phase(phase))
+        return {};
+    if (!is<PaintableBox>(paintable) || is<SVGPaintable>(paintable))
+        return {};
+
+    auto const& paint_box = static_cast<PaintableBox const&>(paintable);
+
+    // NOTE: The root element's background is painted over the whole canvas, not just over the root element's box.
+    if (phase == PaintPhase::Background && paint_box.layout_box().is_root_element())
+        return {};
+
+    // NOTE: A box with a clip rect starts clipping in the background phase and stops in the overlay phase,
+    //       so its background always has to be painted.
+    if (paint_box.computed_values().clip().is_rect() && paint_box.layout_box().is_absolutely_positioned())
+        return {};
+
+    auto rect = paint_box.absolute_paint_rect();
+
+    // NOTE: Lines can overflow the box, unless it clips them.
+    if (phase == PaintPhase::Foreground && is<PaintableWithLines>(paint_box)) {
+        auto const& computed_values = paint_box.computed_values();
+        if (computed_values.overflow_x() == CSS::Overflow::Visible || computed_values.overflow_y() == CSS::Overflow::Visible) {
+            for (auto const& line_box : static_cast<PaintableWithLines const&>(paint_box).line_boxes()) {
+                for (auto const& fragment : line_box.fragments()) {
+                    // FIXME: Include the area of text shadows instead of giving up.
+                    if (!fragment.layout_node().computed_values().text_shadow().is_empty())
+                        return {};
+                    rect = rect.united(fragment.absolute_rect());
+                }
+            }
+        }
+    }
+
+    return enclosing_int_rect(rect);
+}
+
+Optional<Gfx::IntRect> DisplayList::bounding_rect_for_children(Paintable const& paintable, PaintPhase phase, Paintable::ShouldClipOverflow should_clip_overflow)
+{
+    // NOTE: This mirrors PaintableBox::before_children_paint(), which clips the children to the padding box here.
+    if (!is_culled_phase(phase) || should_clip_overflow == Paintable::ShouldClipOverflow::No)
+        return {};
+    if (!is<PaintableBox>(paintable) || is<SVGPaintable>(paintable))
+        return {};
+
+    auto const& paint_box = static_cast<PaintableBox const&>(paintable);
+    if (paint_box.computed_values().overflow_x() != CSS::Overflow::Hidden || paint_box.computed_values().overflow_y() != CSS::Overflow::Hidden)
+        return {};
+    return paint_box.absolute_padding_box_rect().to_rounded<int>();
+}
+
+void DisplayList::paint_node(Paintable const& paintable, PaintPhase phase, RequiresFocus requires_focus)
+{
+    m_commands.append(Command {
+        .type = Command::Type::PaintNode,
+        .paintable = &paintable,
+        .phase = phase,
+        .requires_focus = requires_focus,
+        .bounding_rect = bounding_rect_for_paint(paintable, phase),
+    });
+}
+
+void DisplayList::before_children_paint(Paintable const& paintable, PaintPhase phase, Paintable::ShouldClipOverflow should_clip_overflow)
+{
+    m_open_before_children_paints.append(m_commands.size());
+    m_commands.append(Command {
+        .type = Command::Type::BeforeChildrenPaint,
+        .paintable = &paintable,
+        .phase = phase,
+        .should_clip_overflow = should_clip_overflow,
+        .bounding_rect = bounding_rect_for_children(paintable, phase, should_clip_overflow),
+    });
+}
+
+void DisplayList::after_children_paint(Paintable const& paintable, PaintPhase phase, Paintable::ShouldClipOverflow should_clip_overflow)
+{
+    auto before_index = m_open_before_children_paints.take_last();
+    VERIFY(m_commands[before_index].paintable == &paintable);
+    m_commands[before_index].after_children_paint_index = m_commands.size();
+
+    m_commands.append(Command {
+        .type = Command::Type::AfterChildrenPaint,
+        .paintable = &paintable,
+        .phase = phase,
+        .should_clip_overflow = should_clip_overflow,
+    });
+}
+
+void DisplayList::paint_stacking_context(StackingContext const& stacking_context)
+{
+    m_commands.append(Command {
+        .type = Command::Type::PaintStackingContext,
+        .stacking_context = &stacking_context,
+    });
+}
+
+void DisplayList::replay(PaintContext& context) const
+{
+    VERIFY(m_open_before_children_paints.is_empty());
+
+    // NOTE: The painter's translation and clip rect can change between commands, so they are looked up every time.
+    auto is_out_of_view = [&](Optional<Gfx::IntRect> const& bounding_rect) {
+        if (!bounding_rect.has_value())
+            return false;
+        return !bounding_rect->translated(context.painter().translation()).intersects(context.painter().clip_rect());
+    };
+
+    for (size_t i = 0; i < m_commands.size(); ++i) {
+        auto const& command = m_commands[i];
+        switch (command.type) {
+        case Command::Type::PaintNode:
+            if (command.requires_focus == RequiresFocus::Yes && !context.has_focus())
+                break;
+            if (is_out_of_view(command.bounding_rect))
+                break;
+            command.paintable->paint(context, command.phase);
+            break;
+        case Command::Type::BeforeChildrenPaint:
+            // NOTE: Everything up to the matching AfterChildrenPaint is clipped to the bounding rect, so none of it
+            //       would be visible.
+            if (is_out_of_view(command.bounding_rect)) {
+                i = command.after_children_paint_index;
+                break;
+            }
+            command.paintable->before_children_paint(context, command.phase, command.should_clip_overflow);
+            break;
+        case Command::Type::AfterChildrenPaint:
+            command.paintable->after_children_paint(context, command.phase, command.should_clip_overflow);
+            break;
+        case Command::Type::PaintStackingContext:
+            command.stacking_context->paint(context);
+            break;
+        }
+    }
+}
+
+}
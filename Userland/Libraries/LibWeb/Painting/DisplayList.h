@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Optional.h>
+#include <AK/Vector.h>
+#include <LibGfx/Rect.h>
+#include <LibWeb/Forward.h>
+#include <LibWeb/Painting/Paintable.h>
+
+namespace Web::Painting {
+
+// A DisplayList is the order in which a stacking context paints its paintables, recorded once so that it can be
+// replayed on every repaint without walking the layout tree again.
+// When replaying, paintables that are entirely outside of the painter's clip rect are skipped, and so is everything
+// inside a box that clips its overflow and is outside of it.
+class DisplayList {
+public:
+    enum class RequiresFocus {
+        No,
+        Yes,
+    };
+
+    void paint_node(Paintable const&, PaintPhase, RequiresFocus = RequiresFocus::No);
+    void before_children_paint(Paintable const&, PaintPhase, Paintable::ShouldClipOverflow);
+    void after_children_paint(Paintable const&, PaintPhase, Paintable::ShouldClipOverflow);
+    void paint_stacking_context(StackingContext const&);
+
+    void replay(PaintContext&) const;
+
+    size_t command_count() const { return m_commands.size(); }
+
+private:
+    struct Command {
+        enum class Type {
+            PaintNode,
+            BeforeChildrenPaint,
+            AfterChildrenPaint,
+            PaintStackingContext,
+        };
+        Type type;
+        Paintable const* paintable { nullptr };
+        StackingContext const* stacking_context { nullptr };
+        PaintPhase phase { PaintPhase::Background };
+        Paintable::ShouldClipOverflow should_clip_overflow { Paintable::ShouldClipOverflow::No };
+        RequiresFocus requires_focus { RequiresFocus::No };
+
+        // For PaintNode, the area the paintable paints into. For BeforeChildrenPaint, the area its children are
+        // clipped to. Both are in absolute coordinates, and commands without one are always replayed.
+        Optional<Gfx::IntRect> bounding_rect {};
+
+        // For BeforeChildrenPaint, the index of the matching AfterChildrenPaint.
+        size_t after_children_paint_index { 0 };
+    };
+
+    static Optional<Gfx::IntRect> bounding_rect_for_paint(Paintable const&, PaintPhase);
+    static Optional<Gfx::IntRect> bounding_rect_for_children(Paintable const&, PaintPhase, Paintable::ShouldClipOverflow);
+
+    Vector<Command> m_commands;
+    Vector<size_t> m_open_before_children_paints;
+};
+
+}
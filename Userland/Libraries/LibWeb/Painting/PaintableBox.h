@@ -35,6 +35,7 @@ public:
     Gfx::FloatRect absolute_rect() const;
     Gfx::FloatPoint effective_offset() const;
 
+    Gfx::FloatPoint const& offset() const { return m_offset; }
     void set_offset(Gfx::FloatPoint const&);
     void set_offset(float x, float y) { set_offset({ x, y }); }
 
@@ -16,15 +16,16 @@
 #include <LibWeb/Layout/Box.h>
 #include <LibWeb/Layout/InitialContainingBlock.h>
 #include <LibWeb/Layout/ReplacedBox.h>
+#include <LibWeb/Painting/DisplayList.h>
 #include <LibWeb/Painting/PaintableBox.h>
 #include <LibWeb/Painting/StackingContext.h>
 
 namespace Web::Painting {
 
-static void paint_node(Layout::Node const& layout_node, PaintContext& context, PaintPhase phase)
+static void paint_node(Layout::Node const& layout_node, DisplayList& display_list, PaintPhase phase, DisplayList::RequiresFocus requires_focus = DisplayList::RequiresFocus::No)
 {
     if (auto const* paintable = layout_node.paintable())
-        paintable->paint(context, phase);
+        display_list.paint_node(*paintable, phase, requires_focus);
 }
 
 StackingContext::StackingContext(Layout::Box& box, StackingContext* parent)
@@ -69,10 +70,10 @@ static PaintPhase to_paint_phase(StackingContext::StackingContextPaintPhase phas
     }
 }
 
-void StackingContext::paint_descendants(PaintContext& context, Layout::Node const& box, StackingContextPaintPhase phase) const
+void StackingContext::paint_descendants(DisplayList& display_list, Layout::Node const& box, StackingContextPaintPhase phase) const
 {
     if (auto* paintable = box.paintable())
-        paintable->before_children_paint(context, to_paint_phase(phase), Paintable::ShouldClipOverflow::Yes);
+        display_list.before_children_paint(*paintable, to_paint_phase(phase), Paintable::ShouldClipOverflow::Yes);
 
     box.for_each_child([&](auto& child) {
         // If `child` establishes its own stacking context, skip over it.
@@ -89,61 +90,70 @@ void StackingContext::paint_descendants(PaintContext& context, Layout::Node cons
         switch (phase) {
         case StackingContextPaintPhase::BackgroundAndBorders:
             if (!child_is_inline_or_replaced && !child.is_floating()) {
-                paint_node(child, context, PaintPhase::Background);
-                paint_node(child, context, PaintPhase::Border);
-                paint_descendants(context, child, phase);
+                paint_node(child, display_list, PaintPhase::Background);
+                paint_node(child, display_list, PaintPhase::Border);
+                paint_descendants(display_list, child, phase);
             }
             break;
         case StackingContextPaintPhase::Floats:
             if (child.is_floating()) {
-                paint_node(child, context, PaintPhase::Background);
-                paint_node(child, context, PaintPhase::Border);
-                paint_descendants(context, child, StackingContextPaintPhase::BackgroundAndBorders);
+                paint_node(child, display_list, PaintPhase::Background);
+                paint_node(child, display_list, PaintPhase::Border);
+                paint_descendants(display_list, child, StackingContextPaintPhase::BackgroundAndBorders);
             }
-            paint_descendants(context, child, phase);
+            paint_descendants(display_list, child, phase);
             break;
         case StackingContextPaintPhase::BackgroundAndBordersForInlineLevelAndReplaced:
             if (child_is_inline_or_replaced) {
-                paint_node(child, context, PaintPhase::Background);
-                paint_node(child, context, PaintPhase::Border);
-                paint_descendants(context, child, StackingContextPaintPhase::BackgroundAndBorders);
+                paint_node(child, display_list, PaintPhase::Background);
+                paint_node(child, display_list, PaintPhase::Border);
+                paint_descendants(display_list, child, StackingContextPaintPhase::BackgroundAndBorders);
             }
-            paint_descendants(context, child, phase);
+            paint_descendants(display_list, child, phase);
             break;
         case StackingContextPaintPhase::Foreground:
-            paint_node(child, context, PaintPhase::Foreground);
-            paint_descendants(context, child, phase);
+            paint_node(child, display_list, PaintPhase::Foreground);
+            paint_descendants(display_list, child, phase);
             break;
         case StackingContextPaintPhase::FocusAndOverlay:
-            if (context.has_focus()) {
-                paint_node(child, context, PaintPhase::FocusOutline);
-            }
-            paint_node(child, context, PaintPhase::Overlay);
-            paint_descendants(context, child, phase);
+            paint_node(child, display_list, PaintPhase::FocusOutline, DisplayList::RequiresFocus::Yes);
+            paint_node(child, display_list, PaintPhase::Overlay);
+            paint_descendants(display_list, child, phase);
             break;
         }
     });
 
     if (auto* paintable = box.paintable())
-        paintable->after_children_paint(context, to_paint_phase(phase), Paintable::ShouldClipOverflow::Yes);
+        display_list.after_children_paint(*paintable, to_paint_phase(phase), Paintable::ShouldClipOverflow::Yes);
 }
 
 void StackingContext::paint_internal(PaintContext& context) const
+{
+    // NOTE: The display list only depends on the layout and stacking context trees, so it is kept until the stacking
+    //       context tree is rebuilt.
+    if (!m_display_list) {
+        m_display_list = make<DisplayList>();
+        record_display_list(*m_display_list);
+    }
+    m_display_list->replay(context);
+}
+
+void StackingContext::record_display_list(DisplayList& display_list) const
 {
     // For a more elaborate description of the algorithm, see CSS 2.1 Appendix E
     // Draw the background and borders for the context root (steps 1, 2)
-    paint_node(m_box, context, PaintPhase::Background);
-    paint_node(m_box, context, PaintPhase::Border);
+    paint_node(m_box, display_list, PaintPhase::Background);
+    paint_node(m_box, display_list, PaintPhase::Border);
 
     auto paint_child = [&](auto* child) {
         auto parent = child->m_box.parent();
         auto should_clip_overflow = child->m_box.is_absolutely_positioned() ? Paintable::ShouldClipOverflow::No : Paintable::ShouldClipOverflow::Yes;
         auto* paintable = parent ? parent->paintable() : nullptr;
         if (paintable)
-            paintable->before_children_paint(context, PaintPhase::Foreground, should_clip_overflow);
-        child->paint(context);
+            display_list.before_children_paint(*paintable, PaintPhase::Foreground, should_clip_overflow);
+        display_list.paint_stacking_context(*child);
         if (paintable)
-            paintable->after_children_paint(context, PaintPhase::Foreground, should_clip_overflow);
+            display_list.after_children_paint(*paintable, PaintPhase::Foreground, should_clip_overflow);
     };
 
     // Draw positioned descendants with negative z-indices (step 3)
@@ -153,13 +163,13 @@ void StackingContext::paint_internal(PaintContext& context) const
     }
 
     // Draw the background and borders for block-level children (step 4)
-    paint_descendants(context, m_box, StackingContextPaintPhase::BackgroundAndBorders);
+    paint_descendants(display_list, m_box, StackingContextPaintPhase::BackgroundAndBorders);
     // Draw the non-positioned floats (step 5)
-    paint_descendants(context, m_box, StackingContextPaintPhase::Floats);
+    paint_descendants(display_list, m_box, StackingContextPaintPhase::Floats);
     // Draw inline content, replaced content, etc. (steps 6, 7)
-    paint_descendants(context, m_box, StackingContextPaintPhase::BackgroundAndBordersForInlineLevelAndReplaced);
-    paint_node(m_box, context, PaintPhase::Foreground);
-    paint_descendants(context, m_box, StackingContextPaintPhase::Foreground);
+    paint_descendants(display_list, m_box, StackingContextPaintPhase::BackgroundAndBordersForInlineLevelAndReplaced);
+    paint_node(m_box, display_list, PaintPhase::Foreground);
+    paint_descendants(display_list, m_box, StackingContextPaintPhase::Foreground);
 
     // Draw positioned descendants with z-index `0` or `auto` in tree order. (step 8)
     // NOTE: Non-positioned descendants that establish stacking contexts with z-index `0` or `auto` are also painted here.
@@ -178,16 +188,16 @@ void StackingContext::paint_internal(PaintContext& context) const
         // At this point, `paint_box` is a positioned descendant with z-index: auto
         // but no stacking context of its own.
         // FIXME: This is basically duplicating logic found elsewhere in this same function. Find a way to make this more elegant.
-        paint_node(paint_box.layout_box(), context, PaintPhase::Background);
-        paint_node(paint_box.layout_box(), context, PaintPhase::Border);
-        paint_descendants(context, paint_box.layout_box(), StackingContextPaintPhase::BackgroundAndBorders);
-        paint_descendants(context, paint_box.layout_box(), StackingContextPaintPhase::Floats);
-        paint_descendants(context, paint_box.layout_box(), StackingContextPaintPhase::BackgroundAndBordersForInlineLevelAndReplaced);
-        paint_node(paint_box.layout_box(), context, PaintPhase::Foreground);
-        paint_descendants(context, paint_box.layout_box(), StackingContextPaintPhase::Foreground);
-        paint_node(paint_box.layout_box(), context, PaintPhase::FocusOutline);
-        paint_node(paint_box.layout_box(), context, PaintPhase::Overlay);
-        paint_descendants(context, paint_box.layout_box(), StackingContextPaintPhase::FocusAndOverlay);
+        paint_node(paint_box.layout_box(), display_list, PaintPhase::Background);
+        paint_node(paint_box.layout_box(), display_list, PaintPhase::Border);
+        paint_descendants(display_list, paint_box.layout_box(), StackingContextPaintPhase::BackgroundAndBorders);
+        paint_descendants(display_list, paint_box.layout_box(), StackingContextPaintPhase::Floats);
+        paint_descendants(display_list, paint_box.layout_box(), StackingContextPaintPhase::BackgroundAndBordersForInlineLevelAndReplaced);
+        paint_node(paint_box.layout_box(), display_list, PaintPhase::Foreground);
+        paint_descendants(display_list, paint_box.layout_box(), StackingContextPaintPhase::Foreground);
+        paint_node(paint_box.layout_box(), display_list, PaintPhase::FocusOutline);
+        paint_node(paint_box.layout_box(), display_list, PaintPhase::Overlay);
+        paint_descendants(display_list, paint_box.layout_box(), StackingContextPaintPhase::FocusAndOverlay);
 
         return TraversalDecision::Continue;
     });
@@ -198,9 +208,9 @@ void StackingContext::paint_internal(PaintContext& context) const
             paint_child(child);
     }
 
-    paint_node(m_box, context, PaintPhase::FocusOutline);
-    paint_node(m_box, context, PaintPhase::Overlay);
-    paint_descendants(context, m_box, StackingContextPaintPhase::FocusAndOverlay);
+    paint_node(m_box, display_list, PaintPhase::FocusOutline);
+    paint_node(m_box, display_list, PaintPhase::Overlay);
+    paint_descendants(display_list, m_box, StackingContextPaintPhase::FocusAndOverlay);
 }
 
 Gfx::FloatMatrix4x4 StackingContext::get_transformation_matrix(CSS::Transformation const& transformation) const
@@ -6,9 +6,11 @@
 
 #pragma once
 
+#include <AK/OwnPtr.h>
 #include <AK/Vector.h>
 #include <LibGfx/Matrix4x4.h>
 #include <LibWeb/Layout/Node.h>
+#include <LibWeb/Painting/DisplayList.h>
 #include <LibWeb/Painting/Paintable.h>
 
 namespace Web::Painting {
@@ -30,7 +32,7 @@ public:
         FocusAndOverlay,
     };
 
-    void paint_descendants(PaintContext&, Layout::Node const&, StackingContextPaintPhase) const;
+    void paint_descendants(DisplayList&, Layout::Node const&, StackingContextPaintPhase) const;
     void paint(PaintContext&) const;
     Optional<HitTestResult> hit_test(Gfx::FloatPoint const&, HitTestType) const;
 
@@ -47,8 +49,10 @@ private:
     Gfx::FloatPoint m_transform_origin;
     StackingContext* const m_parent { nullptr };
     Vector<StackingContext*> m_children;
+    mutable OwnPtr<DisplayList> m_display_list;
 
     void paint_internal(PaintContext&) const;
+    void record_display_list(DisplayList&) const;
     Gfx::FloatMatrix4x4 get_transformation_matrix(CSS::Transformation const& transformation) const;
     Gfx::FloatMatrix4x4 combine_transformations(Vector<CSS::Transformation> const& transformations) const;
     Gfx::FloatPoint transform_origin() const { return m_transform_origin; }
@@ -0,0 +1,51 @@
+describe("Ancestor filter", () => {
+    loadLocalPage("AncestorFilter.html");
+
+    afterInitialPageLoad(page => {
+        const black = "rgb(0, 0, 0)";
+        const colorOf = element => page.getComputedStyle(element).getPropertyValue("color");
+
+        test("Selectors that need ancestors still match", () => {
+            expect(colorOf(page.document.getElementById("inner"))).toBe("rgb(255, 0, 0)");
+            expect(colorOf(page.document.getElementById("span"))).toBe("rgb(0, 128, 0)");
+            expect(colorOf(page.document.getElementById("tag"))).toBe("rgb(0, 0, 255)");
+            expect(colorOf(page.document.getElementById("second"))).toBe("rgb(255, 165, 0)");
+        });
+
+        test("Ancestors that share classes many times over", () => {
+            // More ancestors with the same class than the filter can count.
+            let parent = page.document.getElementById("deep-root");
+            for (let i = 0; i < 300; ++i) {
+                const div = page.document.createElement("div");
+                div.className = "deep";
+                parent.appendChild(div);
+                parent = div;
+            }
+            const deepest = page.document.createElement("div");
+            deepest.className = "deepest";
+            parent.appendChild(deepest);
+
+            expect(colorOf(deepest)).toBe("rgb(128, 0, 128)");
+            expect(colorOf(page.document.getElementById("after-deep"))).toBe("rgb(0, 128, 128)");
+        });
+
+        test("Changing the classes of an ancestor", () => {
+            const outer = page.document.getElementById("outer");
+            const inner = page.document.getElementById("inner");
+
+            outer.removeAttribute("id");
+            expect(colorOf(inner)).toBe(black);
+
+            outer.className = "missing";
+            expect(colorOf(inner)).toBe("rgb(1, 2, 3)");
+
+            outer.removeAttribute("class");
+            expect(colorOf(inner)).toBe(black);
+
+            outer.id = "outer";
+            expect(colorOf(inner)).toBe("rgb(255, 0, 0)");
+        });
+    });
+
+    waitForPageToLoad();
+});
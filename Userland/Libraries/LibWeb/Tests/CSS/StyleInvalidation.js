@@ -0,0 +1,79 @@
+describe("Style invalidation", () => {
+    loadLocalPage("StyleInvalidation.html");
+
+    afterInitialPageLoad(page => {
+        const black = "rgb(0, 0, 0)";
+        const colorOf = element => page.getComputedStyle(element).getPropertyValue("color");
+
+        test("Changing the class of an element", () => {
+            const target = page.document.getElementById("target");
+            expect(colorOf(target)).toBe(black);
+
+            target.setAttribute("class", "red");
+            expect(colorOf(target)).toBe("rgb(255, 0, 0)");
+
+            target.className = "blue";
+            expect(colorOf(target)).toBe(black);
+
+            target.setAttribute("CLASS", "red");
+            expect(colorOf(target)).toBe("rgb(255, 0, 0)");
+
+            target.removeAttribute("CLASS");
+            expect(colorOf(target)).toBe(black);
+
+            target.toggleAttribute("class");
+            target.setAttribute("class", "red");
+            target.toggleAttribute("class");
+            expect(colorOf(target)).toBe(black);
+        });
+
+        test("Changing the id of an element", () => {
+            const target = page.document.getElementById("target");
+            expect(colorOf(target)).toBe(black);
+
+            target.id = "green";
+            expect(colorOf(target)).toBe("rgb(0, 128, 0)");
+
+            target.setAttribute("ID", "target");
+            expect(colorOf(target)).toBe(black);
+        });
+
+        test("Changing the class of an ancestor", () => {
+            const parent = page.document.getElementById("parent");
+            const child = page.document.getElementById("child");
+            expect(colorOf(child)).toBe(black);
+
+            parent.setAttribute("class", "parent");
+            expect(colorOf(child)).toBe("rgb(0, 0, 255)");
+
+            parent.removeAttribute("class");
+            expect(colorOf(child)).toBe(black);
+
+            parent.setAttribute("CLASS", "parent");
+            expect(colorOf(child)).toBe("rgb(0, 0, 255)");
+
+            parent.removeAttribute("CLASS");
+            expect(colorOf(child)).toBe(black);
+        });
+
+        test("Changing the class of a preceding sibling", () => {
+            const before = page.document.getElementById("before");
+            const after = page.document.getElementById("after");
+            expect(colorOf(after)).toBe(black);
+
+            before.setAttribute("class", "before");
+            expect(colorOf(after)).toBe("rgb(255, 165, 0)");
+
+            before.removeAttribute("class");
+            expect(colorOf(after)).toBe(black);
+
+            before.setAttribute("CLASS", "before");
+            expect(colorOf(after)).toBe("rgb(255, 165, 0)");
+
+            before.toggleAttribute("Class");
+            expect(colorOf(after)).toBe(black);
+        });
+    });
+
+    waitForPageToLoad();
+});
@@ -0,0 +1,45 @@
+describe("Intrinsic sizes", () => {
+    loadLocalPage("IntrinsicSizes.html");
+
+    afterInitialPageLoad(page => {
+        test("Changing text inside a layout boundary", () => {
+            const floatInBoundary = page.document.getElementById("float-in-boundary");
+            const text = page.document.getElementById("text").firstChild;
+
+            const shortWidth = floatInBoundary.offsetWidth;
+            expect(shortWidth).toBeGreaterThan(0);
+
+            text.data = "a considerably longer text";
+            const longWidth = floatInBoundary.offsetWidth;
+            expect(longWidth).toBeGreaterThan(shortWidth);
+
+            text.data = "short";
+            expect(floatInBoundary.offsetWidth).toBe(shortWidth);
+        });
+
+        test("Changing the style of a descendant", () => {
+            const float = page.document.getElementById("float");
+            const fixedWidth = page.document.getElementById("fixed-width");
+            expect(float.offsetWidth).toBe(50);
+
+            fixedWidth.style.width = "150px";
+            expect(float.offsetWidth).toBe(150);
+
+            fixedWidth.style.width = "50px";
+            expect(float.offsetWidth).toBe(50);
+        });
+
+        test("Replacing the contents of a box", () => {
+            const float = page.document.getElementById("float");
+            expect(float.offsetWidth).toBe(50);
+
+            float.innerHTML = '<div style="width: 80px; height: 10px"></div>';
+            expect(float.offsetWidth).toBe(80);
+
+            float.innerHTML = '<div id="fixed-width" style="width: 50px; height: 10px"></div>';
+            expect(float.offsetWidth).toBe(50);
+        });
+    });
+
+    waitForPageToLoad();
+});
@@ -49,7 +49,12 @@ JS_DEFINE_NATIVE_FUNCTION(WebAssemblyMemoryPrototype::buffer_getter)
     if (!memory)
         return JS::js_undefined();
 
-    auto* array_buffer = JS::ArrayBuffer::create(realm, &memory->data());
+    // NOTE: A guarded memory stays in its reservation, the ArrayBuffer is just a view of it.
+    JS::ArrayBuffer* array_buffer;
+    if (memory->is_guarded())
+        array_buffer = JS::ArrayBuffer::create_with_external_storage(realm, memory->data());
+    else
+        array_buffer = JS::ArrayBuffer::create(realm, &memory->buffer());
     array_buffer->set_detach_key(JS::js_string(vm, "WebAssembly.Memory"));
     return array_buffer;
 }
@@ -11,6 +11,7 @@
 #include "WebAssemblyModulePrototype.h"
 #include "WebAssemblyTableObject.h"
 #include "WebAssemblyTablePrototype.h"
+#include <AK/AnyOf.h>
 #include <AK/ScopeGuard.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/ArrayBuffer.h>
@@ -25,6 +26,12 @@
 
 namespace Web::Bindings {
 
+static bool has_vector_type(Wasm::FunctionType const& type)
+{
+    auto is_vector = [](auto& value_type) { return value_type.is_vector(); };
+    return any_of(type.parameters(), is_vector) || any_of(type.results(), is_vector);
+}
+
 WebAssemblyObject::WebAssemblyObject(JS::Realm& realm)
     : Object(*realm.intrinsics().object_prototype())
 {
@@ -123,10 +130,10 @@ JS::ThrowCompletionOr<size_t> parse_module(JS::VM& vm, JS::Object* buffer_object
         data = buffer.buffer();
     } else if (is<JS::TypedArrayBase>(buffer_object)) {
         auto& buffer = static_cast<JS::TypedArrayBase&>(*buffer_object);
-        data = buffer.viewed_array_buffer()->buffer().span().slice(buffer.byte_offset(), buffer.byte_length());
+        data = buffer.viewed_array_buffer()->buffer().slice(buffer.byte_offset(), buffer.byte_length());
     } else if (is<JS::DataView>(buffer_object)) {
         auto& buffer = static_cast<JS::DataView&>(*buffer_object);
-        data = buffer.viewed_array_buffer()->buffer().span().slice(buffer.byte_offset(), buffer.byte_length());
+        data = buffer.viewed_array_buffer()->buffer().slice(buffer.byte_offset(), buffer.byte_length());
     } else {
         return vm.throw_completion<JS::TypeError>("Not a BufferSource");
     }
@@ -209,6 +216,10 @@ JS::ThrowCompletionOr<size_t> WebAssemblyObject::instantiate_module(JS::VM& vm,
                     //        just extract its address and resolve to that.
                     Wasm::HostFunction host_function {
                         [&](auto&, auto& arguments) -> Wasm::Result {
+                            // NOTE: v128 values can't cross into JS, see https://webassembly.github.io/spec/js-api/#exported-function-exotic-objects.
+                            if (has_vector_type(type))
+                                return Wasm::Trap { "Cannot pass a v128 value to JS" };
+
                             JS::MarkedVector<JS::Value> argument_values { vm.heap() };
                             for (auto& entry : arguments)
                                 argument_values.append(to_js_value(vm, entry));
@@ -384,6 +395,9 @@ JS::Value to_js_value(JS::VM& vm, Wasm::Value& wasm_value)
     case Wasm::ValueType::ExternReference:
     case Wasm::ValueType::NullExternReference:
         TODO();
+    case Wasm::ValueType::V128:
+        // NOTE: Callers reject signatures involving v128 before getting here.
+        VERIFY_NOT_REACHED();
     }
     VERIFY_NOT_REACHED();
 }
@@ -432,6 +446,8 @@ JS::ThrowCompletionOr<Wasm::Value> to_webassembly_value(JS::VM& vm, JS::Value va
     case Wasm::ValueType::ExternReference:
     case Wasm::ValueType::NullExternReference:
         TODO();
+    case Wasm::ValueType::V128:
+        return vm.throw_completion<JS::TypeError>("Cannot convert a value to v128");
     }
 
     VERIFY_NOT_REACHED();
@@ -450,6 +466,9 @@ JS::NativeFunction* create_native_function(JS::VM& vm, Wasm::FunctionAddress add
         name,
         [address, type = type.release_value()](JS::VM& vm) -> JS::ThrowCompletionOr<JS::Value> {
             auto& realm = *vm.current_realm();
+            if (has_vector_type(type))
+                return vm.throw_completion<JS::TypeError>("Cannot call a function taking or returning v128 from JS");
+
             Vector<Wasm::Value> values;
             values.ensure_capacity(type.parameters().size());
 
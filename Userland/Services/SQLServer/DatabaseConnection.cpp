@@ -67,6 +67,25 @@ void DatabaseConnection::disconnect()
     });
 }
 
+void DatabaseConnection::commit(Function<void(ErrorOr<void>)> on_committed)
+{
+    m_pending_commits.append(move(on_committed));
+    if (m_pending_commits.size() > 1)
+        return;
+
+    // NOTE: Statements are executed from the event loop as well, so the ones that were sent along with
+    //       this one get to run before the commit, and they share the write to the write-ahead log.
+    deferred_invoke([this]() {
+        auto pending_commits = move(m_pending_commits);
+        ErrorOr<void> result {};
+        if (m_database)
+            result = m_database->commit();
+        dbgln_if(SQLSERVER_DEBUG, "DatabaseConnection::commit(connection_id {}): {} statements committed", connection_id(), pending_commits.size());
+        for (auto& on_committed : pending_commits)
+            on_committed(result);
+    });
+}
+
 int DatabaseConnection::sql_statement(String const& sql)
 {
     dbgln_if(SQLSERVER_DEBUG, "DatabaseConnection::sql_statement(connection_id {}, database '{}', sql '{}'", connection_id(), m_database_name, sql);
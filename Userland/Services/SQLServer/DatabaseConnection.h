@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <AK/Function.h>
+#include <AK/Vector.h>
 #include <LibCore/Object.h>
 #include <LibSQL/Database.h>
 #include <SQLServer/Forward.h>
@@ -25,10 +27,15 @@ public:
     void disconnect();
     int sql_statement(String const& sql);
 
+    // Commits the changes made by statements so far, together with those of all other statements that
+    // ask for a commit before the event loop gets to it, and then calls the callback.
+    void commit(Function<void(ErrorOr<void>)> on_committed);
+
 private:
     DatabaseConnection(String database_name, int client_id);
 
     RefPtr<SQL::Database> m_database { nullptr };
+    Vector<Function<void(ErrorOr<void>)>> m_pending_commits;
     String m_database_name;
     int m_connection_id;
     int m_client_id;
@@ -75,24 +75,41 @@ void SQLStatement::execute()
             return;
         }
 
-        auto client_connection = ConnectionFromClient::client_connection_for(connection()->client_id());
-        if (!client_connection) {
-            warnln("Cannot return statement execution results. Client disconnected");
-            return;
-        }
-
         m_result = execution_result.release_value();
 
-        if (should_send_result_rows()) {
-            client_connection->async_execution_success(statement_id(), true, 0, 0, 0);
-            m_index = 0;
-            next();
-        } else {
-            client_connection->async_execution_success(statement_id(), false, 0, m_result->size(), 0);
+        if (!should_commit()) {
+            report_success();
+            return;
         }
+
+        // NOTE: The commit happens later on, so the statement has to stick around until then.
+        connection()->commit([this, strong_this = NonnullRefPtr(*this)](ErrorOr<void> result) {
+            if (result.is_error()) {
+                report_error(SQL::Result { m_result->command(), SQL::SQLErrorCode::InternalError, String::formatted("{}", result.error()) });
+                return;
+            }
+            report_success();
+        });
     });
 }
 
+void SQLStatement::report_success()
+{
+    auto client_connection = ConnectionFromClient::client_connection_for(connection()->client_id());
+    if (!client_connection) {
+        warnln("Cannot return statement execution results. Client disconnected");
+        return;
+    }
+
+    if (should_send_result_rows()) {
+        client_connection->async_execution_success(statement_id(), true, 0, 0, 0);
+        m_index = 0;
+        next();
+    } else {
+        client_connection->async_execution_success(statement_id(), false, 0, m_result->size(), 0);
+    }
+}
+
 SQL::ResultOr<void> SQLStatement::parse()
 {
     auto parser = SQL::AST::Parser(SQL::AST::Lexer(m_sql));
@@ -112,6 +129,7 @@ bool SQLStatement::should_send_result_rows() const
 
     switch (m_result->command()) {
     case SQL::SQLCommand::Describe:
+    case SQL::SQLCommand::Explain:
     case SQL::SQLCommand::Select:
         return true;
     default:
@@ -119,6 +137,21 @@ bool SQLStatement::should_send_result_rows() const
     }
 }
 
+bool SQLStatement::should_commit() const
+{
+    VERIFY(m_result.has_value());
+
+    switch (m_result->command()) {
+    case SQL::SQLCommand::Create:
+    case SQL::SQLCommand::Delete:
+    case SQL::SQLCommand::Insert:
+    case SQL::SQLCommand::Update:
+        return true;
+    default:
+        return false;
+    }
+}
+
 void SQLStatement::next()
 {
     VERIFY(!m_result->is_empty());
@@ -33,7 +33,9 @@ private:
     SQLStatement(DatabaseConnection&, String sql);
     SQL::ResultOr<void> parse();
     bool should_send_result_rows() const;
+    bool should_commit() const;
     void next();
+    void report_success();
     void report_error(SQL::Result);
 
     int m_statement_id;
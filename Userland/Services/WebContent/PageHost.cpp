@@ -7,11 +7,13 @@
 
 #include "PageHost.h"
 #include "ConnectionFromClient.h"
+#include <AK/AnyOf.h>
 #include <LibGfx/Painter.h>
 #include <LibGfx/ShareableBitmap.h>
 #include <LibGfx/SystemTheme.h>
 #include <LibWeb/Cookie/ParsedCookie.h>
 #include <LibWeb/HTML/BrowsingContext.h>
+#include <LibWeb/HTML/HTMLHtmlElement.h>
 #include <LibWeb/Layout/InitialContainingBlock.h>
 #include <LibWeb/Painting/PaintableBox.h>
 #include <LibWeb/Platform/Timer.h>
@@ -32,6 +34,8 @@ PageHost::PageHost(ConnectionFromClient& client)
 
 void PageHost::set_has_focus(bool has_focus)
 {
+    if (m_has_focus != has_focus)
+        m_tile_cache.invalidate_all();
     m_has_focus = has_focus;
 }
 
@@ -55,6 +59,7 @@ Gfx::Palette PageHost::palette() const
 void PageHost::set_palette_impl(Gfx::PaletteImpl const& impl)
 {
     m_palette_impl = impl;
+    m_tile_cache.invalidate_all();
     if (auto* document = page().top_level_browsing_context().active_document())
         document->invalidate_style();
 }
@@ -62,10 +67,18 @@ void PageHost::set_palette_impl(Gfx::PaletteImpl const& impl)
 void PageHost::set_preferred_color_scheme(Web::CSS::PreferredColorScheme color_scheme)
 {
     m_preferred_color_scheme = color_scheme;
+    m_tile_cache.invalidate_all();
     if (auto* document = page().top_level_browsing_context().active_document())
         document->invalidate_style();
 }
 
+void PageHost::set_should_show_line_box_borders(bool should_show_line_box_borders)
+{
+    if (m_should_show_line_box_borders != should_show_line_box_borders)
+        m_tile_cache.invalidate_all();
+    m_should_show_line_box_borders = should_show_line_box_borders;
+}
+
 void PageHost::set_is_scripting_enabled(bool is_scripting_enabled)
 {
     page().set_is_scripting_enabled(is_scripting_enabled);
@@ -96,25 +109,82 @@ Web::Layout::InitialContainingBlock* PageHost::layout_root()
 
 void PageHost::paint(Gfx::IntRect const& content_rect, Gfx::Bitmap& target)
 {
-    Gfx::Painter painter(target);
-    Gfx::IntRect bitmap_rect { {}, content_rect.size() };
-
     if (auto* document = page().top_level_browsing_context().active_document())
         document->update_layout();
 
     auto* layout_root = this->layout_root();
     if (!layout_root) {
-        painter.fill_rect(bitmap_rect, palette().base());
+        Gfx::Painter painter(target);
+        painter.fill_rect({ {}, content_rect.size() }, palette().base());
+        return;
+    }
+
+    // NOTE: What gets painted for fixed content depends on the scroll position, so tiles painted for one scroll
+    //       position can't be reused for another.
+    if (has_scroll_dependent_content()) {
+        m_tile_cache.invalidate_all();
+        paint_content(content_rect, target);
         return;
     }
 
-    Web::PaintContext context(painter, palette(), content_rect.top_left());
+    m_tile_cache.paint(content_rect, target, [this](auto& tile_rect, auto& tile_bitmap) {
+        paint_content(tile_rect, tile_bitmap);
+    });
+}
+
+void PageHost::paint_content(Gfx::IntRect const& content_rect, Gfx::Bitmap& target)
+{
+    auto* layout_root = this->layout_root();
+    VERIFY(layout_root);
+
+    Gfx::Painter painter(target);
+    painter.fill_rect({ {}, content_rect.size() }, layout_root->document().background_color(palette()));
+
+    // NOTE: The content is painted relative to the actual viewport even when only a tile of it is painted, since
+    //       some of it (like the root element's background) is positioned relative to the viewport.
+    auto viewport_rect = page().top_level_browsing_context().viewport_rect();
+    painter.translate(viewport_rect.location() - content_rect.location());
+
+    Web::PaintContext context(painter, palette(), viewport_rect.location());
     context.set_should_show_line_box_borders(m_should_show_line_box_borders);
-    context.set_viewport_rect(content_rect);
+    context.set_viewport_rect(viewport_rect);
     context.set_has_focus(m_has_focus);
     layout_root->paint_all_phases(context);
 }
 
+bool PageHost::has_scroll_dependent_content()
+{
+    if (m_has_scroll_dependent_content.has_value())
+        return *m_has_scroll_dependent_content;
+
+    bool has_scroll_dependent_content = false;
+
+    // NOTE: The root element's background covers the viewport (see PaintableBox::paint_background()), so its images
+    //       move along with it.
+    auto& document = layout_root()->document();
+    if (auto* html_element = document.html_element(); html_element && html_element->layout_node()) {
+        auto const* background_layers = html_element->should_use_body_background_properties() ? document.background_layers() : &html_element->layout_node()->background_layers();
+        if (background_layers && any_of(*background_layers, [](auto& layer) { return layer.background_image; }))
+            has_scroll_dependent_content = true;
+    }
+
+    layout_root()->for_each_in_inclusive_subtree_of_type<Web::Layout::NodeWithStyle>([&](auto& node) {
+        if (node.is_fixed_position()) {
+            has_scroll_dependent_content = true;
+            return IterationDecision::Break;
+        }
+        for (auto const& layer : node.computed_values().background_layers()) {
+            if (layer.attachment == Web::CSS::BackgroundAttachment::Fixed) {
+                has_scroll_dependent_content = true;
+                return IterationDecision::Break;
+            }
+        }
+        return IterationDecision::Continue;
+    });
+    m_has_scroll_dependent_content = has_scroll_dependent_content;
+    return has_scroll_dependent_content;
+}
+
 void PageHost::set_viewport_rect(Gfx::IntRect const& rect)
 {
     page().top_level_browsing_context().set_viewport_rect(rect);
@@ -122,6 +192,13 @@ void PageHost::set_viewport_rect(Gfx::IntRect const& rect)
 
 void PageHost::page_did_invalidate(Gfx::IntRect const& content_rect)
 {
+    m_tile_cache.invalidate(content_rect);
+    m_has_scroll_dependent_content = {};
+
+    // NOTE: We hear about changes outside of the viewport as well, as they may be cached in tiles.
+    if (!page().top_level_browsing_context().viewport_rect().intersects(content_rect))
+        return;
+
     m_invalidation_rect = m_invalidation_rect.united(content_rect);
     if (!m_invalidation_coalescing_timer->is_active())
         m_invalidation_coalescing_timer->start();
@@ -141,6 +218,9 @@ void PageHost::page_did_layout()
 {
     auto* layout_root = this->layout_root();
     VERIFY(layout_root);
+    m_tile_cache.invalidate_all();
+    m_has_scroll_dependent_content = {};
+
     Gfx::IntSize content_size;
     if (layout_root->paint_box()->has_overflow())
         content_size = enclosing_int_rect(layout_root->paint_box()->scrollable_overflow_rect().value()).size();
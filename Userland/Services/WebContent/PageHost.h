@@ -9,6 +9,7 @@
 
 #include <LibGfx/Rect.h>
 #include <LibWeb/Page/Page.h>
+#include <WebContent/TileCache.h>
 
 namespace WebContent {
 
@@ -31,7 +32,7 @@ public:
     void set_viewport_rect(Gfx::IntRect const&);
     void set_screen_rects(Vector<Gfx::IntRect, 4> const& rects, size_t main_screen_index) { m_screen_rect = rects[main_screen_index]; };
     void set_preferred_color_scheme(Web::CSS::PreferredColorScheme);
-    void set_should_show_line_box_borders(bool b) { m_should_show_line_box_borders = b; }
+    void set_should_show_line_box_borders(bool);
     void set_has_focus(bool);
     void set_is_scripting_enabled(bool);
     void set_is_webdriver_active(bool);
@@ -76,6 +77,8 @@ private:
 
     Web::Layout::InitialContainingBlock* layout_root();
     void setup_palette();
+    void paint_content(Gfx::IntRect const& content_rect, Gfx::Bitmap&);
+    bool has_scroll_dependent_content();
 
     ConnectionFromClient& m_client;
     NonnullOwnPtr<Web::Page> m_page;
@@ -84,6 +87,9 @@ private:
     bool m_should_show_line_box_borders { false };
     bool m_has_focus { false };
 
+    TileCache m_tile_cache;
+    Optional<bool> m_has_scroll_dependent_content;
+
     RefPtr<Web::Platform::Timer> m_invalidation_coalescing_timer;
     Gfx::IntRect m_invalidation_rect;
     Web::CSS::PreferredColorScheme m_preferred_color_scheme { Web::CSS::PreferredColorScheme::Auto };
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGfx/Painter.h>
+#include <WebContent/TileCache.h>
+
+namespace WebContent {
+
+// Tiles this far outside of the painted area are kept around for when it is scrolled back into view.
+static constexpr int tile_retention_margin = TileCache::tile_size * 2;
+
+static int tile_origin(int coordinate)
+{
+    if (coordinate < 0)
+        return -(((-coordinate - 1) / TileCache::tile_size) + 1) * TileCache::tile_size;
+    return (coordinate / TileCache::tile_size) * TileCache::tile_size;
+}
+
+TileCache::Tile* TileCache::find_tile(Gfx::IntPoint const& location)
+{
+    for (auto& tile : m_tiles) {
+        if (tile.rect.location() == location)
+            return &tile;
+    }
+    return nullptr;
+}
+
+void TileCache::evict_tiles_outside(Gfx::IntRect const& content_rect)
+{
+    auto retained_rect = content_rect.inflated(tile_retention_margin * 2, tile_retention_margin * 2);
+    m_tiles.remove_all_matching([&](auto& tile) { return !tile.rect.intersects(retained_rect); });
+}
+
+void TileCache::paint(Gfx::IntRect const& content_rect, Gfx::Bitmap& target, RasterizeCallback const& rasterize)
+{
+    // NOTE: Tiles can't be reused once the bitmap scale has changed.
+    m_tiles.remove_all_matching([&](auto& tile) { return tile.bitmap->scale() != target.scale(); });
+    evict_tiles_outside(content_rect);
+
+    Gfx::Painter painter(target);
+    painter.translate(-content_rect.location());
+
+    for (int y = tile_origin(content_rect.top()); y <= content_rect.bottom(); y += tile_size) {
+        for (int x = tile_origin(content_rect.left()); x <= content_rect.right(); x += tile_size) {
+            auto* tile = find_tile({ x, y });
+            if (!tile) {
+                auto bitmap_or_error = Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRx8888, { tile_size, tile_size }, target.scale());
+                if (bitmap_or_error.is_error()) {
+                    dbgln("TileCache: Failed to create tile bitmap: {}", bitmap_or_error.error());
+                    continue;
+                }
+                m_tiles.append({ { x, y, tile_size, tile_size }, bitmap_or_error.release_value() });
+                tile = &m_tiles.last();
+            }
+
+            // FIXME: Tiles are independent of each other, so these could be rasterized on a pool of worker threads.
+            //        That has to wait until painting is thread-safe: paintables keep their overflow clip and corner
+            //        clippers in themselves while painting, and cache their absolute rects lazily.
+            if (tile->needs_rasterization) {
+                rasterize(tile->rect, *tile->bitmap);
+                tile->needs_rasterization = false;
+            }
+
+            painter.blit(tile->rect.location(), *tile->bitmap, tile->bitmap->rect(), 1.0f, false);
+        }
+    }
+}
+
+void TileCache::invalidate(Gfx::IntRect const& content_rect)
+{
+    for (auto& tile : m_tiles) {
+        if (tile.rect.intersects(content_rect))
+            tile.needs_rasterization = true;
+    }
+}
+
+void TileCache::invalidate_all()
+{
+    m_tiles.clear();
+}
+
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2022, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Function.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/Vector.h>
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/Rect.h>
+
+namespace WebContent {
+
+// Keeps the page content painted in fixed-size tiles, so that only the tiles that were invalidated since the last
+// paint have to be painted again. Scrolling mostly just copies tiles that are already there to a new place.
+// NOTE: Tiles are rasterized one after another on the calling thread, see paint().
+class TileCache {
+public:
+    static constexpr int tile_size = 256;
+
+    // Paints `tile_rect` (in content coordinates) of the page into the bitmap.
+    using RasterizeCallback = Function<void(Gfx::IntRect const& tile_rect, Gfx::Bitmap&)>;
+
+    void paint(Gfx::IntRect const& content_rect, Gfx::Bitmap& target, RasterizeCallback const&);
+
+    void invalidate(Gfx::IntRect const& content_rect);
+    void invalidate_all();
+
+private:
+    struct Tile {
+        Gfx::IntRect rect;
+        NonnullRefPtr<Gfx::Bitmap> bitmap;
+        bool needs_rasterization { true };
+    };
+
+    Tile* find_tile(Gfx::IntPoint const& location);
+    void evict_tiles_outside(Gfx::IntRect const& content_rect);
+
+    Vector<Tile> m_tiles;
+};
+
+}
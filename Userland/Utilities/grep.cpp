@@ -5,6 +5,7 @@
  */
 
 #include <AK/Assertions.h>
+#include <AK/Atomic.h>
 #include <AK/LexicalPath.h>
 #include <AK/ScopeGuard.h>
 #include <AK/String.h>
@@ -12,10 +13,15 @@
 #include <LibCore/ArgsParser.h>
 #include <LibCore/DirIterator.h>
 #include <LibCore/File.h>
+#include <LibCore/MappedFile.h>
 #include <LibCore/System.h>
 #include <LibMain/Main.h>
 #include <LibRegex/Regex.h>
+#include <LibThreading/ConditionVariable.h>
+#include <LibThreading/Mutex.h>
+#include <LibThreading/Thread.h>
 #include <stdio.h>
+#include <string.h>
 #include <unistd.h>
 
 enum class BinaryFileMode {
@@ -35,7 +41,7 @@ void fail(StringView format, Ts... args)
 
 ErrorOr<int> serenity_main(Main::Arguments args)
 {
-    TRY(Core::System::pledge("stdio rpath"));
+    TRY(Core::System::pledge("stdio rpath thread"));
 
     String program_name = AK::LexicalPath::basename(args.strings[0]);
 
@@ -53,8 +59,6 @@ ErrorOr<int> serenity_main(Main::Arguments args)
     bool colored_output = isatty(STDOUT_FILENO);
     bool count_lines = false;
 
-    size_t matched_line_count = 0;
-
     Core::ArgsParser args_parser;
     args_parser.add_option(recursive, "Recursively scan files", "recursive", 'r');
     args_parser.add_option(use_ere, "Extended regular expressions", "extended-regexp", 'E');
@@ -141,14 +145,16 @@ ErrorOr<int> serenity_main(Main::Arguments args)
     if (case_insensitive)
         options |= PosixFlags::Insensitive;
 
-    auto grep_logic = [&](auto&& regular_expressions) {
+    // NOTE: Files are searched in parallel, each thread with its own copy of the patterns since a Regex can't be shared between threads.
+    auto grep_logic = [&](auto make_regular_expressions) {
+        auto regular_expressions = make_regular_expressions();
         for (auto& re : regular_expressions) {
             if (re.parser_result.error != regex::Error::NoError) {
                 return 1;
             }
         }
 
-        auto matches = [&](StringView str, StringView filename, size_t line_number, bool print_filename, bool is_binary) {
+        auto matches = [&](auto& regular_expressions, StringView str, StringView filename, size_t line_number, bool print_filename, bool is_binary, size_t& matched_line_count, StringBuilder& output) {
             size_t last_printed_char_pos { 0 };
             if (is_binary && binary_mode == BinaryFileMode::Skip)
                 return false;
@@ -167,22 +173,22 @@ ErrorOr<int> serenity_main(Main::Arguments args)
                 }
 
                 if (is_binary && binary_mode == BinaryFileMode::Binary) {
-                    outln(colored_output ? "binary file \x1B[34m{}\x1B[0m matches"sv : "binary file {} matches"sv, filename);
+                    output.appendff(colored_output ? "binary file \x1B[34m{}\x1B[0m matches\n"sv : "binary file {} matches\n"sv, filename);
                 } else {
                     if ((result.matches.size() || invert_match) && print_filename)
-                        out(colored_output ? "\x1B[34m{}:\x1B[0m"sv : "{}:"sv, filename);
+                        output.appendff(colored_output ? "\x1B[34m{}:\x1B[0m"sv : "{}:"sv, filename);
                     if ((result.matches.size() || invert_match) && line_numbers)
-                        out(colored_output ? "\x1B[35m{}:\x1B[0m"sv : "{}:"sv, line_number);
+                        output.appendff(colored_output ? "\x1B[35m{}:\x1B[0m"sv : "{}:"sv, line_number);
 
                     for (auto& match : result.matches) {
                         auto pre_match_length = match.global_offset - last_printed_char_pos;
-                        out(colored_output ? "{}\x1B[32m{}\x1B[0m"sv : "{}{}"sv,
+                        output.appendff(colored_output ? "{}\x1B[32m{}\x1B[0m"sv : "{}{}"sv,
                             pre_match_length > 0 ? StringView(&str[last_printed_char_pos], pre_match_length) : ""sv,
                             match.view.to_string());
                         last_printed_char_pos = match.global_offset + match.view.length();
                     }
                     auto remaining_length = str.length() - last_printed_char_pos;
-                    outln("{}", remaining_length > 0 ? StringView(&str[last_printed_char_pos], remaining_length) : ""sv);
+                    output.appendff("{}\n", remaining_length > 0 ? StringView(&str[last_printed_char_pos], remaining_length) : ""sv);
                 }
 
                 return true;
@@ -191,66 +197,132 @@ ErrorOr<int> serenity_main(Main::Arguments args)
             return false;
         };
 
-        bool did_match_something = false;
+        // Lines that don't contain a literal that every match contains can't match, so we can skip right to the ones that do.
+        auto required_literal = [&](auto& regular_expressions) -> StringView {
+            if (regular_expressions.size() != 1 || invert_match || case_insensitive)
+                return {};
+            auto& optimization_data = regular_expressions.first().parser_result.optimization_data;
+            if (optimization_data.required_substring.length() > optimization_data.literal_prefix.length())
+                return optimization_data.required_substring;
+            return optimization_data.literal_prefix;
+        };
+
+        struct FileResult {
+            bool opened { false };
+            bool did_match_something { false };
+            String error;
+        };
+
+        // NOTE: Output is handed to write_output() in chunks of about this size, so a file with a lot of matches is never buffered whole.
+        static constexpr size_t output_chunk_size = 64 * KiB;
+
+        auto handle_file = [&matches, &required_literal, binary_mode, count_lines, quiet_mode, line_numbers,
+                               user_specified_multiple_files](auto& regular_expressions, String const& filename, bool print_filename, auto write_output) {
+            FileResult result;
+            StringBuilder output;
 
-        auto handle_file = [&matches, binary_mode, suppress_errors, count_lines, quiet_mode,
-                               user_specified_multiple_files, &matched_line_count, &did_match_something](StringView filename, bool print_filename) -> bool {
             auto file = Core::File::construct(filename);
             if (!file->open(Core::OpenMode::ReadOnly)) {
-                if (!suppress_errors)
-                    warnln("Failed to open {}: {}", filename, file->error_string());
-                return false;
+                result.error = String::formatted("Failed to open {}: {}", filename, file->error_string());
+                return result;
             }
 
             auto file_size_or_error = Core::File::size(filename);
             if (file_size_or_error.is_error()) {
-                if (!suppress_errors)
-                    warnln("Failed to retrieve size of {}: {}", filename, strerror(file_size_or_error.error().code()));
-                return false;
+                result.error = String::formatted("Failed to retrieve size of {}: {}", filename, strerror(file_size_or_error.error().code()));
+                return result;
             }
 
-            auto file_size = file_size_or_error.release_value();
+            result.opened = true;
+
+            // NOTE: Large files are mapped into memory instead of being copied into it, either way the whole file is searched at once.
+            static constexpr size_t minimum_size_to_map = 64 * KiB;
+            RefPtr<Core::MappedFile> mapped_file;
+            ByteBuffer file_contents;
+            if (file_size_or_error.value() >= minimum_size_to_map) {
+                if (auto mapped_file_or_error = Core::MappedFile::map(filename); !mapped_file_or_error.is_error())
+                    mapped_file = mapped_file_or_error.release_value();
+            }
+            if (!mapped_file)
+                file_contents = file->read_all();
+            auto contents = mapped_file ? StringView { static_cast<char const*>(mapped_file->data()), mapped_file->size() } : StringView { file_contents.bytes() };
+
+            auto literal = required_literal(regular_expressions);
+            size_t matched_line_count = 0;
+            size_t line_number = 1;
+            size_t position = 0;
+            while (position < contents.length()) {
+                auto line_start = position;
+                if (!literal.is_empty()) {
+                    auto remaining = contents.substring_view(position);
+                    auto offset = AK::memmem_optional(remaining.characters_without_null_termination(), remaining.length(), literal.characters_without_null_termination(), literal.length());
+                    if (!offset.has_value())
+                        break;
+                    if (auto newline = remaining.substring_view(0, *offset).find_last('\n'); newline.has_value()) {
+                        line_start = position + *newline + 1;
+                        if (line_numbers)
+                            line_number += remaining.substring_view(0, *newline + 1).count("\n"sv);
+                    }
+                }
 
-            for (size_t line_number = 1; file->can_read_line(); ++line_number) {
-                auto line = file->read_line(file_size);
-                auto is_binary = memchr(line.characters(), 0, line.length()) != nullptr;
+                auto line_end = contents.find('\n', line_start).value_or(contents.length());
+                auto line = contents.substring_view(line_start, line_end - line_start);
+                auto is_binary = memchr(line.characters_without_null_termination(), 0, line.length()) != nullptr;
 
-                auto matched = matches(line, filename, line_number, print_filename, is_binary);
-                did_match_something = did_match_something || matched;
+                auto matched = matches(regular_expressions, line, filename, line_number, print_filename, is_binary, matched_line_count, output);
+                result.did_match_something = result.did_match_something || matched;
+                if (output.length() >= output_chunk_size) {
+                    write_output(output.string_view());
+                    output.clear();
+                }
                 if (matched && is_binary && binary_mode == BinaryFileMode::Binary)
                     break;
+
+                position = line_end + 1;
+                ++line_number;
             }
 
             if (count_lines && !quiet_mode) {
                 if (user_specified_multiple_files)
-                    outln("{}:{}", filename, matched_line_count);
+                    output.appendff("{}:{}\n", filename, matched_line_count);
                 else
-                    outln("{}", matched_line_count);
-                matched_line_count = 0;
+                    output.appendff("{}\n", matched_line_count);
             }
 
-            return true;
+            if (!output.is_empty())
+                write_output(output.string_view());
+            return result;
+        };
+
+        struct FileToSearch {
+            String path;
+            bool print_filename { false };
         };
+        Vector<FileToSearch> files_to_search;
 
-        auto add_directory = [&handle_file, user_has_specified_files](String base, Optional<String> recursive, auto handle_directory) -> void {
+        auto add_directory = [&files_to_search, user_has_specified_files](String base, Optional<String> recursive, auto handle_directory) -> void {
             Core::DirIterator it(recursive.value_or(base), Core::DirIterator::Flags::SkipDots);
             while (it.has_next()) {
                 auto path = it.next_full_path();
                 if (!Core::File::is_directory(path)) {
-                    auto key = user_has_specified_files ? path.view() : path.substring_view(base.length() + 1, path.length() - base.length() - 1);
-                    handle_file(key, true);
+                    auto key = user_has_specified_files ? path : path.substring(base.length() + 1, path.length() - base.length() - 1);
+                    files_to_search.append({ move(key), true });
                 } else {
                     handle_directory(base, path, handle_directory);
                 }
             }
         };
 
+        bool did_match_something = false;
+
         if (!files.size() && !recursive) {
             char* line = nullptr;
             size_t line_len = 0;
             ssize_t nread = 0;
             ScopeGuard free_line = [line] { free(line); };
             size_t line_number = 0;
+            size_t matched_line_count = 0;
+            StringBuilder output;
             while ((nread = getline(&line, &line_len, stdin)) != -1) {
                 VERIFY(nread > 0);
                 if (line[nread - 1] == '\n')
@@ -263,30 +335,131 @@ ErrorOr<int> serenity_main(Main::Arguments args)
                 if (is_binary && binary_mode == BinaryFileMode::Skip)
                     return 1;
 
-                auto matched = matches(line_view, "stdin"sv, line_number, false, is_binary);
+                auto matched = matches(regular_expressions, line_view, "stdin"sv, line_number, false, is_binary, matched_line_count, output);
                 did_match_something = did_match_something || matched;
+                out("{}", output.string_view());
+                output.clear();
                 if (matched && is_binary && binary_mode == BinaryFileMode::Binary)
                     break;
             }
 
             if (count_lines && !quiet_mode)
                 outln("{}", matched_line_count);
-        } else {
-            if (recursive) {
-                if (user_has_specified_files) {
-                    for (auto& filename : files) {
-                        add_directory(filename, {}, add_directory);
-                    }
-                } else {
-                    add_directory(".", {}, add_directory);
-                }
 
-            } else {
-                bool print_filename { files.size() > 1 };
+            return did_match_something ? 0 : 1;
+        }
+
+        if (recursive) {
+            if (user_has_specified_files) {
                 for (auto& filename : files) {
-                    if (!handle_file(filename, print_filename))
-                        return 1;
+                    add_directory(filename, {}, add_directory);
                 }
+            } else {
+                add_directory(".", {}, add_directory);
+            }
+        } else {
+            bool print_filename { files.size() > 1 };
+            for (auto& filename : files)
+                files_to_search.append({ filename, print_filename });
+        }
+
+        auto report_result = [&](FileResult const& result) {
+            if (!result.error.is_null() && !suppress_errors)
+                warnln("{}", result.error);
+            did_match_something = did_match_something || result.did_match_something;
+            return result.opened || recursive;
+        };
+
+        auto thread_count = min(max(sysconf(_SC_NPROCESSORS_ONLN), 1l), static_cast<long>(files_to_search.size()));
+        if (thread_count <= 1) {
+            for (auto& file : files_to_search) {
+                auto result = handle_file(regular_expressions, file.path, file.print_filename, [](StringView output) { out("{}", output); });
+                if (!report_result(result))
+                    return 1;
+            }
+            return did_match_something ? 0 : 1;
+        }
+
+        // Files are handed out to the threads in order, and their output is written in that order as soon as it's available.
+        // Each file can have at most maximum_pending_output bytes of output waiting to be written, after that its thread
+        // waits until the main thread has caught up with it.
+        static constexpr size_t maximum_pending_output = 1 * MiB;
+        struct PendingFile {
+            Vector<String> output;
+            size_t output_size { 0 };
+            Optional<FileResult> result;
+        };
+        Vector<PendingFile> pending_files;
+        pending_files.resize(files_to_search.size());
+        Threading::Mutex pending_files_mutex;
+        Threading::ConditionVariable pending_files_changed { pending_files_mutex };
+        Atomic<size_t> next_file_index { 0 };
+        bool should_stop { false };
+
+        auto search_files = [&](auto& regular_expressions) {
+            while (true) {
+                auto index = next_file_index.fetch_add(1);
+                if (index >= files_to_search.size())
+                    break;
+                auto& pending_file = pending_files[index];
+                auto result = handle_file(regular_expressions, files_to_search[index].path, files_to_search[index].print_filename, [&](StringView output) {
+                    Threading::MutexLocker locker { pending_files_mutex };
+                    pending_files_changed.wait_while([&] { return pending_file.output_size >= maximum_pending_output && !should_stop; });
+                    pending_file.output.append(output);
+                    pending_file.output_size += output.length();
+                    pending_files_changed.broadcast();
+                });
+                Threading::MutexLocker locker { pending_files_mutex };
+                pending_file.result = move(result);
+                pending_files_changed.broadcast();
+                if (should_stop)
+                    break;
+            }
+        };
+
+        Vector<NonnullRefPtr<Threading::Thread>> threads;
+        for (long i = 0; i < thread_count; ++i) {
+            threads.append(Threading::Thread::construct([&] {
+                auto regular_expressions = make_regular_expressions();
+                search_files(regular_expressions);
+                return 0;
+            },
+                "grep"sv));
+            threads.last()->start();
+        }
+        ScopeGuard join_threads = [&] {
+            {
+                Threading::MutexLocker locker { pending_files_mutex };
+                should_stop = true;
+                pending_files_changed.broadcast();
+            }
+            for (auto& thread : threads) {
+                auto rc = thread->join();
+                if (rc.is_error())
+                    warnln("pthread_join: {}", strerror(rc.error().value()));
+            }
+        };
+
+        for (auto& pending_file : pending_files) {
+            while (true) {
+                Vector<String> output;
+                Optional<FileResult> result;
+                {
+                    Threading::MutexLocker locker { pending_files_mutex };
+                    pending_files_changed.wait_while([&] { return pending_file.output.is_empty() && !pending_file.result.has_value(); });
+                    output = move(pending_file.output);
+                    pending_file.output_size = 0;
+                    result = move(pending_file.result);
+                    pending_files_changed.broadcast();
+                }
+
+                for (auto& chunk : output)
+                    out("{}", chunk);
+                if (!result.has_value())
+                    continue;
+                if (!report_result(*result))
+                    return 1;
+                break;
             }
         }
 
@@ -294,16 +467,20 @@ ErrorOr<int> serenity_main(Main::Arguments args)
     };
 
     if (use_ere) {
-        Vector<Regex<PosixExtended>> regular_expressions;
-        for (auto pattern : patterns) {
-            regular_expressions.append(Regex<PosixExtended>(pattern, options));
-        }
-        return grep_logic(regular_expressions);
+        return grep_logic([&] {
+            Vector<Regex<PosixExtended>> regular_expressions;
+            for (auto pattern : patterns) {
+                regular_expressions.append(Regex<PosixExtended>(pattern, options));
+            }
+            return regular_expressions;
+        });
     }
 
-    Vector<Regex<PosixBasic>> regular_expressions;
-    for (auto pattern : patterns) {
-        regular_expressions.append(Regex<PosixBasic>(pattern, options));
-    }
-    return grep_logic(regular_expressions);
+    return grep_logic([&] {
+        Vector<Regex<PosixBasic>> regular_expressions;
+        for (auto pattern : patterns) {
+            regular_expressions.append(Regex<PosixBasic>(pattern, options));
+        }
+        return regular_expressions;
+    });
 }
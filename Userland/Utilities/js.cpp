@@ -469,7 +469,7 @@ static void print_promise(JS::Promise const& promise, HashTable<JS::Object*>& se
 
 static void print_array_buffer(JS::ArrayBuffer const& array_buffer, HashTable<JS::Object*>& seen_objects)
 {
-    auto& buffer = array_buffer.buffer();
+    auto buffer = array_buffer.buffer();
     auto byte_length = array_buffer.byte_length();
     print_type("ArrayBuffer");
     js_out("\n  byteLength: ");
@@ -1510,6 +1510,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     TRY(Core::System::pledge("stdio rpath wpath cpath tty sigaction"));
 
     bool gc_on_every_allocation = false;
+    size_t gc_marking_threads = 1;
     bool disable_syntax_highlight = false;
     StringView evaluate_script;
     Vector<StringView> script_paths;
@@ -1525,6 +1526,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.add_option(s_strip_ansi, "Disable ANSI colors", "disable-ansi-colors", 'i');
     args_parser.add_option(s_disable_source_location_hints, "Disable source location hints", "disable-source-location-hints", 'h');
     args_parser.add_option(gc_on_every_allocation, "GC on every allocation", "gc-on-every-allocation", 'g');
+    args_parser.add_option(gc_marking_threads, "Number of threads used to mark the heap during GC", "gc-marking-threads", 0, "count");
     args_parser.add_option(disable_syntax_highlight, "Disable live syntax highlighting", "no-syntax-highlight", 's');
     args_parser.add_option(evaluate_script, "Evaluate argument as a script", "evaluate", 'c', "script");
     args_parser.add_positional_argument(script_paths, "Path to script files", "scripts", Core::ArgsParser::Required::No);
@@ -1566,6 +1568,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         ReplConsoleClient console_client(console_object.console());
         console_object.console().set_client(console_client);
         interpreter->heap().set_should_collect_on_every_allocation(gc_on_every_allocation);
+        interpreter->heap().set_marking_thread_count(gc_marking_threads);
 
         auto& global_environment = interpreter->realm().global_environment();
 
@@ -1777,6 +1780,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         ReplConsoleClient console_client(console_object.console());
         console_object.console().set_client(console_client);
         interpreter->heap().set_should_collect_on_every_allocation(gc_on_every_allocation);
+        interpreter->heap().set_marking_thread_count(gc_marking_threads);
 
         signal(SIGINT, [](int) {
             sigint_handler();